@@ -0,0 +1,129 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBufferAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBufferAllocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace
+{
+int TestAllocator(const vtkBufferAllocator* allocator, const char* name, std::uintptr_t alignment)
+{
+  vtkNew<vtkDoubleArray> array;
+  array->SetAllocator(allocator);
+  array->SetNumberOfComponents(3);
+  array->SetNumberOfTuples(1000);
+  if (reinterpret_cast<std::uintptr_t>(array->GetPointer(0)) % alignment != 0)
+  {
+    cerr << name << ": memory is not aligned on " << alignment << " bytes." << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < 3000; ++i)
+  {
+    array->SetValue(i, static_cast<double>(i));
+  }
+
+  // Growing the array must preserve its values and alignment.
+  for (vtkIdType i = 0; i < 5000; ++i)
+  {
+    array->InsertNextTuple3(1., 2., 3.);
+  }
+  if (reinterpret_cast<std::uintptr_t>(array->GetPointer(0)) % alignment != 0)
+  {
+    cerr << name << ": reallocated memory is not aligned on " << alignment << " bytes." << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < 3000; ++i)
+  {
+    if (array->GetValue(i) != static_cast<double>(i))
+    {
+      cerr << name << ": value " << i << " lost on reallocation." << endl;
+      return 1;
+    }
+  }
+  if (array->GetNumberOfTuples() != 6000 || array->GetComponent(5999, 2) != 3.)
+  {
+    cerr << name << ": wrong array content after insertion." << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestBufferAllocator(int, char*[])
+{
+  int status = 0;
+  status += TestAllocator(vtkBufferAllocator::GetDefaultAllocator(), "Default", sizeof(double));
+  status += TestAllocator(vtkBufferAllocator::GetAlignedAllocator(), "Aligned", 64);
+  status += TestAllocator(vtkBufferAllocator::GetHugePageAllocator(), "HugePage", 64);
+  status += TestAllocator(vtkBufferAllocator::GetFirstTouchAllocator(), "FirstTouch", 4096);
+
+  // First touch allocation zero-initializes the memory.
+  vtkNew<vtkDoubleArray> touched;
+  touched->SetAllocator(vtkBufferAllocator::GetFirstTouchAllocator());
+  touched->SetNumberOfValues(100000);
+  for (vtkIdType i = 0; i < 100000; ++i)
+  {
+    if (touched->GetValue(i) != 0.)
+    {
+      cerr << "FirstTouch: memory is not zero-initialized." << endl;
+      return 1;
+    }
+  }
+
+  // Memory handed over by an array keeps the free function of its allocator,
+  // even when it is given back with the default delete method.
+  const vtkBufferAllocator* aligned = vtkBufferAllocator::GetAlignedAllocator();
+  vtkNew<vtkDoubleArray> owner;
+  owner->SetAllocator(aligned);
+  owner->SetNumberOfValues(100);
+  double* memory = owner->GetPointer(0);
+  owner->SetArray(memory, 100, 1);
+  if (owner->GetArrayFreeFunction() != aligned->Free)
+  {
+    cerr << "Handed over memory lost the free function of its allocator." << endl;
+    return 1;
+  }
+  owner->SetArray(memory, 100, 0);
+  if (owner->GetArrayFreeFunction() != aligned->Free)
+  {
+    cerr << "Memory given back is not released by its allocator." << endl;
+    return 1;
+  }
+  double* external = static_cast<double*>(malloc(100 * sizeof(double)));
+  owner->SetArray(external, 100, 0);
+  if (owner->GetArrayFreeFunction() != free)
+  {
+    cerr << "External memory is not released with free()." << endl;
+    return 1;
+  }
+
+  // The global allocator applies to arrays created afterwards, and to arrays
+  // whose allocator is reset.
+  vtkBufferAllocator::SetGlobalAllocator(aligned);
+  vtkNew<vtkDoubleArray> global;
+  owner->SetAllocator(nullptr);
+  vtkBufferAllocator::SetGlobalAllocator(nullptr);
+  if (global->GetAllocator() != aligned || owner->GetAllocator() != aligned ||
+    vtkBufferAllocator::GetGlobalAllocator() != vtkBufferAllocator::GetDefaultAllocator())
+  {
+    cerr << "Global allocator not honored." << endl;
+    return 1;
+  }
+
+  return status;
+}
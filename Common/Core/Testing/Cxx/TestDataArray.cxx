@@ -177,6 +177,69 @@ int TestDataArray(int, char*[])
   }
   farray->Delete();
 
+  // Ranges of arrays large enough to go through the blocked range kernels.
+  farray = vtkDoubleArray::New();
+  farray->SetNumberOfComponents(3);
+  for (cc = 0; cc < 1003; cc++)
+  {
+    farray->InsertNextTuple3(cc, -cc, (cc % 7) - 3.);
+  }
+  farray->SetComponent(500, 0, vtkMath::Inf());
+  farray->SetComponent(501, 1, vtkMath::Nan());
+  farray->GetRange(range, 1);
+  if (range[0] != -1002. || range[1] != 0.)
+  {
+    cerr << "Getting range of component 1 failed, min: " << range[0] << " max: " << range[1]
+         << "\n";
+    farray->Delete();
+    return 1;
+  }
+  farray->GetFiniteRange(range, 0);
+  if (range[0] != 0. || range[1] != 1002.)
+  {
+    cerr << "Getting finite range of component 0 failed, min: " << range[0]
+         << " max: " << range[1] << "\n";
+    farray->Delete();
+    return 1;
+  }
+  farray->GetRange(range, 0);
+  if (range[0] != 0. || range[1] != vtkMath::Inf())
+  {
+    cerr << "Getting range of component 0 failed, min: " << range[0] << " max: " << range[1]
+         << "\n";
+    farray->Delete();
+    return 1;
+  }
+  farray->SetComponent(500, 0, 0.);
+  farray->SetComponent(501, 1, 0.);
+  farray->Modified();
+  farray->GetRange(range, -1);
+  if (!vtkMathUtilities::FuzzyCompare(range[0], std::sqrt(6.)) ||
+    !vtkMathUtilities::FuzzyCompare(range[1], std::sqrt(2. * 1002. * 1002. + 4.)))
+  {
+    cerr << "Getting magnitude range failed, min: " << range[0] << " max: " << range[1] << "\n";
+    farray->Delete();
+    return 1;
+  }
+
+  // Copy a component between arrays of the same type.
+  vtkDoubleArray* carray = vtkDoubleArray::New();
+  carray->SetNumberOfComponents(2);
+  carray->SetNumberOfTuples(farray->GetNumberOfTuples());
+  carray->CopyComponent(1, farray, 0);
+  for (cc = 0; cc < farray->GetNumberOfTuples(); ++cc)
+  {
+    if (carray->GetComponent(cc, 1) != farray->GetComponent(cc, 0))
+    {
+      cerr << "CopyComponent failed at tuple " << cc << "\n";
+      carray->Delete();
+      farray->Delete();
+      return 1;
+    }
+  }
+  carray->Delete();
+  farray->Delete();
+
   farray = vtkDoubleArray::New();
   farray->SetNumberOfComponents(3);
   for (cc = 0; cc < 10; cc++)
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDataArrayCopyOnWrite.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkSOADataArrayTemplate.h"
+
+// Check that arrays sharing a copy-on-write buffer only detach from it
+// when they are modified.
+int TestDataArrayCopyOnWrite(int, char*[])
+{
+  vtkNew<vtkFloatArray> source;
+  source->SetNumberOfComponents(3);
+  source->SetNumberOfTuples(10);
+  for (vtkIdType i = 0; i < 30; ++i)
+  {
+    source->SetValue(i, static_cast<float>(i));
+  }
+  source->CopyOnWriteOn();
+
+  vtkNew<vtkFloatArray> copy;
+  copy->ShallowCopy(source);
+  if (!copy->GetCopyOnWrite() || copy->GetPointer(0) != source->GetPointer(0))
+  {
+    cerr << "Shallow copy does not share the copy-on-write buffer." << endl;
+    return 1;
+  }
+
+  // Modifying the copy must leave the source untouched.
+  copy->SetValue(4, -1.f);
+  if (copy->GetPointer(0) == source->GetPointer(0))
+  {
+    cerr << "Write did not detach the shared buffer." << endl;
+    return 1;
+  }
+  if (source->GetValue(4) != 4.f || copy->GetValue(4) != -1.f || copy->GetValue(29) != 29.f)
+  {
+    cerr << "Wrong values after copy-on-write." << endl;
+    return 1;
+  }
+
+  // The source now owns its buffer and can be written without copying.
+  float* sourceData = source->GetPointer(0);
+  source->SetValue(0, 100.f);
+  if (source->GetPointer(0) != sourceData)
+  {
+    cerr << "Unshared buffer was copied." << endl;
+    return 1;
+  }
+
+  // Growing a shared array must not reallocate the other array's memory.
+  vtkNew<vtkFloatArray> other;
+  other->ShallowCopy(source);
+  other->InsertNextTuple3(1., 2., 3.);
+  if (source->GetNumberOfTuples() != 10 || other->GetNumberOfTuples() != 11 ||
+    source->GetPointer(0) != sourceData || other->GetValue(0) != 100.f)
+  {
+    cerr << "Wrong state after inserting into a shared array." << endl;
+    return 1;
+  }
+
+  // The threaded component copy detaches the buffer before writing to it.
+  vtkNew<vtkFloatArray> component;
+  component->ShallowCopy(source);
+  component->CopyComponent(1, source, 0);
+  if (component->GetPointer(0) == source->GetPointer(0) || source->GetValue(1) != 1.f ||
+    component->GetValue(1) != 100.f || component->GetValue(28) != 27.f)
+  {
+    cerr << "Wrong values after copying a component into a shared array." << endl;
+    return 1;
+  }
+
+  // Copies from arrays of another type or layout write through ranges, and
+  // detach the buffer first too.
+  vtkNew<vtkSOADataArrayTemplate<float>> soa;
+  soa->SetNumberOfComponents(3);
+  soa->SetNumberOfTuples(10);
+  soa->FillValue(-2.f);
+  vtkNew<vtkFloatArray> tuple;
+  tuple->ShallowCopy(source);
+  tuple->SetTuple(2, 0, soa);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetNumberOfComponents(3);
+  doubles->SetNumberOfTuples(10);
+  doubles->FillValue(-3.);
+  vtkNew<vtkFloatArray> deep;
+  deep->ShallowCopy(source);
+  deep->DeepCopy(doubles);
+  if (source->GetValue(6) != 6.f || tuple->GetValue(6) != -2.f || tuple->GetValue(9) != 9.f ||
+    source->GetValue(29) != 29.f || deep->GetValue(29) != -3.f)
+  {
+    cerr << "Wrong values after copying another array type into a shared array." << endl;
+    return 1;
+  }
+
+  // Without copy-on-write, shallow copies keep sharing their memory.
+  vtkNew<vtkFloatArray> plain;
+  plain->SetNumberOfValues(4);
+  plain->FillValue(1.f);
+  vtkNew<vtkFloatArray> plainCopy;
+  plainCopy->ShallowCopy(plain);
+  plainCopy->SetValue(0, 2.f);
+  if (plain->GetValue(0) != 2.f)
+  {
+    cerr << "Buffer without copy-on-write was detached." << endl;
+    return 1;
+  }
+
+  return 0;
+}
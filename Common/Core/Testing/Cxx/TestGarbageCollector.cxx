@@ -19,6 +19,8 @@
 #include "vtkObject.h"
 #include "vtkSmartPointer.h"
 
+#include <thread>
+
 // A class that simulates a reference loop and participates in garbage
 // collection.
 class vtkTestReferenceLoop : public vtkObject
@@ -114,5 +116,27 @@ int TestGarbageCollector(int, char*[])
     return 1;
   }
 
+  // Release the last reference from a worker thread with worker thread
+  // deferral enabled.  The object should be collected only when the
+  // main thread calls Collect.
+  obj = vtkTestReferenceLoop::New();
+  obj->AddObserver(vtkCommand::DeleteEvent, cc);
+  vtkGarbageCollector::SetWorkerThreadDeferral(true);
+  called = 0;
+  std::thread worker([obj]() { obj->Delete(); });
+  worker.join();
+  if (called)
+  {
+    cerr << "Worker thread collection not deferred." << endl;
+    return 1;
+  }
+  vtkGarbageCollector::Collect();
+  vtkGarbageCollector::SetWorkerThreadDeferral(false);
+  if (!called)
+  {
+    cerr << "Collect did not collect object released by worker thread." << endl;
+    return 1;
+  }
+
   return 0;
 }
@@ -73,6 +73,7 @@ public:
   void SetValue(vtkIdType valueIdx, ValueType value)
     VTK_EXPECTS(0 <= valueIdx && valueIdx < GetNumberOfValues())
   {
+    this->DetachSharedBuffer();
     this->Buffer->GetBuffer()[valueIdx] = value;
   }
 
@@ -96,6 +97,7 @@ public:
   void SetTypedTuple(vtkIdType tupleIdx, const ValueType* tuple)
     VTK_EXPECTS(0 <= tupleIdx && tupleIdx < GetNumberOfTuples())
   {
+    this->DetachSharedBuffer();
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     std::copy(tuple, tuple + this->NumberOfComponents, this->Buffer->GetBuffer() + valueIdx);
   }
@@ -172,7 +174,10 @@ public:
    * VTK_DATA_ARRAY_FREE, free() will be used. If the delete method is
    * VTK_DATA_ARRAY_DELETE, delete[] will be used. If the delete method is
    * VTK_DATA_ARRAY_ALIGNED_FREE _aligned_free() will be used on Windows, while
-   * free() will be used everywhere else. The default is FREE.
+   * free() will be used everywhere else. The default is FREE. When @a array
+   * is the memory this array allocated, the delete method is ignored and the
+   * memory is released by the Free function of its allocator, which
+   * GetArrayFreeFunction() returns.
    */
   void SetArray(VTK_ZEROCOPY ValueType* array, vtkIdType size, int save, int deleteMethod);
   void SetArray(VTK_ZEROCOPY ValueType* array, vtkIdType size, int save);
@@ -184,10 +189,81 @@ public:
    * This method allows the user to specify a custom free function to be
    * called when the array is deallocated. Calling this method will implicitly
    * mean that the given free function will be called when the class
-   * cleans up or reallocates memory.
+   * cleans up or reallocates memory. Memory allocated by this array is
+   * still released by the Free function of its allocator.
    **/
   void SetArrayFreeFunction(void (*callback)(void*)) override;
 
+  /**
+   * Return the function that releases the memory of this array. Code taking
+   * over the memory, e.g. with SetArray(GetPointer(0), size, 1), must release
+   * it with this function rather than free(): memory allocated with an
+   * aligned allocator is not compatible with free() on Windows.
+   */
+  vtkBufferAllocator::FreeFunctionType GetArrayFreeFunction() const
+  {
+    return this->Buffer->GetFreeFunction();
+  }
+
+  //@{
+  /**
+   * Enable/disable copy-on-write semantics for the buffer held by this
+   * array. When enabled, arrays sharing the buffer through ShallowCopy()
+   * keep sharing it until one of them is modified through the array API
+   * (SetValue, SetTypedTuple, SetTuple, Insert*, Fill*, WritePointer,
+   * SetArray or any reallocation); that array then replaces the buffer by
+   * a private copy and the other sharers are left untouched. The setting
+   * is a property of the buffer, so it applies to every array sharing it,
+   * and ShallowCopy() enables it on the shared buffer if either array had
+   * it enabled.
+   *
+   * @warning Copy-on-write is limited to the array API above. Writes
+   * through GetPointer(), GetVoidPointer(), the Begin()/End() iterators and
+   * vtk::DataArrayValueRange() or vtk::DataArrayTupleRange() bypass the
+   * check and change every sharer; see vtkBuffer::SetCopyOnWrite() for the
+   * complete list. Call DetachSharedBuffer() before writing through them,
+   * or use WritePointer() for raw write access.
+   *
+   * @warning The detach replaces the buffer of the array and is not
+   * synchronized. Concurrent writers, such as the threads of a
+   * vtkSMPTools::For() writing to disjoint ranges of the array, must not
+   * trigger it: call DetachSharedBuffer() once before the parallel writes
+   * begin.
+   */
+  void SetCopyOnWrite(bool copyOnWrite) { this->Buffer->SetCopyOnWrite(copyOnWrite); }
+  bool GetCopyOnWrite() const { return this->Buffer->GetCopyOnWrite(); }
+  vtkBooleanMacro(CopyOnWrite, bool);
+  //@}
+
+  /**
+   * Replace a shared copy-on-write buffer by a private copy, so that the
+   * array can be modified without affecting the other sharers. Every write
+   * through the array API does this first; it does nothing in the common,
+   * unshared case. Call it from a single thread before writing to the
+   * array from several threads.
+   */
+  void DetachSharedBuffer()
+  {
+    if (this->IsBufferShared())
+    {
+      this->ReplaceBuffer(this->Size, this->MaxId + 1);
+    }
+  }
+
+  //@{
+  /**
+   * Set/Get the allocation policy used for the memory of this array, e.g.
+   * vtkBufferAllocator::GetAlignedAllocator(). It takes effect at the next
+   * allocation. Arrays use vtkBufferAllocator::GetGlobalAllocator() by
+   * default, and passing nullptr selects it again. The memory allocated by
+   * an allocator is always released by its Free function: if the memory is
+   * handed over to other code with SetArray(..., save = 1), release it with
+   * GetArrayFreeFunction(), never with free().
+   */
+  void SetAllocator(const vtkBufferAllocator* allocator) { this->Buffer->SetAllocator(allocator); }
+  const vtkBufferAllocator* GetAllocator() const { return this->Buffer->GetAllocator(); }
+  //@}
+
   // Overridden for optimized implementations:
   void SetTuple(vtkIdType tupleIdx, const float* tuple) override;
   void SetTuple(vtkIdType tupleIdx, const double* tuple) override;
@@ -294,6 +370,21 @@ protected:
    */
   bool ReallocateTuples(vtkIdType numTuples);
 
+  /**
+   * Returns true if the buffer uses copy-on-write semantics and is
+   * currently shared with other arrays.
+   */
+  bool IsBufferShared() const
+  {
+    return this->Buffer->GetCopyOnWrite() && this->Buffer->GetReferenceCount() > 1;
+  }
+
+  /**
+   * Replace the buffer by a new private buffer holding @a numValues values,
+   * the first @a numValuesToCopy of which are copied from the old buffer.
+   */
+  bool ReplaceBuffer(vtkIdType numValues, vtkIdType numValuesToCopy);
+
   vtkBuffer<ValueType>* Buffer;
 
 private:
@@ -45,6 +45,11 @@ template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetArray(
   ValueType* array, vtkIdType size, int save, int deleteMethod)
 {
+  // Do not release the memory of a buffer other arrays still use.
+  if (this->IsBufferShared())
+  {
+    this->ReplaceBuffer(0, 0);
+  }
 
   this->Buffer->SetBuffer(array, size);
 
@@ -103,6 +108,8 @@ void vtkAOSDataArrayTemplate<ValueType>::SetArrayFreeFunction(void (*callback)(v
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const float* tuple)
 {
+  this->DetachSharedBuffer();
+
   // While std::copy is the obvious choice here, it kills performance on MSVC
   // debugging builds as their STL calls are poorly optimized. Just use a for
   // loop instead.
@@ -117,6 +124,8 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const flo
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::SetTuple(vtkIdType tupleIdx, const double* tuple)
 {
+  this->DetachSharedBuffer();
+
   // See note in SetTuple about std::copy vs for loops on MSVC.
   ValueTypeT* data = this->Buffer->GetBuffer() + tupleIdx * this->NumberOfComponents;
   for (int i = 0; i < this->NumberOfComponents; ++i)
@@ -131,6 +140,8 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
 {
   if (this->EnsureAccessToTuple(tupleIdx))
   {
+    this->DetachSharedBuffer();
+
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
@@ -148,6 +159,8 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuple(vtkIdType tupleIdx, const
 {
   if (this->EnsureAccessToTuple(tupleIdx))
   {
+    this->DetachSharedBuffer();
+
     // See note in SetTuple about std::copy vs for loops on MSVC.
     const vtkIdType valueIdx = tupleIdx * this->NumberOfComponents;
     ValueTypeT* data = this->Buffer->GetBuffer() + valueIdx;
@@ -172,6 +185,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertComponent(
       return;
     }
   }
+  this->DetachSharedBuffer();
 
   this->Buffer->GetBuffer()[newMaxId] = static_cast<ValueTypeT>(value);
   this->MaxId = std::max(newMaxId, this->MaxId);
@@ -190,6 +204,7 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const float* tupl
       return -1;
     }
   }
+  this->DetachSharedBuffer();
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
   ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
@@ -214,6 +229,7 @@ vtkIdType vtkAOSDataArrayTemplate<ValueTypeT>::InsertNextTuple(const double* tup
       return -1;
     }
   }
+  this->DetachSharedBuffer();
 
   // See note in SetTuple about std::copy vs for loops on MSVC.
   ValueTypeT* data = this->Buffer->GetBuffer() + this->MaxId + 1;
@@ -274,9 +290,12 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::ShallowCopy(vtkDataArray* other)
     this->CopyComponentNames(o);
     if (this->Buffer != o->Buffer)
     {
+      // Keep copy-on-write semantics if either array requested them.
+      const bool copyOnWrite = this->Buffer->GetCopyOnWrite() || o->Buffer->GetCopyOnWrite();
       this->Buffer->Delete();
       this->Buffer = o->Buffer;
       this->Buffer->Register(nullptr);
+      this->Buffer->SetCopyOnWrite(copyOnWrite);
     }
     this->DataChanged();
   }
@@ -335,6 +354,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::InsertTuples(
       return;
     }
   }
+  this->DetachSharedBuffer();
 
   this->MaxId = std::max(this->MaxId, newSize - 1);
 
@@ -363,6 +383,7 @@ void vtkAOSDataArrayTemplate<ValueTypeT>::FillTypedComponent(int compIdx, ValueT
 template <class ValueTypeT>
 void vtkAOSDataArrayTemplate<ValueTypeT>::FillValue(ValueType value)
 {
+  this->DetachSharedBuffer();
   std::ptrdiff_t offset = this->MaxId + 1;
   std::fill(this->Buffer->GetBuffer(), this->Buffer->GetBuffer() + offset, value);
 }
@@ -388,6 +409,7 @@ vtkAOSDataArrayTemplate<ValueTypeT>::WritePointer(vtkIdType valueIdx, vtkIdType
     }
     this->MaxId = (newSize - 1);
   }
+  this->DetachSharedBuffer();
 
   // For extending the in-use ids but not the size:
   this->MaxId = std::max(this->MaxId, newSize - 1);
@@ -423,6 +445,16 @@ template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 {
   vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->IsBufferShared())
+  {
+    // Old data is not preserved, so there is nothing to copy.
+    if (this->ReplaceBuffer(numValues, 0))
+    {
+      this->Size = this->Buffer->GetSize();
+      return true;
+    }
+    return false;
+  }
   if (this->Buffer->Allocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
@@ -435,7 +467,17 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::AllocateTuples(vtkIdType numTuples)
 template <class ValueTypeT>
 bool vtkAOSDataArrayTemplate<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
 {
-  if (this->Buffer->Reallocate(numTuples * this->GetNumberOfComponents()))
+  vtkIdType numValues = numTuples * this->GetNumberOfComponents();
+  if (this->IsBufferShared())
+  {
+    if (this->ReplaceBuffer(numValues, std::min(numValues, this->MaxId + 1)))
+    {
+      this->Size = this->Buffer->GetSize();
+      return true;
+    }
+    return false;
+  }
+  if (this->Buffer->Reallocate(numValues))
   {
     this->Size = this->Buffer->GetSize();
     return true;
@@ -443,4 +485,31 @@ bool vtkAOSDataArrayTemplate<ValueTypeT>::ReallocateTuples(vtkIdType numTuples)
   return false;
 }
 
+//-----------------------------------------------------------------------------
+template <class ValueTypeT>
+bool vtkAOSDataArrayTemplate<ValueTypeT>::ReplaceBuffer(
+  vtkIdType numValues, vtkIdType numValuesToCopy)
+{
+  vtkBuffer<ValueType>* buffer = vtkBuffer<ValueType>::New();
+  buffer->SetAllocator(this->Buffer->GetAllocator());
+  if (!buffer->Allocate(numValues))
+  {
+    vtkErrorMacro("Failed to allocate a private copy of a shared buffer.");
+    buffer->Delete();
+    return false;
+  }
+  buffer->SetCopyOnWrite(this->Buffer->GetCopyOnWrite());
+
+  numValuesToCopy = std::min(numValuesToCopy, std::min(numValues, this->Buffer->GetSize()));
+  if (numValuesToCopy > 0)
+  {
+    const ValueType* src = this->Buffer->GetBuffer();
+    std::copy(src, src + numValuesToCopy, buffer->GetBuffer());
+  }
+
+  this->Buffer->Delete();
+  this->Buffer = buffer;
+  return true;
+}
+
 #endif // header guard
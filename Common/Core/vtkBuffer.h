@@ -20,11 +20,16 @@
  * vtkBuffer makes it easier to keep data pointers in vtkDataArray subclasses.
  * This is an internal class and not intended for direct use expect when writing
  * new types of vtkDataArray subclasses.
+ *
+ * Memory is obtained through a vtkBufferAllocator, which defaults to the
+ * global allocator at construction time (malloc/realloc/free unless changed
+ * with vtkBufferAllocator::SetGlobalAllocator()).
  */
 
 #ifndef vtkBuffer_h
 #define vtkBuffer_h
 
+#include "vtkBufferAllocator.h" // For vtkBufferAllocator
 #include "vtkObject.h"
 #include "vtkObjectFactory.h" // New() implementation
 
@@ -56,10 +61,20 @@ public:
    * Set the free function to be used when releasing this object.
    * If @a noFreeFunction is true, the buffer will not be freed when
    * this vtkBuffer object is deleted or resize -- otherwise, @a deleteFunction
-   * will be called to free the buffer
+   * will be called to free the buffer. Memory allocated by this object keeps
+   * the Free function of its allocator, whatever @a deleteFunction is: it is
+   * the only function that can release it.
    **/
   void SetFreeFunction(bool noFreeFunction, void (*deleteFunction)(void*) = free);
 
+  /**
+   * Return the function that releases the current buffer: the Free function
+   * of the allocator if this object allocated it, otherwise the last function
+   * given to SetFreeFunction(). Code taking over the buffer, e.g. after
+   * SetFreeFunction(true), must release it with this function.
+   */
+  vtkBufferAllocator::FreeFunctionType GetFreeFunction() const { return this->FreeFunction; }
+
   /**
    * Return the number of elements the current buffer can hold.
    */
@@ -76,19 +91,77 @@ public:
    */
   bool Reallocate(vtkIdType newsize);
 
+  //@{
+  /**
+   * Set/Get the allocation policy used by subsequent calls to Allocate and
+   * Reallocate. Memory already held by the buffer keeps its free function.
+   * Passing nullptr selects vtkBufferAllocator::GetGlobalAllocator().
+   */
+  void SetAllocator(const vtkBufferAllocator* allocator)
+  {
+    this->Allocator = allocator ? allocator : vtkBufferAllocator::GetGlobalAllocator();
+  }
+  const vtkBufferAllocator* GetAllocator() const { return this->Allocator; }
+  //@}
+
+  //@{
+  /**
+   * Set/Get whether the arrays holding this buffer must replace it by a
+   * private copy before modifying it while it is shared with other arrays.
+   * The buffer is shared when its reference count is greater than one.
+   *
+   * @warning Only the write methods of vtkAOSDataArrayTemplate replace the
+   * buffer. The following paths give direct access to the shared memory and
+   * skip the replacement, so writing through them changes every sharer:
+   * - GetBuffer() of this class;
+   * - GetPointer() and GetVoidPointer() of vtkAOSDataArrayTemplate, and
+   *   vtkDataArray::GetVoidPointer() on such arrays;
+   * - the Begin() and End() iterators of vtkAOSDataArrayTemplate;
+   * - vtk::DataArrayValueRange() and vtk::DataArrayTupleRange() over
+   *   vtkAOSDataArrayTemplate arrays, which use GetPointer();
+   * - every write to vtkSOADataArrayTemplate and
+   *   vtkScaledSOADataArrayTemplate, which do not implement copy-on-write.
+   * These accessors are also used to read, often from several threads at
+   * once, so they cannot replace the buffer themselves. Code writing
+   * through them must call vtkAOSDataArrayTemplate::DetachSharedBuffer()
+   * first, from a single thread, or use WritePointer().
+   */
+  void SetCopyOnWrite(bool copyOnWrite) { this->CopyOnWrite = copyOnWrite; }
+  bool GetCopyOnWrite() const { return this->CopyOnWrite; }
+  //@}
+
 protected:
   vtkBuffer()
     : Pointer(nullptr)
     , Size(0)
-    , DeleteFunction(free)
+    , Allocator(vtkBufferAllocator::GetGlobalAllocator())
+    , DeleteFunction(this->Allocator->Free)
+    , FreeFunction(this->Allocator->Free)
+    , Allocated(false)
+    , CopyOnWrite(false)
   {
   }
 
+  /**
+   * Allocate @a size elements with the current allocator, including the
+   * parallel first touch if the allocator requests it.
+   */
+  ScalarType* AllocateArray(vtkIdType size);
+
+  /**
+   * Take ownership of @a array, allocated by the current allocator.
+   */
+  void SetAllocatedBuffer(ScalarType* array, vtkIdType size);
+
   ~vtkBuffer() override { this->SetBuffer(nullptr, 0); }
 
   ScalarType* Pointer;
   vtkIdType Size;
+  const vtkBufferAllocator* Allocator;
   void (*DeleteFunction)(void*);
+  void (*FreeFunction)(void*);
+  bool Allocated;
+  bool CopyOnWrite;
 
 private:
   vtkBuffer(const vtkBuffer&) = delete;
@@ -112,6 +185,8 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
       this->DeleteFunction(this->Pointer);
     }
     this->Pointer = array;
+    this->FreeFunction = free;
+    this->Allocated = false;
   }
   this->Size = size;
 }
@@ -119,16 +194,44 @@ void vtkBuffer<ScalarT>::SetBuffer(typename vtkBuffer<ScalarT>::ScalarType* arra
 template <typename ScalarT>
 void vtkBuffer<ScalarT>::SetFreeFunction(bool noFreeFunction, void (*deleteFunction)(void*))
 {
+  if (!this->Allocated)
+  {
+    this->FreeFunction = deleteFunction;
+  }
   if (noFreeFunction)
   {
     this->DeleteFunction = nullptr;
   }
   else
   {
-    this->DeleteFunction = deleteFunction;
+    this->DeleteFunction = this->FreeFunction;
   }
 }
 
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+void vtkBuffer<ScalarT>::SetAllocatedBuffer(
+  typename vtkBuffer<ScalarT>::ScalarType* array, vtkIdType size)
+{
+  this->SetBuffer(array, size);
+  this->DeleteFunction = this->Allocator->Free;
+  this->FreeFunction = this->Allocator->Free;
+  this->Allocated = true;
+}
+
+//------------------------------------------------------------------------------
+template <typename ScalarT>
+typename vtkBuffer<ScalarT>::ScalarType* vtkBuffer<ScalarT>::AllocateArray(vtkIdType size)
+{
+  const size_t numBytes = static_cast<size_t>(size) * sizeof(ScalarType);
+  ScalarType* newArray = static_cast<ScalarType*>(this->Allocator->Allocate(numBytes));
+  if (newArray && this->Allocator->ParallelFirstTouch)
+  {
+    vtkBufferAllocator::ParallelTouch(newArray, numBytes);
+  }
+  return newArray;
+}
+
 //------------------------------------------------------------------------------
 template <typename ScalarT>
 bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
@@ -137,11 +240,10 @@ bool vtkBuffer<ScalarT>::Allocate(vtkIdType size)
   this->SetBuffer(nullptr, 0);
   if (size > 0)
   {
-    ScalarType* newArray = static_cast<ScalarType*>(malloc(size * sizeof(ScalarType)));
+    ScalarType* newArray = this->AllocateArray(size);
     if (newArray)
     {
-      this->SetBuffer(newArray, size);
-      this->DeleteFunction = free;
+      this->SetAllocatedBuffer(newArray, size);
       return true;
     }
     return false;
@@ -158,24 +260,27 @@ bool vtkBuffer<ScalarT>::Reallocate(vtkIdType newsize)
     return this->Allocate(0);
   }
 
-  if (this->Pointer && this->DeleteFunction != free)
+  if (!this->Allocator->Reallocate ||
+    (this->Pointer && this->DeleteFunction != this->Allocator->Free))
   {
-    ScalarType* newArray = static_cast<ScalarType*>(malloc(newsize * sizeof(ScalarType)));
+    ScalarType* newArray = this->AllocateArray(newsize);
     if (!newArray)
     {
       return false;
     }
-    std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize), newArray);
+    if (this->Pointer)
+    {
+      std::copy(this->Pointer, this->Pointer + std::min(this->Size, newsize), newArray);
+    }
     // now save the new array and release the old one too.
-    this->SetBuffer(newArray, newsize);
-    this->DeleteFunction = free;
+    this->SetAllocatedBuffer(newArray, newsize);
   }
   else
   {
     // Try to reallocate with minimal memory usage and possibly avoid
     // copying.
-    ScalarType* newArray =
-      static_cast<ScalarType*>(realloc(this->Pointer, newsize * sizeof(ScalarType)));
+    ScalarType* newArray = static_cast<ScalarType*>(
+      this->Allocator->Reallocate(this->Pointer, newsize * sizeof(ScalarType)));
     if (!newArray)
     {
       return false;
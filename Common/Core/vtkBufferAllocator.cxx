@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferAllocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBufferAllocator.h"
+
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <malloc.h> // For _aligned_malloc
+#else
+#include <sys/mman.h> // For madvise
+#endif
+
+namespace
+{
+// Cache line size targeted by the aligned policies.
+const size_t CacheLineSize = 64;
+
+// Size and alignment of transparent huge pages on common platforms.
+const size_t HugePageSize = 2 * 1024 * 1024;
+
+// Granularity of the parallel first touch.
+const size_t PageSize = 4096;
+
+//------------------------------------------------------------------------------
+void* AlignedAllocate(size_t numBytes, size_t alignment)
+{
+#ifdef _WIN32
+  return _aligned_malloc(numBytes, alignment);
+#else
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, numBytes) != 0)
+  {
+    return nullptr;
+  }
+  return ptr;
+#endif
+}
+
+//------------------------------------------------------------------------------
+void* CacheLineAllocate(size_t numBytes)
+{
+  return AlignedAllocate(numBytes, CacheLineSize);
+}
+
+//------------------------------------------------------------------------------
+void AlignedFree(void* ptr)
+{
+#ifdef _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+//------------------------------------------------------------------------------
+void* HugePageAllocate(size_t numBytes)
+{
+  if (numBytes < HugePageSize)
+  {
+    return CacheLineAllocate(numBytes);
+  }
+
+  void* ptr = AlignedAllocate(numBytes, HugePageSize);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (ptr)
+  {
+    // Only a hint: failure leaves regular pages in place.
+    madvise(ptr, numBytes, MADV_HUGEPAGE);
+  }
+#endif
+  return ptr;
+}
+
+//------------------------------------------------------------------------------
+void* FirstTouchAllocate(size_t numBytes)
+{
+  // Page aligned so that no page is shared by two work items.
+  return AlignedAllocate(numBytes, PageSize);
+}
+
+//------------------------------------------------------------------------------
+struct ParallelTouchFunctor
+{
+  unsigned char* Data;
+  size_t NumberOfBytes;
+
+  void operator()(vtkIdType beginPage, vtkIdType endPage) const
+  {
+    const size_t begin = static_cast<size_t>(beginPage) * PageSize;
+    const size_t end = std::min(static_cast<size_t>(endPage) * PageSize, this->NumberOfBytes);
+    memset(this->Data + begin, 0, end - begin);
+  }
+};
+
+const vtkBufferAllocator DefaultAllocator = { malloc, realloc, free, false };
+const vtkBufferAllocator AlignedAllocator = { CacheLineAllocate, nullptr, AlignedFree, false };
+const vtkBufferAllocator HugePageAllocator = { HugePageAllocate, nullptr, AlignedFree, false };
+const vtkBufferAllocator FirstTouchAllocator = { FirstTouchAllocate, nullptr, AlignedFree, true };
+
+std::atomic<const vtkBufferAllocator*> GlobalAllocator(&DefaultAllocator);
+}
+
+//------------------------------------------------------------------------------
+const vtkBufferAllocator* vtkBufferAllocator::GetDefaultAllocator()
+{
+  return &DefaultAllocator;
+}
+
+//------------------------------------------------------------------------------
+const vtkBufferAllocator* vtkBufferAllocator::GetAlignedAllocator()
+{
+  return &AlignedAllocator;
+}
+
+//------------------------------------------------------------------------------
+const vtkBufferAllocator* vtkBufferAllocator::GetHugePageAllocator()
+{
+  return &HugePageAllocator;
+}
+
+//------------------------------------------------------------------------------
+const vtkBufferAllocator* vtkBufferAllocator::GetFirstTouchAllocator()
+{
+  return &FirstTouchAllocator;
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferAllocator::SetGlobalAllocator(const vtkBufferAllocator* allocator)
+{
+  GlobalAllocator.store(allocator ? allocator : &DefaultAllocator);
+}
+
+//------------------------------------------------------------------------------
+const vtkBufferAllocator* vtkBufferAllocator::GetGlobalAllocator()
+{
+  return GlobalAllocator.load();
+}
+
+//------------------------------------------------------------------------------
+void vtkBufferAllocator::ParallelTouch(void* ptr, size_t numBytes)
+{
+  if (!ptr || numBytes == 0)
+  {
+    return;
+  }
+  ParallelTouchFunctor functor;
+  functor.Data = static_cast<unsigned char*>(ptr);
+  functor.NumberOfBytes = numBytes;
+  const vtkIdType numPages = static_cast<vtkIdType>((numBytes + PageSize - 1) / PageSize);
+  vtkSMPTools::For(0, numPages, functor);
+}
@@ -0,0 +1,117 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBufferAllocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBufferAllocator
+ * @brief   memory allocation policy used by vtkBuffer.
+ *
+ * vtkBufferAllocator bundles the functions vtkBuffer uses to obtain,
+ * resize and release the memory of data arrays. A few policies are
+ * provided:
+ *
+ * - GetDefaultAllocator(): malloc, realloc and free.
+ * - GetAlignedAllocator(): 64-byte (cache line) aligned blocks.
+ * - GetHugePageAllocator(): blocks of at least 2 MiB are aligned on
+ *   2 MiB and, on Linux, advised for transparent huge pages with
+ *   madvise(MADV_HUGEPAGE). Smaller blocks behave as the aligned policy.
+ * - GetFirstTouchAllocator(): page aligned blocks whose pages are
+ *   zero-initialized in parallel with vtkSMPTools right after allocation.
+ *   On NUMA systems with a first-touch placement policy this places each
+ *   page on the node of the thread that will later process it in a
+ *   vtkSMPTools loop over the array.
+ *
+ * Custom policies can be defined by filling a vtkBufferAllocator. The
+ * Reallocate function may be nullptr, in which case vtkBuffer allocates a
+ * new block and copies the data. An allocator must outlive every buffer
+ * that uses it.
+ *
+ * A block can only be released by the Free function of the allocator that
+ * allocated it; on Windows, the aligned policies use _aligned_malloc, which
+ * free() cannot release. vtkBuffer keeps this function when its memory is
+ * handed over, see vtkBuffer::GetFreeFunction() and
+ * vtkAOSDataArrayTemplate::GetArrayFreeFunction().
+ *
+ * The global allocator, used by buffers created afterwards, defaults to
+ * GetDefaultAllocator() and can be changed with SetGlobalAllocator().
+ *
+ * @sa
+ * vtkBuffer vtkAOSDataArrayTemplate
+ */
+
+#ifndef vtkBufferAllocator_h
+#define vtkBufferAllocator_h
+
+#include "vtkCommonCoreModule.h" // For export macro
+#include "vtkSystemIncludes.h"
+
+#include <cstddef> // For size_t
+
+class VTKCOMMONCORE_EXPORT vtkBufferAllocator
+{
+public:
+  typedef void* (*AllocateFunctionType)(size_t numBytes);
+  typedef void* (*ReallocateFunctionType)(void* ptr, size_t numBytes);
+  typedef void (*FreeFunctionType)(void* ptr);
+
+  /**
+   * Allocate a block of @a numBytes bytes. Returns nullptr on failure.
+   */
+  AllocateFunctionType Allocate;
+
+  /**
+   * Resize a block allocated by Allocate, preserving its content. May be
+   * nullptr when the policy cannot resize in place.
+   */
+  ReallocateFunctionType Reallocate;
+
+  /**
+   * Release a block allocated by Allocate or Reallocate.
+   */
+  FreeFunctionType Free;
+
+  /**
+   * When true, newly allocated blocks are zero-initialized page by page in
+   * parallel with vtkSMPTools.
+   */
+  bool ParallelFirstTouch;
+
+  //@{
+  /**
+   * Built-in allocation policies. See the class documentation.
+   */
+  static const vtkBufferAllocator* GetDefaultAllocator();
+  static const vtkBufferAllocator* GetAlignedAllocator();
+  static const vtkBufferAllocator* GetHugePageAllocator();
+  static const vtkBufferAllocator* GetFirstTouchAllocator();
+  //@}
+
+  //@{
+  /**
+   * Set/Get the allocator used by buffers created from now on. Passing
+   * nullptr restores the default allocator.
+   */
+  static void SetGlobalAllocator(const vtkBufferAllocator* allocator);
+  static const vtkBufferAllocator* GetGlobalAllocator();
+  //@}
+
+  /**
+   * Write zeros to the @a numBytes bytes starting at @a ptr using
+   * vtkSMPTools, one memory page per work item, so that each page is first
+   * touched by the thread that the same partitioning would assign it to.
+   */
+  static void ParallelTouch(void* ptr, size_t numBytes);
+};
+
+#endif
+// VTK-HeaderTest-Exclude: vtkBufferAllocator.h
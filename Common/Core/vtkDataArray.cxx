@@ -51,6 +51,17 @@
 namespace
 {
 
+// The workers below write to the destination through raw pointers and
+// ranges, which skip the copy-on-write check of vtkAOSDataArrayTemplate, so
+// they detach a shared destination buffer before writing.
+template <typename ValueT>
+void DetachSharedBuffer(vtkAOSDataArrayTemplate<ValueT>* array)
+{
+  array->DetachSharedBuffer();
+}
+
+void DetachSharedBuffer(vtkDataArray*) {}
+
 //--------Copy tuples from src to dest------------------------------------------
 struct DeepCopyWorker
 {
@@ -59,6 +70,7 @@ struct DeepCopyWorker
   void operator()(
     vtkAOSDataArrayTemplate<ValueType>* src, vtkAOSDataArrayTemplate<ValueType>* dst) const
   {
+    DetachSharedBuffer(dst);
     std::copy(src->Begin(), src->End(), dst->Begin());
   }
 
@@ -114,6 +126,7 @@ struct DeepCopyWorker
   template <typename SrcArrayT, typename DstArrayT>
   void DoGenericCopy(SrcArrayT* src, DstArrayT* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcRange = vtk::DataArrayValueRange(src);
     auto dstRange = vtk::DataArrayValueRange(dst);
 
@@ -238,6 +251,7 @@ struct GetTuplesFromListWorker
   template <typename Array1T, typename Array2T>
   void operator()(Array1T* src, Array2T* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcTuples = vtk::DataArrayTupleRange(src);
     auto dstTuples = vtk::DataArrayTupleRange(dst);
 
@@ -267,6 +281,7 @@ struct GetTuplesRangeWorker
   template <typename Array1T, typename Array2T>
   void operator()(Array1T* src, Array2T* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcTuples = vtk::DataArrayTupleRange(src);
     auto dstTuples = vtk::DataArrayTupleRange(dst);
 
@@ -277,6 +292,48 @@ struct GetTuplesRangeWorker
   }
 };
 
+//----------------CopyComponent------------------------------------------------
+template <typename SrcArrayT, typename DstArrayT>
+struct CopyComponentFunctor
+{
+  SrcArrayT* Src;
+  DstArrayT* Dst;
+  int SrcComponent;
+  int DstComponent;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const auto srcTuples = vtk::DataArrayTupleRange(this->Src, begin, end);
+    auto dstTuples = vtk::DataArrayTupleRange(this->Dst, begin, end);
+    const vtkIdType numTuples = end - begin;
+    for (vtkIdType t = 0; t < numTuples; ++t)
+    {
+      dstTuples[t][this->DstComponent] = srcTuples[t][this->SrcComponent];
+    }
+  }
+};
+
+struct CopyComponentWorker
+{
+  int SrcComponent;
+  int DstComponent;
+
+  CopyComponentWorker(int srcComponent, int dstComponent)
+    : SrcComponent(srcComponent)
+    , DstComponent(dstComponent)
+  {
+  }
+
+  template <typename SrcArrayT, typename DstArrayT>
+  void operator()(SrcArrayT* src, DstArrayT* dst) const
+  {
+    CopyComponentFunctor<SrcArrayT, DstArrayT> functor = { src, dst, this->SrcComponent,
+      this->DstComponent };
+    DetachSharedBuffer(dst);
+    vtkSMPTools::For(0, src->GetNumberOfTuples(), functor);
+  }
+};
+
 //----------------SetTuple (from array)-----------------------------------------
 struct SetTupleArrayWorker
 {
@@ -292,6 +349,7 @@ struct SetTupleArrayWorker
   template <typename SrcArrayT, typename DstArrayT>
   void operator()(SrcArrayT* src, DstArrayT* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcTuples = vtk::DataArrayTupleRange(src);
     auto dstTuples = vtk::DataArrayTupleRange(dst);
 
@@ -314,6 +372,7 @@ struct SetTuplesIdListWorker
   template <typename SrcArrayT, typename DstArrayT>
   void operator()(SrcArrayT* src, DstArrayT* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcTuples = vtk::DataArrayTupleRange(src);
     auto dstTuples = vtk::DataArrayTupleRange(dst);
 
@@ -347,6 +406,7 @@ struct SetTuplesRangeWorker
   template <typename SrcArrayT, typename DstArrayT>
   void operator()(SrcArrayT* src, DstArrayT* dst) const
   {
+    DetachSharedBuffer(dst);
     const auto srcTuples = vtk::DataArrayTupleRange(src);
     auto dstTuples = vtk::DataArrayTupleRange(dst);
 
@@ -1424,10 +1484,15 @@ void vtkDataArray::CopyComponent(int dstComponent, vtkDataArray* src, int srcCom
     return;
   }
 
-  vtkIdType i;
-  for (i = 0; i < this->GetNumberOfTuples(); i++)
+  CopyComponentWorker worker(srcComponent, dstComponent);
+  if (!vtkArrayDispatch::Dispatch2SameValueType::Execute(src, this, worker))
   {
-    this->SetComponent(i, dstComponent, src->GetComponent(i, srcComponent));
+    // Use fallback if dispatch fails.
+    vtkIdType i;
+    for (i = 0; i < this->GetNumberOfTuples(); i++)
+    {
+      this->SetComponent(i, dstComponent, src->GetComponent(i, srcComponent));
+    }
   }
 }
 
@@ -24,6 +24,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert> // for assert()
+#include <limits>
 #include <vector>
 
 namespace vtkDataArrayPrivate
@@ -98,6 +99,119 @@ bool isinf(T x)
 }
 }
 
+//----------------------------------------------------------------------------
+// Blocked range kernels. The values of a block of RangeBlockTuples tuples
+// are each compared against their own pair of accumulators, so the inner
+// loop carries no dependency from one value to the next and the compiler
+// turns it into packed min/max (and compare/blend for the finite variant)
+// instructions for the target instruction set. The accumulators are folded
+// into the per-component range at the end of the chunk. Comparisons are
+// written so that NaN values are ignored, as with detail::min/max.
+namespace detail
+{
+const int RangeBlockTuples = 16;
+
+template <typename APIType, bool Finite, bool HasInfinity = std::numeric_limits<APIType>::has_infinity>
+struct RangeUpdate
+{
+  static void Update(APIType value, APIType& low, APIType& high)
+  {
+    low = value < low ? value : low;
+    high = high < value ? value : high;
+  }
+};
+
+template <typename APIType>
+struct RangeUpdate<APIType, true, true>
+{
+  static void Update(APIType value, APIType& low, APIType& high)
+  {
+    const APIType inf = std::numeric_limits<APIType>::infinity();
+    low = (value < low && value > -inf) ? value : low;
+    high = (high < value && value < inf) ? value : high;
+  }
+};
+
+template <int NumComps, bool Finite, typename ArrayT, typename APIType>
+void BlockedMinAndMax(ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range)
+{
+  const auto values = vtk::DataArrayValueRange<NumComps>(array, begin * NumComps, end * NumComps);
+  const vtkIdType numValues = static_cast<vtkIdType>(values.size());
+
+  const int blockSize = NumComps * RangeBlockTuples;
+  APIType low[NumComps * RangeBlockTuples];
+  APIType high[NumComps * RangeBlockTuples];
+  for (int k = 0; k < blockSize; ++k)
+  {
+    low[k] = range[2 * (k % NumComps)];
+    high[k] = range[2 * (k % NumComps) + 1];
+  }
+
+  vtkIdType i = 0;
+  for (; i + blockSize <= numValues; i += blockSize)
+  {
+    for (int k = 0; k < blockSize; ++k)
+    {
+      RangeUpdate<APIType, Finite>::Update(values[i + k], low[k], high[k]);
+    }
+  }
+  // Remaining tuples; i is a multiple of NumComps here.
+  for (int k = 0; i < numValues; ++i, ++k)
+  {
+    RangeUpdate<APIType, Finite>::Update(values[i], low[k], high[k]);
+  }
+
+  for (int k = 0; k < blockSize; ++k)
+  {
+    const int j = 2 * (k % NumComps);
+    range[j] = min(range[j], low[k]);
+    range[j + 1] = max(range[j + 1], high[k]);
+  }
+}
+
+template <bool Finite, typename ArrayT, typename APIType>
+void BlockedMagnitudeMinAndMax(ArrayT* array, vtkIdType begin, vtkIdType end, APIType* range)
+{
+  const auto tuples = vtk::DataArrayTupleRange(array, begin, end);
+  const vtkIdType numTuples = static_cast<vtkIdType>(tuples.size());
+
+  APIType squaredSums[RangeBlockTuples];
+  APIType low[RangeBlockTuples];
+  APIType high[RangeBlockTuples];
+  for (int k = 0; k < RangeBlockTuples; ++k)
+  {
+    low[k] = range[0];
+    high[k] = range[1];
+  }
+
+  vtkIdType t = 0;
+  while (t < numTuples)
+  {
+    const int count = static_cast<int>(std::min<vtkIdType>(RangeBlockTuples, numTuples - t));
+    for (int k = 0; k < count; ++k)
+    {
+      APIType squaredSum = 0.0;
+      for (const APIType value : tuples[t + k])
+      {
+        squaredSum += value * value;
+      }
+      squaredSums[k] = squaredSum;
+    }
+    for (int k = 0; k < count; ++k)
+    {
+      RangeUpdate<APIType, Finite>::Update(squaredSums[k], low[k], high[k]);
+    }
+    t += count;
+  }
+
+  for (int k = 0; k < RangeBlockTuples; ++k)
+  {
+    range[0] = min(range[0], low[k]);
+    range[1] = max(range[1], high[k]);
+  }
+}
+}
+
 template <typename APIType, int NumComps>
 class MinAndMax
 {
@@ -158,18 +272,8 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      size_t j = 0;
-      for (const APIType value : tuple)
-      {
-        range[j] = detail::min(range[j], value);
-        range[j + 1] = detail::max(range[j + 1], value);
-        j += 2;
-      }
-    }
+    detail::BlockedMinAndMax<NumComps, false>(this->Array, begin, end, range.data());
   }
 };
 
@@ -191,21 +295,8 @@ public:
   void Reduce() { MinAndMaxT::Reduce(); }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange<NumComps>(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      size_t j = 0;
-      for (const APIType value : tuple)
-      {
-        if (!detail::isinf(value))
-        {
-          range[j] = detail::min(range[j], value);
-          range[j + 1] = detail::max(range[j + 1], value);
-        }
-        j += 2;
-      }
-    }
+    detail::BlockedMinAndMax<NumComps, true>(this->Array, begin, end, range.data());
   }
 };
 
@@ -236,18 +327,8 @@ public:
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      APIType squaredSum = 0.0;
-      for (const APIType value : tuple)
-      {
-        squaredSum += value * value;
-      }
-      range[0] = detail::min(range[0], squaredSum);
-      range[1] = detail::max(range[1], squaredSum);
-    }
+    detail::BlockedMagnitudeMinAndMax<false>(this->Array, begin, end, range.data());
   }
 };
 
@@ -278,21 +359,8 @@ public:
   }
   void operator()(vtkIdType begin, vtkIdType end)
   {
-    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
     auto& range = MinAndMaxT::TLRange.Local();
-    for (const auto tuple : tuples)
-    {
-      APIType squaredSum = 0.0;
-      for (const APIType value : tuple)
-      {
-        squaredSum += value * value;
-      }
-      if (!detail::isinf(squaredSum))
-      {
-        range[0] = detail::min(range[0], squaredSum);
-        range[1] = detail::max(range[1], squaredSum);
-      }
-    }
+    detail::BlockedMagnitudeMinAndMax<true>(this->Array, begin, end, range.data());
   }
 };
 
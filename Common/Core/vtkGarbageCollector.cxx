@@ -18,6 +18,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkSmartPointerBase.h"
 
+#include <atomic>
 #include <queue>
 #include <sstream>
 #include <stack>
@@ -75,6 +76,37 @@ static bool vtkGarbageCollectorGlobalDebugFlag;
 // handle it.
 static vtkMultiThreaderIDType vtkGarbageCollectorMainThread;
 
+//----------------------------------------------------------------------------
+// Global worker thread deferral setting.  When set, references released
+// by threads other than the main thread are pushed on the pending
+// reference stack below instead of triggering a collection check in
+// the releasing thread.
+static std::atomic<bool> vtkGarbageCollectorWorkerThreadDeferral(false);
+
+//----------------------------------------------------------------------------
+// Lock-free stack of references handed over by worker threads.  Any
+// thread may push; only the main thread removes entries, and it always
+// takes the whole stack at once, so no ABA problem can occur.
+struct vtkGarbageCollectorPendingReference
+{
+  vtkObjectBase* Object;
+  vtkGarbageCollectorPendingReference* Next;
+};
+static std::atomic<vtkGarbageCollectorPendingReference*> vtkGarbageCollectorPendingReferences(
+  nullptr);
+
+//----------------------------------------------------------------------------
+static void vtkGarbageCollectorPushPendingReference(vtkObjectBase* obj)
+{
+  vtkGarbageCollectorPendingReference* node = new vtkGarbageCollectorPendingReference;
+  node->Object = obj;
+  node->Next = vtkGarbageCollectorPendingReferences.load(std::memory_order_relaxed);
+  while (!vtkGarbageCollectorPendingReferences.compare_exchange_weak(
+    node->Next, node, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkGarbageCollector::vtkGarbageCollector() = default;
 
@@ -165,6 +197,9 @@ public:
   // Called by GiveReference to decide whether to accept a reference.
   vtkTypeBool CheckAccept();
 
+  // Move references pushed by worker threads into the References map.
+  void TakePendingReferences();
+
   // Push/Pop deferred collection.
   void DeferredCollectionPush();
   void DeferredCollectionPop();
@@ -835,6 +870,18 @@ void vtkGarbageCollectorImpl::FlushEntryReferences(Entry* e)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkGarbageCollector::SetWorkerThreadDeferral(bool flag)
+{
+  vtkGarbageCollectorWorkerThreadDeferral.store(flag);
+}
+
+//----------------------------------------------------------------------------
+bool vtkGarbageCollector::GetWorkerThreadDeferral()
+{
+  return vtkGarbageCollectorWorkerThreadDeferral.load();
+}
+
 //----------------------------------------------------------------------------
 void vtkGarbageCollector::ClassInitialize()
 {
@@ -857,7 +904,12 @@ void vtkGarbageCollector::ClassFinalize()
   // objects, they just will not have the option of deferred
   // collection.  In order to get it they need only to include
   // vtkGarbageCollectorManager.h so that this singleton stays around
-  // longer.
+  // longer.  References still pending from worker threads are
+  // collected first so that they are not leaked.
+  if (vtkGarbageCollectorPendingReferences.load() != nullptr)
+  {
+    vtkGarbageCollector::Collect();
+  }
   delete vtkGarbageCollectorSingletonInstance;
   vtkGarbageCollectorSingletonInstance = nullptr;
 }
@@ -874,6 +926,12 @@ void vtkGarbageCollector::Collect()
   // This must be called only from the main thread.
   assert(vtkGarbageCollectorIsMainThread());
 
+  // Account for references handed over by worker threads.
+  if (vtkGarbageCollectorSingletonInstance)
+  {
+    vtkGarbageCollectorSingletonInstance->TakePendingReferences();
+  }
+
   // Keep collecting until no deferred checks exist.
   while (vtkGarbageCollectorSingletonInstance &&
     vtkGarbageCollectorSingletonInstance->TotalNumberOfReferences > 0)
@@ -933,9 +991,19 @@ int vtkGarbageCollector::GiveReference(vtkObjectBase* obj)
   assert(obj != nullptr);
 
   // See if the singleton will accept a reference.
-  if (vtkGarbageCollectorIsMainThread() && vtkGarbageCollectorSingletonInstance)
+  if (vtkGarbageCollectorIsMainThread())
   {
-    return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
+    if (vtkGarbageCollectorSingletonInstance)
+    {
+      return vtkGarbageCollectorSingletonInstance->GiveReference(obj);
+    }
+  }
+  else if (vtkGarbageCollectorWorkerThreadDeferral.load(std::memory_order_relaxed))
+  {
+    // Hand the reference to the main thread without walking the
+    // reference graph here.
+    vtkGarbageCollectorPushPendingReference(obj);
+    return 1;
   }
 
   // Could not accept the reference.
@@ -1019,6 +1087,21 @@ int vtkGarbageCollectorSingleton::TakeReference(vtkObjectBase* obj)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+void vtkGarbageCollectorSingleton::TakePendingReferences()
+{
+  vtkGarbageCollectorPendingReference* node =
+    vtkGarbageCollectorPendingReferences.exchange(nullptr, std::memory_order_acquire);
+  while (node)
+  {
+    ++this->References[node->Object];
+    ++this->TotalNumberOfReferences;
+    vtkGarbageCollectorPendingReference* next = node->Next;
+    delete node;
+    node = next;
+  }
+}
+
 //----------------------------------------------------------------------------
 vtkTypeBool vtkGarbageCollectorSingleton::CheckAccept()
 {
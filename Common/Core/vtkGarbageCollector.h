@@ -136,6 +136,22 @@ public:
   static void DeferredCollectionPop();
   //@}
 
+  //@{
+  /**
+   * Set/Get whether references released from threads other than the
+   * main thread are deferred.  By default an UnRegister call on a
+   * collectable object from a worker thread performs an immediate
+   * reference graph walk in that thread.  When this flag is on, such
+   * references are instead pushed on a lock-free queue and handed to
+   * the main thread's collector the next time Collect() is called
+   * (directly or through DeferredCollectionPop).  Collect() must then
+   * be called from the main thread at a point where no other thread
+   * is modifying the objects that were released.
+   */
+  static void SetWorkerThreadDeferral(bool flag);
+  static bool GetWorkerThreadDeferral();
+  //@}
+
   //@{
   /**
    * Set/Get global garbage collection debugging flag.  When set to true,
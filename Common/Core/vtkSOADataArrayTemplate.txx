@@ -20,9 +20,38 @@
 
 #include "vtkArrayIteratorTemplate.h"
 #include "vtkBuffer.h"
+#include "vtkSMPTools.h"
 
 #include <cassert>
 
+namespace vtkSOADataArrayTemplatePrivate
+{
+// Interleave the component arrays into an AOS buffer. Each thread handles a
+// range of tuples one component at a time, streaming through one component
+// array per inner loop.
+template <class ValueType>
+struct ExportToAOS
+{
+  ValueType* const* Components;
+  ValueType* Output;
+  int NumberOfComponents;
+
+  void operator()(vtkIdType begin, vtkIdType end) const
+  {
+    const int numComps = this->NumberOfComponents;
+    for (int c = 0; c < numComps; ++c)
+    {
+      const ValueType* src = this->Components[c];
+      ValueType* dst = this->Output + c;
+      for (vtkIdType t = begin; t < end; ++t)
+      {
+        dst[t * numComps] = src[t];
+      }
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 template <class ValueType>
 vtkSOADataArrayTemplate<ValueType>* vtkSOADataArrayTemplate<ValueType>::New()
@@ -346,14 +375,17 @@ void vtkSOADataArrayTemplate<ValueType>::ExportToVoidPointer(void* voidPtr)
     return;
   }
 
-  ValueType* ptr = static_cast<ValueType*>(voidPtr);
-  for (vtkIdType t = 0; t < numTuples; ++t)
+  std::vector<ValueType*> components(this->NumberOfComponents);
+  for (int c = 0; c < this->NumberOfComponents; ++c)
   {
-    for (int c = 0; c < this->NumberOfComponents; ++c)
-    {
-      *ptr++ = this->Data[c]->GetBuffer()[t];
-    }
+    components[c] = this->Data[c]->GetBuffer();
   }
+
+  vtkSOADataArrayTemplatePrivate::ExportToAOS<ValueType> exporter;
+  exporter.Components = components.data();
+  exporter.Output = static_cast<ValueType*>(voidPtr);
+  exporter.NumberOfComponents = this->NumberOfComponents;
+  vtkSMPTools::For(0, numTuples, exporter);
 }
 
 #endif
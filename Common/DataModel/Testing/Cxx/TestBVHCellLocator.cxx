@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check vtkBVHCellLocator against vtkStaticCellLocator on a triangle mesh
+// (triangle fast path) and on a hexahedral grid (generic cells).
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+// A triangulated height field over [0,Resolution]^2.
+void MakeHeightField(vtkPolyData* surface, int resolution)
+{
+  const int np = resolution + 1;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < np; ++j)
+  {
+    for (int i = 0; i < np; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.5 * sin(0.3 * i) * cos(0.2 * j));
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < resolution; ++i)
+    {
+      const vtkIdType p0 = i + np * j;
+      const vtkIdType t0[3] = { p0, p0 + 1, p0 + 1 + np };
+      const vtkIdType t1[3] = { p0, p0 + 1 + np, p0 + np };
+      polys->InsertNextCell(3, t0);
+      polys->InsertNextCell(3, t1);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+// A resolution^3 grid of unit hexahedra.
+void MakeGrid(vtkUnstructuredGrid* grid, int resolution)
+{
+  const int np = resolution + 1;
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(resolution * resolution * resolution);
+  for (int k = 0; k < resolution; ++k)
+  {
+    for (int j = 0; j < resolution; ++j)
+    {
+      for (int i = 0; i < resolution; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType ids[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+      }
+    }
+  }
+}
+
+// Slightly tilted lines crossing the dataset from above, plus one line that
+// misses it. The number of lines is not a multiple of the packet size.
+void MakeLines(vtkPoints* p1s, vtkPoints* p2s, int resolution, double zmin, double zmax)
+{
+  const int n = 31;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const double x = (i + 0.37) * resolution / n;
+      const double y = (j + 0.61) * resolution / n;
+      p1s->InsertNextPoint(x, y, zmax);
+      p2s->InsertNextPoint(x + 0.13, y - 0.07, zmin);
+    }
+  }
+  p1s->InsertNextPoint(-5.0, -5.0, zmax);
+  p2s->InsertNextPoint(-5.0, -5.0, zmin);
+}
+
+int CompareIntersections(vtkDataSet* dataSet, vtkPoints* p1s, vtkPoints* p2s)
+{
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(dataSet);
+  bvh->BuildLocator();
+  vtkNew<vtkStaticCellLocator> reference;
+  reference->SetDataSet(dataSet);
+  reference->BuildLocator();
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> xs;
+  bvh->IntersectWithLines(p1s, p2s, 0.0, cellIds, ts, xs);
+
+  vtkNew<vtkGenericCell> cell;
+  const double tol = 0.0;
+  for (vtkIdType i = 0; i < p1s->GetNumberOfPoints(); ++i)
+  {
+    double p1[3], p2[3], t, x[3], pcoords[3], tRef, xRef[3], pcoordsRef[3];
+    int subId, subIdRef;
+    vtkIdType cellId = -1, cellIdRef = -1;
+    p1s->GetPoint(i, p1);
+    p2s->GetPoint(i, p2);
+    const int hit = bvh->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell);
+    const int hitRef =
+      reference->IntersectWithLine(p1, p2, tol, tRef, xRef, pcoordsRef, subIdRef, cellIdRef, cell);
+    if (hit != hitRef || (hit && (std::fabs(t - tRef) > 1e-9 || cellId != cellIdRef)))
+    {
+      cerr << "Line " << i << ": BVH hit " << hit << " cell " << cellId << " t " << t
+           << ", reference hit " << hitRef << " cell " << cellIdRef << " t " << tRef << endl;
+      return 1;
+    }
+    if (hit && (std::fabs(pcoords[0] - pcoordsRef[0]) > 1e-6 ||
+                 std::fabs(pcoords[1] - pcoordsRef[1]) > 1e-6))
+    {
+      cerr << "Line " << i << ": wrong parametric coordinates" << endl;
+      return 1;
+    }
+    const double tBatch = ts->GetValue(i);
+    if (cellIds->GetValue(i) != (hit ? cellId : -1) ||
+      (hit ? std::fabs(tBatch - t) > 1e-12 : tBatch != VTK_DOUBLE_MAX))
+    {
+      cerr << "Line " << i << ": batched and single intersections differ" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  const int resolution = 40;
+  vtkNew<vtkPolyData> surface;
+  MakeHeightField(surface, resolution);
+  vtkNew<vtkPoints> p1s;
+  vtkNew<vtkPoints> p2s;
+  MakeLines(p1s, p2s, resolution, -2.0, 2.0);
+  if (CompareIntersections(surface, p1s, p2s))
+  {
+    cerr << "Triangle mesh intersections failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid, 8);
+  vtkNew<vtkPoints> q1s;
+  vtkNew<vtkPoints> q2s;
+  MakeLines(q1s, q2s, 8, -1.0, 9.0);
+  if (CompareIntersections(grid, q1s, q2s))
+  {
+    cerr << "Hexahedral grid intersections failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // FindCell and FindCellsWithinBounds on the grid.
+  vtkNew<vtkBVHCellLocator> locator;
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+  double x[3] = { 3.5, 2.25, 6.75 }, pcoords[3], weights[8];
+  vtkNew<vtkGenericCell> cell;
+  vtkIdType cellId = locator->FindCell(x, 0.0, cell, pcoords, weights);
+  if (cellId != 3 + 8 * (2 + 8 * 6) || std::fabs(pcoords[1] - 0.25) > 1e-9)
+  {
+    cerr << "FindCell returned cell " << cellId << endl;
+    return EXIT_FAILURE;
+  }
+  x[0] = 9.5;
+  if (locator->FindCell(x, 0.0, cell, pcoords, weights) != -1)
+  {
+    cerr << "FindCell found a cell outside of the grid" << endl;
+    return EXIT_FAILURE;
+  }
+
+  double bbox[6] = { 1.5, 3.5, 0.5, 1.5, 6.5, 6.9 };
+  vtkNew<vtkIdList> cells;
+  locator->FindCellsWithinBounds(bbox, cells);
+  if (cells->GetNumberOfIds() != 3 * 2 * 1)
+  {
+    cerr << "FindCellsWithinBounds returned " << cells->GetNumberOfIds() << " cells" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkPolyData> representation;
+  locator->GenerateRepresentation(0, representation);
+  if (representation->GetNumberOfPoints() != 8 || representation->GetNumberOfCells() != 6)
+  {
+    cerr << "Wrong representation of the root node" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLocatorsConcurrentQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the queries of vtkCellLocator and vtkPointLocator issued from
+// vtkSMPTools give the same results as brute force searches, and that the
+// locators built in parallel keep the ids of each bucket in increasing order.
+
+#include "vtkCellArray.h"
+#include "vtkCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+const vtkIdType NumberOfQueries = 500;
+
+void RandomPoints(vtkPoints* points, vtkIdType numPts, double min, double max, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(min, max);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// A triangulated, wavy sheet over the unit square
+void MakeSurface(vtkPolyData* surface)
+{
+  const int res = 40;
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < res; ++j)
+  {
+    for (int i = 0; i < res; ++i)
+    {
+      const double x = static_cast<double>(i) / (res - 1);
+      const double y = static_cast<double>(j) / (res - 1);
+      points->InsertNextPoint(x, y, 0.5 + 0.2 * sin(6.0 * x) * cos(4.0 * y));
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < res - 1; ++j)
+  {
+    for (int i = 0; i < res - 1; ++i)
+    {
+      const vtkIdType p0 = i + j * res;
+      const vtkIdType tri0[3] = { p0, p0 + 1, p0 + res + 1 };
+      const vtkIdType tri1[3] = { p0, p0 + res + 1, p0 + res };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+// Smallest squared distance from x to the cells of the dataset
+double BruteForceDistance2(vtkDataSet* dataSet, const double x[3])
+{
+  vtkNew<vtkGenericCell> cell;
+  double minDist2 = VTK_DOUBLE_MAX;
+  for (vtkIdType cellId = 0; cellId < dataSet->GetNumberOfCells(); ++cellId)
+  {
+    double closest[3], pcoords[3], weights[3], dist2;
+    int subId;
+    dataSet->GetCell(cellId, cell);
+    cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights);
+    minDist2 = std::min(minDist2, dist2);
+  }
+  return minDist2;
+}
+
+// Check that the ids of each bucket are in increasing order
+int CheckSortedIds(vtkIdList* ids)
+{
+  if (ids && !std::is_sorted(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds()))
+  {
+    cerr << "The ids of a bucket are not sorted" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int TestCellLocator()
+{
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface);
+  vtkNew<vtkCellLocator> locator;
+  locator->SetDataSet(surface);
+  locator->SetNumberOfCellsPerBucket(4);
+  locator->BuildLocator();
+  for (int i = 0; i < locator->GetNumberOfBuckets(); ++i)
+  {
+    vtkIdList* ids = locator->GetCells(i);
+    if (ids != reinterpret_cast<vtkIdList*>(1) && CheckSortedIds(ids))
+    {
+      return 1;
+    }
+  }
+
+  vtkNew<vtkPoints> queries;
+  RandomPoints(queries, NumberOfQueries, -0.2, 1.2, 1);
+  vtkNew<vtkPoints> ends;
+  RandomPoints(ends, NumberOfQueries, -0.2, 1.2, 2);
+
+  // Run all the queries concurrently
+  const double radius = 0.1;
+  std::vector<double> closestDist2(NumberOfQueries);
+  std::vector<double> radiusDist2(NumberOfQueries);
+  std::vector<std::vector<vtkIdType> > alongLine(NumberOfQueries);
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPThreadLocalObject<vtkIdList> tlIds;
+  vtkSMPTools::For(0, NumberOfQueries, [&](vtkIdType begin, vtkIdType end) {
+    vtkGenericCell* cell = tlCell.Local();
+    vtkIdList* ids = tlIds.Local();
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      double x[3], y[3], closest[3], dist2;
+      vtkIdType cellId;
+      int subId, inside;
+      queries->GetPoint(q, x);
+      ends->GetPoint(q, y);
+      locator->FindClosestPoint(x, closest, cell, cellId, subId, closestDist2[q]);
+      radiusDist2[q] = locator->FindClosestPointWithinRadius(
+                         x, radius, closest, cell, cellId, subId, dist2, inside)
+        ? dist2
+        : -1.0;
+      locator->FindCellsAlongLine(x, y, 0.0, ids);
+      alongLine[q].assign(ids->GetPointer(0), ids->GetPointer(0) + ids->GetNumberOfIds());
+    }
+  });
+
+  // Compare with brute force, and with the serial queries
+  vtkNew<vtkIdList> ids;
+  for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+  {
+    double x[3], y[3];
+    queries->GetPoint(q, x);
+    ends->GetPoint(q, y);
+    const double expected = BruteForceDistance2(surface, x);
+    if (std::abs(closestDist2[q] - expected) > 1.0e-12)
+    {
+      cerr << "FindClosestPoint: wrong distance for query " << q << endl;
+      return 1;
+    }
+    const bool inRadius = expected <= radius * radius;
+    if (std::abs(expected - radius * radius) > 1.0e-9 &&
+      (inRadius != (radiusDist2[q] >= 0.0) ||
+        (inRadius && std::abs(radiusDist2[q] - expected) > 1.0e-12)))
+    {
+      cerr << "FindClosestPointWithinRadius: wrong result for query " << q << endl;
+      return 1;
+    }
+    locator->FindCellsAlongLine(x, y, 0.0, ids);
+    if (alongLine[q] != std::vector<vtkIdType>(ids->GetPointer(0),
+                          ids->GetPointer(0) + ids->GetNumberOfIds()))
+    {
+      cerr << "FindCellsAlongLine: concurrent and serial results differ for query " << q
+           << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int TestPointLocator()
+{
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, 5000, 0.0, 1.0, 3);
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+  vtkNew<vtkPointLocator> locator;
+  locator->SetDataSet(polyData);
+  locator->BuildLocator();
+
+  // Each point is in its bucket, and the buckets are sorted
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    int ijk[3];
+    vtkIdList* ids = locator->GetPointsInBucket(points->GetPoint(i), ijk);
+    if (!ids || ids->IsId(i) < 0 || CheckSortedIds(ids))
+    {
+      cerr << "Point " << i << " is missing from its bucket" << endl;
+      return 1;
+    }
+  }
+
+  vtkNew<vtkPoints> queries;
+  RandomPoints(queries, NumberOfQueries, -0.2, 1.2, 4);
+  std::vector<vtkIdType> closest(NumberOfQueries);
+  vtkSMPTools::For(0, NumberOfQueries, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType q = begin; q < end; ++q)
+    {
+      closest[q] = locator->FindClosestPoint(queries->GetPoint(q));
+    }
+  });
+  for (vtkIdType q = 0; q < NumberOfQueries; ++q)
+  {
+    double x[3];
+    queries->GetPoint(q, x);
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      minDist2 = std::min(minDist2, vtkMath::Distance2BetweenPoints(x, points->GetPoint(i)));
+    }
+    if (closest[q] < 0 ||
+      vtkMath::Distance2BetweenPoints(x, points->GetPoint(closest[q])) != minDist2)
+    {
+      cerr << "vtkPointLocator::FindClosestPoint: wrong point for query " << q << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestLocatorsConcurrentQueries(int, char*[])
+{
+  if (TestCellLocator() || TestPointLocator())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticHalfEdgeMesh.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the half-edges of a mesh of triangles and quads, having boundary
+// and non-manifold edges, against vtkPolyData::GetCellEdgeNeighbors().
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// A grid of n x n points, with quads in the first row of squares and pairs
+// of triangles elsewhere. A fin of triangles is attached to an edge of the
+// grid to make it non-manifold.
+void MakeMesh(vtkPolyData* pd, int n)
+{
+  vtkNew<vtkPoints> points;
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+    }
+  }
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < n - 1; ++j)
+  {
+    for (int i = 0; i < n - 1; ++i)
+    {
+      const vtkIdType p0 = j * n + i;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + n + 1, p0 + n };
+      if (j == 0)
+      {
+        polys->InsertNextCell(4, quad);
+      }
+      else
+      {
+        const vtkIdType tri0[3] = { quad[0], quad[1], quad[2] };
+        const vtkIdType tri1[3] = { quad[0], quad[2], quad[3] };
+        polys->InsertNextCell(3, tri0);
+        polys->InsertNextCell(3, tri1);
+      }
+    }
+  }
+  const vtkIdType top = points->InsertNextPoint(1.5, 1.5, 1.0);
+  const vtkIdType bottom = points->InsertNextPoint(1.5, 1.5, -1.0);
+  const vtkIdType fin0[3] = { n + 1, 2 * n + 2, top };
+  const vtkIdType fin1[3] = { 2 * n + 2, n + 1, bottom };
+  polys->InsertNextCell(3, fin0);
+  polys->InsertNextCell(3, fin1);
+
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+}
+
+template <typename TIds>
+int CheckHalfEdges(vtkPolyData* pd, const char* label)
+{
+  vtkStaticHalfEdgeMeshTemplate<TIds> halfEdges;
+  halfEdges.BuildHalfEdges(pd);
+  vtkCellArray* polys = pd->GetPolys();
+  if (halfEdges.GetCells() != polys || halfEdges.GetNumberOfCells() != pd->GetNumberOfCells() ||
+    halfEdges.GetNumberOfHalfEdges() != polys->GetNumberOfConnectivityIds())
+  {
+    cerr << label << ": wrong number of cells or half-edges" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkIdList> expected;
+  vtkNew<vtkIdList> neighbors;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  int numBoundary = 0, numNonManifold = 0;
+  for (vtkIdType cellId = 0; cellId < pd->GetNumberOfCells(); ++cellId)
+  {
+    pd->GetCellPoints(cellId, npts, pts);
+    if (halfEdges.GetCellSize(cellId) != npts)
+    {
+      cerr << label << ": wrong size of cell " << cellId << endl;
+      return 1;
+    }
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType p1 = pts[i];
+      const vtkIdType p2 = pts[(i + 1) % npts];
+      const TIds heId = halfEdges.GetCellHalfEdge(cellId) + static_cast<TIds>(i);
+      if (halfEdges.GetCell(heId) != cellId || halfEdges.GetOrigin(heId) != p1 ||
+        halfEdges.GetDestination(heId) != p2 ||
+        halfEdges.GetNext(halfEdges.GetPrevious(heId)) != heId ||
+        halfEdges.FindHalfEdge(cellId, p2, p1) != heId)
+      {
+        cerr << label << ": wrong half-edge " << heId << endl;
+        return 1;
+      }
+
+      // Every half-edge of the cycle lies on the edge
+      for (TIds mate = halfEdges.GetMate(heId); mate != heId; mate = halfEdges.GetMate(mate))
+      {
+        const TIds v0 = halfEdges.GetOrigin(mate);
+        const TIds v1 = halfEdges.GetDestination(mate);
+        if (!((v0 == p1 && v1 == p2) || (v0 == p2 && v1 == p1)))
+        {
+          cerr << label << ": half-edge " << mate << " is not on edge (" << p1 << "," << p2
+               << ")" << endl;
+          return 1;
+        }
+      }
+
+      // Same neighbors as the ones found with the links
+      pd->GetCellEdgeNeighbors(cellId, p1, p2, expected);
+      halfEdges.GetEdgeNeighbors(heId, neighbors);
+      std::vector<vtkIdType> a(expected->begin(), expected->end());
+      std::vector<vtkIdType> b(neighbors->begin(), neighbors->end());
+      std::sort(a.begin(), a.end());
+      std::sort(b.begin(), b.end());
+      if (a != b || halfEdges.GetNumberOfEdgeNeighbors(heId) != static_cast<TIds>(b.size()) ||
+        halfEdges.IsBoundary(heId) != a.empty() || halfEdges.IsManifold(heId) != (a.size() == 1))
+      {
+        cerr << label << ": wrong neighbors of edge (" << p1 << "," << p2 << ") of cell "
+             << cellId << endl;
+        return 1;
+      }
+      numBoundary += (a.empty() ? 1 : 0);
+      numNonManifold += (a.size() > 1 ? 1 : 0);
+    }
+  }
+
+  // The grid boundary, and the two fins along with the edge they share
+  const int n = 20;
+  if (numBoundary != 4 * (n - 1) + 4 || numNonManifold != 4)
+  {
+    cerr << label << ": found " << numBoundary << " boundary and " << numNonManifold
+         << " non-manifold half-edges" << endl;
+    return 1;
+  }
+
+  halfEdges.GetCellEdgeNeighbors(0, 0, n + 1, neighbors);
+  if (neighbors->GetNumberOfIds() != 0)
+  {
+    cerr << label << ": found neighbors of a diagonal" << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestStaticHalfEdgeMesh(int, char*[])
+{
+  vtkNew<vtkPolyData> pd;
+  MakeMesh(pd, 20);
+  pd->BuildLinks();
+
+  if (CheckHalfEdges<vtkIdType>(pd, "vtkIdType") || CheckHalfEdges<int>(pd, "int"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Both storages of the cell array
+  vtkCellArray* polys = pd->GetPolys();
+  if (polys->IsStorage64Bit() ? !polys->ConvertTo32BitStorage() : !polys->ConvertTo64BitStorage())
+  {
+    cerr << "Unable to convert the storage" << endl;
+    return EXIT_FAILURE;
+  }
+  if (CheckHalfEdges<vtkIdType>(pd, "Converted storage"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
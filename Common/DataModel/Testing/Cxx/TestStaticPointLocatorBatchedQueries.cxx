@@ -0,0 +1,190 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestStaticPointLocatorBatchedQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched FindClosestNPoints() and FindPointsWithinRadius()
+// of vtkStaticPointLocator match the single point queries.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+void RandomPoints(vtkPoints* points, vtkIdType numPts, int seed)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(seed);
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// Compare the neighbors of query q with the single point query result.
+// Sorted results must be in the same order, unsorted ones are compared as
+// sets.
+int CompareNeighbors(vtkIdType q, vtkIdTypeArray* offsets, vtkIdTypeArray* ids,
+  vtkDoubleArray* dist2s, vtkIdList* single, const double x[3], vtkPoints* points, bool sorted)
+{
+  const vtkIdType begin = offsets->GetValue(q);
+  const vtkIdType numIds = offsets->GetValue(q + 1) - begin;
+  if (numIds != single->GetNumberOfIds())
+  {
+    cerr << "Query " << q << ": " << numIds << " neighbors instead of "
+         << single->GetNumberOfIds() << endl;
+    return 1;
+  }
+  std::vector<vtkIdType> batched(ids->GetPointer(begin), ids->GetPointer(begin) + numIds);
+  std::vector<vtkIdType> expected(single->GetPointer(0), single->GetPointer(0) + numIds);
+  if (!sorted)
+  {
+    std::sort(batched.begin(), batched.end());
+    std::sort(expected.begin(), expected.end());
+  }
+  if (batched != expected)
+  {
+    cerr << "Query " << q << ": wrong neighbors" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < numIds; ++i)
+  {
+    double y[3];
+    points->GetPoint(ids->GetValue(begin + i), y);
+    if (dist2s->GetValue(begin + i) != vtkMath::Distance2BetweenPoints(x, y))
+    {
+      cerr << "Query " << q << ": wrong distance" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestStaticPointLocatorBatchedQueries(int, char*[])
+{
+  const vtkIdType numPts = 5000;
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, numPts, 1177);
+  vtkNew<vtkPolyData> polyData;
+  polyData->SetPoints(points);
+
+  vtkNew<vtkStaticPointLocator> locator;
+  locator->SetDataSet(polyData);
+  locator->BuildLocator();
+
+  vtkNew<vtkPoints> queries;
+  RandomPoints(queries, 3000, 8731);
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> ids;
+  vtkNew<vtkDoubleArray> dist2s;
+  vtkNew<vtkIdList> single;
+  const int N = 7;
+  const double R = 0.05;
+  double x[3];
+
+  // k nearest neighbors of arbitrary queries
+  locator->FindClosestNPoints(N, queries, offsets, ids, dist2s);
+  if (offsets->GetNumberOfValues() != queries->GetNumberOfPoints() + 1 ||
+    ids->GetNumberOfValues() != N * queries->GetNumberOfPoints())
+  {
+    cerr << "Wrong size of the k nearest neighbors" << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType q = 0; q < queries->GetNumberOfPoints(); ++q)
+  {
+    queries->GetPoint(q, x);
+    locator->FindClosestNPoints(N, x, single);
+    if (CompareNeighbors(q, offsets, ids, dist2s, single, x, points, true))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Points within a radius of arbitrary queries
+  locator->FindPointsWithinRadius(R, queries, offsets, ids, dist2s);
+  for (vtkIdType q = 0; q < queries->GetNumberOfPoints(); ++q)
+  {
+    queries->GetPoint(q, x);
+    locator->FindPointsWithinRadius(R, x, single);
+    if (CompareNeighbors(q, offsets, ids, dist2s, single, x, points, false))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  // k nearest neighbor graph of the dataset, each point is its own closest
+  // neighbor
+  locator->FindClosestNPoints(N, nullptr, offsets, ids, dist2s);
+  if (offsets->GetNumberOfValues() != numPts + 1)
+  {
+    cerr << "Wrong size of the k nearest neighbor graph" << endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType q = 0; q < numPts; ++q)
+  {
+    points->GetPoint(q, x);
+    locator->FindClosestNPoints(N, x, single);
+    if (CompareNeighbors(q, offsets, ids, dist2s, single, x, points, true) ||
+      ids->GetValue(offsets->GetValue(q)) != q)
+    {
+      cerr << "Wrong neighbors of point " << q << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Radius graph of the dataset
+  locator->FindPointsWithinRadius(R, nullptr, offsets, ids);
+  for (vtkIdType q = 0; q < numPts; ++q)
+  {
+    points->GetPoint(q, x);
+    locator->FindPointsWithinRadius(R, x, single);
+    if (offsets->GetValue(q + 1) - offsets->GetValue(q) != single->GetNumberOfIds())
+    {
+      cerr << "Wrong number of points within radius of point " << q << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // More neighbors than points
+  vtkNew<vtkPoints> few;
+  RandomPoints(few, 5, 3);
+  vtkNew<vtkPolyData> fewData;
+  fewData->SetPoints(few);
+  locator->SetDataSet(fewData);
+  locator->FindClosestNPoints(N, queries, offsets, ids);
+  if (ids->GetNumberOfValues() != 5 * queries->GetNumberOfPoints())
+  {
+    cerr << "Wrong number of neighbors in a small dataset" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
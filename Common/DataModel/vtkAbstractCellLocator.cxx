@@ -17,11 +17,142 @@
 
 #include "vtkCellArray.h"
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+//----------------------------------------------------------------------------
+// Batched FindCell(). Each thread has its own generic cell and weights.
+struct FindCellsFunctor
+{
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* Points;
+  vtkIdType* CellIds;
+  double* PCoords;
+  int NumberOfWeights;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double> > Weights;
+
+  FindCellsFunctor(vtkAbstractCellLocator* locator, vtkPoints* points, vtkIdType* cellIds,
+    double* pcoords, int numWeights)
+    : Locator(locator)
+    , Points(points)
+    , CellIds(cellIds)
+    , PCoords(pcoords)
+    , NumberOfWeights(numWeights)
+  {
+  }
+
+  void Initialize() { this->Weights.Local().resize(this->NumberOfWeights); }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double* weights = this->Weights.Local().data();
+    double x[3], pcoords[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->Points->GetPoint(i, x);
+      this->CellIds[i] = this->Locator->FindCell(x, 0.0, cell, pcoords, weights);
+      if (this->PCoords)
+      {
+        std::copy(pcoords, pcoords + 3, this->PCoords + 3 * i);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+// Batched IntersectWithLine(). Each thread has its own generic cell.
+struct IntersectWithLinesFunctor
+{
+  vtkAbstractCellLocator* Locator;
+  vtkPoints* P1s;
+  vtkPoints* P2s;
+  double Tolerance;
+  vtkIdType* CellIds;
+  double* Ts;
+  vtkPoints* Xs;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  IntersectWithLinesFunctor(vtkAbstractCellLocator* locator, vtkPoints* p1s, vtkPoints* p2s,
+    double tol, vtkIdType* cellIds, double* ts, vtkPoints* xs)
+    : Locator(locator)
+    , P1s(p1s)
+    , P2s(p2s)
+    , Tolerance(tol)
+    , CellIds(cellIds)
+    , Ts(ts)
+    , Xs(xs)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    double p1[3], p2[3], x[3], pcoords[3], t;
+    int subId;
+    vtkIdType cellId;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      this->P1s->GetPoint(i, p1);
+      this->P2s->GetPoint(i, p2);
+      cellId = -1;
+      if (!this->Locator->IntersectWithLine(
+            p1, p2, this->Tolerance, t, x, pcoords, subId, cellId, cell))
+      {
+        cellId = -1;
+        t = VTK_DOUBLE_MAX;
+        std::copy(p2, p2 + 3, x);
+      }
+      this->CellIds[i] = cellId;
+      if (this->Ts)
+      {
+        this->Ts[i] = t;
+      }
+      if (this->Xs)
+      {
+        this->Xs->SetPoint(i, x);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//----------------------------------------------------------------------------
+// Run the functor in parallel or serially.
+template <typename Functor>
+void ExecuteQueries(bool concurrent, vtkIdType numQueries, Functor& functor)
+{
+  if (concurrent)
+  {
+    vtkSMPTools::For(0, numQueries, functor);
+  }
+  else
+  {
+    functor.Initialize();
+    functor(0, numQueries);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 //----------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -51,10 +182,21 @@ bool vtkAbstractCellLocator::StoreCellBounds()
   // Allocate space for cell bounds storage, then fill
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+  // The first call to GetCellBounds() may build internal structures of the
+  // dataset (e.g., the cell links of vtkPolyData), do it serially.
+  vtkDataSet* ds = this->DataSet;
+  double(*cellBounds)[6] = this->CellBounds;
+  ds->GetCellBounds(0, cellBounds[0]);
+  vtkSMPTools::For(1, numCells, [ds, cellBounds](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType j = begin; j < end; j++)
+    {
+      ds->GetCellBounds(j, cellBounds[j]);
+    }
+  });
   return true;
 }
 //----------------------------------------------------------------------------
@@ -178,6 +320,79 @@ vtkIdType vtkAbstractCellLocator::FindCell(
   }
   return returnVal;
 }
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::PrepareForConcurrentQueries()
+{
+  if (this->DataSet && this->DataSet->GetNumberOfCells() > 0)
+  {
+    double bounds[6];
+    this->DataSet->GetCellBounds(0, bounds);
+    this->DataSet->GetCell(0, this->GenericCell);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::FindCells(
+  vtkPoints* points, vtkIdTypeArray* cellIds, vtkDoubleArray* pcoords)
+{
+  const vtkIdType numPts = points ? points->GetNumberOfPoints() : 0;
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numPts);
+  if (pcoords)
+  {
+    pcoords->SetNumberOfComponents(3);
+    pcoords->SetNumberOfTuples(numPts);
+  }
+  if (!this->DataSet || numPts == 0)
+  {
+    cellIds->FillValue(-1);
+    return;
+  }
+
+  this->PrepareForConcurrentQueries();
+  const int numWeights = std::max(this->DataSet->GetMaxCellSize(), 32);
+  FindCellsFunctor functor(this, points, cellIds->GetPointer(0),
+    pcoords ? pcoords->GetPointer(0) : nullptr, numWeights);
+  ExecuteQueries(this->SupportsConcurrentQueries(), numPts, functor);
+}
+
+//----------------------------------------------------------------------------
+void vtkAbstractCellLocator::IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* ts, vtkPoints* xs)
+{
+  const vtkIdType numLines = p1s ? p1s->GetNumberOfPoints() : 0;
+  if (!p2s || p2s->GetNumberOfPoints() != numLines)
+  {
+    vtkErrorMacro(<< "The two end point arrays must have the same number of points");
+    return;
+  }
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (xs)
+  {
+    xs->SetNumberOfPoints(numLines);
+  }
+  if (!this->DataSet || numLines == 0)
+  {
+    cellIds->FillValue(-1);
+    return;
+  }
+
+  this->PrepareForConcurrentQueries();
+  IntersectWithLinesFunctor functor(
+    this, p1s, p2s, tol, cellIds->GetPointer(0), ts ? ts->GetPointer(0) : nullptr, xs);
+  ExecuteQueries(this->SupportsConcurrentQueries(), numLines, functor);
+  if (xs)
+  {
+    xs->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkAbstractCellLocator::InsideCellBounds(double x[3], vtkIdType cell_ID)
 {
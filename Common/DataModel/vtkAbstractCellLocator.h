@@ -41,8 +41,10 @@
 #include "vtkLocator.h"
 
 class vtkCellArray;
+class vtkDoubleArray;
 class vtkGenericCell;
 class vtkIdList;
+class vtkIdTypeArray;
 class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractCellLocator : public vtkLocator
@@ -248,6 +250,39 @@ public:
   virtual vtkIdType FindCell(
     double x[3], double tol2, vtkGenericCell* GenCell, double pcoords[3], double* weights);
 
+  /**
+   * Batched version of FindCell(x). On return, @a cellIds holds for each
+   * point of @a points the id of the cell containing it, or -1, and
+   * @a pcoords (when not nullptr) the parametric coordinates of the point
+   * in that cell. The locator is built if needed, then the queries run in
+   * parallel with vtkSMPTools if SupportsConcurrentQueries() is true, and
+   * serially otherwise.
+   */
+  virtual void FindCells(
+    vtkPoints* points, vtkIdTypeArray* cellIds, vtkDoubleArray* pcoords = nullptr);
+
+  /**
+   * Batched version of IntersectWithLine(). Each line segment goes from
+   * the i-th point of @a p1s to the i-th point of @a p2s. On return,
+   * @a cellIds holds for each segment the id of the intersected cell, or -1,
+   * @a ts (when not nullptr) the parametric coordinate of the intersection
+   * along the segment, and @a xs (when not nullptr) the intersection point.
+   * For segments that hit nothing, ts is set to VTK_DOUBLE_MAX and xs to
+   * the end point of the segment. Queries run in parallel under the same
+   * conditions as FindCells().
+   */
+  virtual void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+    vtkIdTypeArray* cellIds, vtkDoubleArray* ts = nullptr, vtkPoints* xs = nullptr);
+
+  /**
+   * Return true if, once the locator is built, FindCell() and
+   * IntersectWithLine() taking a vtkGenericCell may be invoked concurrently
+   * on this instance from several threads, each thread providing its own
+   * vtkGenericCell. The batched queries rely on this to run in parallel.
+   * The default implementation returns false.
+   */
+  virtual bool SupportsConcurrentQueries() { return false; }
+
   /**
    * Quickly test if a point is inside the bounds of a particular cell.
    * Some locators cache cell bounds and this function can make use
@@ -271,6 +306,14 @@ protected:
   virtual void FreeCellBounds();
   //@}
 
+  /**
+   * Called by the batched queries before going parallel. Subclasses build
+   * their search structure here if needed; the default implementation
+   * forces the dataset to build the internal structures it would otherwise
+   * create lazily, and unsafely, on the first GetCell() call.
+   */
+  virtual void PrepareForConcurrentQueries();
+
   int NumberOfCellsPerNode;
   vtkTypeBool RetainCellLists;
   vtkTypeBool CacheCellBounds;
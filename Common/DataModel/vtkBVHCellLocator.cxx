@@ -0,0 +1,1173 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+namespace
+{
+// Number of bins used to evaluate the surface area heuristic.
+const int NumberOfBins = 16;
+
+// Relative cost of traversing a node with respect to testing a cell.
+const double TraversalCost = 1.0;
+
+// Depth limit of the hierarchy. Also bounds the traversal stacks.
+const int MaxDepth = 64;
+const int StackSize = MaxDepth + 32;
+
+// Ranges smaller than this are never built as a separate parallel task.
+const vtkIdType ParallelSubtreeSize = 4096;
+
+// Number of segments traversing the hierarchy together in IntersectWithLines().
+const int PacketSize = 8;
+
+// Per triangle: vertex 0, edges 1-0 and 2-0, and the inverse of the
+// smallest altitude (negative for degenerate triangles).
+const int TriangleStride = 10;
+
+// Parametric slack below which the triangle fast path defers to vtkTriangle.
+const double TriangleEpsilon = 1.0e-10;
+
+//----------------------------------------------------------------------------
+// Flattened node. Interior nodes store the index of their second child (the
+// first one follows them) and -(axis+1) as count; leaves store the index of
+// their first entry in the leaf-ordered arrays and their number of cells.
+struct Node
+{
+  float Min[3];
+  float Max[3];
+  vtkTypeUInt32 Index;
+  vtkTypeInt32 Count;
+
+  bool IsLeaf() const { return this->Count > 0; }
+  int GetAxis() const { return -this->Count - 1; }
+};
+
+//----------------------------------------------------------------------------
+// Node of the hierarchy during construction. Leaves have no children;
+// nodes whose range is built by a parallel task refer to it by Subtree.
+struct BuildNode
+{
+  double Bounds[6];
+  vtkIdType Left;
+  vtkIdType Right;
+  vtkIdType Begin;
+  vtkIdType Count;
+  int Axis;
+  vtkIdType Subtree;
+};
+
+struct SubtreeTask
+{
+  vtkIdType Begin;
+  vtkIdType Count;
+  int Depth;
+  std::vector<BuildNode> Nodes;
+};
+
+//----------------------------------------------------------------------------
+inline void InitializeBounds(double bounds[6])
+{
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void AddBounds(double bounds[6], const double b[6])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] = std::min(bounds[2 * i], b[2 * i]);
+    bounds[2 * i + 1] = std::max(bounds[2 * i + 1], b[2 * i + 1]);
+  }
+}
+
+inline double HalfArea(const double b[6])
+{
+  const double dx = b[1] - b[0], dy = b[3] - b[2], dz = b[5] - b[4];
+  return (dx < 0.0 ? 0.0 : dx * dy + dy * dz + dz * dx);
+}
+
+//----------------------------------------------------------------------------
+// Round a double outward to single precision.
+inline float RoundDown(double v)
+{
+  float f = static_cast<float>(v);
+  return (f > v ? std::nextafter(f, -FLT_MAX) : f);
+}
+
+inline float RoundUp(double v)
+{
+  float f = static_cast<float>(v);
+  return (f < v ? std::nextafter(f, FLT_MAX) : f);
+}
+
+//----------------------------------------------------------------------------
+// Top-down binned SAH construction over a permutation of the cells.
+struct Builder
+{
+  const double* CellBounds;
+  const double* Centroids;
+  vtkIdType* Ids;
+  vtkIdType MaxLeafSize;
+  int ParallelDepth;
+
+  // Build the range [begin,begin+count) of Ids into nodes and return the
+  // index of its root. When tasks is not null, ranges deep enough and
+  // large enough are deferred to it instead.
+  vtkIdType Build(std::vector<BuildNode>& nodes, vtkIdType begin, vtkIdType count, int depth,
+    std::vector<SubtreeTask>* tasks)
+  {
+    const vtkIdType nodeId = static_cast<vtkIdType>(nodes.size());
+    nodes.push_back(BuildNode());
+    BuildNode* node = &nodes.back();
+    node->Left = node->Right = -1;
+    node->Begin = begin;
+    node->Count = count;
+    node->Axis = 0;
+    node->Subtree = -1;
+
+    if (tasks && depth >= this->ParallelDepth && count >= ParallelSubtreeSize)
+    {
+      node->Subtree = static_cast<vtkIdType>(tasks->size());
+      tasks->push_back(SubtreeTask());
+      tasks->back().Begin = begin;
+      tasks->back().Count = count;
+      tasks->back().Depth = depth;
+      return nodeId;
+    }
+
+    double centroidBounds[6];
+    InitializeBounds(node->Bounds);
+    InitializeBounds(centroidBounds);
+    for (vtkIdType i = begin; i < begin + count; ++i)
+    {
+      const vtkIdType cellId = this->Ids[i];
+      AddBounds(node->Bounds, this->CellBounds + 6 * cellId);
+      const double* c = this->Centroids + 3 * cellId;
+      const double cb[6] = { c[0], c[0], c[1], c[1], c[2], c[2] };
+      AddBounds(centroidBounds, cb);
+    }
+    if (count == 1 || depth >= MaxDepth)
+    {
+      return nodeId;
+    }
+
+    int axis = 0;
+    double extent = centroidBounds[1] - centroidBounds[0];
+    for (int i = 1; i < 3; ++i)
+    {
+      if (centroidBounds[2 * i + 1] - centroidBounds[2 * i] > extent)
+      {
+        axis = i;
+        extent = centroidBounds[2 * i + 1] - centroidBounds[2 * i];
+      }
+    }
+
+    vtkIdType split = -1;
+    if (extent > 0.0)
+    {
+      split = this->SAHSplit(node->Bounds, begin, count, axis, centroidBounds[2 * axis], extent);
+    }
+    else if (count > this->MaxLeafSize)
+    {
+      // All centroids coincide: any partition is as good as another.
+      split = begin + count / 2;
+    }
+    if (split <= begin)
+    {
+      return nodeId;
+    }
+
+    node->Axis = axis;
+    const vtkIdType left = this->Build(nodes, begin, split - begin, depth + 1, tasks);
+    const vtkIdType right = this->Build(nodes, split, begin + count - split, depth + 1, tasks);
+    nodes[nodeId].Left = left;
+    nodes[nodeId].Right = right;
+    return nodeId;
+  }
+
+  // Partition the range along axis at the cheapest bin boundary. Returns the
+  // start of the second half, or -1 when a leaf is cheaper.
+  vtkIdType SAHSplit(const double bounds[6], vtkIdType begin, vtkIdType count, int axis,
+    double cmin, double extent)
+  {
+    vtkIdType binCounts[NumberOfBins] = { 0 };
+    double binBounds[NumberOfBins][6];
+    for (int b = 0; b < NumberOfBins; ++b)
+    {
+      InitializeBounds(binBounds[b]);
+    }
+    const double scale = NumberOfBins / extent;
+    for (vtkIdType i = begin; i < begin + count; ++i)
+    {
+      const vtkIdType cellId = this->Ids[i];
+      const int b = this->GetBin(cellId, axis, cmin, scale);
+      ++binCounts[b];
+      AddBounds(binBounds[b], this->CellBounds + 6 * cellId);
+    }
+
+    // Sweep from the right, then from the left, to get the cost of each
+    // of the NumberOfBins-1 candidate planes.
+    double rightArea[NumberOfBins];
+    vtkIdType rightCount[NumberOfBins];
+    double acc[6];
+    InitializeBounds(acc);
+    vtkIdType n = 0;
+    for (int b = NumberOfBins - 1; b > 0; --b)
+    {
+      AddBounds(acc, binBounds[b]);
+      n += binCounts[b];
+      rightArea[b] = HalfArea(acc);
+      rightCount[b] = n;
+    }
+
+    int bestBin = -1;
+    double bestCost = VTK_DOUBLE_MAX;
+    InitializeBounds(acc);
+    n = 0;
+    for (int b = 0; b < NumberOfBins - 1; ++b)
+    {
+      AddBounds(acc, binBounds[b]);
+      n += binCounts[b];
+      if (n == 0 || rightCount[b + 1] == 0)
+      {
+        continue;
+      }
+      const double cost = n * HalfArea(acc) + rightCount[b + 1] * rightArea[b + 1];
+      if (cost < bestCost)
+      {
+        bestCost = cost;
+        bestBin = b;
+      }
+    }
+
+    const double area = HalfArea(bounds);
+    if (bestBin < 0 ||
+      (count <= this->MaxLeafSize && area > 0.0 && TraversalCost + bestCost / area >= count))
+    {
+      if (count <= this->MaxLeafSize)
+      {
+        return -1;
+      }
+      // Should not happen since the extreme centroids fall in the first and
+      // last bins; split at the median anyway.
+      vtkIdType* mid = this->Ids + begin + count / 2;
+      const double* centroids = this->Centroids;
+      std::nth_element(this->Ids + begin, mid, this->Ids + begin + count,
+        [centroids, axis](vtkIdType a, vtkIdType b) {
+          return centroids[3 * a + axis] < centroids[3 * b + axis];
+        });
+      return begin + count / 2;
+    }
+
+    Builder* self = this;
+    vtkIdType* middle = std::partition(this->Ids + begin, this->Ids + begin + count,
+      [self, axis, cmin, scale, bestBin](
+        vtkIdType cellId) { return self->GetBin(cellId, axis, cmin, scale) <= bestBin; });
+    return static_cast<vtkIdType>(middle - this->Ids);
+  }
+
+  int GetBin(vtkIdType cellId, int axis, double cmin, double scale) const
+  {
+    const int b = static_cast<int>((this->Centroids[3 * cellId + axis] - cmin) * scale);
+    return std::min(std::max(b, 0), NumberOfBins - 1);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Convert the build nodes to the depth-first flat layout.
+int Flatten(const std::vector<BuildNode>& nodes, vtkIdType nodeId,
+  const std::vector<SubtreeTask>& tasks, std::vector<Node>& flat, int depth)
+{
+  const BuildNode& bnode = nodes[nodeId];
+  if (bnode.Subtree >= 0)
+  {
+    const SubtreeTask& task = tasks[bnode.Subtree];
+    return Flatten(task.Nodes, 0, tasks, flat, depth);
+  }
+
+  const size_t flatId = flat.size();
+  flat.push_back(Node());
+  Node& node = flat.back();
+  for (int i = 0; i < 3; ++i)
+  {
+    node.Min[i] = RoundDown(bnode.Bounds[2 * i]);
+    node.Max[i] = RoundUp(bnode.Bounds[2 * i + 1]);
+  }
+  if (bnode.Left < 0)
+  {
+    node.Index = static_cast<vtkTypeUInt32>(bnode.Begin);
+    node.Count = static_cast<vtkTypeInt32>(bnode.Count);
+    return depth;
+  }
+
+  node.Count = -(bnode.Axis + 1);
+  const int leftDepth = Flatten(nodes, bnode.Left, tasks, flat, depth + 1);
+  flat[flatId].Index = static_cast<vtkTypeUInt32>(flat.size());
+  const int rightDepth = Flatten(nodes, bnode.Right, tasks, flat, depth + 1);
+  return std::max(leftDepth, rightDepth);
+}
+
+//----------------------------------------------------------------------------
+// A finite line prepared for slab tests. Zero direction components get a
+// large finite inverse so that the slab products never produce NaN.
+struct Segment
+{
+  double Origin[3];
+  double Direction[3];
+  double InverseDirection[3];
+
+  void Initialize(const double p1[3], const double p2[3])
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      this->Origin[i] = p1[i];
+      this->Direction[i] = p2[i] - p1[i];
+      this->InverseDirection[i] =
+        (this->Direction[i] != 0.0 ? 1.0 / this->Direction[i] : VTK_DOUBLE_MAX);
+    }
+  }
+};
+
+// Slab test of the segment against box (min,max) padded by tol, clipped to
+// the parametric range [0,tMax]. Returns the entry parameter in tNear.
+template <typename T>
+inline bool IntersectBox(
+  const Segment& s, const T* min, const T* max, double tol, double tMax, double& tNear)
+{
+  double t0 = 0.0, t1 = tMax;
+  for (int i = 0; i < 3; ++i)
+  {
+    double a = (min[i] - tol - s.Origin[i]) * s.InverseDirection[i];
+    double b = (max[i] + tol - s.Origin[i]) * s.InverseDirection[i];
+    if (a > b)
+    {
+      std::swap(a, b);
+    }
+    t0 = (a > t0 ? a : t0);
+    t1 = (b < t1 ? b : t1);
+  }
+  tNear = t0;
+  return t0 <= t1;
+}
+
+inline bool IntersectCellBox(const Segment& s, const double* b, double tol, double tMax)
+{
+  const double min[3] = { b[0], b[2], b[4] };
+  const double max[3] = { b[1], b[3], b[5] };
+  double tNear;
+  return IntersectBox(s, min, max, tol, tMax, tNear);
+}
+
+//----------------------------------------------------------------------------
+// Outcome of the triangle fast path.
+enum TriangleResult
+{
+  TriangleMiss,
+  TriangleHit,
+  TriangleUndecided
+};
+
+// Moller-Trumbore intersection with the decisions of vtkTriangle: a hit
+// requires the plane to be crossed within the segment and the crossing point
+// to be within tol of the triangle. Cases too close to call either way are
+// left to vtkTriangle.
+inline TriangleResult IntersectTriangle(
+  const Segment& s, const double* tri, double tol, double& t, double& u, double& v)
+{
+  const double* v0 = tri;
+  const double* e1 = tri + 3;
+  const double* e2 = tri + 6;
+  const double invAltitude = tri[9];
+  if (invAltitude < 0.0)
+  {
+    return TriangleUndecided;
+  }
+
+  double pvec[3];
+  vtkMath::Cross(s.Direction, e2, pvec);
+  const double det = vtkMath::Dot(e1, pvec);
+  if (det == 0.0)
+  {
+    return TriangleMiss;
+  }
+  const double invDet = 1.0 / det;
+  const double tvec[3] = { s.Origin[0] - v0[0], s.Origin[1] - v0[1], s.Origin[2] - v0[2] };
+  double qvec[3];
+  vtkMath::Cross(tvec, e1, qvec);
+  t = vtkMath::Dot(e2, qvec) * invDet;
+  if (t < -TriangleEpsilon || t > 1.0 + TriangleEpsilon)
+  {
+    return TriangleMiss;
+  }
+  u = vtkMath::Dot(tvec, pvec) * invDet;
+  v = vtkMath::Dot(s.Direction, qvec) * invDet;
+  const double w = 1.0 - u - v;
+
+  const bool inRange = (t >= TriangleEpsilon && t <= 1.0 - TriangleEpsilon);
+  if (inRange && u >= TriangleEpsilon && v >= TriangleEpsilon && w >= TriangleEpsilon)
+  {
+    return TriangleHit;
+  }
+  // The crossing point is at least deficit * (smallest altitude) away from
+  // the triangle.
+  const double deficit = -std::min(std::min(u, v), w);
+  if (deficit > tol * invAltitude * (1.0 + 1.0e-6) + TriangleEpsilon)
+  {
+    return TriangleMiss;
+  }
+  return TriangleUndecided;
+}
+
+//----------------------------------------------------------------------------
+// Fill the leaf-ordered arrays: cell bounds and triangle data.
+struct LeafDataFunctor
+{
+  vtkDataSet* DataSet;
+  const vtkIdType* Ids;
+  const double* CellBounds;
+  double* LeafBounds;
+  double* Triangles;
+  vtkSMPThreadLocalObject<vtkIdList> PointIds;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdList* ptIds = this->PointIds.Local();
+    double p[3][3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType cellId = this->Ids[i];
+      std::copy(this->CellBounds + 6 * cellId, this->CellBounds + 6 * cellId + 6,
+        this->LeafBounds + 6 * i);
+      if (!this->Triangles)
+      {
+        continue;
+      }
+
+      this->DataSet->GetCellPoints(cellId, ptIds);
+      for (int j = 0; j < 3; ++j)
+      {
+        this->DataSet->GetPoint(ptIds->GetId(j), p[j]);
+      }
+      double* tri = this->Triangles + TriangleStride * i;
+      double normal[3];
+      for (int j = 0; j < 3; ++j)
+      {
+        tri[j] = p[0][j];
+        tri[3 + j] = p[1][j] - p[0][j];
+        tri[6 + j] = p[2][j] - p[0][j];
+      }
+      vtkMath::Cross(tri + 3, tri + 6, normal);
+      const double twiceArea = vtkMath::Norm(normal);
+      const double longest = sqrt(std::max(std::max(vtkMath::Distance2BetweenPoints(p[0], p[1]),
+                                             vtkMath::Distance2BetweenPoints(p[1], p[2])),
+        vtkMath::Distance2BetweenPoints(p[2], p[0])));
+      tri[9] = (twiceArea > 0.0 ? longest / twiceArea : -1.0);
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
+//----------------------------------------------------------------------------
+struct vtkBVHCellLocatorInternals
+{
+  std::vector<Node> Nodes;
+  std::vector<vtkIdType> CellIds;
+  std::vector<double> CellBounds;
+  std::vector<double> Triangles;
+
+  void Clear()
+  {
+    std::vector<Node>().swap(this->Nodes);
+    std::vector<vtkIdType>().swap(this->CellIds);
+    std::vector<double>().swap(this->CellBounds);
+    std::vector<double>().swap(this->Triangles);
+  }
+
+  // Test the cell at position entry of the leaf-ordered arrays. Updates
+  // (t, pcoords, subId) and returns true when it is hit closer than t.
+  bool IntersectEntry(vtkDataSet* dataSet, vtkIdType entry, const Segment& s, const double p1[3],
+    const double p2[3], double tol, double& t, double pcoords[3], int& subId,
+    vtkGenericCell* cell) const
+  {
+    if (!IntersectCellBox(s, this->CellBounds.data() + 6 * entry, tol, t))
+    {
+      return false;
+    }
+    if (!this->Triangles.empty())
+    {
+      double tHit, u, v;
+      const TriangleResult result =
+        IntersectTriangle(s, this->Triangles.data() + TriangleStride * entry, tol, tHit, u, v);
+      if (result == TriangleMiss)
+      {
+        return false;
+      }
+      if (result == TriangleHit)
+      {
+        if (tHit >= t)
+        {
+          return false;
+        }
+        t = tHit;
+        pcoords[0] = u;
+        pcoords[1] = v;
+        pcoords[2] = 0.0;
+        subId = 0;
+        return true;
+      }
+    }
+
+    double tHit, x[3], pc[3];
+    int sub;
+    dataSet->GetCell(this->CellIds[entry], cell);
+    if (cell->IntersectWithLine(p1, p2, tol, tHit, x, pc, sub) && tHit < t)
+    {
+      t = tHit;
+      std::copy(pc, pc + 3, pcoords);
+      subId = sub;
+      return true;
+    }
+    return false;
+  }
+
+  // Closest intersection of the segment (p1,p2), -1 if none. t must be
+  // initialized to the largest parameter of interest.
+  vtkIdType IntersectWithLine(vtkDataSet* dataSet, const double p1[3], const double p2[3],
+    double tol, double& t, double pcoords[3], int& subId, vtkGenericCell* cell) const
+  {
+    Segment s;
+    s.Initialize(p1, p2);
+    vtkIdType hitEntry = -1;
+    vtkTypeUInt32 stack[StackSize];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0)
+    {
+      const vtkTypeUInt32 nodeId = stack[--top];
+      const Node& node = this->Nodes[nodeId];
+      double tNear;
+      if (!IntersectBox(s, node.Min, node.Max, tol, t, tNear))
+      {
+        continue;
+      }
+      if (node.IsLeaf())
+      {
+        for (vtkIdType e = node.Index; e < node.Index + node.Count; ++e)
+        {
+          if (this->IntersectEntry(dataSet, e, s, p1, p2, tol, t, pcoords, subId, cell))
+          {
+            hitEntry = e;
+          }
+        }
+        continue;
+      }
+      // Push the far child first so that the near one is visited first.
+      const bool negative = s.Direction[node.GetAxis()] < 0.0;
+      stack[top++] = (negative ? nodeId + 1 : node.Index);
+      stack[top++] = (negative ? node.Index : nodeId + 1);
+    }
+    return (hitEntry < 0 ? -1 : this->CellIds[hitEntry]);
+  }
+};
+
+//----------------------------------------------------------------------------
+namespace
+{
+// Segments processed by packets: the packet descends into a node when any
+// of its active segments crosses the node box. The slab tests are written
+// over structure-of-arrays lanes so that the compiler can vectorize them.
+struct IntersectWithLinesFunctor
+{
+  vtkBVHCellLocatorInternals* Internals;
+  vtkDataSet* DataSet;
+  vtkPoints* P1s;
+  vtkPoints* P2s;
+  vtkIdType NumberOfLines;
+  double Tolerance;
+  vtkIdType* CellIds;
+  double* Ts;
+  vtkPoints* Xs;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  void Initialize() {}
+
+  void operator()(vtkIdType beginPacket, vtkIdType endPacket)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    const std::vector<Node>& nodes = this->Internals->Nodes;
+    const double tol = this->Tolerance;
+
+    double p1[PacketSize][3], p2[PacketSize][3];
+    Segment segments[PacketSize];
+    double origin[3][PacketSize], inverse[3][PacketSize], tMax[PacketSize];
+    double pcoords[3];
+    int subId;
+    vtkIdType hitEntry[PacketSize];
+    vtkTypeUInt32 stack[StackSize];
+
+    for (vtkIdType packet = beginPacket; packet < endPacket; ++packet)
+    {
+      const vtkIdType first = packet * PacketSize;
+      const int numLanes =
+        static_cast<int>(std::min<vtkIdType>(PacketSize, this->NumberOfLines - first));
+      double direction[3] = { 0.0, 0.0, 0.0 };
+      for (int l = 0; l < PacketSize; ++l)
+      {
+        // Unused lanes get an empty parametric range.
+        const int lane = std::min(l, numLanes - 1);
+        this->P1s->GetPoint(first + lane, p1[l]);
+        this->P2s->GetPoint(first + lane, p2[l]);
+        segments[l].Initialize(p1[l], p2[l]);
+        for (int i = 0; i < 3; ++i)
+        {
+          origin[i][l] = segments[l].Origin[i];
+          inverse[i][l] = segments[l].InverseDirection[i];
+          direction[i] += segments[l].Direction[i];
+        }
+        tMax[l] = (l < numLanes ? 1.0 : -1.0);
+        hitEntry[l] = -1;
+      }
+
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0)
+      {
+        const vtkTypeUInt32 nodeId = stack[--top];
+        const Node& node = nodes[nodeId];
+        double t0[PacketSize], t1[PacketSize];
+        for (int l = 0; l < PacketSize; ++l)
+        {
+          t0[l] = 0.0;
+          t1[l] = tMax[l];
+        }
+        for (int i = 0; i < 3; ++i)
+        {
+          const double lo = node.Min[i] - tol;
+          const double hi = node.Max[i] + tol;
+          for (int l = 0; l < PacketSize; ++l)
+          {
+            const double a = (lo - origin[i][l]) * inverse[i][l];
+            const double b = (hi - origin[i][l]) * inverse[i][l];
+            const double tEnter = (a < b ? a : b);
+            const double tExit = (a < b ? b : a);
+            t0[l] = (tEnter > t0[l] ? tEnter : t0[l]);
+            t1[l] = (tExit < t1[l] ? tExit : t1[l]);
+          }
+        }
+        int mask = 0;
+        for (int l = 0; l < PacketSize; ++l)
+        {
+          mask |= (t0[l] <= t1[l] ? 1 << l : 0);
+        }
+        if (!mask)
+        {
+          continue;
+        }
+
+        if (node.IsLeaf())
+        {
+          for (int l = 0; l < numLanes; ++l)
+          {
+            if (!(mask & (1 << l)))
+            {
+              continue;
+            }
+            for (vtkIdType e = node.Index; e < node.Index + node.Count; ++e)
+            {
+              if (this->Internals->IntersectEntry(this->DataSet, e, segments[l], p1[l], p2[l],
+                    tol, tMax[l], pcoords, subId, cell))
+              {
+                hitEntry[l] = e;
+              }
+            }
+          }
+          continue;
+        }
+        const bool negative = direction[node.GetAxis()] < 0.0;
+        stack[top++] = (negative ? nodeId + 1 : node.Index);
+        stack[top++] = (negative ? node.Index : nodeId + 1);
+      }
+
+      for (int l = 0; l < numLanes; ++l)
+      {
+        const vtkIdType id = first + l;
+        double x[3];
+        if (hitEntry[l] < 0)
+        {
+          this->CellIds[id] = -1;
+          tMax[l] = VTK_DOUBLE_MAX;
+          std::copy(p2[l], p2[l] + 3, x);
+        }
+        else
+        {
+          this->CellIds[id] = this->Internals->CellIds[hitEntry[l]];
+          for (int i = 0; i < 3; ++i)
+          {
+            x[i] = p1[l][i] + tMax[l] * segments[l].Direction[i];
+          }
+        }
+        if (this->Ts)
+        {
+          this->Ts[id] = tMax[l];
+        }
+        if (this->Xs)
+        {
+          this->Xs->SetPoint(id, x);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+}
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->NumberOfCellsPerNode = 4;
+  this->Internals = new vtkBVHCellLocatorInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->Internals->Clear();
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::GetNumberOfNodes()
+{
+  return static_cast<vtkIdType>(this->Internals->Nodes.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  vtkDebugMacro(<< "Building BVH cell locator");
+
+  // Do we need to build?
+  if (!this->Internals->Nodes.empty() && (this->BuildTime > this->MTime) &&
+    (this->BuildTime > this->DataSet->GetMTime()))
+  {
+    return;
+  }
+
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    vtkErrorMacro(<< "No cells to build");
+    return;
+  }
+  if (numCells > static_cast<vtkIdType>(VTK_TYPE_INT32_MAX))
+  {
+    vtkErrorMacro(<< "Too many cells for a BVH cell locator");
+    return;
+  }
+  this->FreeSearchStructure();
+
+  // Make the dataset safe for concurrent access, then gather cell bounds
+  // and centroids.
+  this->Superclass::PrepareForConcurrentQueries();
+  vtkDataSet* dataSet = this->DataSet;
+  std::vector<double> cellBounds(6 * numCells);
+  std::vector<double> centroids(3 * numCells);
+  std::vector<vtkIdType> ids(numCells);
+  std::atomic<bool> allTriangles(vtkPointSet::SafeDownCast(dataSet) != nullptr);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      double* b = cellBounds.data() + 6 * cellId;
+      dataSet->GetCellBounds(cellId, b);
+      centroids[3 * cellId] = 0.5 * (b[0] + b[1]);
+      centroids[3 * cellId + 1] = 0.5 * (b[2] + b[3]);
+      centroids[3 * cellId + 2] = 0.5 * (b[4] + b[5]);
+      ids[cellId] = cellId;
+      if (allTriangles.load(std::memory_order_relaxed) &&
+        dataSet->GetCellType(cellId) != VTK_TRIANGLE)
+      {
+        allTriangles.store(false, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  // Build the top of the hierarchy serially, leaving enough independent
+  // subtrees to keep the threads busy.
+  Builder builder;
+  builder.CellBounds = cellBounds.data();
+  builder.Centroids = centroids.data();
+  builder.Ids = ids.data();
+  builder.MaxLeafSize = this->NumberOfCellsPerNode;
+  builder.ParallelDepth = 0;
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  while ((1 << builder.ParallelDepth) < 4 * numThreads && builder.ParallelDepth < 12)
+  {
+    ++builder.ParallelDepth;
+  }
+
+  std::vector<BuildNode> nodes;
+  std::vector<SubtreeTask> tasks;
+  builder.Build(nodes, 0, numCells, 0, (numThreads > 1 ? &tasks : nullptr));
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      SubtreeTask& task = tasks[i];
+      builder.Build(task.Nodes, task.Begin, task.Count, task.Depth, nullptr);
+    }
+  });
+
+  vtkBVHCellLocatorInternals* internals = this->Internals;
+  internals->Nodes.reserve(nodes.size());
+  this->Level = Flatten(nodes, 0, tasks, internals->Nodes, 0);
+  nodes.clear();
+  tasks.clear();
+
+  // Store the cell data in leaf order so that leaves are tested from
+  // contiguous memory.
+  internals->CellIds.swap(ids);
+  internals->CellBounds.resize(6 * numCells);
+  if (allTriangles.load())
+  {
+    internals->Triangles.resize(TriangleStride * numCells);
+  }
+  LeafDataFunctor leafData;
+  leafData.DataSet = dataSet;
+  leafData.Ids = internals->CellIds.data();
+  leafData.CellBounds = cellBounds.data();
+  leafData.LeafBounds = internals->CellBounds.data();
+  leafData.Triangles = (internals->Triangles.empty() ? nullptr : internals->Triangles.data());
+  vtkSMPTools::For(0, numCells, leafData);
+
+  this->BuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrepareForConcurrentQueries()
+{
+  this->BuildLocator();
+  this->Superclass::PrepareForConcurrentQueries();
+}
+
+//----------------------------------------------------------------------------
+int vtkBVHCellLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  this->BuildLocator();
+  if (this->Internals->Nodes.empty())
+  {
+    return 0;
+  }
+
+  double tHit = 1.0;
+  cellId =
+    this->Internals->IntersectWithLine(this->DataSet, p1, p2, tol, tHit, pcoords, subId, cell);
+  if (cellId < 0)
+  {
+    return 0;
+  }
+  t = tHit;
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = p1[i] + t * (p2[i] - p1[i]);
+  }
+  this->DataSet->GetCell(cellId, cell);
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+  vtkIdTypeArray* cellIds, vtkDoubleArray* ts, vtkPoints* xs)
+{
+  const vtkIdType numLines = p1s ? p1s->GetNumberOfPoints() : 0;
+  if (!p2s || p2s->GetNumberOfPoints() != numLines)
+  {
+    vtkErrorMacro(<< "The two end point arrays must have the same number of points");
+    return;
+  }
+  cellIds->SetNumberOfComponents(1);
+  cellIds->SetNumberOfTuples(numLines);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numLines);
+  }
+  if (xs)
+  {
+    xs->SetNumberOfPoints(numLines);
+  }
+  if (numLines > 0 && this->DataSet)
+  {
+    this->PrepareForConcurrentQueries();
+  }
+  if (numLines == 0 || this->Internals->Nodes.empty())
+  {
+    cellIds->FillValue(-1);
+    return;
+  }
+
+  IntersectWithLinesFunctor functor;
+  functor.Internals = this->Internals;
+  functor.DataSet = this->DataSet;
+  functor.P1s = p1s;
+  functor.P2s = p2s;
+  functor.NumberOfLines = numLines;
+  functor.Tolerance = tol;
+  functor.CellIds = cellIds->GetPointer(0);
+  functor.Ts = (ts ? ts->GetPointer(0) : nullptr);
+  functor.Xs = xs;
+  vtkSMPTools::For(0, (numLines + PacketSize - 1) / PacketSize, functor);
+  if (xs)
+  {
+    xs->Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double x[3], double tol2, vtkGenericCell* cell, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  const vtkBVHCellLocatorInternals* internals = this->Internals;
+  if (internals->Nodes.empty())
+  {
+    return -1;
+  }
+
+  const double tol = sqrt(tol2);
+  double dist2;
+  int subId;
+  vtkTypeUInt32 stack[StackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkTypeUInt32 nodeId = stack[--top];
+    const Node& node = internals->Nodes[nodeId];
+    if (x[0] < node.Min[0] - tol || x[0] > node.Max[0] + tol || x[1] < node.Min[1] - tol ||
+      x[1] > node.Max[1] + tol || x[2] < node.Min[2] - tol || x[2] > node.Max[2] + tol)
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack[top++] = node.Index;
+      stack[top++] = nodeId + 1;
+      continue;
+    }
+    for (vtkIdType e = node.Index; e < node.Index + node.Count; ++e)
+    {
+      const double* b = internals->CellBounds.data() + 6 * e;
+      if (x[0] < b[0] - tol || x[0] > b[1] + tol || x[1] < b[2] - tol || x[1] > b[3] + tol ||
+        x[2] < b[4] - tol || x[2] > b[5] + tol)
+      {
+        continue;
+      }
+      const vtkIdType cellId = internals->CellIds[e];
+      this->DataSet->GetCell(cellId, cell);
+      // dist2 is only meaningful when a closest point is requested, the
+      // point is in the cell when EvaluatePosition() returns 1
+      if (cell->EvaluatePosition(x, nullptr, subId, pcoords, dist2, weights) == 1)
+      {
+        return cellId;
+      }
+    }
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  const vtkBVHCellLocatorInternals* internals = this->Internals;
+  if (internals->Nodes.empty())
+  {
+    return;
+  }
+
+  vtkTypeUInt32 stack[StackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkTypeUInt32 nodeId = stack[--top];
+    const Node& node = internals->Nodes[nodeId];
+    if (bbox[1] < node.Min[0] || bbox[0] > node.Max[0] || bbox[3] < node.Min[1] ||
+      bbox[2] > node.Max[1] || bbox[5] < node.Min[2] || bbox[4] > node.Max[2])
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      stack[top++] = node.Index;
+      stack[top++] = nodeId + 1;
+      continue;
+    }
+    for (vtkIdType e = node.Index; e < node.Index + node.Count; ++e)
+    {
+      const double* b = internals->CellBounds.data() + 6 * e;
+      if (bbox[1] >= b[0] && bbox[0] <= b[1] && bbox[3] >= b[2] && bbox[2] <= b[3] &&
+        bbox[5] >= b[4] && bbox[4] <= b[5])
+      {
+        cells->InsertNextId(internals->CellIds[e]);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongLine(
+  const double p1[3], const double p2[3], double tolerance, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  const vtkBVHCellLocatorInternals* internals = this->Internals;
+  if (internals->Nodes.empty())
+  {
+    return;
+  }
+
+  Segment s;
+  s.Initialize(p1, p2);
+  vtkTypeUInt32 stack[StackSize];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkTypeUInt32 nodeId = stack[--top];
+    const Node& node = internals->Nodes[nodeId];
+    double tNear;
+    if (!IntersectBox(s, node.Min, node.Max, tolerance, 1.0, tNear))
+    {
+      continue;
+    }
+    if (!node.IsLeaf())
+    {
+      const bool negative = s.Direction[node.GetAxis()] < 0.0;
+      stack[top++] = (negative ? nodeId + 1 : node.Index);
+      stack[top++] = (negative ? node.Index : nodeId + 1);
+      continue;
+    }
+    for (vtkIdType e = node.Index; e < node.Index + node.Count; ++e)
+    {
+      if (IntersectCellBox(s, internals->CellBounds.data() + 6 * e, tolerance, 1.0))
+      {
+        cells->InsertNextId(internals->CellIds[e]);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  // Make sure locator has been built successfully
+  this->BuildLocator();
+  const vtkBVHCellLocatorInternals* internals = this->Internals;
+  if (internals->Nodes.empty())
+  {
+    return;
+  }
+
+  vtkPoints* pts = vtkPoints::New();
+  pts->SetDataTypeToFloat();
+  vtkCellArray* polys = vtkCellArray::New();
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+
+  // Faces of a box whose corners are numbered in (i-j-k) order.
+  static const vtkIdType faces[6][4] = { { 0, 2, 6, 4 }, { 1, 5, 7, 3 }, { 0, 4, 5, 1 },
+    { 2, 3, 7, 6 }, { 0, 1, 3, 2 }, { 4, 6, 7, 5 } };
+
+  vtkTypeUInt32 stack[StackSize];
+  int depths[StackSize];
+  int top = 0;
+  stack[top] = 0;
+  depths[top++] = 0;
+  while (top > 0)
+  {
+    --top;
+    const vtkTypeUInt32 nodeId = stack[top];
+    const int depth = depths[top];
+    const Node& node = internals->Nodes[nodeId];
+    if (depth < level && !node.IsLeaf())
+    {
+      stack[top] = nodeId + 1;
+      depths[top++] = depth + 1;
+      stack[top] = node.Index;
+      depths[top++] = depth + 1;
+      continue;
+    }
+
+    vtkIdType pIds[8];
+    for (int c = 0; c < 8; ++c)
+    {
+      pIds[c] = pts->InsertNextPoint((c & 1 ? node.Max[0] : node.Min[0]),
+        (c & 2 ? node.Max[1] : node.Min[1]), (c & 4 ? node.Max[2] : node.Min[2]));
+    }
+    for (int f = 0; f < 6; ++f)
+    {
+      const vtkIdType quad[4] = { pIds[faces[f][0]], pIds[faces[f][1]], pIds[faces[f][2]],
+        pIds[faces[f][3]] };
+      polys->InsertNextCell(4, quad);
+    }
+  }
+
+  pts->Delete();
+  polys->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number Of Nodes: " << this->Internals->Nodes.size() << "\n";
+  os << indent << "Triangle Fast Path: " << (this->Internals->Triangles.empty() ? "Off\n" : "On\n");
+}
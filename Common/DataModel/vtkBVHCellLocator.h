@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy, tuned for
+ * line intersection
+ *
+ * vtkBVHCellLocator organizes the cells of a dataset in a binary bounding
+ * volume hierarchy (BVH). The hierarchy is built top-down: each node is
+ * split along the axis of largest centroid extent at the position that
+ * minimizes the surface area heuristic (SAH), evaluated over a fixed number
+ * of bins. Cell bounds and centroids are computed with vtkSMPTools, and once
+ * the top of the hierarchy has been split into enough independent subtrees,
+ * these are built in parallel.
+ *
+ * The nodes are stored in a flat array in depth-first order: the first
+ * child of an interior node immediately follows it and only the index of
+ * the second child is stored. Node bounds are kept in single precision,
+ * rounded outward, so that a node takes 32 bytes. Cell ids and cell bounds
+ * are stored in leaf order and, when all the cells are triangles, so are
+ * the triangle vertices, which lets the leaves be tested without going
+ * through vtkGenericCell.
+ *
+ * IntersectWithLine() returns the intersection closest to the first point
+ * of the line. IntersectWithLines() processes the segments by packets of
+ * consecutive segments that traverse the hierarchy together, which pays
+ * off when consecutive segments are coherent, e.g. rays cast through
+ * neighboring pixels or from neighboring sample points.
+ *
+ * The NumberOfCellsPerNode ivar is the largest number of cells in a leaf;
+ * it defaults to 4 for this class. Smaller leaves may be created when the
+ * SAH finds them cheaper.
+ *
+ * @warning
+ * FindCell(), IntersectWithLine() and FindCellsAlongLine() taking a
+ * vtkGenericCell or returning ids only are thread safe once the locator is
+ * built. The other queries of vtkAbstractCellLocator that this class does
+ * not override are not supported.
+ *
+ * @sa
+ * vtkAbstractCellLocator vtkStaticCellLocator vtkCellTreeLocator vtkModifiedBSPTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+struct vtkBVHCellLocatorInternals;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  using vtkAbstractCellLocator::FindCell;
+  using vtkAbstractCellLocator::IntersectWithLine;
+
+  /**
+   * Return the closest intersection (if any) of the finite line (p1,p2)
+   * with the cells of the dataset. The cell is returned as a cell id and
+   * as a generic cell.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Batched line intersection using packet traversal. See
+   * vtkAbstractCellLocator::IntersectWithLines().
+   */
+  void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdTypeArray* cellIds,
+    vtkDoubleArray* ts = nullptr, vtkPoints* xs = nullptr) override;
+
+  /**
+   * Find the cell containing a given point. Returns -1 if no cell is found.
+   */
+  vtkIdType FindCell(
+    double x[3], double tol2, vtkGenericCell* cell, double pcoords[3], double* weights) override;
+
+  /**
+   * Return the ids of the cells whose bounds intersect the bounding box
+   * bbox (xmin,xmax, ymin,ymax, zmin,zmax).
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Return the ids of the cells whose bounds, padded by tolerance, are
+   * crossed by the finite line (p1,p2).
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cells) override;
+
+  /**
+   * The queries of this class are thread safe once the locator is built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() outputs
+   * the boxes of the nodes at the given depth, and of the shallower leaves.
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+  /**
+   * Return the number of nodes of the hierarchy, 0 if it has not been
+   * built.
+   */
+  vtkIdType GetNumberOfNodes();
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  void PrepareForConcurrentQueries() override;
+
+  vtkBVHCellLocatorInternals* Internals;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
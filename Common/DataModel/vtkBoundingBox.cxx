@@ -664,30 +664,55 @@ struct FastBounds
   {
     std::array<double, 6>& localBds = this->LocalBounds.Local();
     const auto tuples = vtk::DataArrayTupleRange<3>(this->Points, beginPtId, endPtId);
-    const unsigned char usedConst[1] = { 1 };
-    const unsigned char* used =
-      (this->PointUses != nullptr ? this->PointUses + beginPtId : usedConst);
 
-    for (const auto tuple : tuples)
+    // Accumulate in local variables rather than through the thread local
+    // storage so that the loops below can be kept in registers and
+    // vectorized by the compiler.
+    double xmin = localBds[0], xmax = localBds[1];
+    double ymin = localBds[2], ymax = localBds[3];
+    double zmin = localBds[4], zmax = localBds[5];
+
+    if (this->PointUses == nullptr)
     {
-      if (*used)
+      for (const auto tuple : tuples)
       {
-        double x = static_cast<double>(tuple[0]);
-        double y = static_cast<double>(tuple[1]);
-        double z = static_cast<double>(tuple[2]);
-
-        localBds[0] = std::min(x, localBds[0]);
-        localBds[1] = std::max(x, localBds[1]);
-        localBds[2] = std::min(y, localBds[2]);
-        localBds[3] = std::max(y, localBds[3]);
-        localBds[4] = std::min(z, localBds[4]);
-        localBds[5] = std::max(z, localBds[5]);
+        const double x = static_cast<double>(tuple[0]);
+        const double y = static_cast<double>(tuple[1]);
+        const double z = static_cast<double>(tuple[2]);
+        xmin = std::min(x, xmin);
+        xmax = std::max(x, xmax);
+        ymin = std::min(y, ymin);
+        ymax = std::max(y, ymax);
+        zmin = std::min(z, zmin);
+        zmax = std::max(z, zmax);
       }
-      if (this->PointUses != nullptr)
+    }
+    else
+    {
+      const unsigned char* used = this->PointUses + beginPtId;
+      for (const auto tuple : tuples)
       {
-        ++used;
+        if (*used++)
+        {
+          const double x = static_cast<double>(tuple[0]);
+          const double y = static_cast<double>(tuple[1]);
+          const double z = static_cast<double>(tuple[2]);
+          xmin = std::min(x, xmin);
+          xmax = std::max(x, xmax);
+          ymin = std::min(y, ymin);
+          ymax = std::max(y, ymax);
+          zmin = std::min(z, zmin);
+          zmax = std::max(z, zmax);
+        }
       }
     }
+
+    localBds[0] = xmin;
+    localBds[1] = xmax;
+    localBds[2] = ymin;
+    localBds[3] = ymax;
+    localBds[4] = zmin;
+    localBds[5] = zmax;
   }
 
   void Reduce()
@@ -20,8 +20,12 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <vector>
 
 vtkStandardNewMacro(vtkCellLocator);
 
@@ -59,6 +63,116 @@ inline int vtkNeighborCells::InsertNextPoint(int* x)
   return id / 3;
 }
 
+//----------------------------------------------------------------------------
+// The temporary storage of a query: the buckets to search and the markers
+// of the cells already visited. A cell has been visited by the current query
+// when its marker equals QueryNumber, so that the markers only need to be
+// cleared when the query number rolls over.
+struct vtkCellLocatorScratch
+{
+  vtkCellLocatorScratch()
+    : Buckets(10, 10)
+    , QueryNumber(0)
+  {
+  }
+
+  // Start a new query on a dataset of numCells cells.
+  void BeginQuery(vtkIdType numCells)
+  {
+    if (static_cast<vtkIdType>(this->CellHasBeenVisited.size()) != numCells)
+    {
+      this->CellHasBeenVisited.assign(numCells, 0);
+      this->QueryNumber = 0;
+    }
+    if (++this->QueryNumber == 0)
+    {
+      std::fill(this->CellHasBeenVisited.begin(), this->CellHasBeenVisited.end(), 0);
+      this->QueryNumber++; // can't use 0 as a marker
+    }
+  }
+
+  // Mark the cell as visited; return false if it already was.
+  bool Visit(vtkIdType cellId)
+  {
+    if (this->CellHasBeenVisited[cellId] == this->QueryNumber)
+    {
+      return false;
+    }
+    this->CellHasBeenVisited[cellId] = this->QueryNumber;
+    return true;
+  }
+
+  void Unvisit(vtkIdType cellId) { this->CellHasBeenVisited[cellId] = 0; }
+
+  vtkNeighborCells Buckets;
+  std::vector<unsigned char> CellHasBeenVisited;
+  unsigned char QueryNumber;
+};
+
+//----------------------------------------------------------------------------
+// The scratch storage not in use by a query. Each query takes one out of the
+// pool, or creates one, and gives it back when done: concurrent queries never
+// share their temporary storage, and the storage is reused across queries
+// whatever thread issues them.
+struct vtkCellLocatorScratchPool
+{
+  ~vtkCellLocatorScratchPool() { this->Clear(); }
+
+  void Clear()
+  {
+    for (auto scratch : this->Available)
+    {
+      delete scratch;
+    }
+    this->Available.clear();
+  }
+
+  std::mutex Mutex;
+  std::vector<vtkCellLocatorScratch*> Available;
+};
+
+namespace
+{
+// Hold scratch storage from the pool for the duration of a query.
+class vtkCellLocatorScopedScratch
+{
+public:
+  vtkCellLocatorScopedScratch(vtkCellLocatorScratchPool* pool, vtkIdType numCells)
+    : Pool(pool)
+    , Scratch(nullptr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(pool->Mutex);
+      if (!pool->Available.empty())
+      {
+        this->Scratch = pool->Available.back();
+        pool->Available.pop_back();
+      }
+    }
+    if (!this->Scratch)
+    {
+      this->Scratch = new vtkCellLocatorScratch;
+    }
+    this->Scratch->BeginQuery(numCells);
+  }
+
+  ~vtkCellLocatorScopedScratch()
+  {
+    std::lock_guard<std::mutex> lock(this->Pool->Mutex);
+    this->Pool->Available.push_back(this->Scratch);
+  }
+
+  vtkCellLocatorScratch* operator->() const { return this->Scratch; }
+
+private:
+  vtkCellLocatorScopedScratch(const vtkCellLocatorScopedScratch&) = delete;
+  void operator=(const vtkCellLocatorScopedScratch&) = delete;
+
+  vtkCellLocatorScratchPool* Pool;
+  vtkCellLocatorScratch* Scratch;
+};
+}
+
 //----------------------------------------------------------------------------
 // Construct with automatic computation of divisions, averaging
 // 25 cells per bucket.
@@ -68,12 +182,10 @@ vtkCellLocator::vtkCellLocator()
   this->Level = 8;
   this->NumberOfCellsPerNode = 25;
   this->Tree = nullptr;
-  this->CellHasBeenVisited = nullptr;
-  this->QueryNumber = 0;
   this->NumberOfDivisions = 1;
   this->H[0] = this->H[1] = this->H[2] = 1.0;
 
-  this->Buckets = new vtkNeighborCells(10, 10);
+  this->ScratchPool = new vtkCellLocatorScratchPool;
   this->NumberOfOctants = 0;
   this->Bounds[0] = this->Bounds[2] = this->Bounds[4] = VTK_DOUBLE_MAX;
   this->Bounds[1] = this->Bounds[3] = this->Bounds[5] = VTK_DOUBLE_MIN;
@@ -84,14 +196,11 @@ vtkCellLocator::vtkCellLocator()
 //----------------------------------------------------------------------------
 vtkCellLocator::~vtkCellLocator()
 {
-  delete this->Buckets;
-  this->Buckets = nullptr;
-
   this->FreeSearchStructure();
   this->FreeCellBounds();
 
-  delete[] this->CellHasBeenVisited;
-  this->CellHasBeenVisited = nullptr;
+  delete this->ScratchPool;
+  this->ScratchPool = nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -146,17 +255,37 @@ void vtkCellLocator::ComputeOctantBounds(int i, int j, int k)
   this->OctantBounds[5] = this->OctantBounds[4] + H[2];
 }
 
+//----------------------------------------------------------------------------
+namespace
+{
+// Thread safe counterparts of ComputeOctantBounds() and IsInOctantBounds().
+void vtkCellLocatorOctantBounds(
+  const double bounds[6], const double h[3], int i, int j, int k, double octantBounds[6])
+{
+  octantBounds[0] = bounds[0] + i * h[0];
+  octantBounds[1] = octantBounds[0] + h[0];
+  octantBounds[2] = bounds[2] + j * h[1];
+  octantBounds[3] = octantBounds[2] + h[1];
+  octantBounds[4] = bounds[4] + k * h[2];
+  octantBounds[5] = octantBounds[4] + h[2];
+}
+
+bool vtkCellLocatorInOctantBounds(const double octantBounds[6], const double x[3], double tol)
+{
+  return octantBounds[0] - tol <= x[0] && x[0] <= octantBounds[1] + tol &&
+    octantBounds[2] - tol <= x[1] && x[1] <= octantBounds[3] + tol &&
+    octantBounds[4] - tol <= x[2] && x[2] <= octantBounds[5] + tol;
+}
+}
+
 //----------------------------------------------------------------------------
 // Return intersection point (if any) AND the cell which was intersected by
 // finite line.
 //
-// NOTE: This method is not thread safe (i.e., when invoking this method on
-// the same instance of vtkCellLocator). This is the due to the use of the
-// data members QueryNumber and CellHasBeenVisited. These should be pulled
-// out of the class and made local to the appropriate methods that use
-// them. Since there may be a performance cost and possible effects on
-// output, this will be done TODO when more time is available. To see an
-// alternative implementation, see vtkStaticCellLocator which is thread safe.
+// This method is thread safe once the locator is built: the cells already
+// tested are marked in scratch storage owned by the query, and the bounds
+// of the current octant are kept in a local variable rather than in the
+// OctantBounds member.
 //
 int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t,
   double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
@@ -223,15 +352,9 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     leafStart = this->NumberOfOctants - this->NumberOfDivisions * prod;
     bestCellId = -1;
 
-    // Clear the array that indicates whether we have visited this cell.
-    // The array is only cleared when the query number rolls over.  This
-    // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++; // can't use 0 as a marker
-    }
+    // The cells whose intersection has already been computed
+    vtkCellLocatorScopedScratch scratch(this->ScratchPool, this->DataSet->GetNumberOfCells());
+    double octantBounds[6];
 
     // set up curr and stop dist
     currDist = 0;
@@ -262,14 +385,14 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0] - 1, pos[1] - 1, pos[2] - 1);
+        vtkCellLocatorOctantBounds(
+          this->Bounds, this->H, pos[0] - 1, pos[1] - 1, pos[2] - 1, octantBounds);
         for (tMax = VTK_DOUBLE_MAX, cellId = 0; cellId < this->Tree[idx]->GetNumberOfIds();
              cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (scratch->Visit(cId))
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
             int hitCellBounds = 0;
 
             // check whether we intersect the cell bounds
@@ -292,9 +415,9 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
               this->DataSet->GetCell(cId, cell);
               if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId))
               {
-                if (!this->IsInOctantBounds(x, tol))
+                if (!vtkCellLocatorInOctantBounds(octantBounds, x, tol))
                 {
-                  this->CellHasBeenVisited[cId] = 0; // mark the cell non-visited
+                  scratch->Unvisit(cId); // mark the cell non-visited
                 }
                 else
                 {
@@ -311,7 +434,7 @@ int vtkCellLocator::IntersectWithLine(const double a0[3], const double a1[3], do
                 }   // if within current parametric range
               }     // if intersection
             }       // if (hitCellBounds)
-          }         // if (!this->CellHasBeenVisited[cId])
+          }         // if (scratch->Visit(cId))
         }
       }
 
@@ -421,15 +544,9 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
   leafStart = this->NumberOfOctants -
     this->NumberOfDivisions * this->NumberOfDivisions * this->NumberOfDivisions;
 
-  // Clear the array that indicates whether we have visited this cell.
-  // The array is only cleared when the query number rolls over.  This
-  // saves a number of calls to memset.
-  this->QueryNumber++;
-  if (this->QueryNumber == 0)
-  {
-    this->ClearCellHasBeenVisited();
-    this->QueryNumber++; // can't use 0 as a marker
-  }
+  // The buckets to search and the cells already visited
+  vtkCellLocatorScopedScratch scratch(this->ScratchPool, this->DataSet->GetNumberOfCells());
+  vtkNeighborCells* buckets = &scratch->Buckets;
 
   // init
   dist2 = -1.0;
@@ -459,11 +576,11 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
   for (closestCell = (-1), minDist2 = VTK_DOUBLE_MAX, level = 0;
        (closestCell == -1) && (level < this->NumberOfDivisions); level++)
   {
-    this->GetBucketNeighbors(ijk, this->NumberOfDivisions, level);
+    this->GetBucketNeighbors(buckets, ijk, this->NumberOfDivisions, level);
 
-    for (i = 0; i < this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i = 0; i < buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = buckets->GetPoint(i);
 
       // if a neighboring bucket has cells,
       if ((cellIds = this->Tree[leafStart + nei[0] + nei[1] * this->NumberOfDivisions +
@@ -479,9 +596,8 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch->Visit(cellId))
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -533,7 +649,7 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
                   //                  minStat = stat;
                 }
               }
-            } // if (!this->CellHasBeenVisited[cellId])
+            } // if (scratch->Visit(cellId))
           }
         }
       }
@@ -566,11 +682,11 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
         prevMaxLevel[i] = this->NumberOfDivisions - 1;
       }
     }
-    this->GetOverlappingBuckets(x, ijk, sqrt(minDist2), prevMinLevel, prevMaxLevel);
+    this->GetOverlappingBuckets(buckets, x, ijk, sqrt(minDist2), prevMinLevel, prevMaxLevel);
 
-    for (i = 0; i < this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i = 0; i < buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = buckets->GetPoint(i);
 
       if ((cellIds = this->Tree[leafStart + nei[0] + nei[1] * this->NumberOfDivisions +
              nei[2] * this->NumberOfDivisions * this->NumberOfDivisions]) != nullptr)
@@ -585,9 +701,8 @@ void vtkCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch->Visit(cellId))
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -692,15 +807,9 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
   leafStart = this->NumberOfOctants -
     this->NumberOfDivisions * this->NumberOfDivisions * this->NumberOfDivisions;
 
-  // Clear the array that indicates whether we have visited this cell.
-  // The array is only cleared when the query number rolls over.  This
-  // saves a number of calls to memset.
-  this->QueryNumber++;
-  if (this->QueryNumber == 0)
-  {
-    this->ClearCellHasBeenVisited();
-    this->QueryNumber++; // can't use 0 as a marker
-  }
+  // The buckets to search and the cells already visited
+  vtkCellLocatorScopedScratch scratch(this->ScratchPool, this->DataSet->GetNumberOfCells());
+  vtkNeighborCells* buckets = &scratch->Buckets;
 
   // init
   dist2 = -1.0;
@@ -736,9 +845,8 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
     {
       // get the cell
       cellId = cellIds->GetId(j);
-      if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+      if (scratch->Visit(cellId))
       {
-        this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
         // check whether we could be close enough to the cell by
         // testing the cell bounds
@@ -782,7 +890,7 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
             refinedRadius2 = dist2;
           }
         }
-      } // if (this->CellHasBeenVisited[cellId])
+      } // if (scratch->Visit(cellId))
     }
   }
 
@@ -844,11 +952,12 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
     currentRadius = refinedRadius; // used in if at bottom of this for loop
 
     // Build up a list of buckets that are arranged in rings
-    this->GetOverlappingBuckets(x, ijk, refinedRadius / ii, prevMinLevel, prevMaxLevel);
+    this->GetOverlappingBuckets(
+      buckets, x, ijk, refinedRadius / ii, prevMinLevel, prevMaxLevel);
 
-    for (i = 0; i < this->Buckets->GetNumberOfNeighbors(); i++)
+    for (i = 0; i < buckets->GetNumberOfNeighbors(); i++)
     {
-      nei = this->Buckets->GetPoint(i);
+      nei = buckets->GetPoint(i);
 
       if ((cellIds = this->Tree[leafStart + nei[0] + nei[1] * this->NumberOfDivisions +
              nei[2] * numberOfBucketsPerPlane]) != nullptr)
@@ -863,9 +972,8 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
           {
             // get the cell
             cellId = cellIds->GetId(j);
-            if (this->CellHasBeenVisited[cellId] != this->QueryNumber)
+            if (scratch->Visit(cellId))
             {
-              this->CellHasBeenVisited[cellId] = this->QueryNumber;
 
               // check whether we could be close enough to the cell by
               // testing the cell bounds
@@ -955,7 +1063,8 @@ vtkIdType vtkCellLocator::FindClosestPointWithinRadius(double x[3], double radiu
 //  These indices must be offset by number of octants before the leaf node
 //  layer before they can be used. Only those buckets with cells are returned.
 //
-void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
+void vtkCellLocator::GetBucketNeighbors(
+  vtkNeighborCells* buckets, int ijk[3], int ndivs, int level)
 {
   int i, j, k, min, max, minLevel[3], maxLevel[3];
   int nei[3];
@@ -969,7 +1078,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
 
   //  Initialize
   //
-  this->Buckets->Reset();
+  buckets->Reset();
 
   //  If at this bucket, just place into list
   //
@@ -978,7 +1087,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
     if (this->Tree[leafStart + ijk[0] + ijk[1] * this->NumberOfDivisions +
           ijk[2] * numberOfBucketsPerPlane])
     {
-      this->Buckets->InsertNextPoint(ijk);
+      buckets->InsertNextPoint(ijk);
     }
     return;
   }
@@ -1008,7 +1117,7 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
             nei[0] = i;
             nei[1] = j;
             nei[2] = k;
-            this->Buckets->InsertNextPoint(nei);
+            buckets->InsertNextPoint(nei);
           }
         }
       }
@@ -1024,8 +1133,8 @@ void vtkCellLocator::GetBucketNeighbors(int ijk[3], int ndivs, int level)
 // layer before they can be used. Only buckets that have cells are placed
 // in the bucket list.
 //
-void vtkCellLocator::GetOverlappingBuckets(
-  const double x[3], int vtkNotUsed(ijk)[3], double dist, int prevMinLevel[3], int prevMaxLevel[3])
+void vtkCellLocator::GetOverlappingBuckets(vtkNeighborCells* buckets, const double x[3],
+  int vtkNotUsed(ijk)[3], double dist, int prevMinLevel[3], int prevMaxLevel[3])
 {
   int i, j, k, nei[3], minLevel[3], maxLevel[3];
   int leafStart, kFactor, jFactor;
@@ -1037,7 +1146,7 @@ void vtkCellLocator::GetOverlappingBuckets(
   leafStart = this->NumberOfOctants - numberOfBucketsPerPlane * this->NumberOfDivisions;
 
   // Initialize
-  this->Buckets->Reset();
+  buckets->Reset();
 
   // Determine the range of indices in each direction
   for (i = 0; i < 3; i++)
@@ -1107,7 +1216,7 @@ void vtkCellLocator::GetOverlappingBuckets(
           nei[0] = i;
           nei[1] = j;
           nei[2] = k;
-          this->Buckets->InsertNextPoint(nei);
+          buckets->InsertNextPoint(nei);
         }
       }
     }
@@ -1152,6 +1261,12 @@ void vtkCellLocator::BuildLocator()
   this->ForceBuildLocator();
 }
 //---------------------------------------------------------------------------
+void vtkCellLocator::PrepareForConcurrentQueries()
+{
+  this->ForceBuildLocator();
+  this->Superclass::PrepareForConcurrentQueries();
+}
+//---------------------------------------------------------------------------
 void vtkCellLocator::BuildLocatorIfNeeded()
 {
   if (this->LazyEvaluation)
@@ -1182,23 +1297,156 @@ void vtkCellLocator::ForceBuildLocator()
   }
   this->BuildLocatorInternal();
 }
+//---------------------------------------------------------------------------
+namespace
+{
+// A cell in a leaf octant. The leaf octants are filled by sorting these
+// tuples, which gives the cells of each octant in increasing order, as if
+// the cells had been inserted one after the other.
+struct vtkCellLocatorLeafTuple
+{
+  vtkIdType Leaf;   // index of the octant in the leaf level
+  vtkIdType CellId; // cell overlapping the octant
+
+  bool operator<(const vtkCellLocatorLeafTuple& tuple) const
+  {
+    return this->Leaf < tuple.Leaf || (this->Leaf == tuple.Leaf && this->CellId < tuple.CellId);
+  }
+};
+
+// Compute the range of leaf octants overlapped by the bounds of each cell,
+// and the number of these octants.
+struct vtkCellLocatorMapCells
+{
+  vtkDataSet* DataSet;
+  const double (*CellBounds)[6];
+  const double* Bounds;
+  const double* H;
+  double HTol[3];
+  int NDivs;
+  int* Ranges;
+  vtkIdType* Counts;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    double cellBounds[6];
+    const double* boundsPtr = cellBounds;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      if (this->CellBounds)
+      {
+        boundsPtr = this->CellBounds[cellId];
+      }
+      else
+      {
+        this->DataSet->GetCellBounds(cellId, cellBounds);
+      }
+
+      // find min/max locations of bounding box
+      int* range = this->Ranges + 6 * cellId;
+      vtkIdType count = 1;
+      for (int i = 0; i < 3; i++)
+      {
+        int ijkMin = static_cast<int>(
+          (boundsPtr[2 * i] - this->Bounds[2 * i] - this->HTol[i]) / this->H[i]);
+        int ijkMax = static_cast<int>(
+          (boundsPtr[2 * i + 1] - this->Bounds[2 * i] + this->HTol[i]) / this->H[i]);
+        ijkMin = (ijkMin < 0 ? 0 : ijkMin);
+        ijkMax = (ijkMax >= this->NDivs ? this->NDivs - 1 : ijkMax);
+        range[2 * i] = ijkMin;
+        range[2 * i + 1] = ijkMax;
+        count *= (ijkMax < ijkMin ? 0 : ijkMax - ijkMin + 1);
+      }
+      this->Counts[cellId] = count;
+    }
+  }
+};
+
+// Generate a tuple for each octant between the min/max locations of a cell.
+struct vtkCellLocatorGenerateTuples
+{
+  const int* Ranges;
+  const vtkIdType* Offsets;
+  int NDivs;
+  vtkCellLocatorLeafTuple* Tuples;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    const vtkIdType product = static_cast<vtkIdType>(this->NDivs) * this->NDivs;
+    for (vtkIdType cellId = begin; cellId < end; ++cellId)
+    {
+      const int* range = this->Ranges + 6 * cellId;
+      vtkCellLocatorLeafTuple* tuple = this->Tuples + this->Offsets[cellId];
+      for (int k = range[4]; k <= range[5]; k++)
+      {
+        for (int j = range[2]; j <= range[3]; j++)
+        {
+          for (int i = range[0]; i <= range[1]; i++, tuple++)
+          {
+            tuple->Leaf = i + j * this->NDivs + k * product;
+            tuple->CellId = cellId;
+          }
+        }
+      }
+    }
+  }
+};
+
+// Create the cell list of each non-empty leaf octant from the sorted tuples.
+// A run of tuples of the same octant is processed by the range in which it
+// starts.
+struct vtkCellLocatorFillLeaves
+{
+  const vtkCellLocatorLeafTuple* Tuples;
+  vtkIdType NumTuples;
+  vtkIdList** Leaves;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType first = begin;
+    while (first > 0 && first < end && this->Tuples[first].Leaf == this->Tuples[first - 1].Leaf)
+    {
+      first++;
+    }
+    while (first < end)
+    {
+      const vtkIdType leaf = this->Tuples[first].Leaf;
+      vtkIdType last = first + 1;
+      while (last < this->NumTuples && this->Tuples[last].Leaf == leaf)
+      {
+        last++;
+      }
+      vtkIdList* octant = vtkIdList::New();
+      octant->SetNumberOfIds(last - first);
+      for (vtkIdType i = first; i < last; i++)
+      {
+        octant->SetId(i - first, this->Tuples[i].CellId);
+      }
+      this->Leaves[leaf] = octant;
+      first = last;
+    }
+  }
+};
+}
+
 //---------------------------------------------------------------------------
 //  Method to form subdivision of space based on the cells provided and
 //  subject to the constraints of levels and NumberOfCellsPerNode.
 //  The result is directly addressable and of uniform subdivision.
 //
+//  The cells are binned in parallel: each cell generates a tuple per leaf
+//  octant overlapped by its bounds, and the tuples are sorted by octant with
+//  vtkSMPTools::Sort(), as in vtkStaticCellLocator.
+//
 void vtkCellLocator::BuildLocatorInternal()
 {
-  double length, cellBounds[6], *boundsPtr;
+  double length;
   vtkIdType numCells;
   int ndivs, product;
-  int i, j, k, ijkMin[3], ijkMax[3];
-  vtkIdType cellId, idx;
+  int i, j, k;
   int parentOffset;
-  vtkIdList* octant;
   int numCellsPerBucket = this->NumberOfCellsPerNode;
   int prod, numOctants;
-  double hTol[3];
 
   vtkDebugMacro(<< "Subdividing octree...");
 
@@ -1214,10 +1462,13 @@ void vtkCellLocator::BuildLocatorInternal()
   {
     this->FreeSearchStructure();
   }
-  delete[] this->CellHasBeenVisited;
-  this->CellHasBeenVisited = nullptr;
+  this->ScratchPool->Clear();
   this->FreeCellBounds();
 
+  // Let the dataset build the structures it would otherwise create lazily,
+  // and unsafely, in the parallel loops below and in concurrent queries.
+  this->Superclass::PrepareForConcurrentQueries();
+
   //  Size the root cell.  Initialize cell data structure, compute
   //  level and divisions.
   //
@@ -1255,10 +1506,6 @@ void vtkCellLocator::BuildLocatorInternal()
   this->Tree = new vtkIdListPtr[numOctants];
   memset(this->Tree, 0, numOctants * sizeof(vtkIdListPtr));
 
-  this->CellHasBeenVisited = new unsigned char[numCells];
-  this->ClearCellHasBeenVisited();
-  this->QueryNumber = 0;
-
   if (this->CacheCellBounds)
   {
     this->StoreCellBounds();
@@ -1266,68 +1513,59 @@ void vtkCellLocator::BuildLocatorInternal()
 
   //  Compute width of leaf octant in three directions
   //
+  vtkCellLocatorMapCells mapper;
   for (i = 0; i < 3; i++)
   {
     this->H[i] = (this->Bounds[2 * i + 1] - this->Bounds[2 * i]) / ndivs;
-    hTol[i] = this->H[i] / 100.0;
+    mapper.HTol[i] = this->H[i] / 100.0;
   }
 
-  //  Insert each cell into the appropriate octant.  Make sure cell
-  //  falls within octant.
+  //  Find the octants each cell falls within, then insert the cells into
+  //  the octants.
   //
+  std::vector<int> ranges(6 * numCells);
+  std::vector<vtkIdType> offsets(numCells + 1);
+  mapper.DataSet = this->DataSet;
+  mapper.CellBounds = this->CellBounds;
+  mapper.Bounds = this->Bounds;
+  mapper.H = this->H;
+  mapper.NDivs = ndivs;
+  mapper.Ranges = ranges.data();
+  mapper.Counts = offsets.data();
+  vtkSMPTools::For(0, numCells, mapper);
+
+  vtkIdType numTuples = 0;
+  for (vtkIdType cellId = 0; cellId <= numCells; cellId++)
+  {
+    const vtkIdType count = (cellId < numCells ? offsets[cellId] : 0);
+    offsets[cellId] = numTuples;
+    numTuples += count;
+  }
+
+  std::vector<vtkCellLocatorLeafTuple> tuples(numTuples);
+  vtkCellLocatorGenerateTuples generator = { ranges.data(), offsets.data(), ndivs, tuples.data() };
+  vtkSMPTools::For(0, numCells, generator);
+  vtkSMPTools::Sort(tuples.begin(), tuples.end());
+
   parentOffset = numOctants - (ndivs * ndivs * ndivs);
+  vtkCellLocatorFillLeaves filler = { tuples.data(), numTuples, this->Tree + parentOffset };
+  vtkSMPTools::For(0, numTuples, filler);
+
+  // Mark the parents of the non-empty octants
   product = ndivs * ndivs;
-  boundsPtr = cellBounds;
-  for (cellId = 0; cellId < numCells; cellId++)
+  for (k = 0; k < ndivs; k++)
   {
-    if (this->CellBounds)
+    for (j = 0; j < ndivs; j++)
     {
-      boundsPtr = this->CellBounds[cellId];
-    }
-    else
-    {
-      this->DataSet->GetCellBounds(cellId, cellBounds);
-    }
-
-    // find min/max locations of bounding box
-    for (i = 0; i < 3; i++)
-    {
-      ijkMin[i] = static_cast<int>((boundsPtr[2 * i] - this->Bounds[2 * i] - hTol[i]) / this->H[i]);
-      ijkMax[i] =
-        static_cast<int>((boundsPtr[2 * i + 1] - this->Bounds[2 * i] + hTol[i]) / this->H[i]);
-
-      if (ijkMin[i] < 0)
-      {
-        ijkMin[i] = 0;
-      }
-      if (ijkMax[i] >= ndivs)
+      for (i = 0; i < ndivs; i++)
       {
-        ijkMax[i] = ndivs - 1;
-      }
-    }
-
-    // each octant between min/max point may have cell in it
-    for (k = ijkMin[2]; k <= ijkMax[2]; k++)
-    {
-      for (j = ijkMin[1]; j <= ijkMax[1]; j++)
-      {
-        for (i = ijkMin[0]; i <= ijkMax[0]; i++)
+        if (this->Tree[parentOffset + i + j * ndivs + k * product])
         {
-          idx = parentOffset + i + j * ndivs + k * product;
           this->MarkParents(reinterpret_cast<void*>(VTK_CELL_INSIDE), i, j, k, ndivs, this->Level);
-          octant = this->Tree[idx];
-          if (!octant)
-          {
-            octant = vtkIdList::New();
-            octant->Allocate(numCellsPerBucket, numCellsPerBucket / 2);
-            this->Tree[idx] = octant;
-          }
-          octant->InsertNextId(cellId);
         }
       }
     }
-
-  } // for all cells
+  }
 
   this->BuildTime.Modified();
 }
@@ -1550,24 +1788,6 @@ void vtkCellLocator::GenerateFace(
   polys->InsertNextCell(4, ids);
 }
 
-//----------------------------------------------------------------------------
-void vtkCellLocator::ClearCellHasBeenVisited()
-{
-  if (this->CellHasBeenVisited && this->DataSet)
-  {
-    memset(this->CellHasBeenVisited, 0, this->DataSet->GetNumberOfCells());
-  }
-}
-
-//----------------------------------------------------------------------------
-void vtkCellLocator::ClearCellHasBeenVisited(vtkIdType id)
-{
-  if (this->CellHasBeenVisited && this->DataSet && id < this->DataSet->GetNumberOfCells())
-  {
-    this->CellHasBeenVisited[id] = 0;
-  }
-}
-
 //----------------------------------------------------------------------------
 // Calculate the distance between the point x to the bucket "nei".
 //
@@ -1860,15 +2080,8 @@ void vtkCellLocator::FindCellsAlongLine(
     prod = this->NumberOfDivisions * this->NumberOfDivisions;
     leafStart = this->NumberOfOctants - this->NumberOfDivisions * prod;
 
-    // Clear the array that indicates whether we have visited this cell.
-    // The array is only cleared when the query number rolls over.  This
-    // saves a number of calls to memset.
-    this->QueryNumber++;
-    if (this->QueryNumber == 0)
-    {
-      this->ClearCellHasBeenVisited();
-      this->QueryNumber++; // can't use 0 as a marker
-    }
+    // The cells already visited
+    vtkCellLocatorScopedScratch scratch(this->ScratchPool, this->DataSet->GetNumberOfCells());
 
     // set up curr and stop dist
     currDist = 0;
@@ -1899,13 +2112,11 @@ void vtkCellLocator::FindCellsAlongLine(
     {
       if (this->Tree[idx])
       {
-        this->ComputeOctantBounds(pos[0] - 1, pos[1] - 1, pos[2] - 1);
         for (cellId = 0; cellId < this->Tree[idx]->GetNumberOfIds(); cellId++)
         {
           cId = this->Tree[idx]->GetId(cellId);
-          if (this->CellHasBeenVisited[cId] != this->QueryNumber)
+          if (scratch->Visit(cId))
           {
-            this->CellHasBeenVisited[cId] = this->QueryNumber;
 
             // check whether we intersect the cell bounds
             if (this->CacheCellBounds)
@@ -1924,7 +2135,7 @@ void vtkCellLocator::FindCellsAlongLine(
             {
               cells->InsertUniqueId(cId);
             } // if (hitCellBounds)
-          }   // if (!this->CellHasBeenVisited[cId])
+          }   // if (scratch->Visit(cId))
         }
       }
 
@@ -32,8 +32,15 @@
  * for subclassing; so these locators can be derived if necessary.
  *
  * @warning
- * Most of the methods of this class are not thread-safe. For a thread-safe,
- * more efficient generic implementation, please use vtkStaticCellLocator
+ * Once the locator has been built, the queries taking a vtkGenericCell,
+ * FindCellsWithinBounds() and FindCellsAlongLine() may be invoked
+ * concurrently from several threads, each thread providing its own
+ * vtkGenericCell and vtkIdList: the temporary storage of a query (the
+ * cells already visited and the buckets to search) is taken from a pool
+ * and is never shared with another query. The methods that do not take a
+ * vtkGenericCell use an internal cell and are not thread-safe. The
+ * octree is built in parallel with vtkSMPTools. For a more efficient
+ * generic implementation, please use vtkStaticCellLocator.
  *
  * @sa
  * vtkLocator vtkPointLocator vtkOBBTree vtkStaticCellLocator
@@ -45,6 +52,7 @@
 #include "vtkAbstractCellLocator.h"
 #include "vtkCommonDataModelModule.h" // For export macro
 
+struct vtkCellLocatorScratchPool;
 class vtkNeighborCells;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkCellLocator : public vtkAbstractCellLocator
@@ -75,8 +83,8 @@ public:
    * Return intersection point (if any) AND the cell which was intersected by
    * the finite line. The cell is returned as a cell id and as a generic
    * cell.  For other IntersectWithLine signatures, see
-   * vtkAbstractCellLocator.
-   * THIS METHOD IS NOT THREAD SAFE.
+   * vtkAbstractCellLocator. This method is thread safe once the locator
+   * has been built.
    */
   int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
     double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
@@ -91,7 +99,7 @@ public:
    * deallocation can be done only once outside the for loop.  If a cell is
    * found, "cell" contains the points and ptIds for the cell "cellId" upon
    * exit.
-   * THIS METHOD IS NOT THREAD SAFE.
+   * This method is thread safe once the locator has been built.
    */
   void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell* cell,
     vtkIdType& cellId, int& subId, double& dist2) override;
@@ -112,7 +120,7 @@ public:
    * inside returns the return value of the EvaluatePosition call to the
    * closest cell; inside(=1) or outside(=0). For other
    * FindClosestPointWithinRadius signatures, see vtkAbstractCellLocator.
-   * THIS METHOD IS NOT THREAD SAFE.
+   * This method is thread safe once the locator has been built.
    */
   vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
     vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
@@ -143,13 +151,18 @@ public:
    */
   void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
 
+  /**
+   * The queries taking a vtkGenericCell are thread safe once the locator is
+   * built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /**
    * Given a finite line defined by the two points (p1,p2), return the list
    * of unique cell ids in the buckets containing the line. It is possible
    * that an empty cell list is returned. The user must provide the vtkIdList
    * to populate. This method returns data only after the locator has been
-   * built.
-   * THIS METHOD IS NOT THREAD SAFE.
+   * built, and is then thread safe.
    */
   void FindCellsAlongLine(
     const double p1[3], const double p2[3], double tolerance, vtkIdList* cells) override;
@@ -170,12 +183,11 @@ protected:
   vtkCellLocator();
   ~vtkCellLocator() override;
 
-  void GetBucketNeighbors(int ijk[3], int ndivs, int level);
-  void GetOverlappingBuckets(
-    const double x[3], int ijk[3], double dist, int prevMinLevel[3], int prevMaxLevel[3]);
+  void PrepareForConcurrentQueries() override;
 
-  void ClearCellHasBeenVisited();
-  void ClearCellHasBeenVisited(vtkIdType id);
+  void GetBucketNeighbors(vtkNeighborCells* buckets, int ijk[3], int ndivs, int level);
+  void GetOverlappingBuckets(vtkNeighborCells* buckets, const double x[3], int ijk[3],
+    double dist, int prevMinLevel[3], int prevMaxLevel[3]);
 
   double Distance2ToBucket(const double x[3], int nei[3]);
   double Distance2ToBounds(const double x[3], double bounds[6]);
@@ -193,9 +205,8 @@ protected:
   void GenerateFace(
     int face, int numDivs, int i, int j, int k, vtkPoints* pts, vtkCellArray* polys);
 
-  vtkNeighborCells* Buckets;
-  unsigned char* CellHasBeenVisited;
-  unsigned char QueryNumber;
+  // The temporary storage of the queries, see vtkCellLocator.cxx
+  vtkCellLocatorScratchPool* ScratchPool;
 
   void ComputeOctantBounds(int i, int j, int k);
   double OctantBounds[6]; // the bounds of the current octant
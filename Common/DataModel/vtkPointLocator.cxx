@@ -21,8 +21,10 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> //std::sort
+#include <vector>
 
 vtkStandardNewMacro(vtkPointLocator);
 
@@ -817,18 +819,75 @@ void vtkPointLocator::FindPointsWithinRadius(double R, const double x[3], vtkIdL
   }
 }
 
+//-----------------------------------------------------------------------------
+namespace
+{
+// A point in a bucket. The buckets are filled by sorting these tuples, which
+// gives the points of each bucket in increasing order, as if the points had
+// been inserted one after the other.
+struct vtkPointLocatorTuple
+{
+  vtkIdType Bucket;
+  vtkIdType PtId;
+
+  bool operator<(const vtkPointLocatorTuple& tuple) const
+  {
+    return this->Bucket < tuple.Bucket || (this->Bucket == tuple.Bucket && this->PtId < tuple.PtId);
+  }
+};
+
+// Create the id list of each non-empty bucket from the sorted tuples. A run
+// of tuples of the same bucket is processed by the range in which it starts.
+struct vtkPointLocatorFillBuckets
+{
+  const vtkPointLocatorTuple* Tuples;
+  vtkIdType NumTuples;
+  vtkIdList** HashTable;
+  int NumberOfPointsPerBucket;
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkIdType first = begin;
+    while (
+      first > 0 && first < end && this->Tuples[first].Bucket == this->Tuples[first - 1].Bucket)
+    {
+      first++;
+    }
+    while (first < end)
+    {
+      const vtkIdType idx = this->Tuples[first].Bucket;
+      vtkIdType last = first + 1;
+      while (last < this->NumTuples && this->Tuples[last].Bucket == idx)
+      {
+        last++;
+      }
+      vtkIdList* bucket = vtkIdList::New();
+      bucket->Allocate(std::max<vtkIdType>(last - first, this->NumberOfPointsPerBucket),
+        this->NumberOfPointsPerBucket / 3);
+      for (vtkIdType i = first; i < last; i++)
+      {
+        bucket->InsertNextId(this->Tuples[i].PtId);
+      }
+      this->HashTable[idx] = bucket;
+      first = last;
+    }
+  }
+};
+}
+
 //-----------------------------------------------------------------------------
 //  Method to form subdivision of space based on the points provided and
 //  subject to the constraints of levels and NumberOfPointsPerBucket.
 //  The result is directly addressable and of uniform subdivision.
 //
+//  The points are binned in parallel: the bucket of each point is computed
+//  with vtkSMPTools, then the (bucket, point) tuples are sorted by bucket
+//  with vtkSMPTools::Sort(), as in vtkStaticPointLocator.
+//
 void vtkPointLocator::BuildLocator()
 {
   int ndivs[3];
-  vtkIdType idx;
-  vtkIdList* bucket;
   vtkIdType numPts;
-  double x[3];
   typedef vtkIdList* vtkIdListPtr;
 
   if ((this->HashTable != nullptr) && (this->BuildTime > this->MTime) &&
@@ -897,21 +956,26 @@ void vtkPointLocator::BuildLocator()
   this->ComputePerformanceFactors();
 
   //  Insert each point into the appropriate bucket.  Make sure point
-  //  falls within bucket.
+  //  falls within bucket. The first GetPoint() call may build internal
+  //  structures of the dataset, do it serially.
   //
-  for (vtkIdType i = 0; i < numPts; ++i)
-  {
-    this->DataSet->GetPoint(i, x);
-    idx = this->GetBucketIndex(x);
-    bucket = this->HashTable[idx];
-    if (!bucket)
+  std::vector<vtkPointLocatorTuple> tuples(numPts);
+  double x[3];
+  this->DataSet->GetPoint(0, x);
+  vtkSMPTools::For(0, numPts, [this, &tuples](vtkIdType begin, vtkIdType end) {
+    double pt[3];
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      bucket = vtkIdList::New();
-      bucket->Allocate(this->NumberOfPointsPerBucket, this->NumberOfPointsPerBucket / 3);
-      this->HashTable[idx] = bucket;
+      this->DataSet->GetPoint(i, pt);
+      tuples[i].Bucket = this->GetBucketIndex(pt);
+      tuples[i].PtId = i;
     }
-    bucket->InsertNextId(i);
-  }
+  });
+  vtkSMPTools::Sort(tuples.begin(), tuples.end());
+
+  vtkPointLocatorFillBuckets filler = { tuples.data(), numPts, this->HashTable,
+    this->NumberOfPointsPerBucket };
+  vtkSMPTools::For(0, numPts, filler);
 
   // Okay we're done update mtime
   this->BuildTime.Modified();
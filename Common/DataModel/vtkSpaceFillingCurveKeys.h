@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveKeys.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpaceFillingCurveKeys
+ * @brief   positions of integer coordinates along Morton and Hilbert curves
+ *
+ * vtkSpaceFillingCurveKeys provides inline functions computing the 64-bit
+ * key of integer coordinates along a Morton (Z-order) or a Hilbert curve.
+ * Sorting points by the keys of their quantized coordinates puts points that
+ * are close in space close to each other in the sorted order. The 3D keys
+ * use the 21 low bits of each coordinate, the 2D Morton keys the 32 low
+ * bits. In the keys, the bits of x are the most significant of each group of
+ * interleaved bits in 3D, and the least significant in 2D.
+ *
+ * The Hilbert keys use the transposed representation of J. Skilling,
+ * "Programming the Hilbert curve", AIP Conference Proceedings 707, 2004.
+ *
+ * @sa
+ * vtkSpaceFillingCurveReorder
+ */
+
+#ifndef vtkSpaceFillingCurveKeys_h
+#define vtkSpaceFillingCurveKeys_h
+
+#include "vtkType.h"
+
+namespace vtkSpaceFillingCurveKeys
+{
+
+/**
+ * Number of bits used for each coordinate of the 3D keys.
+ */
+const int Bits3D = 21;
+
+/**
+ * Spread the 21 low bits of v so that consecutive bits are three bits apart.
+ */
+inline vtkTypeUInt64 SpreadBits3D(vtkTypeUInt64 v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v << 2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+/**
+ * Spread the 32 low bits of v to the even bits of the result.
+ */
+inline vtkTypeUInt64 SpreadBits2D(vtkTypeUInt64 v)
+{
+  v &= 0xffffffffULL;
+  v = (v | (v << 16)) & 0x0000ffff0000ffffULL;
+  v = (v | (v << 8)) & 0x00ff00ff00ff00ffULL;
+  v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  v = (v | (v << 2)) & 0x3333333333333333ULL;
+  v = (v | (v << 1)) & 0x5555555555555555ULL;
+  return v;
+}
+
+/**
+ * Position of (x,y) along a 2D Morton curve.
+ */
+inline vtkTypeUInt64 MortonKey(vtkTypeUInt64 x, vtkTypeUInt64 y)
+{
+  return SpreadBits2D(x) | (SpreadBits2D(y) << 1);
+}
+
+/**
+ * Position of (x,y,z) along a 3D Morton curve.
+ */
+inline vtkTypeUInt64 MortonKey(vtkTypeUInt64 x, vtkTypeUInt64 y, vtkTypeUInt64 z)
+{
+  return (SpreadBits3D(x) << 2) | (SpreadBits3D(y) << 1) | SpreadBits3D(z);
+}
+
+/**
+ * Position of (x,y,z) along a 3D Hilbert curve.
+ */
+inline vtkTypeUInt64 HilbertKey(unsigned int x, unsigned int y, unsigned int z)
+{
+  unsigned int c[3] = { x, y, z };
+  const unsigned int m = 1u << (Bits3D - 1);
+
+  // Inverse undo
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    const unsigned int p = q - 1;
+    for (int i = 0; i < 3; ++i)
+    {
+      if (c[i] & q)
+      {
+        c[0] ^= p;
+      }
+      else
+      {
+        const unsigned int t = (c[0] ^ c[i]) & p;
+        c[0] ^= t;
+        c[i] ^= t;
+      }
+    }
+  }
+
+  // Gray encode
+  c[1] ^= c[0];
+  c[2] ^= c[1];
+  unsigned int t = 0;
+  for (unsigned int q = m; q > 1; q >>= 1)
+  {
+    if (c[2] & q)
+    {
+      t ^= q - 1;
+    }
+  }
+  return MortonKey(c[0] ^ t, c[1] ^ t, c[2] ^ t);
+}
+
+} // End vtkSpaceFillingCurveKeys namespace.
+
+#endif // vtkSpaceFillingCurveKeys_h
+// VTK-HeaderTest-Exclude: vtkSpaceFillingCurveKeys.h
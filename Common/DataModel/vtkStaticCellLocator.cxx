@@ -33,6 +33,7 @@
 
 #include <functional>
 #include <queue>
+#include <unordered_set>
 #include <vector>
 
 vtkStandardNewMacro(vtkStaticCellLocator);
@@ -1065,7 +1066,7 @@ vtkIdType CellProcessor<T>::FindClosestPointWithinRadius(const double x[3], doub
             // get bin bounding box
             bds[0] = this->Binner->Bounds[0] + ijk[0] * this->Binner->hX;
             bds[2] = this->Binner->Bounds[2] + ijk[1] * this->Binner->hY;
-            bds[4] = this->Binner->Bounds[3] + ijk[2] * this->Binner->hZ;
+            bds[4] = this->Binner->Bounds[4] + ijk[2] * this->Binner->hZ;
             bds[1] = bds[0] + this->Binner->hX;
             bds[3] = bds[2] + this->Binner->hY;
             bds[5] = bds[4] + this->Binner->hZ;
@@ -1118,9 +1119,10 @@ int CellProcessor<T>::IntersectWithLine(const double a0[3], const double a1[3],
     return 0;
   }
 
-  // Initialize intersection query array if necessary. This is done
-  // locally to ensure thread safety.
-  std::vector<unsigned char> cellHasBeenVisited(this->NumCells, 0);
+  // Keep track of the cells already tested. This is done locally to ensure
+  // thread safety, in a set so that the cost is proportional to the number
+  // of cells visited rather than to the size of the dataset.
+  std::unordered_set<vtkIdType> cellHasBeenVisited;
 
   // Get the i-j-k point of intersection and bin index. This is
   // clamped to the boundary of the locator.
@@ -1158,10 +1160,8 @@ int CellProcessor<T>::IntersectWithLine(const double a0[3], const double a1[3],
       for (i = 0; i < numCellsInBin; i++)
       {
         cId = cellIds[i].CellId;
-        if (cellHasBeenVisited[cId] == 0)
+        if (cellHasBeenVisited.insert(cId).second)
         {
-          cellHasBeenVisited[cId] = 1;
-
           // check whether we intersect the cell bounds
           int hitCellBounds = vtkBox::IntersectBox(
             this->CellBounds + (6 * cId), a0, rayDir, hitCellBoundsPosition, tHitCell);
@@ -1177,7 +1177,7 @@ int CellProcessor<T>::IntersectWithLine(const double a0[3], const double a1[3],
               // intersections can occur behind this bin which are not the correct answer.
               if (!this->IsInBinBounds(binBounds, x, binTol))
               {
-                cellHasBeenVisited[cId] = 0; // mark the cell non-visited
+                cellHasBeenVisited.erase(cId); // mark the cell non-visited
               }
               else
               {
@@ -1385,6 +1385,13 @@ int vtkStaticCellLocator::IntersectWithLine(const double p1[3], const double p2[
   return this->Processor->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, cell);
 }
 
+//-----------------------------------------------------------------------------
+void vtkStaticCellLocator::PrepareForConcurrentQueries()
+{
+  this->BuildLocator();
+  this->Superclass::PrepareForConcurrentQueries();
+}
+
 //-----------------------------------------------------------------------------
 void vtkStaticCellLocator::BuildLocator()
 {
@@ -193,6 +193,12 @@ public:
   void BuildLocator() override;
   //@}
 
+  /**
+   * FindCell(), FindClosestPointWithinRadius() and IntersectWithLine() taking
+   * a vtkGenericCell are thread safe once the locator is built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   //@{
   /**
    * Set the maximum number of buckets in the locator. By default the value
@@ -225,6 +231,8 @@ protected:
   vtkStaticCellLocator();
   ~vtkStaticCellLocator() override;
 
+  void PrepareForConcurrentQueries() override;
+
   double Bounds[6]; // Bounding box of the whole dataset
   int Divisions[3]; // Number of sub-divisions in x-y-z directions
   double H[3];      // Width of each bin in x-y-z directions
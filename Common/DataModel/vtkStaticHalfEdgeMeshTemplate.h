@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticHalfEdgeMeshTemplate.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkStaticHalfEdgeMeshTemplate
+ * @brief   compact, array-based half-edge representation of polygonal cells
+ *
+ *
+ * vtkStaticHalfEdgeMeshTemplate is a supplemental object to vtkCellArray
+ * providing constant time access to the cells sharing an edge. It is meant
+ * to replace vtkPolyData::BuildLinks() followed by repeated calls to
+ * vtkPolyData::GetCellEdgeNeighbors() (which intersects the link lists of
+ * the two edge points) in filters that traverse the edges of a surface mesh.
+ *
+ * Each corner of a cell defines a half-edge, going from the corner point to
+ * the next point of the cell. Half-edges are identified by the position of
+ * their origin point in the connectivity array of the vtkCellArray, so the
+ * cell array itself serves as the corner table and is not copied: the only
+ * additional storage is the cell of each half-edge and the "mate" of each
+ * half-edge. The mates link all the half-edges lying on the same edge (in
+ * either direction) into a cycle. A boundary half-edge is its own mate, and
+ * on a manifold edge the two half-edges are the mates of each other.
+ * Non-manifold edges are handled: their cycle simply has more than two
+ * half-edges. The half-edges of a cycle are ordered by increasing id.
+ *
+ * This class is non-incremental (i.e., static). The cell array must not be
+ * modified, nor deleted, while the half-edges are in use; it must be rebuilt
+ * if the cells change. The building of the half-edges has been threaded
+ * with vtkSMPTools.
+ *
+ * @warning
+ * The TIds template type, a signed integral type, is used to represent
+ * point ids, cell ids and half-edge ids. It may be used to reduce memory
+ * and speed processing, as long as the size of the connectivity array fits
+ * in it.
+ *
+ * @warning
+ * When built from a vtkPolyData, the half-edges are those of its polygons.
+ * The cell ids are the indices of the polygons in the polys cell array,
+ * which match the vtkPolyData cell ids only when it has no verts or lines.
+ *
+ * @sa
+ * vtkStaticCellLinksTemplate vtkStaticEdgeLocatorTemplate vtkPolyData
+ */
+
+#ifndef vtkStaticHalfEdgeMeshTemplate_h
+#define vtkStaticHalfEdgeMeshTemplate_h
+
+#include "vtkType.h"
+
+class vtkCellArray;
+class vtkIdList;
+class vtkPolyData;
+
+template <typename TIds>
+class vtkStaticHalfEdgeMeshTemplate
+{
+public:
+  //@{
+  /**
+   * Instantiate and destructor methods.
+   */
+  vtkStaticHalfEdgeMeshTemplate();
+  ~vtkStaticHalfEdgeMeshTemplate();
+  //@}
+
+  /**
+   * Make sure any previously created half-edges are cleaned up.
+   */
+  void Initialize();
+
+  /**
+   * Build the half-edges of the polygons of a vtkPolyData.
+   */
+  void BuildHalfEdges(vtkPolyData* pd);
+
+  /**
+   * Build the half-edges of the cells of a cell array, using numPts points.
+   * The cell array is referenced, not copied.
+   */
+  void BuildHalfEdges(vtkIdType numPts, vtkCellArray* cells);
+
+  /**
+   * Return the cell array the half-edges were built from.
+   */
+  vtkCellArray* GetCells() const { return this->Cells; }
+
+  //@{
+  /**
+   * Return the number of cells and half-edges.
+   */
+  TIds GetNumberOfCells() const { return this->NumCells; }
+  TIds GetNumberOfHalfEdges() const { return this->NumHalfEdges; }
+  //@}
+
+  //@{
+  /**
+   * Return the first half-edge of a cell, and the number of half-edges
+   * (points) of a cell. The half-edges of a cell are contiguous.
+   */
+  TIds GetCellHalfEdge(vtkIdType cellId) const { return this->GetOffset(cellId); }
+  TIds GetCellSize(vtkIdType cellId) const
+  {
+    return this->GetOffset(cellId + 1) - this->GetOffset(cellId);
+  }
+  //@}
+
+  /**
+   * Return the cell of a half-edge.
+   */
+  TIds GetCell(TIds heId) const { return this->HalfEdgeCells[heId]; }
+
+  //@{
+  /**
+   * Return the next and the previous half-edges of the cell of a half-edge.
+   */
+  TIds GetNext(TIds heId) const
+  {
+    const TIds cellId = this->HalfEdgeCells[heId];
+    return (heId + 1 < this->GetOffset(cellId + 1) ? heId + 1 : this->GetOffset(cellId));
+  }
+  TIds GetPrevious(TIds heId) const
+  {
+    const TIds cellId = this->HalfEdgeCells[heId];
+    return (heId > this->GetOffset(cellId) ? heId - 1 : this->GetOffset(cellId + 1) - 1);
+  }
+  //@}
+
+  //@{
+  /**
+   * Return the origin and the destination points of a half-edge.
+   */
+  TIds GetOrigin(TIds heId) const
+  {
+    return static_cast<TIds>(
+      this->Connectivity64 ? this->Connectivity64[heId] : this->Connectivity32[heId]);
+  }
+  TIds GetDestination(TIds heId) const { return this->GetOrigin(this->GetNext(heId)); }
+  //@}
+
+  /**
+   * Return the next half-edge around the edge of a half-edge. Iterating
+   * GetMate() visits all the half-edges of the edge and comes back to the
+   * initial half-edge. A boundary half-edge is its own mate.
+   */
+  TIds GetMate(TIds heId) const { return this->Mates[heId]; }
+
+  //@{
+  /**
+   * Return whether a half-edge lies on a boundary edge (used by one
+   * half-edge only), or on a manifold edge (used by two half-edges).
+   */
+  bool IsBoundary(TIds heId) const { return (this->Mates[heId] == heId); }
+  bool IsManifold(TIds heId) const
+  {
+    return (this->Mates[heId] != heId && this->Mates[this->Mates[heId]] == heId);
+  }
+  //@}
+
+  /**
+   * Return the half-edge of a cell lying on the edge (p1,p2), in either
+   * direction, or -1 if the cell does not have this edge.
+   */
+  TIds FindHalfEdge(vtkIdType cellId, vtkIdType p1, vtkIdType p2) const;
+
+  /**
+   * Return the number of cells, other than the cell of the given half-edge,
+   * using the edge of the half-edge.
+   */
+  TIds GetNumberOfEdgeNeighbors(TIds heId) const;
+
+  /**
+   * Fill the list of cells, other than the cell of the given half-edge,
+   * using the edge of the half-edge. Each cell appears once. The cells are
+   * ordered by increasing id after the cell of the half-edge, followed by
+   * those before it.
+   */
+  void GetEdgeNeighbors(TIds heId, vtkIdList* cellIds) const;
+
+  /**
+   * Same as vtkPolyData::GetCellEdgeNeighbors(): fill the list of cells,
+   * other than cellId, using the edge (p1,p2) of cellId. The list is empty
+   * if (p1,p2) is not an edge of cellId.
+   */
+  void GetCellEdgeNeighbors(vtkIdType cellId, vtkIdType p1, vtkIdType p2, vtkIdList* cellIds) const;
+
+  /**
+   * Return the memory in kibibytes (1024 bytes) consumed by the half-edges,
+   * excluding the referenced cell array.
+   */
+  unsigned long GetActualMemorySize() const;
+
+protected:
+  TIds NumCells;
+  TIds NumHalfEdges;
+
+  // The cell array. Only one of the 32 and 64 bit pointers is set, depending
+  // on its storage.
+  vtkCellArray* Cells;
+  const vtkTypeInt32* Offsets32;
+  const vtkTypeInt32* Connectivity32;
+  const vtkTypeInt64* Offsets64;
+  const vtkTypeInt64* Connectivity64;
+
+  // The half-edges
+  TIds* HalfEdgeCells; // the cell of each half-edge
+  TIds* Mates;         // the next half-edge on the same edge
+
+  TIds GetOffset(vtkIdType cellId) const
+  {
+    return static_cast<TIds>(this->Offsets64 ? this->Offsets64[cellId] : this->Offsets32[cellId]);
+  }
+
+private:
+  vtkStaticHalfEdgeMeshTemplate(const vtkStaticHalfEdgeMeshTemplate&) = delete;
+  void operator=(const vtkStaticHalfEdgeMeshTemplate&) = delete;
+};
+
+#include "vtkStaticHalfEdgeMeshTemplate.txx"
+
+#endif
+// VTK-HeaderTest-Exclude: vtkStaticHalfEdgeMeshTemplate.h
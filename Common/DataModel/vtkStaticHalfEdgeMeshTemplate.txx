@@ -0,0 +1,275 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkStaticHalfEdgeMeshTemplate.txx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkStaticHalfEdgeMeshTemplate.h"
+
+#ifndef vtkStaticHalfEdgeMeshTemplate_txx
+#define vtkStaticHalfEdgeMeshTemplate_txx
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------
+// Default constructor. BuildHalfEdges() does most of the work.
+template <typename TIds>
+vtkStaticHalfEdgeMeshTemplate<TIds>::vtkStaticHalfEdgeMeshTemplate()
+  : NumCells(0)
+  , NumHalfEdges(0)
+  , Cells(nullptr)
+  , Offsets32(nullptr)
+  , Connectivity32(nullptr)
+  , Offsets64(nullptr)
+  , Connectivity64(nullptr)
+  , HalfEdgeCells(nullptr)
+  , Mates(nullptr)
+{
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+vtkStaticHalfEdgeMeshTemplate<TIds>::~vtkStaticHalfEdgeMeshTemplate()
+{
+  this->Initialize();
+}
+
+//----------------------------------------------------------------------------
+// Clean up any previously allocated memory
+template <typename TIds>
+void vtkStaticHalfEdgeMeshTemplate<TIds>::Initialize()
+{
+  delete[] this->HalfEdgeCells;
+  this->HalfEdgeCells = nullptr;
+  delete[] this->Mates;
+  this->Mates = nullptr;
+
+  this->NumCells = 0;
+  this->NumHalfEdges = 0;
+  this->Cells = nullptr;
+  this->Offsets32 = nullptr;
+  this->Connectivity32 = nullptr;
+  this->Offsets64 = nullptr;
+  this->Connectivity64 = nullptr;
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+void vtkStaticHalfEdgeMeshTemplate<TIds>::BuildHalfEdges(vtkPolyData* pd)
+{
+  this->BuildHalfEdges(pd->GetNumberOfPoints(), pd->GetPolys());
+}
+
+//----------------------------------------------------------------------------
+// Build the half-edges. Similar to the building of static cell links, the
+// half-edges are bucketed by the smallest point id of their edge, using
+// std::atomic counts so that cells can be processed in parallel. Then each
+// bucket is sorted on the other point id of the edge, making the half-edges
+// of an edge contiguous, and each group is linked into a cycle. This is
+// linear in the number of half-edges: the buckets are small.
+template <typename TIds>
+void vtkStaticHalfEdgeMeshTemplate<TIds>::BuildHalfEdges(vtkIdType numPts, vtkCellArray* cells)
+{
+  this->Initialize();
+
+  this->Cells = cells;
+  this->NumCells = static_cast<TIds>(cells->GetNumberOfCells());
+  this->NumHalfEdges = static_cast<TIds>(cells->GetNumberOfConnectivityIds());
+  if (cells->IsStorage64Bit())
+  {
+    this->Offsets64 = cells->GetOffsetsArray64()->GetPointer(0);
+    this->Connectivity64 = cells->GetConnectivityArray64()->GetPointer(0);
+  }
+  else
+  {
+    this->Offsets32 = cells->GetOffsetsArray32()->GetPointer(0);
+    this->Connectivity32 = cells->GetConnectivityArray32()->GetPointer(0);
+  }
+
+  const TIds numHalfEdges = this->NumHalfEdges;
+  this->HalfEdgeCells = new TIds[numHalfEdges];
+  this->Mates = new TIds[numHalfEdges];
+  if (numHalfEdges == 0)
+  {
+    return;
+  }
+
+  // Record the cell of each half-edge, and count the half-edges of each
+  // bucket. memory_order_relaxed is safe here, since the atomics are not
+  // used for synchronization.
+  std::atomic<TIds>* counts = new std::atomic<TIds>[numPts];
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    counts[ptId].store(0, std::memory_order_relaxed);
+  }
+  vtkSMPTools::For(0, this->NumCells, [this, counts](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      const TIds begin = this->GetOffset(cellId);
+      const TIds end = this->GetOffset(cellId + 1);
+      for (TIds heId = begin; heId < end; ++heId)
+      {
+        const TIds v0 = this->GetOrigin(heId);
+        const TIds v1 = this->GetOrigin(heId + 1 < end ? heId + 1 : begin);
+        this->HalfEdgeCells[heId] = static_cast<TIds>(cellId);
+        counts[v0 < v1 ? v0 : v1].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  // Prefix sum. The counts are then used to fill each bucket from its end.
+  TIds* offsets = new TIds[numPts + 1];
+  offsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    offsets[ptId + 1] = offsets[ptId] + counts[ptId].load(std::memory_order_relaxed);
+  }
+
+  TIds* buckets = new TIds[numHalfEdges];
+  vtkSMPTools::For(
+    0, this->NumCells, [this, counts, offsets, buckets](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const TIds begin = this->GetOffset(cellId);
+        const TIds end = this->GetOffset(cellId + 1);
+        for (TIds heId = begin; heId < end; ++heId)
+        {
+          const TIds v0 = this->GetOrigin(heId);
+          const TIds v1 = this->GetOrigin(heId + 1 < end ? heId + 1 : begin);
+          const TIds ptId = (v0 < v1 ? v0 : v1);
+          buckets[offsets[ptId] + counts[ptId].fetch_sub(1, std::memory_order_relaxed) - 1] = heId;
+        }
+      }
+    });
+  delete[] counts;
+
+  // Sort each bucket on the largest point id of the edges, then on the
+  // half-edge ids so that the result does not depend on the threading.
+  vtkSMPTools::For(0, numPts, [this, offsets, buckets](vtkIdType ptId, vtkIdType endPtId) {
+    std::vector<std::pair<TIds, TIds> > edges;
+    for (; ptId < endPtId; ++ptId)
+    {
+      edges.clear();
+      for (TIds i = offsets[ptId]; i < offsets[ptId + 1]; ++i)
+      {
+        const TIds heId = buckets[i];
+        const TIds v0 = this->GetOrigin(heId);
+        const TIds v1 = this->GetDestination(heId);
+        edges.emplace_back(v0 < v1 ? v1 : v0, heId);
+      }
+      std::sort(edges.begin(), edges.end());
+
+      // Link each group of half-edges into a cycle
+      const size_t numEdges = edges.size();
+      for (size_t i = 0; i < numEdges;)
+      {
+        size_t j = i + 1;
+        for (; j < numEdges && edges[j].first == edges[i].first; ++j)
+        {
+          this->Mates[edges[j - 1].second] = edges[j].second;
+        }
+        this->Mates[edges[j - 1].second] = edges[i].second;
+        i = j;
+      }
+    }
+  });
+  delete[] offsets;
+  delete[] buckets;
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+TIds vtkStaticHalfEdgeMeshTemplate<TIds>::FindHalfEdge(
+  vtkIdType cellId, vtkIdType p1, vtkIdType p2) const
+{
+  const TIds begin = this->GetOffset(cellId);
+  const TIds end = this->GetOffset(cellId + 1);
+  for (TIds heId = begin; heId < end; ++heId)
+  {
+    const vtkIdType v0 = this->GetOrigin(heId);
+    const vtkIdType v1 = this->GetOrigin(heId + 1 < end ? heId + 1 : begin);
+    if ((v0 == p1 && v1 == p2) || (v0 == p2 && v1 == p1))
+    {
+      return heId;
+    }
+  }
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+// The half-edges of a cell being contiguous, the half-edges of a cell
+// appearing several times in a cycle follow each other.
+template <typename TIds>
+TIds vtkStaticHalfEdgeMeshTemplate<TIds>::GetNumberOfEdgeNeighbors(TIds heId) const
+{
+  const TIds cellId = this->HalfEdgeCells[heId];
+  TIds numNei = 0;
+  TIds prevCellId = cellId;
+  for (TIds mate = this->Mates[heId]; mate != heId; mate = this->Mates[mate])
+  {
+    const TIds mateCellId = this->HalfEdgeCells[mate];
+    if (mateCellId != prevCellId && mateCellId != cellId)
+    {
+      ++numNei;
+    }
+    prevCellId = mateCellId;
+  }
+  return numNei;
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+void vtkStaticHalfEdgeMeshTemplate<TIds>::GetEdgeNeighbors(TIds heId, vtkIdList* cellIds) const
+{
+  cellIds->Reset();
+  const TIds cellId = this->HalfEdgeCells[heId];
+  TIds prevCellId = cellId;
+  for (TIds mate = this->Mates[heId]; mate != heId; mate = this->Mates[mate])
+  {
+    const TIds mateCellId = this->HalfEdgeCells[mate];
+    if (mateCellId != prevCellId && mateCellId != cellId)
+    {
+      cellIds->InsertNextId(mateCellId);
+    }
+    prevCellId = mateCellId;
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+void vtkStaticHalfEdgeMeshTemplate<TIds>::GetCellEdgeNeighbors(
+  vtkIdType cellId, vtkIdType p1, vtkIdType p2, vtkIdList* cellIds) const
+{
+  const TIds heId = this->FindHalfEdge(cellId, p1, p2);
+  if (heId < 0)
+  {
+    cellIds->Reset();
+    return;
+  }
+  this->GetEdgeNeighbors(heId, cellIds);
+}
+
+//----------------------------------------------------------------------------
+template <typename TIds>
+unsigned long vtkStaticHalfEdgeMeshTemplate<TIds>::GetActualMemorySize() const
+{
+  return static_cast<unsigned long>(2 * sizeof(TIds) * this->NumHalfEdges / 1024);
+}
+
+#endif
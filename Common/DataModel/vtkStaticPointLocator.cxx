@@ -17,7 +17,9 @@
 #include "vtkBoundingBox.h"
 #include "vtkBox.h"
 #include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIntArray.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
@@ -26,7 +28,10 @@
 #include "vtkPolyData.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include "vtkSpaceFillingCurveKeys.h"
 
+#include <algorithm>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkStaticPointLocator);
@@ -1958,6 +1963,182 @@ void vtkStaticPointLocator::FindPointsWithinRadius(double R, const double x[3],
   }
 }
 
+//-----------------------------------------------------------------------------
+// Support for the batched queries. The queries are sorted along the Morton
+// (Z-order) curve of the buckets that contain them, then searched by blocks
+// of consecutive queries. Each block keeps its results until the offsets of
+// all the queries are known, then the results are scattered into the
+// compressed sparse row arrays.
+namespace
+{
+// The query points are either given, or the points of the dataset.
+struct QueryPoints
+{
+  vtkPoints* Points;
+  vtkDataSet* DataSet;
+
+  vtkIdType GetNumberOfPoints() const
+  {
+    return this->Points ? this->Points->GetNumberOfPoints() : this->DataSet->GetNumberOfPoints();
+  }
+  void GetPoint(vtkIdType ptId, double x[3]) const
+  {
+    if (this->Points)
+    {
+      this->Points->GetPoint(ptId, x);
+    }
+    else
+    {
+      this->DataSet->GetPoint(ptId, x);
+    }
+  }
+};
+
+// Run a single point search functor, search(x, result), on all the queries.
+template <typename TSearch>
+void BatchedSearch(const vtkBucketList* bList, const QueryPoints& queries, TSearch& search,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* dist2s)
+{
+  const vtkIdType numQueries = queries.GetNumberOfPoints();
+
+  // Order the queries along the Morton curve of their buckets.
+  std::vector<std::pair<vtkTypeUInt64, vtkIdType>> order(numQueries);
+  vtkSMPTools::For(0, numQueries, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    int ijk[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      queries.GetPoint(i, x);
+      bList->GetBucketIndices(x, ijk);
+      order[i].first = vtkSpaceFillingCurveKeys::MortonKey(ijk[0], ijk[1], ijk[2]);
+      order[i].second = i;
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+
+  // Search the blocks of queries. The number of neighbors of each query is
+  // stored in its offset slot, and turned into offsets afterwards.
+  const vtkIdType blockSize = 1024;
+  const vtkIdType numBlocks = (numQueries + blockSize - 1) / blockSize;
+  std::vector<std::vector<vtkIdType>> blockIds(numBlocks);
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(numQueries + 1);
+  vtkIdType* offs = offsets->GetPointer(0);
+  offs[0] = 0;
+  vtkSMPThreadLocalObject<vtkIdList> localResult;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    vtkIdList* result = localResult.Local();
+    double x[3];
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      std::vector<vtkIdType>& bIds = blockIds[block];
+      const vtkIdType end = std::min(numQueries, (block + 1) * blockSize);
+      for (vtkIdType s = block * blockSize; s < end; ++s)
+      {
+        const vtkIdType q = order[s].second;
+        queries.GetPoint(q, x);
+        search(x, result);
+        const vtkIdType numIds = result->GetNumberOfIds();
+        offs[q + 1] = numIds;
+        bIds.insert(bIds.end(), result->GetPointer(0), result->GetPointer(0) + numIds);
+      }
+    }
+  });
+  for (vtkIdType q = 0; q < numQueries; ++q)
+  {
+    offs[q + 1] += offs[q];
+  }
+
+  // Scatter the results of the blocks.
+  ids->SetNumberOfComponents(1);
+  ids->SetNumberOfTuples(offs[numQueries]);
+  vtkIdType* idsPtr = ids->GetPointer(0);
+  double* d2Ptr = nullptr;
+  if (dist2s)
+  {
+    dist2s->SetNumberOfComponents(1);
+    dist2s->SetNumberOfTuples(offs[numQueries]);
+    d2Ptr = dist2s->GetPointer(0);
+  }
+  vtkDataSet* ds = bList->DataSet;
+  vtkSMPTools::For(0, numBlocks, [&](vtkIdType beginBlock, vtkIdType endBlock) {
+    double x[3], y[3];
+    for (vtkIdType block = beginBlock; block < endBlock; ++block)
+    {
+      const vtkIdType* bIds = blockIds[block].data();
+      const vtkIdType end = std::min(numQueries, (block + 1) * blockSize);
+      for (vtkIdType s = block * blockSize; s < end; ++s)
+      {
+        const vtkIdType q = order[s].second;
+        const vtkIdType numIds = offs[q + 1] - offs[q];
+        std::copy(bIds, bIds + numIds, idsPtr + offs[q]);
+        if (d2Ptr)
+        {
+          queries.GetPoint(q, x);
+          for (vtkIdType i = 0; i < numIds; ++i)
+          {
+            ds->GetPoint(bIds[i], y);
+            d2Ptr[offs[q] + i] = vtkMath::Distance2BetweenPoints(x, y);
+          }
+        }
+        bIds += numIds;
+      }
+      std::vector<vtkIdType>().swap(blockIds[block]);
+    }
+  });
+  offsets->Modified();
+  ids->Modified();
+  if (dist2s)
+  {
+    dist2s->Modified();
+  }
+}
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindClosestNPoints(int N, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* dist2s)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    return;
+  }
+
+  // There cannot be more neighbors than points.
+  const int numNeighbors =
+    static_cast<int>(std::min(static_cast<vtkIdType>(std::max(N, 0)), this->Buckets->NumPts));
+  QueryPoints queryPoints = { queries, this->DataSet };
+  auto search = [this, numNeighbors](const double x[3], vtkIdList* result) {
+    if (numNeighbors > 0)
+    {
+      this->FindClosestNPoints(numNeighbors, x, result);
+    }
+    else
+    {
+      result->Reset();
+    }
+  };
+  BatchedSearch(this->Buckets, queryPoints, search, offsets, ids, dist2s);
+}
+
+//-----------------------------------------------------------------------------
+void vtkStaticPointLocator::FindPointsWithinRadius(double R, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdTypeArray* ids, vtkDoubleArray* dist2s)
+{
+  this->BuildLocator(); // will subdivide if modified; otherwise returns
+  if (!this->Buckets)
+  {
+    return;
+  }
+
+  QueryPoints queryPoints = { queries, this->DataSet };
+  auto search = [this, R](const double x[3], vtkIdList* result) {
+    this->FindPointsWithinRadius(R, x, result);
+  };
+  BatchedSearch(this->Buckets, queryPoints, search, offsets, ids, dist2s);
+}
+
 //-----------------------------------------------------------------------------
 // This method traverses the locator along the defined ray, finding the
 // closest point to a0 when projected onto the line (a0,a1) (i.e., min
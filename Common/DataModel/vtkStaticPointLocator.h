@@ -28,6 +28,12 @@
  * (i.e., incremental point insertion is not supported). If you need to
  * incrementally insert points, use the vtkPointLocator or its kin to do so.
  *
+ * Besides the single point queries, batched versions of FindClosestNPoints()
+ * and FindPointsWithinRadius() process many query points at once, in
+ * parallel, and return the neighbors in compressed sparse row form. Passing
+ * no query points gives the k-nearest neighbor (or fixed radius) graph of
+ * the points of the dataset.
+ *
  * @warning
  * This class is templated. It may run slower than serial execution if the code
  * is not optimized during compilation. Build in Release or ReleaseWithDebugInfo.
@@ -53,7 +59,10 @@
 #include "vtkAbstractPointLocator.h"
 #include "vtkCommonDataModelModule.h" // For export macro
 
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 struct vtkBucketList;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkStaticPointLocator : public vtkAbstractPointLocator
@@ -140,6 +149,31 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  //@{
+  /**
+   * Batched versions of FindClosestNPoints() and FindPointsWithinRadius():
+   * find the neighbors of all the points in queries, in parallel. The
+   * results are returned in compressed sparse row form: the neighbors of
+   * query i are ids[offsets[i]] to ids[offsets[i+1]-1], so offsets has one
+   * more value than there are queries. If dist2s is given, it receives the
+   * squared distance from the query to each neighbor. The N closest points
+   * are sorted from closest to farthest (fewer are returned if the dataset
+   * has less than N points); the points within radius R are not sorted.
+   *
+   * If queries is nullptr, the points of the dataset are the queries, which
+   * gives the k-nearest neighbor (or fixed radius) graph of the dataset.
+   * Note that each point is then one of its own neighbors.
+   *
+   * The queries are processed in the Morton (Z-curve) order of the buckets
+   * containing them, so that the queries handled in sequence by a thread are
+   * close to each other and visit the same buckets.
+   */
+  void FindClosestNPoints(int N, vtkPoints* queries, vtkIdTypeArray* offsets,
+    vtkIdTypeArray* ids, vtkDoubleArray* dist2s = nullptr);
+  void FindPointsWithinRadius(double R, vtkPoints* queries, vtkIdTypeArray* offsets,
+    vtkIdTypeArray* ids, vtkDoubleArray* dist2s = nullptr);
+  //@}
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
@@ -15,12 +15,19 @@
 
 #include <iostream>
 
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPerspectiveTransform.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
 #include "vtkTransform.h"
 
+#include <cmath>
+
 // forward declare test subroutines
 int testUseOfInverse();
 int testConcatenationIdentity();
+int testBulkTransformPoints();
 
 int TestTransform(int, char*[])
 {
@@ -28,6 +35,7 @@ int TestTransform(int, char*[])
 
   numErrors += testUseOfInverse();
   numErrors += testConcatenationIdentity();
+  numErrors += testBulkTransformPoints();
 
   return (numErrors > 0) ? 1 : 0;
 }
@@ -89,3 +97,93 @@ int testConcatenationIdentity()
   trans1->DeepCopy(trans2);
   return 0;
 }
+
+// Check that the bulk transformation of large point arrays, which runs in
+// parallel, matches the single point path, both when appending to another
+// vtkPoints and when transforming in place.
+int testBulkTransformPoints()
+{
+  const vtkIdType numPts = 20000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToFloat();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetNumberOfComponents(3);
+  vectors->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    points->SetPoint(i, i % 17, i % 31, i % 7);
+    vectors->SetTuple3(i, 1.0, i % 3, 0.5);
+  }
+
+  vtkNew<vtkTransform> linear;
+  linear->Translate(1.0, -2.0, 3.0);
+  linear->RotateZ(30.0);
+  linear->Scale(2.0, 1.0, 0.5);
+
+  vtkNew<vtkPerspectiveTransform> perspective;
+  perspective->Perspective(30.0, 1.0, 1.0, 100.0);
+  perspective->Translate(0.0, 0.0, -50.0);
+
+  vtkAbstractTransform* transforms[2] = { linear, perspective };
+  for (vtkAbstractTransform* transform : transforms)
+  {
+    vtkNew<vtkPoints> appended;
+    appended->SetDataTypeToDouble();
+    appended->InsertNextPoint(0.0, 0.0, 0.0);
+    transform->TransformPoints(points, appended);
+
+    vtkNew<vtkPoints> inPlace;
+    inPlace->DeepCopy(points);
+    transform->TransformPoints(inPlace, inPlace);
+
+    if (appended->GetNumberOfPoints() != numPts + 1 || inPlace->GetNumberOfPoints() != numPts)
+    {
+      std::cerr << transform->GetClassName() << ": wrong number of points." << std::endl;
+      return 1;
+    }
+    for (vtkIdType i = 0; i < numPts; i++)
+    {
+      double p[3], expected[3];
+      points->GetPoint(i, p);
+      transform->TransformPoint(p, expected);
+      double a[3], b[3];
+      appended->GetPoint(i + 1, a);
+      inPlace->GetPoint(i, b);
+      for (int j = 0; j < 3; j++)
+      {
+        const double tol = 1e-5 * (1.0 + std::fabs(expected[j]));
+        if (std::fabs(a[j] - expected[j]) > tol || std::fabs(b[j] - expected[j]) > tol)
+        {
+          std::cerr << transform->GetClassName() << ": wrong point " << i << std::endl;
+          return 1;
+        }
+      }
+    }
+  }
+
+  // Vectors in place.
+  vtkNew<vtkFloatArray> expectedVectors;
+  expectedVectors->DeepCopy(vectors);
+  for (vtkIdType i = 0; i < numPts; i++)
+  {
+    double v[3];
+    linear->TransformVector(vectors->GetTuple3(i), v);
+    expectedVectors->SetTuple(i, v);
+  }
+  linear->TransformVectors(vectors, vectors);
+  if (vectors->GetNumberOfTuples() != numPts)
+  {
+    std::cerr << "TransformVectors in place changed the number of tuples." << std::endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < 3 * numPts; i++)
+  {
+    if (std::fabs(vectors->GetValue(i) - expectedVectors->GetValue(i)) > 1e-4)
+    {
+      std::cerr << "Wrong vector component " << i << std::endl;
+      return 1;
+    }
+  }
+  return 0;
+}
@@ -14,12 +14,19 @@
 =========================================================================*/
 #include "vtkHomogeneousTransform.h"
 
+#include "vtkDataArray.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <cstring>
 
 namespace
 {
+// Arrays with fewer points than this are transformed serially.
+const vtkIdType vtkHomogeneousTransformSMPThreshold = 10000;
+
 void TransformVector(double M[4][4], double* outPnt, double f, double* inVec, double* outVec)
 {
   // do the linear homogeneous transformation
@@ -119,23 +126,82 @@ void vtkHomogeneousTransform::InternalTransformDerivative(
   vtkHomogeneousTransformDerivative(this->Matrix->Element, in, out, derivative);
 }
 
+//------------------------------------------------------------------------
+// Transform n contiguous points, in parallel for large arrays. The matrix
+// is copied to the stack so that the compiler knows the output cannot
+// alias it. Supports in == out.
+template <class T2, class T3>
+inline void vtkHomogeneousTransformPoints(double mat[4][4], T2* in, T3* out, vtkIdType n)
+{
+  auto worker = [&](vtkIdType begin, vtkIdType end) {
+    double M[4][4];
+    memcpy(*M, *mat, 16 * sizeof(double));
+    T2* pin = in + 3 * begin;
+    T3* pout = out + 3 * begin;
+    for (vtkIdType i = begin; i < end; i++, pin += 3, pout += 3)
+    {
+      vtkHomogeneousTransformPoint(M, pin, pout);
+    }
+  };
+  if (n < vtkHomogeneousTransformSMPThreshold)
+  {
+    worker(0, n);
+  }
+  else
+  {
+    vtkSMPTools::For(0, n, worker);
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkHomogeneousTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
 {
   vtkIdType n = inPts->GetNumberOfPoints();
   double(*M)[4] = this->Matrix->Element;
-  double point[3];
 
   this->Update();
 
-  for (int i = 0; i < n; i++)
+  // the points are transformed in place when inPts == outPts
+  vtkIdType m = (inPts == outPts ? 0 : outPts->GetNumberOfPoints());
+
+  // operate directly on the memory to avoid GetPoint()/InsertNextPoint() calls.
+  vtkDataArray* inArray = inPts->GetData();
+  vtkDataArray* outArray = outPts->GetData();
+  int inType = inArray->GetDataType();
+  int outType = outArray->GetDataType();
+  void* outPtr = outArray->WriteVoidPointer(3 * m, 3 * n);
+  void* inPtr = inArray->GetVoidPointer(0);
+
+  if (inType == VTK_FLOAT && outType == VTK_FLOAT)
+  {
+    vtkHomogeneousTransformPoints(M, static_cast<float*>(inPtr), static_cast<float*>(outPtr), n);
+  }
+  else if (inType == VTK_FLOAT && outType == VTK_DOUBLE)
   {
-    inPts->GetPoint(i, point);
+    vtkHomogeneousTransformPoints(M, static_cast<float*>(inPtr), static_cast<double*>(outPtr), n);
+  }
+  else if (inType == VTK_DOUBLE && outType == VTK_FLOAT)
+  {
+    vtkHomogeneousTransformPoints(M, static_cast<double*>(inPtr), static_cast<float*>(outPtr), n);
+  }
+  else if (inType == VTK_DOUBLE && outType == VTK_DOUBLE)
+  {
+    vtkHomogeneousTransformPoints(M, static_cast<double*>(inPtr), static_cast<double*>(outPtr), n);
+  }
+  else
+  {
+    double point[3];
 
-    vtkHomogeneousTransformPoint(M, point, point);
+    for (vtkIdType i = 0; i < n; i++)
+    {
+      inPts->GetPoint(i, point);
+
+      vtkHomogeneousTransformPoint(M, point, point);
 
-    outPts->InsertNextPoint(point);
+      outPts->SetPoint(m + i, point);
+    }
   }
+  outPts->Modified();
 }
 
 //----------------------------------------------------------------------------
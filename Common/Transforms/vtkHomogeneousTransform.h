@@ -39,7 +39,9 @@ public:
 
   /**
    * Apply the transformation to a series of points, and append the
-   * results to outPts.
+   * results to outPts. If both arguments are the same object, the points
+   * are transformed in place. Large float and double arrays are processed
+   * in parallel with vtkSMPTools.
    */
   void TransformPoints(vtkPoints* inPts, vtkPoints* outPts) override;
 
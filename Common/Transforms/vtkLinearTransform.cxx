@@ -18,6 +18,31 @@
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <cstring>
+
+namespace
+{
+// Arrays with fewer tuples than this are transformed serially, the work
+// per tuple being too small to amortize the threading overhead.
+const vtkIdType vtkLinearTransformSMPThreshold = 10000;
+
+//------------------------------------------------------------------------
+// Apply worker(begin, end) over [0, n), in parallel for large arrays.
+template <class Worker>
+inline void vtkLinearTransformExecute(vtkIdType n, Worker& worker)
+{
+  if (n < vtkLinearTransformSMPThreshold)
+  {
+    worker(0, n);
+  }
+  else
+  {
+    vtkSMPTools::For(0, n, worker);
+  }
+}
+}
 
 //------------------------------------------------------------------------
 void vtkLinearTransform::PrintSelf(ostream& os, vtkIndent indent)
@@ -84,41 +109,59 @@ inline void vtkLinearTransformNormal(T1 mat[4][4], T2 in[3], T3 out[3])
 }
 
 //------------------------------------------------------------------------
+// The bulk helpers below copy the matrix to the stack so that the compiler
+// knows the output cannot alias it, which lets the per-tuple loop be
+// vectorized. Each helper supports in == out.
 template <class T1, class T2, class T3>
-inline void vtkLinearTransformPoints(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+inline void vtkLinearTransformPoints(T1 mat[4][4], T2* in, T3* out, vtkIdType n)
 {
-  for (vtkIdType i = 0; i < n; i++)
-  {
-    vtkLinearTransformPoint(matrix, in, out);
-    in += 3;
-    out += 3;
-  }
+  auto worker = [&](vtkIdType begin, vtkIdType end) {
+    T1 matrix[4][4];
+    memcpy(*matrix, *mat, 16 * sizeof(T1));
+    T2* pin = in + 3 * begin;
+    T3* pout = out + 3 * begin;
+    for (vtkIdType i = begin; i < end; i++, pin += 3, pout += 3)
+    {
+      vtkLinearTransformPoint(matrix, pin, pout);
+    }
+  };
+  vtkLinearTransformExecute(n, worker);
 }
 
 //------------------------------------------------------------------------
 template <class T1, class T2, class T3>
-inline void vtkLinearTransformVectors(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+inline void vtkLinearTransformVectors(T1 mat[4][4], T2* in, T3* out, vtkIdType n)
 {
-  for (vtkIdType i = 0; i < n; i++)
-  {
-    vtkLinearTransformVector(matrix, in, out);
-    in += 3;
-    out += 3;
-  }
+  auto worker = [&](vtkIdType begin, vtkIdType end) {
+    T1 matrix[4][4];
+    memcpy(*matrix, *mat, 16 * sizeof(T1));
+    T2* pin = in + 3 * begin;
+    T3* pout = out + 3 * begin;
+    for (vtkIdType i = begin; i < end; i++, pin += 3, pout += 3)
+    {
+      vtkLinearTransformVector(matrix, pin, pout);
+    }
+  };
+  vtkLinearTransformExecute(n, worker);
 }
 
 //------------------------------------------------------------------------
 template <class T1, class T2, class T3>
-inline void vtkLinearTransformNormals(T1 matrix[4][4], T2* in, T3* out, vtkIdType n)
+inline void vtkLinearTransformNormals(T1 mat[4][4], T2* in, T3* out, vtkIdType n)
 {
-  for (vtkIdType i = 0; i < n; i++)
-  {
-    // matrix has been transposed & inverted, so use TransformVector
-    vtkLinearTransformVector(matrix, in, out);
-    vtkMath::Normalize(out);
-    in += 3;
-    out += 3;
-  }
+  auto worker = [&](vtkIdType begin, vtkIdType end) {
+    T1 matrix[4][4];
+    memcpy(*matrix, *mat, 16 * sizeof(T1));
+    T2* pin = in + 3 * begin;
+    T3* pout = out + 3 * begin;
+    for (vtkIdType i = begin; i < end; i++, pin += 3, pout += 3)
+    {
+      // matrix has been transposed & inverted, so use TransformVector
+      vtkLinearTransformVector(matrix, pin, pout);
+      vtkMath::Normalize(pout);
+    }
+  };
+  vtkLinearTransformExecute(n, worker);
 }
 
 //------------------------------------------------------------------------
@@ -204,18 +247,20 @@ void vtkLinearTransform::TransformPointsNormalsVectors(vtkPoints* inPts, vtkPoin
 void vtkLinearTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
 {
   vtkIdType n = inPts->GetNumberOfPoints();
-  vtkIdType m = outPts->GetNumberOfPoints();
   double(*matrix)[4] = this->Matrix->Element;
 
   this->Update();
 
+  // the points are transformed in place when inPts == outPts
+  vtkIdType m = (inPts == outPts ? 0 : outPts->GetNumberOfPoints());
+
   // operate directly on the memory to avoid GetPoint()/SetPoint() calls.
   vtkDataArray* inArray = inPts->GetData();
   vtkDataArray* outArray = outPts->GetData();
   int inType = inArray->GetDataType();
   int outType = outArray->GetDataType();
-  void* inPtr = inArray->GetVoidPointer(0);
   void* outPtr = outArray->WriteVoidPointer(3 * m, 3 * n);
+  void* inPtr = inArray->GetVoidPointer(0);
 
   if (inType == VTK_FLOAT && outType == VTK_FLOAT)
   {
@@ -246,13 +291,14 @@ void vtkLinearTransform::TransformPoints(vtkPoints* inPts, vtkPoints* outPts)
       outPts->SetPoint(m + i, point);
     }
   }
+  outPts->Modified();
 }
 
 //----------------------------------------------------------------------------
 void vtkLinearTransform::TransformNormals(vtkDataArray* inNms, vtkDataArray* outNms)
 {
   vtkIdType n = inNms->GetNumberOfTuples();
-  vtkIdType m = outNms->GetNumberOfTuples();
+  vtkIdType m = (inNms == outNms ? 0 : outNms->GetNumberOfTuples());
   double matrix[4][4];
 
   this->Update();
@@ -265,8 +311,8 @@ void vtkLinearTransform::TransformNormals(vtkDataArray* inNms, vtkDataArray* out
   // operate directly on the memory to avoid GetTuple()/SetPoint() calls.
   int inType = inNms->GetDataType();
   int outType = outNms->GetDataType();
-  void* inPtr = inNms->GetVoidPointer(0);
   void* outPtr = outNms->WriteVoidPointer(3 * m, 3 * n);
+  void* inPtr = inNms->GetVoidPointer(0);
 
   if (inType == VTK_FLOAT && outType == VTK_FLOAT)
   {
@@ -305,7 +351,7 @@ void vtkLinearTransform::TransformNormals(vtkDataArray* inNms, vtkDataArray* out
 void vtkLinearTransform::TransformVectors(vtkDataArray* inVrs, vtkDataArray* outVrs)
 {
   vtkIdType n = inVrs->GetNumberOfTuples();
-  vtkIdType m = outVrs->GetNumberOfTuples();
+  vtkIdType m = (inVrs == outVrs ? 0 : outVrs->GetNumberOfTuples());
 
   double(*matrix)[4] = this->Matrix->Element;
 
@@ -314,8 +360,8 @@ void vtkLinearTransform::TransformVectors(vtkDataArray* inVrs, vtkDataArray* out
   // operate directly on the memory to avoid GetTuple()/SetTuple() calls.
   int inType = inVrs->GetDataType();
   int outType = outVrs->GetDataType();
-  void* inPtr = inVrs->GetVoidPointer(0);
   void* outPtr = outVrs->WriteVoidPointer(3 * m, 3 * n);
+  void* inPtr = inVrs->GetVoidPointer(0);
 
   if (inType == VTK_FLOAT && outType == VTK_FLOAT)
   {
@@ -178,19 +178,25 @@ public:
 
   /**
    * Apply the transformation to a series of points, and append the
-   * results to outPts.
+   * results to outPts. If both arguments are the same object, the points
+   * are transformed in place. Large float and double arrays are
+   * processed in parallel with vtkSMPTools.
    */
   void TransformPoints(vtkPoints* inPts, vtkPoints* outPts) override;
 
   /**
    * Apply the transformation to a series of normals, and append the
-   * results to outNms.
+   * results to outNms. If both arguments are the same object, the normals
+   * are transformed in place. Large float and double arrays are
+   * processed in parallel with vtkSMPTools.
    */
   virtual void TransformNormals(vtkDataArray* inNms, vtkDataArray* outNms);
 
   /**
    * Apply the transformation to a series of vectors, and append the
-   * results to outVrs.
+   * results to outVrs. If both arguments are the same object, the vectors
+   * are transformed in place. Large float and double arrays are
+   * processed in parallel with vtkSMPTools.
    */
   virtual void TransformVectors(vtkDataArray* inVrs, vtkDataArray* outVrs);
 
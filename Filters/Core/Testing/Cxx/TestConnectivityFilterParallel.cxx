@@ -0,0 +1,183 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestConnectivityFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel labeling of vtkConnectivityFilter and
+// vtkPolyDataConnectivityFilter extracts the same cells, with the same
+// region ids, as the serial labeling, in all the extraction modes and with
+// scalar connectivity.
+
+#include "vtkCellArray.h"
+#include "vtkConnectivityFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkPolyDataConnectivityFilter.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+const int Size = 60;
+
+// A grid of quads with randomly removed cells, making many fragments, some
+// of them touching at a single point, and random point scalars.
+void InitializeFragments(vtkPolyData* polyData, vtkUnstructuredGrid* unstructuredGrid)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  for (int j = 0; j <= Size; ++j)
+  {
+    for (int i = 0; i <= Size; ++i)
+    {
+      points->InsertNextPoint(i, j, 0.0);
+      random->Next();
+      scalars->InsertNextValue(random->GetValue());
+    }
+  }
+  vtkNew<vtkCellArray> quads;
+  for (int j = 0; j < Size; ++j)
+  {
+    for (int i = 0; i < Size; ++i)
+    {
+      random->Next();
+      if (random->GetValue() < 0.45)
+      {
+        continue;
+      }
+      const vtkIdType p0 = j * (Size + 1) + i;
+      const vtkIdType quad[4] = { p0, p0 + 1, p0 + Size + 2, p0 + Size + 1 };
+      quads->InsertNextCell(4, quad);
+    }
+  }
+
+  polyData->SetPoints(points);
+  polyData->SetPolys(quads);
+  polyData->GetPointData()->SetScalars(scalars);
+  unstructuredGrid->SetPoints(points);
+  unstructuredGrid->SetCells(VTK_QUAD, quads);
+  unstructuredGrid->GetPointData()->SetScalars(scalars);
+}
+
+// Extract the regions with the serial or the parallel labeling. With
+// scalars == 2, vtkPolyDataConnectivityFilter uses full scalar connectivity.
+vtkSmartPointer<vtkPointSet> FilterConnectivity(
+  vtkDataObject* input, bool polyDataFilter, int mode, int scalars, bool parallel)
+{
+  vtkSmartPointer<vtkPointSet> output;
+  if (polyDataFilter)
+  {
+    vtkNew<vtkPolyDataConnectivityFilter> connectivity;
+    connectivity->SetInputData(input);
+    connectivity->SetExtractionMode(mode);
+    connectivity->ColorRegionsOn();
+    connectivity->SetScalarConnectivity(scalars != 0);
+    connectivity->SetFullScalarConnectivity(scalars == 2);
+    connectivity->SetScalarRange(0.25, 0.75);
+    connectivity->AddSeed(Size);
+    connectivity->AddSeed(3 * Size + 17);
+    connectivity->AddSpecifiedRegion(1);
+    connectivity->AddSpecifiedRegion(4);
+    connectivity->SetClosestPoint(Size / 2, Size / 2, 0.0);
+    connectivity->SetParallelLabeling(parallel);
+    connectivity->Update();
+    output = connectivity->GetOutput();
+  }
+  else
+  {
+    vtkNew<vtkConnectivityFilter> connectivity;
+    connectivity->SetInputData(input);
+    connectivity->SetExtractionMode(mode);
+    connectivity->ColorRegionsOn();
+    connectivity->SetScalarConnectivity(scalars != 0);
+    connectivity->SetScalarRange(0.25, 0.75);
+    connectivity->AddSeed(Size);
+    connectivity->AddSeed(3 * Size + 17);
+    connectivity->AddSpecifiedRegion(1);
+    connectivity->AddSpecifiedRegion(4);
+    connectivity->SetClosestPoint(Size / 2, Size / 2, 0.0);
+    connectivity->SetRegionIdAssignmentMode(vtkConnectivityFilter::CELL_COUNT_DESCENDING);
+    connectivity->SetParallelLabeling(parallel);
+    connectivity->Update();
+    output = vtkPointSet::SafeDownCast(connectivity->GetOutput());
+  }
+  return output;
+}
+}
+
+int TestConnectivityFilterParallel(int, char*[])
+{
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkUnstructuredGrid> unstructuredGrid;
+  InitializeFragments(polyData, unstructuredGrid);
+
+  // vtkPolyDataConnectivityFilter, then vtkConnectivityFilter on both inputs
+  vtkDataObject* inputs[3] = { polyData, polyData, unstructuredGrid };
+  for (int mode = VTK_EXTRACT_POINT_SEEDED_REGIONS; mode <= VTK_EXTRACT_CLOSEST_POINT_REGION;
+       ++mode)
+  {
+    for (int scalars = 0; scalars < 3; ++scalars)
+    {
+      for (int filter = 0; filter < 3; ++filter)
+      {
+        if (filter > 0 && scalars == 2)
+        {
+          continue;
+        }
+        vtkSmartPointer<vtkPointSet> serial =
+          FilterConnectivity(inputs[filter], filter == 0, mode, scalars, false);
+        vtkSmartPointer<vtkPointSet> parallel =
+          FilterConnectivity(inputs[filter], filter == 0, mode, scalars, true);
+
+        // The same cells, with the same points and point region ids
+        vtkDataArray* serialRegionIds = serial->GetPointData()->GetArray("RegionId");
+        vtkDataArray* parallelRegionIds = parallel->GetPointData()->GetArray("RegionId");
+        bool same = (serial->GetNumberOfCells() == parallel->GetNumberOfCells() &&
+          serial->GetNumberOfPoints() == parallel->GetNumberOfPoints() && serialRegionIds &&
+          parallelRegionIds);
+        vtkNew<vtkIdList> serialPts;
+        vtkNew<vtkIdList> parallelPts;
+        for (vtkIdType cellId = 0; same && cellId < serial->GetNumberOfCells(); ++cellId)
+        {
+          serial->GetCellPoints(cellId, serialPts);
+          parallel->GetCellPoints(cellId, parallelPts);
+          same = (serialPts->GetNumberOfIds() == parallelPts->GetNumberOfIds());
+          for (vtkIdType i = 0; same && i < serialPts->GetNumberOfIds(); ++i)
+          {
+            double x[3], y[3];
+            serial->GetPoint(serialPts->GetId(i), x);
+            parallel->GetPoint(parallelPts->GetId(i), y);
+            same = (x[0] == y[0] && x[1] == y[1] && x[2] == y[2] &&
+              serialRegionIds->GetTuple1(serialPts->GetId(i)) ==
+                parallelRegionIds->GetTuple1(parallelPts->GetId(i)));
+          }
+        }
+        if (!same)
+        {
+          cerr << "The parallel labeling differs from the serial one with filter " << filter
+               << ", extraction mode " << mode << " and scalars " << scalars << endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay2DParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the parallel triangulation of vtkDelaunay2D with the serial one.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <array>
+#include <set>
+
+namespace
+{
+using CellSet = std::set<std::array<vtkIdType, 3> >;
+
+// The cells as sorted triplets of point ids, padded with -1
+CellSet GetCells(vtkCellArray* cells)
+{
+  CellSet cellSet;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (cells->InitTraversal(); cells->GetNextCell(npts, pts);)
+  {
+    std::array<vtkIdType, 3> cell = { { -1, -1, -1 } };
+    std::copy(pts, pts + std::min(npts, vtkIdType(3)), cell.begin());
+    std::sort(cell.begin(), cell.end());
+    cellSet.insert(cell);
+  }
+  return cellSet;
+}
+
+// Points on a grid of n x n, randomly displaced by up to jitter times the
+// grid spacing.
+void MakePoints(vtkPoints* points, int n, double jitter)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (int j = 0; j < n; ++j)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      const double dx = random->GetRangeValue(-jitter, jitter);
+      random->Next();
+      const double dy = random->GetRangeValue(-jitter, jitter);
+      random->Next();
+      points->InsertNextPoint(i + dx, j + dy, 0.01 * i * j);
+    }
+  }
+}
+
+int Compare(vtkPolyData* input, double alpha, bool identical)
+{
+  vtkNew<vtkDelaunay2D> serial;
+  serial->SetInputData(input);
+  serial->SetAlpha(alpha);
+  serial->Update();
+
+  vtkNew<vtkDelaunay2D> parallel;
+  parallel->SetInputData(input);
+  parallel->SetAlpha(alpha);
+  parallel->ParallelTriangulationOn();
+  parallel->Update();
+
+  vtkPolyData* expected = serial->GetOutput();
+  vtkPolyData* output = parallel->GetOutput();
+  const CellSet polys = GetCells(output->GetPolys());
+  if (static_cast<vtkIdType>(polys.size()) != output->GetNumberOfPolys())
+  {
+    cerr << "Duplicate triangles in the parallel triangulation" << endl;
+    return 1;
+  }
+  if (output->GetNumberOfPolys() != expected->GetNumberOfPolys())
+  {
+    cerr << "Expected " << expected->GetNumberOfPolys() << " triangles, got "
+         << output->GetNumberOfPolys() << endl;
+    return 1;
+  }
+  if (identical &&
+    (polys != GetCells(expected->GetPolys()) ||
+      GetCells(output->GetLines()) != GetCells(expected->GetLines()) ||
+      GetCells(output->GetVerts()) != GetCells(expected->GetVerts())))
+  {
+    cerr << "The parallel and serial triangulations differ" << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestDelaunay2DParallel(int, char*[])
+{
+  // Points in general position have a unique triangulation
+  vtkNew<vtkPoints> points;
+  MakePoints(points, 150, 0.3);
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  if (Compare(input, 0.0, true) || Compare(input, 0.6, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Points on a regular grid can be triangulated in many ways, all having
+  // the same number of triangles.
+  vtkNew<vtkPoints> gridPoints;
+  MakePoints(gridPoints, 150, 0.0);
+  vtkNew<vtkPolyData> grid;
+  grid->SetPoints(gridPoints);
+  if (Compare(grid, 0.0, false))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay3DParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the parallel triangulation of vtkDelaunay3D is a valid Delaunay
+// tetrahedralization: the tetrahedra are positively oriented, fill the convex
+// hull and have empty circumspheres.
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay3D.h"
+#include "vtkIdList.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTetra.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+int Check(vtkPolyData* input, double alpha, double expectedVolume, const char* label)
+{
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(input);
+  delaunay->SetTolerance(0.0);
+  delaunay->SetAlpha(alpha);
+  delaunay->ParallelTriangulationOn();
+  delaunay->Update();
+  vtkUnstructuredGrid* output = delaunay->GetOutput();
+  vtkPoints* points = output->GetPoints();
+  if (output->GetNumberOfCells() == 0)
+  {
+    cerr << label << ": empty triangulation" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkPointLocator> locator;
+  locator->SetDataSet(input);
+  locator->BuildLocator();
+  vtkNew<vtkIdList> neighbors;
+  double volume = 0.0;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    if (output->GetCellType(cellId) != VTK_TETRA)
+    {
+      continue;
+    }
+    vtkIdType npts;
+    const vtkIdType* pts;
+    output->GetCellPoints(cellId, npts, pts);
+    double x[4][3];
+    for (int i = 0; i < 4; ++i)
+    {
+      points->GetPoint(pts[i], x[i]);
+    }
+    const double v = vtkTetra::ComputeVolume(x[0], x[1], x[2], x[3]);
+    if (v <= 0.0)
+    {
+      cerr << label << ": tetrahedron " << cellId << " is not positively oriented" << endl;
+      return 1;
+    }
+    volume += v;
+
+    // No input point lies strictly inside the circumsphere
+    double center[3];
+    const double radius = std::sqrt(vtkTetra::Circumsphere(x[0], x[1], x[2], x[3], center));
+    locator->FindPointsWithinRadius(radius * (1.0 - 1.0e-9), center, neighbors);
+    for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType ptId = neighbors->GetId(i);
+      if (ptId != pts[0] && ptId != pts[1] && ptId != pts[2] && ptId != pts[3])
+      {
+        cerr << label << ": point " << ptId << " is inside the circumsphere of tetrahedron "
+             << cellId << endl;
+        return 1;
+      }
+    }
+  }
+
+  if (expectedVolume > 0.0 && std::abs(volume - expectedVolume) > 1.0e-9 * expectedVolume)
+  {
+    cerr << label << ": expected a volume of " << expectedVolume << ", got " << volume << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestDelaunay3DParallel(int, char*[])
+{
+  // Random points, enough to be split in several regions
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  vtkNew<vtkPoints> points;
+  for (int i = 0; i < 30000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetValue();
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  if (Check(input, 0.0, 0.0, "Random points") || Check(input, 0.05, 0.0, "Alpha shape"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The points of a regular grid are degenerate: every cube has its eight
+  // corners on a sphere. The triangulation must still fill the grid.
+  const int n = 30;
+  vtkNew<vtkPoints> gridPoints;
+  for (int k = 0; k < n; ++k)
+  {
+    for (int j = 0; j < n; ++j)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        gridPoints->InsertNextPoint(i, j, k);
+      }
+    }
+  }
+  vtkNew<vtkPolyData> grid;
+  grid->SetPoints(gridPoints);
+  if (Check(grid, 0.0, (n - 1) * (n - 1) * (n - 1), "Grid"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFastWindingNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the winding number of a sphere against the analytic inside test,
+// with and without holes in the sphere, and the winding number mode of
+// vtkSelectEnclosedPoints.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkFastWindingNumber.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+namespace
+{
+const double Radius = 0.5;
+
+void RandomPoints(vtkPoints* points, vtkIdType numPts)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-0.8, 0.8);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// Compare the classification with the sphere, ignoring the points within
+// margin of the sphere.
+int CheckWindingNumbers(vtkPoints* points, vtkDataArray* windingNumbers, double margin,
+  const char* label)
+{
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    const double r = vtkMath::Norm(points->GetPoint(i));
+    if (std::abs(r - Radius) < margin)
+    {
+      continue;
+    }
+    const double w = windingNumbers->GetTuple1(i);
+    if ((r < Radius) != (w >= 0.5) || std::abs(w - (r < Radius ? 1.0 : 0.0)) > 0.1)
+    {
+      cerr << label << ": wrong winding number " << w << " at distance " << r << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestFastWindingNumber(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(points, 20000);
+
+  // Closed surface
+  vtkNew<vtkFastWindingNumber> windingNumber;
+  windingNumber->SetSurface(surface);
+  vtkNew<vtkDoubleArray> windingNumbers;
+  windingNumber->EvaluateWindingNumbers(points, windingNumbers);
+  if (CheckWindingNumbers(points, windingNumbers, 0.01, "Closed sphere"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The dipole approximation is close to the exact winding number
+  vtkNew<vtkFastWindingNumber> exact;
+  exact->SetSurface(surface);
+  exact->SetAccuracy(VTK_DOUBLE_MAX);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    const double w = exact->EvaluateWindingNumber(points->GetPoint(i));
+    if (std::abs(w - windingNumbers->GetValue(i)) > 0.05)
+    {
+      cerr << "Approximate winding number " << windingNumbers->GetValue(i)
+           << " differs from the exact winding number " << w << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Reversing the orientation of the polygons negates the winding number
+  vtkNew<vtkCellArray> reversed;
+  reversed->DeepCopy(surface->GetPolys());
+  for (vtkIdType i = 0; i < reversed->GetNumberOfCells(); ++i)
+  {
+    reversed->ReverseCellAtId(i);
+  }
+  vtkNew<vtkPolyData> inward;
+  inward->SetPoints(surface->GetPoints());
+  inward->SetPolys(reversed);
+  windingNumber->SetSurface(inward);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    const double w = windingNumber->EvaluateWindingNumber(points->GetPoint(i));
+    if (std::abs(w + windingNumbers->GetValue(i)) > 1.0e-9)
+    {
+      cerr << "Reversing the surface does not negate the winding number" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Punch small holes in the sphere: the classification of the points away
+  // from the surface is unchanged.
+  vtkNew<vtkCellArray> holed;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = surface->GetPolys();
+  vtkIdType cellId = 0;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts); ++cellId)
+  {
+    if (cellId % 40 != 0)
+    {
+      holed->InsertNextCell(npts, pts);
+    }
+  }
+  vtkNew<vtkPolyData> holedSurface;
+  holedSurface->SetPoints(surface->GetPoints());
+  holedSurface->SetPolys(holed);
+  windingNumber->SetSurface(holedSurface);
+  windingNumber->EvaluateWindingNumbers(points, windingNumbers);
+  if (CheckWindingNumbers(points, windingNumbers, 0.05, "Sphere with holes"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // vtkSelectEnclosedPoints in winding number mode
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(input);
+  select->SetSurfaceData(holedSurface);
+  select->SetMethodToWindingNumber();
+  select->Update();
+  vtkDataArray* selected = select->GetOutput()->GetPointData()->GetArray("SelectedPoints");
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    const double r = vtkMath::Norm(points->GetPoint(i));
+    if (std::abs(r - Radius) >= 0.05 && (r < Radius) != (selected->GetTuple1(i) != 0.0))
+    {
+      cerr << "vtkSelectEnclosedPoints: wrong classification of point " << i << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
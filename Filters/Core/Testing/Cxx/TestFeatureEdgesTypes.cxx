@@ -0,0 +1,189 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFeatureEdgesTypes.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the edge types found by vtkFeatureEdges on a mesh with boundary,
+// non-manifold, feature and manifold edges, with the default parallel
+// algorithm and with the serial one used with a locator.
+
+#include "vtkFeatureEdges.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkUnsignedCharArray.h"
+
+namespace
+{
+// A vertex, a line, three triangles sharing the edge (0,1), a quad folded
+// along the edge (1,2) of the first triangle, and a flat strip. Point 8 is
+// coincident with point 2, so the strip shares a point of the quad but none
+// of its edges.
+void InitializePolyData(vtkPolyData* mesh)
+{
+  vtkNew<vtkPoints> points;
+  const double x[10][3] = { { 0, 0, 0 }, { 1, 0, 0 }, { 0.5, 1, 0 }, { 0.5, -1, 0 },
+    { 0.5, 0, 1 }, { 1.5, 1, 1 }, { 1.5, 0, 1 }, { 0, 2, 0 }, { 0.5, 1, 0 }, { 1, 2, 1 } };
+  for (int i = 0; i < 10; ++i)
+  {
+    points->InsertNextPoint(x[i]);
+  }
+
+  vtkNew<vtkCellArray> verts;
+  verts->InsertNextCell(1);
+  verts->InsertCellPoint(7);
+  vtkNew<vtkCellArray> lines;
+  lines->InsertNextCell(2);
+  lines->InsertCellPoint(6);
+  lines->InsertCellPoint(7);
+  vtkNew<vtkCellArray> polys;
+  const vtkIdType tri0[3] = { 0, 1, 2 };
+  const vtkIdType tri1[3] = { 1, 0, 3 };
+  const vtkIdType tri2[3] = { 0, 1, 4 };
+  const vtkIdType quad[4] = { 2, 1, 6, 5 };
+  polys->InsertNextCell(3, tri0);
+  polys->InsertNextCell(3, tri1);
+  polys->InsertNextCell(3, tri2);
+  polys->InsertNextCell(4, quad);
+  vtkNew<vtkCellArray> strips;
+  const vtkIdType strip[4] = { 8, 5, 7, 9 };
+  strips->InsertNextCell(4, strip);
+
+  mesh->SetPoints(points);
+  mesh->SetVerts(verts);
+  mesh->SetLines(lines);
+  mesh->SetPolys(polys);
+  mesh->SetStrips(strips);
+
+  vtkNew<vtkIdTypeArray> pointIds;
+  pointIds->SetName("PointIds");
+  for (vtkIdType i = 0; i < mesh->GetNumberOfPoints(); ++i)
+  {
+    pointIds->InsertNextValue(i);
+  }
+  mesh->GetPointData()->AddArray(pointIds);
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType i = 0; i < mesh->GetNumberOfCells(); ++i)
+  {
+    cellIds->InsertNextValue(i);
+  }
+  mesh->GetCellData()->AddArray(cellIds);
+}
+
+// Count the output edges of each type, and check that the points and the
+// cell of each edge come from a polygon or strip using these points.
+int CheckTypes(vtkPolyData* mesh, int types, const int expected[4], const char* label)
+{
+  for (int useLocator = 0; useLocator < 2; ++useLocator)
+  {
+    vtkNew<vtkFeatureEdges> edges;
+    edges->SetInputData(mesh);
+    edges->SetBoundaryEdges((types & 1) != 0);
+    edges->SetNonManifoldEdges((types & 2) != 0);
+    edges->SetFeatureEdges((types & 4) != 0);
+    edges->SetManifoldEdges((types & 8) != 0);
+    edges->SetFeatureAngle(30.0);
+    if (useLocator)
+    {
+      vtkNew<vtkMergePoints> locator;
+      edges->SetLocator(locator);
+    }
+    edges->Update();
+    vtkPolyData* output = edges->GetOutput();
+
+    int counts[4] = { 0, 0, 0, 0 };
+    vtkDataArray* edgeTypes = output->GetCellData()->GetArray("Edge Types");
+    vtkDataArray* cellIds = output->GetCellData()->GetArray("CellIds");
+    vtkDataArray* pointIds = output->GetPointData()->GetArray("PointIds");
+    vtkNew<vtkIdList> edgePts;
+    vtkNew<vtkIdList> cellPts;
+    for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+    {
+      counts[static_cast<int>(edgeTypes->GetTuple1(i) * 4.5 + 0.5)]++;
+      const vtkIdType cellId = static_cast<vtkIdType>(cellIds->GetTuple1(i));
+      mesh->GetCellPoints(cellId, cellPts);
+      output->GetCellPoints(i, edgePts);
+      for (vtkIdType j = 0; j < 2; ++j)
+      {
+        double x[3], y[3];
+        output->GetPoint(edgePts->GetId(j), x);
+        mesh->GetPoint(static_cast<vtkIdType>(pointIds->GetTuple1(edgePts->GetId(j))), y);
+        const bool samePoint = (x[0] == y[0] && x[1] == y[1] && x[2] == y[2]);
+        bool inCell = false;
+        for (vtkIdType k = 0; k < cellPts->GetNumberOfIds() && !inCell; ++k)
+        {
+          mesh->GetPoint(cellPts->GetId(k), y);
+          inCell = (x[0] == y[0] && x[1] == y[1] && x[2] == y[2]);
+        }
+        if (cellId < 2 || !samePoint || !inCell)
+        {
+          cerr << label << ": edge " << i << " does not match cell " << cellId << endl;
+          return 1;
+        }
+      }
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      if (counts[i] != expected[i])
+      {
+        cerr << label << ": " << counts[i] << " edges of type " << i << " instead of "
+             << expected[i] << (useLocator ? " with a locator" : "") << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
+int TestFeatureEdgesTypes(int, char*[])
+{
+  vtkNew<vtkPolyData> mesh;
+  InitializePolyData(mesh);
+
+  // The strip is split into two triangles sharing a manifold edge. The fold
+  // of the quad is the only feature edge. Manifold edges are not extracted
+  // along with feature edges.
+  const int all[4] = { 12, 1, 1, 0 };
+  const int boundary[4] = { 12, 0, 0, 0 };
+  const int nonManifold[4] = { 0, 1, 0, 0 };
+  const int feature[4] = { 0, 0, 1, 0 };
+  const int manifold[4] = { 0, 0, 0, 2 };
+  int status = CheckTypes(mesh, 15, all, "All edges");
+  status += CheckTypes(mesh, 1, boundary, "Boundary edges");
+  status += CheckTypes(mesh, 2, nonManifold, "Non-manifold edges");
+  status += CheckTypes(mesh, 4, feature, "Feature edges");
+  status += CheckTypes(mesh, 8, manifold, "Manifold edges");
+
+  // The edges output by a duplicate cell are skipped, including the edges it
+  // shares with cells of larger ids.
+  vtkNew<vtkUnsignedCharArray> ghosts;
+  ghosts->SetName(vtkDataSetAttributes::GhostArrayName());
+  for (vtkIdType i = 0; i < mesh->GetNumberOfCells(); ++i)
+  {
+    ghosts->InsertNextValue(i == 2 ? vtkDataSetAttributes::DUPLICATECELL : 0);
+  }
+  mesh->GetCellData()->AddArray(ghosts);
+  const int allGhosts[4] = { 11, 0, 0, 0 };
+  status += CheckTypes(mesh, 15, allGhosts, "All edges with ghosts");
+
+  return (status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,239 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestGlyph3DInstances.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the glyph instances generated by vtkGlyph3D, applied to their
+// source, reproduce the glyph geometry, with and without a table of sources
+// and a source transform. Also check that a source mixing several kinds of
+// cells is glyphed with its cells in order.
+
+#include "vtkCellArray.h"
+#include "vtkConeSource.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkGlyph3D.h"
+#include "vtkIdList.h"
+#include "vtkLineSource.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTransform.h"
+
+#include <cmath>
+
+// Glyph the instances of the sources, with or without a table of sources and
+// a source transform, and check that each instance transform applied to its
+// source reproduces the glyph geometry.
+static bool TestGlyph3DInstances_WithSources(
+  vtkPolyData* input, vtkPolyData** sources, int numSources, vtkTransform* sourceTransform)
+{
+  vtkNew<vtkGlyph3D> geometry;
+  vtkNew<vtkGlyph3D> instancer;
+  vtkGlyph3D* glyph3Ds[] = { geometry, instancer };
+  for (vtkGlyph3D* glyph3D : glyph3Ds)
+  {
+    glyph3D->SetInputData(input);
+    for (int i = 0; i < numSources; ++i)
+    {
+      glyph3D->SetSourceData(i, sources[i]);
+    }
+    glyph3D->SetIndexMode(numSources > 1 ? VTK_INDEXING_BY_SCALAR : VTK_INDEXING_OFF);
+    glyph3D->SetScaleModeToScaleByVector();
+    glyph3D->SetScaleFactor(0.5);
+    glyph3D->SetColorModeToColorByScale();
+    glyph3D->GeneratePointIdsOn();
+    glyph3D->SetSourceTransform(sourceTransform);
+  }
+  instancer->GenerateInstancesOn();
+  geometry->Update();
+  instancer->Update();
+  vtkPolyData* glyphs = geometry->GetOutput();
+  vtkPolyData* instances = instancer->GetOutput();
+
+  vtkPointData* outPD = instances->GetPointData();
+  vtkDataArray* transforms = outPD->GetArray("GlyphTransform");
+  vtkDataArray* sourceIndices = outPD->GetArray("GlyphSourceIndex");
+  vtkDataArray* instanceIds = outPD->GetArray("InputPointIds");
+  vtkDataArray* instanceScales = outPD->GetScalars();
+  vtkDataArray* glyphIds = glyphs->GetPointData()->GetArray("InputPointIds");
+  vtkDataArray* glyphScales = glyphs->GetPointData()->GetScalars();
+  if (instances->GetNumberOfPoints() != input->GetNumberOfPoints() ||
+    instances->GetNumberOfCells() != 0 || !transforms ||
+    transforms->GetNumberOfComponents() != 16 || !sourceIndices != (numSources == 1) ||
+    !instanceIds || !instanceScales || outPD->GetNormals())
+  {
+    cerr << "Wrong instance output with " << numSources << " sources" << endl;
+    return false;
+  }
+
+  // Apply each instance transform to its source
+  vtkIdType glyphPtId = 0;
+  vtkIdType numGlyphCells = 0;
+  for (vtkIdType instanceId = 0; instanceId < instances->GetNumberOfPoints(); ++instanceId)
+  {
+    const int sourceIndex =
+      (sourceIndices ? static_cast<int>(sourceIndices->GetTuple1(instanceId)) : 0);
+    vtkPolyData* source = sources[sourceIndex];
+    const vtkIdType inPtId = static_cast<vtkIdType>(instanceIds->GetTuple1(instanceId));
+    double x[3], y[3];
+    instances->GetPoint(instanceId, x);
+    input->GetPoint(inPtId, y);
+    if (vtkMath::Distance2BetweenPoints(x, y) > 1.0e-10)
+    {
+      cerr << "Instance " << instanceId << " is not at its input point" << endl;
+      return false;
+    }
+
+    const double* m = transforms->GetTuple(instanceId);
+    for (vtkIdType i = 0; i < source->GetNumberOfPoints(); ++i, ++glyphPtId)
+    {
+      double p[3], q[3];
+      source->GetPoint(i, p);
+      for (int j = 0; j < 3; ++j)
+      {
+        q[j] = m[4 * j] * p[0] + m[4 * j + 1] * p[1] + m[4 * j + 2] * p[2] + m[4 * j + 3];
+      }
+      glyphs->GetPoint(glyphPtId, y);
+      if (vtkMath::Distance2BetweenPoints(q, y) > 1.0e-8 ||
+        glyphIds->GetTuple1(glyphPtId) != inPtId ||
+        glyphScales->GetTuple1(glyphPtId) != instanceScales->GetTuple1(instanceId))
+      {
+        cerr << "Instance " << instanceId << " does not match glyph point " << glyphPtId << endl;
+        return false;
+      }
+    }
+    numGlyphCells += source->GetNumberOfCells();
+  }
+  if (glyphPtId != glyphs->GetNumberOfPoints() || numGlyphCells != glyphs->GetNumberOfCells())
+  {
+    cerr << "The instances do not cover the glyphs" << endl;
+    return false;
+  }
+  return true;
+}
+
+// Glyph a source with its triangles, line and vertex interleaved, and check
+// that the cells of each glyph are in the order of the source cells.
+static bool TestGlyph3DInstances_WithMixedCells(vtkPolyData* input)
+{
+  vtkNew<vtkPolyData> mixed;
+  vtkNew<vtkPoints> points;
+  points->InsertNextPoint(0.0, 0.0, 0.0);
+  points->InsertNextPoint(1.0, 0.0, 0.0);
+  points->InsertNextPoint(0.0, 1.0, 0.0);
+  points->InsertNextPoint(0.0, 0.0, 1.0);
+  mixed->SetPoints(points);
+  mixed->AllocateEstimate(4, 3);
+  const vtkIdType tri0[3] = { 0, 1, 2 };
+  const vtkIdType line[2] = { 0, 3 };
+  const vtkIdType vert[1] = { 3 };
+  const vtkIdType tri1[3] = { 1, 2, 3 };
+  mixed->InsertNextCell(VTK_TRIANGLE, 3, tri0);
+  mixed->InsertNextCell(VTK_LINE, 2, line);
+  mixed->InsertNextCell(VTK_VERTEX, 1, vert);
+  mixed->InsertNextCell(VTK_TRIANGLE, 3, tri1);
+
+  vtkNew<vtkGlyph3D> glyph3D;
+  glyph3D->SetInputData(input);
+  glyph3D->SetSourceData(mixed);
+  glyph3D->Update();
+  vtkPolyData* output = glyph3D->GetOutput();
+  if (output->GetNumberOfCells() != 4 * input->GetNumberOfPoints())
+  {
+    cerr << "Mixed cells: wrong number of cells" << endl;
+    return false;
+  }
+  vtkNew<vtkIdList> srcPts;
+  vtkNew<vtkIdList> outPts;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType glyphId = cellId / 4;
+    mixed->GetCellPoints(cellId % 4, srcPts);
+    output->GetCellPoints(cellId, outPts);
+    bool same = (output->GetCellType(cellId) == mixed->GetCellType(cellId % 4) &&
+      outPts->GetNumberOfIds() == srcPts->GetNumberOfIds());
+    for (vtkIdType i = 0; same && i < srcPts->GetNumberOfIds(); ++i)
+    {
+      same = (outPts->GetId(i) == srcPts->GetId(i) + 4 * glyphId);
+    }
+    if (!same)
+    {
+      cerr << "Mixed cells: wrong cell " << cellId << endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int TestGlyph3DInstances(int, char*[])
+{
+  // Random points, vectors and scalars
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(7);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetName("Vectors");
+  vectors->SetNumberOfComponents(3);
+  for (int i = 0; i < 500; ++i)
+  {
+    double x[3], v[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-10.0, 10.0);
+      random->Next();
+      v[j] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+    vectors->InsertNextTuple(v);
+    scalars->InsertNextValue(random->GetValue());
+    random->Next();
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->GetPointData()->SetScalars(scalars);
+  input->GetPointData()->SetVectors(vectors);
+
+  vtkNew<vtkConeSource> cone;
+  cone->SetResolution(8);
+  cone->Update();
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(6);
+  sphere->SetPhiResolution(5);
+  sphere->Update();
+  vtkNew<vtkLineSource> line;
+  line->SetResolution(3);
+  line->Update();
+  vtkPolyData* sources[] = { cone->GetOutput(), sphere->GetOutput(), line->GetOutput() };
+
+  vtkNew<vtkTransform> sourceTransform;
+  sourceTransform->RotateZ(30.0);
+  sourceTransform->Scale(1.0, 2.0, 3.0);
+  sourceTransform->Translate(0.1, 0.2, 0.3);
+
+  if (!TestGlyph3DInstances_WithSources(input, sources, 1, nullptr) ||
+    !TestGlyph3DInstances_WithSources(input, sources, 1, sourceTransform) ||
+    !TestGlyph3DInstances_WithSources(input, sources, 3, nullptr) ||
+    !TestGlyph3DInstances_WithSources(input, sources, 3, sourceTransform) ||
+    !TestGlyph3DInstances_WithMixedCells(input))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
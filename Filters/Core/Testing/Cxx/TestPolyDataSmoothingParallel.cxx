@@ -0,0 +1,295 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataSmoothingParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the threaded vertex classification and windowed sinc sweeps of
+// vtkSmoothPolyDataFilter and vtkWindowedSincPolyDataFilter give the same
+// output as a serial implementation of the same algorithms, on a bumpy
+// plane with simple, boundary and fixed vertices.
+
+#include "vtkCellArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkTriangleFilter.h"
+#include "vtkWindowedSincPolyDataFilter.h"
+
+#include <cmath>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const int NumberOfIterations = 20;
+const double EdgeAngle = 15.0;
+
+// The vertices smoothed along their connected points, in the serial order
+struct Vertices
+{
+  std::vector<std::vector<vtkIdType>> Edges;
+  std::vector<bool> Fixed;
+};
+
+// A boundary vertex is smoothed along its two boundary edges unless they
+// make an angle larger than the edge angle; a simple vertex is smoothed
+// along all its edges.
+Vertices ClassifyVertices(vtkPolyData* mesh)
+{
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  std::map<std::pair<vtkIdType, vtkIdType>, int> edgeUses;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = mesh->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      const vtkIdType p0 = pts[i];
+      const vtkIdType p1 = pts[(i + 1) % npts];
+      ++edgeUses[std::make_pair(std::min(p0, p1), std::max(p0, p1))];
+    }
+  }
+
+  std::vector<std::set<vtkIdType>> neighbors(numPts), boundaryNeighbors(numPts);
+  for (const auto& edge : edgeUses)
+  {
+    neighbors[edge.first.first].insert(edge.first.second);
+    neighbors[edge.first.second].insert(edge.first.first);
+    if (edge.second == 1)
+    {
+      boundaryNeighbors[edge.first.first].insert(edge.first.second);
+      boundaryNeighbors[edge.first.second].insert(edge.first.first);
+    }
+  }
+
+  Vertices verts;
+  verts.Edges.resize(numPts);
+  verts.Fixed.resize(numPts, false);
+  const double cosEdgeAngle = std::cos(vtkMath::RadiansFromDegrees(EdgeAngle));
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (boundaryNeighbors[ptId].empty())
+    {
+      verts.Edges[ptId].assign(neighbors[ptId].begin(), neighbors[ptId].end());
+      continue;
+    }
+    verts.Edges[ptId].assign(boundaryNeighbors[ptId].begin(), boundaryNeighbors[ptId].end());
+    if (verts.Edges[ptId].size() != 2)
+    {
+      verts.Fixed[ptId] = true;
+      continue;
+    }
+    double x1[3], x2[3], x3[3], l1[3], l2[3];
+    mesh->GetPoint(verts.Edges[ptId][0], x1);
+    mesh->GetPoint(ptId, x2);
+    mesh->GetPoint(verts.Edges[ptId][1], x3);
+    for (int k = 0; k < 3; ++k)
+    {
+      l1[k] = x2[k] - x1[k];
+      l2[k] = x3[k] - x2[k];
+    }
+    vtkMath::Normalize(l1);
+    vtkMath::Normalize(l2);
+    // The angle does not depend on the order of the two edges
+    verts.Fixed[ptId] = vtkMath::Dot(l1, l2) < cosEdgeAngle;
+  }
+  return verts;
+}
+
+std::vector<double> GetPoints(vtkPolyData* mesh)
+{
+  std::vector<double> x(3 * mesh->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+  {
+    mesh->GetPoint(ptId, x.data() + 3 * ptId);
+  }
+  return x;
+}
+
+// Laplacian smoothing, updating the points in place
+std::vector<double> SmoothLaplacian(vtkPolyData* mesh, double factor)
+{
+  const Vertices verts = ClassifyVertices(mesh);
+  std::vector<double> x = GetPoints(mesh);
+  for (int iteration = 0; iteration < NumberOfIterations; ++iteration)
+  {
+    for (vtkIdType ptId = 0; ptId < mesh->GetNumberOfPoints(); ++ptId)
+    {
+      const std::vector<vtkIdType>& edges = verts.Edges[ptId];
+      if (verts.Fixed[ptId] || edges.empty())
+      {
+        continue;
+      }
+      for (int k = 0; k < 3; ++k)
+      {
+        double mean = 0.0;
+        for (vtkIdType nei : edges)
+        {
+          mean += x[3 * nei + k];
+        }
+        x[3 * ptId + k] += factor * (mean / edges.size() - x[3 * ptId + k]);
+      }
+    }
+  }
+  return x;
+}
+
+// Windowed sinc smoothing with the Chebyshev coefficients of Taubin's
+// "Optimal Surface Smoothing as Filter Design".
+std::vector<double> SmoothWindowedSinc(vtkPolyData* mesh, double passBand)
+{
+  const int n = NumberOfIterations;
+  const double thetaPB = std::acos(1.0 - 0.5 * passBand);
+  std::vector<double> w(n + 1), c(n + 1), cprime(n + 1);
+  for (int i = 0; i <= n; ++i)
+  {
+    w[i] = 0.54 + 0.46 * std::cos(i * vtkMath::Pi() / (n + 1));
+  }
+  double sigma = 0.0;
+  for (int iteration = 0; iteration < 500; ++iteration)
+  {
+    c[0] = w[0] * (thetaPB + sigma) / vtkMath::Pi();
+    for (int i = 1; i <= n; ++i)
+    {
+      c[i] = 2.0 * w[i] * std::sin(i * (thetaPB + sigma)) / (i * vtkMath::Pi());
+    }
+    cprime[n] = cprime[n - 1] = 0.0;
+    cprime[n - 2] = 2.0 * (n - 1) * c[n - 1];
+    for (int i = n - 3; i >= 0; --i)
+    {
+      cprime[i] = cprime[i + 2] + 2.0 * (i + 1) * c[i + 1];
+    }
+    double f = c[0];
+    double fprime = cprime[0];
+    for (int i = 1; i <= n; ++i)
+    {
+      f += c[i] * std::cos(i * thetaPB);
+      fprime += cprime[i] * std::cos(i * thetaPB);
+    }
+    if (std::abs(f - 1.0) < 1.0e-3)
+    {
+      break;
+    }
+    sigma -= (f - 1.0) / fprime;
+  }
+
+  // Jacobi sweeps of the Chebyshev recurrence: x1 = (I - K/2) x0, then
+  // x2 = 2 (I - K/2) x1 - x0, with K the Laplacian operator
+  const vtkIdType numPts = mesh->GetNumberOfPoints();
+  const Vertices verts = ClassifyVertices(mesh);
+  std::vector<double> x0 = GetPoints(mesh);
+  std::vector<double> x3 = x0;
+  std::vector<double> x1(3 * numPts), x2(3 * numPts);
+  auto laplacian = [&](const std::vector<double>& x, vtkIdType ptId, int k) {
+    double delta = 0.0;
+    for (vtkIdType nei : verts.Edges[ptId])
+    {
+      delta += (x[3 * ptId + k] - x[3 * nei + k]) / verts.Edges[ptId].size();
+    }
+    return delta;
+  };
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    for (int k = 0; k < 3 && !verts.Edges[ptId].empty(); ++k)
+    {
+      x1[3 * ptId + k] = x0[3 * ptId + k] - 0.5 * laplacian(x0, ptId, k);
+      if (!verts.Fixed[ptId])
+      {
+        x3[3 * ptId + k] = c[0] * x0[3 * ptId + k] + c[1] * x1[3 * ptId + k];
+      }
+    }
+  }
+  for (int j = 2; j <= n; ++j)
+  {
+    for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+    {
+      for (int k = 0; k < 3 && !verts.Edges[ptId].empty(); ++k)
+      {
+        x2[3 * ptId + k] =
+          2.0 * x1[3 * ptId + k] - x0[3 * ptId + k] - laplacian(x1, ptId, k);
+        if (!verts.Fixed[ptId])
+        {
+          x3[3 * ptId + k] += c[j] * x2[3 * ptId + k];
+        }
+      }
+    }
+    std::swap(x0, x1);
+    std::swap(x1, x2);
+  }
+  return x3;
+}
+
+int Compare(vtkPolyData* output, const std::vector<double>& expected, const char* label)
+{
+  double maxDist = 0.0;
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    maxDist = std::max(maxDist,
+      std::sqrt(vtkMath::Distance2BetweenPoints(x, expected.data() + 3 * ptId)));
+  }
+  if (maxDist > 1.0e-6)
+  {
+    cerr << label << ": the points are " << maxDist << " away from the serial smoothing" << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int TestPolyDataSmoothingParallel(int, char*[])
+{
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(40, 30);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(plane->GetOutputPort());
+  triangles->Update();
+  vtkNew<vtkPolyData> mesh;
+  mesh->DeepCopy(triangles->GetOutput());
+
+  // Bumps, steep enough to fix some of the boundary vertices
+  vtkPoints* points = mesh->GetPoints();
+  for (vtkIdType ptId = 0; ptId < points->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    points->GetPoint(ptId, x);
+    x[2] = 0.05 * std::sin(23.0 * x[0]) * std::cos(17.0 * x[1]);
+    points->SetPoint(ptId, x);
+  }
+
+  vtkNew<vtkSmoothPolyDataFilter> laplacian;
+  laplacian->SetInputData(mesh);
+  laplacian->SetNumberOfIterations(NumberOfIterations);
+  laplacian->SetRelaxationFactor(0.1);
+  laplacian->SetEdgeAngle(EdgeAngle);
+  laplacian->BoundarySmoothingOn();
+  laplacian->Update();
+  int status = Compare(laplacian->GetOutput(), SmoothLaplacian(mesh, 0.1), "Laplacian");
+
+  vtkNew<vtkWindowedSincPolyDataFilter> windowedSinc;
+  windowedSinc->SetInputData(mesh);
+  windowedSinc->SetNumberOfIterations(NumberOfIterations);
+  windowedSinc->SetPassBand(0.1);
+  windowedSinc->SetEdgeAngle(EdgeAngle);
+  windowedSinc->BoundarySmoothingOn();
+  windowedSinc->Update();
+  status += Compare(windowedSinc->GetOutput(), SmoothWindowedSinc(mesh, 0.1), "Windowed sinc");
+
+  return (status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,185 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestQuadricDecimationParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Decimate a sphere in parallel partitions and check that the target
+// reduction is reached, that the mesh stays close to the sphere and that the
+// point data is the same as with the serial decimation: the attributes are
+// interpolated, the normals renormalized and the other arrays copied.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkElevationFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricDecimation.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+const double Radius = 0.5;
+
+int Check(vtkPolyData* input, bool attributes)
+{
+  const char* label = attributes ? "With attributes" : "Geometry only";
+  vtkNew<vtkQuadricDecimation> serial;
+  serial->SetInputData(input);
+  serial->SetTargetReduction(0.8);
+  serial->SetAttributeErrorMetric(attributes);
+  serial->Update();
+
+  vtkNew<vtkQuadricDecimation> parallel;
+  parallel->SetInputData(input);
+  parallel->SetTargetReduction(0.8);
+  parallel->SetAttributeErrorMetric(attributes);
+  parallel->ParallelDecimationOn();
+  parallel->Update();
+  vtkPolyData* output = parallel->GetOutput();
+
+  const vtkIdType numTris = input->GetNumberOfPolys();
+  if (parallel->GetActualReduction() < 0.8 ||
+    output->GetNumberOfPolys() !=
+      numTris - static_cast<vtkIdType>(std::round(parallel->GetActualReduction() * numTris)))
+  {
+    cerr << label << ": wrong reduction " << parallel->GetActualReduction() << " ("
+         << output->GetNumberOfPolys() << " triangles)" << endl;
+    return 1;
+  }
+  if (std::abs(output->GetNumberOfPolys() - serial->GetOutput()->GetNumberOfPolys()) >
+    0.01 * numTris)
+  {
+    cerr << label << ": expected about " << serial->GetOutput()->GetNumberOfPolys()
+         << " triangles, got " << output->GetNumberOfPolys() << endl;
+    return 1;
+  }
+
+  // Valid triangles, using all the points
+  std::vector<bool> used(output->GetNumberOfPoints(), false);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = output->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts != 3 || pts[0] == pts[1] || pts[1] == pts[2] || pts[2] == pts[0])
+    {
+      cerr << label << ": degenerate triangle" << endl;
+      return 1;
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      used[pts[i]] = true;
+    }
+  }
+  for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    if (!used[ptId] || std::abs(vtkMath::Norm(x) - Radius) > 1.0e-3)
+    {
+      cerr << label << ": point " << ptId << " is unused or off the sphere" << endl;
+      return 1;
+    }
+  }
+
+  // The same arrays as the serial output, which only holds point data when
+  // the attributes are used
+  vtkPointData* pd = output->GetPointData();
+  vtkPointData* serialPD = serial->GetOutput()->GetPointData();
+  if (pd->GetNumberOfArrays() != serialPD->GetNumberOfArrays() ||
+    pd->GetNumberOfArrays() != (attributes ? 3 : 0))
+  {
+    cerr << label << ": " << pd->GetNumberOfArrays() << " point data arrays instead of "
+         << serialPD->GetNumberOfArrays() << endl;
+    return 1;
+  }
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = pd->GetArray(i);
+    int serialIndex;
+    vtkDataArray* serialArray = serialPD->GetArray(array->GetName(), serialIndex);
+    if (!serialArray || array->GetDataType() != serialArray->GetDataType() ||
+      array->GetNumberOfComponents() != serialArray->GetNumberOfComponents() ||
+      array->GetNumberOfTuples() != output->GetNumberOfPoints() ||
+      pd->IsArrayAnAttribute(i) != serialPD->IsArrayAnAttribute(serialIndex))
+    {
+      cerr << label << ": wrong point data array " << array->GetName() << endl;
+      return 1;
+    }
+  }
+
+  // The elevation is interpolated with the points, the normals stay normal
+  // to the sphere and the heights are those of the kept input points
+  vtkDataArray* elevation = pd->GetScalars();
+  vtkDataArray* normals = pd->GetNormals();
+  vtkDataArray* heights = pd->GetArray("Height");
+  if (attributes != (elevation != nullptr))
+  {
+    cerr << label << ": wrong output attributes" << endl;
+    return 1;
+  }
+  for (vtkIdType ptId = 0; elevation && ptId < output->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    output->GetPoint(ptId, x);
+    double n[3];
+    normals->GetTuple(ptId, n);
+    if (std::abs(elevation->GetTuple1(ptId) - (x[2] + 0.5)) > 0.01 ||
+      std::abs(vtkMath::Norm(n) - 1.0) > 1.0e-6 || vtkMath::Dot(n, x) / Radius < 0.99 ||
+      std::abs(heights->GetTuple1(ptId) - x[2]) > 0.05)
+    {
+      cerr << label << ": wrong point data at point " << ptId << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestQuadricDecimationParallel(int, char*[])
+{
+  // Enough triangles to be split in several partitions
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(200);
+  sphere->SetPhiResolution(200);
+  vtkNew<vtkElevationFilter> elevation;
+  elevation->SetInputConnection(sphere->GetOutputPort());
+  elevation->SetLowPoint(0.0, 0.0, -0.5);
+  elevation->SetHighPoint(0.0, 0.0, 0.5);
+  elevation->Update();
+  vtkPolyData* input = vtkPolyData::SafeDownCast(elevation->GetOutput());
+
+  // An array that is not an attribute
+  vtkNew<vtkFloatArray> heights;
+  heights->SetName("Height");
+  heights->SetNumberOfTuples(input->GetNumberOfPoints());
+  for (vtkIdType ptId = 0; ptId < input->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    input->GetPoint(ptId, x);
+    heights->SetValue(ptId, x[2]);
+  }
+  input->GetPointData()->AddArray(heights);
+
+  if (Check(input, false) || Check(input, true))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestTubeFilterLines.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tube many polylines, which are tubed in parallel, and check that the sides
+// of each polyline are placed after the ones of the previous polyline, at the
+// scalar radius of their point. Some polylines share a point with the
+// previous one, and one of them has a negative radius and is skipped.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTubeFilter.h"
+
+#include <cmath>
+
+int TestTubeFilterLines(int, char*[])
+{
+  const int numLines = 20;
+  const int numSides = 5;
+  const int badLine = 7;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkFloatArray> radii;
+  radii->SetName("Radius");
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkIdList> ids;
+  for (int lineId = 0; lineId < numLines; ++lineId)
+  {
+    ids->Reset();
+    if (lineId % 4 == 1)
+    {
+      ids->InsertNextId(points->GetNumberOfPoints() - 1);
+    }
+    for (int i = 0; i < 2 + lineId % 5; ++i)
+    {
+      ids->InsertNextId(points->InsertNextPoint(i, std::sin(i + lineId), lineId));
+      radii->InsertNextValue(lineId == badLine && i == 1 ? -1.0 : 0.1 + 0.01 * i);
+    }
+    lines->InsertNextCell(ids);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetLines(lines);
+  input->GetPointData()->SetScalars(radii);
+
+  vtkNew<vtkTest::ErrorObserver> observer;
+  vtkNew<vtkTubeFilter> tube;
+  tube->SetInputData(input);
+  tube->SetNumberOfSides(numSides);
+  tube->SetVaryRadiusToVaryRadiusByAbsoluteScalar();
+  tube->AddObserver(vtkCommand::WarningEvent, observer);
+  tube->Update();
+  vtkPolyData* output = tube->GetOutput();
+  if (observer->CheckWarningMessage("Scalar value less than zero, skipping line"))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The sides of a polyline are the strips joining the points of a side
+  vtkIdType ptId = 0;
+  vtkIdType stripId = 0;
+  vtkNew<vtkIdList> stripPts;
+  for (int lineId = 0; lineId < numLines; ++lineId)
+  {
+    if (lineId == badLine)
+    {
+      continue;
+    }
+    input->GetLines()->GetCellAtId(lineId, ids);
+    const vtkIdType firstPtId = ptId;
+    for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i)
+    {
+      double x[3];
+      input->GetPoint(ids->GetId(i), x);
+      const double radius = radii->GetValue(ids->GetId(i));
+      for (int side = 0; side < numSides; ++side, ++ptId)
+      {
+        double y[3];
+        output->GetPoint(ptId, y);
+        if (std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(x, y)) - radius) > 1.0e-5 ||
+          output->GetPointData()->GetScalars()->GetTuple1(ptId) != radius)
+        {
+          cerr << "Wrong tube point " << ptId << " for line " << lineId << endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    for (int side = 0; side < numSides; ++side, ++stripId)
+    {
+      output->GetCellPoints(stripId, stripPts);
+      if (stripPts->GetNumberOfIds() != 2 * ids->GetNumberOfIds() ||
+        stripPts->GetId(0) < firstPtId || stripPts->GetId(0) >= ptId)
+      {
+        cerr << "Wrong side " << side << " for line " << lineId << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (ptId != output->GetNumberOfPoints() || stripId != output->GetNumberOfCells())
+  {
+    cerr << "The tubes have extra points or strips" << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
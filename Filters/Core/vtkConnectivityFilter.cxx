@@ -16,6 +16,7 @@
 
 #include "vtkCell.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkDataSet.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkFloatArray.h"
@@ -24,13 +25,18 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 
 vtkObjectFactoryNewMacro(vtkConnectivityFilter);
 
@@ -41,6 +47,7 @@ vtkConnectivityFilter::vtkConnectivityFilter()
   this->ExtractionMode = VTK_EXTRACT_LARGEST_REGION;
   this->ColorRegions = 0;
   this->RegionIdAssignmentMode = UNSPECIFIED;
+  this->ParallelLabeling = 0;
 
   this->ScalarConnectivity = 0;
   this->ScalarRange[0] = 0.0;
@@ -241,28 +248,35 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
+      largestRegionId = this->LabelRegionsInParallel(input, false);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave->InsertNextId(cellId);
-        this->TraverseAndMark(input);
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave->Reset();
-        this->Wave2->Reset();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave->InsertNextId(cellId);
+          this->TraverseAndMark(input);
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave->Reset();
+          this->Wave2->Reset();
+        }
       }
     }
   }
@@ -319,7 +333,14 @@ int vtkConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark(input);
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(input, true);
+    }
+    else
+    {
+      this->TraverseAndMark(input);
+    }
     this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
     this->UpdateProgress(0.9);
   }
@@ -597,6 +618,82 @@ void vtkConnectivityFilter::TraverseAndMark(vtkDataSet* input)
   } // while wave is not empty
 }
 
+// Label the regions with a concurrent union-find instead of the wave
+// propagation, see vtkLabelRegions().
+vtkIdType vtkConnectivityFilter::LabelRegionsInParallel(vtkDataSet* input, bool seeded)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // The cells satisfying the scalar connectivity criterion
+  std::vector<unsigned char> connected;
+  if (this->InScalars)
+  {
+    connected.resize(numCells);
+    vtkDataArray* inScalars = this->InScalars;
+    const double* scalarRange = this->ScalarRange;
+    input->GetCellPoints(0, this->PointIds); // makes GetCellPoints() thread safe
+    vtkSMPThreadLocalObject<vtkIdList> threadPtIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* ptIds = threadPtIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        input->GetCellPoints(cellId, ptIds);
+        double range[2] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          // The scalars are compared as floats, like in TraverseAndMark()
+          const double s = static_cast<float>(inScalars->GetComponent(ptIds->GetId(i), 0));
+          range[0] = std::min(range[0], s);
+          range[1] = std::max(range[1], s);
+        }
+        connected[cellId] = (range[1] >= scalarRange[0] && range[0] <= scalarRange[1]);
+      }
+    });
+  }
+
+  std::vector<vtkIdType> seeds;
+  for (vtkIdType i = 0; seeded && i < this->Wave->GetNumberOfIds(); ++i)
+  {
+    seeds.push_back(this->Wave->GetId(i));
+  }
+  std::vector<vtkIdType> pointRegions(numPts);
+  std::vector<vtkIdType> regionSizes = vtkLabelRegions(input,
+    connected.empty() ? nullptr : connected.data(), seeded ? &seeds : nullptr, this->Visited,
+    pointRegions.data());
+  const vtkIdType numRegions = static_cast<vtkIdType>(regionSizes.size());
+
+  this->PointNumber = vtkMapRegionPoints(numPts, numRegions, pointRegions.data(), this->PointMap,
+    this->NewScalars->GetPointer(0));
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (this->Visited[cellId] >= 0)
+    {
+      this->NewCellScalars->SetValue(cellId, this->Visited[cellId]);
+    }
+  }
+
+  if (seeded)
+  {
+    this->NumCellsInRegion = regionSizes[0];
+    return 0;
+  }
+
+  // Same largest region as the serial labeling, the first one of the
+  // largest size.
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    this->RegionSizes->InsertValue(regionId, regionSizes[regionId]);
+    if (regionSizes[regionId] > regionSizes[largestRegionId])
+    {
+      largestRegionId = regionId;
+    }
+  }
+  this->RegionNumber = numRegions;
+  return largestRegionId;
+}
+
 void vtkConnectivityFilter::OrderRegionIds(
   vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds)
 {
@@ -751,6 +848,7 @@ void vtkConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 
   double* range = this->GetScalarRange();
   os << indent << "Scalar Range: (" << range[0] << ", " << range[1] << ")\n";
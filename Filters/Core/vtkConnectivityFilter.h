@@ -50,6 +50,13 @@
  * was processed and has no other significance with respect to the size of
  * or number of cells.
  *
+ * With ParallelLabeling on, the regions are found with a concurrent
+ * union-find over the cells and their points, threaded with vtkSMPTools,
+ * instead of the serial wave propagation. The cells of each region, the
+ * RegionIds (ordered by the lowest cell id of each region) and the region
+ * sizes are the same; only the order of the output points differs: they are
+ * grouped by region, and ordered by input point id within each region.
+ *
  * @sa
  * vtkPolyDataConnectivityFilter
  */
@@ -177,6 +184,16 @@ public:
    */
   int GetNumberOfExtractedRegions();
 
+  //@{
+  /**
+   * Turn on/off the labeling of the regions in parallel (see the class
+   * documentation). Off by default.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Turn on/off the coloring of connected regions.
@@ -243,8 +260,16 @@ protected:
 
   int RegionIdAssignmentMode;
 
+  vtkTypeBool ParallelLabeling;
+
   void TraverseAndMark(vtkDataSet* input);
 
+  /**
+   * Label the regions with ParallelLabeling on, from the seed cells in the
+   * wave when seeded. Return the id of the largest region.
+   */
+  vtkIdType LabelRegionsInParallel(vtkDataSet* input, bool seeded);
+
   void OrderRegionIds(vtkIdTypeArray* pointRegionIds, vtkIdTypeArray* cellRegionIds);
 
 private:
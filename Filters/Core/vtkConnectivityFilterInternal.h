@@ -0,0 +1,314 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkConnectivityFilterInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkConnectivityFilterInternal
+ * @brief   parallel labeling of the connected regions of a dataset
+ *
+ * vtkConnectivityFilterInternal labels the connected regions of the cells
+ * and points of a dataset with a concurrent union-find, and numbers the
+ * points of the regions. It is shared by vtkConnectivityFilter and
+ * vtkPolyDataConnectivityFilter.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkConnectivityFilter vtkPolyDataConnectivityFilter
+ */
+
+#ifndef vtkConnectivityFilterInternal_h
+#define vtkConnectivityFilterInternal_h
+
+#include "vtkDataSet.h"
+#include "vtkIdList.h"
+#include "vtkNew.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// A concurrent union-find (disjoint-set forest) over the cells and the
+// points of a dataset, the points being numbered after the cells. A root is
+// always linked under a smaller root, so that the root of a set is its
+// smallest element whatever the order of the unions. Find() does path
+// halving with compare-and-swap, so Find() and Union() may be called from
+// several threads.
+struct vtkConnectivityForest
+{
+  std::unique_ptr<std::atomic<vtkIdType>[]> Parents;
+
+  explicit vtkConnectivityForest(vtkIdType size)
+    : Parents(new std::atomic<vtkIdType>[size])
+  {
+    vtkSMPTools::For(0, size, [this](vtkIdType id, vtkIdType endId) {
+      for (; id < endId; ++id)
+      {
+        this->Parents[id].store(id, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  vtkIdType Find(vtkIdType id)
+  {
+    vtkIdType parent = this->Parents[id].load();
+    while (parent != id)
+    {
+      vtkIdType grandParent = this->Parents[parent].load();
+      if (grandParent != parent)
+      {
+        this->Parents[id].compare_exchange_weak(parent, grandParent);
+      }
+      id = grandParent;
+      parent = this->Parents[id].load();
+    }
+    return id;
+  }
+
+  void Union(vtkIdType id0, vtkIdType id1)
+  {
+    for (;;)
+    {
+      id0 = this->Find(id0);
+      id1 = this->Find(id1);
+      if (id0 == id1)
+      {
+        return;
+      }
+      if (id0 < id1)
+      {
+        std::swap(id0, id1);
+      }
+      vtkIdType root = id0;
+      if (this->Parents[id0].compare_exchange_strong(root, id1))
+      {
+        return;
+      }
+    }
+  }
+};
+
+void vtkAtomicMin(std::atomic<vtkIdType>& value, vtkIdType newValue)
+{
+  vtkIdType current = value.load();
+  while (newValue < current && !value.compare_exchange_weak(current, newValue))
+  {
+  }
+}
+
+// Label the regions of the cells of a dataset in parallel. Two cells sharing
+// a point are in the same region when both are connected (connected[cellId]
+// is not zero, or connected is null). A cell that is not connected starts a
+// region of its own, which also gets the sets of connected cells using its
+// points that are not reached from a smaller cell: this matches the wave
+// propagation from the cells taken in increasing id order. With seeds, the
+// seed cells and the sets they reach make the single region 0. Fill the
+// region of each cell and point (-1 if none), and return the region sizes.
+std::vector<vtkIdType> vtkLabelRegions(vtkDataSet* input, const unsigned char* connected,
+  const std::vector<vtkIdType>* seeds, vtkIdType* cellRegions, vtkIdType* pointRegions)
+{
+  const vtkIdType numCells = input->GetNumberOfCells();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+
+  // Calling GetCellPoints() once makes it thread safe
+  vtkNew<vtkIdList> cellPtIds;
+  input->GetCellPoints(0, cellPtIds);
+  vtkSMPThreadLocalObject<vtkIdList> threadPtIds;
+
+  // Union the connected cells with their points
+  vtkConnectivityForest forest(numCells + numPts);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIds = threadPtIds.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (!connected || connected[cellId])
+      {
+        input->GetCellPoints(cellId, ptIds);
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          forest.Union(cellId, numCells + ptIds->GetId(i));
+        }
+      }
+    }
+  });
+
+  // The root of a cell is the smallest cell of its set
+  std::vector<vtkIdType> roots(numCells);
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      roots[cellId] = forest.Find(cellId);
+    }
+  });
+
+  std::vector<vtkIdType> regionSizes;
+  if (seeds)
+  {
+    std::vector<unsigned char> reached(numCells, 0);
+    for (vtkIdType seed : *seeds)
+    {
+      input->GetCellPoints(seed, cellPtIds);
+      for (vtkIdType i = 0; i < cellPtIds->GetNumberOfIds(); ++i)
+      {
+        const vtkIdType root = forest.Find(numCells + cellPtIds->GetId(i));
+        if (root < numCells)
+        {
+          reached[root] = 1;
+        }
+      }
+    }
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const bool isReached = (!connected || connected[cellId]) && reached[roots[cellId]];
+        cellRegions[cellId] = (isReached ? 0 : -1);
+      }
+    });
+    regionSizes.push_back(0);
+    for (vtkIdType seed : *seeds)
+    {
+      cellRegions[seed] = 0;
+    }
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      regionSizes[0] += (cellRegions[cellId] == 0 ? 1 : 0);
+    }
+  }
+  else
+  {
+    // The cell starting the region of each set: its root, or a smaller cell
+    // that is not connected and uses one of its points.
+    std::unique_ptr<std::atomic<vtkIdType>[]> owners;
+    if (connected)
+    {
+      owners.reset(new std::atomic<vtkIdType>[numCells]);
+      vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+        for (; cellId < endCellId; ++cellId)
+        {
+          owners[cellId].store(cellId, std::memory_order_relaxed);
+        }
+      });
+      vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+        vtkIdList* ptIds = threadPtIds.Local();
+        for (; cellId < endCellId; ++cellId)
+        {
+          if (!connected[cellId])
+          {
+            input->GetCellPoints(cellId, ptIds);
+            for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+            {
+              const vtkIdType root = forest.Find(numCells + ptIds->GetId(i));
+              if (root < numCells)
+              {
+                vtkAtomicMin(owners[root], cellId);
+              }
+            }
+          }
+        }
+      });
+    }
+
+    // Number the regions in increasing order of their starting cell
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType root = roots[cellId];
+      const vtkIdType owner = (owners ? owners[root].load(std::memory_order_relaxed) : root);
+      if (owner == cellId)
+      {
+        cellRegions[cellId] = static_cast<vtkIdType>(regionSizes.size());
+        regionSizes.push_back(1);
+      }
+      else
+      {
+        cellRegions[cellId] = cellRegions[owner];
+        ++regionSizes[cellRegions[owner]];
+      }
+    }
+  }
+
+  // The region of a point is the first region using it
+  std::unique_ptr<std::atomic<vtkIdType>[]> firstRegions(new std::atomic<vtkIdType>[numPts]);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      firstRegions[ptId].store(VTK_ID_MAX, std::memory_order_relaxed);
+    }
+  });
+  vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* ptIds = threadPtIds.Local();
+    for (; cellId < endCellId; ++cellId)
+    {
+      if (cellRegions[cellId] >= 0)
+      {
+        input->GetCellPoints(cellId, ptIds);
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          vtkAtomicMin(firstRegions[ptIds->GetId(i)], cellRegions[cellId]);
+        }
+      }
+    }
+  });
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkIdType region = firstRegions[ptId].load(std::memory_order_relaxed);
+      pointRegions[ptId] = (region == VTK_ID_MAX ? -1 : region);
+    }
+  });
+
+  return regionSizes;
+}
+
+// Number the points of the regions, grouped by region, and fill the region
+// of the new points. Return the number of points.
+vtkIdType vtkMapRegionPoints(vtkIdType numPts, vtkIdType numRegions,
+  const vtkIdType* pointRegions, vtkIdType* pointMap, vtkIdType* newPointRegions)
+{
+  std::vector<vtkIdType> offsets(numRegions + 1, 0);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointRegions[ptId] >= 0)
+    {
+      ++offsets[pointRegions[ptId] + 1];
+    }
+  }
+  for (vtkIdType region = 0; region < numRegions; ++region)
+  {
+    offsets[region + 1] += offsets[region];
+  }
+  const vtkIdType numNewPts = offsets[numRegions];
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    const vtkIdType region = pointRegions[ptId];
+    if (region >= 0)
+    {
+      pointMap[ptId] = offsets[region]++;
+      newPointRegions[pointMap[ptId]] = region;
+    }
+  }
+  return numNewPts;
+}
+} // anonymous namespace
+
+#endif // vtkConnectivityFilterInternal_h
+// VTK-HeaderTest-Exclude: vtkConnectivityFilterInternal.h
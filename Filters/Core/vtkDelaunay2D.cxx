@@ -25,13 +25,64 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpaceFillingCurveKeys.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
 #include <set>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+namespace
+{
+// Minimum number of points in a strip of the parallel triangulation
+const vtkIdType VTK_DEL2D_MIN_STRIP_SIZE = 10000;
+
+// Sort point ids along a Morton curve over the x-y bounds of the points, so
+// that consecutive points are close to each other and the walk to the
+// triangle containing the next point is short. Both axes are scaled alike,
+// so that thin strips are not traversed along long runs of aligned points.
+void SortAlongMortonCurve(const double* points, std::vector<vtkIdType>& ids)
+{
+  double bounds[4] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (vtkIdType id : ids)
+  {
+    const double* x = points + 3 * id;
+    bounds[0] = std::min(bounds[0], x[0]);
+    bounds[1] = std::max(bounds[1], x[0]);
+    bounds[2] = std::min(bounds[2], x[1]);
+    bounds[3] = std::max(bounds[3], x[1]);
+  }
+  const double extent = std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]);
+  const double scale = extent > 0.0 ? 4294967295.0 / extent : 0.0;
+
+  std::vector<std::pair<vtkTypeUInt64, vtkIdType> > keys(ids.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    const double* x = points + 3 * ids[i];
+    const vtkTypeUInt64 qx = static_cast<vtkTypeUInt64>((x[0] - bounds[0]) * scale);
+    const vtkTypeUInt64 qy = static_cast<vtkTypeUInt64>((x[1] - bounds[2]) * scale);
+    keys[i] = std::make_pair(vtkSpaceFillingCurveKeys::MortonKey(qx, qy), ids[i]);
+  }
+  std::sort(keys.begin(), keys.end());
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    ids[i] = keys[i].second;
+  }
+}
+
+// Twice the signed area of the triangle (x1,x2,x3) in the x-y plane
+double Orientation(const double x1[3], const double x2[3], const double x3[3])
+{
+  return (x2[0] - x1[0]) * (x3[1] - x1[1]) - (x2[1] - x1[1]) * (x3[0] - x1[0]);
+}
+}
+
 vtkStandardNewMacro(vtkDelaunay2D);
 vtkCxxSetObjectMacro(vtkDelaunay2D, Transform, vtkAbstractTransform);
 
@@ -45,6 +96,11 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->Offset = 1.0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
+  this->ParallelTriangulation = 0;
+
+  this->Mesh = nullptr;
+  this->Points = nullptr;
+  this->Concurrent = false;
 
   // optional 2nd input
   this->SetNumberOfInputPorts(2);
@@ -128,9 +184,17 @@ vtkIdType vtkDelaunay2D::FindTriangle(double x[3], vtkIdType ptIds[3], vtkIdType
   }
 
   // Randomization (of find edge neighbora) avoids walking in
-  // circles in certain weird cases
-  srand(tri);
-  ir = rand() % 3;
+  // circles in certain weird cases. The concurrent instances hash the
+  // triangle id instead, as rand() shares a global state.
+  if (this->Concurrent)
+  {
+    ir = static_cast<int>(((static_cast<vtkTypeUInt64>(tri) * 2654435761u) >> 16) % 3);
+  }
+  else
+  {
+    srand(tri);
+    ir = rand() % 3;
+  }
   // evaluate in/out of each edge
   for (inside = 1, minProj = VTK_DEL2D_TOLERANCE, ic = 0; ic < 3; ic++)
   {
@@ -275,144 +339,13 @@ void vtkDelaunay2D::CheckEdge(
   neighbors->Delete();
 }
 
-// 2D Delaunay triangulation. Steps are as follows:
-//   1. For each point
-//   2. Find triangle point is in
-//   3. Create 3 triangles from each edge of triangle that point is in
-//   4. Recursively evaluate Delaunay criterion for each edge neighbor
-//   5. If criterion not satisfied; swap diagonal
-//
-int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
-  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+// Append the eight points of the initial, bounding triangulation to the
+// points, and create the mesh made of its six triangles.
+void vtkDelaunay2D::InitializeMesh(
+  vtkPoints* points, vtkIdType numPoints, double center[3], double radius)
 {
-  // get the info objects
-  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
-  vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
-  vtkInformation* outInfo = outputVector->GetInformationObject(0);
-
-  // get the input and output
-  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
-  vtkPolyData* source = nullptr;
-  if (sourceInfo)
-  {
-    source = vtkPolyData::SafeDownCast(sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
-  }
-  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
-
-  vtkIdType numPoints, i;
-  vtkIdType numTriangles = 0;
-  vtkIdType ptId, tri[4], nei[3];
-  vtkIdType p1 = 0;
-  vtkIdType p2 = 0;
-  vtkIdType p3 = 0;
-  vtkPoints* inPoints;
-  vtkPoints* points;
-  vtkPoints* tPoints = nullptr;
-  vtkCellArray* triangles;
-  int ncells;
-  vtkIdType nodes[4][3];
-  const vtkIdType* neiPts;
-  const vtkIdType* triPts = nullptr;
-  vtkIdType numNeiPts;
-  vtkIdType npts = 0;
-  vtkIdType pts[3], swapPts[3];
-  vtkIdList *neighbors, *cells;
-  vtkIdType tri1, tri2;
-  double center[3], radius, tol, x[3];
-  double n1[3], n2[3];
-  int* triUse = nullptr;
-
-  vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
-
-  if (this->Transform && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
-                       "specified.  Output will not contain bounding triangulation.");
-  }
-
-  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
-  {
-    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
-                       "is on.  Output will not contain bounding triangulation.");
-  }
-
-  // Initialize; check input
-  //
-  if ((inPoints = input->GetPoints()) == nullptr)
-  {
-    vtkDebugMacro("Cannot triangulate; no input points");
-    return 1;
-  }
-
-  if ((numPoints = inPoints->GetNumberOfPoints()) <= 2)
-  {
-    vtkDebugMacro("Cannot triangulate; need at least 3 input points");
-    return 1;
-  }
-
-  neighbors = vtkIdList::New();
-  neighbors->Allocate(2);
-  cells = vtkIdList::New();
-  cells->Allocate(64);
-
-  this->NumberOfDuplicatePoints = 0;
-  this->NumberOfDegeneracies = 0;
-
-  this->Mesh = vtkPolyData::New();
-
-  // If the user specified a transform, apply it to the input data.
-  //
-  // Only the input points are transformed.  We do not bother
-  // transforming the source points (if specified).  The reason is
-  // that only the topology of the Source is used during the constrain
-  // operation.  The point ids in the Source topology are assumed to
-  // reference points in the input. So, when an input transform is
-  // used, only the input points are transformed.  We do not bother
-  // with transforming the Source points since they are never
-  // referenced.
-  if (this->Transform)
-  {
-    tPoints = vtkPoints::New();
-    this->Transform->TransformPoints(inPoints, tPoints);
-  }
-  else
-  {
-    // If the user asked this filter to compute the best fitting plane,
-    // proceed to compute the plane and generate a transform that will
-    // map the input points into that plane.
-    if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE)
-    {
-      this->SetTransform(this->ComputeBestFittingPlane(input));
-      tPoints = vtkPoints::New();
-      this->Transform->TransformPoints(inPoints, tPoints);
-    }
-  }
-
-  // Create initial bounding triangulation. Have to create bounding points.
-  // Initialize mesh structure.
-  //
-  points = vtkPoints::New();
-  // This will copy doubles to doubles if the input is double.
-  points->SetDataTypeToDouble();
-  points->SetNumberOfPoints(numPoints);
-  if (!this->Transform)
-  {
-    points->DeepCopy(inPoints);
-  }
-  else
-  {
-    points->DeepCopy(tPoints);
-    tPoints->Delete();
-    tPoints = nullptr;
-  }
-
-  const double* bounds = points->GetBounds();
-  center[0] = (bounds[0] + bounds[1]) / 2.0;
-  center[1] = (bounds[2] + bounds[3]) / 2.0;
-  center[2] = (bounds[4] + bounds[5]) / 2.0;
-  tol = input->GetLength();
-  radius = this->Offset * tol;
-  tol *= this->Tolerance;
+  vtkIdType ptId, pts[3];
+  double x[3];
 
   for (ptId = 0; ptId < 8; ptId++)
   {
@@ -424,7 +357,7 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // We do this for speed accessing points
   this->Points = static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
 
-  triangles = vtkCellArray::New();
+  vtkCellArray* triangles = vtkCellArray::New();
   triangles->AllocateEstimate(2 * numPoints, 3);
 
   // create bounding triangles (there are six)
@@ -452,11 +385,26 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   pts[1] = numPoints + 4;
   pts[2] = numPoints + 6;
   triangles->InsertNextCell(3, pts);
-  tri[0] = 0;
 
+  this->Mesh = vtkPolyData::New();
   this->Mesh->SetPoints(points);
   this->Mesh->SetPolys(triangles);
   this->Mesh->BuildLinks(); // build cell structure
+  triangles->Delete();
+}
+
+// Insert the points [0, numPoints) into the mesh, one at a time.
+void vtkDelaunay2D::InsertPoints(vtkIdType numPoints, double tol)
+{
+  vtkIdType ptId, i, tri[4], nei[3], pts[3], nodes[4][3];
+  vtkIdType p1 = 0;
+  vtkIdType p2 = 0;
+  const vtkIdType* neiPts;
+  vtkIdType numNeiPts;
+  double x[3];
+  vtkIdList* neighbors = vtkIdList::New();
+  neighbors->Allocate(2);
+  tri[0] = 0;
 
   // For each point; find triangle containing point. Then evaluate three
   // neighboring triangles for Delaunay criterion. Triangles that do not
@@ -559,7 +507,7 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
       tri[0] = 0; // no triangle found
     }
 
-    if (!(ptId % 1000))
+    if (!this->Concurrent && !(ptId % 1000))
     {
       vtkDebugMacro(<< "point #" << ptId);
       this->UpdateProgress(static_cast<double>(ptId) / numPoints);
@@ -571,6 +519,496 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
 
   } // for all points
 
+  neighbors->Delete();
+}
+
+// Parallel triangulation. Steps are as follows:
+//   1. Split the points into strips along x, points with the same x
+//      coordinate being in the same strip
+//   2. Triangulate the strips concurrently, each on its own instance
+//   3. Keep the triangles whose circumcircle lies strictly within their
+//      strip: no point of the other strips can be in their circumcircle, so
+//      they are Delaunay triangles of the whole point set
+//   4. Triangulate the points left on the border of, or outside of, the
+//      kept triangles, enforcing the border edges as constraints, and keep
+//      the triangles on the outer side of the border
+// Returns the triangles, which use the ids of this->Points.
+vtkCellArray* vtkDelaunay2D::TriangulateInParallel(vtkIdType numPoints, double tol)
+{
+  const double* points = this->Points;
+
+  std::vector<std::pair<double, vtkIdType> > sorted(numPoints);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      sorted[ptId] = std::make_pair(points[3 * ptId], ptId);
+    }
+  });
+  vtkSMPTools::Sort(sorted.begin(), sorted.end());
+
+  const vtkIdType maxNumberOfStrips = std::max(numPoints / VTK_DEL2D_MIN_STRIP_SIZE, vtkIdType(1));
+  const vtkIdType numberOfStrips = std::min(
+    static_cast<vtkIdType>(2 * vtkSMPTools::GetEstimatedNumberOfThreads()), maxNumberOfStrips);
+  std::vector<vtkIdType> starts(1, 0);
+  for (vtkIdType strip = 1; strip < numberOfStrips; ++strip)
+  {
+    vtkIdType start = strip * numPoints / numberOfStrips;
+    while (start < numPoints && sorted[start].first == sorted[start - 1].first)
+    {
+      ++start;
+    }
+    if (start < numPoints && start > starts.back())
+    {
+      starts.push_back(start);
+    }
+  }
+  starts.push_back(numPoints);
+  const vtkIdType numStrips = static_cast<vtkIdType>(starts.size()) - 1;
+
+  // Triangulate a subset of the points on a private instance. The ids are
+  // reordered along a Morton curve; the i-th point of the instance is the
+  // point ids[i].
+  auto triangulate = [this, points](vtkDelaunay2D* helper, std::vector<vtkIdType>& ids,
+                       double tolerance) {
+    SortAlongMortonCurve(points, ids);
+    const vtkIdType numIds = static_cast<vtkIdType>(ids.size());
+    vtkPoints* subset = vtkPoints::New();
+    subset->SetDataTypeToDouble();
+    subset->SetNumberOfPoints(numIds);
+    for (vtkIdType i = 0; i < numIds; ++i)
+    {
+      subset->SetPoint(i, points + 3 * ids[i]);
+    }
+    const double* bounds = subset->GetBounds();
+    double center[3] = { (bounds[0] + bounds[1]) / 2.0, (bounds[2] + bounds[3]) / 2.0,
+      (bounds[4] + bounds[5]) / 2.0 };
+    const double length = sqrt((bounds[1] - bounds[0]) * (bounds[1] - bounds[0]) +
+      (bounds[3] - bounds[2]) * (bounds[3] - bounds[2]) +
+      (bounds[5] - bounds[4]) * (bounds[5] - bounds[4]));
+
+    helper->Concurrent = true;
+    helper->Tolerance = this->Tolerance;
+    helper->NumberOfDuplicatePoints = 0;
+    helper->NumberOfDegeneracies = 0;
+    helper->InitializeMesh(subset, numIds, center, this->Offset * length);
+    helper->InsertPoints(numIds, tolerance);
+    subset->Delete();
+  };
+
+  // The triangles kept from each strip, the border edges of the kept
+  // triangles (oriented so that the kept triangles are on their left), and
+  // the points to triangulate again.
+  std::vector<std::vector<vtkIdType> > kept(numStrips);
+  std::vector<std::vector<vtkIdType> > border(numStrips);
+  std::vector<char> inSeam(numPoints, 0);
+  std::vector<vtkSmartPointer<vtkDelaunay2D> > helpers(numStrips);
+  for (vtkIdType strip = 0; strip < numStrips; ++strip)
+  {
+    helpers[strip] = vtkSmartPointer<vtkDelaunay2D>::New();
+  }
+
+  vtkSMPTools::For(0, numStrips, 1, [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* neighbors = vtkIdList::New();
+    for (vtkIdType strip = begin; strip < end; ++strip)
+    {
+      std::vector<vtkIdType> ids(starts[strip + 1] - starts[strip]);
+      for (size_t i = 0; i < ids.size(); ++i)
+      {
+        ids[i] = sorted[starts[strip] + i].second;
+      }
+      vtkDelaunay2D* helper = helpers[strip];
+      triangulate(helper, ids, tol);
+
+      const double xMin = strip > 0 ? sorted[starts[strip]].first : VTK_DOUBLE_MIN;
+      const double xMax = strip < numStrips - 1 ? sorted[starts[strip + 1]].first : VTK_DOUBLE_MAX;
+      const vtkIdType numIds = static_cast<vtkIdType>(ids.size());
+      vtkPolyData* mesh = helper->Mesh;
+      const vtkIdType numCells = mesh->GetNumberOfCells();
+      std::vector<char> isKept(numCells, 0);
+      const vtkIdType* pts;
+      vtkIdType npts;
+      double x[3][3], center[2];
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        mesh->GetCellPoints(cellId, npts, pts);
+        if (pts[0] < numIds && pts[1] < numIds && pts[2] < numIds)
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            helper->GetPoint(pts[i], x[i]);
+          }
+          const double radius = sqrt(vtkTriangle::Circumcircle(x[0], x[1], x[2], center));
+          isKept[cellId] = (center[0] - radius > xMin && center[0] + radius < xMax);
+        }
+      }
+
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        mesh->GetCellPoints(cellId, npts, pts);
+        if (!isKept[cellId])
+        {
+          for (int i = 0; i < 3; ++i)
+          {
+            if (pts[i] < numIds)
+            {
+              inSeam[ids[pts[i]]] = 1;
+            }
+          }
+          continue;
+        }
+
+        for (int i = 0; i < 3; ++i)
+        {
+          helper->GetPoint(pts[i], x[i]);
+          kept[strip].push_back(ids[pts[i]]);
+        }
+        const bool counterClockwise = Orientation(x[0], x[1], x[2]) > 0.0;
+        for (int i = 0; i < 3; ++i)
+        {
+          const vtkIdType p1 = pts[i];
+          const vtkIdType p2 = pts[(i + 1) % 3];
+          mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
+          if (neighbors->GetNumberOfIds() == 0 || !isKept[neighbors->GetId(0)])
+          {
+            border[strip].push_back(ids[counterClockwise ? p1 : p2]);
+            border[strip].push_back(ids[counterClockwise ? p2 : p1]);
+            inSeam[ids[p1]] = 1;
+            inSeam[ids[p2]] = 1;
+          }
+        }
+      }
+      helper->Mesh->Delete();
+      helper->Mesh = nullptr;
+    }
+    neighbors->Delete();
+  });
+
+  vtkIdType numTriangles = 0;
+  for (vtkIdType strip = 0; strip < numStrips; ++strip)
+  {
+    this->NumberOfDuplicatePoints += helpers[strip]->NumberOfDuplicatePoints;
+    this->NumberOfDegeneracies += helpers[strip]->NumberOfDegeneracies;
+    numTriangles += static_cast<vtkIdType>(kept[strip].size()) / 3;
+  }
+
+  vtkCellArray* triangles = vtkCellArray::New();
+  triangles->AllocateEstimate(std::max(numTriangles, 2 * numPoints), 3);
+  for (vtkIdType strip = 0; strip < numStrips; ++strip)
+  {
+    for (size_t i = 0; i < kept[strip].size(); i += 3)
+    {
+      triangles->InsertNextCell(3, &kept[strip][i]);
+    }
+    std::vector<vtkIdType>().swap(kept[strip]);
+  }
+
+  // Triangulate the seam points. Duplicate points have been discarded
+  // within the strips, so they are all inserted.
+  std::vector<vtkIdType> seamIds;
+  for (vtkIdType ptId = 0; ptId < numPoints; ++ptId)
+  {
+    if (inSeam[ptId])
+    {
+      seamIds.push_back(ptId);
+    }
+  }
+  if (seamIds.empty())
+  {
+    return triangles;
+  }
+  vtkSmartPointer<vtkDelaunay2D> helper = vtkSmartPointer<vtkDelaunay2D>::New();
+  triangulate(helper, seamIds, 0.0);
+  const vtkIdType numSeamIds = static_cast<vtkIdType>(seamIds.size());
+  std::unordered_map<vtkIdType, vtkIdType> seamId;
+  for (vtkIdType i = 0; i < numSeamIds; ++i)
+  {
+    seamId[seamIds[i]] = i;
+  }
+
+  // Enforce the border edges
+  vtkPolyData* mesh = helper->Mesh;
+  vtkPolyData* source = vtkPolyData::New();
+  vtkCellArray* lines = vtkCellArray::New();
+  for (vtkIdType strip = 0; strip < numStrips; ++strip)
+  {
+    for (size_t i = 0; i < border[strip].size(); i += 2)
+    {
+      const vtkIdType edge[2] = { seamId[border[strip][i]], seamId[border[strip][i + 1]] };
+      lines->InsertNextCell(2, edge);
+    }
+  }
+  source->SetPoints(mesh->GetPoints());
+  source->SetLines(lines);
+  lines->Delete();
+  delete[] helper->RecoverBoundary(source);
+
+  // Keep the triangles on the right of the border edges, and those on the
+  // convex hull, then flood fill without crossing the border.
+  const vtkIdType numCells = mesh->GetNumberOfCells();
+  std::vector<signed char> inHole(numCells, -1);
+  std::vector<vtkIdType> front;
+  vtkIdList* neighbors = vtkIdList::New();
+  const vtkIdType* pts;
+  vtkIdType npts;
+  double x1[3], x2[3], x3[3];
+  auto isBounding = [mesh, numSeamIds](vtkIdType cellId) {
+    const vtkIdType* cellPts;
+    vtkIdType numCellPts;
+    mesh->GetCellPoints(cellId, numCellPts, cellPts);
+    return cellPts[0] >= numSeamIds || cellPts[1] >= numSeamIds || cellPts[2] >= numSeamIds;
+  };
+  for (lines->InitTraversal(); lines->GetNextCell(npts, pts);)
+  {
+    helper->GetPoint(pts[0], x1);
+    helper->GetPoint(pts[1], x2);
+    mesh->GetCellEdgeNeighbors(-1, pts[0], pts[1], neighbors);
+    for (vtkIdType i = 0; i < neighbors->GetNumberOfIds(); ++i)
+    {
+      const vtkIdType cellId = neighbors->GetId(i);
+      const vtkIdType* triPts;
+      mesh->GetCellPoints(cellId, npts, triPts);
+      if (isBounding(cellId))
+      {
+        continue;
+      }
+      int k = 0;
+      while (triPts[k] == pts[0] || triPts[k] == pts[1])
+      {
+        ++k;
+      }
+      helper->GetPoint(triPts[k], x3);
+      if (Orientation(x1, x2, x3) < 0.0)
+      {
+        if (inHole[cellId] < 0)
+        {
+          inHole[cellId] = 1;
+          front.push_back(cellId);
+        }
+      }
+      else
+      {
+        inHole[cellId] = 0;
+      }
+    }
+  }
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    if (inHole[cellId] >= 0 || isBounding(cellId))
+    {
+      continue;
+    }
+    mesh->GetCellPoints(cellId, npts, pts);
+    for (int i = 0; i < 3; ++i)
+    {
+      const vtkIdType p1 = pts[i];
+      const vtkIdType p2 = pts[(i + 1) % 3];
+      if (source->IsEdge(p1, p2))
+      {
+        continue;
+      }
+      mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
+      if (neighbors->GetNumberOfIds() == 0 || isBounding(neighbors->GetId(0)))
+      {
+        inHole[cellId] = 1;
+        front.push_back(cellId);
+        break;
+      }
+    }
+  }
+  while (!front.empty())
+  {
+    const vtkIdType cellId = front.back();
+    front.pop_back();
+    if (inHole[cellId] != 1)
+    {
+      continue;
+    }
+    mesh->GetCellPoints(cellId, npts, pts);
+    const vtkIdType triPts[3] = { pts[0], pts[1], pts[2] };
+    vtkIdType tri[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      tri[i] = seamIds[triPts[i]];
+      const vtkIdType p1 = triPts[i];
+      const vtkIdType p2 = triPts[(i + 1) % 3];
+      if (source->IsEdge(p1, p2))
+      {
+        continue;
+      }
+      mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
+      for (vtkIdType j = 0; j < neighbors->GetNumberOfIds(); ++j)
+      {
+        const vtkIdType nei = neighbors->GetId(j);
+        if (inHole[nei] < 0 && !isBounding(nei))
+        {
+          inHole[nei] = 1;
+          front.push_back(nei);
+        }
+      }
+    }
+    triangles->InsertNextCell(3, tri);
+  }
+
+  neighbors->Delete();
+  source->Delete();
+  helper->Mesh->Delete();
+  helper->Mesh = nullptr;
+
+  return triangles;
+}
+
+// 2D Delaunay triangulation. Steps are as follows:
+//   1. For each point
+//   2. Find triangle point is in
+//   3. Create 3 triangles from each edge of triangle that point is in
+//   4. Recursively evaluate Delaunay criterion for each edge neighbor
+//   5. If criterion not satisfied; swap diagonal
+//
+int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  // get the info objects
+  vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+  vtkInformation* sourceInfo = inputVector[1]->GetInformationObject(0);
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+
+  // get the input and output
+  vtkPointSet* input = vtkPointSet::SafeDownCast(inInfo->Get(vtkDataObject::DATA_OBJECT()));
+  vtkPolyData* source = nullptr;
+  if (sourceInfo)
+  {
+    source = vtkPolyData::SafeDownCast(sourceInfo->Get(vtkDataObject::DATA_OBJECT()));
+  }
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  vtkIdType numPoints, i;
+  vtkIdType numTriangles = 0;
+  vtkIdType ptId;
+  vtkIdType p1 = 0;
+  vtkIdType p2 = 0;
+  vtkIdType p3 = 0;
+  vtkPoints* inPoints;
+  vtkPoints* points;
+  vtkPoints* tPoints = nullptr;
+  vtkCellArray* triangles;
+  int ncells;
+  const vtkIdType* neiPts;
+  const vtkIdType* triPts = nullptr;
+  vtkIdType npts = 0;
+  vtkIdType pts[3], swapPts[3];
+  vtkIdList *neighbors, *cells;
+  vtkIdType tri1, tri2;
+  double center[3], radius, tol;
+  double n1[3], n2[3];
+  int* triUse = nullptr;
+
+  vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
+
+  if (this->Transform && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when an input transform is "
+                       "specified.  Output will not contain bounding triangulation.");
+  }
+
+  if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE && this->BoundingTriangulation)
+  {
+    vtkWarningMacro(<< "Bounding triangulation cannot be used when the best fitting plane option "
+                       "is on.  Output will not contain bounding triangulation.");
+  }
+
+  // Initialize; check input
+  //
+  if ((inPoints = input->GetPoints()) == nullptr)
+  {
+    vtkDebugMacro("Cannot triangulate; no input points");
+    return 1;
+  }
+
+  if ((numPoints = inPoints->GetNumberOfPoints()) <= 2)
+  {
+    vtkDebugMacro("Cannot triangulate; need at least 3 input points");
+    return 1;
+  }
+
+  neighbors = vtkIdList::New();
+  neighbors->Allocate(2);
+  cells = vtkIdList::New();
+  cells->Allocate(64);
+
+  this->NumberOfDuplicatePoints = 0;
+  this->NumberOfDegeneracies = 0;
+
+  // If the user specified a transform, apply it to the input data.
+  //
+  // Only the input points are transformed.  We do not bother
+  // transforming the source points (if specified).  The reason is
+  // that only the topology of the Source is used during the constrain
+  // operation.  The point ids in the Source topology are assumed to
+  // reference points in the input. So, when an input transform is
+  // used, only the input points are transformed.  We do not bother
+  // with transforming the Source points since they are never
+  // referenced.
+  if (this->Transform)
+  {
+    tPoints = vtkPoints::New();
+    this->Transform->TransformPoints(inPoints, tPoints);
+  }
+  else
+  {
+    // If the user asked this filter to compute the best fitting plane,
+    // proceed to compute the plane and generate a transform that will
+    // map the input points into that plane.
+    if (this->ProjectionPlaneMode == VTK_BEST_FITTING_PLANE)
+    {
+      this->SetTransform(this->ComputeBestFittingPlane(input));
+      tPoints = vtkPoints::New();
+      this->Transform->TransformPoints(inPoints, tPoints);
+    }
+  }
+
+  // Create initial bounding triangulation. Have to create bounding points.
+  // Initialize mesh structure.
+  //
+  points = vtkPoints::New();
+  // This will copy doubles to doubles if the input is double.
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPoints);
+  if (!this->Transform)
+  {
+    points->DeepCopy(inPoints);
+  }
+  else
+  {
+    points->DeepCopy(tPoints);
+    tPoints->Delete();
+    tPoints = nullptr;
+  }
+
+  const double* bounds = points->GetBounds();
+  center[0] = (bounds[0] + bounds[1]) / 2.0;
+  center[1] = (bounds[2] + bounds[3]) / 2.0;
+  center[2] = (bounds[4] + bounds[5]) / 2.0;
+  tol = input->GetLength();
+  radius = this->Offset * tol;
+  tol *= this->Tolerance;
+
+  this->InitializeMesh(points, numPoints, center, radius);
+
+  // Triangulate the points, either all at once or strip by strip. The
+  // parallel triangulation replaces the bounding triangulation.
+  if (this->ParallelTriangulation && !this->BoundingTriangulation)
+  {
+    triangles = this->TriangulateInParallel(numPoints, tol);
+    this->Mesh->SetPolys(triangles);
+    triangles->Delete();
+    this->Mesh->BuildLinks();
+  }
+  else
+  {
+    this->InsertPoints(numPoints, tol);
+  }
+  triangles = this->Mesh->GetPolys();
+
   vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
                 << " of which were duplicates");
 
@@ -962,7 +1400,6 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   points->Delete();
-  triangles->Delete();
   this->Mesh->Delete();
   neighbors->Delete();
   cells->Delete();
@@ -1644,4 +2081,5 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Parallel Triangulation: " << (this->ParallelTriangulation ? "On\n" : "Off\n");
 }
@@ -96,13 +96,25 @@
  * or non-rigid), care must be taken in constructing constraints when
  * an input transform is used.
  *
+ * Large point sets can be triangulated in parallel by turning on
+ * ParallelTriangulation. The points are then split into strips along the x
+ * axis, and the strips are triangulated concurrently, each inserting its
+ * points in a spatially coherent (Morton) order. The triangles whose
+ * circumcircle lies within their strip are Delaunay for the whole point
+ * set and are kept; the region they leave uncovered along the strip
+ * boundaries is triangulated afterwards, the edges bounding the kept
+ * triangles being enforced as constraints. The Tolerance is applied within
+ * each strip, and the Alpha and constraint (Source) processing is
+ * performed on the merged triangulation, as in the serial case.
+ *
  * @warning
  * Points arranged on a regular lattice (termed degenerate cases) can be
  * triangulated in more than one way (at least according to the Delaunay
  * criterion). The choice of triangulation (as implemented by
  * this algorithm) depends on the order of the input points. The first three
  * points will form a triangle; other degenerate points will not break
- * this triangle.
+ * this triangle. With ParallelTriangulation on, the choice also depends on
+ * the partitioning, so it may differ from the serial triangulation.
  *
  * @warning
  * Points that are coincident (or nearly so) may be discarded by the algorithm.
@@ -132,6 +144,7 @@ class vtkAbstractTransform;
 class vtkCellArray;
 class vtkIdList;
 class vtkPointSet;
+class vtkPoints;
 
 #define VTK_DELAUNAY_XY_PLANE 0
 #define VTK_SET_TRANSFORM_PLANE 1
@@ -245,6 +258,17 @@ public:
   vtkGetMacro(ProjectionPlaneMode, int);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the parallel triangulation of the points (see the class
+   * documentation). It is only used when BoundingTriangulation is off, and
+   * for point sets large enough to be partitioned. Off by default.
+   */
+  vtkSetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkGetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkBooleanMacro(ParallelTriangulation, vtkTypeBool);
+  //@}
+
   /**
    * This method computes the best fit plane to a set of points represented
    * by a vtkPointSet. The method constructs a transform and returns it on
@@ -269,6 +293,8 @@ protected:
   int ProjectionPlaneMode; // selects the plane in 3D where the Delaunay triangulation will be
                            // computed.
 
+  vtkTypeBool ParallelTriangulation;
+
 private:
   vtkPolyData* Mesh; // the created mesh
   double* Points;    // the raw points in double precision
@@ -291,6 +317,14 @@ private:
   int NumberOfDuplicatePoints;
   int NumberOfDegeneracies;
 
+  // Set on the instances triangulating strips concurrently, which must not
+  // use the global state of rand().
+  bool Concurrent;
+
+  void InitializeMesh(vtkPoints* points, vtkIdType numPoints, double center[3], double radius);
+  void InsertPoints(vtkIdType numPoints, double tol);
+  vtkCellArray* TriangulateInParallel(vtkIdType numPoints, double tol);
+
   int* RecoverBoundary(vtkPolyData* source);
   int RecoverEdge(vtkPolyData* source, vtkIdType p1, vtkIdType p2);
   void FillPolygons(vtkCellArray* polys, int* triUse);
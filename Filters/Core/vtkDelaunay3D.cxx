@@ -14,8 +14,10 @@
 =========================================================================*/
 #include "vtkDelaunay3D.h"
 
+#include "vtkCellArray.h"
 #include "vtkEdgeTable.h"
 #include "vtkExecutive.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -24,10 +26,1045 @@
 #include "vtkPointData.h"
 #include "vtkPointLocator.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSpaceFillingCurveKeys.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Minimum number of points in a region of the parallel triangulation
+const vtkIdType VTK_DEL3D_MIN_REGION_SIZE = 10000;
+
+//--------------------------------------------------------------------------
+// Robust geometric predicates. The determinants are first evaluated in
+// floating point; when the error bound of the evaluation does not guarantee
+// their sign, they are evaluated exactly with the expansion arithmetic of
+// J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast
+// Robust Geometric Predicates", Discrete & Computational Geometry 18, 1997.
+const double Epsilon = 0.5 * std::numeric_limits<double>::epsilon();
+const double Splitter = 134217729.0; // 2^27 + 1
+const double OrientErrorBound = (7.0 + 56.0 * Epsilon) * Epsilon;
+const double InSphereErrorBound = (16.0 + 224.0 * Epsilon) * Epsilon;
+
+// A sum of non-overlapping doubles in increasing order of magnitude, with
+// zero components eliminated (an empty expansion is zero).
+using Expansion = std::vector<double>;
+
+void TwoSum(double a, double b, double& x, double& y)
+{
+  x = a + b;
+  const double bv = x - a;
+  const double av = x - bv;
+  y = (a - av) + (b - bv);
+}
+
+void FastTwoSum(double a, double b, double& x, double& y)
+{
+  x = a + b;
+  y = b - (x - a);
+}
+
+void Split(double a, double& hi, double& lo)
+{
+  const double c = Splitter * a;
+  hi = c - (c - a);
+  lo = a - hi;
+}
+
+void TwoProduct(double a, double b, double& x, double& y)
+{
+  x = a * b;
+  double ahi, alo, bhi, blo;
+  Split(a, ahi, alo);
+  Split(b, bhi, blo);
+  y = alo * blo - (((x - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+// The exact difference a - b
+Expansion Difference(double a, double b)
+{
+  const double x = a - b;
+  const double bv = a - x;
+  const double y = (a - (x + bv)) + (bv - b);
+  Expansion e;
+  if (y != 0.0)
+  {
+    e.push_back(y);
+  }
+  if (x != 0.0)
+  {
+    e.push_back(x);
+  }
+  return e;
+}
+
+// e + f, merging the components in increasing order of magnitude
+Expansion Add(const Expansion& e, const Expansion& f)
+{
+  if (e.empty() || f.empty())
+  {
+    return e.empty() ? f : e;
+  }
+  Expansion h;
+  h.reserve(e.size() + f.size());
+  size_t i = 0, j = 0;
+  auto next = [&]() {
+    return (j == f.size() || (i < e.size() && (f[j] > e[i]) == (f[j] > -e[i]))) ? e[i++]
+                                                                                 : f[j++];
+  };
+  double q = next();
+  while (i < e.size() || j < f.size())
+  {
+    double sum, error;
+    TwoSum(q, next(), sum, error);
+    if (error != 0.0)
+    {
+      h.push_back(error);
+    }
+    q = sum;
+  }
+  if (q != 0.0)
+  {
+    h.push_back(q);
+  }
+  return h;
+}
+
+// e * b
+Expansion Scale(const Expansion& e, double b)
+{
+  Expansion h;
+  if (e.empty() || b == 0.0)
+  {
+    return h;
+  }
+  double q, error;
+  TwoProduct(e[0], b, q, error);
+  if (error != 0.0)
+  {
+    h.push_back(error);
+  }
+  for (size_t i = 1; i < e.size(); ++i)
+  {
+    double product1, product0, sum;
+    TwoProduct(e[i], b, product1, product0);
+    TwoSum(q, product0, sum, error);
+    if (error != 0.0)
+    {
+      h.push_back(error);
+    }
+    FastTwoSum(product1, sum, q, error);
+    if (error != 0.0)
+    {
+      h.push_back(error);
+    }
+  }
+  if (q != 0.0)
+  {
+    h.push_back(q);
+  }
+  return h;
+}
+
+// e * f
+Expansion Multiply(const Expansion& e, const Expansion& f)
+{
+  Expansion h;
+  for (double component : f)
+  {
+    h = Add(h, Scale(e, component));
+  }
+  return h;
+}
+
+// e * f - g * h
+Expansion CrossTerm(const Expansion& e, const Expansion& f, const Expansion& g, const Expansion& h)
+{
+  return Add(Multiply(e, f), Scale(Multiply(g, h), -1.0));
+}
+
+int Sign(const Expansion& e)
+{
+  return e.empty() ? 0 : (e.back() > 0.0 ? 1 : -1);
+}
+
+// The exact determinant of the rows u, v and w, that is u.(v x w)
+Expansion Determinant(const Expansion u[3], const Expansion v[3], const Expansion w[3])
+{
+  return Add(Add(Multiply(u[0], CrossTerm(v[1], w[2], v[2], w[1])),
+               Multiply(u[1], CrossTerm(v[2], w[0], v[0], w[2]))),
+    Multiply(u[2], CrossTerm(v[0], w[1], v[1], w[0])));
+}
+
+// Sign of the volume of the tetrahedron (a,b,c,d): positive when (a,b,c) are
+// counterclockwise seen from d, which is the ordering of vtkTetra.
+int Orient(const double* a, const double* b, const double* c, const double* d)
+{
+  const double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+  const double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+  const double w[3] = { d[0] - a[0], d[1] - a[1], d[2] - a[2] };
+  const double v0w1 = v[0] * w[1], w0v1 = w[0] * v[1];
+  const double w0u1 = w[0] * u[1], u0w1 = u[0] * w[1];
+  const double u0v1 = u[0] * v[1], v0u1 = v[0] * u[1];
+  const double det = u[2] * (v0w1 - w0v1) + v[2] * (w0u1 - u0w1) + w[2] * (u0v1 - v0u1);
+  const double permanent = (std::abs(v0w1) + std::abs(w0v1)) * std::abs(u[2]) +
+    (std::abs(w0u1) + std::abs(u0w1)) * std::abs(v[2]) +
+    (std::abs(u0v1) + std::abs(v0u1)) * std::abs(w[2]);
+  const double bound = OrientErrorBound * permanent;
+  if (det > bound || -det > bound)
+  {
+    return det > 0.0 ? 1 : -1;
+  }
+
+  Expansion eu[3], ev[3], ew[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    eu[i] = Difference(b[i], a[i]);
+    ev[i] = Difference(c[i], a[i]);
+    ew[i] = Difference(d[i], a[i]);
+  }
+  return Sign(Determinant(eu, ev, ew));
+}
+
+// Positive when e is inside the circumsphere of the positively oriented
+// tetrahedron (a,b,c,d), negative when outside and zero when on the sphere.
+int InSphere(const double* a, const double* b, const double* c, const double* d, const double* e)
+{
+  const double aex = a[0] - e[0], aey = a[1] - e[1], aez = a[2] - e[2];
+  const double bex = b[0] - e[0], bey = b[1] - e[1], bez = b[2] - e[2];
+  const double cex = c[0] - e[0], cey = c[1] - e[1], cez = c[2] - e[2];
+  const double dex = d[0] - e[0], dey = d[1] - e[1], dez = d[2] - e[2];
+
+  const double aexbey = aex * bey, bexaey = bex * aey;
+  const double bexcey = bex * cey, cexbey = cex * bey;
+  const double cexdey = cex * dey, dexcey = dex * cey;
+  const double dexaey = dex * aey, aexdey = aex * dey;
+  const double aexcey = aex * cey, cexaey = cex * aey;
+  const double bexdey = bex * dey, dexbey = dex * bey;
+  const double ab = aexbey - bexaey;
+  const double bc = bexcey - cexbey;
+  const double cd = cexdey - dexcey;
+  const double da = dexaey - aexdey;
+  const double ac = aexcey - cexaey;
+  const double bd = bexdey - dexbey;
+
+  const double abc = aez * bc - bez * ac + cez * ab;
+  const double bcd = bez * cd - cez * bd + dez * bc;
+  const double cda = cez * da + dez * ac + aez * cd;
+  const double dab = dez * ab + aez * bd + bez * da;
+
+  const double alift = aex * aex + aey * aey + aez * aez;
+  const double blift = bex * bex + bey * bey + bez * bez;
+  const double clift = cex * cex + cey * cey + cez * cez;
+  const double dlift = dex * dex + dey * dey + dez * dez;
+
+  const double det = (alift * bcd - blift * cda) + (clift * dab - dlift * abc);
+
+  const double aezplus = std::abs(aez), bezplus = std::abs(bez);
+  const double cezplus = std::abs(cez), dezplus = std::abs(dez);
+  const double abplus = std::abs(aexbey) + std::abs(bexaey);
+  const double bcplus = std::abs(bexcey) + std::abs(cexbey);
+  const double cdplus = std::abs(cexdey) + std::abs(dexcey);
+  const double daplus = std::abs(dexaey) + std::abs(aexdey);
+  const double acplus = std::abs(aexcey) + std::abs(cexaey);
+  const double bdplus = std::abs(bexdey) + std::abs(dexbey);
+  const double permanent = (cdplus * bezplus + bdplus * cezplus + bcplus * dezplus) * alift +
+    (daplus * cezplus + acplus * dezplus + cdplus * aezplus) * blift +
+    (abplus * dezplus + bdplus * aezplus + daplus * bezplus) * clift +
+    (bcplus * aezplus + acplus * bezplus + abplus * cezplus) * dlift;
+  const double bound = InSphereErrorBound * permanent;
+  if (det > bound || -det > bound)
+  {
+    return det > 0.0 ? 1 : -1;
+  }
+
+  const double* pts[4] = { a, b, c, d };
+  Expansion rows[4][3], lifts[4];
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      rows[i][j] = Difference(pts[i][j], e[j]);
+      lifts[i] = Add(lifts[i], Multiply(rows[i][j], rows[i][j]));
+    }
+  }
+  Expansion exact = Multiply(lifts[0], Determinant(rows[1], rows[2], rows[3]));
+  exact = Add(exact, Scale(Multiply(lifts[1], Determinant(rows[0], rows[2], rows[3])), -1.0));
+  exact = Add(exact, Multiply(lifts[2], Determinant(rows[0], rows[1], rows[3])));
+  exact = Add(exact, Scale(Multiply(lifts[3], Determinant(rows[0], rows[1], rows[2])), -1.0));
+  return Sign(exact);
+}
+
+bool LexicographicLess(const double* x, const double* y)
+{
+  return std::lexicographical_compare(x, x + 3, y, y + 3);
+}
+
+// InSphere() with a symbolic perturbation of the points breaking the ties
+// of cospherical points, so that the Delaunay triangulation of any set of
+// points is unique and does not depend on the insertion order. The points
+// are lifted to the paraboloid and raised by amounts decreasing quickly with
+// their lexicographic order (O. Devillers and M. Teillaud, "Perturbations for
+// Delaunay and weighted Delaunay 3D triangulations", Computational Geometry
+// 44(3), 2011).
+int PerturbedInSphere(
+  const double* a, const double* b, const double* c, const double* d, const double* e)
+{
+  const int inSphere = InSphere(a, b, c, d, e);
+  if (inSphere != 0)
+  {
+    return inSphere;
+  }
+  const double* sorted[5] = { a, b, c, d, e };
+  std::sort(sorted, sorted + 5, LexicographicLess);
+  for (int i = 4; i > 2; --i)
+  {
+    // The point raised the most: e is outside if it is e, otherwise the
+    // sphere bulges toward the raised point.
+    int orient = 0;
+    if (sorted[i] == e)
+    {
+      return -1;
+    }
+    else if (sorted[i] == d)
+    {
+      orient = Orient(a, b, c, e);
+    }
+    else if (sorted[i] == c)
+    {
+      orient = Orient(a, b, e, d);
+    }
+    else if (sorted[i] == b)
+    {
+      orient = Orient(a, e, c, d);
+    }
+    else
+    {
+      orient = Orient(e, b, c, d);
+    }
+    if (orient != 0)
+    {
+      return orient;
+    }
+  }
+  return -1;
+}
+
+//--------------------------------------------------------------------------
+// Order the point ids for insertion with a biased randomized insertion order
+// (N. Amenta, S. Choi and G. Rote, "Incremental constructions con BRIO",
+// Symposium on Computational Geometry, 2003): the points are shuffled and
+// split into rounds of geometrically increasing size, and the points of each
+// round are sorted along a Hilbert curve. The random order keeps the
+// expected size of the triangulation small, and the curve order keeps
+// consecutive points close to each other, so that locating each point takes
+// a short walk through tetrahedra that are likely in cache.
+template <typename TIds>
+void SortForInsertion(const double* points, std::vector<TIds>& ids)
+{
+  const size_t numIds = ids.size();
+  double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+    VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (TIds id : ids)
+  {
+    const double* x = points + 3 * id;
+    for (int i = 0; i < 3; ++i)
+    {
+      bounds[2 * i] = std::min(bounds[2 * i], x[i]);
+      bounds[2 * i + 1] = std::max(bounds[2 * i + 1], x[i]);
+    }
+  }
+  const double extent =
+    std::max(std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]), bounds[5] - bounds[4]);
+  const double scale = extent > 0.0 ? 2097151.0 / extent : 0.0;
+
+  // Deterministic shuffle
+  vtkTypeUInt64 seed = 0x9e3779b97f4a7c15ULL;
+  for (size_t i = numIds; i > 1; --i)
+  {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    std::swap(ids[i - 1], ids[(seed >> 33) % i]);
+  }
+
+  std::vector<std::pair<vtkTypeUInt64, TIds> > keys(numIds);
+  for (size_t i = 0; i < numIds; ++i)
+  {
+    const double* x = points + 3 * ids[i];
+    unsigned int c[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      c[j] = static_cast<unsigned int>((x[j] - bounds[2 * j]) * scale);
+    }
+    keys[i] = std::make_pair(vtkSpaceFillingCurveKeys::HilbertKey(c[0], c[1], c[2]), ids[i]);
+  }
+  for (size_t end = numIds; end > 0;)
+  {
+    const size_t begin = end > 1000 ? end / 4 : 0;
+    std::sort(keys.begin() + begin, keys.begin() + end);
+    end = begin;
+  }
+  for (size_t i = 0; i < numIds; ++i)
+  {
+    ids[i] = keys[i].second;
+  }
+}
+
+//--------------------------------------------------------------------------
+// A compact Delaunay tetrahedralization: four point ids and four neighbors
+// per tetrahedron in flat arrays, with points inserted by the Bowyer-Watson
+// algorithm. The neighbor i of a tetrahedron is across the face opposite its
+// point i, and all the tetrahedra are positively oriented. The points are
+// enclosed in a bounding tetrahedron, whose point ids are given. Points
+// closer than the tolerance to a point of the triangulation are rejected.
+template <typename TIds>
+class Tetrahedralization
+{
+public:
+  Tetrahedralization(const double* points, TIds firstBoundingPoint, double tolerance)
+    : Points(points)
+    , Tolerance2(tolerance * tolerance)
+    , Hint(0)
+    , Stamp(0)
+    , Seed(0)
+    , NumberOfDuplicatePoints(0)
+    , NumberOfDegeneracies(0)
+  {
+    for (TIds i = 0; i < 4; ++i)
+    {
+      this->Tetras.push_back(firstBoundingPoint + i);
+      this->Neighbors.push_back(-1);
+    }
+    this->Marks.push_back(0);
+  }
+
+  // Insert the points in a spatially coherent order
+  void InsertPoints(std::vector<TIds>& ids)
+  {
+    SortForInsertion(this->Points, ids);
+    const size_t expectedSize = 4 * (7 * ids.size() + 1);
+    this->Tetras.reserve(expectedSize);
+    this->Neighbors.reserve(expectedSize);
+    this->Marks.reserve(expectedSize / 4);
+    for (TIds id : ids)
+    {
+      this->InsertPoint(id);
+    }
+  }
+
+  void InsertPoint(TIds ptId);
+
+  TIds GetNumberOfTetras() const { return static_cast<TIds>(this->Marks.size()); }
+  bool IsDeleted(TIds tetId) const { return this->Tetras[4 * tetId] < 0; }
+  const TIds* GetTetra(TIds tetId) const { return this->Tetras.data() + 4 * tetId; }
+  TIds GetNeighbor(TIds tetId, int face) const { return this->Neighbors[4 * tetId + face]; }
+
+  vtkIdType GetNumberOfDuplicatePoints() const { return this->NumberOfDuplicatePoints; }
+  vtkIdType GetNumberOfDegeneracies() const { return this->NumberOfDegeneracies; }
+
+private:
+  struct BoundaryFace
+  {
+    TIds Tetra;
+    int Face;
+    TIds Outside;
+  };
+  struct NewFace
+  {
+    TIds Edge[2];
+    TIds Tetra;
+    int Face;
+    bool operator<(const NewFace& other) const
+    {
+      return this->Edge[0] < other.Edge[0] ||
+        (this->Edge[0] == other.Edge[0] && this->Edge[1] < other.Edge[1]);
+    }
+  };
+
+  const double* GetPoint(TIds ptId) const { return this->Points + 3 * ptId; }
+  TIds Locate(const double* x);
+
+  const double* Points;
+  double Tolerance2;
+  std::vector<TIds> Tetras;
+  std::vector<TIds> Neighbors;
+  std::vector<TIds> Marks; // cavity marks of the current insertion
+  std::vector<TIds> FreeTetras;
+  TIds Hint;  // tetrahedron where the walk to the next point starts
+  TIds Stamp; // marks of the current insertion are Stamp and Stamp + 1
+  vtkTypeUInt64 Seed;
+  vtkIdType NumberOfDuplicatePoints;
+  vtkIdType NumberOfDegeneracies;
+
+  // Work arrays
+  std::vector<TIds> Cavity;
+  std::vector<BoundaryFace> Boundary;
+  std::vector<NewFace> NewFaces;
+};
+
+//--------------------------------------------------------------------------
+// Walk from the hint toward x, crossing a face separating the tetrahedron
+// from x picked at random, and return the tetrahedron containing x, or -1 if
+// the walk leaves the triangulation.
+template <typename TIds>
+TIds Tetrahedralization<TIds>::Locate(const double* x)
+{
+  TIds tetId = this->Hint;
+  TIds previous = -1;
+  for (;;)
+  {
+    const TIds* tetra = this->GetTetra(tetId);
+    const double* pts[4] = { this->GetPoint(tetra[0]), this->GetPoint(tetra[1]),
+      this->GetPoint(tetra[2]), this->GetPoint(tetra[3]) };
+    this->Seed = this->Seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const int first = static_cast<int>(this->Seed >> 62);
+    int k = 0;
+    TIds next = -1;
+    for (; k < 4; ++k)
+    {
+      const int face = (first + k) & 3;
+      next = this->Neighbors[4 * tetId + face];
+      if (next == previous && next >= 0)
+      {
+        continue;
+      }
+      const double* p = pts[face];
+      pts[face] = x;
+      const int orient = Orient(pts[0], pts[1], pts[2], pts[3]);
+      pts[face] = p;
+      if (orient < 0)
+      {
+        break;
+      }
+    }
+    if (k == 4)
+    {
+      return tetId;
+    }
+    if (next < 0)
+    {
+      return -1;
+    }
+    previous = tetId;
+    tetId = next;
+  }
+}
+
+//--------------------------------------------------------------------------
+template <typename TIds>
+void Tetrahedralization<TIds>::InsertPoint(TIds ptId)
+{
+  const double* x = this->GetPoint(ptId);
+  const TIds tetId = this->Locate(x);
+  if (tetId < 0)
+  {
+    this->NumberOfDegeneracies++;
+    return;
+  }
+  for (int i = 0; i < 4; ++i)
+  {
+    const double* y = this->GetPoint(this->GetTetra(tetId)[i]);
+    if (x[0] == y[0] && x[1] == y[1] && x[2] == y[2])
+    {
+      this->NumberOfDuplicatePoints++;
+      return;
+    }
+  }
+
+  // Gather the tetrahedra whose circumsphere contains the point, and the
+  // faces bounding them.
+  this->Stamp += 2;
+  const TIds inside = this->Stamp;
+  const TIds outside = this->Stamp + 1;
+  this->Cavity.clear();
+  this->Boundary.clear();
+  this->Cavity.push_back(tetId);
+  this->Marks[tetId] = inside;
+  for (size_t c = 0; c < this->Cavity.size(); ++c)
+  {
+    const TIds cavityId = this->Cavity[c];
+    for (int face = 0; face < 4; ++face)
+    {
+      const TIds nei = this->Neighbors[4 * cavityId + face];
+      if (nei >= 0)
+      {
+        if (this->Marks[nei] == inside)
+        {
+          continue;
+        }
+        if (this->Marks[nei] != outside)
+        {
+          const TIds* tetra = this->GetTetra(nei);
+          if (PerturbedInSphere(this->GetPoint(tetra[0]), this->GetPoint(tetra[1]),
+                this->GetPoint(tetra[2]), this->GetPoint(tetra[3]), x) > 0)
+          {
+            this->Marks[nei] = inside;
+            this->Cavity.push_back(nei);
+            continue;
+          }
+          this->Marks[nei] = outside;
+        }
+      }
+      this->Boundary.push_back(BoundaryFace{ cavityId, face, nei });
+    }
+  }
+
+  // The nearest point of the triangulation is on the boundary of the cavity
+  if (this->Tolerance2 > 0.0)
+  {
+    for (const BoundaryFace& bf : this->Boundary)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        if (i != bf.Face &&
+          vtkMath::Distance2BetweenPoints(x, this->GetPoint(this->GetTetra(bf.Tetra)[i])) <=
+            this->Tolerance2)
+        {
+          this->NumberOfDuplicatePoints++;
+          return;
+        }
+      }
+    }
+  }
+
+  // Connect the point to each boundary face. The new tetrahedra reuse the
+  // ids of the cavity, so the data of each face is gathered first.
+  const size_t numFaces = this->Boundary.size();
+  std::vector<TIds> newTetras(4 * numFaces);
+  std::vector<int> outsideFaces(numFaces, -1);
+  for (size_t f = 0; f < numFaces; ++f)
+  {
+    const BoundaryFace& bf = this->Boundary[f];
+    std::copy(this->GetTetra(bf.Tetra), this->GetTetra(bf.Tetra) + 4, &newTetras[4 * f]);
+    newTetras[4 * f + bf.Face] = ptId;
+    if (bf.Outside >= 0)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        if (this->Neighbors[4 * bf.Outside + i] == bf.Tetra)
+        {
+          outsideFaces[f] = i;
+        }
+      }
+    }
+  }
+  for (size_t c = numFaces; c < this->Cavity.size(); ++c)
+  {
+    this->Tetras[4 * this->Cavity[c]] = -1;
+    this->FreeTetras.push_back(this->Cavity[c]);
+  }
+
+  this->NewFaces.clear();
+  for (size_t f = 0; f < numFaces; ++f)
+  {
+    TIds newId;
+    if (f < this->Cavity.size())
+    {
+      newId = this->Cavity[f];
+    }
+    else if (!this->FreeTetras.empty())
+    {
+      newId = this->FreeTetras.back();
+      this->FreeTetras.pop_back();
+    }
+    else
+    {
+      newId = static_cast<TIds>(this->Marks.size());
+      this->Tetras.resize(this->Tetras.size() + 4);
+      this->Neighbors.resize(this->Neighbors.size() + 4);
+      this->Marks.push_back(0);
+    }
+    const BoundaryFace& bf = this->Boundary[f];
+    std::copy(&newTetras[4 * f], &newTetras[4 * f] + 4, &this->Tetras[4 * newId]);
+    this->Neighbors[4 * newId + bf.Face] = bf.Outside;
+    if (bf.Outside >= 0)
+    {
+      this->Neighbors[4 * bf.Outside + outsideFaces[f]] = newId;
+    }
+
+    // The other faces contain the point and an edge of the boundary face
+    for (int face = 0; face < 4; ++face)
+    {
+      if (face != bf.Face)
+      {
+        NewFace nf;
+        int n = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+          if (i != face && i != bf.Face)
+          {
+            nf.Edge[n++] = newTetras[4 * f + i];
+          }
+        }
+        if (nf.Edge[0] > nf.Edge[1])
+        {
+          std::swap(nf.Edge[0], nf.Edge[1]);
+        }
+        nf.Tetra = newId;
+        nf.Face = face;
+        this->NewFaces.push_back(nf);
+      }
+    }
+    this->Hint = newId;
+  }
+
+  // Each edge of the boundary of the cavity is shared by two new tetrahedra
+  std::sort(this->NewFaces.begin(), this->NewFaces.end());
+  for (size_t i = 0; i + 1 < this->NewFaces.size(); i += 2)
+  {
+    const NewFace& nf0 = this->NewFaces[i];
+    const NewFace& nf1 = this->NewFaces[i + 1];
+    if (nf0.Edge[0] != nf1.Edge[0] || nf0.Edge[1] != nf1.Edge[1])
+    {
+      this->NumberOfDegeneracies++;
+      continue;
+    }
+    this->Neighbors[4 * nf0.Tetra + nf0.Face] = nf1.Tetra;
+    this->Neighbors[4 * nf1.Tetra + nf1.Face] = nf0.Tetra;
+  }
+}
+
+//--------------------------------------------------------------------------
+// A face of the parallel triangulation separating a tetrahedron kept from a
+// region from the rest of the mesh: its sorted point ids, and the point of
+// the kept tetrahedron opposite to it.
+template <typename TIds>
+struct SeamFace
+{
+  TIds Ids[3];
+  TIds Apex;
+  bool operator<(const SeamFace& other) const
+  {
+    return std::lexicographical_compare(this->Ids, this->Ids + 3, other.Ids, other.Ids + 3);
+  }
+};
+
+// Whether the circumsphere of the tetrahedron lies strictly between the
+// planes x = xMin and x = xMax, allowing for the error of its computation.
+bool CircumsphereInSlab(const double* a, const double* b, const double* c, const double* d,
+  double xMin, double xMax)
+{
+  double u[3], v[3], w[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    u[i] = b[i] - a[i];
+    v[i] = c[i] - a[i];
+    w[i] = d[i] - a[i];
+  }
+  double vw[3], wu[3], uv[3];
+  vtkMath::Cross(v, w, vw);
+  vtkMath::Cross(w, u, wu);
+  vtkMath::Cross(u, v, uv);
+  const double det = vtkMath::Dot(u, vw);
+  if (det <= 0.0)
+  {
+    return false;
+  }
+  const double u2 = vtkMath::Dot(u, u);
+  const double v2 = vtkMath::Dot(v, v);
+  const double w2 = vtkMath::Dot(w, w);
+  double center[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    center[i] = (u2 * vw[i] + v2 * wu[i] + w2 * uv[i]) / (2.0 * det);
+  }
+  const double radius = vtkMath::Norm(center);
+  const double cx = a[0] + center[0];
+
+  // The relative error grows with the condition of the tetrahedron
+  const double length = std::sqrt(std::max(std::max(u2, v2), w2));
+  const double margin =
+    1.0e-12 * (length * length * length / det * (radius + length) + std::abs(cx) + radius);
+  return cx - radius - margin > xMin && cx + radius + margin < xMax;
+}
+
+//--------------------------------------------------------------------------
+// Concatenate the point ids of the tetrahedra of several lists
+template <typename TIds>
+void GatherTetras(const std::vector<std::vector<TIds> >& tetras, vtkIdTypeArray* connectivity)
+{
+  std::vector<vtkIdType> offsets(tetras.size() + 1, 0);
+  for (size_t i = 0; i < tetras.size(); ++i)
+  {
+    offsets[i + 1] = offsets[i] + static_cast<vtkIdType>(tetras[i].size());
+  }
+  connectivity->SetNumberOfValues(offsets.back());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tetras.size()), 1,
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        std::copy(tetras[i].begin(), tetras[i].end(), connectivity->GetPointer(offsets[i]));
+      }
+    });
+}
+
+//--------------------------------------------------------------------------
+// Delaunay triangulation of the points split into slabs along x, each slab
+// being triangulated concurrently. A tetrahedron whose circumsphere lies
+// inside its slab does not enclose any point of the other slabs, so it is a
+// tetrahedron of the triangulation of all the points. The points of the
+// other tetrahedra are triangulated again, and the tetrahedra of this seam
+// triangulation filling the gaps between the kept tetrahedra complete the
+// mesh. The symbolic perturbation makes all these triangulations consistent.
+template <typename TIds>
+void TriangulateRegions(const double* points, TIds numPoints, double tolerance,
+  vtkIdType numRegions, vtkIdTypeArray* connectivity, vtkIdType& numDuplicates,
+  vtkIdType& numDegeneracies)
+{
+  if (numRegions <= 1)
+  {
+    std::vector<TIds> ids(numPoints);
+    std::iota(ids.begin(), ids.end(), 0);
+    Tetrahedralization<TIds> mesh(points, numPoints, tolerance);
+    mesh.InsertPoints(ids);
+    std::vector<std::vector<TIds> > tetras(1);
+    for (TIds tetId = 0; tetId < mesh.GetNumberOfTetras(); ++tetId)
+    {
+      const TIds* tetra = mesh.GetTetra(tetId);
+      if (!mesh.IsDeleted(tetId) && tetra[0] < numPoints && tetra[1] < numPoints &&
+        tetra[2] < numPoints && tetra[3] < numPoints)
+      {
+        tetras[0].insert(tetras[0].end(), tetra, tetra + 4);
+      }
+    }
+    GatherTetras(tetras, connectivity);
+    numDuplicates = mesh.GetNumberOfDuplicatePoints();
+    numDegeneracies = mesh.GetNumberOfDegeneracies();
+    return;
+  }
+
+  // Sort the points along x and split them into regions. Points closer than
+  // the tolerance in x are kept in the same region, so that close points
+  // are merged consistently.
+  std::vector<std::pair<double, TIds> > order(numPoints);
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      order[i] = std::make_pair(points[3 * i], static_cast<TIds>(i));
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+  std::vector<TIds> starts(1, 0);
+  for (vtkIdType r = 1; r < numRegions; ++r)
+  {
+    TIds start = std::max(static_cast<TIds>(r * numPoints / numRegions), starts.back() + 1);
+    while (start < numPoints && order[start].first - order[start - 1].first <= tolerance)
+    {
+      ++start;
+    }
+    if (start < numPoints)
+    {
+      starts.push_back(start);
+    }
+  }
+  starts.push_back(numPoints);
+  if (starts.size() == 2)
+  {
+    TriangulateRegions(points, numPoints, tolerance, 1, connectivity, numDuplicates,
+      numDegeneracies);
+    return;
+  }
+  numRegions = static_cast<vtkIdType>(starts.size()) - 1;
+
+  std::vector<std::vector<TIds> > keptTetras(numRegions);
+  std::vector<std::vector<SeamFace<TIds> > > seamFaces(numRegions);
+  std::vector<vtkIdType> duplicates(numRegions + 1, 0);
+  std::vector<vtkIdType> degeneracies(numRegions + 1, 0);
+  std::vector<unsigned char> inSeam(numPoints, 0);
+  vtkSMPTools::For(0, numRegions, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType r = begin; r < end; ++r)
+    {
+      std::vector<TIds> ids(starts[r + 1] - starts[r]);
+      for (TIds i = starts[r]; i < starts[r + 1]; ++i)
+      {
+        ids[i - starts[r]] = order[i].second;
+      }
+      const double xMin =
+        r == 0 ? VTK_DOUBLE_MIN : 0.5 * (order[starts[r] - 1].first + order[starts[r]].first);
+      const double xMax = r == numRegions - 1
+        ? VTK_DOUBLE_MAX
+        : 0.5 * (order[starts[r + 1] - 1].first + order[starts[r + 1]].first);
+
+      Tetrahedralization<TIds> region(points, numPoints, tolerance);
+      region.InsertPoints(ids);
+      duplicates[r] = region.GetNumberOfDuplicatePoints();
+      degeneracies[r] = region.GetNumberOfDegeneracies();
+
+      const TIds numTetras = region.GetNumberOfTetras();
+      std::vector<unsigned char> keep(numTetras, 0);
+      for (TIds tetId = 0; tetId < numTetras; ++tetId)
+      {
+        const TIds* tetra = region.GetTetra(tetId);
+        if (region.IsDeleted(tetId))
+        {
+          continue;
+        }
+        if (tetra[0] < numPoints && tetra[1] < numPoints && tetra[2] < numPoints &&
+          tetra[3] < numPoints &&
+          CircumsphereInSlab(points + 3 * tetra[0], points + 3 * tetra[1], points + 3 * tetra[2],
+            points + 3 * tetra[3], xMin, xMax))
+        {
+          keep[tetId] = 1;
+          keptTetras[r].insert(keptTetras[r].end(), tetra, tetra + 4);
+        }
+        else
+        {
+          for (int i = 0; i < 4; ++i)
+          {
+            if (tetra[i] < numPoints)
+            {
+              inSeam[tetra[i]] = 1;
+            }
+          }
+        }
+      }
+      for (TIds tetId = 0; tetId < numTetras; ++tetId)
+      {
+        if (!keep[tetId])
+        {
+          continue;
+        }
+        const TIds* tetra = region.GetTetra(tetId);
+        for (int face = 0; face < 4; ++face)
+        {
+          const TIds nei = region.GetNeighbor(tetId, face);
+          if (nei >= 0 && !keep[nei])
+          {
+            SeamFace<TIds> sf;
+            for (int i = 0, n = 0; i < 4; ++i)
+            {
+              if (i != face)
+              {
+                sf.Ids[n++] = tetra[i];
+              }
+            }
+            std::sort(sf.Ids, sf.Ids + 3);
+            sf.Apex = tetra[face];
+            seamFaces[r].push_back(sf);
+          }
+        }
+      }
+    }
+  });
+
+  // Triangulate the points of the seam
+  std::vector<TIds> seamIds;
+  for (TIds i = 0; i < numPoints; ++i)
+  {
+    if (inSeam[i])
+    {
+      seamIds.push_back(i);
+    }
+  }
+  Tetrahedralization<TIds> seam(points, numPoints, 0.0);
+  seam.InsertPoints(seamIds);
+  degeneracies[numRegions] = seam.GetNumberOfDegeneracies();
+
+  std::vector<SeamFace<TIds> > faces;
+  for (const auto& regionFaces : seamFaces)
+  {
+    faces.insert(faces.end(), regionFaces.begin(), regionFaces.end());
+  }
+  std::sort(faces.begin(), faces.end());
+  auto findFace = [&](const TIds* tetra, int face) -> const SeamFace<TIds>* {
+    SeamFace<TIds> sf;
+    for (int i = 0, n = 0; i < 4; ++i)
+    {
+      if (i != face)
+      {
+        sf.Ids[n++] = tetra[i];
+      }
+    }
+    std::sort(sf.Ids, sf.Ids + 3);
+    auto found = std::lower_bound(faces.begin(), faces.end(), sf);
+    return found != faces.end() && !(sf < *found) ? &*found : nullptr;
+  };
+
+  // Classify the tetrahedra of the seam: those using a bounding point, or
+  // on the other side of a face of the kept tetrahedra, fill the gaps, and
+  // those on the same side overlap the kept tetrahedra. The classification
+  // is propagated to the neighbors that are not across such a face.
+  const TIds numSeamTetras = seam.GetNumberOfTetras();
+  std::vector<signed char> fill(numSeamTetras, -1);
+  std::vector<TIds> stack;
+  for (TIds tetId = 0; tetId < numSeamTetras; ++tetId)
+  {
+    if (seam.IsDeleted(tetId))
+    {
+      continue;
+    }
+    const TIds* tetra = seam.GetTetra(tetId);
+    if (tetra[0] >= numPoints || tetra[1] >= numPoints || tetra[2] >= numPoints ||
+      tetra[3] >= numPoints)
+    {
+      fill[tetId] = 1;
+    }
+    for (int face = 0; face < 4 && fill[tetId] < 0; ++face)
+    {
+      const SeamFace<TIds>* sf = findFace(tetra, face);
+      if (sf)
+      {
+        const double* x0 = points + 3 * sf->Ids[0];
+        const double* x1 = points + 3 * sf->Ids[1];
+        const double* x2 = points + 3 * sf->Ids[2];
+        fill[tetId] = Orient(x0, x1, x2, points + 3 * tetra[face]) !=
+            Orient(x0, x1, x2, points + 3 * sf->Apex)
+          ? 1
+          : 0;
+      }
+    }
+    if (fill[tetId] >= 0)
+    {
+      stack.push_back(tetId);
+    }
+  }
+  while (!stack.empty())
+  {
+    const TIds tetId = stack.back();
+    stack.pop_back();
+    for (int face = 0; face < 4; ++face)
+    {
+      const TIds nei = seam.GetNeighbor(tetId, face);
+      if (nei >= 0 && fill[nei] < 0 && !findFace(seam.GetTetra(tetId), face))
+      {
+        fill[nei] = fill[tetId];
+        stack.push_back(nei);
+      }
+    }
+  }
+
+  // Gather the tetrahedra
+  std::vector<TIds> seamTetras;
+  for (TIds tetId = 0; tetId < numSeamTetras; ++tetId)
+  {
+    const TIds* tetra = seam.GetTetra(tetId);
+    if (fill[tetId] == 1 && tetra[0] < numPoints && tetra[1] < numPoints &&
+      tetra[2] < numPoints && tetra[3] < numPoints)
+    {
+      seamTetras.insert(seamTetras.end(), tetra, tetra + 4);
+    }
+  }
+  keptTetras.push_back(std::move(seamTetras));
+  GatherTetras(keptTetras, connectivity);
+
+  numDuplicates = 0;
+  numDegeneracies = 0;
+  for (vtkIdType r = 0; r <= numRegions; ++r)
+  {
+    numDuplicates += duplicates[r];
+    numDegeneracies += degeneracies[r];
+  }
+}
+}
+
 vtkStandardNewMacro(vtkDelaunay3D);
 
 //--------------------------------------------------------------------------
@@ -139,6 +1176,7 @@ vtkDelaunay3D::vtkDelaunay3D()
   this->OutputPointsPrecision = DEFAULT_PRECISION;
   this->Locator = nullptr;
   this->TetraArray = nullptr;
+  this->ParallelTriangulation = 0;
 
   // added for performance
   this->Tetras = vtkIdList::New();
@@ -481,33 +1519,60 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     points->SetDataType(VTK_DOUBLE);
   }
 
-  points->Allocate(numPoints + 6);
-
-  Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
-
-  // Insert each point into triangulation. Points laying "inside"
-  // of tetra cause tetra to be deleted, leaving a void with bounding
-  // faces. Combination of point and each face is used to form new
-  // tetrahedra.
-  for (ptId = 0; ptId < numPoints; ptId++)
+  const bool parallel = this->ParallelTriangulation && !this->BoundingTriangulation;
+  if (parallel)
   {
-    inPoints->GetPoint(ptId, x);
+    vtkCellArray* tetras = this->TriangulateInParallel(inPoints, center, tol);
+    points->DeepCopy(inPoints);
+    Mesh = vtkUnstructuredGrid::New();
+    Mesh->SetPoints(points);
+    points->Delete();
+    Mesh->SetCells(VTK_TETRA, tetras);
+    tetras->Delete();
+
+    // The alpha shape uses the links and the circumspheres of the mesh
+    if (this->Alpha > 0.0)
+    {
+      Mesh->EditableOn();
+      Mesh->BuildLinks();
+      delete this->TetraArray;
+      this->TetraArray = new vtkTetraArray(Mesh->GetNumberOfCells(), numPoints);
+      for (i = 0; i < Mesh->GetNumberOfCells(); i++)
+      {
+        this->InsertTetra(Mesh, points, i);
+      }
+    }
+  }
+  else
+  {
+    points->Allocate(numPoints + 6);
 
-    this->InsertPoint(Mesh, points, ptId, x, holeTetras);
+    Mesh = this->InitPointInsertion(center, this->Offset * tol, numPoints, points);
 
-    if (!(ptId % 250))
+    // Insert each point into triangulation. Points laying "inside"
+    // of tetra cause tetra to be deleted, leaving a void with bounding
+    // faces. Combination of point and each face is used to form new
+    // tetrahedra.
+    for (ptId = 0; ptId < numPoints; ptId++)
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
-      if (this->GetAbortExecute())
+      inPoints->GetPoint(ptId, x);
+
+      this->InsertPoint(Mesh, points, ptId, x, holeTetras);
+
+      if (!(ptId % 250))
       {
-        break;
+        vtkDebugMacro(<< "point #" << ptId);
+        this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+        if (this->GetAbortExecute())
+        {
+          break;
+        }
       }
-    }
 
-  } // for all points
+    } // for all points
 
-  this->EndPointInsertion();
+    this->EndPointInsertion();
+  }
 
   vtkDebugMacro(<< "Triangulated " << numPoints << " points, " << this->NumberOfDuplicatePoints
                 << " of which were duplicates");
@@ -520,7 +1585,10 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
 
   // Send appropriate portions of triangulation to output
   //
-  output->Allocate(5 * numPoints);
+  if (!parallel || this->Alpha > 0.0)
+  {
+    output->Allocate(5 * numPoints);
+  }
   numTetras = Mesh->GetNumberOfCells();
   tetraUse = new char[numTetras];
 
@@ -534,8 +1602,8 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // if boundary triangulation not desired, delete tetras connected to
-  // boundary points
-  if (!this->BoundingTriangulation)
+  // boundary points (the parallel triangulation does not output them)
+  if (!this->BoundingTriangulation && !parallel)
   {
     for (ptId = numPoints; ptId < (numPoints + 6); ptId++)
     {
@@ -742,12 +1810,19 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
     output->GetPointData()->PassData(input->GetPointData());
   }
 
-  for (i = 0; i < numTetras; i++)
+  if (parallel && this->Alpha <= 0.0)
+  {
+    output->SetCells(VTK_TETRA, Mesh->GetCells());
+  }
+  else
   {
-    if (tetraUse[i] == 2)
+    for (i = 0; i < numTetras; i++)
     {
-      Mesh->GetCellPoints(i, npts, tetraPts);
-      output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      if (tetraUse[i] == 2)
+      {
+        Mesh->GetCellPoints(i, npts, tetraPts);
+        output->InsertNextCell(VTK_TETRA, 4, tetraPts);
+      }
     }
   }
   vtkDebugMacro(<< "Generated " << output->GetNumberOfPoints() << " points and "
@@ -764,6 +1839,78 @@ int vtkDelaunay3D::RequestData(vtkInformation* vtkNotUsed(request),
   return 1;
 }
 
+//--------------------------------------------------------------------------
+// Triangulate the points with the compact, robust tetrahedralization, in
+// regions processed concurrently. The points are enclosed in a tetrahedron
+// whose inscribed sphere has a radius of Offset times the length of the
+// input. Return the tetrahedra that do not use its points.
+vtkCellArray* vtkDelaunay3D::TriangulateInParallel(
+  vtkPoints* inPoints, double center[3], double length)
+{
+  const vtkIdType numPoints = inPoints->GetNumberOfPoints();
+  if (length <= 0.0)
+  {
+    length = 1.0;
+  }
+
+  std::vector<double> points(3 * (numPoints + 4));
+  vtkSMPTools::For(0, numPoints, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      inPoints->GetPoint(ptId, points.data() + 3 * ptId);
+    }
+  });
+  static const double corners[4][3] = { { 1, 1, 1 }, { -1, -1, 1 }, { -1, 1, -1 },
+    { 1, -1, -1 } };
+  const double size = std::sqrt(3.0) * this->Offset * length;
+  double* bounding = points.data() + 3 * numPoints;
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 3; ++j)
+    {
+      bounding[3 * i + j] = center[j] + size * corners[i][j];
+    }
+  }
+  if (Orient(bounding, bounding + 3, bounding + 6, bounding + 9) < 0)
+  {
+    std::swap_ranges(bounding + 6, bounding + 9, bounding + 9);
+  }
+
+  const vtkIdType numRegions = std::max(static_cast<vtkIdType>(1),
+    std::min(static_cast<vtkIdType>(2 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+      numPoints / VTK_DEL3D_MIN_REGION_SIZE));
+  const double tolerance = this->Tolerance * length;
+  vtkIdType numDuplicates, numDegeneracies;
+  vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+  if (numPoints + 4 <= VTK_INT_MAX / 16)
+  {
+    TriangulateRegions<int>(points.data(), static_cast<int>(numPoints), tolerance, numRegions,
+      connectivity, numDuplicates, numDegeneracies);
+  }
+  else
+  {
+    TriangulateRegions<vtkIdType>(points.data(), numPoints, tolerance, numRegions, connectivity,
+      numDuplicates, numDegeneracies);
+  }
+  this->NumberOfDuplicatePoints = static_cast<int>(numDuplicates);
+  this->NumberOfDegeneracies = static_cast<int>(numDegeneracies);
+
+  const vtkIdType numTetras = connectivity->GetNumberOfValues() / 4;
+  vtkIdTypeArray* offsets = vtkIdTypeArray::New();
+  offsets->SetNumberOfValues(numTetras + 1);
+  vtkSMPTools::For(0, numTetras + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType tetId = begin; tetId < end; ++tetId)
+    {
+      offsets->SetValue(tetId, 4 * tetId);
+    }
+  });
+  vtkCellArray* tetras = vtkCellArray::New();
+  tetras->SetData(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+  return tetras;
+}
+
 //--------------------------------------------------------------------------
 // This is a helper method used with InsertPoint() to create
 // tetrahedronalizations of points. Its purpose is construct an initial
@@ -1050,6 +2197,7 @@ void vtkDelaunay3D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Parallel Triangulation: " << (this->ParallelTriangulation ? "On\n" : "Off\n");
 
   if (this->Locator)
   {
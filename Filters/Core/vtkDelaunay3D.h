@@ -54,13 +54,29 @@
  * see a warning message to this effect at the end of the
  * triangulation process.
  *
+ * Large point sets are best triangulated with ParallelTriangulation on.
+ * The tetrahedra are then stored compactly in flat arrays with their face
+ * neighbors, and the points are inserted in a biased randomized order
+ * sorted along a Hilbert curve, so that each point is located by a short
+ * walk. The orientation and insphere tests are exact, and cospherical points
+ * are resolved by a symbolic perturbation, so the triangulation is valid
+ * whatever the input and its result does not depend on the insertion order.
+ * The points are also split into slabs along the x axis that are
+ * triangulated concurrently: the tetrahedra whose circumsphere lies within
+ * their slab are kept, and the points of the others are triangulated again
+ * to fill the seams between the slabs. In this mode the Tolerance is a
+ * fraction of the length of the input as documented, the bounding
+ * triangulation is a tetrahedron, and the Locator is not used.
+ *
  * @warning
  * Points arranged on a regular lattice (termed degenerate cases) can be
  * triangulated in more than one way (at least according to the Delaunay
  * criterion). The choice of triangulation (as implemented by
  * this algorithm) depends on the order of the input points. The first four
  * points will form a tetrahedron; other degenerate points (relative to this
- * initial tetrahedron) will not break it.
+ * initial tetrahedron) will not break it. With ParallelTriangulation on,
+ * the choice is made by the symbolic perturbation and does not depend on the
+ * order of the points.
  *
  * @warning
  * Points that are coincident (or nearly so) may be discarded by the
@@ -97,6 +113,7 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkUnstructuredGridAlgorithm.h"
 
+class vtkCellArray;
 class vtkIdList;
 class vtkPointLocator;
 class vtkPointSet;
@@ -197,6 +214,17 @@ public:
   vtkBooleanMacro(BoundingTriangulation, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the robust, parallel triangulation of the points (see the
+   * class documentation). It is only used when BoundingTriangulation is off.
+   * Off by default.
+   */
+  vtkSetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkGetMacro(ParallelTriangulation, vtkTypeBool);
+  vtkBooleanMacro(ParallelTriangulation, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Set / get a spatial locator for merging points. By default,
@@ -278,6 +306,7 @@ protected:
   vtkTypeBool BoundingTriangulation;
   double Offset;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelTriangulation;
 
   vtkIncrementalPointLocator* Locator; // help locate points faster
 
@@ -302,6 +331,8 @@ private:                    // members added for performance
   vtkIdList* Faces;         // used in InsertPoint
   vtkIdList* CheckedTetras; // used by InsertPoint
 
+  vtkCellArray* TriangulateInParallel(vtkPoints* inPoints, double center[3], double length);
+
 private:
   vtkDelaunay3D(const vtkDelaunay3D&) = delete;
   void operator=(const vtkDelaunay3D&) = delete;
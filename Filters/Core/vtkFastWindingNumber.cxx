@@ -0,0 +1,408 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFastWindingNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkFastWindingNumber.h"
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+vtkStandardNewMacro(vtkFastWindingNumber);
+vtkCxxSetObjectMacro(vtkFastWindingNumber, Surface, vtkPolyData);
+
+//----------------------------------------------------------------------------
+// The bounding volume hierarchy. The triangles are stored in the order of
+// the leaves, each node covering a contiguous range of triangles. The two
+// children of a node are consecutive, and are stored after their parent.
+struct vtkFastWindingNumberTree
+{
+  struct Node
+  {
+    double Center[3]; // area-weighted center of the triangles
+    double Normal[3]; // sum of the area-weighted normals of the triangles
+    double Area;      // total area of the triangles
+    double Radius;    // radius of the sphere about Center bounding the triangles
+    vtkIdType Start;  // range of triangles
+    vtkIdType End;
+    vtkIdType Child; // index of the first child, or -1 for a leaf
+  };
+
+  std::vector<double> Triangles; // 9 coordinates per triangle
+  std::vector<Node> Nodes;
+
+  void Build(std::vector<double>& triangles, int trianglesPerLeaf);
+  double Evaluate(const double x[3], double accuracy) const;
+};
+
+namespace
+{
+// Sum of the areas of the triangles, weighted by their centroids, and of
+// their area vectors (half the cross product of two edges).
+void AddTriangle(const double* tri, double center[3], double normal[3], double& area)
+{
+  double e1[3], e2[3], n[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    e1[i] = tri[3 + i] - tri[i];
+    e2[i] = tri[6 + i] - tri[i];
+  }
+  vtkMath::Cross(e1, e2, n);
+  const double a = 0.5 * vtkMath::Norm(n);
+  for (int i = 0; i < 3; ++i)
+  {
+    center[i] += a * (tri[i] + tri[3 + i] + tri[6 + i]) / 3.0;
+    normal[i] += 0.5 * n[i];
+  }
+  area += a;
+}
+
+// Signed solid angle of a triangle seen from x (Van Oosterom and Strackee).
+// It is positive when x is behind the triangle, i.e. when the triangle is
+// counterclockwise seen from the side its normal points to.
+double SolidAngle(const double* tri, const double x[3])
+{
+  double a[3], b[3], c[3], bc[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    a[i] = tri[i] - x[i];
+    b[i] = tri[3 + i] - x[i];
+    c[i] = tri[6 + i] - x[i];
+  }
+  const double la = vtkMath::Norm(a);
+  const double lb = vtkMath::Norm(b);
+  const double lc = vtkMath::Norm(c);
+  vtkMath::Cross(b, c, bc);
+  const double det = vtkMath::Dot(a, bc);
+  const double denom =
+    la * lb * lc + vtkMath::Dot(a, b) * lc + vtkMath::Dot(b, c) * la + vtkMath::Dot(c, a) * lb;
+  return 2.0 * atan2(det, denom);
+}
+}
+
+//----------------------------------------------------------------------------
+// Split the triangles at the median of their centroids along the longest
+// axis of the centroid bounds until the leaves are small enough, then
+// compute the dipoles of the nodes from the leaves up.
+void vtkFastWindingNumberTree::Build(std::vector<double>& triangles, int trianglesPerLeaf)
+{
+  const vtkIdType numTris = static_cast<vtkIdType>(triangles.size() / 9);
+  std::vector<double> centroids(3 * numTris);
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      const double* tri = triangles.data() + 9 * t;
+      for (int i = 0; i < 3; ++i)
+      {
+        centroids[3 * t + i] = (tri[i] + tri[3 + i] + tri[6 + i]) / 3.0;
+      }
+    }
+  });
+
+  std::vector<vtkIdType> order(numTris);
+  std::iota(order.begin(), order.end(), 0);
+  this->Nodes.clear();
+  this->Nodes.push_back(Node{ { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 0.0, 0.0, 0, numTris, -1 });
+  std::vector<vtkIdType> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkIdType nodeId = stack.back();
+    stack.pop_back();
+    const vtkIdType start = this->Nodes[nodeId].Start;
+    const vtkIdType end = this->Nodes[nodeId].End;
+    if (end - start <= trianglesPerLeaf)
+    {
+      continue;
+    }
+
+    double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN,
+      VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+    for (vtkIdType t = start; t < end; ++t)
+    {
+      const double* c = centroids.data() + 3 * order[t];
+      for (int i = 0; i < 3; ++i)
+      {
+        bounds[2 * i] = std::min(bounds[2 * i], c[i]);
+        bounds[2 * i + 1] = std::max(bounds[2 * i + 1], c[i]);
+      }
+    }
+    int axis = 0;
+    for (int i = 1; i < 3; ++i)
+    {
+      if (bounds[2 * i + 1] - bounds[2 * i] > bounds[2 * axis + 1] - bounds[2 * axis])
+      {
+        axis = i;
+      }
+    }
+    if (bounds[2 * axis + 1] <= bounds[2 * axis])
+    {
+      continue; // coincident centroids, keep them in a leaf
+    }
+
+    const vtkIdType mid = start + (end - start) / 2;
+    std::nth_element(order.begin() + start, order.begin() + mid, order.begin() + end,
+      [&centroids, axis](vtkIdType t0, vtkIdType t1) {
+        return centroids[3 * t0 + axis] < centroids[3 * t1 + axis];
+      });
+    const vtkIdType child = static_cast<vtkIdType>(this->Nodes.size());
+    this->Nodes[nodeId].Child = child;
+    this->Nodes.push_back(Node{ { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 0.0, 0.0, start, mid, -1 });
+    this->Nodes.push_back(Node{ { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, 0.0, 0.0, mid, end, -1 });
+    stack.push_back(child);
+    stack.push_back(child + 1);
+  }
+
+  // Store the triangles in the order of the leaves
+  this->Triangles.resize(triangles.size());
+  vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType t = begin; t < end; ++t)
+    {
+      std::copy(triangles.begin() + 9 * order[t], triangles.begin() + 9 * order[t] + 9,
+        this->Triangles.begin() + 9 * t);
+    }
+  });
+
+  // Children are stored after their parent: traverse the nodes backwards.
+  for (vtkIdType nodeId = static_cast<vtkIdType>(this->Nodes.size()) - 1; nodeId >= 0; --nodeId)
+  {
+    Node& node = this->Nodes[nodeId];
+    double* center = node.Center;
+    if (node.Child < 0)
+    {
+      for (vtkIdType t = node.Start; t < node.End; ++t)
+      {
+        AddTriangle(this->Triangles.data() + 9 * t, center, node.Normal, node.Area);
+      }
+    }
+    else
+    {
+      for (vtkIdType c = node.Child; c <= node.Child + 1; ++c)
+      {
+        const Node& child = this->Nodes[c];
+        for (int i = 0; i < 3; ++i)
+        {
+          center[i] += child.Area * child.Center[i];
+          node.Normal[i] += child.Normal[i];
+        }
+        node.Area += child.Area;
+      }
+    }
+
+    // Fall back on the average of the vertices for degenerate triangles
+    if (node.Area > 0.0)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        center[i] /= node.Area;
+      }
+    }
+    else
+    {
+      center[0] = center[1] = center[2] = 0.0;
+      for (vtkIdType t = node.Start; t < node.End; ++t)
+      {
+        for (int v = 0; v < 9; ++v)
+        {
+          center[v % 3] += this->Triangles[9 * t + v];
+        }
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        center[i] /= 3.0 * (node.End - node.Start);
+      }
+    }
+
+    if (node.Child < 0)
+    {
+      double radius2 = 0.0;
+      for (vtkIdType v = 3 * node.Start; v < 3 * node.End; ++v)
+      {
+        radius2 =
+          std::max(radius2, vtkMath::Distance2BetweenPoints(center, &this->Triangles[3 * v]));
+      }
+      node.Radius = sqrt(radius2);
+    }
+    else
+    {
+      for (vtkIdType c = node.Child; c <= node.Child + 1; ++c)
+      {
+        const Node& child = this->Nodes[c];
+        node.Radius = std::max(node.Radius,
+          sqrt(vtkMath::Distance2BetweenPoints(center, child.Center)) + child.Radius);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+double vtkFastWindingNumberTree::Evaluate(const double x[3], double accuracy) const
+{
+  if (this->Nodes.empty())
+  {
+    return 0.0;
+  }
+
+  // The tree is balanced, so its depth is at most 64 and so is the number
+  // of nodes waiting on the stack.
+  vtkIdType stack[128];
+  int top = 0;
+  stack[top++] = 0;
+  const double accuracy2 = accuracy * accuracy;
+  double solidAngle = 0.0;
+  while (top > 0)
+  {
+    const Node& node = this->Nodes[stack[--top]];
+    double d[3] = { node.Center[0] - x[0], node.Center[1] - x[1], node.Center[2] - x[2] };
+    const double dist2 = vtkMath::Dot(d, d);
+    if (dist2 > accuracy2 * node.Radius * node.Radius)
+    {
+      // Far field: the solid angle of a dipole
+      solidAngle += vtkMath::Dot(d, node.Normal) / (dist2 * sqrt(dist2));
+    }
+    else if (node.Child < 0)
+    {
+      for (vtkIdType t = node.Start; t < node.End; ++t)
+      {
+        solidAngle += SolidAngle(this->Triangles.data() + 9 * t, x);
+      }
+    }
+    else
+    {
+      stack[top++] = node.Child;
+      stack[top++] = node.Child + 1;
+    }
+  }
+  return solidAngle / (4.0 * vtkMath::Pi());
+}
+
+//----------------------------------------------------------------------------
+vtkFastWindingNumber::vtkFastWindingNumber()
+{
+  this->Surface = nullptr;
+  this->Accuracy = 2.0;
+  this->NumberOfTrianglesPerLeaf = 8;
+  this->Tree = nullptr;
+}
+
+//----------------------------------------------------------------------------
+vtkFastWindingNumber::~vtkFastWindingNumber()
+{
+  this->SetSurface(nullptr);
+  this->FreeTree();
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::FreeTree()
+{
+  delete this->Tree;
+  this->Tree = nullptr;
+}
+
+//----------------------------------------------------------------------------
+// Triangulate the polygons as fans and the triangle strips, keeping the
+// orientation of the cells.
+void vtkFastWindingNumber::BuildTree()
+{
+  if (this->Tree && this->Surface && this->BuildTime > this->GetMTime() &&
+    this->BuildTime > this->Surface->GetMTime())
+  {
+    return;
+  }
+
+  this->FreeTree();
+  this->Tree = new vtkFastWindingNumberTree;
+  this->BuildTime.Modified();
+  if (!this->Surface || !this->Surface->GetPoints())
+  {
+    return;
+  }
+
+  vtkPoints* points = this->Surface->GetPoints();
+  std::vector<double> triangles;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = this->Surface->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 1; i + 1 < npts; ++i)
+    {
+      const vtkIdType tri[3] = { pts[0], pts[i], pts[i + 1] };
+      for (int v = 0; v < 3; ++v)
+      {
+        const double* x = points->GetPoint(tri[v]);
+        triangles.insert(triangles.end(), x, x + 3);
+      }
+    }
+  }
+  vtkCellArray* strips = this->Surface->GetStrips();
+  for (strips->InitTraversal(); strips->GetNextCell(npts, pts);)
+  {
+    for (vtkIdType i = 0; i + 2 < npts; ++i)
+    {
+      const vtkIdType tri[3] = { pts[i % 2 ? i + 1 : i], pts[i % 2 ? i : i + 1], pts[i + 2] };
+      for (int v = 0; v < 3; ++v)
+      {
+        const double* x = points->GetPoint(tri[v]);
+        triangles.insert(triangles.end(), x, x + 3);
+      }
+    }
+  }
+
+  this->Tree->Build(triangles, this->NumberOfTrianglesPerLeaf);
+}
+
+//----------------------------------------------------------------------------
+double vtkFastWindingNumber::EvaluateWindingNumber(const double x[3])
+{
+  this->BuildTree();
+  return this->Tree->Evaluate(x, this->Accuracy);
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::EvaluateWindingNumbers(vtkPoints* points, vtkDoubleArray* windingNumbers)
+{
+  this->BuildTree();
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  windingNumbers->SetNumberOfComponents(1);
+  windingNumbers->SetNumberOfTuples(numPts);
+  double* values = windingNumbers->GetPointer(0);
+  const vtkFastWindingNumberTree* tree = this->Tree;
+  const double accuracy = this->Accuracy;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    double x[3];
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      points->GetPoint(i, x);
+      values[i] = tree->Evaluate(x, accuracy);
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+void vtkFastWindingNumber::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Surface: " << this->Surface << "\n";
+  os << indent << "Accuracy: " << this->Accuracy << "\n";
+  os << indent << "Number Of Triangles Per Leaf: " << this->NumberOfTrianglesPerLeaf << "\n";
+}
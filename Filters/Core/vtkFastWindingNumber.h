@@ -0,0 +1,143 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkFastWindingNumber.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkFastWindingNumber
+ * @brief   evaluate the generalized winding number of a polygonal surface
+ *
+ * vtkFastWindingNumber computes the generalized winding number of a
+ * surface at arbitrary points: the sum of the signed solid angles of the
+ * polygons of the surface seen from the point, divided by 4*pi. For a
+ * closed, consistently oriented surface the winding number is 1 inside and 0
+ * outside (-1 inside if the polygons are oriented inwards). Unlike ray
+ * casting, the winding number varies smoothly when the surface has small
+ * holes, gaps or overlaps, so thresholding its magnitude at 0.5 gives a
+ * robust inside/outside classification of imperfect surfaces.
+ *
+ * The polygons and triangle strips of the surface are triangulated and
+ * organized in a bounding volume hierarchy. Each node of the hierarchy
+ * stores the sum of the area-weighted normals of its triangles, and is
+ * approximated by a dipole at its area-weighted center when the point is
+ * far enough from the node (see Accuracy). Near the point, the exact solid
+ * angles of the triangles are summed. Evaluating a point thus costs
+ * O(log n) rather than O(n) for a surface of n triangles. See Barill et
+ * al., "Fast Winding Numbers for Soups and Clouds", ACM Transactions on
+ * Graphics 37(4), 2018.
+ *
+ * The hierarchy is built by BuildTree(), and rebuilt only when the surface
+ * or this object has been modified since, so that it can be reused across
+ * many evaluations. Once built, EvaluateWindingNumber() is thread safe, and
+ * EvaluateWindingNumbers() processes a set of points in parallel with
+ * vtkSMPTools.
+ *
+ * @sa
+ * vtkSelectEnclosedPoints vtkExtractEnclosedPoints vtkBooleanOperationPolyDataFilter
+ * vtkImplicitPolyDataDistance
+ */
+
+#ifndef vtkFastWindingNumber_h
+#define vtkFastWindingNumber_h
+
+#include "vtkFiltersCoreModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDoubleArray;
+class vtkPoints;
+class vtkPolyData;
+struct vtkFastWindingNumberTree;
+
+class VTKFILTERSCORE_EXPORT vtkFastWindingNumber : public vtkObject
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type information.
+   */
+  static vtkFastWindingNumber* New();
+  vtkTypeMacro(vtkFastWindingNumber, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the surface. Its polygons and triangle strips are used; its
+   * vertices and lines are ignored.
+   */
+  virtual void SetSurface(vtkPolyData*);
+  vtkGetObjectMacro(Surface, vtkPolyData);
+  //@}
+
+  //@{
+  /**
+   * A node of the hierarchy is approximated by its dipole when the distance
+   * from the evaluation point to the center of the node exceeds Accuracy
+   * times the radius of the node. Larger values are more accurate and
+   * slower. Defaults to 2, for which the error on the winding number is
+   * typically a few hundredths, well below the 0.5 classification threshold.
+   */
+  vtkSetClampMacro(Accuracy, double, 1.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Accuracy, double);
+  //@}
+
+  //@{
+  /**
+   * Specify the maximum number of triangles in a leaf of the hierarchy.
+   * Defaults to 8.
+   */
+  vtkSetClampMacro(NumberOfTrianglesPerLeaf, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfTrianglesPerLeaf, int);
+  //@}
+
+  /**
+   * Build the hierarchy if the surface or this object has been modified
+   * since it was last built. It is built implicitly by
+   * EvaluateWindingNumbers(), but must be built before calling
+   * EvaluateWindingNumber() from several threads.
+   */
+  void BuildTree();
+
+  /**
+   * Release the memory used by the hierarchy.
+   */
+  void FreeTree();
+
+  /**
+   * Return the winding number of the surface at x. This method builds the
+   * hierarchy if needed, and is thread safe once it has been built.
+   */
+  double EvaluateWindingNumber(const double x[3]);
+
+  /**
+   * Evaluate the winding number at each point, in parallel. On return,
+   * windingNumbers has a value per point.
+   */
+  void EvaluateWindingNumbers(vtkPoints* points, vtkDoubleArray* windingNumbers);
+
+protected:
+  vtkFastWindingNumber();
+  ~vtkFastWindingNumber() override;
+
+  vtkPolyData* Surface;
+  double Accuracy;
+  int NumberOfTrianglesPerLeaf;
+
+  vtkFastWindingNumberTree* Tree;
+  vtkTimeStamp BuildTime;
+
+private:
+  vtkFastWindingNumber(const vtkFastWindingNumber&) = delete;
+  void operator=(const vtkFastWindingNumber&) = delete;
+};
+
+#endif
@@ -17,21 +17,340 @@
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
+#include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkFeatureEdges);
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// The filter works on the input polygons followed by the triangles of the
+// input strips. This maps them back to input cell ids.
+struct PolyCellIds
+{
+  vtkIdType FirstPolyId;
+  vtkIdType NumberOfPolys;
+  std::vector<vtkIdType> StripCellIds;
+
+  vtkIdType operator()(vtkIdType polyId) const
+  {
+    return (polyId < this->NumberOfPolys ? this->FirstPolyId + polyId
+                                         : this->StripCellIds[polyId - this->NumberOfPolys]);
+  }
+};
+
+// The values of the "Edge Types" scalars for boundary, non-manifold, feature
+// and manifold edges.
+const double EdgeTypeScalars[4] = { 0.0, 0.222222, 0.444444, 0.666667 };
+
+//----------------------------------------------------------------------------
+// An edge use is an edge of a polygon. Its data is the polygon id, stored as
+// -polyId-1 when the edge runs from the larger to the smaller point id. The
+// EId is the position of the use in the polygon connectivity, which makes
+// the output independent of the sort and of the number of threads.
+template <typename TId>
+using EdgeUse = MergeTuple<TId, TId>;
+
+template <typename TId>
+vtkIdType GetPolyId(const EdgeUse<TId>& use)
+{
+  return (use.T >= 0 ? use.T : -use.T - 1);
+}
+
+// Gather the edge uses of the polygons and, if requested, their normals.
+template <typename TId>
+struct GenerateEdgeUses
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkPoints* points, EdgeUse<TId>* uses, float* normals)
+  {
+    vtkSMPTools::For(0, state.GetNumberOfCells(), [&](vtkIdType polyId, vtkIdType endPolyId) {
+      std::vector<vtkIdType> pts;
+      double n[3];
+      for (; polyId < endPolyId; ++polyId)
+      {
+        const auto cellPts = state.GetCellRange(polyId);
+        pts.assign(cellPts.begin(), cellPts.end());
+        const vtkIdType npts = static_cast<vtkIdType>(pts.size());
+        const vtkIdType offset = state.GetBeginOffset(polyId);
+        for (vtkIdType i = 0; i < npts; ++i)
+        {
+          const vtkIdType p0 = pts[i];
+          const vtkIdType p1 = pts[(i + 1) % npts];
+          const vtkIdType data = (p0 <= p1 ? polyId : -polyId - 1);
+          uses[offset + i] = EdgeUse<TId>(static_cast<TId>(p0), static_cast<TId>(p1),
+            static_cast<TId>(offset + i), static_cast<TId>(data));
+        }
+        if (normals)
+        {
+          vtkPolygon::ComputeNormal(points, static_cast<int>(npts), pts.data(), n);
+          normals[3 * polyId] = static_cast<float>(n[0]);
+          normals[3 * polyId + 1] = static_cast<float>(n[1]);
+          normals[3 * polyId + 2] = static_cast<float>(n[2]);
+        }
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+// Classify the uses of each unique edge. The neighbors of a use are the other
+// polygons using the same edge. As in the serial traversal, an edge used by
+// one polygon is a boundary edge, and an edge used by more polygons is output
+// by its polygon with the smallest id only. Output uses are recorded at
+// their position in the polygon connectivity, with their edge type.
+template <typename TId>
+struct ClassifyEdges
+{
+  const EdgeUse<TId>* Uses;
+  const TId* Groups;
+  const float* Normals;
+  double CosAngle;
+  bool BoundaryEdges;
+  bool NonManifoldEdges;
+  bool FeatureEdges;
+  bool ManifoldEdges;
+  const unsigned char* Ghosts;
+  const PolyCellIds& CellIds;
+  TId* OutputUses;
+  unsigned char* Types;
+
+  ClassifyEdges(vtkFeatureEdges* self, const EdgeUse<TId>* uses, const TId* groups,
+    const float* normals, const unsigned char* ghosts, const PolyCellIds& cellIds,
+    TId* outputUses, unsigned char* types)
+    : Uses(uses)
+    , Groups(groups)
+    , Normals(normals)
+    , Ghosts(ghosts)
+    , CellIds(cellIds)
+    , OutputUses(outputUses)
+    , Types(types)
+  {
+    this->CosAngle = cos(vtkMath::RadiansFromDegrees(self->GetFeatureAngle()));
+    this->BoundaryEdges = self->GetBoundaryEdges();
+    this->NonManifoldEdges = self->GetNonManifoldEdges();
+    this->FeatureEdges = self->GetFeatureEdges();
+    this->ManifoldEdges = self->GetManifoldEdges();
+  }
+
+  void operator()(vtkIdType group, vtkIdType endGroup)
+  {
+    std::vector<vtkIdType> polys;
+    for (; group < endGroup; ++group)
+    {
+      const TId begin = this->Groups[group];
+      const TId end = this->Groups[group + 1];
+      polys.clear();
+      for (TId i = begin; i < end; ++i)
+      {
+        polys.push_back(GetPolyId(this->Uses[i]));
+      }
+      std::sort(polys.begin(), polys.end());
+      polys.erase(std::unique(polys.begin(), polys.end()), polys.end());
+      const vtkIdType numNei = static_cast<vtkIdType>(polys.size()) - 1;
+
+      for (TId i = begin; i < end; ++i)
+      {
+        const vtkIdType polyId = GetPolyId(this->Uses[i]);
+        // Smallest neighbor, which is the only one of a manifold edge
+        const vtkIdType nei = (numNei < 1 ? -1 : (polys[0] != polyId ? polys[0] : polys[1]));
+        int type = -1;
+        if (this->BoundaryEdges && numNei < 1)
+        {
+          type = 0;
+        }
+        else if (this->NonManifoldEdges && numNei > 1)
+        {
+          type = (nei > polyId ? 1 : -1);
+        }
+        else if (this->FeatureEdges && numNei == 1 && nei > polyId)
+        {
+          const double neiNormal[3] = { this->Normals[3 * nei], this->Normals[3 * nei + 1],
+            this->Normals[3 * nei + 2] };
+          const double polyNormal[3] = { this->Normals[3 * polyId],
+            this->Normals[3 * polyId + 1], this->Normals[3 * polyId + 2] };
+          type = (vtkMath::Dot(neiNormal, polyNormal) <= this->CosAngle ? 2 : -1);
+        }
+        else if (this->ManifoldEdges && numNei == 1 && nei > polyId)
+        {
+          type = 3;
+        }
+
+        if (type >= 0 &&
+          !(this->Ghosts &&
+            this->Ghosts[this->CellIds(polyId)] & vtkDataSetAttributes::DUPLICATECELL))
+        {
+          this->OutputUses[this->Uses[i].EId] = i;
+          this->Types[i] = static_cast<unsigned char>(type);
+        }
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Extract the edges with vtkStaticEdgeLocatorTemplate. The edges are output
+// in the order of the serial traversal of the polygons, each one with the
+// point order and the cell data of its output use. The mergeMap gives the
+// first of the points sharing the coordinates of each point; output points
+// are numbered in the order they are first used by the output edges.
+template <typename TId>
+void ExtractFeatureEdges(vtkFeatureEdges* self, vtkPolyData* input, vtkCellArray* polys,
+  const PolyCellIds& cellIds, const unsigned char* ghosts, const vtkIdType* mergeMap,
+  vtkPoints* newPts, vtkPolyData* output)
+{
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numUses = polys->GetNumberOfConnectivityIds();
+
+  std::vector<EdgeUse<TId> > uses(numUses);
+  std::vector<float> normals;
+  if (self->GetFeatureEdges())
+  {
+    normals.resize(3 * polys->GetNumberOfCells());
+  }
+  polys->Visit(GenerateEdgeUses<TId>{}, inPts, uses.data(),
+    (normals.empty() ? nullptr : normals.data()));
+  self->UpdateProgress(0.3);
+
+  vtkIdType numEdges = 0;
+  const TId* groups = nullptr;
+  vtkStaticEdgeLocatorTemplate<TId, TId> locator;
+  if (numUses > 0)
+  {
+    groups = locator.MergeEdges(numUses, uses.data(), numEdges);
+  }
+
+  std::vector<TId> outputUses(numUses, -1);
+  std::vector<unsigned char> types(numUses);
+  ClassifyEdges<TId> classify(self, uses.data(), groups,
+    (normals.empty() ? nullptr : normals.data()), ghosts, cellIds, outputUses.data(),
+    types.data());
+  vtkSMPTools::For(0, numEdges, classify);
+  self->UpdateProgress(0.7);
+
+  // Order the output edges and number their points as they are first used.
+  std::vector<TId> edges;
+  vtkIdType numEdgesOfType[4] = { 0, 0, 0, 0 };
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkNew<vtkIdList> srcPtIds;
+  for (const TId use : outputUses)
+  {
+    if (use >= 0)
+    {
+      edges.push_back(use);
+      numEdgesOfType[types[use]]++;
+      const vtkIdType p0 = (uses[use].T >= 0 ? uses[use].V0 : uses[use].V1);
+      const vtkIdType p1 = (uses[use].T >= 0 ? uses[use].V1 : uses[use].V0);
+      vtkIdType& newPt0 = pointMap[mergeMap[p0]];
+      if (newPt0 < 0)
+      {
+        newPt0 = srcPtIds->InsertNextId(p0);
+      }
+      vtkIdType& newPt1 = pointMap[mergeMap[p1]];
+      if (newPt1 < 0)
+      {
+        newPt1 = srcPtIds->InsertNextId(p1);
+      }
+    }
+  }
+  const vtkIdType numNewPts = srcPtIds->GetNumberOfIds();
+  const vtkIdType numNewLines = static_cast<vtkIdType>(edges.size());
+
+  // Produce the output points, lines and attributes.
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      inPts->GetPoint(srcPtIds->GetId(ptId), x);
+      newPts->SetPoint(ptId, x);
+    }
+  });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numNewLines + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(2 * numNewLines);
+  vtkNew<vtkIdList> srcCellIds;
+  srcCellIds->SetNumberOfIds(numNewLines);
+  vtkNew<vtkFloatArray> newScalars;
+  newScalars->SetName("Edge Types");
+  newScalars->SetNumberOfValues(self->GetColoring() ? numNewLines : 0);
+  vtkIdType* offs = offsets->GetPointer(0);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  offs[numNewLines] = 2 * numNewLines;
+  vtkSMPTools::For(0, numNewLines, [&](vtkIdType lineId, vtkIdType endLineId) {
+    for (; lineId < endLineId; ++lineId)
+    {
+      const TId use = edges[lineId];
+      const vtkIdType p0 = (uses[use].T >= 0 ? uses[use].V0 : uses[use].V1);
+      const vtkIdType p1 = (uses[use].T >= 0 ? uses[use].V1 : uses[use].V0);
+      offs[lineId] = 2 * lineId;
+      conn[2 * lineId] = pointMap[mergeMap[p0]];
+      conn[2 * lineId + 1] = pointMap[mergeMap[p1]];
+      srcCellIds->SetId(lineId, cellIds(GetPolyId(uses[use])));
+      if (newScalars->GetNumberOfValues() > 0)
+      {
+        newScalars->SetValue(lineId, static_cast<float>(EdgeTypeScalars[types[use]]));
+      }
+    }
+  });
+  vtkNew<vtkCellArray> newLines;
+  newLines->SetData(offsets, connectivity);
+
+  vtkNew<vtkIdList> dstPtIds;
+  dstPtIds->SetNumberOfIds(numNewPts);
+  std::iota(dstPtIds->GetPointer(0), dstPtIds->GetPointer(0) + numNewPts, 0);
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(input->GetPointData(), numNewPts);
+  outPD->CopyData(input->GetPointData(), srcPtIds, dstPtIds);
+
+  vtkNew<vtkIdList> dstCellIds;
+  dstCellIds->SetNumberOfIds(numNewLines);
+  std::iota(dstCellIds->GetPointer(0), dstCellIds->GetPointer(0) + numNewLines, 0);
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(input->GetCellData(), numNewLines);
+  outCD->CopyData(input->GetCellData(), srcCellIds, dstCellIds);
+
+  vtkDebugWithObjectMacro(self, << "Created " << numEdgesOfType[0] << " boundary edges, "
+                                << numEdgesOfType[1] << " non-manifold edges, "
+                                << numEdgesOfType[2] << " feature edges, " << numEdgesOfType[3]
+                                << " manifold edges");
+
+  output->SetPoints(newPts);
+  output->SetLines(newLines);
+  if (self->GetColoring())
+  {
+    int idx = outCD->AddArray(newScalars);
+    outCD->SetActiveAttribute(idx, vtkDataSetAttributes::SCALARS);
+  }
+}
+
+} // anonymous namespace
+
 //----------------------------------------------------------------------------
 // Construct object with feature angle = 30; all types of edges, except
 // manifold edges, are extracted and colored.
@@ -126,6 +445,9 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Build cell structure.  Might have to triangulate the strips.
+  PolyCellIds polyCellIds;
+  polyCellIds.FirstPolyId = input->GetNumberOfVerts() + input->GetNumberOfLines();
+  polyCellIds.NumberOfPolys = numPolys;
   Mesh = vtkPolyData::New();
   Mesh->SetPoints(inPts);
   inPolys = input->GetPolys();
@@ -141,9 +463,12 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       newPolys->AllocateEstimate(numStrips, 5);
     }
     inStrips = input->GetStrips();
-    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts);)
+    cellId = polyCellIds.FirstPolyId + numPolys;
+    for (inStrips->InitTraversal(); inStrips->GetNextCell(npts, pts); cellId++)
     {
       vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
+      polyCellIds.StripCellIds.insert(
+        polyCellIds.StripCellIds.end(), std::max<vtkIdType>(npts - 2, 0), cellId);
     }
     Mesh->SetPolys(newPolys);
     newPolys->Delete();
@@ -153,10 +478,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     newPolys = inPolys;
     Mesh->SetPolys(newPolys);
   }
-  Mesh->BuildLinks();
 
-  // Allocate storage for lines/points (arbitrary allocation sizes)
-  //
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -173,6 +495,34 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
+  // Without a locator, the edges are classified by sorting the edge uses in
+  // parallel, and coincident points are merged with a static locator.
+  if (this->Locator == nullptr)
+  {
+    std::vector<vtkIdType> mergeMap(numPts);
+    vtkNew<vtkStaticPointLocator> pointLocator;
+    pointLocator->SetDataSet(input);
+    pointLocator->BuildLocator();
+    pointLocator->MergePoints(0.0, mergeMap.data());
+
+    if (numPts < VTK_INT_MAX && newPolys->GetNumberOfConnectivityIds() < VTK_INT_MAX)
+    {
+      ExtractFeatureEdges<int>(
+        this, input, newPolys, polyCellIds, ghosts, mergeMap.data(), newPts, output);
+    }
+    else
+    {
+      ExtractFeatureEdges<vtkIdType>(
+        this, input, newPolys, polyCellIds, ghosts, mergeMap.data(), newPts, output);
+    }
+    newPts->Delete();
+    Mesh->Delete();
+    return 1;
+  }
+
+  // Allocate storage for lines/points (arbitrary allocation sizes)
+  //
+  Mesh->BuildLinks();
   newPts->Allocate(numPts / 10, numPts);
   newLines = vtkCellArray::New();
   newLines->AllocateEstimate(numPts / 20, 2);
@@ -186,12 +536,8 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   outPD->CopyAllocate(pd, numPts);
   outCD->CopyAllocate(cd, numCells);
 
-  // Get our locator for merging points
+  // Merge points with the locator
   //
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
   this->Locator->InitPointInsertion(newPts, input->GetBounds());
 
   // Loop over all polygons generating boundary, non-manifold,
@@ -237,7 +583,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
 
       if (this->BoundaryEdges && numNei < 1)
       {
-        if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
+        if (ghosts && ghosts[polyCellIds(cellId)] & vtkDataSetAttributes::DUPLICATECELL)
         {
           continue;
         }
@@ -260,7 +606,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
         }
         if (j >= numNei)
         {
-          if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
+          if (ghosts && ghosts[polyCellIds(cellId)] & vtkDataSetAttributes::DUPLICATECELL)
           {
             continue;
           }
@@ -283,7 +629,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
         polyNormals->GetTuple(cellId, cellTuple);
         if (vtkMath::Dot(neiTuple, cellTuple) <= cosAngle)
         {
-          if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
+          if (ghosts && ghosts[polyCellIds(cellId)] & vtkDataSetAttributes::DUPLICATECELL)
           {
             continue;
           }
@@ -300,7 +646,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       }
       else if (this->ManifoldEdges && numNei == 1 && neighbors->GetId(0) > cellId)
       {
-        if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
+        if (ghosts && ghosts[polyCellIds(cellId)] & vtkDataSetAttributes::DUPLICATECELL)
         {
           continue;
         }
@@ -330,7 +676,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       }
 
       newId = newLines->InsertNextCell(2, lineIds);
-      outCD->CopyData(cd, cellId, newId);
+      outCD->CopyData(cd, polyCellIds(cellId), newId);
       if (this->Coloring)
       {
         newScalars->InsertTuple(newId, &scalar);
@@ -27,11 +27,31 @@
  * based on edge type. The cell coloring is assigned to the cell data of
  * the extracted edges.
  *
+ * Edges are output in the order the polygons use them, followed by the
+ * triangles of the triangle strips. Coincident points are merged.
+ *
  * @warning
  * To see the coloring of the lines you may have to set the ScalarMode
  * instance variable of the mapper to SetScalarModeToUseCellData(). (This
  * is only a problem if there are point data scalars.)
  *
+ * @warning
+ * By default, the polygons sharing each edge are found by sorting the edge
+ * uses with vtkStaticEdgeLocatorTemplate, and the output does not depend on
+ * the number of threads. When a locator is specified, the edges are
+ * extracted serially and the points are merged with the locator. This class
+ * has been threaded with vtkSMPTools. Using TBB or other non-sequential type
+ * (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve
+ * performance significantly.
+ *
+ * @warning
+ * There is no streaming mode that outputs the edges in chunks. The
+ * polygons sharing an edge are only known once all the edge uses have been
+ * sorted, so the whole input is processed at once. Large inputs can instead
+ * be streamed as pieces through the pipeline: each piece is requested with
+ * one more ghost level so that its edges are classified as in the whole
+ * mesh.
+ *
  * @sa
  * vtkExtractEdges
  */
@@ -126,15 +146,17 @@ public:
 
   //@{
   /**
-   * Set / get a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Set / get a spatial locator for merging points. By default no locator
+   * is used, and exactly coincident points are merged in parallel.
+   * Specifying a locator uses the serial algorithm.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
   //@}
 
   /**
-   * Create default locator. Used to create one when none is specified.
+   * Create default locator, an instance of vtkMergePoints. This selects
+   * the serial algorithm.
    */
   void CreateDefaultLocator();
 
@@ -15,17 +15,23 @@
 #include "vtkGlyph3D.h"
 
 #include "vtkCell.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMath.h"
+#include "vtkMatrix4x4.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
@@ -33,9 +39,127 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 vtkStandardNewMacro(vtkGlyph3D);
 vtkCxxSetObjectMacro(vtkGlyph3D, SourceTransform, vtkTransform);
 
+namespace
+{
+// The geometry of a source, copied to each of its glyphs. The points, with
+// the source transform applied, and the normals are kept in double precision
+// since the glyph transform is applied in double precision.
+struct vtkGlyphSource
+{
+  vtkPolyData* Source = nullptr;
+  vtkIdType NumberOfPoints = 0;
+  vtkIdType NumberOfCells = 0;
+  vtkIdType ConnectivitySize = 0;
+  std::vector<double> Points;
+  std::vector<double> Normals;
+  std::vector<vtkIdType> CellOffsets;  // when the source has a single kind of cells
+  std::vector<vtkIdType> Connectivity; // idem
+};
+
+// Cache the geometry of a source. Return the kinds of cells of the source,
+// as a bit mask of verts (1), lines (2), polys (4) and strips (8).
+int vtkPrepareGlyphSource(vtkGlyphSource& glyph, vtkTransform* sourceTransform, bool normals)
+{
+  vtkPolyData* source = glyph.Source;
+  vtkPoints* sourcePts = source->GetPoints();
+  glyph.NumberOfPoints = (sourcePts ? sourcePts->GetNumberOfPoints() : 0);
+  glyph.NumberOfCells = source->GetNumberOfCells();
+
+  vtkNew<vtkPoints> transformedSourcePts;
+  if (sourceTransform && sourcePts)
+  {
+    transformedSourcePts->SetDataTypeToDouble();
+    sourceTransform->TransformPoints(sourcePts, transformedSourcePts);
+    sourcePts = transformedSourcePts;
+  }
+  glyph.Points.resize(3 * glyph.NumberOfPoints);
+  for (vtkIdType i = 0; i < glyph.NumberOfPoints; i++)
+  {
+    sourcePts->GetPoint(i, glyph.Points.data() + 3 * i);
+  }
+  if (normals)
+  {
+    vtkDataArray* sourceNormals = source->GetPointData()->GetNormals();
+    glyph.Normals.resize(3 * glyph.NumberOfPoints);
+    for (vtkIdType i = 0; i < glyph.NumberOfPoints; i++)
+    {
+      sourceNormals->GetTuple(i, glyph.Normals.data() + 3 * i);
+    }
+  }
+
+  vtkCellArray* cells[4] = { source->GetVerts(), source->GetLines(), source->GetPolys(),
+    source->GetStrips() };
+  int kinds = 0;
+  for (int k = 0; k < 4; k++)
+  {
+    kinds |= (cells[k]->GetNumberOfCells() > 0 ? (1 << k) : 0);
+  }
+  if (kinds == 0 || (kinds & (kinds - 1)))
+  {
+    return kinds;
+  }
+
+  // A single kind of cells: copy their offsets and connectivity
+  vtkCellArray* kindCells = cells[kinds == 1 ? 0 : (kinds == 2 ? 1 : (kinds == 4 ? 2 : 3))];
+  glyph.ConnectivitySize = kindCells->GetNumberOfConnectivityIds();
+  glyph.CellOffsets.resize(glyph.NumberOfCells);
+  glyph.Connectivity.resize(glyph.ConnectivitySize);
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType connId = 0;
+  for (vtkIdType cellId = 0; cellId < glyph.NumberOfCells; cellId++)
+  {
+    kindCells->GetCellAtId(cellId, npts, pts);
+    glyph.CellOffsets[cellId] = connId;
+    std::copy(pts, pts + npts, glyph.Connectivity.data() + connId);
+    connId += npts;
+  }
+  return kinds;
+}
+
+// Same as vtkLinearTransform::TransformPoints()
+template <typename T>
+void vtkGlyphTransformPoints(const double (*matrix)[4], const double* in, vtkIdType n, T* out)
+{
+  for (vtkIdType i = 0; i < n; i++, in += 3, out += 3)
+  {
+    out[0] = static_cast<T>(
+      matrix[0][0] * in[0] + matrix[0][1] * in[1] + matrix[0][2] * in[2] + matrix[0][3]);
+    out[1] = static_cast<T>(
+      matrix[1][0] * in[0] + matrix[1][1] * in[1] + matrix[1][2] * in[2] + matrix[1][3]);
+    out[2] = static_cast<T>(
+      matrix[2][0] * in[0] + matrix[2][1] * in[1] + matrix[2][2] * in[2] + matrix[2][3]);
+  }
+}
+
+// Same as vtkLinearTransform::TransformNormals(): multiply by the transposed
+// inverse matrix and normalize.
+void vtkGlyphTransformNormals(const double (*matrix)[4], const double* in, vtkIdType n, float* out)
+{
+  double normalMatrix[4][4];
+  std::copy(*matrix, *matrix + 16, *normalMatrix);
+  vtkMatrix4x4::Invert(*normalMatrix, *normalMatrix);
+  vtkMatrix4x4::Transpose(*normalMatrix, *normalMatrix);
+  for (vtkIdType i = 0; i < n; i++, in += 3, out += 3)
+  {
+    out[0] = static_cast<float>(
+      normalMatrix[0][0] * in[0] + normalMatrix[0][1] * in[1] + normalMatrix[0][2] * in[2]);
+    out[1] = static_cast<float>(
+      normalMatrix[1][0] * in[0] + normalMatrix[1][1] * in[1] + normalMatrix[1][2] * in[2]);
+    out[2] = static_cast<float>(
+      normalMatrix[2][0] * in[0] + normalMatrix[2][1] * in[1] + normalMatrix[2][2] * in[2]);
+    vtkMath::Normalize(out);
+  }
+}
+}
+
 //----------------------------------------------------------------------------
 // Construct object with scaling on, scaling mode is by scalar value,
 // scale factor = 1.0, the range is (0,1), orient geometry is on, and
@@ -58,6 +182,7 @@ vtkGlyph3D::vtkGlyph3D()
   this->SetPointIdsName("InputPointIds");
   this->SetNumberOfInputPorts(2);
   this->FillCellData = 0;
+  this->GenerateInstances = 0;
   this->SourceTransform = nullptr;
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
@@ -131,40 +256,27 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   vtkPointData* pd;
   vtkDataArray* inCScalars; // Scalars for Coloring
   unsigned char* inGhostLevels = nullptr;
-  vtkDataArray *inNormals, *sourceNormals = nullptr;
+  vtkDataArray* inNormals;
+  vtkDataArray* array3D = nullptr; // Vectors or normals orienting the glyphs
   vtkDataArray* sourceTCoords = nullptr;
-  vtkIdType numPts, numSourcePts, numSourceCells, inPtId, i;
-  vtkPoints* sourcePts = nullptr;
-  vtkSmartPointer<vtkPoints> transformedSourcePts = vtkSmartPointer<vtkPoints>::New();
+  vtkIdType numPts, inPtId;
   vtkPoints* newPts;
   vtkDataArray* newScalars = nullptr;
-  vtkDataArray* newVectors = nullptr;
-  vtkDataArray* newNormals = nullptr;
-  vtkDataArray* newTCoords = nullptr;
-  double x[3], v[3], vNew[3], s = 0.0, vMag = 0.0, value, tc[3];
-  vtkTransform* trans = vtkTransform::New();
-  vtkNew<vtkIdList> pointIdList;
-  vtkIdList* cellPts;
-  int npts;
-  vtkIdList* pts;
-  vtkIdType ptIncr, cellIncr, cellId;
+  vtkFloatArray* newVectors = nullptr;
+  vtkFloatArray* newNormals = nullptr;
+  vtkFloatArray* newTCoords = nullptr;
+  vtkDoubleArray* newTransforms = nullptr;
+  vtkIntArray* newSourceIndices = nullptr;
   int haveVectors, haveNormals, haveTCoords = 0;
-  double scalex, scaley, scalez, den;
+  double den;
   vtkPointData* outputPD = output->GetPointData();
   vtkCellData* outputCD = output->GetCellData();
   int numberOfSources = this->GetNumberOfInputConnections(1);
   vtkIdTypeArray* pointIds = nullptr;
   vtkSmartPointer<vtkPolyData> source = this->GetSource(0, sourceVector);
-  vtkNew<vtkIdList> srcPointIdList;
-  vtkNew<vtkIdList> dstPointIdList;
-  vtkNew<vtkIdList> srcCellIdList;
-  vtkNew<vtkIdList> dstCellIdList;
 
   vtkDebugMacro(<< "Generating glyphs");
 
-  pts = vtkIdList::New();
-  pts->Allocate(VTK_CELL_SIZE);
-
   pd = input->GetPointData();
   inNormals = this->GetInputArrayToProcess(2, input);
   inCScalars = this->GetInputArrayToProcess(3, input);
@@ -191,8 +303,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   if (numPts < 1)
   {
     vtkDebugMacro(<< "No points to glyph!");
-    pts->Delete();
-    trans->Delete();
     return 1;
   }
 
@@ -207,6 +317,12 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
       (this->VectorMode == VTK_USE_NORMAL && inNormals != nullptr)))
   {
     haveVectors = 1;
+    array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
+    if (array3D->GetNumberOfComponents() > 3)
+    {
+      vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
+      return false;
+    }
   }
   else
   {
@@ -221,8 +337,6 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     if (source == nullptr)
     {
       vtkErrorMacro(<< "Indexing on but don't have data to index with");
-      pts->Delete();
-      trans->Delete();
       return true;
     }
     else
@@ -254,69 +368,137 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     source = defaultSource;
   }
 
+  // Gather the table of sources
+  std::vector<vtkGlyphSource> sources;
   if (this->IndexMode != VTK_INDEXING_OFF)
   {
     pd = nullptr;
     haveNormals = 1;
-    for (numSourcePts = numSourceCells = i = 0; i < numberOfSources; i++)
+    sources.resize(numberOfSources);
+    for (int i = 0; i < numberOfSources; i++)
     {
-      source = this->GetSource(i, sourceVector);
-      if (source != nullptr)
+      sources[i].Source = this->GetSource(i, sourceVector);
+      if (sources[i].Source != nullptr && !sources[i].Source->GetPointData()->GetNormals())
       {
-        if (source->GetNumberOfPoints() > numSourcePts)
-        {
-          numSourcePts = source->GetNumberOfPoints();
-        }
-        if (source->GetNumberOfCells() > numSourceCells)
-        {
-          numSourceCells = source->GetNumberOfCells();
-        }
-        if (!(sourceNormals = source->GetPointData()->GetNormals()))
-        {
-          haveNormals = 0;
-        }
+        haveNormals = 0;
       }
     }
   }
   else
   {
-    sourcePts = source->GetPoints();
-    numSourcePts = sourcePts->GetNumberOfPoints();
-    numSourceCells = source->GetNumberOfCells();
+    sources.resize(1);
+    sources[0].Source = source;
+    haveNormals = (source->GetPointData()->GetNormals() != nullptr ? 1 : 0);
+    sourceTCoords = source->GetPointData()->GetTCoords();
+    haveTCoords = (sourceTCoords != nullptr ? 1 : 0);
+  }
+  if (this->GenerateInstances)
+  {
+    haveNormals = haveTCoords = 0;
+  }
 
-    sourceNormals = source->GetPointData()->GetNormals();
-    if (sourceNormals)
+  // Cache the glyph geometry, and find out whether the sources have a
+  // single kind of cells (verts, lines, polys or strips).
+  int cellKinds = 0;
+  for (vtkGlyphSource& glyph : sources)
+  {
+    if (glyph.Source != nullptr && !this->GenerateInstances)
     {
-      haveNormals = 1;
+      cellKinds |= vtkPrepareGlyphSource(glyph, this->SourceTransform, haveNormals != 0);
     }
-    else
+  }
+
+  // Decide which input points are glyphed, and with which source. This is
+  // done serially, so that IsPointVisible() needs not be thread safe.
+  std::vector<int> glyphSources(numPts, -1);
+  for (inPtId = 0; inPtId < numPts; inPtId++)
+  {
+    if (!(inPtId % 10000))
     {
-      haveNormals = 0;
+      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
+      if (this->GetAbortExecute())
+      {
+        break;
+      }
     }
 
-    sourceTCoords = source->GetPointData()->GetTCoords();
-    if (sourceTCoords)
+    // Compute index into table of glyphs
+    int index = 0;
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      double value = 0.0;
+      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
+      {
+        value = inSScalars->GetComponent(inPtId, 0);
+      }
+      else if (haveVectors)
+      {
+        double v[3] = { 0.0, 0.0, 0.0 };
+        array3D->GetTuple(inPtId, v);
+        value = vtkMath::Norm(v);
+      }
+
+      index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
+      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
+    }
+
+    // Make sure we're not indexing into empty glyph
+    if (sources[index].Source == nullptr)
     {
-      haveTCoords = 1;
+      continue;
     }
-    else
+
+    // Check ghost points.
+    // If we are processing a piece, we do not want to duplicate
+    // glyphs on the borders.
+    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
     {
-      haveTCoords = 0;
+      continue;
     }
 
-    // Prepare to copy output.
-    pd = input->GetPointData();
-    outputPD->CopyAllocate(pd, numPts * numSourcePts);
-    if (this->FillCellData)
+    if (inputUG && !inputUG->IsPointVisible(inPtId))
     {
-      outputCD->CopyAllocate(pd, numPts * numSourceCells);
+      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
+      // it.
+      continue;
+    }
+
+    if (!this->IsPointVisible(input, inPtId))
+    {
+      continue;
     }
+
+    glyphSources[inPtId] = index;
   }
 
-  srcPointIdList->SetNumberOfIds(numSourcePts);
-  dstPointIdList->SetNumberOfIds(numSourcePts);
-  srcCellIdList->SetNumberOfIds(numSourceCells);
-  dstCellIdList->SetNumberOfIds(numSourceCells);
+  // Locate the output of each glyph. A glyph instance is a single point.
+  std::vector<vtkIdType> ptOffsets(numPts + 1);
+  std::vector<vtkIdType> cellOffsets(numPts + 1);
+  std::vector<vtkIdType> connOffsets(numPts + 1);
+  ptOffsets[0] = cellOffsets[0] = connOffsets[0] = 0;
+  for (inPtId = 0; inPtId < numPts; inPtId++)
+  {
+    const int index = glyphSources[inPtId];
+    const vtkGlyphSource* glyph = (index < 0 ? nullptr : &sources[index]);
+    ptOffsets[inPtId + 1] = ptOffsets[inPtId] +
+      (glyph == nullptr ? 0 : (this->GenerateInstances ? 1 : glyph->NumberOfPoints));
+    cellOffsets[inPtId + 1] = cellOffsets[inPtId] + (glyph == nullptr ? 0 : glyph->NumberOfCells);
+    connOffsets[inPtId + 1] =
+      connOffsets[inPtId] + (glyph == nullptr ? 0 : glyph->ConnectivitySize);
+  }
+  const vtkIdType numOutPts = ptOffsets[numPts];
+  const vtkIdType numOutCells = cellOffsets[numPts];
+  const bool fillCellData = (pd && this->FillCellData && !this->GenerateInstances);
+
+  // Prepare to copy output.
+  if (pd)
+  {
+    outputPD->CopyAllocate(pd, numOutPts);
+    if (fillCellData)
+    {
+      outputCD->CopyAllocate(pd, numOutCells);
+    }
+  }
 
   newPts = vtkPoints::New();
 
@@ -334,26 +516,27 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numPts * numSourcePts);
+  newPts->SetNumberOfPoints(numOutPts);
   if (this->GeneratePointIds)
   {
     pointIds = vtkIdTypeArray::New();
     pointIds->SetName(this->PointIdsName);
-    pointIds->Allocate(numPts * numSourcePts);
+    pointIds->SetNumberOfValues(numOutPts);
     outputPD->AddArray(pointIds);
     pointIds->Delete();
   }
+  vtkFloatArray* newScales = nullptr;
   if (this->ColorMode == VTK_COLOR_BY_SCALAR && inCScalars)
   {
     newScalars = inCScalars->NewInstance();
     newScalars->SetNumberOfComponents(inCScalars->GetNumberOfComponents());
-    newScalars->Allocate(inCScalars->GetNumberOfComponents() * numPts * numSourcePts);
+    newScalars->SetNumberOfTuples(numOutPts);
     newScalars->SetName(inCScalars->GetName());
   }
   else if ((this->ColorMode == VTK_COLOR_BY_SCALE) && inSScalars)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars = newScales = vtkFloatArray::New();
+    newScales->SetNumberOfValues(numOutPts);
     newScalars->SetName("GlyphScale");
     if (this->ScaleMode == VTK_SCALE_BY_SCALAR)
     {
@@ -362,22 +545,22 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
   }
   else if ((this->ColorMode == VTK_COLOR_BY_VECTOR) && haveVectors)
   {
-    newScalars = vtkFloatArray::New();
-    newScalars->Allocate(numPts * numSourcePts);
+    newScalars = newScales = vtkFloatArray::New();
+    newScales->SetNumberOfValues(numOutPts);
     newScalars->SetName("VectorMagnitude");
   }
   if (haveVectors)
   {
     newVectors = vtkFloatArray::New();
     newVectors->SetNumberOfComponents(3);
-    newVectors->Allocate(3 * numPts * numSourcePts);
+    newVectors->SetNumberOfTuples(numOutPts);
     newVectors->SetName("GlyphVector");
   }
   if (haveNormals)
   {
     newNormals = vtkFloatArray::New();
     newNormals->SetNumberOfComponents(3);
-    newNormals->Allocate(3 * numPts * numSourcePts);
+    newNormals->SetNumberOfTuples(numOutPts);
     newNormals->SetName("Normals");
   }
   if (haveTCoords)
@@ -385,172 +568,148 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords = vtkFloatArray::New();
     int numComps = sourceTCoords->GetNumberOfComponents();
     newTCoords->SetNumberOfComponents(numComps);
-    newTCoords->Allocate(numComps * numPts * numSourcePts);
+    newTCoords->SetNumberOfTuples(numOutPts);
     newTCoords->SetName("TCoords");
   }
+  if (this->GenerateInstances)
+  {
+    newTransforms = vtkDoubleArray::New();
+    newTransforms->SetNumberOfComponents(16);
+    newTransforms->SetNumberOfTuples(numOutPts);
+    newTransforms->SetName("GlyphTransform");
+    if (this->IndexMode != VTK_INDEXING_OFF)
+    {
+      newSourceIndices = vtkIntArray::New();
+      newSourceIndices->SetNumberOfValues(numOutPts);
+      newSourceIndices->SetName("GlyphSourceIndex");
+    }
+  }
 
-  // Setting up for calls to PolyData::InsertNextCell()
-  output->AllocateEstimate(numPts * numSourceCells, 3);
+  // The cells are copied in parallel when the output has a single kind of
+  // cells. Otherwise they are inserted afterwards, in order.
+  const bool parallelCells = !this->GenerateInstances && !(cellKinds & (cellKinds - 1));
+  vtkNew<vtkIdTypeArray> outCellOffsets;
+  vtkNew<vtkIdTypeArray> outConnectivity;
+  if (parallelCells)
+  {
+    outCellOffsets->SetNumberOfValues(numOutCells + 1);
+    outCellOffsets->SetValue(numOutCells, connOffsets[numPts]);
+    outConnectivity->SetNumberOfValues(connOffsets[numPts]);
+  }
 
-  transformedSourcePts->SetDataTypeToDouble();
-  transformedSourcePts->Allocate(numSourcePts);
+  // The input point of each output point and cell, to copy the point data
+  const bool copyPointData = (pd || (newScalars != nullptr && newScales == nullptr));
+  vtkNew<vtkIdList> srcPointIds;
+  vtkNew<vtkIdList> dstPointIds;
+  vtkNew<vtkIdList> srcCellIds;
+  vtkNew<vtkIdList> dstCellIds;
+  srcPointIds->SetNumberOfIds(copyPointData ? numOutPts : 0);
+  dstPointIds->SetNumberOfIds(copyPointData ? numOutPts : 0);
+  srcCellIds->SetNumberOfIds(fillCellData ? numOutCells : 0);
+  dstCellIds->SetNumberOfIds(fillCellData ? numOutCells : 0);
+
+  double sourceMatrix[16];
+  if (this->SourceTransform)
+  {
+    vtkMatrix4x4::DeepCopy(sourceMatrix, this->SourceTransform->GetMatrix());
+  }
 
-  // Traverse all Input points, transforming Source points and copying
-  // point attributes.
-  //
-  ptIncr = 0;
-  cellIncr = 0;
-  for (inPtId = 0; inPtId < numPts; inPtId++)
+  // Traverse all glyphed input points in parallel, transforming the glyph
+  // geometry and copying point attributes. vtkDataSet::GetPoint() is thread
+  // safe once called from a single thread.
+  double x[3];
+  input->GetPoint(0, x);
+  float* newPtsF = nullptr;
+  double* newPtsD = nullptr;
+  if (newPts->GetDataType() == VTK_FLOAT)
   {
-    scalex = scaley = scalez = 1.0;
-    if (!(inPtId % 10000))
+    newPtsF = static_cast<vtkFloatArray*>(newPts->GetData())->GetPointer(0);
+  }
+  else
+  {
+    newPtsD = static_cast<vtkDoubleArray*>(newPts->GetData())->GetPointer(0);
+  }
+  vtkSMPThreadLocalObject<vtkTransform> transforms;
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    vtkTransform* trans = transforms.Local();
+    double pt[3], v[3], vNew[3], vMag, matrix[4][4];
+    for (; ptId < endPtId; ++ptId)
     {
-      this->UpdateProgress(static_cast<double>(inPtId) / numPts);
-      if (this->GetAbortExecute())
+      const int index = glyphSources[ptId];
+      if (index < 0)
       {
-        break;
+        continue;
       }
-    }
+      const vtkGlyphSource& glyph = sources[index];
+      const vtkIdType outPtId = ptOffsets[ptId];
+      const vtkIdType numGlyphPts = ptOffsets[ptId + 1] - outPtId;
 
-    // Get the scalar and vector data
-    if (inSScalars)
-    {
-      s = inSScalars->GetComponent(inPtId, 0);
-      if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+      // Get the scalar and vector data
+      double scalex = 1.0, scaley = 1.0, scalez = 1.0;
+      if (inSScalars)
       {
-        scalex = scaley = scalez = s;
+        const double s = inSScalars->GetComponent(ptId, 0);
+        if (this->ScaleMode == VTK_SCALE_BY_SCALAR || this->ScaleMode == VTK_DATA_SCALING_OFF)
+        {
+          scalex = scaley = scalez = s;
+        }
       }
-    }
 
-    if (haveVectors)
-    {
-      vtkDataArray* array3D = this->VectorMode == VTK_USE_NORMAL ? inNormals : inVectors;
-      if (array3D->GetNumberOfComponents() > 3)
+      vMag = 0.0;
+      if (haveVectors)
       {
-        vtkErrorMacro(<< "vtkDataArray " << array3D->GetName() << " has more than 3 components.\n");
-        pts->Delete();
-        trans->Delete();
-        if (newPts)
+        v[0] = 0;
+        v[1] = 0;
+        v[2] = 0;
+        array3D->GetTuple(ptId, v);
+        vMag = vtkMath::Norm(v);
+        if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
         {
-          newPts->Delete();
+          scalex = v[0];
+          scaley = v[1];
+          scalez = v[2];
         }
-        if (newVectors)
+        else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
         {
-          newVectors->Delete();
+          scalex = scaley = scalez = vMag;
         }
-        return false;
-      }
-
-      v[0] = 0;
-      v[1] = 0;
-      v[2] = 0;
-      array3D->GetTuple(inPtId, v);
-      vMag = vtkMath::Norm(v);
-      if (this->ScaleMode == VTK_SCALE_BY_VECTORCOMPONENTS)
-      {
-        scalex = v[0];
-        scaley = v[1];
-        scalez = v[2];
-      }
-      else if (this->ScaleMode == VTK_SCALE_BY_VECTOR)
-      {
-        scalex = scaley = scalez = vMag;
       }
-    }
 
-    // Clamp data scale if enabled
-    if (this->Clamping)
-    {
-      scalex = (scalex < this->Range[0] ? this->Range[0]
-                                        : (scalex > this->Range[1] ? this->Range[1] : scalex));
-      scalex = (scalex - this->Range[0]) / den;
-      scaley = (scaley < this->Range[0] ? this->Range[0]
-                                        : (scaley > this->Range[1] ? this->Range[1] : scaley));
-      scaley = (scaley - this->Range[0]) / den;
-      scalez = (scalez < this->Range[0] ? this->Range[0]
-                                        : (scalez > this->Range[1] ? this->Range[1] : scalez));
-      scalez = (scalez - this->Range[0]) / den;
-    }
-
-    // Compute index into table of glyphs
-    if (this->IndexMode != VTK_INDEXING_OFF)
-    {
-      if (this->IndexMode == VTK_INDEXING_BY_SCALAR)
+      // Clamp data scale if enabled
+      if (this->Clamping)
       {
-        value = s;
+        scalex = (scalex < this->Range[0] ? this->Range[0]
+                                          : (scalex > this->Range[1] ? this->Range[1] : scalex));
+        scalex = (scalex - this->Range[0]) / den;
+        scaley = (scaley < this->Range[0] ? this->Range[0]
+                                          : (scaley > this->Range[1] ? this->Range[1] : scaley));
+        scaley = (scaley - this->Range[0]) / den;
+        scalez = (scalez < this->Range[0] ? this->Range[0]
+                                          : (scalez > this->Range[1] ? this->Range[1] : scalez));
+        scalez = (scalez - this->Range[0]) / den;
       }
-      else
-      {
-        value = vMag;
-      }
-
-      int index = static_cast<int>((value - this->Range[0]) * numberOfSources / den);
-      index = (index < 0 ? 0 : (index >= numberOfSources ? (numberOfSources - 1) : index));
 
-      source = this->GetSource(index, sourceVector);
-      if (source != nullptr)
+      // Copy the vector, and the scale or vector magnitude as scalar
+      for (vtkIdType i = 0; haveVectors && i < numGlyphPts; i++)
       {
-        sourcePts = source->GetPoints();
-        sourceNormals = source->GetPointData()->GetNormals();
-        numSourcePts = sourcePts->GetNumberOfPoints();
-        numSourceCells = source->GetNumberOfCells();
+        float* vector = newVectors->GetPointer(3 * (outPtId + i));
+        vector[0] = static_cast<float>(v[0]);
+        vector[1] = static_cast<float>(v[1]);
+        vector[2] = static_cast<float>(v[2]);
       }
-    }
-
-    // Make sure we're not indexing into empty glyph
-    if (source == nullptr)
-    {
-      continue;
-    }
-
-    // Check ghost points.
-    // If we are processing a piece, we do not want to duplicate
-    // glyphs on the borders.
-    if (inGhostLevels && inGhostLevels[inPtId] & vtkDataSetAttributes::DUPLICATEPOINT)
-    {
-      continue;
-    }
-
-    if (inputUG && !inputUG->IsPointVisible(inPtId))
-    {
-      // input is a vtkUniformGrid and the current point is blanked. Don't glyph
-      // it.
-      continue;
-    }
-
-    if (!this->IsPointVisible(input, inPtId))
-    {
-      continue;
-    }
-
-    // Now begin copying/transforming glyph
-    trans->Identity();
-
-    // Copy all topology (transformation independent)
-    for (cellId = 0; cellId < numSourceCells; cellId++)
-    {
-      source->GetCellPoints(cellId, pointIdList);
-      cellPts = pointIdList;
-      npts = cellPts->GetNumberOfIds();
-      for (pts->Reset(), i = 0; i < npts; i++)
+      if (newScales)
       {
-        pts->InsertId(i, cellPts->GetId(i) + ptIncr);
+        const float value =
+          static_cast<float>(this->ColorMode == VTK_COLOR_BY_SCALE ? scalex : vMag);
+        std::fill_n(newScales->GetPointer(outPtId), numGlyphPts, value);
       }
-      output->InsertNextCell(source->GetCellType(cellId), pts);
-    }
 
-    // translate Source to Input point
-    input->GetPoint(inPtId, x);
-    trans->Translate(x[0], x[1], x[2]);
+      // translate Source to Input point
+      trans->Identity();
+      input->GetPoint(ptId, pt);
+      trans->Translate(pt[0], pt[1], pt[2]);
 
-    if (haveVectors)
-    {
-      // Copy Input vector
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newVectors->InsertTuple(i + ptIncr, v);
-      }
-      if (this->Orient && (vMag > 0.0))
+      if (haveVectors && this->Orient && (vMag > 0.0))
       {
         // if there is no y or z component
         if (v[1] == 0.0 && v[2] == 0.0)
@@ -568,118 +727,190 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
           trans->RotateWXYZ(180.0, vNew[0], vNew[1], vNew[2]);
         }
       }
-    }
 
-    if (haveTCoords)
-    {
-      for (i = 0; i < numSourcePts; i++)
+      // scale data if appropriate
+      if (this->Scaling)
       {
-        sourceTCoords->GetTuple(i, tc);
-        newTCoords->InsertTuple(i + ptIncr, tc);
-      }
-    }
+        if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+        {
+          scalex = scaley = scalez = this->ScaleFactor;
+        }
+        else
+        {
+          scalex *= this->ScaleFactor;
+          scaley *= this->ScaleFactor;
+          scalez *= this->ScaleFactor;
+        }
 
-    // determine scale factor from scalars if appropriate
-    // Copy scalar value
-    if (inSScalars && (this->ColorMode == VTK_COLOR_BY_SCALE))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &scalex); // = scaley = scalez
-      }
-    }
-    else if (inCScalars && (this->ColorMode == VTK_COLOR_BY_SCALAR))
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        outputPD->CopyTuple(inCScalars, newScalars, inPtId, ptIncr + i);
-      }
-    }
-    if (haveVectors && this->ColorMode == VTK_COLOR_BY_VECTOR)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        newScalars->InsertTuple(i + ptIncr, &vMag);
+        if (scalex == 0.0)
+        {
+          scalex = 1.0e-10;
+        }
+        if (scaley == 0.0)
+        {
+          scaley = 1.0e-10;
+        }
+        if (scalez == 0.0)
+        {
+          scalez = 1.0e-10;
+        }
+        trans->Scale(scalex, scaley, scalez);
       }
-    }
+      vtkMatrix4x4::DeepCopy(*matrix, trans->GetMatrix());
 
-    // scale data if appropriate
-    if (this->Scaling)
-    {
-      if (this->ScaleMode == VTK_DATA_SCALING_OFF)
+      if (this->GenerateInstances)
       {
-        scalex = scaley = scalez = this->ScaleFactor;
+        // The glyph is the source mapped by its transform
+        double* instance = newTransforms->GetPointer(16 * outPtId);
+        if (this->SourceTransform)
+        {
+          vtkMatrix4x4::Multiply4x4(*matrix, sourceMatrix, instance);
+        }
+        else
+        {
+          std::copy(*matrix, *matrix + 16, instance);
+        }
+        if (newSourceIndices)
+        {
+          newSourceIndices->SetValue(outPtId, index);
+        }
+        if (newPtsF)
+        {
+          std::copy(pt, pt + 3, newPtsF + 3 * outPtId);
+        }
+        else
+        {
+          std::copy(pt, pt + 3, newPtsD + 3 * outPtId);
+        }
       }
       else
       {
-        scalex *= this->ScaleFactor;
-        scaley *= this->ScaleFactor;
-        scalez *= this->ScaleFactor;
+        // multiply points and normals by resulting matrix
+        if (newPtsF)
+        {
+          vtkGlyphTransformPoints(matrix, glyph.Points.data(), numGlyphPts, newPtsF + 3 * outPtId);
+        }
+        else
+        {
+          vtkGlyphTransformPoints(matrix, glyph.Points.data(), numGlyphPts, newPtsD + 3 * outPtId);
+        }
+        if (haveNormals)
+        {
+          vtkGlyphTransformNormals(matrix, glyph.Normals.data(), numGlyphPts,
+            newNormals->GetPointer(3 * outPtId));
+        }
+        if (haveTCoords)
+        {
+          const int numComps = sourceTCoords->GetNumberOfComponents();
+          float* tcoords = newTCoords->GetPointer(numComps * outPtId);
+          for (vtkIdType i = 0; i < numGlyphPts; i++)
+          {
+            for (int j = 0; j < numComps; j++)
+            {
+              *tcoords++ = static_cast<float>(sourceTCoords->GetComponent(i, j));
+            }
+          }
+        }
+
+        // Copy all topology (transformation independent)
+        if (parallelCells)
+        {
+          const vtkIdType outCellId = cellOffsets[ptId];
+          const vtkIdType outConnId = connOffsets[ptId];
+          vtkIdType* cellOffset = outCellOffsets->GetPointer(outCellId);
+          for (vtkIdType i = 0; i < glyph.NumberOfCells; i++)
+          {
+            cellOffset[i] = glyph.CellOffsets[i] + outConnId;
+          }
+          vtkIdType* conn = outConnectivity->GetPointer(outConnId);
+          for (vtkIdType i = 0; i < glyph.ConnectivitySize; i++)
+          {
+            conn[i] = glyph.Connectivity[i] + outPtId;
+          }
+        }
       }
 
-      if (scalex == 0.0)
+      // Record the input point of the output points and cells
+      if (copyPointData)
       {
-        scalex = 1.0e-10;
+        std::fill_n(srcPointIds->GetPointer(outPtId), numGlyphPts, ptId);
+        std::iota(dstPointIds->GetPointer(outPtId), dstPointIds->GetPointer(outPtId) + numGlyphPts,
+          outPtId);
       }
-      if (scaley == 0.0)
+      if (fillCellData)
       {
-        scaley = 1.0e-10;
+        const vtkIdType outCellId = cellOffsets[ptId];
+        const vtkIdType numGlyphCells = cellOffsets[ptId + 1] - outCellId;
+        std::fill_n(srcCellIds->GetPointer(outCellId), numGlyphCells, ptId);
+        std::iota(dstCellIds->GetPointer(outCellId),
+          dstCellIds->GetPointer(outCellId) + numGlyphCells, outCellId);
       }
-      if (scalez == 0.0)
+
+      // If point ids are to be generated, do it here
+      if (pointIds)
       {
-        scalez = 1.0e-10;
+        std::fill_n(pointIds->GetPointer(outPtId), numGlyphPts, ptId);
       }
-      trans->Scale(scalex, scaley, scalez);
     }
+  });
 
-    // multiply points and normals by resulting matrix
-    if (this->SourceTransform)
-    {
-      transformedSourcePts->Reset();
-      this->SourceTransform->TransformPoints(sourcePts, transformedSourcePts);
-      trans->TransformPoints(transformedSourcePts, newPts);
-    }
-    else
+  // Copy point data from the input in bulk
+  if (pd)
+  {
+    outputPD->CopyData(pd, srcPointIds, dstPointIds);
+    if (fillCellData)
     {
-      trans->TransformPoints(sourcePts, newPts);
+      outputCD->CopyData(pd, srcCellIds, dstCellIds);
     }
+  }
+  if (newScalars && !newScales)
+  {
+    newScalars->InsertTuples(dstPointIds, srcPointIds, inCScalars);
+  }
 
-    if (haveNormals)
+  // Set the cells, or insert them in order when there are several kinds
+  if (parallelCells && numOutCells > 0)
+  {
+    vtkNew<vtkCellArray> cells;
+    cells->SetData(outCellOffsets, outConnectivity);
+    switch (cellKinds)
     {
-      trans->TransformNormals(sourceNormals, newNormals);
+      case 1:
+        output->SetVerts(cells);
+        break;
+      case 2:
+        output->SetLines(cells);
+        break;
+      case 4:
+        output->SetPolys(cells);
+        break;
+      default:
+        output->SetStrips(cells);
+        break;
     }
-
-    // Copy point data from source (if possible)
-    if (pd)
+  }
+  else if (!this->GenerateInstances)
+  {
+    output->AllocateEstimate(numOutCells, 3);
+    vtkNew<vtkIdList> pointIdList;
+    for (inPtId = 0; inPtId < numPts; inPtId++)
     {
-      for (i = 0; i < numSourcePts; ++i)
+      if (glyphSources[inPtId] < 0)
       {
-        srcPointIdList->SetId(i, inPtId);
-        dstPointIdList->SetId(i, ptIncr + i);
+        continue;
       }
-      outputPD->CopyData(pd, srcPointIdList, dstPointIdList);
-      if (this->FillCellData)
+      vtkPolyData* glyphSource = sources[glyphSources[inPtId]].Source;
+      const vtkIdType numSourceCells = glyphSource->GetNumberOfCells();
+      for (vtkIdType cellId = 0; cellId < numSourceCells; cellId++)
       {
-        for (i = 0; i < numSourceCells; ++i)
+        glyphSource->GetCellPoints(cellId, pointIdList);
+        for (vtkIdType i = 0; i < pointIdList->GetNumberOfIds(); i++)
         {
-          srcCellIdList->SetId(i, inPtId);
-          dstCellIdList->SetId(i, cellIncr + i);
+          pointIdList->SetId(i, pointIdList->GetId(i) + ptOffsets[inPtId]);
         }
-        outputCD->CopyData(pd, srcCellIdList, dstCellIdList);
-      }
-    }
-
-    // If point ids are to be generated, do it here
-    if (this->GeneratePointIds)
-    {
-      for (i = 0; i < numSourcePts; i++)
-      {
-        pointIds->InsertNextValue(inPtId);
+        output->InsertNextCell(glyphSource->GetCellType(cellId), pointIdList);
       }
     }
-
-    ptIncr += numSourcePts;
-    cellIncr += numSourceCells;
   }
 
   // Update ourselves and release memory
@@ -712,9 +943,19 @@ bool vtkGlyph3D::Execute(vtkDataSet* input, vtkInformationVector* sourceVector,
     newTCoords->Delete();
   }
 
+  if (newTransforms)
+  {
+    outputPD->AddArray(newTransforms);
+    newTransforms->Delete();
+  }
+
+  if (newSourceIndices)
+  {
+    outputPD->AddArray(newSourceIndices);
+    newSourceIndices->Delete();
+  }
+
   output->Squeeze();
-  trans->Delete();
-  pts->Delete();
 
   return true;
 }
@@ -867,6 +1108,7 @@ void vtkGlyph3D::PrintSelf(ostream& os, vtkIndent indent)
   }
 
   os << indent << "Fill Cell Data: " << (this->FillCellData ? "On\n" : "Off\n");
+  os << indent << "Generate Instances: " << (this->GenerateInstances ? "On\n" : "Off\n");
 
   os << indent << "SourceTransform: ";
   if (this->SourceTransform)
@@ -73,6 +73,18 @@
  * vtkAlgorithm. The first array is scalars, the next vectors, the next
  * normals and finally color scalars.
  *
+ * @warning
+ * Copying the glyph geometry to every point multiplies the size of the
+ * source by the number of points. When GenerateInstances is on, the
+ * geometry is not copied: the output has one point per glyph, with the
+ * matrix transforming the source into the glyph, so that downstream code
+ * (e.g. instanced rendering) can use the source directly.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkTensorGlyph
  */
@@ -282,9 +294,28 @@ public:
   vtkBooleanMacro(FillCellData, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Enable/disable the generation of glyph instances instead of glyph
+   * geometry. When on, the output has one point (and no cell) per glyph,
+   * located at the glyphed input point. Its point data holds a 16-component
+   * double array named "GlyphTransform", the row-major 4x4 matrix mapping
+   * the source points (including the SourceTransform) to the glyph points,
+   * and, when indexing is on, an integer array named "GlyphSourceIndex",
+   * the index of the source of the glyph. The other point data (scalars,
+   * vectors, point ids and copied input data) have one tuple per glyph.
+   * The source normals and texture coordinates, and the cell data, are not
+   * generated. Off by default.
+   */
+  vtkSetMacro(GenerateInstances, vtkTypeBool);
+  vtkGetMacro(GenerateInstances, vtkTypeBool);
+  vtkBooleanMacro(GenerateInstances, vtkTypeBool);
+  //@}
+
   /**
    * This can be overwritten by subclass to return 0 when a point is
-   * blanked. Default implementation is to always return 1;
+   * blanked. Default implementation is to always return 1. It is called
+   * from a single thread, before the glyphs are generated in parallel.
    */
   virtual int IsPointVisible(vtkDataSet*, vtkIdType) { return 1; }
 
@@ -349,6 +380,7 @@ protected:
   char* PointIdsName;
   vtkTransform* SourceTransform;
   int OutputPointsPrecision;
+  vtkTypeBool GenerateInstances;
 
 private:
   vtkGlyph3D(const vtkGlyph3D&) = delete;
@@ -15,13 +15,15 @@
 #include "vtkImplicitPolyDataDistance.h"
 
 #include "vtkCellData.h"
-#include "vtkCellLocator.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLocator.h"
 #include "vtkTriangleFilter.h"
 
 vtkStandardNewMacro(vtkImplicitPolyDataDistance);
@@ -67,7 +69,7 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
     this->CreateDefaultLocator();
     this->Locator->SetDataSet(this->Input);
     this->Locator->SetTolerance(this->Tolerance);
-    this->Locator->SetNumberOfCellsPerBucket(10);
+    this->Locator->SetNumberOfCellsPerNode(10);
     this->Locator->CacheCellBoundsOn();
     this->Locator->AutomaticOn();
     this->Locator->BuildLocator();
@@ -99,12 +101,31 @@ vtkImplicitPolyDataDistance::~vtkImplicitPolyDataDistance()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::SetLocator(vtkAbstractCellLocator* locator)
+{
+  if (this->Locator == locator)
+  {
+    return;
+  }
+  if (this->Locator)
+  {
+    this->Locator->UnRegister(this);
+  }
+  this->Locator = locator;
+  if (this->Locator)
+  {
+    this->Locator->Register(this);
+  }
+  this->Modified();
+}
+
 //----------------------------------------------------------------------------
 void vtkImplicitPolyDataDistance::CreateDefaultLocator()
 {
   if (this->Locator == nullptr)
   {
-    this->Locator = vtkCellLocator::New();
+    this->Locator = vtkStaticCellLocator::New();
   }
 }
 
@@ -134,11 +155,51 @@ void vtkImplicitPolyDataDistance::EvaluateGradient(double x[3], double g[3])
     x, g, p); // get normal, returned distance value not used and closest point not used
 }
 
+//-----------------------------------------------------------------------------
+bool vtkImplicitPolyDataDistance::EvaluateFunctionWithinRadius(
+  double x[3], double radius, double& value)
+{
+  double g[3];
+  double p[3];
+  bool found;
+  double ret = this->SharedEvaluate(x, radius, g, p, found);
+  if (found)
+  {
+    value = ret;
+  }
+  return found;
+}
+
 //-----------------------------------------------------------------------------
 double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], double closestPoint[3])
+{
+  bool found;
+  return this->SharedEvaluate(x, vtkMath::Inf(), g, closestPoint, found);
+}
+
+//-----------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::ComputeTriangleNormal(
+  vtkIdType cellId, vtkIdList* ptIds, vtkDataArray* cnorms, double normal[3])
+{
+  if (cnorms)
+  {
+    cnorms->GetTuple(cellId, normal);
+  }
+  else
+  {
+    this->Input->GetCellPoints(cellId, ptIds);
+    vtkPolygon::ComputeNormal(
+      this->Input->GetPoints(), ptIds->GetNumberOfIds(), ptIds->GetPointer(0), normal);
+  }
+}
+
+//-----------------------------------------------------------------------------
+double vtkImplicitPolyDataDistance::SharedEvaluate(
+  double x[3], double radius, double g[3], double closestPoint[3], bool& found)
 {
   // Set defaults
   double ret = this->NoValue;
+  found = false;
 
   for (int i = 0; i < 3; i++)
   {
@@ -158,7 +219,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
   }
 
   double p[3];
-  vtkIdType cellId;
+  vtkIdType cellId = -1;
   int subId;
   double vlen2;
 
@@ -169,11 +230,25 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
   }
 
   // Get point id of closest point in data set.
-  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
-  this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
+  vtkNew<vtkGenericCell> cell;
+  if (radius < vtkMath::Inf())
+  {
+    int inside;
+    if (!this->Locator->FindClosestPointWithinRadius(
+          x, radius, p, cell, cellId, subId, vlen2, inside))
+    {
+      cellId = -1;
+    }
+  }
+  else
+  {
+    this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
+  }
 
   if (cellId != -1) // point located
   {
+    found = true;
+
     // dist = | point - x |
     ret = sqrt(vlen2);
     // grad = (point - x) / dist
@@ -185,7 +260,8 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     double dist2, weights[3], pcoords[3], awnorm[3] = { 0, 0, 0 };
     cell->EvaluatePosition(p, closestPoint, subId, pcoords, dist2, weights);
 
-    vtkIdList* idList = vtkIdList::New();
+    vtkNew<vtkIdList> idList;
+    vtkNew<vtkIdList> ptIds;
     int count = 0;
     for (int i = 0; i < 3; i++)
     {
@@ -208,7 +284,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     else if (count == 1)
     {
       // ... edge ... get two adjacent faces, compute average normal
-      int a = -1, b = -1;
+      vtkIdType a = -1, b = -1;
       for (int edge = 0; edge < 3; edge++)
       {
         if (fabs(weights[edge]) < this->Tolerance)
@@ -232,14 +308,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
-        if (cnorms)
-        {
-          cnorms->GetTuple(idList->GetId(i), norm);
-        }
-        else
-        {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
-        }
+        this->ComputeTriangleNormal(idList->GetId(i), ptIds, cnorms, norm);
         awnorm[0] += norm[0];
         awnorm[1] += norm[1];
         awnorm[2] += norm[2];
@@ -253,7 +322,7 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       // ... vertex ... this is the expensive case, get all adjacent
       // faces and compute sum(a_i * n_i) Angle-Weighted Pseudo
       // Normals, J. Andreas Baerentzen and Henrik Aanaes
-      int a = -1;
+      vtkIdType a = -1;
       for (int i = 0; i < 3; i++)
       {
         if (fabs(weights[i]) > this->Tolerance)
@@ -273,25 +342,19 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
-        if (cnorms)
-        {
-          cnorms->GetTuple(idList->GetId(i), norm);
-        }
-        else
-        {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
-        }
+        this->ComputeTriangleNormal(idList->GetId(i), ptIds, cnorms, norm);
 
         // Compute angle at point a
-        int b = this->Input->GetCell(idList->GetId(i))->GetPointId(0);
-        int c = this->Input->GetCell(idList->GetId(i))->GetPointId(1);
+        this->Input->GetCellPoints(idList->GetId(i), ptIds);
+        vtkIdType b = ptIds->GetId(0);
+        vtkIdType c = ptIds->GetId(1);
         if (a == b)
         {
-          b = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          b = ptIds->GetId(2);
         }
         else if (a == c)
         {
-          c = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          c = ptIds->GetId(2);
         }
         double pa[3], pb[3], pc[3];
         this->Input->GetPoint(a, pa);
@@ -311,7 +374,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       }
       vtkMath::Normalize(awnorm);
     }
-    idList->Delete();
 
     // sign(dist) = dot(grad, cell normal)
     if (ret == 0)
@@ -344,6 +406,7 @@ void vtkImplicitPolyDataDistance::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "NoGradient: (" << this->NoGradient[0] << ", " << this->NoGradient[1] << ", "
      << this->NoGradient[2] << ")\n";
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+  os << indent << "Locator: " << this->Locator << "\n";
 
   if (this->Input)
   {
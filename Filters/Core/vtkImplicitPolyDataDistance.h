@@ -25,6 +25,12 @@
  * vtkPolyData have a distance of zero. The gradient of the function
  * is the angle-weighted pseudonormal at the nearest point.
  *
+ * The closest point is found with a cell locator, a vtkStaticCellLocator
+ * by default. Once SetInput() has been called, the evaluation methods may
+ * be invoked concurrently from several threads, provided the locator
+ * supports concurrent closest point queries as vtkStaticCellLocator does
+ * and no transform is set.
+ *
  * Baerentzen, J. A. and Aanaes, H. (2005). Signed distance
  * computation using the angle weighted pseudonormal. IEEE
  * Transactions on Visualization and Computer Graphics, 11:243-253.
@@ -42,7 +48,9 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkImplicitFunction.h"
 
-class vtkCellLocator;
+class vtkAbstractCellLocator;
+class vtkDataArray;
+class vtkIdList;
 class vtkPolyData;
 
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
@@ -74,6 +82,14 @@ public:
    */
   double EvaluateFunctionAndGetClosestPoint(double x[3], double closestPoint[3]);
 
+  /**
+   * Evaluate the signed distance to the input only if the input lies
+   * within the given radius of x[3]. Returns false, leaving value
+   * unchanged, if no point of the input is within the radius. Much faster
+   * than EvaluateFunction() when only distances near the surface matter.
+   */
+  bool EvaluateFunctionWithinRadius(double x[3], double radius, double& value);
+
   /**
    * Set the input vtkPolyData used for the implicit function
    * evaluation.  Passes input through an internal instance of
@@ -117,6 +133,16 @@ public:
   vtkSetMacro(Tolerance, double);
   //@}
 
+  //@{
+  /**
+   * Set/get the cell locator used to find the closest point of the input.
+   * A vtkStaticCellLocator is created if none is set. The locator must be
+   * set before SetInput() is called.
+   */
+  void SetLocator(vtkAbstractCellLocator* locator);
+  vtkGetObjectMacro(Locator, vtkAbstractCellLocator);
+  //@}
+
 protected:
   vtkImplicitPolyDataDistance();
   ~vtkImplicitPolyDataDistance() override;
@@ -127,6 +153,9 @@ protected:
   void CreateDefaultLocator(void);
 
   double SharedEvaluate(double x[3], double g[3], double p[3]);
+  double SharedEvaluate(double x[3], double radius, double g[3], double p[3], bool& found);
+  void ComputeTriangleNormal(
+    vtkIdType cellId, vtkIdList* ptIds, vtkDataArray* cnorms, double normal[3]);
 
   double NoGradient[3];
   double NoClosestPoint[3];
@@ -134,7 +163,7 @@ protected:
   double Tolerance;
 
   vtkPolyData* Input;
-  vtkCellLocator* Locator;
+  vtkAbstractCellLocator* Locator;
 
 private:
   vtkImplicitPolyDataDistance(const vtkImplicitPolyDataDistance&) = delete;
@@ -0,0 +1,111 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkLineNormalsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkLineNormalsInternal
+ * @brief   sliding normals of a single polyline
+ *
+ * vtkLineNormalsInternal generates the sliding normals of one polyline at a
+ * time, with its own scratch arrays, so that the lines can be processed in
+ * parallel. It is shared by vtkTubeFilter and vtkRibbonFilter.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkTubeFilter vtkRibbonFilter vtkPolyLine
+ */
+
+#ifndef vtkLineNormalsInternal_h
+#define vtkLineNormalsInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkFloatArray.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyLine.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The normals are stored by position along the line. A point repeated along
+// the line uses the last normal generated for it, as if the normals were
+// stored by point id.
+struct vtkLineNormals
+{
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Line;
+  vtkNew<vtkFloatArray> Normals;
+  vtkNew<vtkPolyLine> Generator;
+  std::vector<std::pair<vtkIdType, vtkIdType> > SortedIds;
+  std::vector<vtkIdType> NormalIds;
+
+  vtkLineNormals()
+  {
+    this->Points->SetDataTypeToDouble();
+    this->Normals->SetNumberOfComponents(3);
+  }
+
+  // Generate the normals of the line points, and return false if
+  // vtkPolyLine::GenerateSlidingNormals() failed. The ids of the normals of
+  // the line points are set in both cases.
+  bool Generate(vtkPoints* inPts, vtkIdType npts, const vtkIdType* pts)
+  {
+    this->Points->SetNumberOfPoints(npts);
+    this->Normals->SetNumberOfTuples(npts);
+    this->Line->Reset();
+    this->Line->InsertNextCell(static_cast<int>(npts));
+    this->SortedIds.resize(npts);
+    double x[3];
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      inPts->GetPoint(pts[i], x);
+      this->Points->SetPoint(i, x);
+      this->Line->InsertCellPoint(i);
+      this->SortedIds[i] = std::make_pair(pts[i], i);
+    }
+    const bool generated =
+      this->Generator->GenerateSlidingNormals(this->Points, this->Line, this->Normals) != 0;
+
+    std::sort(this->SortedIds.begin(), this->SortedIds.end());
+    this->NormalIds.resize(npts);
+    for (vtkIdType i = 0, last; i < npts; i = last + 1)
+    {
+      for (last = i; last + 1 < npts && this->SortedIds[last + 1].first == this->SortedIds[i].first;
+           ++last)
+      {
+      }
+      for (vtkIdType j = i; j <= last; ++j)
+      {
+        this->NormalIds[this->SortedIds[j].second] = this->SortedIds[last].second;
+      }
+    }
+    return generated;
+  }
+
+  // The ids of the normals of the line points
+  const vtkIdType* GetNormalIds() const { return this->NormalIds.data(); }
+};
+
+} // anonymous namespace
+
+#endif // vtkLineNormalsInternal_h
+// VTK-HeaderTest-Exclude: vtkLineNormalsInternal.h
@@ -17,17 +17,22 @@
 #include "vtkCell.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
+#include "vtkConnectivityFilterInternal.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm> // for fill_n
+#include <vector>
 
 vtkStandardNewMacro(vtkPolyDataConnectivityFilter);
 
@@ -58,6 +63,7 @@ vtkPolyDataConnectivityFilter::vtkPolyDataConnectivityFilter()
   this->VisitedPointIds = vtkIdList::New();
 
   this->OutputPointsPrecision = DEFAULT_PRECISION;
+  this->ParallelLabeling = 0;
 }
 
 vtkPolyDataConnectivityFilter::~vtkPolyDataConnectivityFilter()
@@ -133,7 +139,11 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
   //
   this->Mesh = vtkPolyData::New();
   this->Mesh->CopyStructure(input);
-  this->Mesh->BuildLinks();
+  if (!this->ParallelLabeling || this->ExtractionMode == VTK_EXTRACT_POINT_SEEDED_REGIONS ||
+    this->ExtractionMode == VTK_EXTRACT_CLOSEST_POINT_REGION)
+  {
+    this->Mesh->BuildLinks();
+  }
   this->UpdateProgress(0.10);
 
   // Remove all visited point ids
@@ -188,28 +198,35 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->ExtractionMode != VTK_EXTRACT_CELL_SEEDED_REGIONS &&
     this->ExtractionMode != VTK_EXTRACT_CLOSEST_POINT_REGION)
   { // visit all cells marking with region number
-    for (cellId = 0; cellId < numCells; cellId++)
+    if (this->ParallelLabeling)
     {
-      if (cellId && !(cellId % 5000))
-      {
-        this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
-      }
-
-      if (this->Visited[cellId] < 0)
+      largestRegionId = this->LabelRegionsInParallel(false);
+    }
+    else
+    {
+      for (cellId = 0; cellId < numCells; cellId++)
       {
-        this->NumCellsInRegion = 0;
-        this->Wave.push_back(cellId);
-        this->TraverseAndMark();
-
-        if (this->NumCellsInRegion > maxCellsInRegion)
+        if (cellId && !(cellId % 5000))
         {
-          maxCellsInRegion = this->NumCellsInRegion;
-          largestRegionId = this->RegionNumber;
+          this->UpdateProgress(0.1 + 0.8 * cellId / numCells);
         }
 
-        this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
-        this->Wave.clear();
-        this->Wave2.clear();
+        if (this->Visited[cellId] < 0)
+        {
+          this->NumCellsInRegion = 0;
+          this->Wave.push_back(cellId);
+          this->TraverseAndMark();
+
+          if (this->NumCellsInRegion > maxCellsInRegion)
+          {
+            maxCellsInRegion = this->NumCellsInRegion;
+            largestRegionId = this->RegionNumber;
+          }
+
+          this->RegionSizes->InsertValue(this->RegionNumber++, this->NumCellsInRegion);
+          this->Wave.clear();
+          this->Wave2.clear();
+        }
       }
     }
   }
@@ -266,7 +283,14 @@ int vtkPolyDataConnectivityFilter::RequestData(vtkInformation* vtkNotUsed(reques
     this->UpdateProgress(0.5);
 
     // mark all seeded regions
-    this->TraverseAndMark();
+    if (this->ParallelLabeling)
+    {
+      this->LabelRegionsInParallel(true);
+    }
+    else
+    {
+      this->TraverseAndMark();
+    }
     this->RegionSizes->InsertValue(this->RegionNumber, this->NumCellsInRegion);
     this->UpdateProgress(0.9);
   } // else extracted seeded cells
@@ -502,6 +526,80 @@ void vtkPolyDataConnectivityFilter::TraverseAndMark()
   } // while wave is not empty
 }
 
+// --------------------------------------------------------------------------
+// Label the regions with a concurrent union-find instead of the wave
+// propagation, see vtkLabelRegions().
+vtkIdType vtkPolyDataConnectivityFilter::LabelRegionsInParallel(bool seeded)
+{
+  const vtkIdType numCells = this->Mesh->GetNumberOfCells();
+  const vtkIdType numPts = this->Mesh->GetNumberOfPoints();
+
+  // The cells satisfying the scalar connectivity criterion, as in
+  // IsScalarConnected()
+  std::vector<unsigned char> connected;
+  if (this->InScalars)
+  {
+    connected.resize(numCells);
+    vtkPolyData* mesh = this->Mesh;
+    vtkDataArray* inScalars = this->InScalars;
+    const double* scalarRange = this->ScalarRange;
+    const bool fullScalarConnectivity = (this->FullScalarConnectivity != 0);
+    mesh->GetCellPoints(0, this->PointIds); // makes GetCellPoints() thread safe
+    vtkSMPThreadLocalObject<vtkIdList> threadPtIds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* ptIds = threadPtIds.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        mesh->GetCellPoints(cellId, ptIds);
+        double range[2] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+        for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+        {
+          const double s = static_cast<float>(inScalars->GetComponent(ptIds->GetId(i), 0));
+          range[0] = std::min(range[0], s);
+          range[1] = std::max(range[1], s);
+        }
+        connected[cellId] = (fullScalarConnectivity
+            ? (range[0] >= scalarRange[0] && range[1] <= scalarRange[1])
+            : (range[1] >= scalarRange[0] && range[0] <= scalarRange[1]));
+      }
+    });
+  }
+
+  std::vector<vtkIdType> seeds;
+  if (seeded)
+  {
+    seeds = this->Wave;
+  }
+  std::vector<vtkIdType> pointRegions(numPts);
+  std::vector<vtkIdType> regionSizes = vtkLabelRegions(this->Mesh,
+    connected.empty() ? nullptr : connected.data(), seeded ? &seeds : nullptr, this->Visited,
+    pointRegions.data());
+  const vtkIdType numRegions = static_cast<vtkIdType>(regionSizes.size());
+
+  this->PointNumber = vtkMapRegionPoints(numPts, numRegions, pointRegions.data(), this->PointMap,
+    vtkArrayDownCast<vtkIdTypeArray>(this->NewScalars)->GetPointer(0));
+
+  if (seeded)
+  {
+    this->NumCellsInRegion = regionSizes[0];
+    return 0;
+  }
+
+  // Same largest region as the serial labeling, the first one of the
+  // largest size.
+  vtkIdType largestRegionId = 0;
+  for (vtkIdType regionId = 0; regionId < numRegions; ++regionId)
+  {
+    this->RegionSizes->InsertValue(regionId, regionSizes[regionId]);
+    if (regionSizes[regionId] > regionSizes[largestRegionId])
+    {
+      largestRegionId = regionId;
+    }
+  }
+  this->RegionNumber = numRegions;
+  return largestRegionId;
+}
+
 // --------------------------------------------------------------------------
 int vtkPolyDataConnectivityFilter::IsScalarConnected(vtkIdType cellId)
 {
@@ -615,6 +713,7 @@ void vtkPolyDataConnectivityFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Color Regions: " << (this->ColorRegions ? "On\n" : "Off\n");
 
   os << indent << "Scalar Connectivity: " << (this->ScalarConnectivity ? "On\n" : "Off\n");
+  os << indent << "Parallel Labeling: " << (this->ParallelLabeling ? "On\n" : "Off\n");
 
   if (this->ScalarConnectivity)
   {
@@ -43,6 +43,13 @@
  * This use of ScalarConnectivity is particularly useful for selecting cells
  * for later processing.
  *
+ * With ParallelLabeling on, the regions are found with a concurrent
+ * union-find over the cells and their points, threaded with vtkSMPTools,
+ * instead of the serial wave propagation. The cells of each region, the
+ * region ids (ordered by the lowest cell id of each region) and the region
+ * sizes are the same; only the order of the output points differs: they are
+ * grouped by region, and ordered by input point id within each region.
+ *
  * @sa
  * vtkConnectivityFilter
  */
@@ -189,6 +196,16 @@ public:
    */
   int GetNumberOfExtractedRegions();
 
+  //@{
+  /**
+   * Turn on/off the labeling of the regions in parallel (see the class
+   * documentation). Off by default.
+   */
+  vtkSetMacro(ParallelLabeling, vtkTypeBool);
+  vtkGetMacro(ParallelLabeling, vtkTypeBool);
+  vtkBooleanMacro(ParallelLabeling, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Turn on/off the coloring of connected regions.
@@ -252,6 +269,12 @@ protected:
 
   void TraverseAndMark();
 
+  /**
+   * Label the regions with ParallelLabeling on, from the seed cells in the
+   * wave when seeded. Return the id of the largest region.
+   */
+  vtkIdType LabelRegionsInParallel(bool seeded);
+
   // used to support algorithm execution
   vtkDataArray* CellScalars;
   vtkIdList* NeighborCellPointIds;
@@ -271,6 +294,7 @@ protected:
 
   vtkTypeBool MarkVisitedPointIds;
   int OutputPointsPrecision;
+  vtkTypeBool ParallelLabeling;
 
 private:
   vtkPolyDataConnectivityFilter(const vtkPolyDataConnectivityFilter&) = delete;
@@ -0,0 +1,254 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolyDataSmoothingInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPolyDataSmoothingInternal
+ * @brief   vertex classification and connected edges of a mesh to smooth
+ *
+ * vtkPolyDataSmoothingInternal classifies the vertices of the polygons of a
+ * mesh as simple, feature edge or boundary edge vertices, from the
+ * half-edges of the mesh, and gathers the connected edges along which each
+ * vertex is smoothed. It is shared by vtkSmoothPolyDataFilter and
+ * vtkWindowedSincPolyDataFilter.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkSmoothPolyDataFilter vtkWindowedSincPolyDataFilter
+ */
+
+#ifndef vtkPolyDataSmoothingInternal_h
+#define vtkPolyDataSmoothingInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
+
+#include <vector>
+
+// The types of the vertices
+#define VTK_SIMPLE_VERTEX 0
+#define VTK_FIXED_VERTEX 1
+#define VTK_FEATURE_EDGE_VERTEX 2
+#define VTK_BOUNDARY_EDGE_VERTEX 3
+
+// Flags of the polygon half-edges, in addition to the vertex type
+#define VTK_VISITED_EDGE 4
+#define VTK_ADDED_TO_ORIGIN 8
+#define VTK_ADDED_TO_DESTINATION 16
+
+namespace
+{ // anonymous namespace
+
+// Special structure for marking vertices. The connected edges (lists of
+// connected point ids) of all the vertices are stored contiguously.
+struct vtkMeshVertices
+{
+  std::vector<char> Types;
+  std::vector<vtkIdType> EdgeOffsets;
+  std::vector<vtkIdType> Edges;
+
+  // The two connected edges of the vertices inside lines, or -1
+  std::vector<vtkIdType> LineEdges;
+
+  vtkIdType GetNumberOfEdges(vtkIdType ptId) const
+  {
+    return this->EdgeOffsets[ptId + 1] - this->EdgeOffsets[ptId];
+  }
+  const vtkIdType* GetEdges(vtkIdType ptId) const
+  {
+    return this->Edges.data() + this->EdgeOffsets[ptId];
+  }
+};
+
+// Analyze the edges of the polygons in parallel. Each half-edge gets the
+// vertex type its edge implies, or VTK_VISITED_EDGE if the edge is analyzed
+// from a neighbor polygon. With nonManifoldSmoothing, the non-manifold edges
+// are smoothed as simple edges.
+void vtkClassifyMeshEdges(vtkPoints* inPts,
+  const vtkStaticHalfEdgeMeshTemplate<vtkIdType>& halfEdges, bool featureEdgeSmoothing,
+  bool nonManifoldSmoothing, double cosFeatureAngle, unsigned char* edgeTypes)
+{
+  vtkCellArray* polys = halfEdges.GetCells();
+  vtkSMPThreadLocalObject<vtkIdList> threadCellPts;
+  vtkSMPThreadLocalObject<vtkIdList> threadNeiPts;
+  vtkSMPTools::For(0, halfEdges.GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkIdList* cellPts = threadCellPts.Local();
+    vtkIdList* neiPts = threadNeiPts.Local();
+    double normal[3], neiNormal[3];
+    for (; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType beginHalfEdge = halfEdges.GetCellHalfEdge(cellId);
+      const vtkIdType endHalfEdge = beginHalfEdge + halfEdges.GetCellSize(cellId);
+      bool hasNormal = false;
+      for (vtkIdType heId = beginHalfEdge; heId < endHalfEdge; ++heId)
+      {
+        // The smallest neighbor polygon using the edge
+        const vtkIdType numNei = halfEdges.GetNumberOfEdgeNeighbors(heId);
+        vtkIdType nei = VTK_ID_MAX;
+        for (vtkIdType mate = halfEdges.GetMate(heId); mate != heId; mate = halfEdges.GetMate(mate))
+        {
+          const vtkIdType mateCellId = halfEdges.GetCell(mate);
+          if (mateCellId != cellId && mateCellId < nei)
+          {
+            nei = mateCellId;
+          }
+        }
+
+        unsigned char edge = VTK_SIMPLE_VERTEX;
+        if (numNei == 0)
+        {
+          edge = VTK_BOUNDARY_EDGE_VERTEX;
+        }
+
+        else if (numNei >= 2)
+        {
+          // non-manifold case, check nonmanifold smoothing state, and make
+          // sure that this edge hasn't been marked already
+          if (!nonManifoldSmoothing && nei > cellId)
+          {
+            edge = VTK_FEATURE_EDGE_VERTEX;
+          }
+        }
+
+        else if (nei > cellId)
+        {
+          if (featureEdgeSmoothing)
+          {
+            if (!hasNormal)
+            {
+              polys->GetCellAtId(cellId, cellPts);
+              vtkPolygon::ComputeNormal(
+                inPts, cellPts->GetNumberOfIds(), cellPts->GetPointer(0), normal);
+              hasNormal = true;
+            }
+            polys->GetCellAtId(nei, neiPts);
+            vtkPolygon::ComputeNormal(
+              inPts, neiPts->GetNumberOfIds(), neiPts->GetPointer(0), neiNormal);
+
+            if (vtkMath::Dot(normal, neiNormal) <= cosFeatureAngle)
+            {
+              edge = VTK_FEATURE_EDGE_VERTEX;
+            }
+          }
+        }
+        else // a visited edge; skip rest of analysis
+        {
+          edge = VTK_VISITED_EDGE;
+        }
+        edgeTypes[heId] = edge;
+      }
+    }
+  });
+}
+
+// Add the analyzed polygon edges to the connected edges of their points,
+// and store the connected edges of all the vertices. The type of a vertex
+// depends on the order its edges are visited in, so this follows the order
+// of the polygons: a first pass sets the vertex types and counts the
+// connected edges kept after the last reset of each list, then a second pass
+// fills them in.
+void vtkBuildMeshEdges(const vtkStaticHalfEdgeMeshTemplate<vtkIdType>& halfEdges,
+  unsigned char* edgeTypes, vtkMeshVertices& verts)
+{
+  const vtkIdType numPts = static_cast<vtkIdType>(verts.Types.size());
+  const vtkIdType numHalfEdges = halfEdges.GetNumberOfHalfEdges();
+  const bool hasLines = !verts.LineEdges.empty();
+  std::vector<vtkIdType> counts(numPts, 0);
+  std::vector<vtkIdType> firstKept(numPts, 0);
+  for (vtkIdType ptId = 0; hasLines && ptId < numPts; ++ptId)
+  {
+    counts[ptId] = (verts.LineEdges[2 * ptId] >= 0 ? 2 : 0);
+  }
+
+  for (vtkIdType heId = 0; heId < numHalfEdges; ++heId)
+  {
+    const unsigned char edge = edgeTypes[heId];
+    if (edge == VTK_VISITED_EDGE)
+    {
+      continue;
+    }
+    for (int end = 0; end < 2; ++end)
+    {
+      const vtkIdType ptId = (end ? halfEdges.GetDestination(heId) : halfEdges.GetOrigin(heId));
+      char& type = verts.Types[ptId];
+      if (edge && type == VTK_SIMPLE_VERTEX)
+      {
+        counts[ptId] = 1;
+        firstKept[ptId] = heId;
+        type = edge;
+      }
+      else if ((edge && type == VTK_BOUNDARY_EDGE_VERTEX) ||
+        (edge && type == VTK_FEATURE_EDGE_VERTEX) || (!edge && type == VTK_SIMPLE_VERTEX))
+      {
+        ++counts[ptId];
+        if (type && edge == VTK_BOUNDARY_EDGE_VERTEX)
+        {
+          type = VTK_BOUNDARY_EDGE_VERTEX;
+        }
+      }
+      else
+      {
+        continue;
+      }
+      edgeTypes[heId] |= (end ? VTK_ADDED_TO_DESTINATION : VTK_ADDED_TO_ORIGIN);
+    }
+  }
+
+  // Prefix sum, then fill in the edges. The counts are reused as insertion
+  // positions.
+  verts.EdgeOffsets.resize(numPts + 1);
+  verts.EdgeOffsets[0] = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    verts.EdgeOffsets[ptId + 1] = verts.EdgeOffsets[ptId] + counts[ptId];
+    counts[ptId] = verts.EdgeOffsets[ptId];
+  }
+  verts.Edges.resize(verts.EdgeOffsets[numPts]);
+  for (vtkIdType ptId = 0; hasLines && ptId < numPts; ++ptId)
+  {
+    if (verts.LineEdges[2 * ptId] >= 0)
+    {
+      verts.Edges[counts[ptId]++] = verts.LineEdges[2 * ptId];
+      verts.Edges[counts[ptId]++] = verts.LineEdges[2 * ptId + 1];
+    }
+  }
+  for (vtkIdType heId = 0; heId < numHalfEdges; ++heId)
+  {
+    const vtkIdType p1 = halfEdges.GetOrigin(heId);
+    const vtkIdType p2 = halfEdges.GetDestination(heId);
+    if ((edgeTypes[heId] & VTK_ADDED_TO_ORIGIN) && heId >= firstKept[p1])
+    {
+      verts.Edges[counts[p1]++] = p2;
+    }
+    if ((edgeTypes[heId] & VTK_ADDED_TO_DESTINATION) && heId >= firstKept[p2])
+    {
+      verts.Edges[counts[p2]++] = p1;
+    }
+  }
+}
+
+} // anonymous namespace
+
+#endif // vtkPolyDataSmoothingInternal_h
+// VTK-HeaderTest-Exclude: vtkPolyDataSmoothingInternal.h
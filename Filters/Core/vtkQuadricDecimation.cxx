@@ -46,6 +46,7 @@
 #include "vtkEdgeTable.h"
 #include "vtkGenericCell.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -53,8 +54,490 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPriorityQueue.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
 #include "vtkTriangle.h"
 
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Compute the quadric of the triangle (p0, p1, p2) in QEM. The vertices hold
+// the point coordinates followed by numComps scaled attribute values. The
+// plane of the triangle is returned in n and d, and half of its area in area.
+// Return false if the attribute part of the quadric could not be computed,
+// in which case the attribute entries of QEM are left untouched.
+bool ComputeTriangleQuadric(const double* p0, const double* p1, const double* p2, int numComps,
+  bool attributes, double* QEM, double n[3], double& d, double& area)
+{
+  double tempP1[3], tempP2[3];
+  double data[16];
+  double *A[4], x[4];
+  int index[4];
+  A[0] = data;
+  A[1] = data + 4;
+  A[2] = data + 8;
+  A[3] = data + 12;
+
+  for (int i = 0; i < 3; i++)
+  {
+    tempP1[i] = p1[i] - p0[i];
+    tempP2[i] = p2[i] - p0[i];
+  }
+  vtkMath::Cross(tempP1, tempP2, n);
+  area = vtkMath::Normalize(n);
+  // area = (area * area * 0.25);
+  area = area * 0.5;
+  // I am unsure whether this should be squared or not??
+  d = -vtkMath::Dot(n, p0);
+  // could possible add in angle weights??
+
+  // set the geometric part of the QEM
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+  QEM[10] = 1;
+
+  if (!attributes)
+  {
+    return true;
+  }
+
+  for (int i = 0; i < 3; i++)
+  {
+    A[0][i] = p0[i];
+    A[1][i] = p1[i];
+    A[2][i] = p2[i];
+    A[3][i] = n[i];
+  }
+  A[0][3] = A[1][3] = A[2][3] = 1;
+  A[3][3] = 0;
+
+  // should handle poorly condition matrix better
+  if (!vtkMath::LUFactorLinearSystem(A, index, 4))
+  {
+    return false;
+  }
+  for (int i = 0; i < numComps; i++)
+  {
+    x[0] = p0[3 + i];
+    x[1] = p1[3 + i];
+    x[2] = p2[3 + i];
+    x[3] = 0;
+    vtkMath::LUSolveLinearSystem(A, index, x, 4);
+
+    // add in the contribution of this element into the QEM
+    QEM[0] += x[0] * x[0];
+    QEM[1] += x[0] * x[1];
+    QEM[2] += x[0] * x[2];
+    QEM[3] += x[3] * x[0];
+
+    QEM[4] += x[1] * x[1];
+    QEM[5] += x[1] * x[2];
+    QEM[6] += x[3] * x[1];
+
+    QEM[7] += x[2] * x[2];
+    QEM[8] += x[3] * x[2];
+
+    QEM[9] += x[3] * x[3];
+
+    QEM[11 + i * 4] = -x[0];
+    QEM[12 + i * 4] = -x[1];
+    QEM[13 + i * 4] = -x[2];
+    QEM[14 + i * 4] = -x[3];
+  }
+  return true;
+}
+
+// Compute the geometric part of the quadric constraining the free boundary
+// edge (t1, t2) of the triangle (t0, t1, t2) in QEM, and return its weight.
+double ComputeBoundaryQuadric(
+  const double t0[3], const double t1[3], const double t2[3], double* QEM)
+{
+  double e0[3], e1[3], n[3], c, d, w;
+  int j;
+
+  // computing a plane which is orthogonal to line t1, t2 and incident
+  // with it
+  for (j = 0; j < 3; j++)
+  {
+    e0[j] = t2[j] - t1[j];
+  }
+  for (j = 0; j < 3; j++)
+  {
+    e1[j] = t0[j] - t1[j];
+  }
+
+  // compute n so that it is orthogonal to e0 and parallel to the
+  // triangle
+  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (j = 0; j < 3; j++)
+  {
+    n[j] = e1[j] - c * e0[j];
+  }
+  vtkMath::Normalize(n);
+  d = -vtkMath::Dot(n, t1);
+  w = vtkMath::Norm(e0);
+
+  // w *= w;
+  // area issue ??
+  // could possible add in angle weights??
+  QEM[0] = n[0] * n[0];
+  QEM[1] = n[0] * n[1];
+  QEM[2] = n[0] * n[2];
+  QEM[3] = d * n[0];
+
+  QEM[4] = n[1] * n[1];
+  QEM[5] = n[1] * n[2];
+  QEM[6] = d * n[1];
+
+  QEM[7] = n[2] * n[2];
+  QEM[8] = d * n[2];
+
+  QEM[9] = d * d;
+
+  QEM[10] = 1;
+
+  return w;
+}
+
+// Compute the geometric cost of collapsing an edge and the point that gives
+// this cost. quad is the sum of the quadrics of the end points of the edge,
+// and getEndPoints(pt1, pt2) returns the coordinates of the end points.
+template <typename TGetEndPoints>
+double ComputeGeometricCost(const double* quad, TGetEndPoints&& getEndPoints, double* x)
+{
+  static const double errorNumber = 1e-10;
+  double temp[3], A[3][3], b[3];
+  double cost = 0.0;
+  const double* index;
+  int i, j;
+  double newPoint[4];
+  double v[3], c, norm, normTemp, temp2[3];
+  double pt1[3], pt2[3];
+
+  A[0][0] = quad[0];
+  A[0][1] = A[1][0] = quad[1];
+  A[0][2] = A[2][0] = quad[2];
+  A[1][1] = quad[4];
+  A[1][2] = A[2][1] = quad[5];
+  A[2][2] = quad[7];
+
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+
+  norm = vtkMath::Norm(A[0]);
+  normTemp = vtkMath::Norm(A[1]);
+  norm = norm > normTemp ? norm : normTemp;
+  normTemp = vtkMath::Norm(A[2]);
+  norm = norm > normTemp ? norm : normTemp;
+
+  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
+  {
+    // it would be better to use the normal of the matrix to test singularity??
+    vtkMath::LinearSolve3x3(A, b, x);
+    vtkMath::Multiply3x3(A, x, temp);
+    // error too high, backup plans
+  }
+  else
+  {
+    // cheapest point along the edge
+    getEndPoints(pt1, pt2);
+    v[0] = pt2[0] - pt1[0];
+    v[1] = pt2[1] - pt1[1];
+    v[2] = pt2[2] - pt1[2];
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    vtkMath::Multiply3x3(A, v, temp2);
+    if (vtkMath::Dot(temp2, temp2) > errorNumber)
+    {
+      vtkMath::Multiply3x3(A, pt1, temp);
+      for (i = 0; i < 3; i++)
+        temp[i] = b[i] - temp[i];
+      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
+      for (i = 0; i < 3; i++)
+        x[i] = pt1[i] + c * v[i];
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (i = 0; i < 3; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  newPoint[0] = x[0];
+  newPoint[1] = x[1];
+  newPoint[2] = x[2];
+  newPoint[3] = 1;
+
+  // Compute the cost
+  // x'*quad*x
+  index = quad;
+  for (i = 0; i < 4; i++)
+  {
+    cost += (*index++) * newPoint[i] * newPoint[i];
+    for (j = i + 1; j < 4; j++)
+    {
+      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
+    }
+  }
+
+  return cost;
+}
+
+// Compute the cost of collapsing an edge, including the attribute errors,
+// and the point and attributes that give this cost. quad is the sum of the
+// quadrics of the end points of the edge, volume the sum of their volume
+// constraints (nullptr without volume preservation), A and b are work
+// arrays of the size of x, and getEndPoints(pt1, pt2) returns the coordinates
+// and scaled attributes of the end points.
+template <typename TGetEndPoints>
+double ComputeAttributeCost(const double* quad, const double* volume, int numComps, double** A,
+  double* b, TGetEndPoints&& getEndPoints, double* x)
+{
+  static const double errorNumber = 1e-10;
+  const int volumePreservation = volume ? 1 : 0;
+  double cost = 0.0;
+  int i, j;
+  int solveOk;
+
+  // copy the quad into A
+  // converting from the sparse matrix format into a dense
+  auto fillMatrix = [&]() {
+    A[0][0] = quad[0];
+    A[0][1] = A[1][0] = quad[1];
+    A[0][2] = A[2][0] = quad[2];
+    A[1][1] = quad[4];
+    A[1][2] = A[2][1] = quad[5];
+    A[2][2] = quad[7];
+
+    for (i = 3; i < 3 + numComps; i++)
+    {
+      A[0][i] = A[i][0] = quad[11 + 4 * (i - 3)];
+      A[1][i] = A[i][1] = quad[11 + 4 * (i - 3) + 1];
+      A[2][i] = A[i][2] = quad[11 + 4 * (i - 3) + 2];
+    }
+
+    // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
+    for (i = 3; i < 3 + numComps; i++)
+    {
+      for (j = 3; j < 3 + numComps; j++)
+      {
+        if (i == j)
+        {
+          A[i][j] = quad[10];
+        }
+        else
+        {
+          A[i][j] = 0;
+        }
+      }
+    }
+    if (volumePreservation)
+    {
+      // Add row/col for volume constraint
+      for (i = 0; i < 3 + numComps + 1; i++)
+      {
+        if (i >= 3)
+        {
+          A[i][3 + numComps] = 0;
+          A[3 + numComps][i] = 0;
+        }
+        else
+        {
+          A[i][3 + numComps] = volume[i];
+          A[3 + numComps][i] = volume[i];
+        }
+      }
+    }
+  };
+
+  fillMatrix();
+  b[0] = -quad[3];
+  b[1] = -quad[6];
+  b[2] = -quad[8];
+  for (i = 3; i < 3 + numComps; i++)
+  {
+    b[i] = -quad[11 + 4 * (i - 3) + 3];
+  }
+  if (volumePreservation)
+  {
+    // Add constraint to b
+    b[3 + numComps] = volume[3];
+  }
+
+  for (i = 0; i < 3 + numComps + volumePreservation; i++)
+  {
+    x[i] = b[i];
+  }
+
+  // solve A*x = b
+  // this clobers A
+  // need to develop a quality of the solution test??
+  solveOk = vtkMath::SolveLinearSystem(A, x, 3 + numComps + volumePreservation);
+
+  // need to copy back into A
+  fillMatrix();
+
+  // check for failure to solve the system
+  if (!solveOk)
+  {
+    // cheapest point along the edge
+    // this should not frequently occur, so I am using dynamic allocation
+    std::vector<double> pt1(3 + numComps);
+    std::vector<double> pt2(3 + numComps);
+    std::vector<double> v(3 + numComps);
+    std::vector<double> temp(3 + numComps);
+    std::vector<double> temp2(3 + numComps);
+    double d = 0;
+    double c = 0;
+
+    getEndPoints(pt1.data(), pt2.data());
+    for (i = 0; i < 3 + numComps; ++i)
+    {
+      v[i] = pt2[i] - pt1[i];
+    }
+
+    // equation for the edge pt1 + c * v
+    // attempt least squares fit for c for A*(pt1 + c * v) = b
+    // temp2 = A*v
+    for (i = 0; i < 3 + numComps; ++i)
+    {
+      temp2[i] = 0;
+      for (j = 0; j < 3 + numComps; ++j)
+      {
+        temp2[i] += A[i][j] * v[j];
+      }
+    }
+
+    // c = v dot v
+    for (i = 0; i < 3 + numComps; ++i)
+    {
+      d += temp2[i] * temp2[i];
+    }
+
+    if (d > errorNumber)
+    {
+      // temp = A*pt1
+      for (i = 0; i < 3 + numComps; ++i)
+      {
+        temp[i] = 0;
+        for (j = 0; j < 3 + numComps; ++j)
+        {
+          temp[i] += A[i][j] * pt1[j];
+        }
+      }
+
+      for (i = 0; i < 3 + numComps; i++)
+      {
+        temp[i] = b[i] - temp[i];
+      }
+
+      for (i = 0; i < 3 + numComps; i++)
+      {
+        c += temp2[i] * temp[i];
+      }
+      c = c / d;
+
+      for (i = 0; i < 3 + numComps; i++)
+      {
+        x[i] = pt1[i] + c * v[i];
+      }
+    }
+    else
+    {
+      // use mid point
+      // might want to change to best of mid and end points??
+      for (i = 0; i < 3 + numComps; i++)
+      {
+        x[i] = 0.5 * (pt1[i] + pt2[i]);
+      }
+    }
+  }
+
+  // Compute the cost
+  // x'*A*x - 2*b*x + d
+  for (i = 0; i < 3 + numComps + volumePreservation; i++)
+  {
+    cost += A[i][i] * x[i] * x[i];
+    for (j = i + 1; j < 3 + numComps + volumePreservation; j++)
+    {
+      cost += 2.0 * A[i][j] * x[i] * x[j];
+    }
+  }
+  for (i = 0; i < 3 + numComps + volumePreservation; i++)
+  {
+    cost -= 2.0 * b[i] * x[i];
+  }
+
+  cost += quad[9];
+
+  return cost;
+}
+
+// triangle t0, t1, t2 and point x
+// determines if t0 and x are on the same side of the plane defined by
+// t1 and t2, and parallel to the normal of the triangle
+int TrianglePlaneCheck(const double t0[3], const double t1[3], const double t2[3], const double* x)
+{
+  double e0[3], e1[3], n[3], e2[3];
+  double c;
+  int i;
+
+  for (i = 0; i < 3; i++)
+  {
+    e0[i] = t2[i] - t1[i];
+  }
+  for (i = 0; i < 3; i++)
+  {
+    e1[i] = t0[i] - t1[i];
+  }
+
+  // projection of e0 onto e1
+  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
+  for (i = 0; i < 3; i++)
+  {
+    n[i] = e1[i] - c * e0[i];
+  }
+
+  for (i = 0; i < 3; i++)
+  {
+    e2[i] = x[i] - t1[i];
+  }
+
+  vtkMath::Normalize(n);
+  vtkMath::Normalize(e2);
+  if (vtkMath::Dot(n, e2) > 1e-5)
+  {
+    return 1;
+  }
+  else
+  {
+    return 0;
+  }
+}
+}
+
 vtkStandardNewMacro(vtkQuadricDecimation);
 
 //----------------------------------------------------------------------------
@@ -87,6 +570,7 @@ vtkQuadricDecimation::vtkQuadricDecimation()
   this->TensorsWeight = 0.1;
 
   this->ActualReduction = 0.0;
+  this->ParallelDecimation = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -215,6 +699,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  if (this->ParallelDecimation)
+  {
+    this->DecimateInParallel(input, output);
+    return 1;
+  }
+
   polys = vtkCellArray::New();
   points = vtkPoints::New();
   pointData = vtkPointData::New();
@@ -407,9 +897,12 @@ int vtkQuadricDecimation::RequestData(vtkInformation* vtkNotUsed(request),
   {
     if (nullptr != (attrib = output->GetPointData()->GetNormals()))
     {
+      double n[3];
       for (i = 0; i < attrib->GetNumberOfTuples(); i++)
       {
-        vtkMath::Normalize(attrib->GetTuple3(i));
+        attrib->GetTuple(i, n);
+        vtkMath::Normalize(n);
+        attrib->SetTuple(i, n);
       }
     }
     // might want to add clamping texture coordinates??
@@ -428,16 +921,10 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   vtkCellArray* polys;
   vtkIdType npts;
   const vtkIdType* pts = nullptr;
-  double point0[3], point1[3], point2[3];
-  double n[3];
-  double tempP1[3], tempP2[3], d, triArea2;
-  double data[16];
-  double *A[4], x[4];
-  int index[4];
-  A[0] = data;
-  A[1] = data + 4;
-  A[2] = data + 8;
-  A[3] = data + 12;
+  std::vector<double> point0(3 + this->NumberOfComponents);
+  std::vector<double> point1(3 + this->NumberOfComponents);
+  std::vector<double> point2(3 + this->NumberOfComponents);
+  double n[3], d, triArea2;
 
   // allocate local QEM sparse matrix
   QEM = new double[11 + 4 * this->NumberOfComponents];
@@ -456,140 +943,13 @@ void vtkQuadricDecimation::InitializeQuadrics(vtkIdType numPts)
   // compute the QEM for each face
   for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
   {
-    input->GetPoint(pts[0], point0);
-    input->GetPoint(pts[1], point1);
-    input->GetPoint(pts[2], point2);
-    for (i = 0; i < 3; i++)
+    this->GetPointAttributeArray(pts[0], point0.data());
+    this->GetPointAttributeArray(pts[1], point1.data());
+    this->GetPointAttributeArray(pts[2], point2.data());
+    if (!ComputeTriangleQuadric(point0.data(), point1.data(), point2.data(),
+          this->NumberOfComponents, this->AttributeErrorMetric != 0, QEM, n, d, triArea2))
     {
-      tempP1[i] = point1[i] - point0[i];
-      tempP2[i] = point2[i] - point0[i];
-    }
-    vtkMath::Cross(tempP1, tempP2, n);
-    triArea2 = vtkMath::Normalize(n);
-    // triArea2 = (triArea2 * triArea2 * 0.25);
-    triArea2 = triArea2 * 0.5;
-    // I am unsure whether this should be squared or not??
-    d = -vtkMath::Dot(n, point0);
-    // could possible add in angle weights??
-
-    // set the geometric part of the QEM
-    QEM[0] = n[0] * n[0];
-    QEM[1] = n[0] * n[1];
-    QEM[2] = n[0] * n[2];
-    QEM[3] = d * n[0];
-
-    QEM[4] = n[1] * n[1];
-    QEM[5] = n[1] * n[2];
-    QEM[6] = d * n[1];
-
-    QEM[7] = n[2] * n[2];
-    QEM[8] = d * n[2];
-
-    QEM[9] = d * d;
-    QEM[10] = 1;
-
-    if (this->AttributeErrorMetric)
-    {
-      for (i = 0; i < 3; i++)
-      {
-        A[0][i] = point0[i];
-        A[1][i] = point1[i];
-        A[2][i] = point2[i];
-        A[3][i] = n[i];
-      }
-      A[0][3] = A[1][3] = A[2][3] = 1;
-      A[3][3] = 0;
-
-      // should handle poorly condition matrix better
-      if (vtkMath::LUFactorLinearSystem(A, index, 4))
-      {
-        for (i = 0; i < this->NumberOfComponents; i++)
-        {
-          x[3] = 0;
-          if (i < this->AttributeComponents[0])
-          {
-            x[0] = input->GetPointData()->GetScalars()->GetComponent(pts[0], i) *
-              this->AttributeScale[0];
-            x[1] = input->GetPointData()->GetScalars()->GetComponent(pts[1], i) *
-              this->AttributeScale[0];
-            x[2] = input->GetPointData()->GetScalars()->GetComponent(pts[2], i) *
-              this->AttributeScale[0];
-          }
-          else if (i < this->AttributeComponents[1])
-          {
-            x[0] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[1] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-            x[2] = input->GetPointData()->GetVectors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[0]) *
-              this->AttributeScale[1];
-          }
-          else if (i < this->AttributeComponents[2])
-          {
-            x[0] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[0], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[1] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[1], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-            x[2] = input->GetPointData()->GetNormals()->GetComponent(
-                     pts[2], i - this->AttributeComponents[1]) *
-              this->AttributeScale[2];
-          }
-          else if (i < this->AttributeComponents[3])
-          {
-            x[0] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[0], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[1] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[1], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-            x[2] = input->GetPointData()->GetTCoords()->GetComponent(
-                     pts[2], i - this->AttributeComponents[2]) *
-              this->AttributeScale[3];
-          }
-          else if (i < this->AttributeComponents[4])
-          {
-            x[0] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[0], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[1] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[1], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-            x[2] = input->GetPointData()->GetTensors()->GetComponent(
-                     pts[2], i - this->AttributeComponents[3]) *
-              this->AttributeScale[4];
-          }
-          vtkMath::LUSolveLinearSystem(A, index, x, 4);
-
-          // add in the contribution of this element into the QEM
-          QEM[0] += x[0] * x[0];
-          QEM[1] += x[0] * x[1];
-          QEM[2] += x[0] * x[2];
-          QEM[3] += x[3] * x[0];
-
-          QEM[4] += x[1] * x[1];
-          QEM[5] += x[1] * x[2];
-          QEM[6] += x[3] * x[1];
-
-          QEM[7] += x[2] * x[2];
-          QEM[8] += x[3] * x[2];
-
-          QEM[9] += x[3] * x[3];
-
-          QEM[11 + i * 4] = -x[0];
-          QEM[12 + i * 4] = -x[1];
-          QEM[13 + i * 4] = -x[2];
-          QEM[14 + i * 4] = -x[3];
-        }
-      }
-      else
-      {
-        vtkErrorMacro(<< "Unable to factor attribute matrix!");
-      }
+      vtkErrorMacro(<< "Unable to factor attribute matrix!");
     }
 
     // add the QEM to all points of the face
@@ -627,67 +987,29 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
   int i, j;
   vtkIdType npts;
   const vtkIdType* pts;
-  double t0[3], t1[3], t2[3];
-  double e0[3], e1[3], n[3], c, d, w;
-  vtkIdList* cellIds = vtkIdList::New();
-
-  // allocate local QEM space matrix
-  QEM = new double[11 + 4 * this->NumberOfComponents];
-
-  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
-  {
-    input->GetCellPoints(cellId, npts, pts);
-
-    for (i = 0; i < 3; i++)
-    {
-      input->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % 3], cellIds);
-      if (cellIds->GetNumberOfIds() == 0)
-      {
-        // this is a boundary
-        input->GetPoint(pts[(i + 2) % 3], t0);
-        input->GetPoint(pts[i], t1);
-        input->GetPoint(pts[(i + 1) % 3], t2);
-
-        // computing a plane which is orthogonal to line t1, t2 and incident
-        // with it
-        for (j = 0; j < 3; j++)
-        {
-          e0[j] = t2[j] - t1[j];
-        }
-        for (j = 0; j < 3; j++)
-        {
-          e1[j] = t0[j] - t1[j];
-        }
-
-        // compute n so that it is orthogonal to e0 and parallel to the
-        // triangle
-        c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-        for (j = 0; j < 3; j++)
-        {
-          n[j] = e1[j] - c * e0[j];
-        }
-        vtkMath::Normalize(n);
-        d = -vtkMath::Dot(n, t1);
-        w = vtkMath::Norm(e0);
-
-        // w *= w;
-        // area issue ??
-        // could possible add in angle weights??
-        QEM[0] = n[0] * n[0];
-        QEM[1] = n[0] * n[1];
-        QEM[2] = n[0] * n[2];
-        QEM[3] = d * n[0];
+  double t0[3], t1[3], t2[3];
+  double w;
 
-        QEM[4] = n[1] * n[1];
-        QEM[5] = n[1] * n[2];
-        QEM[6] = d * n[1];
+  // allocate local QEM space matrix
+  QEM = new double[11 + 4 * this->NumberOfComponents];
 
-        QEM[7] = n[2] * n[2];
-        QEM[8] = d * n[2];
+  // the boundary edges are those without edge neighbors
+  vtkStaticHalfEdgeMeshTemplate<vtkIdType> halfEdges;
+  halfEdges.BuildHalfEdges(input);
 
-        QEM[9] = d * d;
+  for (cellId = 0; cellId < input->GetNumberOfCells(); cellId++)
+  {
+    input->GetCellPoints(cellId, npts, pts);
 
-        QEM[10] = 1;
+    for (i = 0; i < 3; i++)
+    {
+      if (halfEdges.GetNumberOfEdgeNeighbors(halfEdges.GetCellHalfEdge(cellId) + i) == 0)
+      {
+        // this is a boundary
+        input->GetPoint(pts[(i + 2) % 3], t0);
+        input->GetPoint(pts[i], t1);
+        input->GetPoint(pts[(i + 1) % 3], t2);
+        w = ComputeBoundaryQuadric(t0, t1, t2, QEM);
 
         // need to add orthogonal plane with the other Attributes, but this
         // is not clear??
@@ -700,7 +1022,6 @@ void vtkQuadricDecimation::AddBoundaryConstraints()
       }
     }
   }
-  cellIds->Delete();
   delete[] QEM;
 }
 
@@ -849,345 +1170,55 @@ void vtkQuadricDecimation::UpdateEdgeData(vtkIdType pt0Id, vtkIdType pt1Id)
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost(vtkIdType edgeId, double* x)
 {
-  static const double errorNumber = 1e-10;
-  double temp[3], A[3][3], b[3];
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  double* index;
-  int i, j;
-  double newPoint[4];
-  double v[3], c, norm, normTemp, temp2[3];
-  double pt1[3], pt2[3];
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
-  for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+  for (int i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
     this->TempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
 
-  A[0][0] = this->TempQuad[0];
-  A[0][1] = A[1][0] = this->TempQuad[1];
-  A[0][2] = A[2][0] = this->TempQuad[2];
-  A[1][1] = this->TempQuad[4];
-  A[1][2] = A[2][1] = this->TempQuad[5];
-  A[2][2] = this->TempQuad[7];
-
-  b[0] = -this->TempQuad[3];
-  b[1] = -this->TempQuad[6];
-  b[2] = -this->TempQuad[8];
-
-  norm = vtkMath::Norm(A[0]);
-  normTemp = vtkMath::Norm(A[1]);
-  norm = norm > normTemp ? norm : normTemp;
-  normTemp = vtkMath::Norm(A[2]);
-  norm = norm > normTemp ? norm : normTemp;
-
-  if (fabs(vtkMath::Determinant3x3(A)) / (norm * norm * norm) > errorNumber)
-  {
-    // it would be better to use the normal of the matrix to test singularity??
-    vtkMath::LinearSolve3x3(A, b, x);
-    vtkMath::Multiply3x3(A, x, temp);
-    // error too high, backup plans
-  }
-  else
-  {
-    // cheapest point along the edge
-    this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
-    this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
-    v[0] = pt2[0] - pt1[0];
-    v[1] = pt2[1] - pt1[1];
-    v[2] = pt2[2] - pt1[2];
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    vtkMath::Multiply3x3(A, v, temp2);
-    if (vtkMath::Dot(temp2, temp2) > errorNumber)
-    {
-      vtkMath::Multiply3x3(A, pt1, temp);
-      for (i = 0; i < 3; i++)
-        temp[i] = b[i] - temp[i];
-      c = vtkMath::Dot(temp2, temp) / vtkMath::Dot(temp2, temp2);
-      for (i = 0; i < 3; i++)
-        x[i] = pt1[i] + c * v[i];
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-  }
-
-  newPoint[0] = x[0];
-  newPoint[1] = x[1];
-  newPoint[2] = x[2];
-  newPoint[3] = 1;
-
-  // Compute the cost
-  // x'*quad*x
-  index = this->TempQuad;
-  for (i = 0; i < 4; i++)
-  {
-    cost += (*index++) * newPoint[i] * newPoint[i];
-    for (j = i + 1; j < 4; j++)
-    {
-      cost += 2.0 * (*index++) * newPoint[i] * newPoint[j];
-    }
-  }
-
-  return cost;
+  return ComputeGeometricCost(this->TempQuad,
+    [&](double* pt1, double* pt2) {
+      this->Mesh->GetPoints()->GetPoint(pointIds[0], pt1);
+      this->Mesh->GetPoints()->GetPoint(pointIds[1], pt2);
+    },
+    x);
 }
 
 //----------------------------------------------------------------------------
 double vtkQuadricDecimation::ComputeCost2(vtkIdType edgeId, double* x)
 {
-  // this function is so ugly because the functionality of converting an QEM
-  // into a dense matrix was not extracted into a separate function and
-  // neither was multiplication and some other matrix and vector primitives
-  static const double errorNumber = 1e-10;
   vtkIdType pointIds[2];
-  double cost = 0.0;
-  int i, j;
-  int solveOk;
+  double volume[4];
 
   pointIds[0] = this->EndPoint1List->GetId(edgeId);
   pointIds[1] = this->EndPoint2List->GetId(edgeId);
 
-  for (i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
+  for (int i = 0; i < 11 + 4 * this->NumberOfComponents; i++)
   {
     this->TempQuad[i] =
       this->ErrorQuadrics[pointIds[0]].Quadric[i] + this->ErrorQuadrics[pointIds[1]].Quadric[i];
   }
-
-  // copy the temp quad into TempA
-  // converting from the sparse matrix format into a dense
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
-
-  this->TempB[0] = -this->TempQuad[3];
-  this->TempB[1] = -this->TempQuad[6];
-  this->TempB[2] = -this->TempQuad[8];
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-    this->TempB[i] = -this->TempQuad[11 + 4 * (i - 3) + 3];
-  }
-
-  // Set zero to all components of the submatrix a[3:n;3:n] and al to its diagonal
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    for (j = 3; j < 3 + this->NumberOfComponents; j++)
-    {
-      if (i == j)
-      {
-        this->TempA[i][j] = this->TempQuad[10];
-      }
-      else
-      {
-        this->TempA[i][j] = 0;
-      }
-    }
-  }
-  if (this->VolumePreservation)
-  {
-    // Add row/col for volume constraint
-    for (i = 0; i < 3 + this->NumberOfComponents + 1; i++)
-    {
-      if (i >= 3)
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
-      }
-      else
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-      }
-    }
-    // Add constraint to b
-    this->TempB[3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + 3];
-    this->TempB[3 + this->NumberOfComponents] += this->VolumeConstraints[pointIds[1] * 4 + 3];
-  }
-
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    x[i] = this->TempB[i];
-  }
-
-  // solve A*x = b
-  // this clobers A
-  // need to develop a quality of the solution test??
-  solveOk = vtkMath::SolveLinearSystem(
-    this->TempA, x, 3 + this->NumberOfComponents + this->VolumePreservation);
-
-  // need to copy back into A
-  this->TempA[0][0] = this->TempQuad[0];
-  this->TempA[0][1] = this->TempA[1][0] = this->TempQuad[1];
-  this->TempA[0][2] = this->TempA[2][0] = this->TempQuad[2];
-  this->TempA[1][1] = this->TempQuad[4];
-  this->TempA[1][2] = this->TempA[2][1] = this->TempQuad[5];
-  this->TempA[2][2] = this->TempQuad[7];
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    this->TempA[0][i] = this->TempA[i][0] = this->TempQuad[11 + 4 * (i - 3)];
-    this->TempA[1][i] = this->TempA[i][1] = this->TempQuad[11 + 4 * (i - 3) + 1];
-    this->TempA[2][i] = this->TempA[i][2] = this->TempQuad[11 + 4 * (i - 3) + 2];
-  }
-
-  for (i = 3; i < 3 + this->NumberOfComponents; i++)
-  {
-    for (j = 3; j < 3 + this->NumberOfComponents; j++)
-    {
-      if (i == j)
-      {
-        this->TempA[i][j] = this->TempQuad[10];
-      }
-      else
-      {
-        this->TempA[i][j] = 0;
-      }
-    }
-  }
   if (this->VolumePreservation)
   {
-    // Add row/col for volume constraint
-    for (i = 0; i < 3 + this->NumberOfComponents + 1; i++)
-    {
-      if (i >= 3)
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = 0;
-        this->TempA[3 + this->NumberOfComponents][i] = 0;
-      }
-      else
-      {
-        this->TempA[i][3 + this->NumberOfComponents] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] = this->VolumeConstraints[pointIds[0] * 4 + i];
-        this->TempA[i][3 + this->NumberOfComponents] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-        this->TempA[3 + this->NumberOfComponents][i] +=
-          this->VolumeConstraints[pointIds[1] * 4 + i];
-      }
-    }
-  }
-
-  // check for failure to solve the system
-  if (!solveOk)
-  {
-    // cheapest point along the edge
-    // this should not frequently occur, so I am using dynamic allocation
-    double* pt1 = new double[3 + this->NumberOfComponents];
-    double* pt2 = new double[3 + this->NumberOfComponents];
-    double* v = new double[3 + this->NumberOfComponents];
-    double* temp = new double[3 + this->NumberOfComponents];
-    double* temp2 = new double[3 + this->NumberOfComponents];
-    double d = 0;
-    double c = 0;
-
-    this->GetPointAttributeArray(pointIds[0], pt1);
-    this->GetPointAttributeArray(pointIds[1], pt2);
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      v[i] = pt2[i] - pt1[i];
-    }
-
-    // equation for the edge pt1 + c * v
-    // attempt least squares fit for c for A*(pt1 + c * v) = b
-    // temp2 = A*v
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      temp2[i] = 0;
-      for (j = 0; j < 3 + this->NumberOfComponents; ++j)
-      {
-        temp2[i] += this->TempA[i][j] * v[j];
-      }
-    }
-
-    // c = v dot v
-    for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-    {
-      d += temp2[i] * temp2[i];
-    }
-
-    if (d > errorNumber)
-    {
-      // temp = A*pt1
-      for (i = 0; i < 3 + this->NumberOfComponents; ++i)
-      {
-        temp[i] = 0;
-        for (j = 0; j < 3 + this->NumberOfComponents; ++j)
-        {
-          temp[i] += this->TempA[i][j] * pt1[j];
-        }
-      }
-
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        temp[i] = this->TempB[i] - temp[i];
-      }
-
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        c += temp2[i] * temp[i];
-      }
-      c = c / d;
-
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        x[i] = pt1[i] + c * v[i];
-      }
-    }
-    else
-    {
-      // use mid point
-      // might want to change to best of mid and end points??
-      for (i = 0; i < 3 + this->NumberOfComponents; i++)
-      {
-        x[i] = 0.5 * (pt1[i] + pt2[i]);
-      }
-    }
-    delete[] pt1;
-    delete[] pt2;
-    delete[] v;
-    delete[] temp;
-    delete[] temp2;
-  }
-
-  // Compute the cost
-  // x'*A*x - 2*b*x + d
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    cost += this->TempA[i][i] * x[i] * x[i];
-    for (j = i + 1; j < 3 + this->NumberOfComponents + this->VolumePreservation; j++)
+    for (int i = 0; i < 4; i++)
     {
-      cost += 2.0 * this->TempA[i][j] * x[i] * x[j];
+      volume[i] = this->VolumeConstraints[pointIds[0] * 4 + i] +
+        this->VolumeConstraints[pointIds[1] * 4 + i];
     }
   }
-  for (i = 0; i < 3 + this->NumberOfComponents + this->VolumePreservation; i++)
-  {
-    cost -= 2.0 * this->TempB[i] * x[i];
-  }
-
-  cost += this->TempQuad[9];
 
-  return cost;
+  return ComputeAttributeCost(this->TempQuad, this->VolumePreservation ? volume : nullptr,
+    this->NumberOfComponents, this->TempA, this->TempB,
+    [&](double* pt1, double* pt2) {
+      this->GetPointAttributeArray(pointIds[0], pt1);
+      this->GetPointAttributeArray(pointIds[1], pt2);
+    },
+    x);
 }
 
 int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
@@ -1240,49 +1271,13 @@ int vtkQuadricDecimation::CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id)
   return numDeleted;
 }
 
-// triangle t0, t1, t2 and point x
-// determines if t0 and x are on the same side of the plane defined by
-// t1 and t2, and parallel to the normal of the triangle
-int vtkQuadricDecimation::TrianglePlaneCheck(
-  const double t0[3], const double t1[3], const double t2[3], const double* x)
-{
-  double e0[3], e1[3], n[3], e2[3];
-  double c;
-  int i;
-
-  for (i = 0; i < 3; i++)
-  {
-    e0[i] = t2[i] - t1[i];
-  }
-  for (i = 0; i < 3; i++)
-  {
-    e1[i] = t0[i] - t1[i];
-  }
-
-  // projection of e0 onto e1
-  c = vtkMath::Dot(e0, e1) / (e0[0] * e0[0] + e0[1] * e0[1] + e0[2] * e0[2]);
-  for (i = 0; i < 3; i++)
-  {
-    n[i] = e1[i] - c * e0[i];
-  }
-
-  for (i = 0; i < 3; i++)
-  {
-    e2[i] = x[i] - t1[i];
-  }
-
-  vtkMath::Normalize(n);
-  vtkMath::Normalize(e2);
-  if (vtkMath::Dot(n, e2) > 1e-5)
-  {
-    return 1;
-  }
-  else
-  {
-    return 0;
-  }
-}
-
+//----------------------------------------------------------------------------
+int vtkQuadricDecimation::TrianglePlaneCheck(
+  const double t0[3], const double t1[3], const double t2[3], const double* x)
+{
+  return ::TrianglePlaneCheck(t0, t1, t2, x);
+}
+
 int vtkQuadricDecimation::IsGoodPlacement(vtkIdType pt0Id, vtkIdType pt1Id, const double* x)
 {
   vtkIdType ncells, i;
@@ -1445,6 +1440,775 @@ void vtkQuadricDecimation::ComputeNumberOfComponents()
   vtkDebugMacro("Number of components: " << this->NumberOfComponents);
 }
 
+//----------------------------------------------------------------------------
+// Parallel decimation
+namespace
+{
+// Minimum number of triangles of a partition
+const vtkIdType VTK_QUADRIC_MIN_PARTITION_SIZE = 20000;
+
+// A candidate collapse of point B into point A. It is stale once either
+// point has changed since its cost was computed.
+struct EdgeCollapse
+{
+  double Cost;
+  vtkIdType A;
+  vtkIdType B;
+  unsigned int StampA;
+  unsigned int StampB;
+
+  // The heap of collapses pops the cheapest one first
+  bool operator<(const EdgeCollapse& other) const { return this->Cost > other.Cost; }
+};
+
+// The triangle mesh decimated in parallel. The triangles are stored in a flat
+// array, and the triangles using a point are linked through their corners
+// (corner 3 * t + i is the i-th point of triangle t). The points are split
+// into partitions, and a partition only collapses edges between points it
+// owns: all the triangles using these points belong to the partition, so
+// that the partitions can be decimated concurrently. The points used by the
+// triangles spanning several partitions are frozen.
+class ParallelQuadricMesh
+{
+public:
+  ParallelQuadricMesh(int numComps, bool attributes, bool volumePreservation)
+    : NumberOfComponents(numComps)
+    , AttributeErrorMetric(attributes)
+    , VolumePreservation(volumePreservation)
+    , Dimension(3 + numComps)
+    , QuadricSize(11 + 4 * numComps)
+  {
+  }
+
+  const int NumberOfComponents;
+  const bool AttributeErrorMetric;
+  const bool VolumePreservation;
+  const int Dimension; // coordinates followed by the scaled attributes
+  const int QuadricSize;
+
+  std::vector<double> Points;
+  std::vector<double> Quadrics;
+  std::vector<double> VolumeConstraints;
+  std::vector<vtkIdType> Triangles; // the first point is -1 once deleted
+  std::vector<vtkIdType> NextCorner;
+  std::vector<vtkIdType> FirstCorner;
+  std::vector<unsigned int> Stamps;
+  std::vector<char> Moved;
+  std::vector<int> Owners; // partition owning each point, -1 if frozen
+  std::vector<vtkIdType> PartitionOffsets;
+  std::vector<vtkIdType> PartitionTriangles;
+
+  // Work arrays of a partition
+  struct Workspace
+  {
+    Workspace(const ParallelQuadricMesh& mesh)
+    {
+      const int size = mesh.Dimension + (mesh.VolumePreservation ? 1 : 0);
+      this->Quad.resize(mesh.QuadricSize);
+      this->X.resize(size);
+      this->B.resize(size);
+      this->AData.resize(size * size);
+      for (int i = 0; i < size; i++)
+      {
+        this->A.push_back(this->AData.data() + i * size);
+      }
+    }
+
+    std::vector<double> Quad;
+    std::vector<double> X;
+    std::vector<double> B;
+    std::vector<double> AData;
+    std::vector<double*> A;
+    std::vector<vtkIdType> Corners;
+    std::vector<vtkIdType> Neighbors;
+  };
+
+  vtkIdType GetNumberOfPoints() const { return static_cast<vtkIdType>(this->FirstCorner.size()); }
+
+  vtkIdType GetNumberOfTriangles() const
+  {
+    return static_cast<vtkIdType>(this->Triangles.size() / 3);
+  }
+
+  double* GetPoint(vtkIdType ptId) { return this->Points.data() + ptId * this->Dimension; }
+
+  const vtkIdType* GetTriangle(vtkIdType corner) const
+  {
+    return this->Triangles.data() + corner - corner % 3;
+  }
+
+  bool IsDeleted(vtkIdType triId) const { return this->Triangles[3 * triId] < 0; }
+
+  // Link the corners of the triangles to their points
+  void BuildLinks(vtkIdType numPts)
+  {
+    this->FirstCorner.assign(numPts, -1);
+    this->NextCorner.resize(this->Triangles.size());
+    for (vtkIdType corner = static_cast<vtkIdType>(this->Triangles.size()) - 1; corner >= 0;
+         --corner)
+    {
+      const vtkIdType ptId = this->Triangles[corner];
+      this->NextCorner[corner] = this->FirstCorner[ptId];
+      this->FirstCorner[ptId] = corner;
+    }
+    this->Stamps.assign(numPts, 0);
+    this->Moved.assign(numPts, 0);
+    this->Owners.assign(numPts, 0);
+  }
+
+  // Call f on the corners of the live triangles using the point, unlinking
+  // the corners of the deleted triangles on the way.
+  template <typename F>
+  void ForEachCorner(vtkIdType ptId, F&& f)
+  {
+    vtkIdType* link = &this->FirstCorner[ptId];
+    while (*link >= 0)
+    {
+      const vtkIdType corner = *link;
+      if (this->GetTriangle(corner)[0] < 0)
+      {
+        *link = this->NextCorner[corner];
+        continue;
+      }
+      f(corner);
+      link = &this->NextCorner[corner];
+    }
+  }
+
+  // Whether another triangle than the one of the corner uses the edge
+  // between its point and ptId
+  bool IsSharedEdge(vtkIdType corner, vtkIdType ptId)
+  {
+    bool shared = false;
+    this->ForEachCorner(this->Triangles[corner], [&](vtkIdType other) {
+      const vtkIdType* tri = this->GetTriangle(other);
+      shared |= (other != corner && (tri[0] == ptId || tri[1] == ptId || tri[2] == ptId));
+    });
+    return shared;
+  }
+
+  // Whether a triangle uses the three points
+  bool IsTriangle(vtkIdType pt0Id, vtkIdType pt1Id, vtkIdType pt2Id)
+  {
+    bool found = false;
+    this->ForEachCorner(pt0Id, [&](vtkIdType corner) {
+      const vtkIdType* tri = this->GetTriangle(corner);
+      found |= ((tri[0] == pt1Id || tri[1] == pt1Id || tri[2] == pt1Id) &&
+        (tri[0] == pt2Id || tri[1] == pt2Id || tri[2] == pt2Id));
+    });
+    return found;
+  }
+
+  // Sum the quadrics (and volume constraints) of the triangles and boundary
+  // edges using each point. Return false if the attribute part of the
+  // quadric of a triangle could not be computed.
+  bool InitializeQuadrics()
+  {
+    const vtkIdType numPts = this->GetNumberOfPoints();
+    this->Quadrics.assign(numPts * this->QuadricSize, 0.0);
+    if (this->VolumePreservation)
+    {
+      this->VolumeConstraints.assign(numPts * 4, 0.0);
+    }
+    std::atomic<bool> factored(true);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      std::vector<double> QEM(this->QuadricSize);
+      double n[3], d, area;
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        double* quadric = this->Quadrics.data() + ptId * this->QuadricSize;
+        this->ForEachCorner(ptId, [&](vtkIdType corner) {
+          const vtkIdType* tri = this->GetTriangle(corner);
+          if (!ComputeTriangleQuadric(this->GetPoint(tri[0]), this->GetPoint(tri[1]),
+                this->GetPoint(tri[2]), this->NumberOfComponents, this->AttributeErrorMetric,
+                QEM.data(), n, d, area))
+          {
+            factored = false;
+          }
+          for (int j = 0; j < this->QuadricSize; j++)
+          {
+            quadric[j] += QEM[j] * area;
+          }
+          if (this->VolumePreservation)
+          {
+            double* volume = this->VolumeConstraints.data() + ptId * 4;
+            for (int j = 0; j < 3; j++)
+            {
+              volume[j] += n[j] * area * 2.0;
+            }
+            volume[3] += -d * area * 2.0;
+          }
+
+          // Free boundary edges (ptId, next) and (previous, ptId)
+          const int i = static_cast<int>(corner % 3);
+          const vtkIdType next = tri[(i + 1) % 3];
+          const vtkIdType previous = tri[(i + 2) % 3];
+          for (int edge = 0; edge < 2; edge++)
+          {
+            if (!this->IsSharedEdge(corner, edge == 0 ? next : previous))
+            {
+              const double w = edge == 0
+                ? ComputeBoundaryQuadric(this->GetPoint(previous), this->GetPoint(ptId),
+                    this->GetPoint(next), QEM.data())
+                : ComputeBoundaryQuadric(this->GetPoint(next), this->GetPoint(previous),
+                    this->GetPoint(ptId), QEM.data());
+              for (int j = 0; j < 11; j++)
+              {
+                quadric[j] += QEM[j] * w;
+              }
+            }
+          }
+        });
+      }
+    });
+    return factored;
+  }
+
+  // Compute the cost of collapsing the edge (pt0Id, pt1Id) and the point
+  // that gives this cost.
+  double ComputeCost(vtkIdType pt0Id, vtkIdType pt1Id, Workspace& ws, double* x)
+  {
+    const double* quad0 = this->Quadrics.data() + pt0Id * this->QuadricSize;
+    const double* quad1 = this->Quadrics.data() + pt1Id * this->QuadricSize;
+    for (int i = 0; i < this->QuadricSize; i++)
+    {
+      ws.Quad[i] = quad0[i] + quad1[i];
+    }
+    auto getEndPoints = [&](double* pt1, double* pt2) {
+      std::copy(this->GetPoint(pt0Id), this->GetPoint(pt0Id) + this->Dimension, pt1);
+      std::copy(this->GetPoint(pt1Id), this->GetPoint(pt1Id) + this->Dimension, pt2);
+    };
+    if (!this->AttributeErrorMetric)
+    {
+      return ComputeGeometricCost(ws.Quad.data(), getEndPoints, x);
+    }
+    double volume[4];
+    if (this->VolumePreservation)
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        volume[i] =
+          this->VolumeConstraints[pt0Id * 4 + i] + this->VolumeConstraints[pt1Id * 4 + i];
+      }
+    }
+    return ComputeAttributeCost(ws.Quad.data(), this->VolumePreservation ? volume : nullptr,
+      this->NumberOfComponents, ws.A.data(), ws.B.data(), getEndPoints, x);
+  }
+
+  // Check that moving the points of the edge to x does not flip the
+  // triangles that do not use the edge.
+  bool IsGoodPlacement(vtkIdType pt0Id, vtkIdType pt1Id, const double* x)
+  {
+    bool good = true;
+    for (int k = 0; k < 2 && good; k++)
+    {
+      const vtkIdType ptId = k == 0 ? pt0Id : pt1Id;
+      const vtkIdType otherId = k == 0 ? pt1Id : pt0Id;
+      this->ForEachCorner(ptId, [&](vtkIdType corner) {
+        const vtkIdType* tri = this->GetTriangle(corner);
+        if (good && tri[0] != otherId && tri[1] != otherId && tri[2] != otherId)
+        {
+          const int i = static_cast<int>(corner % 3);
+          good = TrianglePlaneCheck(this->GetPoint(tri[i]), this->GetPoint(tri[(i + 1) % 3]),
+                   this->GetPoint(tri[(i + 2) % 3]), x) != 0;
+        }
+      });
+    }
+    return good;
+  }
+
+  // Collapse pt1Id into pt0Id, moved to x. Return the number of deleted
+  // triangles.
+  int CollapseEdge(vtkIdType pt0Id, vtkIdType pt1Id, const double* x, Workspace& ws)
+  {
+    std::copy(x, x + this->Dimension, this->GetPoint(pt0Id));
+    this->Moved[pt0Id] = 1;
+    for (int i = 0; i < this->QuadricSize; i++)
+    {
+      this->Quadrics[pt0Id * this->QuadricSize + i] +=
+        this->Quadrics[pt1Id * this->QuadricSize + i];
+    }
+    if (this->VolumePreservation)
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        this->VolumeConstraints[pt0Id * 4 + i] += this->VolumeConstraints[pt1Id * 4 + i];
+      }
+    }
+
+    // Delete the triangles using the edge
+    int numDeleted = 0;
+    this->ForEachCorner(pt0Id, [&](vtkIdType corner) {
+      vtkIdType* tri = this->Triangles.data() + corner - corner % 3;
+      if (tri[0] == pt1Id || tri[1] == pt1Id || tri[2] == pt1Id)
+      {
+        tri[0] = -1;
+        numDeleted++;
+      }
+    });
+
+    // Move the other triangles of pt1Id to pt0Id, unless pt0Id already has
+    // the same triangle
+    ws.Corners.clear();
+    this->ForEachCorner(pt1Id, [&](vtkIdType corner) { ws.Corners.push_back(corner); });
+    this->FirstCorner[pt1Id] = -1;
+    for (vtkIdType corner : ws.Corners)
+    {
+      vtkIdType* tri = this->Triangles.data() + corner - corner % 3;
+      const int i = static_cast<int>(corner % 3);
+      if (this->IsTriangle(pt0Id, tri[(i + 1) % 3], tri[(i + 2) % 3]))
+      {
+        tri[0] = -1;
+        numDeleted++;
+      }
+      else
+      {
+        tri[i] = pt0Id;
+        this->NextCorner[corner] = this->FirstCorner[pt0Id];
+        this->FirstCorner[pt0Id] = corner;
+      }
+    }
+
+    this->Stamps[pt0Id]++;
+    this->Stamps[pt1Id]++;
+    return numDeleted;
+  }
+
+  bool IsStale(const EdgeCollapse& collapse) const
+  {
+    return collapse.StampA != this->Stamps[collapse.A] ||
+      collapse.StampB != this->Stamps[collapse.B];
+  }
+
+  // Queue the collapses of the edges between ptId and the other points of
+  // the partition.
+  void QueueCollapses(vtkIdType ptId, int partition, std::vector<EdgeCollapse>& heap, Workspace& ws)
+  {
+    ws.Neighbors.clear();
+    this->ForEachCorner(ptId, [&](vtkIdType corner) {
+      const vtkIdType* tri = this->GetTriangle(corner);
+      const int i = static_cast<int>(corner % 3);
+      ws.Neighbors.push_back(tri[(i + 1) % 3]);
+      ws.Neighbors.push_back(tri[(i + 2) % 3]);
+    });
+    std::sort(ws.Neighbors.begin(), ws.Neighbors.end());
+    ws.Neighbors.erase(std::unique(ws.Neighbors.begin(), ws.Neighbors.end()), ws.Neighbors.end());
+    for (vtkIdType otherId : ws.Neighbors)
+    {
+      if (otherId != ptId && this->Owners[otherId] == partition)
+      {
+        const double cost = this->ComputeCost(ptId, otherId, ws, ws.X.data());
+        heap.push_back({ cost, ptId, otherId, this->Stamps[ptId], this->Stamps[otherId] });
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+  }
+
+  // Split the points in slabs along the axis, delimited by the boundaries.
+  // Return the number of triangles within a slab.
+  vtkIdType Partition(const std::vector<double>& boundaries, int axis)
+  {
+    const vtkIdType numPts = this->GetNumberOfPoints();
+    const vtkIdType numTris = this->GetNumberOfTriangles();
+    vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        this->Owners[ptId] = static_cast<int>(std::upper_bound(boundaries.begin(),
+                                                boundaries.end(), this->GetPoint(ptId)[axis]) -
+          boundaries.begin());
+      }
+    });
+    std::vector<int> partitions(numTris);
+    vtkSMPTools::For(0, numTris, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType triId = begin; triId < end; ++triId)
+      {
+        const vtkIdType* tri = this->Triangles.data() + 3 * triId;
+        partitions[triId] = tri[0] < 0
+          ? -2
+          : (this->Owners[tri[0]] == this->Owners[tri[1]] &&
+                this->Owners[tri[0]] == this->Owners[tri[2]]
+                ? this->Owners[tri[0]]
+                : -1);
+      }
+    });
+
+    // Sort the triangles by partition, and freeze the points of the others
+    this->PartitionOffsets.assign(boundaries.size() + 2, 0);
+    for (vtkIdType triId = 0; triId < numTris; ++triId)
+    {
+      if (partitions[triId] >= 0)
+      {
+        this->PartitionOffsets[partitions[triId] + 1]++;
+      }
+      else if (partitions[triId] == -1)
+      {
+        for (int i = 0; i < 3; i++)
+        {
+          this->Owners[this->Triangles[3 * triId + i]] = -1;
+        }
+      }
+    }
+    for (size_t i = 1; i < this->PartitionOffsets.size(); i++)
+    {
+      this->PartitionOffsets[i] += this->PartitionOffsets[i - 1];
+    }
+    std::vector<vtkIdType> cursors(this->PartitionOffsets.begin(), this->PartitionOffsets.end());
+    this->PartitionTriangles.resize(this->PartitionOffsets.back());
+    for (vtkIdType triId = 0; triId < numTris; ++triId)
+    {
+      if (partitions[triId] >= 0)
+      {
+        this->PartitionTriangles[cursors[partitions[triId]]++] = triId;
+      }
+    }
+    return this->PartitionOffsets.back();
+  }
+
+  // Collapse the cheapest edges of a partition until the given number of
+  // triangles has been deleted. Return the number of deleted triangles.
+  vtkIdType DecimatePartition(int partition, double target, vtkIdType& numCollapses)
+  {
+    Workspace ws(*this);
+    std::vector<std::pair<vtkIdType, vtkIdType> > edges;
+    for (vtkIdType i = this->PartitionOffsets[partition];
+         i < this->PartitionOffsets[partition + 1]; ++i)
+    {
+      const vtkIdType* tri = this->Triangles.data() + 3 * this->PartitionTriangles[i];
+      for (int j = 0; j < 3; j++)
+      {
+        const vtkIdType pt0Id = tri[j];
+        const vtkIdType pt1Id = tri[(j + 1) % 3];
+        if (pt0Id != pt1Id && this->Owners[pt0Id] == partition &&
+          this->Owners[pt1Id] == partition)
+        {
+          edges.emplace_back(std::min(pt0Id, pt1Id), std::max(pt0Id, pt1Id));
+        }
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<EdgeCollapse> heap;
+    heap.reserve(edges.size());
+    for (const auto& edge : edges)
+    {
+      const double cost = this->ComputeCost(edge.first, edge.second, ws, ws.X.data());
+      heap.push_back(
+        { cost, edge.first, edge.second, this->Stamps[edge.first], this->Stamps[edge.second] });
+    }
+    edges = std::vector<std::pair<vtkIdType, vtkIdType> >();
+    std::make_heap(heap.begin(), heap.end());
+
+    // The stale collapses are skipped when popped, and purged when they
+    // would make the heap grow beyond twice its size after the last purge.
+    size_t purgeSize = 2 * heap.size();
+    vtkIdType numDeleted = 0;
+    while (numDeleted < target && !heap.empty())
+    {
+      if (heap.size() > purgeSize)
+      {
+        heap.erase(std::remove_if(heap.begin(), heap.end(),
+                     [this](const EdgeCollapse& collapse) { return this->IsStale(collapse); }),
+          heap.end());
+        std::make_heap(heap.begin(), heap.end());
+        purgeSize = std::max(2 * heap.size(), static_cast<size_t>(1024));
+        continue;
+      }
+      std::pop_heap(heap.begin(), heap.end());
+      const EdgeCollapse collapse = heap.back();
+      heap.pop_back();
+      if (this->IsStale(collapse))
+      {
+        continue;
+      }
+      if (collapse.Cost >= VTK_DOUBLE_MAX)
+      {
+        break;
+      }
+      // The edge is reconsidered when its points change
+      this->ComputeCost(collapse.A, collapse.B, ws, ws.X.data());
+      if (!this->IsGoodPlacement(collapse.A, collapse.B, ws.X.data()))
+      {
+        continue;
+      }
+      numDeleted += this->CollapseEdge(collapse.A, collapse.B, ws.X.data(), ws);
+      numCollapses++;
+      this->QueueCollapses(collapse.A, partition, heap, ws);
+    }
+    return numDeleted;
+  }
+
+  // Decimate the partitions concurrently, each deleting the given fraction
+  // of its triangles. Return the number of deleted triangles.
+  vtkIdType DecimatePartitions(double fraction, vtkIdType& numCollapses)
+  {
+    const int numPartitions = static_cast<int>(this->PartitionOffsets.size()) - 1;
+    std::vector<vtkIdType> numDeleted(numPartitions, 0);
+    std::vector<vtkIdType> collapses(numPartitions, 0);
+    vtkSMPTools::For(0, numPartitions, 1, [&](vtkIdType begin, vtkIdType end) {
+      for (int partition = static_cast<int>(begin); partition < end; ++partition)
+      {
+        const vtkIdType numTris =
+          this->PartitionOffsets[partition + 1] - this->PartitionOffsets[partition];
+        numDeleted[partition] =
+          this->DecimatePartition(partition, fraction * numTris, collapses[partition]);
+      }
+    });
+    numCollapses += std::accumulate(collapses.begin(), collapses.end(), vtkIdType(0));
+    return std::accumulate(numDeleted.begin(), numDeleted.end(), vtkIdType(0));
+  }
+};
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricDecimation::DecimateInParallel(vtkPolyData* input, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numTris = input->GetNumberOfPolys();
+
+  // The working mesh only gives access to the input points and attributes
+  this->Mesh = vtkPolyData::New();
+  this->Mesh->SetPoints(input->GetPoints());
+  this->NumberOfComponents = 0;
+  if (this->AttributeErrorMetric)
+  {
+    this->Mesh->GetPointData()->ShallowCopy(input->GetPointData());
+    this->ComputeNumberOfComponents();
+  }
+
+  ParallelQuadricMesh mesh(
+    this->NumberOfComponents, this->AttributeErrorMetric != 0, this->VolumePreservation != 0);
+  mesh.Points.resize(numPts * mesh.Dimension);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      this->GetPointAttributeArray(ptId, mesh.GetPoint(ptId));
+    }
+  });
+  mesh.Triangles.reserve(3 * numTris);
+  vtkCellArray* polys = input->GetPolys();
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    if (npts == 3)
+    {
+      mesh.Triangles.insert(mesh.Triangles.end(), pts, pts + 3);
+    }
+  }
+  mesh.BuildLinks(numPts);
+
+  vtkDebugMacro(<< "Computing Quadrics");
+  if (!mesh.InitializeQuadrics())
+  {
+    vtkErrorMacro(<< "Unable to factor attribute matrix!");
+  }
+  this->UpdateProgress(0.2);
+
+  // Split the points in slabs along the largest dimension of the mesh, each
+  // holding as many points, and decimate them concurrently. The frozen
+  // points between the slabs are then decimated by a second pass whose slabs
+  // straddle the first ones, and a last pass over the whole mesh is run if
+  // needed to reach the target reduction.
+  double bounds[6];
+  input->GetPoints()->GetBounds(bounds);
+  int axis = 0;
+  for (int i = 1; i < 3; i++)
+  {
+    if (bounds[2 * i + 1] - bounds[2 * i] > bounds[2 * axis + 1] - bounds[2 * axis])
+    {
+      axis = i;
+    }
+  }
+  const vtkIdType numPartitions = std::max(static_cast<vtkIdType>(1),
+    std::min(static_cast<vtkIdType>(2 * vtkSMPTools::GetEstimatedNumberOfThreads()),
+      numTris / VTK_QUADRIC_MIN_PARTITION_SIZE));
+  std::vector<double> coordinates(numPartitions > 1 ? numPts : 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(coordinates.size()),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType ptId = begin; ptId < end; ++ptId)
+      {
+        coordinates[ptId] = mesh.GetPoint(ptId)[axis];
+      }
+    });
+  vtkSMPTools::Sort(coordinates.begin(), coordinates.end());
+  std::vector<double> boundaries, shiftedBoundaries;
+  for (vtkIdType i = 1; i < numPartitions; i++)
+  {
+    boundaries.push_back(coordinates[i * numPts / numPartitions]);
+  }
+  for (vtkIdType i = 0; numPartitions > 1 && i < numPartitions; i++)
+  {
+    shiftedBoundaries.push_back(coordinates[(2 * i + 1) * numPts / (2 * numPartitions)]);
+  }
+  coordinates = std::vector<double>();
+
+  vtkDebugMacro(<< "Collapsing edges in " << numPartitions << " partitions");
+  const double target = this->TargetReduction * numTris;
+  vtkIdType numCollapses = 0;
+  mesh.Partition(boundaries, axis);
+  vtkIdType numDeleted = mesh.DecimatePartitions(this->TargetReduction, numCollapses);
+  this->UpdateProgress(0.6);
+  if (numPartitions > 1 && numDeleted < target && !this->GetAbortExecute())
+  {
+    const vtkIdType numInside = mesh.Partition(shiftedBoundaries, axis);
+    if (numInside > 0)
+    {
+      numDeleted += mesh.DecimatePartitions(
+        std::min(1.0, (target - numDeleted) / numInside), numCollapses);
+    }
+    this->UpdateProgress(0.8);
+    if (numDeleted < target && !this->GetAbortExecute())
+    {
+      const vtkIdType numLeft = mesh.Partition(std::vector<double>(), axis);
+      if (numLeft > 0)
+      {
+        numDeleted += mesh.DecimatePartitions((target - numDeleted) / numLeft, numCollapses);
+      }
+    }
+  }
+  this->NumberOfEdgeCollapses = static_cast<int>(numCollapses);
+  this->ActualReduction = numTris > 0 ? static_cast<double>(numDeleted) / numTris : 0.0;
+  vtkDebugMacro(<< "Number Of Edge Collapses: " << this->NumberOfEdgeCollapses);
+  this->UpdateProgress(0.9);
+
+  // Renumber the points used by the remaining triangles
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkIdType numNewTris = 0;
+  for (vtkIdType triId = 0; triId < mesh.GetNumberOfTriangles(); ++triId)
+  {
+    if (!mesh.IsDeleted(triId))
+    {
+      numNewTris++;
+      for (int i = 0; i < 3; i++)
+      {
+        pointMap[mesh.Triangles[3 * triId + i]] = 0;
+      }
+    }
+  }
+  vtkIdType numNewPts = 0;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] >= 0)
+    {
+      pointMap[ptId] = numNewPts++;
+    }
+  }
+
+  vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfValues(3 * numNewTris);
+  vtkIdType* newPts = connectivity->GetPointer(0);
+  for (vtkIdType triId = 0; triId < mesh.GetNumberOfTriangles(); ++triId)
+  {
+    if (!mesh.IsDeleted(triId))
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        *newPts++ = pointMap[mesh.Triangles[3 * triId + i]];
+      }
+    }
+  }
+  vtkIdTypeArray* offsets = vtkIdTypeArray::New();
+  offsets->SetNumberOfValues(numNewTris + 1);
+  vtkSMPTools::For(0, numNewTris + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType triId = begin; triId < end; ++triId)
+    {
+      offsets->SetValue(triId, 3 * triId);
+    }
+  });
+  vtkCellArray* newPolys = vtkCellArray::New();
+  newPolys->SetData(offsets, connectivity);
+  offsets->Delete();
+  connectivity->Delete();
+
+  vtkPoints* points = vtkPoints::New();
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType ptId = begin; ptId < end; ++ptId)
+    {
+      if (pointMap[ptId] >= 0)
+      {
+        points->SetPoint(pointMap[ptId], mesh.GetPoint(ptId));
+      }
+    }
+  });
+
+  output->Reset();
+  output->SetPoints(points);
+  points->Delete();
+  output->SetPolys(newPolys);
+  newPolys->Delete();
+
+  // As in the serial mode, the point data of the kept points is copied from
+  // the working mesh, which only holds the input point data when the
+  // attributes are used. The attributes of the moved points are then those
+  // of the collapses, and the normals are renormalized.
+  vtkPointData* pd = this->Mesh->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(pd, numNewPts);
+  vtkIdList* srcIds = vtkIdList::New();
+  vtkIdList* dstIds = vtkIdList::New();
+  srcIds->SetNumberOfIds(numNewPts);
+  dstIds->SetNumberOfIds(numNewPts);
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (pointMap[ptId] >= 0)
+    {
+      srcIds->SetId(pointMap[ptId], ptId);
+      dstIds->SetId(pointMap[ptId], pointMap[ptId]);
+    }
+  }
+  outPD->CopyData(pd, srcIds, dstIds);
+  srcIds->Delete();
+  dstIds->Delete();
+
+  if (this->AttributeErrorMetric)
+  {
+    int firstComponent = 0;
+    for (int attribute = 0; attribute < 5; attribute++)
+    {
+      const int lastComponent = this->AttributeComponents[attribute];
+      vtkDataArray* outArray = outPD->GetAttribute(attribute);
+      if (lastComponent > firstComponent && outArray)
+      {
+        const double scale = this->AttributeScale[attribute];
+        vtkSMPTools::For(0, numPts, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType ptId = begin; ptId < end; ++ptId)
+          {
+            if (pointMap[ptId] < 0 || !mesh.Moved[ptId])
+            {
+              continue;
+            }
+            const double* x = mesh.GetPoint(ptId) + 3 + firstComponent;
+            for (int i = 0; i < lastComponent - firstComponent; i++)
+            {
+              outArray->SetComponent(pointMap[ptId], i, x[i] / scale);
+            }
+          }
+        });
+      }
+      firstComponent = lastComponent;
+    }
+
+    if (vtkDataArray* normals = outPD->GetNormals())
+    {
+      vtkSMPTools::For(0, numNewPts, [&](vtkIdType begin, vtkIdType end) {
+        double n[3];
+        for (vtkIdType ptId = begin; ptId < end; ++ptId)
+        {
+          normals->GetTuple(ptId, n);
+          vtkMath::Normalize(n);
+          normals->SetTuple(ptId, n);
+        }
+      });
+    }
+  }
+
+  this->Mesh->Delete();
+  this->Mesh = nullptr;
+}
+
 //----------------------------------------------------------------------------
 void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -1466,4 +2230,5 @@ void vtkQuadricDecimation::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Normals Weight: " << this->NormalsWeight << "\n";
   os << indent << "TCoords Weight: " << this->TCoordsWeight << "\n";
   os << indent << "Tensors Weight: " << this->TensorsWeight << "\n";
+  os << indent << "Parallel Decimation: " << (this->ParallelDecimation ? "On\n" : "Off\n");
 }
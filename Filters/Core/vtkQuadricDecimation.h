@@ -48,6 +48,18 @@
  * Attributes" is also a good take on the subject especially as it pertains
  * to the error metric applied to attributes.
  *
+ * With ParallelDecimation on, the mesh is stored in compact arrays instead
+ * of a vtkPolyData with links and an edge table, and is split into slabs
+ * holding as many points along its largest dimension. The slabs are
+ * decimated concurrently, each with its own priority queue, collapsing only
+ * the edges whose triangles all lie within the slab; the points of the
+ * triangles spanning several slabs are left untouched. A second pass over
+ * slabs straddling the first ones then decimates these seams, and a final
+ * pass over the whole mesh runs if the target reduction has not been
+ * reached. The order of the collapses thus differs from the serial
+ * algorithm, but the error metric, its attribute weights, the
+ * TargetReduction and the output point data are the same.
+ *
  * @par Thanks:
  * Thanks to Bradley Lowekamp of the National Library of Medicine/NIH for
  * contributing this class.
@@ -148,6 +160,17 @@ public:
   vtkGetMacro(TensorsWeight, double);
   //@}
 
+  //@{
+  /**
+   * Turn on/off the decimation of the mesh in parallel partitions (see the
+   * class documentation). It uses much less memory than the serial
+   * decimation. Off by default.
+   */
+  vtkSetMacro(ParallelDecimation, vtkTypeBool);
+  vtkGetMacro(ParallelDecimation, vtkTypeBool);
+  vtkBooleanMacro(ParallelDecimation, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Get the actual reduction. This value is only valid after the
@@ -230,10 +253,16 @@ protected:
    */
   void GetAttributeComponents();
 
+  /**
+   * Decimate the input with ParallelDecimation on.
+   */
+  void DecimateInParallel(vtkPolyData* input, vtkPolyData* output);
+
   double TargetReduction;
   double ActualReduction;
   vtkTypeBool AttributeErrorMetric;
   vtkTypeBool VolumePreservation;
+  vtkTypeBool ParallelDecimation;
 
   vtkTypeBool ScalarsAttribute;
   vtkTypeBool VectorsAttribute;
@@ -24,11 +24,14 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkPolyDataSmoothingInternal.h"
 #include "vtkPolygon.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -147,26 +150,9 @@ vtkPolyData* vtkSmoothPolyDataFilter::GetSource()
   return vtkPolyData::SafeDownCast(this->GetExecutive()->GetInputData(1, 0));
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
 namespace
 {
 
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-{
-  char type;
-  vtkIdList* edges; // connected edges (list of connected point ids)
-  _vtkMeshVertex()
-  {
-    type = VTK_SIMPLE_VERTEX; // can smooth
-    edges = nullptr;
-  }
-} vtkMeshVertex, *vtkMeshVertexPtr;
-
 template <typename T>
 struct vtkSPDF_InternalParams
 {
@@ -176,7 +162,7 @@ struct vtkSPDF_InternalParams
   T factor;
   T conv;
   vtkIdType numPts;
-  vtkMeshVertexPtr vertexPtr;
+  const vtkMeshVertices* verts;
   vtkPolyData* source;
   vtkSmoothPoints* SmoothPoints;
   double* w;
@@ -202,8 +188,9 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
     maxDist = 0.0;
     T* newPtsCoords = static_cast<T*>(params.newPts->GetVoidPointer(0));
     T* start = newPtsCoords;
-    vtkMeshVertexPtr vertsPtr = params.vertexPtr;
-    vtkIdType npts, *edgeIdPtr;
+    const vtkMeshVertices* verts = params.verts;
+    vtkIdType npts;
+    const vtkIdType* edgeIdPtr;
     T dist, deltaX[3];
     double dist2, xNew[3], closestPt[3];
 
@@ -211,11 +198,10 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
     // position of its connected neighbors using the relaxation factor.
     for (vtkIdType i = 0; i < params.numPts; ++i)
     {
-      if (vertsPtr->type != VTK_FIXED_VERTEX && vertsPtr->edges != nullptr &&
-        (npts = vertsPtr->edges->GetNumberOfIds()) > 0)
+      if (verts->Types[i] != VTK_FIXED_VERTEX && (npts = verts->GetNumberOfEdges(i)) > 0)
       {
         deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-        edgeIdPtr = vertsPtr->edges->GetPointer(0);
+        edgeIdPtr = verts->GetEdges(i);
         // Compute the mean (cumulated) direction vector
         for (vtkIdType j = 0; j < npts; ++j)
         {
@@ -269,7 +255,6 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
       {
         newPtsCoords += 3;
       }
-      ++vertsPtr;
     } // for all points
   }   // for not converged or within iteration count
 
@@ -299,19 +284,18 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   int j, k;
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
   double conv;
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
   double closestPt[3], dist2, *w = nullptr;
   vtkIdType numSimple = 0, numBEdges = 0, numFixed = 0, numFEdges = 0;
-  vtkPolyData *inMesh, *Mesh;
+  vtkPolyData *inMesh = nullptr, *Mesh;
   vtkPoints* inPts;
   vtkTriangleFilter* toTris = nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints* newPts;
-  vtkMeshVertexPtr Verts;
+  vtkMeshVertices Verts;
   vtkCellLocator* cellLocator = nullptr;
 
   // Check input
@@ -353,7 +337,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   // using a subset of the attached vertices.
   //
   vtkDebugMacro(<< "Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
+  Verts.Types.resize(numPts, VTK_SIMPLE_VERTEX); // can smooth
 
   inPts = input->GetPoints();
   conv = this->Convergence * input->GetLength();
@@ -363,43 +347,45 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     for (j = 0; j < npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines = input->GetLines(), inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
+  inLines = input->GetLines();
+  if (inLines->GetNumberOfCells() > 0)
+  {
+    Verts.LineEdges.resize(2 * numPts, -1);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
   {
     for (j = 0; j < npts; j++)
     {
-      if (Verts[pts[j]].type == VTK_SIMPLE_VERTEX)
+      if (Verts.Types[pts[j]] == VTK_SIMPLE_VERTEX)
       {
         if (j == (npts - 1)) // end-of-line marked FIXED
         {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
         }
         else if (j == 0) // beginning-of-line marked FIXED
         {
-          Verts[pts[0]].type = VTK_FIXED_VERTEX;
+          Verts.Types[pts[0]] = VTK_FIXED_VERTEX;
           inPts->GetPoint(pts[0], x2);
           inPts->GetPoint(pts[1], x3);
         }
         else // is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0, pts[j - 1]);
-          Verts[pts[j]].edges->SetId(1, pts[j + 1]);
+          Verts.Types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          Verts.LineEdges[2 * pts[j]] = pts[j - 1];
+          Verts.LineEdges[2 * pts[j] + 1] = pts[j + 1];
         }
       } // if simple vertex
 
-      else if (Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX)
+      else if (Verts.Types[pts[j]] == VTK_FEATURE_EDGE_VERTEX)
       { // multiply connected, becomes fixed!
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
+        Verts.LineEdges[2 * pts[j]] = -1;
       }
 
     } // for all points in this line
@@ -412,19 +398,11 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   inStrips = input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
+  // Half-edges to do neighborhood searching
+  vtkStaticHalfEdgeMeshTemplate<vtkIdType> halfEdges;
+  std::vector<unsigned char> edgeTypes;
   if (numPolys > 0 || numStrips > 0)
   { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList* neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
-
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
@@ -439,152 +417,60 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       Mesh = toTris->GetOutput();
     }
 
-    Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
+    halfEdges.BuildHalfEdges(Mesh);
     this->UpdateProgress(0.375);
 
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
-    {
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
-          {
-            edge = VTK_FEATURE_EDGE_VERTEX;
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    inMesh->Delete();
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-
-    neighbors->Delete();
+    edgeTypes.resize(halfEdges.GetNumberOfHalfEdges());
+    vtkClassifyMeshEdges(
+      inPts, halfEdges, this->FeatureEdgeSmoothing != 0, false, CosFeatureAngle, edgeTypes.data());
   } // if strips or polys
+  vtkBuildMeshEdges(halfEdges, edgeTypes.data(), Verts);
+  halfEdges.Initialize();
+  if (inMesh)
+  {
+    inMesh->Delete();
+  }
+  if (toTris)
+  {
+    toTris->Delete();
+  }
 
   this->UpdateProgress(0.50);
 
   // post-process edge vertices to make sure we can smooth them
   for (i = 0; i < numPts; i++)
   {
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
+    if (Verts.Types[i] == VTK_SIMPLE_VERTEX)
     {
       numSimple++;
     }
 
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
+    else if (Verts.Types[i] == VTK_FIXED_VERTEX)
     {
       numFixed++;
     }
 
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
+    else if (Verts.Types[i] == VTK_FEATURE_EDGE_VERTEX ||
+      Verts.Types[i] == VTK_BOUNDARY_EDGE_VERTEX)
     { // see how many edges; if two, what the angle is
 
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
+      if (!this->BoundarySmoothing && Verts.Types[i] == VTK_BOUNDARY_EDGE_VERTEX)
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        Verts.Types[i] = VTK_FIXED_VERTEX;
         numBEdges++;
       }
 
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
+      else if (Verts.GetNumberOfEdges(i) != 2)
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        Verts.Types[i] = VTK_FIXED_VERTEX;
         numFixed++;
       }
 
       else // check angle between edges
       {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
+        inPts->GetPoint(Verts.GetEdges(i)[0], x1);
         inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
+        inPts->GetPoint(Verts.GetEdges(i)[1], x3);
 
         for (k = 0; k < 3; k++)
         {
@@ -595,11 +481,11 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
           vtkMath::Dot(l1, l2) < CosEdgeAngle)
         {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          Verts.Types[i] = VTK_FIXED_VERTEX;
         }
         else
         {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
+          if (Verts.Types[i] == VTK_FEATURE_EDGE_VERTEX)
           {
             numFEdges++;
           }
@@ -669,14 +555,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   if (newPts->GetDataType() == VTK_DOUBLE)
   {
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
-      this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints, w, cellLocator };
+      this->RelaxationFactor, conv, numPts, &Verts, source, this->SmoothPoints, w, cellLocator };
 
     vtkSPDF_MovePoints(params);
   }
   else
   {
     vtkSPDF_InternalParams<float> params = { this, this->NumberOfIterations, newPts,
-      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
+      static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, &Verts, source,
       this->SmoothPoints, w, cellLocator };
 
     vtkSPDF_MovePoints(params);
@@ -736,17 +622,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPolys(input->GetPolys());
   output->SetStrips(input->GetStrips());
 
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr)
-    {
-      Verts[i].edges->Delete();
-      Verts[i].edges = nullptr;
-    }
-  }
-  delete[] Verts;
-
   return 1;
 }
 
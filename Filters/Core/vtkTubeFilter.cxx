@@ -15,17 +15,25 @@
 #include "vtkTubeFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLineNormalsInternal.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include "vtkPolyLine.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 
 #include <algorithm>
+#include <numeric>
+#include <sstream>
 
 vtkStandardNewMacro(vtkTubeFilter);
 
@@ -82,6 +90,24 @@ struct IdPointsEqual
   vtkPoints* Points;
 };
 
+// Copy the points of a line, removing the consecutive coincident points.
+// Return the number of points left, or 0 if the line is not tubed.
+vtkIdType GetLinePoints(
+  vtkCellArrayIterator* lineIter, vtkIdType lineId, vtkPoints* inPts, std::vector<vtkIdType>& pts)
+{
+  vtkIdType npts;
+  const vtkIdType* ptsOrig;
+  lineIter->GetCellAtId(lineId, npts, ptsOrig);
+  if (npts < 2)
+  {
+    return 0;
+  }
+  pts.assign(ptsOrig, ptsOrig + npts);
+  npts = static_cast<vtkIdType>(std::unique(pts.begin(), pts.end(), IdPointsEqual(inPts)) -
+    pts.begin());
+  return (npts < 2 ? 0 : npts);
+}
+
 }
 
 int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -107,19 +133,13 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* inPts;
   vtkIdType numPts;
   vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
   vtkPoints* newPts;
   int deleteNormals = 0;
   vtkFloatArray* newNormals;
   vtkIdType i;
   double range[2], maxSpeed = 0;
   vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* ptsOrig = nullptr;
-  vtkIdType offset = 0;
   vtkFloatArray* newTCoords = nullptr;
-  int abort = 0;
-  vtkIdType inCellId;
   double oldRadius = 1.0;
 
   // Check input and initialize
@@ -133,7 +153,6 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Create the geometry and topology
-  numNewPts = numPts * this->NumberOfSides;
   newPts = vtkPoints::New();
 
   // Set the desired precision for the points in the output.
@@ -150,14 +169,10 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     newPts->SetDataType(VTK_DOUBLE);
   }
 
-  newPts->Allocate(numNewPts);
   newNormals = vtkFloatArray::New();
   newNormals->SetName("TubeNormals");
   newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
   newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
 
   // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
   outPD->CopyNormalsOff();
@@ -167,10 +182,8 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     newTCoords = vtkFloatArray::New();
     newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
     outPD->CopyTCoordsOff();
   }
-  outPD->CopyAllocate(pd, numNewPts);
 
   int generateNormals = 0;
   if (!(inNormals = pd->GetNormals()) || this->UseDefaultNormal)
@@ -225,76 +238,137 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     maxSpeed = inVectors->GetMaxNorm();
   }
 
-  // Copy selected parts of cell data; certainly don't want normals
+  // Count the points of each polyline, once the consecutive coincident
+  // points are removed. The output of each polyline is then placed, with an
+  // exclusive scan of its size, and generated in parallel.
   //
-  numNewCells = inLines->GetNumberOfCells() * this->NumberOfSides + 2;
-  outCD->CopyNormalsOff();
-  outCD->CopyAllocate(cd, numNewCells);
+  std::vector<vtkIdType> lineNumPts(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+    auto lineIter = vtk::TakeSmartPointer(inLines->NewIterator());
+    std::vector<vtkIdType> pts;
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+    {
+      lineNumPts[lineId] = GetLinePoints(lineIter, lineId, inPts, pts);
+    }
+  });
+  this->UpdateProgress(0.25);
+
+  const vtkIdType numSideStrips = (this->NumberOfSides + this->OnRatio - 1) / this->OnRatio;
+  const vtkIdType numCapStrips = (this->Capping ? 2 : 0);
+  std::vector<vtkIdType> ptOffsets(numLines + 1);
+  std::vector<vtkIdType> stripOffsets(numLines + 1);
+  std::vector<vtkIdType> connOffsets(numLines + 1);
+  std::vector<std::vector<std::string> > lineWarnings(numLines);
+  vtkNew<vtkIdList> srcPtIds;
+  vtkNew<vtkIdTypeArray> newOffsets;
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  vtkNew<vtkIdList> srcCellIds;
 
   //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
+  //  triangle strips. Texture coordinates are optionally generated. A
+  //  polyline that cannot be tubed is removed from the layout, and the
+  //  output is generated again.
   //
   this->Theta = 2.0 * vtkMath::Pi() / this->NumberOfSides;
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  // the line cellIds start after the last vert cellId
-  inCellId = input->GetNumberOfVerts();
-  for (inLines->InitTraversal(); inLines->GetNextCell(npts, ptsOrig) && !abort; inCellId++)
-  {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->GetAbortExecute();
-
-    // Make a copy of point indices to avoid modfiying input polydata cells
-    // while removing degenerate lines.
-    if (npts < 2)
+  for (bool firstPass = true;; firstPass = false)
+  {
+    ptOffsets[0] = stripOffsets[0] = connOffsets[0] = 0;
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      const vtkIdType npts = lineNumPts[lineId];
+      ptOffsets[lineId + 1] =
+        (npts ? this->ComputeOffset(ptOffsets[lineId], npts) : ptOffsets[lineId]);
+      stripOffsets[lineId + 1] = stripOffsets[lineId] + (npts ? numSideStrips + numCapStrips : 0);
+      connOffsets[lineId + 1] = connOffsets[lineId] +
+        (npts ? 2 * npts * numSideStrips + numCapStrips * this->NumberOfSides : 0);
+    }
+    const vtkIdType numNewPts = ptOffsets[numLines];
+    const vtkIdType numNewStrips = stripOffsets[numLines];
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
     {
-      continue; // skip tubing this polyline
-    }
-    std::vector<vtkIdType> ptsCopy(ptsOrig, ptsOrig + npts);
-    vtkIdType* pts = ptsCopy.data();
+      newTCoords->SetNumberOfTuples(numNewPts);
+    }
+    srcPtIds->SetNumberOfIds(numNewPts);
+    newOffsets->SetNumberOfValues(numNewStrips + 1);
+    newOffsets->SetValue(numNewStrips, connOffsets[numLines]);
+    newConnectivity->SetNumberOfValues(connOffsets[numLines]);
+    srcCellIds->SetNumberOfIds(numNewStrips);
+
+    // the line cellIds start after the last vert cellId
+    const vtkIdType firstCellId = input->GetNumberOfVerts();
+    vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+      auto lineIter = vtk::TakeSmartPointer(inLines->NewIterator());
+      std::vector<vtkIdType> pts;
+      vtkLineNormals lineNormals;
+      for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+      {
+        if (!lineNumPts[lineId])
+        {
+          continue; // skip tubing this polyline
+        }
+        const vtkIdType npts = GetLinePoints(lineIter, lineId, inPts, pts);
 
-    // remove degenerate lines to avoid warnings
-    npts = static_cast<vtkIdType>(std::unique(pts, pts + npts, IdPointsEqual(inPts)) - pts);
-    if (npts < 2)
-    {
-      continue; // skip tubing this polyline
-    }
+        // If necessary calculate normals, each polyline calculates its
+        // normals independently, avoiding conflicts at shared vertices.
+        vtkDataArray* normals = inNormals;
+        const vtkIdType* normalIds = pts.data();
+        if (generateNormals)
+        {
+          normals = lineNormals.Normals;
+          lineNormals.Generate(inPts, npts, pts.data());
+          normalIds = lineNormals.GetNormalIds();
+        }
 
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
-    {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      lineNormalGenerator->GenerateSlidingNormals(inPts, singlePolyline, inNormals);
-    }
+        // Generate the points around the polyline. The tube is not stripped
+        // if the polyline is bad.
+        //
+        if (!this->GeneratePoints(ptOffsets[lineId], npts, pts.data(), inPts, newPts, srcPtIds,
+              newNormals, inScalars, range, inVectors, maxSpeed, normals, normalIds,
+              lineWarnings[lineId]))
+        {
+          lineWarnings[lineId].emplace_back("Could not generate points!");
+          lineNumPts[lineId] = 0;
+          continue; // skip tubing this polyline
+        }
 
-    // Generate the points around the polyline. The tube is not stripped
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars,
-          range, inVectors, maxSpeed, inNormals))
-    {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip tubing this polyline
-    }
+        // Generate the strips for this polyline (including caps)
+        //
+        this->GenerateStrips(ptOffsets[lineId], npts, firstCellId + lineId,
+          stripOffsets[lineId], connOffsets[lineId], newOffsets->GetPointer(0),
+          newConnectivity->GetPointer(0), srcCellIds);
 
-    // Generate the strips for this polyline (including caps)
-    //
-    this->GenerateStrips(offset, npts, pts, inCellId, cd, outCD, newStrips);
+        // Generate the texture coordinates for this polyline
+        //
+        if (newTCoords)
+        {
+          this->GenerateTextureCoords(
+            ptOffsets[lineId], npts, pts.data(), inPts, inScalars, newTCoords);
+        }
+      } // for all polylines
+    });
 
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
+    // Report the problems in the order of the polylines
+    bool failed = false;
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
+    {
+      if (firstPass)
+      {
+        for (const std::string& warning : lineWarnings[lineId])
+        {
+          vtkWarningMacro(<< warning);
+        }
+      }
+      lineWarnings[lineId].clear();
+      failed |= (!lineNumPts[lineId] && ptOffsets[lineId + 1] != ptOffsets[lineId]);
+    }
+    if (!failed)
     {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      break;
     }
-
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+  }
+  this->UpdateProgress(0.75);
 
   // reset the radius to ite original value if necessary
   if (this->VaryRadius == VTK_VARY_RADIUS_BY_ABSOLUTE_SCALAR)
@@ -302,6 +376,22 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
     this->Radius = oldRadius;
   }
 
+  // Copy the point data, and selected parts of the cell data; certainly
+  // don't want normals
+  //
+  vtkNew<vtkIdList> dstPtIds;
+  dstPtIds->SetNumberOfIds(srcPtIds->GetNumberOfIds());
+  std::iota(dstPtIds->GetPointer(0), dstPtIds->GetPointer(0) + dstPtIds->GetNumberOfIds(), 0);
+  outPD->CopyAllocate(pd, dstPtIds->GetNumberOfIds());
+  outPD->CopyData(pd, srcPtIds, dstPtIds);
+  vtkNew<vtkIdList> dstCellIds;
+  dstCellIds->SetNumberOfIds(srcCellIds->GetNumberOfIds());
+  std::iota(
+    dstCellIds->GetPointer(0), dstCellIds->GetPointer(0) + dstCellIds->GetNumberOfIds(), 0);
+  outCD->CopyNormalsOff();
+  outCD->CopyAllocate(cd, dstCellIds->GetNumberOfIds());
+  outCD->CopyData(cd, srcCellIds, dstCellIds);
+
   // Update ourselves
   //
   if (deleteNormals)
@@ -318,12 +408,12 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPoints(newPts);
   newPts->Delete();
 
+  newStrips->SetData(newOffsets, newConnectivity);
   output->SetStrips(newStrips);
   newStrips->Delete();
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -331,9 +421,9 @@ int vtkTubeFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
-  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors,
-  double maxSpeed, vtkDataArray* inNormals)
+  vtkPoints* inPts, vtkPoints* newPts, vtkIdList* srcIds, vtkFloatArray* newNormals,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxSpeed,
+  vtkDataArray* inNormals, const vtkIdType* normalIds, std::vector<std::string>& warnings)
 {
   vtkIdType j;
   int i, k;
@@ -347,10 +437,26 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   // double bevelAngle;
   double w[3];
   double nP[3];
+  double v[3];
   double sFactor = 1.0;
   double normal[3];
   vtkIdType ptId = offset;
 
+  // The cosines and sines of the angles of the sides, and of the angles half
+  // way between the sides, computed once for the whole line.
+  std::vector<double> cosines(3 * this->NumberOfSides);
+  std::vector<double> sines(3 * this->NumberOfSides);
+  for (k = 0; k < this->NumberOfSides; k++)
+  {
+    const double angles[3] = { (double)k * this->Theta, (double)(k - 0.5) * this->Theta,
+      (double)(k + 0.5) * this->Theta };
+    for (i = 0; i < 3; i++)
+    {
+      cosines[3 * k + i] = cos(angles[i]);
+      sines[3 * k + i] = sin(angles[i]);
+    }
+  }
+
   // Use "averaged" segment to create beveled effect.
   // Watch out for first and last points.
   //
@@ -392,11 +498,11 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
-      vtkWarningMacro(<< "Coincident points!");
+      warnings.emplace_back("Coincident points!");
       return 0;
     }
 
@@ -407,12 +513,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     // if s is zero then just use sPrev cross n
     if (vtkMath::Normalize(s) == 0.0)
     {
-      vtkDebugMacro(<< "Using alternate bevel vector");
       vtkMath::Cross(sPrev, n, s);
-      if (vtkMath::Normalize(s) == 0.0)
-      {
-        vtkDebugMacro(<< "Using alternate bevel vector");
-      }
+      vtkMath::Normalize(s);
     }
 
     /*    if ( (bevelAngle = vtkMath::Dot(sNext,sPrev)) > 1.0 )
@@ -434,8 +536,10 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     vtkMath::Cross(s, n, w);
     if (vtkMath::Normalize(w) == 0.0)
     {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
+      std::ostringstream warning;
+      warning << "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0] << " "
+              << n[1] << " " << n[2];
+      warnings.push_back(warning.str());
       return 0;
     }
 
@@ -451,7 +555,8 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     }
     else if (inVectors && this->VaryRadius == VTK_VARY_RADIUS_BY_VECTOR)
     {
-      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(inVectors->GetTuple(pts[j])));
+      inVectors->GetTuple(pts[j], v);
+      sFactor = sqrt((double)maxSpeed / vtkMath::Norm(v));
       if (sFactor > this->RadiusFactor)
       {
         sFactor = this->RadiusFactor;
@@ -462,7 +567,7 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
       sFactor = inScalars->GetComponent(pts[j], 0);
       if (sFactor < 0.0)
       {
-        vtkWarningMacro(<< "Scalar value less than zero, skipping line");
+        warnings.emplace_back("Scalar value less than zero, skipping line");
         return 0;
       }
     }
@@ -474,12 +579,12 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
       {
         for (i = 0; i < 3; i++)
         {
-          normal[i] = w[i] * cos((double)k * this->Theta) + nP[i] * sin((double)k * this->Theta);
+          normal[i] = w[i] * cosines[3 * k] + nP[i] * sines[3 * k];
           s[i] = p[i] + this->Radius * sFactor * normal[i];
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, normal);
-        outPD->CopyData(pd, pts[j], ptId);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, normal);
+        srcIds->SetId(ptId, pts[j]);
         ptId++;
       } // for each side
     }
@@ -496,20 +601,17 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
           // polygonal appearance, as if by flat-shading around the tube,
           // while still allowing smooth (gouraud) shading along the
           // tube as it bends.
-          normal[i] = w[i] * cos((double)(k + 0.0) * this->Theta) +
-            nP[i] * sin((double)(k + 0.0) * this->Theta);
-          n_right[i] = w[i] * cos((double)(k - 0.5) * this->Theta) +
-            nP[i] * sin((double)(k - 0.5) * this->Theta);
-          n_left[i] = w[i] * cos((double)(k + 0.5) * this->Theta) +
-            nP[i] * sin((double)(k + 0.5) * this->Theta);
+          normal[i] = w[i] * cosines[3 * k] + nP[i] * sines[3 * k];
+          n_right[i] = w[i] * cosines[3 * k + 1] + nP[i] * sines[3 * k + 1];
+          n_left[i] = w[i] * cosines[3 * k + 2] + nP[i] * sines[3 * k + 2];
           s[i] = p[i] + this->Radius * sFactor * normal[i];
         }
-        newPts->InsertPoint(ptId, s);
-        newNormals->InsertTuple(ptId, n_right);
-        outPD->CopyData(pd, pts[j], ptId);
-        newPts->InsertPoint(ptId + 1, s);
-        newNormals->InsertTuple(ptId + 1, n_left);
-        outPD->CopyData(pd, pts[j], ptId + 1);
+        newPts->SetPoint(ptId, s);
+        newNormals->SetTuple(ptId, n_right);
+        srcIds->SetId(ptId, pts[j]);
+        newPts->SetPoint(ptId + 1, s);
+        newNormals->SetTuple(ptId + 1, n_left);
+        srcIds->SetId(ptId + 1, pts[j]);
         ptId += 2;
       } // for each side
     }   // else separate vertices
@@ -530,9 +632,9 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     for (k = 0; k < numCapSides; k += capIncr)
     {
       newPts->GetPoint(offset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, startCapNorm);
-      outPD->CopyData(pd, pts[0], ptId);
+      newPts->SetPoint(ptId, s);
+      newNormals->SetTuple(ptId, startCapNorm);
+      srcIds->SetId(ptId, pts[0]);
       ptId++;
     }
     // the end cap
@@ -544,9 +646,9 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
     for (k = 0; k < numCapSides; k += capIncr)
     {
       newPts->GetPoint(endOffset + k, s);
-      newPts->InsertPoint(ptId, s);
-      newNormals->InsertTuple(ptId, endCapNorm);
-      outPD->CopyData(pd, pts[npts - 1], ptId);
+      newPts->SetPoint(ptId, s);
+      newNormals->SetTuple(ptId, endCapNorm);
+      srcIds->SetId(ptId, pts[npts - 1]);
       ptId++;
     }
   } // if capping
@@ -554,11 +656,11 @@ int vtkTubeFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdT
   return 1;
 }
 
-void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
+void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType inCellId,
+  vtkIdType outCellId, vtkIdType connId, vtkIdType* stripOffsets, vtkIdType* connectivity,
+  vtkIdList* srcIds)
 {
-  vtkIdType i, outCellId;
+  vtkIdType i;
   int k;
   int i1, i2, i3;
 
@@ -568,13 +670,13 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = k % this->NumberOfSides;
       i2 = (k + 1) % this->NumberOfSides;
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      stripOffsets[outCellId] = connId;
+      srcIds->SetId(outCellId++, inCellId);
       for (i = 0; i < npts; i++)
       {
         i3 = i * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        connectivity[connId++] = offset + i2 + i3;
+        connectivity[connId++] = offset + i1 + i3;
       }
     } // for each side of the tube
   }
@@ -584,13 +686,13 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     {
       i1 = 2 * (k % this->NumberOfSides) + 1;
       i2 = 2 * ((k + 1) % this->NumberOfSides);
-      outCellId = newStrips->InsertNextCell(npts * 2);
-      outCD->CopyData(cd, inCellId, outCellId);
+      stripOffsets[outCellId] = connId;
+      srcIds->SetId(outCellId++, inCellId);
       for (i = 0; i < npts; i++)
       {
         i3 = i * 2 * this->NumberOfSides;
-        newStrips->InsertCellPoint(offset + i2 + i3);
-        newStrips->InsertCellPoint(offset + i1 + i3);
+        connectivity[connId++] = offset + i2 + i3;
+        connectivity[connId++] = offset + i1 + i3;
       }
     } // for each side of the tube
   }
@@ -608,44 +710,44 @@ void vtkTubeFilter::GenerateStrips(vtkIdType offset, vtkIdType npts,
     }
 
     // The start cap
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + 1);
+    stripOffsets[outCellId] = connId;
+    srcIds->SetId(outCellId++, inCellId);
+    connectivity[connId++] = startIdx;
+    connectivity[connId++] = startIdx + 1;
     for (i1 = this->NumberOfSides - 1, i2 = 2, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
         idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        connectivity[connId++] = idx;
         i2++;
       }
       else
       {
         idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        connectivity[connId++] = idx;
         i1--;
       }
     }
 
     // The end cap - reversed order to be consistent with normal
     startIdx += this->NumberOfSides;
-    outCellId = newStrips->InsertNextCell(this->NumberOfSides);
-    outCD->CopyData(cd, inCellId, outCellId);
-    newStrips->InsertCellPoint(startIdx);
-    newStrips->InsertCellPoint(startIdx + this->NumberOfSides - 1);
+    stripOffsets[outCellId] = connId;
+    srcIds->SetId(outCellId++, inCellId);
+    connectivity[connId++] = startIdx;
+    connectivity[connId++] = startIdx + this->NumberOfSides - 1;
     for (i1 = this->NumberOfSides - 2, i2 = 1, k = 0; k < (this->NumberOfSides - 2); k++)
     {
       if ((k % 2))
       {
         idx = startIdx + i1;
-        newStrips->InsertCellPoint(idx);
+        connectivity[connId++] = idx;
         i1--;
       }
       else
       {
         idx = startIdx + i2;
-        newStrips->InsertCellPoint(idx);
+        connectivity[connId++] = idx;
         i2++;
       }
     }
@@ -668,15 +770,15 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
   double s0, s;
   if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0], 0);
     for (i = 0; i < npts; i++)
     {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i], 0);
       tc = (s - s0) / this->TextureLength;
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
     }
   }
@@ -692,7 +794,7 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
 
       xPrev[0] = x[0];
@@ -722,7 +824,7 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
       for (k = 0; k < numSides; k++)
       {
         double tcy = static_cast<double>(k) / (numSides - 1);
-        newTCoords->InsertTuple2(offset + i * numSides + k, tc, tcy);
+        newTCoords->SetTuple2(offset + i * numSides + k, tc, tcy);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -739,13 +841,13 @@ void vtkTubeFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, cons
     // start cap
     for (ik = 0; ik < this->NumberOfSides; ik++)
     {
-      newTCoords->InsertTuple2(startIdx + ik, 0.0, 0.0);
+      newTCoords->SetTuple2(startIdx + ik, 0.0, 0.0);
     }
 
     // end cap
     for (ik = 0; ik < this->NumberOfSides; ik++)
     {
-      newTCoords->InsertTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
+      newTCoords->SetTuple2(startIdx + this->NumberOfSides + ik, tc, 0.0);
     }
   }
 }
@@ -44,6 +44,13 @@
  * can be removed with vtkCleanPolyData.) If a line does not meet this
  * criteria, then that line is not tubed.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The size of the output of
+ * each line is computed first, so that the tubes are generated in parallel
+ * directly at their place in the output. Using TBB or other non-sequential
+ * type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve
+ * performance significantly.
+ *
  * @sa
  * vtkRibbonFilter vtkStreamTracer
  *
@@ -57,6 +64,9 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+#include <string> // For std::string
+#include <vector> // For std::vector
+
 #define VTK_VARY_RADIUS_OFF 0
 #define VTK_VARY_RADIUS_BY_SCALAR 1
 #define VTK_VARY_RADIUS_BY_VECTOR 2
@@ -67,11 +77,9 @@
 #define VTK_TCOORDS_FROM_LENGTH 2
 #define VTK_TCOORDS_FROM_SCALARS 3
 
-class vtkCellArray;
-class vtkCellData;
 class vtkDataArray;
 class vtkFloatArray;
-class vtkPointData;
+class vtkIdList;
 class vtkPoints;
 
 class VTKFILTERSCORE_EXPORT vtkTubeFilter : public vtkPolyDataAlgorithm
@@ -246,13 +254,15 @@ protected:
   int OutputPointsPrecision;
   double TextureLength; // this length is mapped to [0,1) texture space
 
-  // Helper methods
+  // Helper methods. They are invoked in parallel, one polyline at a time,
+  // and write at the given offsets in the presized output arrays. The ids
+  // of the input points and cells to copy the data from are stored in srcIds.
   int GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkPoints* inPts,
-    vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD, vtkFloatArray* newNormals,
-    vtkDataArray* inScalars, double range[2], vtkDataArray* inVectors, double maxNorm,
-    vtkDataArray* inNormals);
-  void GenerateStrips(vtkIdType offset, vtkIdType npts, const vtkIdType* pts, vtkIdType inCellId,
-    vtkCellData* cd, vtkCellData* outCD, vtkCellArray* newStrips);
+    vtkPoints* newPts, vtkIdList* srcIds, vtkFloatArray* newNormals, vtkDataArray* inScalars,
+    double range[2], vtkDataArray* inVectors, double maxNorm, vtkDataArray* inNormals,
+    const vtkIdType* normalIds, std::vector<std::string>& warnings);
+  void GenerateStrips(vtkIdType offset, vtkIdType npts, vtkIdType inCellId, vtkIdType outCellId,
+    vtkIdType connId, vtkIdType* stripOffsets, vtkIdType* connectivity, vtkIdList* srcIds);
   void GenerateTextureCoords(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
     vtkPoints* inPts, vtkDataArray* inScalars, vtkFloatArray* newTCoords);
   vtkIdType ComputeOffset(vtkIdType offset, vtkIdType npts);
@@ -23,10 +23,15 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkPolyDataSmoothingInternal.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkWindowedSincPolyDataFilter);
 
 //-----------------------------------------------------------------------------
@@ -52,18 +57,6 @@ vtkWindowedSincPolyDataFilter::vtkWindowedSincPolyDataFilter()
   this->NormalizeCoordinates = 0;
 }
 
-#define VTK_SIMPLE_VERTEX 0
-#define VTK_FIXED_VERTEX 1
-#define VTK_FEATURE_EDGE_VERTEX 2
-#define VTK_BOUNDARY_EDGE_VERTEX 3
-
-// Special structure for marking vertices
-typedef struct _vtkMeshVertex
-{
-  char type;
-  vtkIdList* edges; // connected edges (list of connected point ids)
-} vtkMeshVertex, *vtkMeshVertexPtr;
-
 //-----------------------------------------------------------------------------
 int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -77,11 +70,8 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
 
   vtkIdType numPts, numCells, numPolys, numStrips, i;
-  int j, k;
   vtkIdType npts = 0;
   const vtkIdType* pts = nullptr;
-  vtkIdType p1, p2;
-  double x[3], y[3], deltaX[3], xNew[3];
   double x1[3], x2[3], x3[3], l1[3], l2[3];
   double CosFeatureAngle; // Cosine of angle between adjacent polys
   double CosEdgeAngle;    // Cosine of angle between adjacent edges
@@ -92,10 +82,10 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   vtkTriangleFilter* toTris = nullptr;
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints* newPts[4];
-  vtkMeshVertexPtr Verts;
+  vtkMeshVertices Verts;
 
   // variables specific to windowed sinc interpolation
-  double theta_pb, k_pb, sigma, p_x0[3], p_x1[3], p_x3[3];
+  double theta_pb, k_pb, sigma;
   double *w, *c, *cprime;
   int zero, one, two, three;
 
@@ -138,76 +128,71 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // vertices. FIXED vertices are never smoothed. Edge vertices are smoothed
   // using a subset of the attached vertices.
   vtkDebugMacro(<< "Analyzing topology...");
-  Verts = new vtkMeshVertex[numPts];
-  for (i = 0; i < numPts; i++)
-  {
-    Verts[i].type = VTK_SIMPLE_VERTEX; // can smooth
-    Verts[i].edges = nullptr;
-  }
+  Verts.Types.resize(numPts, VTK_SIMPLE_VERTEX); // can smooth
 
   inPts = input->GetPoints();
 
   // check vertices first. Vertices are never smoothed_--------------
   for (inVerts = input->GetVerts(), inVerts->InitTraversal(); inVerts->GetNextCell(npts, pts);)
   {
-    for (j = 0; j < npts; j++)
+    for (vtkIdType j = 0; j < npts; j++)
     {
-      Verts[pts[j]].type = VTK_FIXED_VERTEX;
+      Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
     }
   }
 
   this->UpdateProgress(0.10);
 
   // now check lines. Only manifold lines can be smoothed------------
-  for (inLines = input->GetLines(), inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
+  inLines = input->GetLines();
+  if (inLines->GetNumberOfCells() > 0)
+  {
+    Verts.LineEdges.resize(2 * numPts, -1);
+  }
+  for (inLines->InitTraversal(); inLines->GetNextCell(npts, pts);)
   {
     // Check for closed loop which are treated specially. Basically the
     // last point is ignored (set to fixed).
     bool closedLoop = (pts[0] == pts[npts - 1] && npts > 3);
 
-    for (j = 0; j < npts; j++)
+    for (vtkIdType j = 0; j < npts; j++)
     {
-      if (Verts[pts[j]].type == VTK_SIMPLE_VERTEX)
+      if (Verts.Types[pts[j]] == VTK_SIMPLE_VERTEX)
       {
         // First point
         if (j == 0)
         {
           if (!closedLoop)
           {
-            Verts[pts[0]].type = VTK_FIXED_VERTEX;
+            Verts.Types[pts[0]] = VTK_FIXED_VERTEX;
           }
           else
           {
-            Verts[pts[0]].type = VTK_FEATURE_EDGE_VERTEX;
-            Verts[pts[0]].edges = vtkIdList::New();
-            Verts[pts[0]].edges->SetNumberOfIds(2);
-            Verts[pts[0]].edges->SetId(0, pts[npts - 2]);
-            Verts[pts[0]].edges->SetId(1, pts[1]);
+            Verts.Types[pts[0]] = VTK_FEATURE_EDGE_VERTEX;
+            Verts.LineEdges[2 * pts[0]] = pts[npts - 2];
+            Verts.LineEdges[2 * pts[0] + 1] = pts[1];
           }
         }
         // Last point
         else if (j == (npts - 1) && !closedLoop)
         {
-          Verts[pts[j]].type = VTK_FIXED_VERTEX;
+          Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
         }
         // In between point
         else // is edge vertex (unless already edge vertex!)
         {
-          Verts[pts[j]].type = VTK_FEATURE_EDGE_VERTEX;
-          Verts[pts[j]].edges = vtkIdList::New();
-          Verts[pts[j]].edges->SetNumberOfIds(2);
-          Verts[pts[j]].edges->SetId(0, pts[j - 1]);
-          Verts[pts[j]].edges->SetId(1, pts[(closedLoop && j == (npts - 2) ? 0 : (j + 1))]);
+          Verts.Types[pts[j]] = VTK_FEATURE_EDGE_VERTEX;
+          Verts.LineEdges[2 * pts[j]] = pts[j - 1];
+          Verts.LineEdges[2 * pts[j] + 1] = pts[(closedLoop && j == (npts - 2) ? 0 : (j + 1))];
         }
       } // if simple vertex
 
       // Vertex has been visited before, need to fix it. Special case
       // when working on closed loop.
-      else if (Verts[pts[j]].type == VTK_FEATURE_EDGE_VERTEX && !(closedLoop && j == (npts - 1)))
+      else if (Verts.Types[pts[j]] == VTK_FEATURE_EDGE_VERTEX && !(closedLoop && j == (npts - 1)))
       {
-        Verts[pts[j]].type = VTK_FIXED_VERTEX;
-        Verts[pts[j]].edges->Delete();
-        Verts[pts[j]].edges = nullptr;
+        Verts.Types[pts[j]] = VTK_FIXED_VERTEX;
+        Verts.LineEdges[2 * pts[j]] = -1;
       }
     } // for all points in this line
   }   // for all lines
@@ -220,22 +205,15 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   inStrips = input->GetStrips();
   numStrips = inStrips->GetNumberOfCells();
 
+  // Half-edges to do neighborhood searching
+  vtkStaticHalfEdgeMeshTemplate<vtkIdType> halfEdges;
+  std::vector<unsigned char> edgeTypes;
   if (numPolys > 0 || numStrips > 0)
   { // build cell structure
-    vtkCellArray* polys;
-    vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList* neighbors;
-
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
     inMesh->SetPolys(inPolys);
     Mesh = inMesh;
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
 
     if ((numStrips = inStrips->GetNumberOfCells()) > 0)
     { // convert data to triangles
@@ -246,161 +224,57 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
       Mesh = toTris->GetOutput();
     }
 
-    Mesh->BuildLinks(); // to do neighborhood searching
-    polys = Mesh->GetPolys();
-
-    for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
-    {
-      for (i = 0; i < npts; i++)
-      {
-        p1 = pts[i];
-        p2 = pts[(i + 1) % npts];
-
-        if (Verts[p1].edges == nullptr)
-        {
-          Verts[p1].edges = vtkIdList::New();
-          Verts[p1].edges->Allocate(16, 6);
-          // Verts[p1].edges = new vtkIdList(6,6);
-        }
-        if (Verts[p2].edges == nullptr)
-        {
-          Verts[p2].edges = vtkIdList::New();
-          Verts[p2].edges->Allocate(16, 6);
-          // Verts[p2].edges = new vtkIdList(6,6);
-        }
-
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
-
-        edge = VTK_SIMPLE_VERTEX;
-        if (numNei == 0)
-        {
-          edge = VTK_BOUNDARY_EDGE_VERTEX;
-        }
-
-        else if (numNei >= 2)
-        {
-          // non-manifold case, check nonmanifold smoothing state
-          if (!this->NonManifoldSmoothing)
-          {
-            // check to make sure that this edge hasn't been marked already
-            for (j = 0; j < numNei; j++)
-            {
-              if (neighbors->GetId(j) < cellId)
-              {
-                break;
-              }
-            }
-            if (j >= numNei)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
-        {
-          if (this->FeatureEdgeSmoothing)
-          {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts,
-              // vtkCell API needs fixing...
-              const_cast<vtkIdType*>(neiPts), neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
-            {
-              edge = VTK_FEATURE_EDGE_VERTEX;
-            }
-          }
-        }
-        else // a visited edge; skip rest of analysis
-        {
-          continue;
-        }
-
-        if (edge && Verts[p1].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p1].edges->Reset();
-          Verts[p1].edges->InsertNextId(p2);
-          Verts[p1].type = edge;
-        }
-        else if ((edge && Verts[p1].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p1].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p1].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p1].edges->InsertNextId(p2);
-          if (Verts[p1].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p1].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-
-        if (edge && Verts[p2].type == VTK_SIMPLE_VERTEX)
-        {
-          Verts[p2].edges->Reset();
-          Verts[p2].edges->InsertNextId(p1);
-          Verts[p2].type = edge;
-        }
-        else if ((edge && Verts[p2].type == VTK_BOUNDARY_EDGE_VERTEX) ||
-          (edge && Verts[p2].type == VTK_FEATURE_EDGE_VERTEX) ||
-          (!edge && Verts[p2].type == VTK_SIMPLE_VERTEX))
-        {
-          Verts[p2].edges->InsertNextId(p1);
-          if (Verts[p2].type && edge == VTK_BOUNDARY_EDGE_VERTEX)
-          {
-            Verts[p2].type = VTK_BOUNDARY_EDGE_VERTEX;
-          }
-        }
-      }
-    }
-
-    //    delete inMesh; // delete this later, windowed sinc smoothing needs it
-    if (toTris)
-    {
-      toTris->Delete();
-    }
-    neighbors->Delete();
+    halfEdges.BuildHalfEdges(Mesh);
+    edgeTypes.resize(halfEdges.GetNumberOfHalfEdges());
+    vtkClassifyMeshEdges(inPts, halfEdges, this->FeatureEdgeSmoothing != 0,
+      this->NonManifoldSmoothing != 0, CosFeatureAngle, edgeTypes.data());
   } // if strips or polys
+  vtkBuildMeshEdges(halfEdges, edgeTypes.data(), Verts);
+  halfEdges.Initialize();
+  if (toTris)
+  {
+    toTris->Delete();
+  }
 
   this->UpdateProgress(0.50);
 
   // post-process edge vertices to make sure we can smooth them
   for (i = 0; i < numPts; i++)
   {
-    if (Verts[i].type == VTK_SIMPLE_VERTEX)
+    if (Verts.Types[i] == VTK_SIMPLE_VERTEX)
     {
       numSimple++;
     }
 
-    else if (Verts[i].type == VTK_FIXED_VERTEX)
+    else if (Verts.Types[i] == VTK_FIXED_VERTEX)
     {
       numFixed++;
     }
 
-    else if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX || Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
+    else if (Verts.Types[i] == VTK_FEATURE_EDGE_VERTEX ||
+      Verts.Types[i] == VTK_BOUNDARY_EDGE_VERTEX)
     { // see how many edges; if two, what the angle is
 
-      if (!this->BoundarySmoothing && Verts[i].type == VTK_BOUNDARY_EDGE_VERTEX)
+      if (!this->BoundarySmoothing && Verts.Types[i] == VTK_BOUNDARY_EDGE_VERTEX)
       {
-        Verts[i].type = VTK_FIXED_VERTEX;
+        Verts.Types[i] = VTK_FIXED_VERTEX;
         numBEdges++;
       }
 
-      else if ((npts = Verts[i].edges->GetNumberOfIds()) != 2)
+      else if (Verts.GetNumberOfEdges(i) != 2)
       {
         // can only smooth edges on 2-manifold surfaces
-        Verts[i].type = VTK_FIXED_VERTEX;
+        Verts.Types[i] = VTK_FIXED_VERTEX;
         numFixed++;
       }
 
       else // check angle between edges
       {
-        inPts->GetPoint(Verts[i].edges->GetId(0), x1);
+        inPts->GetPoint(Verts.GetEdges(i)[0], x1);
         inPts->GetPoint(i, x2);
-        inPts->GetPoint(Verts[i].edges->GetId(1), x3);
+        inPts->GetPoint(Verts.GetEdges(i)[1], x3);
 
-        for (k = 0; k < 3; k++)
+        for (int k = 0; k < 3; k++)
         {
           l1[k] = x2[k] - x1[k];
           l2[k] = x3[k] - x2[k];
@@ -409,11 +283,11 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
           (vtkMath::Dot(l1, l2) < CosEdgeAngle))
         {
           numFixed++;
-          Verts[i].type = VTK_FIXED_VERTEX;
+          Verts.Types[i] = VTK_FIXED_VERTEX;
         }
         else
         {
-          if (Verts[i].type == VTK_FEATURE_EDGE_VERTEX)
+          if (Verts.Types[i] == VTK_FEATURE_EDGE_VERTEX)
           {
             numFEdges++;
           }
@@ -467,7 +341,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     for (i = 0; i < numPts; i++) // initialize to old coordinates
     {
       inPts->GetPoint(i, normalizedPoint);
-      for (j = 0; j < 3; ++j)
+      for (int j = 0; j < 3; ++j)
       {
         normalizedPoint[j] = (normalizedPoint[j] - inCenter[j]) / inLength;
       }
@@ -494,9 +368,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   c = new double[this->NumberOfIterations + 1];
   cprime = new double[this->NumberOfIterations + 1];
 
-  double zerovector[3];
-  zerovector[0] = zerovector[1] = zerovector[2] = 0.0;
-
   // Calculate the weights and the Chebychev coefficients c.
   //
 
@@ -513,7 +384,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   int done = 0;
   sigma = 0.0;
 
-  for (j = 0; !done && (j < 500); j++)
+  for (int j = 0; !done && (j < 500); j++)
   {
     // Chebyshev coefficients
     c[0] = w[0] * (theta_pb + sigma) / vtkMath::Pi();
@@ -580,53 +451,66 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
                      "Unpredictable smoothing/shrinkage may result.");
   }
 
+  // The sweeps are Jacobi iterations: each point is updated from the
+  // previous positions of its neighbors, so the points are processed in
+  // parallel. The point arrays are the float arrays created above.
+  float* pts0 = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+  float* pts1 = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+  float* pts3 = static_cast<float*>(newPts[three]->GetVoidPointer(0));
+
   // first iteration
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3], y[3], deltaX[3];
+    for (; ptId < endPtId; ptId++)
     {
-      // point is allowed to move
-      newPts[zero]->GetPoint(i, x); // use current points
-      deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-      // calculate the negative of the laplacian
-      for (j = 0; j < npts; j++) // for all connected points
+      const vtkIdType numEdges = Verts.GetNumberOfEdges(ptId);
+      const vtkIdType* edges = Verts.GetEdges(ptId);
+      if (numEdges > 0)
       {
-        newPts[zero]->GetPoint(Verts[i].edges->GetId(j), y);
-        for (k = 0; k < 3; k++)
+        // point is allowed to move
+        for (int k = 0; k < 3; k++) // use current points
         {
-          deltaX[k] += (x[k] - y[k]) / npts;
+          x[k] = pts0[3 * ptId + k];
+          deltaX[k] = 0.0;
         }
-      }
-      // newPts[one] = newPts[zero] - 0.5 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = x[k] - 0.5 * deltaX[k];
-      }
-      newPts[one]->SetPoint(i, deltaX);
 
-      // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
-      for (k = 0; k < 3; k++)
-      {
-        deltaX[k] = c[0] * x[k] + c[1] * deltaX[k];
-      }
-      if (Verts[i].type == VTK_FIXED_VERTEX)
-      {
-        newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-      }
+        // calculate the negative of the laplacian
+        for (vtkIdType j = 0; j < numEdges; j++) // for all connected points
+        {
+          for (int k = 0; k < 3; k++)
+          {
+            y[k] = pts0[3 * edges[j] + k];
+            deltaX[k] += (x[k] - y[k]) / numEdges;
+          }
+        }
+        // newPts[one] = newPts[zero] - 0.5 newPts[one]
+        for (int k = 0; k < 3; k++)
+        {
+          deltaX[k] = x[k] - 0.5 * deltaX[k];
+          pts1[3 * ptId + k] = static_cast<float>(deltaX[k]);
+        }
+
+        // calculate newPts[three] = c0 newPts[zero] + c1 newPts[one]
+        for (int k = 0; k < 3; k++)
+        {
+          deltaX[k] = c[0] * x[k] + c[1] * deltaX[k];
+          pts3[3 * ptId + k] = (Verts.Types[ptId] == VTK_FIXED_VERTEX
+              ? pts0[3 * ptId + k]
+              : static_cast<float>(deltaX[k]));
+        }
+      } // if can move point
       else
       {
-        newPts[three]->SetPoint(i, deltaX);
+        // point is not allowed to move, just use the old point...
+        // (zero out the Laplacian)
+        for (int k = 0; k < 3; k++)
+        {
+          pts1[3 * ptId + k] = 0.0f;
+          pts3[3 * ptId + k] = pts0[3 * ptId + k];
+        }
       }
-    } // if can move point
-    else
-    {
-      // point is not allowed to move, just use the old point...
-      // (zero out the Laplacian)
-      newPts[one]->SetPoint(i, zerovector);
-      newPts[three]->SetPoint(i, newPts[zero]->GetPoint(i));
-    }
-  } // for all points
+    } // for all points
+  });
 
   // for the rest of the iterations
   for (iterationNumber = 2; iterationNumber <= this->NumberOfIterations; iterationNumber++)
@@ -640,52 +524,65 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
       }
     }
 
-    for (i = 0; i < numPts; i++)
-    {
-      if (Verts[i].edges != nullptr && (npts = Verts[i].edges->GetNumberOfIds()) > 0)
+    pts0 = static_cast<float*>(newPts[zero]->GetVoidPointer(0));
+    pts1 = static_cast<float*>(newPts[one]->GetVoidPointer(0));
+    float* pts2 = static_cast<float*>(newPts[two]->GetVoidPointer(0));
+    const double cj = c[iterationNumber];
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double p_x0[3], p_x1[3], y[3], deltaX[3];
+      for (; ptId < endPtId; ptId++)
       {
-        // point is allowed to move
-        newPts[zero]->GetPoint(i, p_x0); // use current points
-        newPts[one]->GetPoint(i, p_x1);
-
-        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
-
-        // calculate the negative laplacian of x1
-        for (j = 0; j < npts; j++)
+        const vtkIdType numEdges = Verts.GetNumberOfEdges(ptId);
+        const vtkIdType* edges = Verts.GetEdges(ptId);
+        if (numEdges > 0)
         {
-          newPts[one]->GetPoint(Verts[i].edges->GetId(j), y);
-          for (k = 0; k < 3; k++)
+          // point is allowed to move
+          for (int k = 0; k < 3; k++) // use current points
           {
-            deltaX[k] += (p_x1[k] - y[k]) / npts;
+            p_x0[k] = pts0[3 * ptId + k];
+            p_x1[k] = pts1[3 * ptId + k];
+            deltaX[k] = 0.0;
           }
-        } // for all connected points
 
-        // Taubin:  x2 = (x1 - x0) + (x1 - x2)
-        for (k = 0; k < 3; k++)
-        {
-          deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
-        }
-        newPts[two]->SetPoint(i, deltaX);
+          // calculate the negative laplacian of x1
+          for (vtkIdType j = 0; j < numEdges; j++)
+          {
+            for (int k = 0; k < 3; k++)
+            {
+              y[k] = pts1[3 * edges[j] + k];
+              deltaX[k] += (p_x1[k] - y[k]) / numEdges;
+            }
+          } // for all connected points
 
-        // smooth the vertex (x3 = x3 + cj x2)
-        newPts[three]->GetPoint(i, p_x3);
-        for (k = 0; k < 3; k++)
-        {
-          xNew[k] = p_x3[k] + c[iterationNumber] * deltaX[k];
-        }
-        if (Verts[i].type != VTK_FIXED_VERTEX)
+          // Taubin:  x2 = (x1 - x0) + (x1 - x2)
+          for (int k = 0; k < 3; k++)
+          {
+            deltaX[k] = p_x1[k] - p_x0[k] + p_x1[k] - deltaX[k];
+            pts2[3 * ptId + k] = static_cast<float>(deltaX[k]);
+          }
+
+          // smooth the vertex (x3 = x3 + cj x2)
+          if (Verts.Types[ptId] != VTK_FIXED_VERTEX)
+          {
+            for (int k = 0; k < 3; k++)
+            {
+              double p_x3 = pts3[3 * ptId + k];
+              pts3[3 * ptId + k] = static_cast<float>(p_x3 + cj * deltaX[k]);
+            }
+          }
+        } // if can move point
+        else
         {
-          newPts[three]->SetPoint(i, xNew);
+          // point is not allowed to move, just use the old point...
+          // (zero out the Laplacian, newPts[one] is zero from the previous
+          // iterations)
+          for (int k = 0; k < 3; k++)
+          {
+            pts2[3 * ptId + k] = 0.0f;
+          }
         }
-      } // if can move point
-      else
-      {
-        // point is not allowed to move, just use the old point...
-        // (zero out the Laplacian)
-        newPts[one]->SetPoint(i, zerovector);
-        newPts[two]->SetPoint(i, zerovector);
-      }
-    } // for all points
+      } // for all points
+    });
 
     // update the pointers. three is always three. all other pointers
     // shift by one and wrap.
@@ -717,7 +614,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     for (i = 0; i < numPts; i++)
     {
       newPts[zero]->GetPoint(i, repositionedPoint);
-      for (j = 0; j < 3; ++j)
+      for (int j = 0; j < 3; ++j)
       {
         repositionedPoint[j] = repositionedPoint[j] * inLength + inCenter[j];
       }
@@ -754,7 +651,7 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     {
       inPts->GetPoint(i, x1);
       newPts[zero]->GetPoint(i, x2);
-      for (j = 0; j < 3; j++)
+      for (int j = 0; j < 3; j++)
       {
         x3[j] = x2[j] - x1[j];
       }
@@ -781,16 +678,6 @@ int vtkWindowedSincPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
     inMesh->Delete();
   }
 
-  // free up connectivity storage
-  for (i = 0; i < numPts; i++)
-  {
-    if (Verts[i].edges != nullptr)
-    {
-      Verts[i].edges->Delete();
-    }
-  }
-  delete[] Verts;
-
   return 1;
 }
 
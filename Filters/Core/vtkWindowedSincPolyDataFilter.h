@@ -131,6 +131,11 @@
  * lost. Enabling FeatureEdgeSmoothing helps reduce this effect, but cannot
  * entirely eliminate it.
  *
+ * @warning
+ * This class has been threaded with vtkSMPTools. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
  * @sa
  * vtkSmoothPolyDataFilter vtkDecimate vtkDecimatePro
  */
@@ -0,0 +1,158 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExtractEdges.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the number of edges extracted from several datasets by the default
+// parallel algorithm and by the serial one used with a locator, and check
+// that each edge joins two points of the cell it comes from.
+
+#include "vtkExtractEdges.h"
+
+#include "vtkCellData.h"
+#include "vtkCellTypeSource.h"
+#include "vtkCubeSource.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkStripper.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+// Unless numEdges is negative, both algorithms must output numPts points
+// and numEdges edges. Otherwise they must output as many as each other.
+int CheckEdges(vtkDataSet* input, vtkIdType numPts, vtkIdType numEdges, const char* label)
+{
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellIds");
+  for (vtkIdType cellId = 0; cellId < input->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  input->GetCellData()->AddArray(cellIds);
+
+  vtkNew<vtkExtractEdges> parallel;
+  parallel->SetInputData(input);
+  parallel->Update();
+  vtkPolyData* output = parallel->GetOutput();
+
+  vtkNew<vtkExtractEdges> serial;
+  vtkNew<vtkMergePoints> locator;
+  serial->SetInputData(input);
+  serial->SetLocator(locator);
+  serial->Update();
+  if (numEdges < 0)
+  {
+    numPts = serial->GetOutput()->GetNumberOfPoints();
+    numEdges = serial->GetOutput()->GetNumberOfLines();
+  }
+
+  if (output->GetNumberOfPoints() != numPts || output->GetNumberOfLines() != numEdges ||
+    serial->GetOutput()->GetNumberOfPoints() != numPts ||
+    serial->GetOutput()->GetNumberOfLines() != numEdges)
+  {
+    cerr << label << ": " << output->GetNumberOfPoints() << " points and "
+         << output->GetNumberOfLines() << " edges instead of " << numPts << " and " << numEdges
+         << endl;
+    return 1;
+  }
+
+  vtkDataArray* edgeCellIds = output->GetCellData()->GetArray("CellIds");
+  vtkNew<vtkIdList> cellPts;
+  vtkNew<vtkIdList> edgePts;
+  for (vtkIdType edgeId = 0; edgeId < numEdges; ++edgeId)
+  {
+    input->GetCellPoints(static_cast<vtkIdType>(edgeCellIds->GetTuple1(edgeId)), cellPts);
+    output->GetCellPoints(edgeId, edgePts);
+    for (vtkIdType i = 0; i < 2; ++i)
+    {
+      double x[3], y[3];
+      output->GetPoint(edgePts->GetId(i), x);
+      bool inCell = false;
+      for (vtkIdType j = 0; j < cellPts->GetNumberOfIds() && !inCell; ++j)
+      {
+        input->GetPoint(cellPts->GetId(j), y);
+        inCell = (x[0] == y[0] && x[1] == y[1] && x[2] == y[2]);
+      }
+      if (!inCell)
+      {
+        cerr << label << ": edge " << edgeId << " is not an edge of its cell" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
+int TestExtractEdges(int, char*[])
+{
+  // A closed triangulated sphere has V + F - 2 edges.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(16);
+  sphere->SetPhiResolution(9);
+  sphere->Update();
+  vtkNew<vtkPolyData> spherePolys;
+  spherePolys->DeepCopy(sphere->GetOutput());
+  int status = CheckEdges(spherePolys, 114, 114 + 224 - 2, "Sphere");
+
+  // The edges of a triangle strip are its first and last edges and the
+  // edges joining every other point, as in vtkTriangleStrip::GetEdge().
+  vtkNew<vtkStripper> stripper;
+  stripper->SetInputConnection(sphere->GetOutputPort());
+  stripper->Update();
+  vtkNew<vtkPolyData> sphereStrips;
+  sphereStrips->DeepCopy(stripper->GetOutput());
+  status += CheckEdges(sphereStrips, -1, -1, "Sphere strips");
+
+  // The faces of a cube do not share point ids, but the coincident points
+  // are merged.
+  vtkNew<vtkCubeSource> cube;
+  cube->Update();
+  vtkNew<vtkPolyData> cubePolys;
+  cubePolys->DeepCopy(cube->GetOutput());
+  status += CheckEdges(cubePolys, 8, 24, "Cube");
+
+  // A 4x3x3 grid of points has 75 edges, whether it is made of voxels or
+  // hexahedra.
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(4, 3, 3);
+  status += CheckEdges(image, 36, 75, "Image");
+
+  vtkNew<vtkCellTypeSource> hexahedra;
+  hexahedra->SetCellType(VTK_HEXAHEDRON);
+  hexahedra->SetBlocksDimensions(3, 2, 2);
+  hexahedra->Update();
+  status += CheckEdges(hexahedra->GetOutput(), 36, 75, "Hexahedra");
+
+  // The tetrahedra of each block share a point at its center. The quadratic
+  // edges of the tetrahedra are split in two at their mid-edge points.
+  vtkNew<vtkCellTypeSource> tetrahedra;
+  tetrahedra->SetCellType(VTK_TETRA);
+  tetrahedra->SetBlocksDimensions(3, 2, 2);
+  tetrahedra->Update();
+  status += CheckEdges(tetrahedra->GetOutput(), 48, 223, "Tetrahedra");
+
+  vtkNew<vtkCellTypeSource> quadraticTetrahedra;
+  quadraticTetrahedra->SetCellType(VTK_QUADRATIC_TETRA);
+  quadraticTetrahedra->SetBlocksDimensions(3, 2, 2);
+  quadraticTetrahedra->Update();
+  status += CheckEdges(quadraticTetrahedra->GetOutput(), 48 + 223, 2 * 223, "Quadratic tetrahedra");
+
+  return (status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
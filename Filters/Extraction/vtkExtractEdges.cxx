@@ -15,20 +15,374 @@
 #include "vtkExtractEdges.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkEdgeTable.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMergePoints.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
+#include "vtkStaticPointLocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
 
 vtkStandardNewMacro(vtkExtractEdges);
 
+namespace
+{
+
+//----------------------------------------------------------------------------
+// An edge use is a cell edge, or a segment of a tessellated higher-order
+// edge. Its data is the id of its cell, stored as -cellId-1 when the edge
+// runs from the larger to the smaller point id. The EId is the position of
+// the use in the cell traversal order, which makes the output independent
+// of the sort and of the number of threads.
+template <typename TId>
+using EdgeUse = MergeTuple<TId, TId>;
+
+template <typename TId>
+using EdgeUseVector = std::vector<EdgeUse<TId> >;
+
+// Cells are processed in fixed size chunks, each one gathering its edge uses
+// in traversal order.
+const vtkIdType EdgeChunkSize = 10000;
+
+template <typename TId>
+void AddEdgeUse(EdgeUseVector<TId>& uses, vtkIdType p0, vtkIdType p1, vtkIdType cellId)
+{
+  const vtkIdType data = (p0 <= p1 ? cellId : -cellId - 1);
+  uses.emplace_back(static_cast<TId>(p0), static_cast<TId>(p1), 0, static_cast<TId>(data));
+}
+
+//----------------------------------------------------------------------------
+// Gather the edge uses of polygonal data directly from its cell arrays. The
+// edges follow the order of vtkTriangle, vtkQuad, vtkPixel, vtkPolygon and
+// vtkTriangleStrip. Vertices and lines have no edges.
+template <typename TId>
+struct GeneratePolyDataEdges
+{
+  vtkPolyData* Input;
+  vtkIdType FirstPolyId;
+  vtkIdType FirstStripId;
+  vtkIdType NumberOfCells;
+  std::vector<EdgeUseVector<TId> >& Chunks;
+
+  GeneratePolyDataEdges(vtkPolyData* input, std::vector<EdgeUseVector<TId> >& chunks)
+    : Input(input)
+    , Chunks(chunks)
+  {
+    this->FirstPolyId = input->GetNumberOfVerts() + input->GetNumberOfLines();
+    this->FirstStripId = this->FirstPolyId + input->GetNumberOfPolys();
+    this->NumberOfCells = input->GetNumberOfCells();
+  }
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    static const int pixelEdges[4][2] = { { 0, 1 }, { 1, 3 }, { 2, 3 }, { 0, 2 } };
+    auto polys = vtk::TakeSmartPointer(this->Input->GetPolys()->NewIterator());
+    auto strips = vtk::TakeSmartPointer(this->Input->GetStrips()->NewIterator());
+    vtkIdType npts;
+    const vtkIdType* pts;
+
+    for (; chunk < endChunk; ++chunk)
+    {
+      EdgeUseVector<TId>& uses = this->Chunks[chunk];
+      vtkIdType cellId = this->FirstPolyId + chunk * EdgeChunkSize;
+      const vtkIdType endCellId = std::min(cellId + EdgeChunkSize, this->NumberOfCells);
+      for (; cellId < endCellId; ++cellId)
+      {
+        const int cellType = this->Input->GetCellType(cellId);
+        if (cellType == VTK_EMPTY_CELL)
+        {
+          continue;
+        }
+        if (cellId < this->FirstStripId)
+        {
+          polys->GetCellAtId(cellId - this->FirstPolyId, npts, pts);
+          if (cellType == VTK_PIXEL)
+          {
+            for (int i = 0; i < 4; ++i)
+            {
+              AddEdgeUse(uses, pts[pixelEdges[i][0]], pts[pixelEdges[i][1]], cellId);
+            }
+          }
+          else
+          {
+            for (vtkIdType i = 0; i < npts; ++i)
+            {
+              AddEdgeUse(uses, pts[i], pts[(i + 1) % npts], cellId);
+            }
+          }
+        }
+        else
+        {
+          strips->GetCellAtId(cellId - this->FirstStripId, npts, pts);
+          if (npts < 2)
+          {
+            continue;
+          }
+          AddEdgeUse(uses, pts[0], pts[1], cellId);
+          for (vtkIdType i = 1; i < npts - 1; ++i)
+          {
+            AddEdgeUse(uses, pts[i - 1], pts[i + 1], cellId);
+          }
+          AddEdgeUse(uses, pts[npts - 2], pts[npts - 1], cellId);
+        }
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Gather the edge uses of any dataset through its cells. Higher-order edges
+// are tessellated into line segments.
+template <typename TId>
+struct GenerateDataSetEdges
+{
+  vtkDataSet* Input;
+  std::vector<EdgeUseVector<TId> >& Chunks;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> EdgeIds;
+  vtkSMPThreadLocalObject<vtkPoints> EdgePoints;
+
+  GenerateDataSetEdges(vtkDataSet* input, std::vector<EdgeUseVector<TId> >& chunks)
+    : Input(input)
+    , Chunks(chunks)
+  {
+  }
+
+  void operator()(vtkIdType chunk, vtkIdType endChunk)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* edgeIds = this->EdgeIds.Local();
+    vtkPoints* edgePts = this->EdgePoints.Local();
+    const vtkIdType numCells = this->Input->GetNumberOfCells();
+
+    for (; chunk < endChunk; ++chunk)
+    {
+      EdgeUseVector<TId>& uses = this->Chunks[chunk];
+      vtkIdType cellId = chunk * EdgeChunkSize;
+      const vtkIdType endCellId = std::min(cellId + EdgeChunkSize, numCells);
+      for (; cellId < endCellId; ++cellId)
+      {
+        this->Input->GetCell(cellId, cell);
+        const int numCellEdges = cell->GetNumberOfEdges();
+        for (int edgeNum = 0; edgeNum < numCellEdges; ++edgeNum)
+        {
+          vtkCell* edge = cell->GetEdge(edgeNum);
+          if (!edge->IsLinear())
+          {
+            edge->Triangulate(0, edgeIds, edgePts);
+            for (vtkIdType i = 0; i < edgeIds->GetNumberOfIds() / 2; ++i)
+            {
+              AddEdgeUse(uses, edgeIds->GetId(2 * i), edgeIds->GetId(2 * i + 1), cellId);
+            }
+          }
+          else
+          {
+            const vtkIdType numEdgePts = edge->GetNumberOfPoints();
+            for (vtkIdType i = 1; i < numEdgePts; ++i)
+            {
+              AddEdgeUse(uses, edge->PointIds->GetId(i - 1), edge->PointIds->GetId(i), cellId);
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+// Extract the unique edges of a dataset. Each edge is output the first time
+// it is used in cell order, with the point order and the cell data of that
+// use. The mergeMap, if any, gives the first of the points sharing the
+// coordinates of each point. Output points are numbered in the order they
+// are first used by the output edges, so the output matches the serial
+// traversal. Returns false, leaving the output untouched, when the edge uses
+// cannot be indexed with TId.
+template <typename TId>
+bool ExtractUniqueEdges(
+  vtkExtractEdges* self, vtkDataSet* input, const vtkIdType* mergeMap, vtkPolyData* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  vtkPolyData* polyInput = vtkPolyData::SafeDownCast(input);
+
+  // Gather the edge uses. Building the cells (or whatever else a dataset
+  // does on its first GetCell()) must not happen in the threads.
+  std::vector<EdgeUseVector<TId> > chunks;
+  if (polyInput)
+  {
+    polyInput->GetCellType(0);
+    const vtkIdType numPolyCells = polyInput->GetNumberOfPolys() + polyInput->GetNumberOfStrips();
+    chunks.resize((numPolyCells + EdgeChunkSize - 1) / EdgeChunkSize);
+    GeneratePolyDataEdges<TId> generate(polyInput, chunks);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), generate);
+  }
+  else
+  {
+    vtkNew<vtkGenericCell> cell;
+    input->GetCell(0, cell);
+    chunks.resize((input->GetNumberOfCells() + EdgeChunkSize - 1) / EdgeChunkSize);
+    GenerateDataSetEdges<TId> generate(input, chunks);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), generate);
+  }
+
+  std::vector<vtkIdType> chunkOffsets(chunks.size() + 1, 0);
+  for (size_t i = 0; i < chunks.size(); ++i)
+  {
+    chunkOffsets[i + 1] = chunkOffsets[i] + static_cast<vtkIdType>(chunks[i].size());
+  }
+  const vtkIdType numUses = chunkOffsets.back();
+  if (numUses >= static_cast<vtkIdType>(std::numeric_limits<TId>::max()))
+  {
+    return false;
+  }
+  self->UpdateProgress(0.4);
+
+  // Number the uses in traversal order and merge them.
+  EdgeUseVector<TId> uses(numUses);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(chunks.size()), [&](vtkIdType chunk, vtkIdType end) {
+    for (; chunk < end; ++chunk)
+    {
+      vtkIdType eId = chunkOffsets[chunk];
+      for (const EdgeUse<TId>& use : chunks[chunk])
+      {
+        uses[eId] = use;
+        uses[eId].EId = static_cast<TId>(eId);
+        ++eId;
+      }
+      EdgeUseVector<TId>().swap(chunks[chunk]);
+    }
+  });
+
+  vtkIdType numEdges = 0;
+  const TId* groups = nullptr;
+  vtkStaticEdgeLocatorTemplate<TId, TId> locator;
+  if (numUses > 0)
+  {
+    groups = locator.MergeEdges(numUses, uses.data(), numEdges);
+  }
+
+  // Keep the first use of each edge, indexed by its traversal position.
+  std::vector<TId> firstUses(numUses, -1);
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      TId first = groups[edgeId];
+      for (TId i = groups[edgeId] + 1; i < groups[edgeId + 1]; ++i)
+      {
+        if (uses[i].EId < uses[first].EId)
+        {
+          first = i;
+        }
+      }
+      firstUses[uses[first].EId] = first;
+    }
+  });
+  self->UpdateProgress(0.7);
+
+  // Order the edges and number their points as they are first used.
+  std::vector<TId> edges;
+  edges.reserve(numEdges);
+  std::vector<vtkIdType> pointMap(numPts, -1);
+  vtkNew<vtkIdList> srcPtIds;
+  srcPtIds->Allocate(numPts);
+  for (const TId first : firstUses)
+  {
+    if (first >= 0)
+    {
+      edges.push_back(first);
+      const EdgeUse<TId>& use = uses[first];
+      const vtkIdType p0 = (use.T >= 0 ? use.V0 : use.V1);
+      const vtkIdType p1 = (use.T >= 0 ? use.V1 : use.V0);
+      vtkIdType& newPt0 = pointMap[mergeMap ? mergeMap[p0] : p0];
+      if (newPt0 < 0)
+      {
+        newPt0 = srcPtIds->InsertNextId(p0);
+      }
+      vtkIdType& newPt1 = pointMap[mergeMap ? mergeMap[p1] : p1];
+      if (newPt1 < 0)
+      {
+        newPt1 = srcPtIds->InsertNextId(p1);
+      }
+    }
+  }
+  const vtkIdType numNewPts = srcPtIds->GetNumberOfIds();
+
+  // Produce the output points, lines and attributes.
+  vtkNew<vtkPoints> newPts;
+  newPts->SetNumberOfPoints(numNewPts);
+  vtkSMPTools::For(0, numNewPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      input->GetPoint(srcPtIds->GetId(ptId), x);
+      newPts->SetPoint(ptId, x);
+    }
+  });
+
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numEdges + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(2 * numEdges);
+  vtkNew<vtkIdList> srcCellIds;
+  srcCellIds->SetNumberOfIds(numEdges);
+  vtkIdType* offs = offsets->GetPointer(0);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  offs[numEdges] = 2 * numEdges;
+  vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+    for (; edgeId < endEdgeId; ++edgeId)
+    {
+      const EdgeUse<TId>& use = uses[edges[edgeId]];
+      const vtkIdType p0 = (use.T >= 0 ? use.V0 : use.V1);
+      const vtkIdType p1 = (use.T >= 0 ? use.V1 : use.V0);
+      offs[edgeId] = 2 * edgeId;
+      conn[2 * edgeId] = pointMap[mergeMap ? mergeMap[p0] : p0];
+      conn[2 * edgeId + 1] = pointMap[mergeMap ? mergeMap[p1] : p1];
+      srcCellIds->SetId(edgeId, use.T >= 0 ? use.T : -use.T - 1);
+    }
+  });
+  vtkNew<vtkCellArray> newLines;
+  newLines->SetData(offsets, connectivity);
+
+  vtkNew<vtkIdList> dstPtIds;
+  dstPtIds->SetNumberOfIds(numNewPts);
+  std::iota(dstPtIds->GetPointer(0), dstPtIds->GetPointer(0) + numNewPts, 0);
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(input->GetPointData(), numNewPts);
+  outPD->CopyData(input->GetPointData(), srcPtIds, dstPtIds);
+
+  vtkNew<vtkIdList> dstCellIds;
+  dstCellIds->SetNumberOfIds(numEdges);
+  std::iota(dstCellIds->GetPointer(0), dstCellIds->GetPointer(0) + numEdges, 0);
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(input->GetCellData(), numEdges);
+  outCD->CopyData(input->GetCellData(), srcCellIds, dstCellIds);
+
+  output->SetPoints(newPts);
+  output->SetLines(newLines);
+  return true;
+}
+
+} // anonymous namespace
+
 //----------------------------------------------------------------------------
 // Construct object.
 vtkExtractEdges::vtkExtractEdges()
@@ -83,6 +437,30 @@ int vtkExtractEdges::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
+  // Without a locator, the unique edges are found by sorting the edge uses
+  // in parallel, and coincident points are merged with a static locator.
+  if (this->Locator == nullptr)
+  {
+    std::vector<vtkIdType> mergeMap;
+    if (vtkPointSet::SafeDownCast(input))
+    {
+      vtkNew<vtkStaticPointLocator> pointLocator;
+      pointLocator->SetDataSet(input);
+      pointLocator->BuildLocator();
+      mergeMap.resize(numPts);
+      pointLocator->MergePoints(0.0, mergeMap.data());
+    }
+    const vtkIdType* map = (mergeMap.empty() ? nullptr : mergeMap.data());
+    if (numPts >= VTK_INT_MAX || numCells >= VTK_INT_MAX ||
+      !ExtractUniqueEdges<int>(this, input, map, output))
+    {
+      ExtractUniqueEdges<vtkIdType>(this, input, map, output);
+    }
+    vtkDebugMacro(<< "Created " << output->GetNumberOfLines() << " edges");
+    output->Squeeze();
+    return 1;
+  }
+
   // Set up processing
   //
   edgeTable = vtkEdgeTable::New();
@@ -104,12 +482,8 @@ int vtkExtractEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkIdList *edgeIds, *HEedgeIds = vtkIdList::New();
   vtkPoints *edgePts, *HEedgePts = vtkPoints::New();
 
-  // Get our locator for merging points
+  // Merge points with the locator
   //
-  if (this->Locator == nullptr)
-  {
-    this->CreateDefaultLocator();
-  }
   this->Locator->InitPointInsertion(newPts, input->GetBounds());
 
   // Loop over all cells, extracting non-visited edges.
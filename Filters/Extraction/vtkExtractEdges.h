@@ -19,6 +19,24 @@
  * vtkExtractEdges is a filter to extract edges from a dataset. Edges
  * are extracted as lines or polylines.
  *
+ * Each edge is output once, in the order the cells first use it, with the
+ * cell data of that cell. Coincident points are merged.
+ *
+ * @warning
+ * By default, the edges are found by sorting the edge uses with
+ * vtkStaticEdgeLocatorTemplate, and the output does not depend on the number
+ * of threads. When a locator is specified, the edges are extracted serially
+ * and the points are merged with the locator. This class has been threaded
+ * with vtkSMPTools. Using TBB or other non-sequential type (set in the CMake
+ * variable VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
+ * @warning
+ * The edges are not streamed. An edge is output once only because all of
+ * its uses are sorted together, and outputting the edges of some of the
+ * cells at a time would output the edges shared by cells of different
+ * chunks several times. The same holds for the pieces of a streamed input,
+ * whose shared edges are output by each piece.
+ *
  * @sa
  * vtkFeatureEdges
  */
@@ -40,15 +58,17 @@ public:
 
   //@{
   /**
-   * Set / get a spatial locator for merging points. By
-   * default an instance of vtkMergePoints is used.
+   * Set / get a spatial locator for merging points. By default no locator
+   * is used, and exactly coincident points are merged in parallel.
+   * Specifying a locator uses the serial algorithm.
    */
   void SetLocator(vtkIncrementalPointLocator* locator);
   vtkGetObjectMacro(Locator, vtkIncrementalPointLocator);
   //@}
 
   /**
-   * Create default locator. Used to create one when none is specified.
+   * Create default locator, an instance of vtkMergePoints. This selects
+   * the serial algorithm.
    */
   void CreateDefaultLocator();
 
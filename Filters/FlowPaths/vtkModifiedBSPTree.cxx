@@ -18,6 +18,7 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
@@ -43,6 +44,10 @@ enum
 };
 //
 const double Epsilon_ = 1E-8;
+//
+// Nodes with at least this many cells partition their 6 sorted lists in
+// parallel while the top of the tree is built.
+const vtkIdType ParallelPartitionCells_ = 5000;
 
 //////////////////////////////////////////////////////////////////////////////
 // Main management and support for tree
@@ -84,8 +89,6 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
-
 class Sorted_cell_extents_Lists
 {
 public:
@@ -99,7 +102,6 @@ public:
       Mins[i] = new cell_extents[nCells]; // max num <= nCells/2 ?
       Maxs[i] = new cell_extents[nCells];
     }
-    global_list_count += 1;
   };
   ~Sorted_cell_extents_Lists()
   {
@@ -108,36 +110,66 @@ public:
       delete[](Mins[i]);
       delete[](Maxs[i]);
     }
-    global_list_count -= 1;
   }
 };
 
-extern "C" int __compareMin(const void* pA, const void* B)
+// Mins lists are sorted by increasing min, Maxs lists by decreasing max
+static bool __compareMin(const cell_extents& tA, const cell_extents& tB)
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->min == tB->min)
-  {
-    return 0;
-  }
-  else
+  return tA.min < tB.min;
+}
+
+static bool __compareMax(const cell_extents& tA, const cell_extents& tB)
+{
+  return tA.max > tB.max;
+}
+
+// Distribute one of the sorted lists of a node to the left, middle and
+// right child lists according to the bounds of the cells along the split
+// axis. The child lists stay sorted. counts receives their sizes.
+static void PartitionExtents(const cell_extents* list, vtkIdType nCells,
+  const double (*cellBounds)[6], int splitAxis, double pDiv, cell_extents* left,
+  cell_extents* mid, cell_extents* right, vtkIdType counts[3])
+{
+  counts[0] = counts[1] = counts[2] = 0;
+  for (vtkIdType i = 0; i < nCells; i++)
   {
-    return tA->min < tB->min ? -1 : 1;
+    const cell_extents& ext = list[i];
+    // max is on left of middle node
+    if (cellBounds[ext.cell_ID][2 * splitAxis + 1] < pDiv)
+    {
+      left[counts[0]++] = ext;
+    }
+    // min is on right of middle node
+    else if (cellBounds[ext.cell_ID][2 * splitAxis] > pDiv)
+    {
+      right[counts[2]++] = ext;
+    }
+    // neither - must be one of ours
+    else
+    {
+      mid[counts[1]++] = ext;
+    }
   }
 }
 
-extern "C" int __compareMax(const void* pA, const void* B)
+// Depth down to which the tree is built serially (with the partitions of
+// the large nodes done in parallel) before the subtrees below it are built
+// concurrently. 0 when there is a single thread.
+static int ParallelDepth()
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->max == tB->max)
+  const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+  if (numThreads < 2)
   {
     return 0;
   }
-  else
+  // Each level has up to 3 times more nodes; aim at a few subtrees per thread
+  int depth = 1;
+  for (int numNodes = 3; numNodes < 4 * numThreads && depth < 12; numNodes *= 3)
   {
-    return tA->max > tB->max ? -1 : 1;
+    depth++;
   }
+  return depth;
 }
 
 //---------------------------------------------------------------------------
@@ -152,6 +184,12 @@ void vtkModifiedBSPTree::BuildLocator()
   this->ForceBuildLocator();
 }
 //---------------------------------------------------------------------------
+void vtkModifiedBSPTree::PrepareForConcurrentQueries()
+{
+  this->ForceBuildLocator();
+  this->Superclass::PrepareForConcurrentQueries();
+}
+//---------------------------------------------------------------------------
 void vtkModifiedBSPTree::BuildLocatorIfNeeded()
 {
   if (this->LazyEvaluation)
@@ -211,38 +249,133 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   }
   //
   this->StoreCellBounds();
+  const double(*cellBounds)[6] = this->CellBounds;
   //
-  // sort the cells into 6 lists using structure for subdividing tests
+  // sort the cells into 6 lists using structure for subdividing tests,
+  // the 6 lists are filled and sorted concurrently
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i = 0; i < 3; i++)
-  { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+  auto sortLists = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType l = begin; l < end; l++)
+    {
+      const int i = static_cast<int>(l / 2); // i=0 x, i=1 y, i=2 z
+      cell_extents_List list = (l % 2 == 0) ? lists->Mins[i] : lists->Maxs[i];
+      for (vtkIdType j = 0; j < numCells; j++)
+      { // loop over each cell
+        list[j].min = cellBounds[j][i * 2];
+        list[j].max = cellBounds[j][i * 2 + 1];
+        list[j].cell_ID = j;
+      }
+      std::sort(list, list + numCells, (l % 2 == 0) ? __compareMin : __compareMax);
     }
-    // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), __compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), __compareMax);
-  }
+  };
+  vtkSMPTools::For(0, 6, 1, sortLists);
   //
   // call the recursive subdivision routine
   //
   vtkDebugMacro(<< "Beginning Subdivision");
   //
-  if (numCells > 0)
-  {
-    Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, this->MaxLevel,
-      this->NumberOfCellsPerNode, this->Level);
-  }
+  // The top of the tree is built first, down to a depth that gives enough
+  // subtrees to keep all the threads busy. The subtrees are then built
+  // concurrently, each one serially. This gives the same tree as a serial
+  // build.
+  const int parallelDepth = ParallelDepth();
+  const int topLevel = (parallelDepth > 0 && parallelDepth < this->MaxLevel)
+    ? parallelDepth
+    : this->MaxLevel;
+  this->Level = 0;
+  Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, topLevel,
+    this->NumberOfCellsPerNode, this->Level);
   delete lists;
   // Child nodes are responsible for freeing the temporary sorted lists
   //
+  // Collect the leaves of the top of the tree which must be subdivided further
+  std::vector<BSPNode*> subtrees;
+  std::stack<BSPNode*> nodes;
+  nodes.push(this->mRoot);
+  while (topLevel < this->MaxLevel && !nodes.empty())
+  {
+    BSPNode* node = nodes.top();
+    nodes.pop();
+    if (node->mChild[0])
+    {
+      for (int i = 0; i < 3; i++)
+      {
+        if (node->mChild[i])
+        {
+          nodes.push(node->mChild[i]);
+        }
+      }
+    }
+    else if (node->depth == topLevel && node->num_cells > this->NumberOfCellsPerNode)
+    {
+      subtrees.push_back(node);
+    }
+  }
+  std::vector<int> subtreeLevels(subtrees.size(), 0);
+  const int maxLevel = this->MaxLevel;
+  const vtkIdType maxCells = this->NumberOfCellsPerNode;
+  vtkDataSet* dataSet = this->DataSet;
+  auto buildSubtrees = [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType s = begin; s < end; s++)
+    {
+      // Restore the sorted lists of extents from the cell lists of the leaf
+      BSPNode* node = subtrees[s];
+      const vtkIdType nCells = node->num_cells;
+      Sorted_cell_extents_Lists* leafLists = new Sorted_cell_extents_Lists(nCells);
+      for (int i = 0; i < 3; i++)
+      {
+        for (vtkIdType j = 0; j < nCells; j++)
+        {
+          const vtkIdType minId = node->sorted_cell_lists[i * 2][j];
+          const vtkIdType maxId = node->sorted_cell_lists[i * 2 + 1][j];
+          leafLists->Mins[i][j].min = cellBounds[minId][i * 2];
+          leafLists->Mins[i][j].max = cellBounds[minId][i * 2 + 1];
+          leafLists->Mins[i][j].cell_ID = minId;
+          leafLists->Maxs[i][j].min = cellBounds[maxId][i * 2];
+          leafLists->Maxs[i][j].max = cellBounds[maxId][i * 2 + 1];
+          leafLists->Maxs[i][j].cell_ID = maxId;
+        }
+      }
+      for (int i = 0; i < 6; i++)
+      {
+        delete[] node->sorted_cell_lists[i];
+        node->sorted_cell_lists[i] = nullptr;
+      }
+      this->Subdivide(node, leafLists, dataSet, nCells, node->depth, maxLevel, maxCells,
+        subtreeLevels[s]);
+      delete leafLists;
+    }
+  };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, buildSubtrees);
+  for (size_t i = 0; i < subtreeLevels.size(); i++)
+  {
+    this->Level = std::max(this->Level, subtreeLevels[i]);
+  }
+  //
+  // Gather statistics
+  nodes.push(this->mRoot);
+  while (!nodes.empty())
+  {
+    BSPNode* node = nodes.top();
+    nodes.pop();
+    if (node->mChild[0])
+    {
+      npn += 1; // Parent node
+      for (int i = 0; i < 3; i++)
+      {
+        if (node->mChild[i])
+        {
+          nodes.push(node->mChild[i]);
+        }
+      }
+    }
+    else
+    {
+      nln += 1; // Leaf node
+      tot_depth += node->depth;
+    }
+  }
+  //
   this->BuildTime.Modified();
   //
   double av_depth = (double)tot_depth / nln;
@@ -319,123 +452,60 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       {
         node->mChild[i] = new BSPNode();
         node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
+        // deterministic, so that the tree does not depend on the build order
+        node->mChild[i]->mAxis = (node->mAxis + 1 + i) % 3;
       }
-      Daxis = node->mAxis;
       Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
       Sorted_cell_extents_Lists* mid = new Sorted_cell_extents_Lists(nCells);
       Sorted_cell_extents_Lists* right = new Sorted_cell_extents_Lists(nCells);
-      // we ought to keep track of how many we are adding to each list
-      vtkIdType Cmin_l[3] = { 0, 0, 0 }, Cmin_m[3] = { 0, 0, 0 }, Cmin_r[3] = { 0, 0, 0 };
-      vtkIdType Cmax_l[3] = { 0, 0, 0 }, Cmax_m[3] = { 0, 0, 0 }, Cmax_r[3] = { 0, 0, 0 };
-      // Partition the cells into the correct child lists
-      // here we use the lists for the axis we're dividing along
-      for (vtkIdType i = 0; i < nCells; i++)
-      {
-        // process the MIN-List
-        cell_extents ext = lists->Mins[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
-        {
-          left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-        }
-        //
-        // process the MAX-List
-        ext = lists->Maxs[Daxis][i];
-        // max is on left of middle node
-        if (ext.max < pDiv)
+      // Partition the cells into the correct child lists, keeping each
+      // list sorted. The 6 lists (min and max along x, y, z) are independent,
+      // the large nodes at the top of the tree process them concurrently.
+      // counts[l] receives the sizes of the left, mid and right lists made
+      // from list l, in the order Mins x, Maxs x, Mins y, ... Maxs z.
+      const int splitAxis = node->mAxis;
+      const double(*cellBounds)[6] = this->CellBounds;
+      vtkIdType counts[6][3];
+      auto partition = [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType l = begin; l < end; l++)
         {
-          left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-        }
-        // min is on right of middle node
-        else if (ext.min > pDiv)
-        {
-          right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
-        }
-        // neither - must be one of ours
-        else
-        {
-          mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
-        }
-      }
-      // construct the sorted list of extents for the 2 remaining axes
-      // do everything in order so our sorted lists aren't munged
-      for (Daxis = (node->mAxis + 1) % 3; Daxis != node->mAxis; Daxis = (Daxis + 1) % 3)
-      {
-        for (vtkIdType i = 0; i < nCells; i++)
-        {
-          // process the MIN-List
-          cell_extents ext = lists->Mins[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
-          {
-            left->Mins[Daxis][Cmin_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Mins[Daxis][Cmin_r[Daxis]++] = ext;
-          }
-          else
-          {
-            mid->Mins[Daxis][Cmin_m[Daxis]++] = ext;
-          }
-          //
-          // process the MAX-List
-          ext = lists->Maxs[Daxis][i];
-          if (this->CellBounds[ext.cell_ID][2 * node->mAxis + 1] < pDiv)
+          const int axis = static_cast<int>(l / 2);
+          if (l % 2 == 0)
           {
-            left->Maxs[Daxis][Cmax_l[Daxis]++] = ext;
-          }
-          else if (this->CellBounds[ext.cell_ID][2 * node->mAxis] > pDiv)
-          {
-            right->Maxs[Daxis][Cmax_r[Daxis]++] = ext;
+            PartitionExtents(lists->Mins[axis], nCells, cellBounds, splitAxis, pDiv,
+              left->Mins[axis], mid->Mins[axis], right->Mins[axis], counts[l]);
           }
           else
           {
-            mid->Maxs[Daxis][Cmax_m[Daxis]++] = ext;
+            PartitionExtents(lists->Maxs[axis], nCells, cellBounds, splitAxis, pDiv,
+              left->Maxs[axis], mid->Maxs[axis], right->Maxs[axis], counts[l]);
           }
         }
-      }
-      //
-      // Better check we didn't make a diddly
-      // this is overkill but for now I want a FULL DEBUG!
-      if ((Cmin_l[0] + Cmin_r[0] + Cmin_m[0]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmin_l[1] + Cmin_r[1] + Cmin_m[1]) != nCells)
+      };
+      if (nCells >= ParallelPartitionCells_ && depth < ParallelDepth())
       {
-        vtkWarningMacro("Error count in min lists");
+        vtkSMPTools::For(0, 6, 1, partition);
       }
-      if ((Cmin_l[2] + Cmin_r[2] + Cmin_m[2]) != nCells)
-      {
-        vtkWarningMacro("Error count in min lists");
-      }
-      if ((Cmax_l[0] + Cmax_r[0] + Cmax_m[0]) != nCells)
-      {
-        vtkWarningMacro("Error count in max lists");
-      }
-      if ((Cmax_l[1] + Cmax_r[1] + Cmax_m[1]) != nCells)
+      else
       {
-        vtkWarningMacro("Error count in max lists");
+        partition(0, 6);
       }
-      if ((Cmax_l[2] + Cmax_r[2] + Cmax_m[2]) != nCells)
+      //
+      // Better check we didn't make a diddly
+      // this is overkill but for now I want a FULL DEBUG!
+      for (int l = 0; l < 6; l++)
       {
-        vtkWarningMacro("Error count in max lists");
+        if ((counts[l][0] + counts[l][1] + counts[l][2]) != nCells)
+        {
+          vtkWarningMacro(
+            << (l % 2 == 0 ? "Error count in min lists" : "Error count in max lists"));
+        }
       }
+      const vtkIdType numLeft = counts[0][0], numMid = counts[0][1], numRight = counts[0][2];
       //
       // Bug : Can sometimes get unbalanced leaves
       //
-      if (!Cmin_l[0] || !Cmin_r[0])
+      if (!numLeft || !numRight)
       {
         // vtkDebugMacro(<<"Child 0 or 2 empty : Aborting subdivision for node " << Cmin_l[0] << " "
         // << Cmin_m[0] << " " << Cmin_r[0]); clean up all the memory we allocated. Yikes.
@@ -456,10 +526,10 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         //
         // And of course, we really ought to subdivide again - Hoorah!
         // NB: it is possible for a node to be empty now, so check and delete if necessary
-        if (Cmin_l[0])
+        if (numLeft)
         {
           Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
+            node->mChild[0], left, dataset, numLeft, depth + 1, maxlevel, maxCells, MaxDepth);
         }
         else
         {
@@ -467,10 +537,10 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         }
         delete left;
 
-        if (Cmin_m[0])
+        if (numMid)
         {
           Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
+            node->mChild[1], mid, dataset, numMid, depth + 1, maxlevel, maxCells, MaxDepth);
         }
         else
         {
@@ -479,10 +549,10 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         }
         delete mid;
 
-        if (Cmin_r[0])
+        if (numRight)
         {
           Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
+            node->mChild[2], right, dataset, numRight, depth + 1, maxlevel, maxCells, MaxDepth);
         }
         else
         {
@@ -490,8 +560,6 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         }
         delete right;
         //
-        npn += 1; // Parent node
-        //
         // we've done all we were asked to do
         //
         return;
@@ -503,8 +571,6 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   //
   // Copy the cell IDs into the actual node structure for proper use
   node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
   for (int i = 0; i < 6; i++)
   {
     node->sorted_cell_lists[i] = new vtkIdType[nCells];
@@ -652,18 +718,13 @@ int BSPNode::getDominantAxis(const double dir[3])
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 //---------------------------------------------------------------------------
 int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
 {
   //
   BSPNode *node, *Near, *Mid, *Far;
@@ -782,7 +843,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
       ctmax = _tmax;
       if (BSPNode::RayMinMaxT(CellBounds[cell_ID], p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -801,6 +862,7 @@ int vtkModifiedBSPTree::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellId, cell);
   }
   //
   return HIT;
@@ -999,8 +1061,16 @@ int vtkModifiedBSPTree::IntersectWithLine(
 int vtkModifiedBSPTree::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
   const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  return this->IntersectCellInternal(
+    cell_ID, p1, p2, tol, t, ipt, pcoords, subId, this->GenericCell);
+}
+//----------------------------------------------------------------------------
+int vtkModifiedBSPTree::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
+{
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //////////////////////////////////////////////////////////////////////////////
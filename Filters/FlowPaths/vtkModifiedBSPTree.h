@@ -95,6 +95,11 @@
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
  *
+ * The build uses vtkSMPTools: the 6 lists are sorted concurrently, the large
+ * nodes near the root partition their lists concurrently, and the subtrees
+ * below them are then built in parallel. The resulting tree does not depend
+ * on the number of threads.
+ *
  * NB. The following reference has been sent to me
  *   @Article{formella-1995-ray,
  *     author =     "Arno Formella and Christian Gill",
@@ -227,6 +232,12 @@ public:
 
   bool InsideCellBounds(double x[3], vtkIdType cell_ID) override;
 
+  /**
+   * FindCell() and IntersectWithLine() taking a vtkGenericCell are thread
+   * safe once the locator is built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /**
    * After subdivision has completed, one may wish to query the tree to find
    * which cells are in which leaf nodes. This function returns a list
@@ -255,6 +266,14 @@ protected:
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
     const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
 
+  // Same as above but uses the provided cell so that it can be called
+  // concurrently. The version above forwards to this one with GenericCell.
+  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
+
+  void PrepareForConcurrentQueries() override;
+
   void BuildLocatorIfNeeded();
   void ForceBuildLocator();
   void BuildLocatorInternal();
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBooleanOperationPolyDataFilterWindingNumber.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the winding number classification of
+// vtkBooleanOperationPolyDataFilter selects as many cells as the signed
+// distance classification for two overlapping spheres, on the expected side
+// of the other sphere, for each operation.
+
+#include "vtkBooleanOperationPolyDataFilter.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+namespace
+{
+const double Radius = 0.5;
+const double Center0[3] = { 0.0, 0.0, 0.0 };
+const double Center1[3] = { 0.3, 0.0, 0.0 };
+
+// Check that each cell of the output lies on the expected side of the other
+// sphere: outside it for the union, inside it for the intersection, and for
+// the difference outside the second sphere for the cells of the first one
+// and inside the first sphere for the cells of the second one. The cells
+// close to the other sphere are ignored.
+int CheckOutput(vtkPolyData* output, int operation, const char* label)
+{
+  vtkDataArray* source = output->GetCellData()->GetArray("CellSource");
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    double bounds[6];
+    output->GetCellBounds(cellId, bounds);
+    double x[3] = { 0.5 * (bounds[0] + bounds[1]), 0.5 * (bounds[2] + bounds[3]),
+      0.5 * (bounds[4] + bounds[5]) };
+    const bool fromFirst = source->GetTuple1(cellId) == 0.0;
+    const double r = std::sqrt(vtkMath::Distance2BetweenPoints(x, fromFirst ? Center1 : Center0));
+    const bool expectInside = operation == vtkBooleanOperationPolyDataFilter::VTK_INTERSECTION ||
+      (operation == vtkBooleanOperationPolyDataFilter::VTK_DIFFERENCE && !fromFirst);
+    if (std::abs(r - Radius) > 0.02 && (r < Radius) != expectInside)
+    {
+      cerr << label << ": cell " << cellId << " of input " << (fromFirst ? 0 : 1)
+           << " is on the wrong side of the other sphere" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestBooleanOperationPolyDataFilterWindingNumber(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere0;
+  sphere0->SetRadius(Radius);
+  sphere0->SetThetaResolution(32);
+  sphere0->SetPhiResolution(32);
+
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetRadius(Radius);
+  sphere1->SetCenter(Center1[0], Center1[1], Center1[2]);
+  sphere1->SetThetaResolution(32);
+  sphere1->SetPhiResolution(32);
+
+  const char* names[3] = { "Union", "Intersection", "Difference" };
+  for (int operation = vtkBooleanOperationPolyDataFilter::VTK_UNION;
+       operation <= vtkBooleanOperationPolyDataFilter::VTK_DIFFERENCE; ++operation)
+  {
+    vtkNew<vtkBooleanOperationPolyDataFilter> distance;
+    distance->SetInputConnection(0, sphere0->GetOutputPort());
+    distance->SetInputConnection(1, sphere1->GetOutputPort());
+    distance->SetOperation(operation);
+    distance->Update();
+
+    vtkNew<vtkBooleanOperationPolyDataFilter> winding;
+    winding->SetInputConnection(0, sphere0->GetOutputPort());
+    winding->SetInputConnection(1, sphere1->GetOutputPort());
+    winding->SetOperation(operation);
+    winding->SetMethodToWindingNumber();
+    winding->Update();
+
+    vtkPolyData* output = winding->GetOutput();
+    if (output->GetNumberOfCells() == 0 ||
+      output->GetNumberOfCells() != distance->GetOutput()->GetNumberOfCells())
+    {
+      cerr << names[operation] << ": the winding number method selects "
+           << output->GetNumberOfCells() << " cells, the signed distance method "
+           << distance->GetOutput()->GetNumberOfCells() << endl;
+      return EXIT_FAILURE;
+    }
+    if (!output->GetCellData()->GetArray("WindingNumber"))
+    {
+      cerr << names[operation] << ": no WindingNumber cell data" << endl;
+      return EXIT_FAILURE;
+    }
+    if (CheckOutput(output, operation, names[operation]))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCellLocatorsBatchedQueries.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the batched FindCells() and IntersectWithLines() queries of
+// the cell locators match the one-at-a-time queries.
+
+#include "vtkCellLocator.h"
+#include "vtkCellTreeLocator.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdTypeArray.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkStaticCellLocator.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+
+namespace
+{
+const int Resolution = 16;
+
+// A Resolution^3 grid of unit hexahedra.
+void MakeGrid(vtkUnstructuredGrid* grid)
+{
+  const int np = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(np * np * np);
+  for (int k = 0; k < np; ++k)
+  {
+    for (int j = 0; j < np; ++j)
+    {
+      for (int i = 0; i < np; ++i)
+      {
+        points->SetPoint(i + np * (j + np * k), i, j, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  grid->Allocate(Resolution * Resolution * Resolution);
+  for (int k = 0; k < Resolution; ++k)
+  {
+    for (int j = 0; j < Resolution; ++j)
+    {
+      for (int i = 0; i < Resolution; ++i)
+      {
+        vtkIdType p0 = i + np * (j + np * k);
+        vtkIdType ids[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+          p0 + 1 + np + np * np, p0 + np + np * np };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+      }
+    }
+  }
+}
+
+int TestLocator(vtkAbstractCellLocator* locator, vtkUnstructuredGrid* grid)
+{
+  locator->SetDataSet(grid);
+  locator->BuildLocator();
+
+  // Points near the cell centers, with one point outside of the grid.
+  const vtkIdType numPts = Resolution * Resolution * Resolution;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(numPts + 1);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->SetPoint(i, 0.4 + i % Resolution, 0.6 + (i / Resolution) % Resolution,
+      0.5 + i / (Resolution * Resolution));
+  }
+  points->SetPoint(numPts, -5.0, 0.5, 0.5);
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  locator->FindCells(points, cellIds, pcoords);
+  if (cellIds->GetNumberOfTuples() != numPts + 1 || pcoords->GetNumberOfTuples() != numPts + 1)
+  {
+    cerr << locator->GetClassName() << ": wrong FindCells output size" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    if (cellIds->GetValue(i) != i || std::fabs(pcoords->GetComponent(i, 0) - 0.4) > 1e-6)
+    {
+      cerr << locator->GetClassName() << ": wrong cell " << cellIds->GetValue(i) << " for point "
+           << i << endl;
+      return 1;
+    }
+  }
+  if (cellIds->GetValue(numPts) != -1)
+  {
+    cerr << locator->GetClassName() << ": found a cell for a point outside" << endl;
+    return 1;
+  }
+
+  // Vertical lines through the cell centers of the bottom layer, and one
+  // line that misses the grid.
+  const vtkIdType numLines = Resolution * Resolution + 1;
+  vtkNew<vtkPoints> p1s;
+  vtkNew<vtkPoints> p2s;
+  p1s->SetNumberOfPoints(numLines);
+  p2s->SetNumberOfPoints(numLines);
+  for (vtkIdType i = 0; i < numLines - 1; ++i)
+  {
+    double x = 0.5 + i % Resolution;
+    double y = 0.5 + i / Resolution;
+    p1s->SetPoint(i, x, y, -1.0);
+    p2s->SetPoint(i, x, y, Resolution + 1.0);
+  }
+  p1s->SetPoint(numLines - 1, -5.0, -5.0, -1.0);
+  p2s->SetPoint(numLines - 1, -5.0, -5.0, Resolution + 1.0);
+
+  vtkNew<vtkIdTypeArray> hitIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> xs;
+  locator->IntersectWithLines(p1s, p2s, 0.001, hitIds, ts, xs);
+  if (hitIds->GetNumberOfTuples() != numLines || xs->GetNumberOfPoints() != numLines)
+  {
+    cerr << locator->GetClassName() << ": wrong IntersectWithLines output size" << endl;
+    return 1;
+  }
+
+  vtkNew<vtkGenericCell> cell;
+  for (vtkIdType i = 0; i < numLines; ++i)
+  {
+    double p1[3], p2[3], t = 0.0, x[3], pc[3];
+    int subId;
+    vtkIdType cellId = -1;
+    p1s->GetPoint(i, p1);
+    p2s->GetPoint(i, p2);
+    if (!locator->IntersectWithLine(p1, p2, 0.001, t, x, pc, subId, cellId, cell))
+    {
+      cellId = -1;
+    }
+    if (hitIds->GetValue(i) != cellId || (cellId >= 0 && std::fabs(ts->GetValue(i) - t) > 1e-9))
+    {
+      cerr << locator->GetClassName() << ": batched and single intersections differ for line "
+           << i << endl;
+      return 1;
+    }
+    if (i < numLines - 1 && (cellId < 0 || std::fabs(xs->GetPoint(i)[2]) > 1e-6))
+    {
+      cerr << locator->GetClassName() << ": line " << i << " did not hit the bottom layer" << endl;
+      return 1;
+    }
+  }
+  if (hitIds->GetValue(numLines - 1) != -1 || ts->GetValue(numLines - 1) != VTK_DOUBLE_MAX)
+  {
+    cerr << locator->GetClassName() << ": a line outside of the grid hit a cell" << endl;
+    return 1;
+  }
+
+  return 0;
+}
+}
+
+int TestCellLocatorsBatchedQueries(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  MakeGrid(grid);
+
+  vtkNew<vtkStaticCellLocator> staticLocator;
+  vtkNew<vtkCellLocator> cellLocator;
+  vtkNew<vtkCellTreeLocator> cellTreeLocator;
+  vtkNew<vtkModifiedBSPTree> bspTree;
+
+  int result = 0;
+  result |= TestLocator(staticLocator, grid);
+  result |= TestLocator(cellLocator, grid);
+  result |= TestLocator(cellTreeLocator, grid);
+  result |= TestLocator(bspTree, grid);
+  return result;
+}
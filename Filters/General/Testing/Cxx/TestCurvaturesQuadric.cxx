@@ -0,0 +1,137 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCurvaturesQuadric.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check the principal curvatures and directions estimated by quadric fitting
+// on a sphere and on a quadrangulated patch of cylinder.
+
+#include "vtkCurvatures.h"
+
+#include "vtkDataArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <string>
+
+namespace
+{
+int CheckSphere(bool invert)
+{
+  const std::string label = invert ? "Inverted sphere" : "Sphere";
+  const double radius = 2.0;
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(radius);
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(48);
+
+  vtkNew<vtkCurvatures> curvatures;
+  curvatures->SetInputConnection(sphere->GetOutputPort());
+  curvatures->SetCurvatureTypeToQuadric();
+  curvatures->SetInvertMeanCurvature(invert);
+  curvatures->Update();
+
+  vtkPointData* pd = curvatures->GetOutput()->GetPointData();
+  vtkDataArray* maximum = pd->GetArray("Maximum_Curvature");
+  vtkDataArray* minimum = pd->GetArray("Minimum_Curvature");
+  if (!maximum || !minimum || pd->GetScalars() != maximum)
+  {
+    cerr << label << ": missing curvature arrays" << endl;
+    return 1;
+  }
+  const double expected = (invert ? -1.0 : 1.0) / radius;
+  for (vtkIdType ptId = 0; ptId < maximum->GetNumberOfTuples(); ++ptId)
+  {
+    const double kMax = maximum->GetTuple1(ptId);
+    const double kMin = minimum->GetTuple1(ptId);
+    if (std::fabs(kMax / expected - 1.0) > 0.01 || std::fabs(kMin / expected - 1.0) > 0.01 ||
+      kMin > kMax)
+    {
+      cerr << label << ": wrong curvatures " << kMax << " " << kMin << " at point " << ptId
+           << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int CheckCylinder()
+{
+  // Half a cylinder of radius 0.5 along the z axis
+  const double radius = 0.5;
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(40, 20);
+  plane->Update();
+  vtkNew<vtkPolyData> cylinder;
+  cylinder->DeepCopy(plane->GetOutput());
+  for (vtkIdType ptId = 0; ptId < cylinder->GetNumberOfPoints(); ++ptId)
+  {
+    double x[3];
+    cylinder->GetPoint(ptId, x);
+    const double angle = (x[0] + 0.5) * vtkMath::Pi();
+    const double z = x[1];
+    x[0] = radius * cos(angle);
+    x[1] = radius * sin(angle);
+    x[2] = z;
+    cylinder->GetPoints()->SetPoint(ptId, x);
+  }
+
+  vtkNew<vtkCurvatures> curvatures;
+  curvatures->SetInputData(cylinder);
+  curvatures->SetCurvatureTypeToQuadric();
+  curvatures->Update();
+
+  vtkPointData* pd = curvatures->GetOutput()->GetPointData();
+  vtkDataArray* maximum = pd->GetArray("Maximum_Curvature");
+  vtkDataArray* minimum = pd->GetArray("Minimum_Curvature");
+  vtkDataArray* maximumDirection = pd->GetArray("Maximum_Curvature_Direction");
+  vtkDataArray* minimumDirection = pd->GetArray("Minimum_Curvature_Direction");
+  if (!maximum || !minimum || !maximumDirection || !minimumDirection)
+  {
+    cerr << "Cylinder: missing curvature arrays" << endl;
+    return 1;
+  }
+  for (vtkIdType ptId = 0; ptId < maximum->GetNumberOfTuples(); ++ptId)
+  {
+    double x[3], maxDir[3], minDir[3];
+    cylinder->GetPoint(ptId, x);
+    maximumDirection->GetTuple(ptId, maxDir);
+    minimumDirection->GetTuple(ptId, minDir);
+    const double radial[3] = { x[0] / radius, x[1] / radius, 0.0 };
+    if (std::fabs(maximum->GetTuple1(ptId) * radius - 1.0) > 0.01 ||
+      std::fabs(minimum->GetTuple1(ptId) * radius) > 0.01 ||
+      std::fabs(std::fabs(minDir[2]) - 1.0) > 1.0e-3 || std::fabs(maxDir[2]) > 1.0e-3 ||
+      std::fabs(vtkMath::Dot(maxDir, radial)) > 1.0e-3)
+    {
+      cerr << "Cylinder: wrong curvatures " << maximum->GetTuple1(ptId) << " "
+           << minimum->GetTuple1(ptId) << " at point " << ptId << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+}
+
+int TestCurvaturesQuadric(int, char*[])
+{
+  if (CheckSphere(false) || CheckSphere(true) || CheckCylinder())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
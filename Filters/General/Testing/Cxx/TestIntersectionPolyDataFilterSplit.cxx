@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestIntersectionPolyDataFilterSplit.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the cells split along the intersection lines replace the input
+// cells in order, that the new cell ids of the intersection lines refer to
+// split cells touching both ends of the lines, and that the ends of the lines
+// are marked as boundary points of the split surfaces.
+
+#include "vtkIntersectionPolyDataFilter.h"
+
+#include "vtkCellData.h"
+#include "vtkCubeSource.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+#include "vtkTriangle.h"
+#include "vtkTriangleFilter.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Triangulate a source and label its cells with their ids
+vtkSmartPointer<vtkPolyData> MakeSurface(vtkPolyDataAlgorithm* source)
+{
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(source->GetOutputPort());
+  triangles->Update();
+  vtkSmartPointer<vtkPolyData> surface = triangles->GetOutput();
+
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("InputCellId");
+  for (vtkIdType cellId = 0; cellId < surface->GetNumberOfCells(); ++cellId)
+  {
+    cellIds->InsertNextValue(cellId);
+  }
+  surface->GetCellData()->AddArray(cellIds);
+  return surface;
+}
+
+double Area(vtkPolyData* surface, vtkIdType cellId)
+{
+  vtkNew<vtkIdList> ptIds;
+  surface->GetCellPoints(cellId, ptIds);
+  double p0[3], p1[3], p2[3];
+  surface->GetPoint(ptIds->GetId(0), p0);
+  surface->GetPoint(ptIds->GetId(1), p1);
+  surface->GetPoint(ptIds->GetId(2), p2);
+  return vtkTriangle::TriangleArea(p0, p1, p2);
+}
+
+bool CellHasPoint(vtkPolyData* surface, vtkIdType cellId, const double x[3])
+{
+  vtkNew<vtkIdList> ptIds;
+  surface->GetCellPoints(cellId, ptIds);
+  for (vtkIdType i = 0; i < ptIds->GetNumberOfIds(); ++i)
+  {
+    double y[3];
+    surface->GetPoint(ptIds->GetId(i), y);
+    if (vtkMath::Distance2BetweenPoints(x, y) < 1.0e-12)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+int CheckSplit(vtkIntersectionPolyDataFilter* filter, int index, const std::string& label)
+{
+  vtkPolyData* input = vtkPolyData::SafeDownCast(filter->GetInput(index));
+  vtkPolyData* output = filter->GetOutput(index + 1);
+  vtkPolyData* lines = filter->GetOutput(0);
+
+  // Each input cell is kept or replaced by its split cells, in order
+  vtkDataArray* inputCellIds = output->GetCellData()->GetArray("InputCellId");
+  vtkIdType nextCellId = 0;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    const vtkIdType inputCellId = static_cast<vtkIdType>(inputCellIds->GetTuple1(cellId));
+    if (inputCellId == nextCellId)
+    {
+      ++nextCellId;
+    }
+    else if (inputCellId != nextCellId - 1 || Area(output, cellId) > Area(input, inputCellId))
+    {
+      cerr << label << ": wrong split cell " << cellId << endl;
+      return 1;
+    }
+  }
+  if (nextCellId != input->GetNumberOfCells())
+  {
+    cerr << label << ": some input cells are missing" << endl;
+    return 1;
+  }
+
+  // The new cells of each line touch its ends, which are boundary points
+  const std::string arrayName = "NewCell" + std::to_string(index) + "ID";
+  vtkDataArray* newCellIds = lines->GetCellData()->GetArray(arrayName.c_str());
+  vtkDataArray* boundaryPoints = output->GetPointData()->GetArray("BoundaryPoints");
+  vtkNew<vtkIdList> linePts;
+  for (vtkIdType lineId = 0; lineId < lines->GetNumberOfCells(); ++lineId)
+  {
+    lines->GetCellPoints(lineId, linePts);
+    for (vtkIdType i = 0; i < linePts->GetNumberOfIds(); ++i)
+    {
+      double x[3];
+      lines->GetPoint(linePts->GetId(i), x);
+      for (int j = 0; j < 2; ++j)
+      {
+        const vtkIdType newCellId = static_cast<vtkIdType>(newCellIds->GetComponent(lineId, j));
+        if (newCellId >= output->GetNumberOfCells() ||
+          (newCellId >= 0 && !CellHasPoint(output, newCellId, x)))
+        {
+          cerr << label << ": wrong new cell " << newCellId << " for line " << lineId << endl;
+          return 1;
+        }
+      }
+
+      bool boundary = false;
+      for (vtkIdType ptId = 0; ptId < output->GetNumberOfPoints() && !boundary; ++ptId)
+      {
+        double y[3];
+        output->GetPoint(ptId, y);
+        boundary = (boundaryPoints->GetTuple1(ptId) == 1 &&
+          vtkMath::Distance2BetweenPoints(x, y) < 1.0e-12);
+      }
+      if (!boundary)
+      {
+        cerr << label << ": the end of line " << lineId << " is not a boundary point" << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+int CheckIntersection(vtkPolyData* surface0, vtkPolyData* surface1, const std::string& label)
+{
+  vtkNew<vtkIntersectionPolyDataFilter> filter;
+  filter->SetInputData(0, surface0);
+  filter->SetInputData(1, surface1);
+  filter->SplitFirstOutputOn();
+  filter->SplitSecondOutputOn();
+  filter->ComputeIntersectionPointArrayOn();
+  filter->Update();
+  if (filter->GetStatus() != 1 || filter->GetNumberOfIntersectionLines() == 0)
+  {
+    cerr << label << ": no intersection" << endl;
+    return 1;
+  }
+  return CheckSplit(filter, 0, label + " first surface") ||
+    CheckSplit(filter, 1, label + " second surface");
+}
+}
+
+int TestIntersectionPolyDataFilterSplit(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere0;
+  sphere0->SetThetaResolution(24);
+  sphere0->SetPhiResolution(24);
+  vtkNew<vtkSphereSource> sphere1;
+  sphere1->SetThetaResolution(27);
+  sphere1->SetPhiResolution(22);
+  sphere1->SetCenter(0.25, 0.1, 0.05);
+
+  // The large faces of the cube are crossed by many lines
+  vtkNew<vtkCubeSource> cube;
+  vtkNew<vtkSphereSource> sphere2;
+  sphere2->SetThetaResolution(20);
+  sphere2->SetPhiResolution(15);
+  sphere2->SetCenter(0.4, 0.3, 0.2);
+  sphere2->SetRadius(0.45);
+
+  if (CheckIntersection(MakeSurface(sphere0), MakeSurface(sphere1), "Spheres") ||
+    CheckIntersection(MakeSurface(cube), MakeSurface(sphere2), "Cube and sphere"))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBBTreeRefit.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that a refitted vtkOBBTree finds the same line intersections as a
+// tree built from scratch after the points of the mesh have moved.
+
+#include "vtkCellArray.h"
+#include "vtkGenericCell.h"
+#include "vtkNew.h"
+#include "vtkOBBTree.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <cmath>
+
+namespace
+{
+const int Resolution = 60;
+
+// A triangulated height field over [0,Resolution]^2.
+void MakeSurface(vtkPolyData* surface)
+{
+  const int np = Resolution + 1;
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(np * np);
+  vtkNew<vtkCellArray> polys;
+  for (int j = 0; j < Resolution; ++j)
+  {
+    for (int i = 0; i < Resolution; ++i)
+    {
+      const vtkIdType p0 = i + np * j;
+      const vtkIdType t0[3] = { p0, p0 + 1, p0 + 1 + np };
+      const vtkIdType t1[3] = { p0, p0 + 1 + np, p0 + np };
+      polys->InsertNextCell(3, t0);
+      polys->InsertNextCell(3, t1);
+    }
+  }
+  surface->SetPoints(points);
+  surface->SetPolys(polys);
+}
+
+// Deform the height field.
+void MovePoints(vtkPolyData* surface, double phase)
+{
+  const int np = Resolution + 1;
+  vtkPoints* points = surface->GetPoints();
+  for (int j = 0; j < np; ++j)
+  {
+    for (int i = 0; i < np; ++i)
+    {
+      points->SetPoint(i + np * j, i + 0.2 * sin(0.1 * j + phase), j,
+        2.0 * sin(0.15 * i + phase) * cos(0.1 * j - phase));
+    }
+  }
+  points->Modified();
+}
+
+int CompareTrees(vtkOBBTree* tree, vtkOBBTree* reference)
+{
+  vtkNew<vtkGenericCell> cell;
+  for (int j = 0; j < 23; ++j)
+  {
+    for (int i = 0; i < 23; ++i)
+    {
+      const double p1[3] = { (i + 0.37) * Resolution / 23.0, (j + 0.61) * Resolution / 23.0, 5.0 };
+      const double p2[3] = { p1[0] + 0.7, p1[1] - 0.3, -5.0 };
+      double t, x[3], pcoords[3], tRef, xRef[3], pcoordsRef[3];
+      int subId, subIdRef;
+      vtkIdType cellId = -1, cellIdRef = -1;
+      const int hit = tree->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+      const int hitRef = reference->IntersectWithLine(
+        p1, p2, 0.0, tRef, xRef, pcoordsRef, subIdRef, cellIdRef, cell);
+      if (hit != hitRef || (hit && std::fabs(t - tRef) > 1e-9))
+      {
+        cerr << "Line (" << i << "," << j << "): hit " << hit << " t " << t << ", reference hit "
+             << hitRef << " t " << tRef << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+}
+
+int TestOBBTreeRefit(int, char*[])
+{
+  vtkNew<vtkPolyData> surface;
+  MakeSurface(surface);
+  MovePoints(surface, 0.0);
+
+  vtkNew<vtkOBBTree> tree;
+  tree->SetDataSet(surface);
+  tree->SetNumberOfCellsPerNode(8);
+  tree->BuildLocator();
+  vtkNew<vtkPolyData> leaves;
+  tree->GenerateRepresentation(-1, leaves);
+  const vtkIdType numLeaves = leaves->GetNumberOfCells();
+
+  for (int step = 1; step <= 3; ++step)
+  {
+    MovePoints(surface, 0.5 * step);
+    tree->Refit();
+
+    // The structure of the tree is kept...
+    tree->GenerateRepresentation(-1, leaves);
+    if (leaves->GetNumberOfCells() != numLeaves)
+    {
+      cerr << "Refit changed the tree structure" << endl;
+      return EXIT_FAILURE;
+    }
+
+    // ... and the tree bounds the moved cells.
+    vtkNew<vtkOBBTree> reference;
+    reference->SetDataSet(surface);
+    reference->SetNumberOfCellsPerNode(8);
+    reference->BuildLocator();
+    if (CompareTrees(tree, reference))
+    {
+      cerr << "Refitted tree differs from a new tree at step " << step << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Without a tree, Refit() builds one.
+  MovePoints(surface, 3.0);
+  vtkNew<vtkOBBTree> newTree;
+  newTree->SetDataSet(surface);
+  newTree->Refit();
+  vtkNew<vtkOBBTree> reference;
+  reference->SetDataSet(surface);
+  reference->BuildLocator();
+  if (CompareTrees(newTree, reference))
+  {
+    cerr << "Tree built by Refit() differs from a new tree" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPolyDataSignedDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compare the signed distance volume of a sphere with the analytic
+// distance, with and without the narrow band.
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPolyDataSignedDistance.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+
+namespace
+{
+const double Radius = 0.5;
+
+// Return the largest difference between the volume and the distance to
+// the sphere, over the voxels within band of the sphere, or over all the
+// voxels when band is negative.
+double MaxError(vtkImageData* volume, double band)
+{
+  vtkFloatArray* scalars =
+    vtkFloatArray::SafeDownCast(volume->GetPointData()->GetArray("SignedDistance"));
+  double maxError = 0.0;
+  for (vtkIdType i = 0; i < volume->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    volume->GetPoint(i, x);
+    const double d = std::sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]) - Radius;
+    if (band < 0.0 || std::fabs(d) < band)
+    {
+      maxError = std::max(maxError, std::fabs(scalars->GetValue(i) - d));
+    }
+  }
+  return maxError;
+}
+}
+
+int TestPolyDataSignedDistance(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(Radius);
+  sphere->SetThetaResolution(48);
+  sphere->SetPhiResolution(48);
+  sphere->Update();
+
+  vtkNew<vtkPolyDataSignedDistance> distance;
+  distance->SetInputConnection(sphere->GetOutputPort());
+  distance->SetDimensions(33, 33, 33);
+  distance->SetBounds(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0);
+  distance->NarrowBandOff();
+  distance->Update();
+
+  // Exact distances: only the faceting of the sphere contributes.
+  vtkNew<vtkImageData> exact;
+  exact->DeepCopy(distance->GetOutput());
+  const double exactError = MaxError(exact, -1.0);
+  if (exactError > 0.01)
+  {
+    cerr << "Exact distance error " << exactError << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Narrow band: exact within the band, eikonal solution beyond.
+  distance->NarrowBandOn();
+  distance->SetNarrowBandWidth(2.0);
+  distance->Update();
+  vtkImageData* banded = distance->GetOutput();
+  vtkFloatArray* exactScalars =
+    vtkFloatArray::SafeDownCast(exact->GetPointData()->GetArray("SignedDistance"));
+  vtkFloatArray* bandedScalars =
+    vtkFloatArray::SafeDownCast(banded->GetPointData()->GetArray("SignedDistance"));
+  const double band = 2.0 * banded->GetSpacing()[0];
+  for (vtkIdType i = 0; i < banded->GetNumberOfPoints(); ++i)
+  {
+    const float e = exactScalars->GetValue(i);
+    const float b = bandedScalars->GetValue(i);
+    if ((std::fabs(e) < band && b != e) || (e < 0.0f) != (b < 0.0f))
+    {
+      cerr << "Voxel " << i << ": narrow band value " << b << ", exact value " << e << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  const double bandedError = MaxError(banded, -1.0);
+  if (bandedError > 3.0 * banded->GetSpacing()[0])
+  {
+    cerr << "Fast sweeping error " << bandedError << endl;
+    return EXIT_FAILURE;
+  }
+
+  // The within-radius evaluation agrees with the unbounded one.
+  vtkNew<vtkImplicitPolyDataDistance> implicitDistance;
+  implicitDistance->SetInput(sphere->GetOutput());
+  double x[3] = { 0.1, 0.55, -0.05 };
+  double value = 0.0;
+  if (!implicitDistance->EvaluateFunctionWithinRadius(x, 0.2, value) ||
+    value != implicitDistance->EvaluateFunction(x))
+  {
+    cerr << "EvaluateFunctionWithinRadius differs from EvaluateFunction" << endl;
+    return EXIT_FAILURE;
+  }
+  x[1] = 0.9;
+  if (implicitDistance->EvaluateFunctionWithinRadius(x, 0.2, value))
+  {
+    cerr << "EvaluateFunctionWithinRadius found a point beyond the radius" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,309 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that vtkSpaceFillingCurveReorder permutes points, cells and
+// attributes consistently, and that the Hilbert order of a regular lattice
+// only moves between neighboring points.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSpaceFillingCurveReorder.h"
+#include "vtkUnstructuredGrid.h"
+
+namespace
+{
+const int Resolution = 8;
+
+// The points of a Resolution^3 lattice, in a scrambled order. The point
+// data holds the position of the point in the lattice.
+void MakeLattice(vtkPoints* points, vtkPointData* pd)
+{
+  const vtkIdType numPts = Resolution * Resolution * Resolution;
+  vtkNew<vtkDoubleArray> scalars;
+  scalars->SetName("Position");
+  scalars->SetNumberOfValues(numPts);
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    const vtkIdType j = (i * 97) % numPts;
+    const int x = j % Resolution, y = (j / Resolution) % Resolution;
+    const int z = j / (Resolution * Resolution);
+    points->SetPoint(i, x, y, z);
+    scalars->SetValue(i, x + 10 * y + 100 * z);
+  }
+  pd->SetScalars(scalars);
+}
+
+// Check that each output point has the coordinates and data of its input
+// point.
+int CheckPoints(vtkPointSet* input, vtkPointSet* output)
+{
+  vtkIdTypeArray* originalIds =
+    vtkIdTypeArray::SafeDownCast(output->GetPointData()->GetArray("vtkOriginalPointIds"));
+  vtkDataArray* scalars = output->GetPointData()->GetScalars();
+  if (!originalIds || !scalars || output->GetNumberOfPoints() != input->GetNumberOfPoints())
+  {
+    cerr << "Missing output points or point data" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < output->GetNumberOfPoints(); ++i)
+  {
+    const vtkIdType id = originalIds->GetValue(i);
+    double x[3], y[3];
+    output->GetPoint(i, x);
+    input->GetPoint(id, y);
+    if (vtkMath::Distance2BetweenPoints(x, y) != 0.0 ||
+      scalars->GetTuple1(i) != input->GetPointData()->GetScalars()->GetTuple1(id))
+    {
+      cerr << "Output point " << i << " does not match input point " << id << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Check that each output cell has the type, point coordinates and data of
+// its input cell.
+int CheckCells(vtkDataSet* input, vtkDataSet* output)
+{
+  vtkIdTypeArray* originalIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  vtkDataArray* data = output->GetCellData()->GetArray("CellId");
+  if (!originalIds || !data || output->GetNumberOfCells() != input->GetNumberOfCells())
+  {
+    cerr << "Missing output cells or cell data" << endl;
+    return 1;
+  }
+  vtkNew<vtkIdList> outPts;
+  vtkNew<vtkIdList> inPts;
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    const vtkIdType id = originalIds->GetValue(i);
+    output->GetCellPoints(i, outPts);
+    input->GetCellPoints(id, inPts);
+    if (output->GetCellType(i) != input->GetCellType(id) ||
+      outPts->GetNumberOfIds() != inPts->GetNumberOfIds() || data->GetTuple1(i) != id)
+    {
+      cerr << "Output cell " << i << " does not match input cell " << id << endl;
+      return 1;
+    }
+    for (vtkIdType j = 0; j < outPts->GetNumberOfIds(); ++j)
+    {
+      double x[3], y[3];
+      output->GetPoint(outPts->GetId(j), x);
+      input->GetPoint(inPts->GetId(j), y);
+      if (vtkMath::Distance2BetweenPoints(x, y) != 0.0)
+      {
+        cerr << "Wrong point " << j << " of output cell " << i << endl;
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+void AddCellIds(vtkDataSet* dataSet)
+{
+  vtkNew<vtkIdTypeArray> cellIds;
+  cellIds->SetName("CellId");
+  cellIds->SetNumberOfValues(dataSet->GetNumberOfCells());
+  for (vtkIdType i = 0; i < dataSet->GetNumberOfCells(); ++i)
+  {
+    cellIds->SetValue(i, i);
+  }
+  dataSet->GetCellData()->AddArray(cellIds);
+}
+
+int TestPolyData()
+{
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  MakeLattice(points, polyData->GetPointData());
+  polyData->SetPoints(points);
+
+  // A vertex per point and a line per pair of consecutive input points
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkCellArray> lines;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    verts->InsertNextCell(1, &i);
+    if (i % 2)
+    {
+      const vtkIdType line[2] = { i - 1, i };
+      lines->InsertNextCell(2, line);
+    }
+  }
+  polyData->SetVerts(verts);
+  polyData->SetLines(lines);
+  AddCellIds(polyData);
+
+  vtkNew<vtkSpaceFillingCurveReorder> reorder;
+  reorder->SetInputData(polyData);
+  reorder->Update();
+  vtkPolyData* output = reorder->GetPolyDataOutput();
+  if (CheckPoints(polyData, output) || CheckCells(polyData, output) ||
+    output->GetNumberOfVerts() != verts->GetNumberOfCells() ||
+    output->GetNumberOfLines() != lines->GetNumberOfCells())
+  {
+    cerr << "Hilbert reordering of a vtkPolyData failed" << endl;
+    return 1;
+  }
+
+  // Consecutive points along the Hilbert curve are lattice neighbors.
+  for (vtkIdType i = 1; i < output->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    output->GetPoint(i - 1, x);
+    output->GetPoint(i, y);
+    if (vtkMath::Distance2BetweenPoints(x, y) != 1.0)
+    {
+      cerr << "Points " << i - 1 << " and " << i << " are not neighbors" << endl;
+      return 1;
+    }
+  }
+
+  // The first eight points along the Morton curve form the first octant of
+  // the lattice.
+  reorder->SetCurveTypeToMorton();
+  reorder->Update();
+  output = reorder->GetPolyDataOutput();
+  if (CheckPoints(polyData, output) || CheckCells(polyData, output))
+  {
+    cerr << "Morton reordering of a vtkPolyData failed" << endl;
+    return 1;
+  }
+  for (vtkIdType i = 0; i < 8; ++i)
+  {
+    double x[3];
+    output->GetPoint(i, x);
+    if (x[0] > 1.0 || x[1] > 1.0 || x[2] > 1.0)
+    {
+      cerr << "Point " << i << " is not in the first octant" << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+int TestUnstructuredGrid()
+{
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  MakeLattice(points, grid->GetPointData());
+  grid->SetPoints(points);
+
+  // Find the point ids of the lattice positions
+  const int np = Resolution;
+  vtkIdType lattice[Resolution * Resolution * Resolution];
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    lattice[static_cast<int>(x[0] + np * (x[1] + np * x[2]))] = i;
+  }
+
+  // Hexahedra in a scrambled order, one of them as a polyhedron
+  const int numHexes = (np - 1) * (np - 1) * (np - 1);
+  grid->Allocate(numHexes);
+  for (int c = 0; c < numHexes; ++c)
+  {
+    const int h = (c * 31) % numHexes;
+    const int i = h % (np - 1), j = (h / (np - 1)) % (np - 1), k = h / ((np - 1) * (np - 1));
+    const int p0 = i + np * (j + np * k);
+    const int corners[8] = { p0, p0 + 1, p0 + 1 + np, p0 + np, p0 + np * np, p0 + 1 + np * np,
+      p0 + 1 + np + np * np, p0 + np + np * np };
+    vtkIdType ids[8];
+    for (int n = 0; n < 8; ++n)
+    {
+      ids[n] = lattice[corners[n]];
+    }
+    if (c == 5)
+    {
+      const vtkIdType faces[30] = { 4, ids[0], ids[3], ids[2], ids[1], 4, ids[4], ids[5], ids[6],
+        ids[7], 4, ids[0], ids[1], ids[5], ids[4], 4, ids[1], ids[2], ids[6], ids[5], 4, ids[2],
+        ids[3], ids[7], ids[6], 4, ids[3], ids[0], ids[4], ids[7] };
+      grid->InsertNextCell(VTK_POLYHEDRON, 8, ids, 6, faces);
+    }
+    else
+    {
+      grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+    }
+  }
+  AddCellIds(grid);
+
+  vtkNew<vtkSpaceFillingCurveReorder> reorder;
+  reorder->SetInputData(grid);
+  reorder->Update();
+  vtkUnstructuredGrid* output = reorder->GetUnstructuredGridOutput();
+  if (CheckPoints(grid, output) || CheckCells(grid, output))
+  {
+    cerr << "Reordering of a vtkUnstructuredGrid failed" << endl;
+    return 1;
+  }
+
+  // The face stream of the polyhedron refers to the new point ids
+  vtkIdTypeArray* originalIds =
+    vtkIdTypeArray::SafeDownCast(output->GetCellData()->GetArray("vtkOriginalCellIds"));
+  for (vtkIdType i = 0; i < output->GetNumberOfCells(); ++i)
+  {
+    if (output->GetCellType(i) != VTK_POLYHEDRON)
+    {
+      continue;
+    }
+    vtkNew<vtkIdList> inFaces;
+    vtkNew<vtkIdList> outFaces;
+    grid->GetFaceStream(originalIds->GetValue(i), inFaces);
+    output->GetFaceStream(i, outFaces);
+    if (outFaces->GetNumberOfIds() != 31 || inFaces->GetNumberOfIds() != 31)
+    {
+      cerr << "Wrong face stream size" << endl;
+      return 1;
+    }
+    for (vtkIdType j = 1; j < 31; j += 5)
+    {
+      for (vtkIdType n = 1; n <= 4; ++n)
+      {
+        double x[3], y[3];
+        output->GetPoint(outFaces->GetId(j + n), x);
+        grid->GetPoint(inFaces->GetId(j + n), y);
+        if (vtkMath::Distance2BetweenPoints(x, y) != 0.0)
+        {
+          cerr << "Wrong face point in the polyhedron" << endl;
+          return 1;
+        }
+      }
+    }
+    return 0;
+  }
+  cerr << "The polyhedron is missing from the output" << endl;
+  return 1;
+}
+}
+
+int TestSpaceFillingCurveReorder(int, char*[])
+{
+  if (TestPolyData() || TestUnstructuredGrid())
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include "vtkCellData.h"
 #include "vtkDistancePolyDataFilter.h"
 #include "vtkDoubleArray.h"
+#include "vtkFastWindingNumber.h"
 #include "vtkFloatArray.h"
 #include "vtkGenericCell.h"
 #include "vtkInformation.h"
@@ -24,8 +25,12 @@
 #include "vtkIntersectionPolyDataFilter.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkSmartPointer.h"
 
+#include <cmath>
+#include <vector>
+
 vtkStandardNewMacro(vtkBooleanOperationPolyDataFilter);
 
 //-----------------------------------------------------------------------------
@@ -35,6 +40,7 @@ vtkBooleanOperationPolyDataFilter::vtkBooleanOperationPolyDataFilter()
   this->Tolerance = 1e-6;
   this->Operation = VTK_UNION;
   this->ReorientDifferenceCells = 1;
+  this->Method = SIGNED_DISTANCE;
 
   this->SetNumberOfInputPorts(2);
   this->SetNumberOfOutputPorts(2);
@@ -49,6 +55,25 @@ void vtkBooleanOperationPolyDataFilter::SortPolyData(
 {
   int numCells = input->GetNumberOfCells();
 
+  if (this->Method == WINDING_NUMBER)
+  {
+    vtkDoubleArray* windingArray =
+      vtkArrayDownCast<vtkDoubleArray>(input->GetCellData()->GetArray("WindingNumber"));
+
+    for (int cid = 0; cid < numCells; cid++)
+    {
+      if (std::abs(windingArray->GetValue(cid)) < 0.5)
+      {
+        unionList->InsertNextId(cid);
+      }
+      else
+      {
+        interList->InsertNextId(cid);
+      }
+    }
+    return;
+  }
+
   vtkDoubleArray* distArray =
     vtkArrayDownCast<vtkDoubleArray>(input->GetCellData()->GetArray("Distance"));
 
@@ -66,6 +91,43 @@ void vtkBooleanOperationPolyDataFilter::SortPolyData(
   }
 }
 
+//-----------------------------------------------------------------------------
+void vtkBooleanOperationPolyDataFilter::ComputeWindingNumbers(
+  vtkPolyData* mesh, vtkPolyData* surface)
+{
+  vtkIdType numCells = mesh->GetNumberOfCells();
+
+  // The cell centers are gathered serially because the cell access of
+  // vtkPolyData is not thread safe; the winding numbers, which dominate the
+  // cost, are evaluated in parallel.
+  vtkSmartPointer<vtkPoints> centers = vtkSmartPointer<vtkPoints>::New();
+  centers->SetDataTypeToDouble();
+  centers->SetNumberOfPoints(numCells);
+
+  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
+  std::vector<double> weights(mesh->GetMaxCellSize());
+  for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+  {
+    mesh->GetCell(cellId, cell);
+    int subId;
+    double pcoords[3], x[3];
+
+    cell->GetParametricCenter(pcoords);
+    cell->EvaluateLocation(subId, pcoords, x, weights.data());
+    centers->SetPoint(cellId, x);
+  }
+
+  vtkSmartPointer<vtkFastWindingNumber> windingNumber =
+    vtkSmartPointer<vtkFastWindingNumber>::New();
+  windingNumber->SetSurface(surface);
+
+  vtkSmartPointer<vtkDoubleArray> windingArray = vtkSmartPointer<vtkDoubleArray>::New();
+  windingArray->SetName("WindingNumber");
+  windingNumber->EvaluateWindingNumbers(centers, windingArray);
+
+  mesh->GetCellData()->AddArray(windingArray);
+}
+
 //-----------------------------------------------------------------------------
 int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
@@ -111,17 +173,33 @@ int vtkBooleanOperationPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(re
   outputIntersection->GetPointData()->PassData(PolyDataIntersection->GetOutput()->GetPointData());
   outputIntersection->GetCellData()->PassData(PolyDataIntersection->GetOutput()->GetCellData());
 
-  // Compute distances
-  vtkSmartPointer<vtkDistancePolyDataFilter> PolyDataDistance =
-    vtkSmartPointer<vtkDistancePolyDataFilter>::New();
+  vtkSmartPointer<vtkPolyData> pd0;
+  vtkSmartPointer<vtkPolyData> pd1;
+  if (this->Method == WINDING_NUMBER)
+  {
+    // Compute the winding number of each surface at the cells of the other
+    pd0 = vtkSmartPointer<vtkPolyData>::New();
+    pd0->ShallowCopy(PolyDataIntersection->GetOutput(1));
+    pd1 = vtkSmartPointer<vtkPolyData>::New();
+    pd1->ShallowCopy(PolyDataIntersection->GetOutput(2));
+
+    this->ComputeWindingNumbers(pd0, pd1);
+    this->ComputeWindingNumbers(pd1, pd0);
+  }
+  else
+  {
+    // Compute distances
+    vtkSmartPointer<vtkDistancePolyDataFilter> PolyDataDistance =
+      vtkSmartPointer<vtkDistancePolyDataFilter>::New();
 
-  PolyDataDistance->SetInputConnection(0, PolyDataIntersection->GetOutputPort(1));
-  PolyDataDistance->SetInputConnection(1, PolyDataIntersection->GetOutputPort(2));
-  PolyDataDistance->ComputeSecondDistanceOn();
-  PolyDataDistance->Update();
+    PolyDataDistance->SetInputConnection(0, PolyDataIntersection->GetOutputPort(1));
+    PolyDataDistance->SetInputConnection(1, PolyDataIntersection->GetOutputPort(2));
+    PolyDataDistance->ComputeSecondDistanceOn();
+    PolyDataDistance->Update();
 
-  vtkPolyData* pd0 = PolyDataDistance->GetOutput();
-  vtkPolyData* pd1 = PolyDataDistance->GetSecondDistanceOutput();
+    pd0 = PolyDataDistance->GetOutput();
+    pd1 = PolyDataDistance->GetSecondDistanceOutput();
+  }
 
   pd0->BuildCells();
   pd0->BuildLinks();
@@ -239,6 +317,8 @@ void vtkBooleanOperationPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   }
   os << "\n";
   os << indent << "ReorientDifferenceCells: " << this->ReorientDifferenceCells << "\n";
+  os << indent << "Method: "
+     << (this->Method == WINDING_NUMBER ? "Winding Number\n" : "Signed Distance\n");
 }
 
 //-----------------------------------------------------------------------------
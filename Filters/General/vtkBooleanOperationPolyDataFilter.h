@@ -27,6 +27,13 @@
  * @warning This filter is not designed to perform 2D boolean operations,
  * and in fact relies on the inputs having no co-planar, overlapping cells.
  *
+ * The cells of each surface are classified as inside or outside the other
+ * surface, either by the sign of the distance from their center to it
+ * computed by vtkDistancePolyDataFilter (the default), or by the
+ * generalized winding number of the other surface at their center computed
+ * by vtkFastWindingNumber (see SetMethod()). The winding number is robust to
+ * small holes and overlaps in the surfaces.
+ *
  * This code was contributed in the VTK Journal paper:
  * "Boolean Operations on Surfaces in VTK Without External Libraries"
  * by Cory Quammen, Chris Weigle C., Russ Taylor
@@ -93,15 +100,45 @@ public:
   vtkGetMacro(Tolerance, double);
   //@}
 
+  /**
+   * The methods used to classify the cells of each surface.
+   */
+  enum Methods
+  {
+    SIGNED_DISTANCE = 0,
+    WINDING_NUMBER = 1
+  };
+
+  //@{
+  /**
+   * Specify how the cells of each surface are classified as inside or
+   * outside the other surface: by the signed distance from their center to
+   * it (the default), or by its winding number at their center, a cell being
+   * inside when the magnitude of the winding number is at least 0.5. The
+   * Tolerance is only used by the signed distance method.
+   */
+  vtkSetClampMacro(Method, int, SIGNED_DISTANCE, WINDING_NUMBER);
+  vtkGetMacro(Method, int);
+  void SetMethodToSignedDistance() { this->SetMethod(SIGNED_DISTANCE); }
+  void SetMethodToWindingNumber() { this->SetMethod(WINDING_NUMBER); }
+  //@}
+
 protected:
   vtkBooleanOperationPolyDataFilter();
   ~vtkBooleanOperationPolyDataFilter() override;
 
   /**
-   * Labels triangles in mesh as part of the intersection or union surface.
+   * Labels triangles in mesh as part of the intersection or union surface,
+   * from their "Distance" or "WindingNumber" cell data depending on Method.
    */
   void SortPolyData(vtkPolyData* input, vtkIdList* intersectionList, vtkIdList* unionList);
 
+  /**
+   * Adds to the cell data of mesh a "WindingNumber" array holding the
+   * winding number of surface at the center of each cell.
+   */
+  void ComputeWindingNumbers(vtkPolyData* mesh, vtkPolyData* surface);
+
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   int FillInputPortInformation(int, vtkInformation*) override;
 
@@ -130,6 +167,11 @@ private:
    */
   int Operation;
 
+  /**
+   * How cells are classified: SIGNED_DISTANCE or WINDING_NUMBER.
+   */
+  int Method;
+
   //@{
   /**
    * Determines if cells from the intersection surface should be
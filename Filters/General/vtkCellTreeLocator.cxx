@@ -552,6 +552,12 @@ vtkCellTreeLocator::~vtkCellTreeLocator()
   this->vtkCellTreeLocator::FreeSearchStructure();
 }
 
+//----------------------------------------------------------------------------
+void vtkCellTreeLocator::PrepareForConcurrentQueries()
+{
+  this->ForceBuildLocator();
+  this->Superclass::PrepareForConcurrentQueries();
+}
 //----------------------------------------------------------------------------
 void vtkCellTreeLocator::BuildLocatorIfNeeded()
 {
@@ -684,18 +690,13 @@ double _getMinDistNEG_Z(const double origin[3], const double dir[3], const doubl
 typedef std::pair<double, int> Intersection;
 
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId)
 {
-  int hit = this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
-  if (hit)
-  {
-    this->DataSet->GetCell(cellId, cell);
-  }
-  return hit;
+  return this->IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId, this->GenericCell);
 }
 
 int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3], double tol,
-  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds)
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellIds, vtkGenericCell* cell)
 {
   //
   vtkCellTreeNode *node, *near, *far;
@@ -790,7 +791,8 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
         node = near;
       }
     }
-    double t_hit, ipt[3];
+    double t_hit, ipt[3], pc[3];
+    int sub;
     // Ok, so we're a leaf node, first check the BBox against the ray
     // then test the candidates in our sorted ray direction order
     _tmin = tmin;
@@ -813,16 +815,18 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
       {
         this->DataSet->GetCellBounds(cell_ID, cellBounds);
       }
+      // The cells of a leaf are not sorted along the ray, so a cell further
+      // than the closest intersection does not end the search of the leaf.
       if (_getMinDist(p1, ray_vec, boundsPtr) > closest_intersection)
       {
-        break;
+        continue;
       }
       //
       ctmin = _tmin;
       ctmax = _tmax;
       if (this->RayMinMaxT(boundsPtr, p1, ray_vec, ctmin, ctmax))
       {
-        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pcoords, subId))
+        if (this->IntersectCellInternal(cell_ID, p1, p2, tol, t_hit, ipt, pc, sub, cell))
         {
           if (t_hit < closest_intersection)
           {
@@ -832,6 +836,10 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
             x[0] = ipt[0];
             x[1] = ipt[1];
             x[2] = ipt[2];
+            pcoords[0] = pc[0];
+            pcoords[1] = pc[1];
+            pcoords[2] = pc[2];
+            subId = sub;
           }
         }
       }
@@ -841,6 +849,7 @@ int vtkCellTreeLocator::IntersectWithLine(const double p1[3], const double p2[3]
   if (HIT)
   {
     t = closest_intersection;
+    this->DataSet->GetCell(cellIds, cell);
   }
   //
   return HIT;
@@ -1221,8 +1230,16 @@ void vtkCellTreeLocator::Classify(const double origin[3], const double dir[3], d
 int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
   const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId)
 {
-  this->DataSet->GetCell(cell_ID, this->GenericCell);
-  return this->GenericCell->IntersectWithLine(
+  return this->IntersectCellInternal(
+    cell_ID, p1, p2, tol, t, ipt, pcoords, subId, this->GenericCell);
+}
+//----------------------------------------------------------------------------
+int vtkCellTreeLocator::IntersectCellInternal(vtkIdType cell_ID, const double p1[3],
+  const double p2[3], const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+  vtkGenericCell* cell)
+{
+  this->DataSet->GetCell(cell_ID, cell);
+  return cell->IntersectWithLine(
     const_cast<double*>(p1), const_cast<double*>(p2), tol, t, ipt, pcoords, subId);
 }
 //----------------------------------------------------------------------------
@@ -82,6 +82,12 @@ public:
    */
   void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
 
+  /**
+   * FindCell() and IntersectWithLine() taking a vtkGenericCell are thread
+   * safe once the locator is built.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /*
     if the borland compiler is ever removed, we can use these declarations
     instead of reimplementaing the calls in this subclass
@@ -217,6 +223,14 @@ protected:
   virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
     const double tol, double& t, double ipt[3], double pcoords[3], int& subId);
 
+  // Same as above but uses the provided cell so that it can be called
+  // concurrently. The version above forwards to this one with GenericCell.
+  virtual int IntersectCellInternal(vtkIdType cell_ID, const double p1[3], const double p2[3],
+    const double tol, double& t, double ipt[3], double pcoords[3], int& subId,
+    vtkGenericCell* cell);
+
+  void PrepareForConcurrentQueries() override;
+
   int NumberOfBuckets;
 
   vtkCellTree* Tree;
@@ -15,6 +15,7 @@
 #include "vtkCurvatures.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
 #include "vtkFieldData.h"
@@ -28,12 +29,307 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkStaticCellLinksTemplate.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
 #include "vtkTriangle.h"
 
-#include <memory> // For unique_ptr
+#include <algorithm> // For min, sort, unique
+#include <cmath>     // For sqrt
+#include <vector>    // For the per-edge and per-facet terms
 
 vtkStandardNewMacro(vtkCurvatures);
 
+namespace
+{
+
+//-------------------------------------------------------//
+// Solve the normal equations of a least squares fit with a Cholesky
+// decomposition. Returns false if the system is (nearly) singular.
+bool SolveNormalEquations(double a[5][5], double b[5], int size)
+{
+  double maxDiagonal = 0.0;
+  for (int i = 0; i < size; ++i)
+  {
+    maxDiagonal = std::max(maxDiagonal, a[i][i]);
+  }
+  const double tolerance = 1.0e-10 * maxDiagonal;
+  for (int j = 0; j < size; ++j)
+  {
+    double d = a[j][j];
+    for (int k = 0; k < j; ++k)
+    {
+      d -= a[j][k] * a[j][k];
+    }
+    if (!(d > tolerance))
+    {
+      return false;
+    }
+    a[j][j] = sqrt(d);
+    for (int i = j + 1; i < size; ++i)
+    {
+      double l = a[i][j];
+      for (int k = 0; k < j; ++k)
+      {
+        l -= a[i][k] * a[j][k];
+      }
+      a[i][j] = l / a[j][j];
+    }
+  }
+  for (int i = 0; i < size; ++i)
+  {
+    for (int k = 0; k < i; ++k)
+    {
+      b[i] -= a[i][k] * b[k];
+    }
+    b[i] /= a[i][i];
+  }
+  for (int i = size - 1; i >= 0; --i)
+  {
+    for (int k = i + 1; k < size; ++k)
+    {
+      b[i] -= a[k][i] * b[k];
+    }
+    b[i] /= a[i][i];
+  }
+  return true;
+}
+
+//-------------------------------------------------------//
+// Fit a quadric height field to the neighbourhood of each point and compute
+// the principal curvatures and directions of its shape operator.
+struct FitQuadrics
+{
+  vtkPolyData* Mesh;
+  vtkCellArray* Cells;
+  vtkStaticCellLinksTemplate<vtkIdType>* Links;
+  bool Invert;
+  double* Maximum;
+  double* Minimum;
+  double* MaximumDirection;
+  double* MinimumDirection;
+
+  vtkSMPThreadLocal<std::vector<vtkIdType>> Neighbors;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkCellArrayIterator>> Iterator;
+
+  FitQuadrics(vtkPolyData* mesh, vtkStaticCellLinksTemplate<vtkIdType>* links, bool invert,
+    double* maximum, double* minimum, double* maximumDirection, double* minimumDirection)
+    : Mesh(mesh)
+    , Cells(mesh->GetPolys())
+    , Links(links)
+    , Invert(invert)
+    , Maximum(maximum)
+    , Minimum(minimum)
+    , MaximumDirection(maximumDirection)
+    , MinimumDirection(minimumDirection)
+  {
+  }
+
+  // Append the points of the cells using the point
+  void AddRing(vtkIdType ptId, std::vector<vtkIdType>& neighbors)
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    const vtkIdType* cells = this->Links->GetCells(ptId);
+    const vtkIdType ncells = this->Links->GetNcells(ptId);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType i = 0; i < ncells; ++i)
+    {
+      iter->GetCellAtId(cells[i], npts, pts);
+      neighbors.insert(neighbors.end(), pts, pts + npts);
+    }
+  }
+
+  // Area weighted normal of the polygons using the point (Newell's method)
+  void ComputeNormal(vtkIdType ptId, double normal[3])
+  {
+    vtkCellArrayIterator* iter = this->Iterator.Local();
+    const vtkIdType* cells = this->Links->GetCells(ptId);
+    const vtkIdType ncells = this->Links->GetNcells(ptId);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    normal[0] = normal[1] = normal[2] = 0.0;
+    for (vtkIdType i = 0; i < ncells; ++i)
+    {
+      if (i > 0 && cells[i] == cells[i - 1])
+      {
+        continue;
+      }
+      iter->GetCellAtId(cells[i], npts, pts);
+      double p0[3], p1[3];
+      this->Mesh->GetPoint(pts[npts - 1], p0);
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        this->Mesh->GetPoint(pts[j], p1);
+        normal[0] += (p0[1] - p1[1]) * (p0[2] + p1[2]);
+        normal[1] += (p0[2] - p1[2]) * (p0[0] + p1[0]);
+        normal[2] += (p0[0] - p1[0]) * (p0[1] + p1[1]);
+        p0[0] = p1[0];
+        p0[1] = p1[1];
+        p0[2] = p1[2];
+      }
+    }
+  }
+
+  // The cell arrays are read through an iterator per thread
+  void Initialize() { this->Iterator.Local() = vtk::TakeSmartPointer(this->Cells->NewIterator()); }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    std::vector<vtkIdType>& neighbors = this->Neighbors.Local();
+    for (; ptId < endPtId; ++ptId)
+    {
+      double* maxDir = this->MaximumDirection + 3 * ptId;
+      double* minDir = this->MinimumDirection + 3 * ptId;
+      this->Maximum[ptId] = this->Minimum[ptId] = 0.0;
+      maxDir[0] = maxDir[1] = maxDir[2] = 0.0;
+      minDir[0] = minDir[1] = minDir[2] = 0.0;
+
+      double n[3], u[3], w[3];
+      this->ComputeNormal(ptId, n);
+      if (vtkMath::Normalize(n) == 0.0)
+      {
+        continue;
+      }
+      vtkMath::Perpendiculars(n, u, w, 0.0);
+
+      // The one-ring, extended to the two-ring when it is too small to
+      // determine the five coefficients of the quadric reliably (this is
+      // the case of most boundary points)
+      neighbors.clear();
+      this->AddRing(ptId, neighbors);
+      std::sort(neighbors.begin(), neighbors.end());
+      neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+      if (neighbors.size() < 7)
+      {
+        const std::vector<vtkIdType> ring(neighbors);
+        for (vtkIdType nei : ring)
+        {
+          this->AddRing(nei, neighbors);
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+      }
+      neighbors.erase(std::remove(neighbors.begin(), neighbors.end(), ptId), neighbors.end());
+      if (neighbors.size() < 3)
+      {
+        continue;
+      }
+
+      // Local coordinates of the neighbours, scaled by their mean distance
+      // to keep the normal equations well conditioned
+      double x[3], y[3], d[3];
+      this->Mesh->GetPoint(ptId, x);
+      double scale = 0.0;
+      for (vtkIdType nei : neighbors)
+      {
+        this->Mesh->GetPoint(nei, y);
+        scale += sqrt(vtkMath::Distance2BetweenPoints(x, y));
+      }
+      scale /= static_cast<double>(neighbors.size());
+      if (scale == 0.0)
+      {
+        continue;
+      }
+
+      // Least squares fit of z = a x^2 + b x y + c y^2 + d x + e y. Fall
+      // back to z = a x^2 + b x y + c y^2 if the neighbourhood is degenerate.
+      double ata[5][5] = {}, atz[5] = {}, row[5];
+      for (vtkIdType nei : neighbors)
+      {
+        this->Mesh->GetPoint(nei, y);
+        vtkMath::Subtract(y, x, d);
+        const double px = vtkMath::Dot(d, u) / scale;
+        const double py = vtkMath::Dot(d, w) / scale;
+        const double pz = vtkMath::Dot(d, n) / scale;
+        row[0] = px * px;
+        row[1] = px * py;
+        row[2] = py * py;
+        row[3] = px;
+        row[4] = py;
+        for (int i = 0; i < 5; ++i)
+        {
+          for (int j = 0; j <= i; ++j)
+          {
+            ata[i][j] += row[i] * row[j];
+          }
+          atz[i] += row[i] * pz;
+        }
+      }
+      double coef[5], fit[5][5];
+      std::copy(&ata[0][0], &ata[0][0] + 25, &fit[0][0]);
+      std::copy(atz, atz + 5, coef);
+      if (neighbors.size() < 5 || !SolveNormalEquations(fit, coef, 5))
+      {
+        std::copy(&ata[0][0], &ata[0][0] + 25, &fit[0][0]);
+        std::copy(atz, atz + 3, coef);
+        coef[3] = coef[4] = 0.0;
+        if (!SolveNormalEquations(fit, coef, 3))
+        {
+          continue;
+        }
+      }
+
+      // Shape operator I^-1 II of the quadric at the origin, with the sign
+      // chosen so that a sphere with outward normals has positive curvatures
+      const double fx = coef[3], fy = coef[4];
+      const double g = sqrt(1.0 + fx * fx + fy * fy);
+      const double l = -2.0 * coef[0] / g, m = -coef[1] / g, nn = -2.0 * coef[2] / g;
+      const double e = 1.0 + fx * fx, f = fx * fy, gg = 1.0 + fy * fy;
+      const double det = e * gg - f * f;
+      const double s00 = (gg * l - f * m) / det, s01 = (gg * m - f * nn) / det;
+      const double s10 = (e * m - f * l) / det, s11 = (e * nn - f * m) / det;
+      const double halfTrace = 0.5 * (s00 + s11);
+      const double disc = halfTrace * halfTrace - (s00 * s11 - s01 * s10);
+      const double root = (disc > 0.0 ? sqrt(disc) : 0.0);
+      double kMax = (halfTrace + root) / scale;
+      double kMin = (halfTrace - root) / scale;
+
+      // Eigenvector of the maximum curvature, in the tangent basis of the
+      // quadric parametrization
+      double a0 = s01, a1 = halfTrace + root - s00;
+      const double b0 = halfTrace + root - s11, b1 = s10;
+      if (a0 * a0 + a1 * a1 < b0 * b0 + b1 * b1)
+      {
+        a0 = b0;
+        a1 = b1;
+      }
+      if (a0 * a0 + a1 * a1 == 0.0)
+      {
+        a0 = 1.0;
+      }
+      double fitNormal[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        maxDir[i] = a0 * (u[i] + fx * n[i]) + a1 * (w[i] + fy * n[i]);
+        fitNormal[i] = n[i] - fx * u[i] - fy * w[i];
+      }
+      vtkMath::Normalize(maxDir);
+      vtkMath::Cross(fitNormal, maxDir, minDir);
+      vtkMath::Normalize(minDir);
+
+      if (this->Invert)
+      {
+        std::swap(kMax, kMin);
+        kMax = -kMax;
+        kMin = -kMin;
+        for (int i = 0; i < 3; ++i)
+        {
+          std::swap(maxDir[i], minDir[i]);
+        }
+      }
+      this->Maximum[ptId] = kMax;
+      this->Minimum[ptId] = kMin;
+    }
+  }
+
+  void Reduce() {}
+};
+
+} // anonymous namespace
+
 //-------------------------------------------------------//
 vtkCurvatures::vtkCurvatures()
 {
@@ -52,12 +348,9 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
     return;
   }
 
-  int numPts = mesh->GetNumberOfPoints();
+  vtkIdType numPts = mesh->GetNumberOfPoints();
 
   //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
@@ -65,126 +358,184 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   // Get the array so we can write to it directly
   double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
-  mesh->BuildLinks();
-  // data init
-  const int F = mesh->GetNumberOfCells();
-  // init, preallocate the mean curvature
-  const std::unique_ptr<int[]> num_neighb(new int[numPts]);
-  for (int v = 0; v < numPts; v++)
+  // The cells indexed by cell id: the polygons, unless there are other cells
+  vtkSmartPointer<vtkCellArray> cells = mesh->GetPolys();
+  if (mesh->GetNumberOfCells() != mesh->GetNumberOfPolys())
   {
-    meanCurvatureData[v] = 0.0;
-    num_neighb[v] = 0;
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    cells->AllocateEstimate(mesh->GetNumberOfCells(), 3);
+    vtkIdType npts;
+    const vtkIdType* pts;
+    for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+    {
+      mesh->GetCellPoints(cellId, npts, pts);
+      cells->InsertNextCell(npts, pts);
+    }
   }
 
+  // The half-edges of a cell are its edges, and give the neighbors of the
+  // cell across them. The links list the cells of each point by decreasing
+  // cell id.
+  vtkStaticHalfEdgeMeshTemplate<vtkIdType> halfEdges;
+  halfEdges.BuildHalfEdges(numPts, cells);
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.SerialBuildLinks(numPts, cells->GetNumberOfCells(), cells);
+  // data init
+  const vtkIdType F = halfEdges.GetNumberOfCells();
+  // curvature of every edge of every facet, if computed there
+  std::vector<double> edgeCurvature(halfEdges.GetNumberOfHalfEdges(), 0.0);
+  std::vector<char> edgeComputed(halfEdges.GetNumberOfHalfEdges(), 0);
+
   //     main loop
   vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
   vtkDebugMacro(<< "so that every edge comes only once");
   //
-  for (int f = 0; f < F; f++)
-  {
-    mesh->GetCellPoints(f, vertices);
-    const int nv = vertices->GetNumberOfIds();
-
-    for (int v = 0; v < nv; v++)
+  vtkSMPTools::For(0, F, [&](vtkIdType f, vtkIdType endF) {
+    double n_f[3]; // normal of facet (could be stored for later?)
+    double n_n[3]; // normal of edge
+    double t[3];   // to store the cross product of n_f n_n
+    double ore[3]; // origin of e
+    double end[3]; // end of e
+    double oth[3]; //     third vertex necessary for comp of n
+    double vn0[3];
+    double vn1[3]; // vertices for computation of neighbour's n
+    double vn2[3];
+    double e[3]; // edge (oriented)
+
+    for (; f < endF; f++)
     {
-      // get neighbour
-      const int v_l = vertices->GetId(v);
-      const int v_r = vertices->GetId((v + 1) % nv);
-      const int v_o = vertices->GetId((v + 2) % nv);
-      mesh->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      int n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
+      const vtkIdType he_f = halfEdges.GetCellHalfEdge(f);
+      const vtkIdType nv = halfEdges.GetCellSize(f);
+
+      for (vtkIdType v = 0; v < nv; v++)
       {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        mesh->GetPoint(v_l, ore);
-        mesh->GetPoint(v_r, end);
-        mesh->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        mesh->GetCellPoints(n, vertices_n);
-        mesh->GetPoint(vertices_n->GetId(0), vn0);
-        mesh->GetPoint(vertices_n->GetId(1), vn1);
-        mesh->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
+        // get neighbour
+        const vtkIdType he = he_f + v;
+        const vtkIdType v_l = halfEdges.GetOrigin(he);
+        const vtkIdType v_r = halfEdges.GetOrigin(he_f + (v + 1) % nv);
+        const vtkIdType v_o = halfEdges.GetOrigin(he_f + (v + 2) % nv);
+
+        // compute only if there is really ONE neighbour
+        // AND meanCurvature has not been computed yet!
+        // (ensured by n > f)
+        if (halfEdges.GetNumberOfEdgeNeighbors(he) != 1)
         {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
+          continue;
         }
-        else
+        vtkIdType mate = halfEdges.GetMate(he);
+        while (halfEdges.GetCell(mate) == f)
         {
-          Hf = 0.0;
+          mate = halfEdges.GetMate(mate);
         }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
+        const vtkIdType n = halfEdges.GetCell(mate); // n short for neighbor
+        if (n > f && halfEdges.GetCellSize(n) >= 3)
         {
-          (Hf /= Af) *= 3.0;
+          const vtkIdType he_n = halfEdges.GetCellHalfEdge(n);
+          double Hf; // temporary store
+
+          // find 3 corners of f: in order!
+          mesh->GetPoint(v_l, ore);
+          mesh->GetPoint(v_r, end);
+          mesh->GetPoint(v_o, oth);
+          // compute normal of f
+          vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+          // compute common edge
+          e[0] = end[0];
+          e[1] = end[1];
+          e[2] = end[2];
+          e[0] -= ore[0];
+          e[1] -= ore[1];
+          e[2] -= ore[2];
+          const double length = vtkMath::Normalize(e);
+          double Af = vtkTriangle::TriangleArea(ore, end, oth);
+          // find 3 corners of n: in order!
+          mesh->GetPoint(halfEdges.GetOrigin(he_n), vn0);
+          mesh->GetPoint(halfEdges.GetOrigin(he_n + 1), vn1);
+          mesh->GetPoint(halfEdges.GetOrigin(he_n + 2), vn2);
+          Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+          // compute normal of n
+          vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+          // the cosine is n_f * n_n
+          const double cs = vtkMath::Dot(n_f, n_n);
+          // the sin is (n_f x n_n) * e
+          vtkMath::Cross(n_f, n_n, t);
+          const double sn = vtkMath::Dot(t, e);
+          // signed angle in [-pi,pi]
+          if (sn != 0.0 || cs != 0.0)
+          {
+            const double angle = atan2(sn, cs);
+            Hf = length * angle;
+          }
+          else
+          {
+            Hf = 0.0;
+          }
+          // weighted Hf is added to scalar at v_l and v_r below
+          if (Af != 0.0)
+          {
+            (Hf /= Af) *= 3.0;
+          }
+          edgeCurvature[he] = Hf;
+          edgeComputed[he] = 1;
         }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
-        num_neighb[v_l] += 1;
-        num_neighb[v_r] += 1;
       }
     }
-  }
+  });
 
-  // put curvature in vtkArray
-  for (int v = 0; v < numPts; v++)
-  {
-    if (num_neighb[v] > 0)
+  // put curvature in vtkArray, gathering the edges of the facets of every
+  // vertex in the order of the facets
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
     {
-      const double Hf = 0.5 * meanCurvatureData[v] / num_neighb[v];
-      if (this->InvertMeanCurvature)
+      double H = 0.0;
+      int num_neighb = 0;
+      const vtkIdType* pointCells = links.GetCells(ptId);
+      for (vtkIdType i = links.GetNcells(ptId) - 1; i >= 0; --i)
+      {
+        const vtkIdType f = pointCells[i];
+        if (i < links.GetNcells(ptId) - 1 && f == pointCells[i + 1])
+        {
+          continue;
+        }
+        const vtkIdType he_f = halfEdges.GetCellHalfEdge(f);
+        const vtkIdType nv = halfEdges.GetCellSize(f);
+        for (vtkIdType v = 0; v < nv; v++)
+        {
+          const vtkIdType edgeId = he_f + v;
+          if (edgeComputed[edgeId])
+          {
+            if (halfEdges.GetOrigin(edgeId) == ptId)
+            {
+              H += edgeCurvature[edgeId];
+              num_neighb += 1;
+            }
+            if (halfEdges.GetOrigin(he_f + (v + 1) % nv) == ptId)
+            {
+              H += edgeCurvature[edgeId];
+              num_neighb += 1;
+            }
+          }
+        }
+      }
+
+      if (num_neighb > 0)
       {
-        meanCurvatureData[v] = -Hf;
+        const double Hf = 0.5 * H / num_neighb;
+        if (this->InvertMeanCurvature)
+        {
+          meanCurvatureData[ptId] = -Hf;
+        }
+        else
+        {
+          meanCurvatureData[ptId] = Hf;
+        }
       }
       else
       {
-        meanCurvatureData[v] = Hf;
+        meanCurvatureData[ptId] = 0.0;
       }
     }
-    else
-    {
-      meanCurvatureData[v] = 0.0;
-    }
-  }
+  });
 
   mesh->GetPointData()->AddArray(meanCurvature);
   mesh->GetPointData()->SetActiveScalars("Mean_Curvature");
@@ -209,73 +560,76 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
   // other data
   vtkIdType Nv = output->GetNumberOfPoints();
 
-  const std::unique_ptr<double[]> K(new double[Nv]);
-  const std::unique_ptr<double[]> dA(new double[Nv]);
-  double pi2 = 2.0 * vtkMath::Pi();
-  for (int k = 0; k < Nv; k++)
-  {
-    K[k] = pi2;
-    dA[k] = 0.0;
-  }
+  // The links list the facets of each point by decreasing facet id
+  const vtkIdType numFacets = facets->GetNumberOfCells();
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.SerialBuildLinks(Nv, numFacets, facets);
 
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+  // area and angles alpha0, alpha1, alpha2 of every facet
+  std::vector<double> facetData(4 * numFacets, 0.0);
 
-  double A, alpha0, alpha1, alpha2;
+  vtkSMPTools::For(0, numFacets, [&](vtkIdType f, vtkIdType endF) {
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
 
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
-  {
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    // normalise
-    vtkMath::Normalize(e0);
-    vtkMath::Normalize(e1);
-    vtkMath::Normalize(e2);
-    // angles
-    // I get lots of acos domain errors so clamp the value to +/-1 as the
-    // normalize function can return 1.000000001 etc (I think)
-    double ac1 = vtkMath::Dot(e1, e2);
-    double ac2 = vtkMath::Dot(e2, e0);
-    double ac3 = vtkMath::Dot(e0, e1);
-    alpha0 = acos(-CLAMP_MACRO(ac1));
-    alpha1 = acos(-CLAMP_MACRO(ac2));
-    alpha2 = acos(-CLAMP_MACRO(ac3));
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
-    // UPDATE
-    dA[vert[0]] += A;
-    dA[vert[1]] += A;
-    dA[vert[2]] += A;
-    K[vert[0]] -= alpha1;
-    K[vert[1]] -= alpha2;
-    K[vert[2]] -= alpha0;
-  }
+    double A, alpha0, alpha1, alpha2;
+
+    auto iter = vtk::TakeSmartPointer(facets->NewIterator());
+    vtkIdType nv;
+    const vtkIdType* vert;
+    for (; f < endF; ++f)
+    {
+      iter->GetCellAtId(f, nv, vert);
+      if (nv < 3)
+      {
+        continue;
+      }
+      output->GetPoint(vert[0], v0);
+      output->GetPoint(vert[1], v1);
+      output->GetPoint(vert[2], v2);
+      // edges
+      e0[0] = v1[0];
+      e0[1] = v1[1];
+      e0[2] = v1[2];
+      e0[0] -= v0[0];
+      e0[1] -= v0[1];
+      e0[2] -= v0[2];
+
+      e1[0] = v2[0];
+      e1[1] = v2[1];
+      e1[2] = v2[2];
+      e1[0] -= v1[0];
+      e1[1] -= v1[1];
+      e1[2] -= v1[2];
+
+      e2[0] = v0[0];
+      e2[1] = v0[1];
+      e2[2] = v0[2];
+      e2[0] -= v2[0];
+      e2[1] -= v2[1];
+      e2[2] -= v2[2];
+
+      // normalise
+      vtkMath::Normalize(e0);
+      vtkMath::Normalize(e1);
+      vtkMath::Normalize(e2);
+      // angles
+      // I get lots of acos domain errors so clamp the value to +/-1 as the
+      // normalize function can return 1.000000001 etc (I think)
+      double ac1 = vtkMath::Dot(e1, e2);
+      double ac2 = vtkMath::Dot(e2, e0);
+      double ac3 = vtkMath::Dot(e0, e1);
+      alpha0 = acos(-CLAMP_MACRO(ac1));
+      alpha1 = acos(-CLAMP_MACRO(ac2));
+      alpha2 = acos(-CLAMP_MACRO(ac3));
+
+      // surf. area
+      A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+      facetData[4 * f] = A;
+      facetData[4 * f + 1] = alpha0;
+      facetData[4 * f + 2] = alpha1;
+      facetData[4 * f + 3] = alpha2;
+    }
+  });
 
   int numPts = output->GetNumberOfPoints();
   // put curvature in vtkArray
@@ -285,17 +639,47 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
   gaussCurvature->SetNumberOfTuples(numPts);
   double* gaussCurvatureData = gaussCurvature->GetPointer(0);
 
-  for (int v = 0; v < Nv; v++)
-  {
-    if (dA[v] > 0.0)
-    {
-      gaussCurvatureData[v] = 3.0 * K[v] / dA[v];
-    }
-    else
+  // UPDATE: gather the facets of every vertex in the order of the facets.
+  // vert[0] loses alpha1, vert[1] loses alpha2 and vert[2] loses alpha0.
+  double pi2 = 2.0 * vtkMath::Pi();
+  vtkSMPTools::For(0, Nv, [&](vtkIdType v, vtkIdType endV) {
+    auto iter = vtk::TakeSmartPointer(facets->NewIterator());
+    vtkIdType nv;
+    const vtkIdType* vert;
+    for (; v < endV; v++)
     {
-      gaussCurvatureData[v] = 0.0;
+      double K = pi2;
+      double dA = 0.0;
+      const vtkIdType* cells = links.GetCells(v);
+      for (vtkIdType i = links.GetNcells(v) - 1; i >= 0; --i)
+      {
+        const vtkIdType f = cells[i];
+        if (i < links.GetNcells(v) - 1 && f == cells[i + 1])
+        {
+          continue;
+        }
+        iter->GetCellAtId(f, nv, vert);
+        nv = std::min<vtkIdType>(nv, 3);
+        for (vtkIdType c = 0; c < nv; ++c)
+        {
+          if (vert[c] == v)
+          {
+            dA += facetData[4 * f];
+            K -= facetData[4 * f + 1 + (c + 1) % 3];
+          }
+        }
+      }
+
+      if (dA > 0.0)
+      {
+        gaussCurvatureData[v] = 3.0 * K / dA;
+      }
+      else
+      {
+        gaussCurvatureData[v] = 0.0;
+      }
     }
-  }
+  });
 
   output->GetPointData()->AddArray(gaussCurvature);
   output->GetPointData()->SetActiveScalars("Gauss_Curvature");
@@ -321,26 +705,28 @@ void vtkCurvatures::GetMaximumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_max, tmp;
 
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_max = h + sqrt(tmp);
-    }
-    else
+  vtkSMPTools::For(0, numPts, [&](vtkIdType i, vtkIdType end) {
+    double k, h, k_max, tmp;
+
+    for (; i < end; i++)
     {
-      vtkDebugMacro(<< "Maximum Curvature undefined at point: " << i);
-      // k_max can be any real number. Undefined points will be indistinguishable
-      // from points that actually have a k_max == 0
-      k_max = 0;
+      k = gauss->GetValue(i);
+      h = mean->GetValue(i);
+      tmp = h * h - k;
+      if (tmp >= 0)
+      {
+        k_max = h + sqrt(tmp);
+      }
+      else
+      {
+        // k_max can be any real number. Undefined points will be indistinguishable
+        // from points that actually have a k_max == 0
+        k_max = 0;
+      }
+      maximumCurvature->SetValue(i, k_max);
     }
-    maximumCurvature->SetComponent(i, 0, k_max);
-  }
+  });
 }
 
 void vtkCurvatures::GetMinimumCurvature(vtkPolyData* input, vtkPolyData* output)
@@ -361,26 +747,74 @@ void vtkCurvatures::GetMinimumCurvature(vtkPolyData* input, vtkPolyData* output)
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Gauss_Curvature"));
   vtkDoubleArray* mean =
     static_cast<vtkDoubleArray*>(output->GetPointData()->GetArray("Mean_Curvature"));
-  double k, h, k_min, tmp;
 
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    k = gauss->GetComponent(i, 0);
-    h = mean->GetComponent(i, 0);
-    tmp = h * h - k;
-    if (tmp >= 0)
-    {
-      k_min = h - sqrt(tmp);
-    }
-    else
+  vtkSMPTools::For(0, numPts, [&](vtkIdType i, vtkIdType end) {
+    double k, h, k_min, tmp;
+
+    for (; i < end; i++)
     {
-      vtkDebugMacro(<< "Minimum Curvature undefined at point: " << i);
-      // k_min can be any real number. Undefined points will be indistinguishable
-      // from points that actually have a k_min == 0
-      k_min = 0;
+      k = gauss->GetValue(i);
+      h = mean->GetValue(i);
+      tmp = h * h - k;
+      if (tmp >= 0)
+      {
+        k_min = h - sqrt(tmp);
+      }
+      else
+      {
+        // k_min can be any real number. Undefined points will be indistinguishable
+        // from points that actually have a k_min == 0
+        k_min = 0;
+      }
+      minimumCurvature->SetValue(i, k_min);
     }
-    minimumCurvature->SetComponent(i, 0, k_min);
+  });
+}
+
+void vtkCurvatures::GetQuadricCurvature(vtkPolyData* output)
+{
+  vtkDebugMacro("Start vtkCurvatures::GetQuadricCurvature()");
+
+  // Empty array check
+  if (output->GetNumberOfPolys() == 0 || output->GetNumberOfPoints() == 0)
+  {
+    vtkErrorMacro("No points/cells to operate on");
+    return;
   }
+
+  vtkIdType numPts = output->GetNumberOfPoints();
+
+  vtkCellArray* polys = output->GetPolys();
+  vtkStaticCellLinksTemplate<vtkIdType> links;
+  links.SerialBuildLinks(numPts, polys->GetNumberOfCells(), polys);
+
+  const vtkNew<vtkDoubleArray> maximumCurvature;
+  maximumCurvature->SetName("Maximum_Curvature");
+  maximumCurvature->SetNumberOfTuples(numPts);
+  const vtkNew<vtkDoubleArray> minimumCurvature;
+  minimumCurvature->SetName("Minimum_Curvature");
+  minimumCurvature->SetNumberOfTuples(numPts);
+  const vtkNew<vtkDoubleArray> maximumDirection;
+  maximumDirection->SetName("Maximum_Curvature_Direction");
+  maximumDirection->SetNumberOfComponents(3);
+  maximumDirection->SetNumberOfTuples(numPts);
+  const vtkNew<vtkDoubleArray> minimumDirection;
+  minimumDirection->SetName("Minimum_Curvature_Direction");
+  minimumDirection->SetNumberOfComponents(3);
+  minimumDirection->SetNumberOfTuples(numPts);
+
+  FitQuadrics fit(output, &links, this->InvertMeanCurvature != 0, maximumCurvature->GetPointer(0),
+    minimumCurvature->GetPointer(0), maximumDirection->GetPointer(0),
+    minimumDirection->GetPointer(0));
+  vtkSMPTools::For(0, numPts, fit);
+
+  output->GetPointData()->AddArray(maximumCurvature);
+  output->GetPointData()->AddArray(minimumCurvature);
+  output->GetPointData()->AddArray(maximumDirection);
+  output->GetPointData()->AddArray(minimumDirection);
+  output->GetPointData()->SetActiveScalars("Maximum_Curvature");
+
+  vtkDebugMacro("Set Values of Quadric Curvature: Done");
 }
 
 //-------------------------------------------------------
@@ -426,9 +860,13 @@ int vtkCurvatures::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->GetMinimumCurvature(input, output);
   }
+  else if (this->CurvatureType == VTK_CURVATURE_QUADRIC)
+  {
+    this->GetQuadricCurvature(output);
+  }
   else
   {
-    vtkErrorMacro("Only Gauss, Mean, Max, and Min Curvature type available");
+    vtkErrorMacro("Only Gauss, Mean, Max, Min and Quadric Curvature type available");
     return 1;
   }
 
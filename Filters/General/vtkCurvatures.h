@@ -17,7 +17,7 @@
  * @brief   compute curvatures (Gauss and mean) of a Polydata object
  *
  * vtkCurvatures takes a polydata input and computes the curvature of the
- * mesh at each point. Four possible methods of computation are available :
+ * mesh at each point. Five possible methods of computation are available :
  *
  * Gauss Curvature
  * discrete Gauss curvature (K) computation,
@@ -43,6 +43,18 @@
  * through two extrema: a minimum (\f$k_\min\f$) and a maximum (\f$k_\max\f$)
  * which occur at mutually orthogonal directions to each other.
  *
+ * Quadric Fitting
+ * At each point a quadric height field
+ * \f$z = a x^2 + b x y + c y^2 + d x + e y\f$ is fitted in the least squares
+ * sense to the neighbouring points (the one-ring, extended to the two-ring
+ * when the one-ring is too small), in a frame whose z axis is the area
+ * weighted normal of the polygons using the point. The principal curvatures
+ * \f$k_\max\f$ and \f$k_\min\f$ are the eigenvalues of the shape operator of
+ * the fitted quadric, and the principal directions are its eigenvectors
+ * mapped back to world space. This estimate is less sensitive to irregular
+ * triangulations and noise than the discrete formulas above, and it provides
+ * the principal directions.
+ *
  * NB. The sign of the Gauss curvature is a geometric invariant, it should be
  * positive when the surface looks like a sphere, negative when it looks like a
  * saddle, however the sign of the Mean curvature is not, it depends on the
@@ -50,6 +62,15 @@
  * from the surface of a sphere outwards). If a given mesh produces curvatures
  * of opposite senses then the flag InvertMeanCurvature can be set and the
  * Curvature reported by the Mean calculation will be inverted.
+ * The flag also inverts the principal curvatures of the quadric fitting.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The point-to-cell
+ * adjacency is gathered once in compressed row storage, and each point
+ * accumulates the contributions of its cells in cell order, so the results
+ * do not depend on the number of threads. Using TBB or other non-sequential
+ * type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE) may improve
+ * performance significantly.
  *
  * @par Thanks:
  * Philip Batchelor philipp.batchelor@kcl.ac.uk for creating and contributing
@@ -71,6 +92,7 @@
 #define VTK_CURVATURE_MEAN 1
 #define VTK_CURVATURE_MAXIMUM 2
 #define VTK_CURVATURE_MINIMUM 3
+#define VTK_CURVATURE_QUADRIC 4
 
 class VTKFILTERSGENERAL_EXPORT vtkCurvatures : public vtkPolyDataAlgorithm
 {
@@ -90,6 +112,13 @@ public:
    * DataArray "Gauss_Curvature"
    * VTK_CURVATURE_MEAN : Mean curvature, stored as
    * DataArray "Mean_Curvature"
+   * VTK_CURVATURE_MAXIMUM : Maximum principal curvature, stored as
+   * DataArray "Maximum_Curvature"
+   * VTK_CURVATURE_MINIMUM : Minimum principal curvature, stored as
+   * DataArray "Minimum_Curvature"
+   * VTK_CURVATURE_QUADRIC : Principal curvatures and directions of a fitted
+   * quadric, stored as DataArrays "Maximum_Curvature", "Minimum_Curvature",
+   * "Maximum_Curvature_Direction" and "Minimum_Curvature_Direction"
    */
   vtkSetMacro(CurvatureType, int);
   vtkGetMacro(CurvatureType, int);
@@ -97,6 +126,7 @@ public:
   void SetCurvatureTypeToMean() { this->SetCurvatureType(VTK_CURVATURE_MEAN); }
   void SetCurvatureTypeToMaximum() { this->SetCurvatureType(VTK_CURVATURE_MAXIMUM); }
   void SetCurvatureTypeToMinimum() { this->SetCurvatureType(VTK_CURVATURE_MINIMUM); }
+  void SetCurvatureTypeToQuadric() { this->SetCurvatureType(VTK_CURVATURE_QUADRIC); }
   //@}
 
   //@{
@@ -135,6 +165,12 @@ protected:
    */
   void GetMinimumCurvature(vtkPolyData* input, vtkPolyData* output);
 
+  /**
+   * Principal curvatures and directions of a quadric fitted to the
+   * neighbourhood of each point
+   */
+  void GetQuadricCurvature(vtkPolyData* output);
+
   // Vars
   int CurvatureType;
   vtkTypeBool InvertMeanCurvature;
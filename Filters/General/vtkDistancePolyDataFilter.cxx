@@ -16,11 +16,14 @@
 
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
 #include "vtkImplicitPolyDataDistance.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 
@@ -92,22 +95,25 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   vtkImplicitPolyDataDistance* imp = vtkImplicitPolyDataDistance::New();
   imp->SetInput(src);
 
-  // Calculate distance from points.
-  int numPts = mesh->GetNumberOfPoints();
+  // Calculate distance from points. The implicit function is thread safe
+  // with its default locator.
+  vtkIdType numPts = mesh->GetNumberOfPoints();
 
   vtkDoubleArray* pointArray = vtkDoubleArray::New();
   pointArray->SetName("Distance");
   pointArray->SetNumberOfComponents(1);
   pointArray->SetNumberOfTuples(numPts);
 
-  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
-  {
-    double pt[3];
-    mesh->GetPoint(ptId, pt);
-    double val = imp->EvaluateFunction(pt);
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    pointArray->SetValue(ptId, dist);
-  }
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ptId++)
+    {
+      double pt[3];
+      mesh->GetPoint(ptId, pt);
+      double val = imp->EvaluateFunction(pt);
+      double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
+      pointArray->SetValue(ptId, dist);
+    }
+  });
 
   mesh->GetPointData()->AddArray(pointArray);
   pointArray->Delete();
@@ -116,26 +122,30 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   // Calculate distance from cell centers.
   if (this->ComputeCellCenterDistance)
   {
-    int numCells = mesh->GetNumberOfCells();
+    vtkIdType numCells = mesh->GetNumberOfCells();
 
     vtkDoubleArray* cellArray = vtkDoubleArray::New();
     cellArray->SetName("Distance");
     cellArray->SetNumberOfComponents(1);
     cellArray->SetNumberOfTuples(numCells);
 
-    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
-    {
-      vtkCell* cell = mesh->GetCell(cellId);
-      int subId;
-      double pcoords[3], x[3], weights[VTK_MAXIMUM_NUMBER_OF_POINTS];
-
-      cell->GetParametricCenter(pcoords);
-      cell->EvaluateLocation(subId, pcoords, x, weights);
-
-      double val = imp->EvaluateFunction(x);
-      double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-      cellArray->SetValue(cellId, dist);
-    }
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkGenericCell* cell = tlCell.Local();
+      for (; cellId < endCellId; cellId++)
+      {
+        mesh->GetCell(cellId, cell);
+        int subId;
+        double pcoords[3], x[3], weights[VTK_MAXIMUM_NUMBER_OF_POINTS];
+
+        cell->GetParametricCenter(pcoords);
+        cell->EvaluateLocation(subId, pcoords, x, weights);
+
+        double val = imp->EvaluateFunction(x);
+        double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
+        cellArray->SetValue(cellId, dist);
+      }
+    });
 
     mesh->GetCellData()->AddArray(cellArray);
     cellArray->Delete();
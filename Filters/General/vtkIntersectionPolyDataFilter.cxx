@@ -15,6 +15,7 @@
 #include "vtkIntersectionPolyDataFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkCleanPolyData.h"
 #include "vtkDelaunay2D.h"
@@ -32,6 +33,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -40,8 +42,12 @@
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 //----------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -75,6 +81,32 @@ typedef struct _CellEdgeLine
 typedef std::multimap<vtkIdType, CellEdgeLineType> PointEdgeMapType;
 typedef PointEdgeMapType::iterator PointEdgeMapIteratorType;
 
+// Pair of OBB tree leaves whose bounding boxes overlap
+typedef struct _NodePair
+{
+  vtkOBBNode* Node0;
+  vtkOBBNode* Node1;
+  vtkMatrix4x4* Transform;
+} NodePairType;
+
+// Intersection between a triangle of each input
+typedef struct _TriangleIntersection
+{
+  vtkIdType CellId0;
+  vtkIdType CellId1;
+  double Pt0[3];
+  double Pt1[3];
+  double SurfaceId[2];
+} TriangleIntersectionType;
+
+// Intersection line touching a new cell of a split cell
+typedef struct _NewCell
+{
+  int SubCellId;
+  int InterPtCount;
+  int InterPts[3];
+} NewCellType;
+
 //----------------------------------------------------------------------------
 // Private implementation to hide STL.
 //----------------------------------------------------------------------------
@@ -84,17 +116,48 @@ public:
   Impl();
   virtual ~Impl();
 
-  // Finds all triangle triangle intersections between two input OOBTrees
-  static int FindTriangleIntersections(
+  // State of a cell being split. Each cell is split with its own context so
+  // that the cells can be split in parallel. The changes to the boundary
+  // points and to the new cell ids are applied afterwards in cell order.
+  struct SplitContext
+  {
+    // Bounds of the input surface
+    const double* Bounds;
+
+    // vtkPolyData to hold current splitting cell. Used to double check area
+    // of small area cells
+    vtkSmartPointer<vtkPolyData> SplittingPD;
+    int TransformSign;
+
+    // Cells created by splitting the cell
+    vtkSmartPointer<vtkCellArray> SplitCells;
+    std::vector<std::pair<vtkIdType, int> > BoundaryPoints;
+    std::vector<NewCellType> NewCells;
+    std::vector<std::string> Warnings;
+  };
+
+  // Collects the pairs of leaves of the two input OOBTrees whose boxes
+  // intersect
+  static int FindNodePairs(
     vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
 
+  // Finds all triangle triangle intersections between the collected leaves
+  void FindTriangleIntersections();
+
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Finds the triangle triangle intersections between two leaves
+  void IntersectNodes(
+    const NodePairType& nodePair, std::vector<TriangleIntersectionType>& intersections);
+
+  // Adds a triangle triangle intersection to the intersection lines
+  void AddTriangleIntersection(const TriangleIntersectionType& intersection);
+
   // Split cells into polygons created by intersection lines
   vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
-    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
+    IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, SplitContext* context);
 
   // Function to add point to check edge list for remeshing step
   int AddToPointEdgeMap(int index, vtkIdType ptId, double x[3], vtkPolyData* mesh, vtkIdType cellId,
@@ -105,22 +168,23 @@ protected:
     int inputIndex, int interPtCount, int interPts[3], vtkPolyData* interLines, int numCurrCells);
 
   // Function inside SplitCell to get the smaller triangle loops
-  int GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops);
+  int GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops, SplitContext* context);
 
   // Get individual polygon loop of splitting cell
   int GetSingleLoop(vtkPolyData* pd, simPolygon* loop, vtkIdType nextCell,
-    std::vector<bool>& interPtBool, std::vector<bool>& lineBool);
+    std::vector<bool>& interPtBool, std::vector<bool>& lineBool, SplitContext* context);
 
   // Follow a loop orientation to iterate around a split polygon
   int FollowLoopOrientation(vtkPolyData* pd, simPolygon* loop, vtkIdType* nextCell,
-    vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells);
+    vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells, SplitContext* context);
 
   // Set the loop orientation based on CW CCW geometric test
   void SetLoopOrientation(vtkPolyData* pd, simPolygon* loop, vtkIdType* nextCell, vtkIdType nextPt,
-    vtkIdType prevPt, vtkIdList* pointCells);
+    vtkIdType prevPt, vtkIdList* pointCells, SplitContext* context);
 
   // Get the loop orientation is already given
-  int GetLoopOrientation(vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2);
+  int GetLoopOrientation(vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2,
+    SplitContext* context);
 
   // Orient the triangle based on the transform for remeshing
   void Orient(
@@ -137,8 +201,16 @@ public:
   vtkPolyData* Mesh[2];
   vtkOBBTree* OBBTree1;
 
-  // Stores the intersection lines.
+  // Point ids of the triangles of each input, -1 for the other cells
+  std::vector<vtkIdType> TrianglePoints[2];
+
+  // Pairs of leaves to check for triangle intersections
+  std::vector<NodePairType> NodePairs;
+
+  // Stores the intersection lines, and their end points to check for
+  // duplicate lines.
   vtkCellArray* IntersectionLines;
+  std::set<std::pair<vtkIdType, vtkIdType> > IntersectionLinePoints;
 
   vtkIdTypeArray* SurfaceId;
   vtkIdTypeArray* NewCellIds[2];
@@ -169,10 +241,6 @@ public:
   // cell, and the ID of the line.
   PointEdgeMapType* PointEdgeMap[2];
 
-  // vtkPolyData to hold current splitting cell. Used to double check area
-  // of small area cells
-  vtkPolyData* SplittingPD;
-  int TransformSign;
   double Tolerance;
   double RelativeSubtriangleArea;
 
@@ -200,8 +268,6 @@ vtkIntersectionPolyDataFilter::Impl::Impl()
     this->PointEdgeMap[i] = new PointEdgeMapType();
   }
   this->PointMapper = new IntersectionMapType();
-  this->SplittingPD = vtkPolyData::New();
-  this->TransformSign = 0;
   this->Tolerance = 1e-6;
   this->RelativeSubtriangleArea = 1e-4;
 }
@@ -216,26 +282,73 @@ vtkIntersectionPolyDataFilter::Impl::~Impl()
     delete this->PointEdgeMap[i];
   }
   delete this->PointMapper;
-  this->SplittingPD->Delete();
 }
 
 //----------------------------------------------------------------------------
-int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
+int vtkIntersectionPolyDataFilter::Impl ::FindNodePairs(
   vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg)
 {
   vtkIntersectionPolyDataFilter::Impl* info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
+  // The triangles of the leaves are intersected afterwards, in parallel
+  NodePairType nodePair = { node0, node1, transform };
+  info->NodePairs.push_back(nodePair);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections()
+{
+  // Gather the point ids of the triangles first. Depending on its storage,
+  // a cell array may not be read safely from several threads.
+  for (int i = 0; i < 2; i++)
+  {
+    vtkPolyData* mesh = this->Mesh[i];
+    vtkIdType numCells = mesh->GetNumberOfCells();
+    this->TrianglePoints[i].assign(3 * numCells, -1);
+    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
+    {
+      if (mesh->GetCellType(cellId) == VTK_TRIANGLE)
+      {
+        vtkIdType npts;
+        const vtkIdType* triPtIds;
+        mesh->GetCellPoints(cellId, npts, triPtIds);
+        std::copy(triPtIds, triPtIds + 3, this->TrianglePoints[i].begin() + 3 * cellId);
+      }
+    }
+  }
+
+  // Intersect the triangles of each pair of leaves in parallel. The
+  // intersections are then added in the order of the pairs, so that the
+  // intersection lines are the same whatever the number of threads.
+  vtkIdType numPairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector<std::vector<TriangleIntersectionType> > intersections(numPairs);
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType beginPair, vtkIdType endPair) {
+    for (vtkIdType pairId = beginPair; pairId < endPair; pairId++)
+    {
+      this->IntersectNodes(this->NodePairs[pairId], intersections[pairId]);
+    }
+  });
+
+  for (vtkIdType pairId = 0; pairId < numPairs; pairId++)
+  {
+    for (const TriangleIntersectionType& intersection : intersections[pairId])
+    {
+      this->AddTriangleIntersection(intersection);
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::IntersectNodes(
+  const NodePairType& nodePair, std::vector<TriangleIntersectionType>& intersections)
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkOBBNode* node0 = nodePair.Node0;
+  vtkOBBNode* node1 = nodePair.Node1;
 
   // The number of cells in OBBTree
   int numCells0 = node0->Cells->GetNumberOfIds();
@@ -243,223 +356,230 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
   for (vtkIdType id0 = 0; id0 < numCells0; id0++)
   {
     vtkIdType cellId0 = node0->Cells->GetId(id0);
-    int type0 = mesh0->GetCellType(cellId0);
+    const vtkIdType* triPtIds0 = &this->TrianglePoints[0][3 * cellId0];
 
     // Make sure the cell is a triangle
-    if (type0 == VTK_TRIANGLE)
+    if (triPtIds0[0] >= 0)
     {
-      vtkIdType npts0;
-      const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
       double triPts0[3][3];
-      for (vtkIdType id = 0; id < npts0; id++)
+      for (vtkIdType id = 0; id < 3; id++)
       {
         mesh0->GetPoint(triPtIds0[id], triPts0[id]);
       }
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+      if (this->OBBTree1->TriangleIntersectsNode(
+            node1, triPts0[0], triPts0[1], triPts0[2], nodePair.Transform))
       {
         int numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
         {
           vtkIdType cellId1 = node1->Cells->GetId(id1);
-          int type1 = mesh1->GetCellType(cellId1);
-          if (type1 == VTK_TRIANGLE)
+          const vtkIdType* triPtIds1 = &this->TrianglePoints[1][3 * cellId1];
+          if (triPtIds1[0] >= 0)
           {
-            // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1;
-            const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
-
+            // See if the two cells actually intersect. If they do, keep
+            // the intersection to add it to the maps and intersection lines.
             double triPts1[3][3];
-            for (vtkIdType id = 0; id < npts1; id++)
+            for (vtkIdType id = 0; id < 3; id++)
             {
               mesh1->GetPoint(triPtIds1[id], triPts1[id]);
             }
 
+            TriangleIntersectionType intersection;
             int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
             int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar,
+              intersection.Pt0, intersection.Pt1, intersection.SurfaceId, this->Tolerance);
 
-            if (coplanar)
+            // Coplanar triangle intersection is not handled.
+            // This intersection will not be included in the output. TODO
+            if (intersects && !coplanar)
             {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
+              intersection.CellId0 = cellId0;
+              intersection.CellId1 = cellId1;
+              intersections.push_back(intersection);
             }
+          }
+        }
+      }
+    }
+  }
+}
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+//----------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddTriangleIntersection(
+  const TriangleIntersectionType& intersection)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+  vtkIdType cellId0 = intersection.CellId0;
+  vtkIdType cellId1 = intersection.CellId1;
+  const vtkIdType* triPtIds0 = &this->TrianglePoints[0][3 * cellId0];
+  const vtkIdType* triPtIds1 = &this->TrianglePoints[1][3 * cellId1];
+  double outpt0[3], outpt1[3];
+  double surfaceid[2] = { intersection.SurfaceId[0], intersection.SurfaceId[1] };
+  std::copy(intersection.Pt0, intersection.Pt0 + 3, outpt0);
+  std::copy(intersection.Pt1, intersection.Pt1 + 3, outpt1);
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+  // Add point and cell to edge, line, and surface maps!
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    if (this->IntersectionLinePoints.count(
+          std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1))) > 0)
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+    this->IntersectionLinePoints.insert(
+      std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1)));
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -489,6 +609,10 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
   //
   vtkSmartPointer<vtkPolyData> splitLines = vtkSmartPointer<vtkPolyData>::New();
   splitLines->DeepCopy(intersectionLines);
+  // The lines are read by the cells split in parallel, so store them as
+  // vtkIdType and build their links once.
+  splitLines->GetLines()->ConvertToDefaultStorage();
+  splitLines->BuildLinks();
 
   vtkPointData* inPD = input->GetPointData();
   vtkPointData* outPD = output->GetPointData();
@@ -531,6 +655,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
   if (input->GetPolys()->GetNumberOfCells() > 0)
   {
     vtkCellArray* cells = input->GetPolys();
+    vtkIdType numPolys = cells->GetNumberOfCells();
     vtkIdType newId = output->GetNumberOfCells();
 
     vtkSmartPointer<vtkCellArray> newPolys = vtkSmartPointer<vtkCellArray>::New();
@@ -538,10 +663,74 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
     newPolys->AllocateEstimate(cells->GetNumberOfCells(), 3);
     output->SetPolys(newPolys);
 
-    vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+    // Mark the cells that need a split. If the cell is in the intersection
+    // map, split. If not, one of its edges may be split by an intersection
+    // line that splits a neighbor cell. Mark the cell as needing a split if
+    // this is the case.
+    std::vector<char> needsSplit(numPolys, 0);
+    vtkSMPTools::For(0, numPolys, [&](vtkIdType beginCell, vtkIdType endCell) {
+      auto cellIter = vtk::TakeSmartPointer(cells->NewIterator());
+      vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+      for (vtkIdType cellId = beginCell; cellId < endCell; cellId++)
+      {
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cellIter->GetCellAtId(cellId, npts, pts);
+        if (npts != 3)
+        {
+          continue;
+        }
+
+        bool split = intersectionMap->find(cellId) != intersectionMap->end();
+        for (vtkIdType ptId = 0; ptId < npts && !split; ptId++)
+        {
+          input->GetCellEdgeNeighbors(cellId, pts[ptId], pts[(ptId + 1) % npts], edgeNeighbors);
+          for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
+          {
+            if (intersectionMap->find(edgeNeighbors->GetId(nbr)) != intersectionMap->end())
+            {
+              split = true;
+            }
+          }
+        }
+        needsSplit[cellId] = split;
+      }
+    });
+
+    // Split the marked cells in parallel
+    std::vector<vtkIdType> splitCellIds;
+    for (vtkIdType cellId = 0; cellId < numPolys; cellId++)
+    {
+      if (needsSplit[cellId])
+      {
+        splitCellIds.push_back(cellId);
+      }
+    }
+    double bounds[6];
+    input->GetBounds(bounds);
+    vtkIdType numSplitCells = static_cast<vtkIdType>(splitCellIds.size());
+    std::vector<SplitContext> contexts(numSplitCells);
+    vtkSMPTools::For(0, numSplitCells, 1, [&](vtkIdType beginSplit, vtkIdType endSplit) {
+      auto cellIter = vtk::TakeSmartPointer(cells->NewIterator());
+      for (vtkIdType splitId = beginSplit; splitId < endSplit; splitId++)
+      {
+        vtkIdType cellId = splitCellIds[splitId];
+        vtkIdType npts;
+        const vtkIdType* pts;
+        cellIter->GetCellAtId(cellId, npts, pts);
+        SplitContext& context = contexts[splitId];
+        context.Bounds = bounds;
+        context.SplittingPD = vtkSmartPointer<vtkPolyData>::New();
+        context.TransformSign = 0;
+        context.SplitCells.TakeReference(
+          this->SplitCell(input, cellId, pts, intersectionMap, splitLines, inputIndex, &context));
+      }
+    });
+
+    // Add the cells in order
     vtkIdType nptsX = 0;
     const vtkIdType* pts = nullptr;
-    vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
+    vtkIdType splitId = 0;
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
       if (nptsX != 3)
@@ -551,36 +740,8 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         continue;
       }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX + 1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find(cellIdX) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-      {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-        {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if (intersectionMap->find(nbrId) != intersectionMap->end())
-          {
-            needsSplit = true;
-          }
-        } // for (vtkIdType nbr = 0; ...
-      }   // for (vtkIdType pt = 0; ...
-
       // Splitting occurs here
-      if (!needsSplit)
+      if (!needsSplit[cellIdX])
       {
         // Just insert the cell and copy the cell data
         newId = newPolys->InsertNextCell(3, pts);
@@ -588,17 +749,31 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
       }
       else
       {
-        // Total number of cells so that we know the id numbers of the new
-        // cells added and we can add it to the new cell id mapping
-        int numCurrCells = newPolys->GetNumberOfCells();
-        vtkCellArray* splitCells = this->SplitCell(
-          input, cellIdX, pts, intersectionMap, splitLines, inputIndex, numCurrCells);
+        SplitContext& context = contexts[splitId++];
+        for (const std::string& warning : context.Warnings)
+        {
+          vtkWarningWithObjectMacro(this->ParentFilter, << warning);
+        }
+        vtkCellArray* splitCells = context.SplitCells;
         if (splitCells == nullptr)
         {
           vtkDebugWithObjectMacro(this->ParentFilter, << "Error in splitting cell!");
           return 0;
         }
 
+        // Total number of cells so that we know the id numbers of the new
+        // cells added and we can add it to the new cell id mapping
+        int numCurrCells = newPolys->GetNumberOfCells();
+        for (const std::pair<vtkIdType, int>& boundaryPoint : context.BoundaryPoints)
+        {
+          this->BoundaryPoints[inputIndex]->InsertValue(boundaryPoint.first, boundaryPoint.second);
+        }
+        for (NewCellType& newCell : context.NewCells)
+        {
+          this->AddToNewCellMap(inputIndex, newCell.InterPtCount, newCell.InterPts, splitLines,
+            numCurrCells + newCell.SubCellId);
+        }
+
         double pt0[3], pt1[3], pt2[3], normal[3];
         points->GetPoint(pts[0], pt0);
         points->GetPoint(pts[1], pt1);
@@ -636,7 +811,6 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
           outCD->CopyData(inCD, cellIdX, newId); // Duplicate cell data
         }
-        splitCells->Delete();
       }
     } // for (cells->InitTraversal(); ...
   }   // if inputGetPolys()->GetNumberOfCells() > 1 ...
@@ -646,7 +820,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
 
 vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input, vtkIdType cellId,
   const vtkIdType* cellPts, IntersectionMapType* map, vtkPolyData* interLines, int inputIndex,
-  int numCurrCells)
+  SplitContext* context)
 {
   // Copy down the SurfaceID array that tells which surface the point belongs
   // to
@@ -663,14 +837,14 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
   vtkSmartPointer<vtkPointLocator> merger = vtkSmartPointer<vtkPointLocator>::New();
   merger->SetTolerance(this->Tolerance);
-  merger->InitPointInsertion(points, input->GetBounds());
+  merger->InitPointInsertion(points, context->Bounds);
 
   double xyz[3];
   for (int i = 0; i < 3; i++)
   {
     if (cellPts[i] >= input->GetNumberOfPoints())
     {
-      vtkGenericWarningMacro(<< "invalid point read 1");
+      context->Warnings.push_back("invalid point read 1");
     }
     input->GetPoint(cellPts[i], xyz);
     merger->InsertNextPoint(xyz);
@@ -714,7 +888,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         interLines->GetPoint(linePtIds[i], xyz);
         if (linePtIds[i] >= interLines->GetNumberOfPoints())
         {
-          vtkGenericWarningMacro(<< "invalid point read 2");
+          context->Warnings.push_back("invalid point read 2");
         }
         // Check to see if point is unique
         int unique = merger->InsertUniquePoint(xyz, ptIdMap[linePtIds[i]]);
@@ -774,11 +948,11 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     double edgePt0[3], edgePt1[3];
     if (edgePtId0 >= input->GetNumberOfPoints())
     {
-      vtkGenericWarningMacro(<< "invalid point read 3");
+      context->Warnings.push_back("invalid point read 3");
     }
     if (edgePtId1 >= input->GetNumberOfPoints())
     {
-      vtkGenericWarningMacro(<< "invalid point read 4");
+      context->Warnings.push_back("invalid point read 4");
     }
     input->GetPoint(edgePtId0, edgePt0);
     input->GetPoint(edgePtId1, edgePt1);
@@ -801,7 +975,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         {
           if (linePtIds[k] >= interLines->GetNumberOfPoints())
           {
-            vtkGenericWarningMacro(<< "invalid point read 5");
+            context->Warnings.push_back("invalid point read 5");
           }
           interLines->GetPoint(linePtIds[k], xyz);
           ptIterLower = this->PointMapper->lower_bound(linePtIds[k]);
@@ -929,15 +1103,15 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
     // Setting the boundary points
     if (ptId > 2)
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(reverseIdMap[ptId], 1);
+      context->BoundaryPoints.push_back(std::make_pair(reverseIdMap[ptId], 1));
     }
     else if (CellPointOnInterLine[ptId])
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 1);
+      context->BoundaryPoints.push_back(std::make_pair(cellPts[ptId], 1));
     }
     else
     {
-      this->BoundaryPoints[inputIndex]->InsertValue(cellPts[ptId], 0);
+      context->BoundaryPoints.push_back(std::make_pair(cellPts[ptId], 0));
     }
   }
   // Sort the edgePtIdList according to the angle list. The starting
@@ -974,9 +1148,10 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   // Set up a transform that will rotate the points to the
   // XY-plane (normal aligned with z-axis).
   vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
-  this->TransformSign = this->GetTransform(transform, points);
+  context->TransformSign = this->GetTransform(transform, points);
 
   vtkCellArray* splitCells = vtkCellArray::New();
+  int subCellId = 0;
   vtkSmartPointer<vtkPolyData> interpd = vtkSmartPointer<vtkPolyData>::New();
   interpd->SetPoints(points);
   interpd->SetLines(interceptlines);
@@ -985,7 +1160,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   vtkSmartPointer<vtkPolyData> fullpd = vtkSmartPointer<vtkPolyData>::New();
   fullpd->SetPoints(points);
   fullpd->SetLines(lines);
-  SplittingPD->DeepCopy(fullpd);
+  context->SplittingPD->DeepCopy(fullpd);
 
   vtkSmartPointer<vtkTransformPolyDataFilter> transformer =
     vtkSmartPointer<vtkTransformPolyDataFilter>::New();
@@ -1001,7 +1176,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
   {
     // Get polygon loops of intersected triangle
     std::vector<simPolygon> loops;
-    if (this->GetLoops(transformedpd, &loops) != 1)
+    if (this->GetLoops(transformedpd, &loops, context) != 1)
     {
       splitCells->Delete();
       splitCells = nullptr;
@@ -1120,14 +1295,13 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       // Renumber the point IDs.
       vtkIdType npts;
       const vtkIdType* ptIds;
-      interLines->BuildLinks();
       for (polys->InitTraversal(); polys->GetNextCell(npts, ptIds);)
       {
         if (pointMapper[ptIds[0]] >= points->GetNumberOfPoints() ||
           pointMapper[ptIds[1]] >= points->GetNumberOfPoints() ||
           pointMapper[ptIds[2]] >= points->GetNumberOfPoints())
         {
-          vtkGenericWarningMacro(<< "Invalid point ID!!!");
+          context->Warnings.push_back("Invalid point ID!!!");
         }
 
         splitCells->InsertNextCell(npts);
@@ -1155,9 +1329,13 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
         if (interPtCount >= 2) // If there are more than two, inter line
         {
           // Add the information to new cell mapping on intersection lines
-          this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+          NewCellType newCell;
+          newCell.SubCellId = subCellId;
+          newCell.InterPtCount = interPtCount;
+          std::copy(interPts, interPts + interPtCount, newCell.InterPts);
+          context->NewCells.push_back(newCell);
         }
-        numCurrCells++;
+        subCellId++;
       }
       delete[] pointMapper;
     }
@@ -1187,7 +1365,7 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       if (ptIds[0] >= points->GetNumberOfPoints() || ptIds[1] >= points->GetNumberOfPoints() ||
         ptIds[2] >= points->GetNumberOfPoints())
       {
-        vtkGenericWarningMacro(<< "Invalid point ID!!!");
+        context->Warnings.push_back("Invalid point ID!!!");
       }
 
       splitCells->InsertNextCell(npts);
@@ -1213,9 +1391,13 @@ vtkCellArray* vtkIntersectionPolyDataFilter::Impl ::SplitCell(vtkPolyData* input
       }
       if (interPtCount >= 2)
       {
-        this->AddToNewCellMap(inputIndex, interPtCount, interPts, interLines, numCurrCells);
+        NewCellType newCell;
+        newCell.SubCellId = subCellId;
+        newCell.InterPtCount = interPtCount;
+        std::copy(interPts, interPts + interPtCount, newCell.InterPts);
+        context->NewCells.push_back(newCell);
       }
-      numCurrCells++;
+      subCellId++;
     }
   }
 
@@ -1328,7 +1510,8 @@ void vtkIntersectionPolyDataFilter::Impl::AddToNewCellMap(
   delete[] cellIds;
 }
 
-int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<simPolygon>* loops)
+int vtkIntersectionPolyDataFilter::Impl ::GetLoops(
+  vtkPolyData* pd, std::vector<simPolygon>* loops, SplitContext* context)
 {
   vtkSmartPointer<vtkIdList> pointCells = vtkSmartPointer<vtkIdList>::New();
   vtkSmartPointer<vtkIdList> cellPoints = vtkSmartPointer<vtkIdList>::New();
@@ -1359,7 +1542,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
       lineBool[nextCell] = true;
 
       // Get one loop for untouched point
-      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool) != 1)
+      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool, context) != 1)
       {
         return 0;
       }
@@ -1383,7 +1566,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
       nextCell = lineId;
 
       // Get single loop if the line is still untouched
-      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool) != 1)
+      if (this->GetSingleLoop(pd, &interloop, nextCell, ptBool, lineBool, context) != 1)
       {
         return 0;
       }
@@ -1398,7 +1581,8 @@ int vtkIntersectionPolyDataFilter::Impl ::GetLoops(vtkPolyData* pd, std::vector<
 //----------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType nextCell, std::vector<bool>& interPtBool, std::vector<bool>& lineBool)
+  vtkIdType nextCell, std::vector<bool>& interPtBool, std::vector<bool>& lineBool,
+  SplitContext* context)
 {
   int intertype = 0;
   vtkSmartPointer<vtkIdList> pointCells = vtkSmartPointer<vtkIdList>::New();
@@ -1440,14 +1624,15 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
       // set the orientation of the loop (i.e. CW or CCW)
       if (intertype == 0)
       {
-        this->SetLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells);
+        this->SetLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells, context);
         intertype = 1;
       }
       // This is not the first intersection. Follow line that continues along
       // the set loop orientation
       else
       {
-        if (this->FollowLoopOrientation(pd, loop, &nextCell, nextPt, prevPt, pointCells) != 1)
+        if (this->FollowLoopOrientation(
+              pd, loop, &nextCell, nextPt, prevPt, pointCells, context) != 1)
         {
           return 0;
         }
@@ -1518,7 +1703,7 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
       prevPt = cellPoints->GetId(0);
     }
 
-    loop->orientation = this->GetLoopOrientation(pd, nextCell, prevPt, nextPt);
+    loop->orientation = this->GetLoopOrientation(pd, nextCell, prevPt, nextPt, context);
   }
   return 1;
 }
@@ -1526,7 +1711,8 @@ int vtkIntersectionPolyDataFilter::Impl ::GetSingleLoop(vtkPolyData* pd, simPoly
 //----------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells)
+  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells,
+  SplitContext* context)
 {
   // Follow the orientation of this loop
   int foundcell = 0;
@@ -1538,7 +1724,7 @@ int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd,
     if (*nextCell != cellId)
     {
       // Get orientation for newly selected line
-      int neworient = this->GetLoopOrientation(pd, cellId, prevPt, nextPt);
+      int neworient = this->GetLoopOrientation(pd, cellId, prevPt, nextPt, context);
 
       // If the orientation of the newly selected line is correct, check
       // the angle of this it will make with the previous line
@@ -1590,7 +1776,7 @@ int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd,
   }
   if (foundcell == 0)
   {
-    vtkWarningWithObjectMacro(this->ParentFilter, << "No cell with correct orientation found");
+    context->Warnings.push_back("No cell with correct orientation found");
     return 0;
   }
 
@@ -1605,7 +1791,8 @@ int vtkIntersectionPolyDataFilter::Impl ::FollowLoopOrientation(vtkPolyData* pd,
 //---------------------------------------------------------------------------
 
 void vtkIntersectionPolyDataFilter::Impl ::SetLoopOrientation(vtkPolyData* pd, simPolygon* loop,
-  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells)
+  vtkIdType* nextCell, vtkIdType nextPt, vtkIdType prevPt, vtkIdList* pointCells,
+  SplitContext* context)
 {
   // Set the orientation of this loop!
   double mincell = 0;
@@ -1663,13 +1850,13 @@ void vtkIntersectionPolyDataFilter::Impl ::SetLoopOrientation(vtkPolyData* pd, s
   // Set the next line as the line that makes the minimum angle with the
   // previous cell and set the orientation of the loop
   *nextCell = mincell;
-  loop->orientation = this->GetLoopOrientation(pd, *nextCell, prevPt, nextPt);
+  loop->orientation = this->GetLoopOrientation(pd, *nextCell, prevPt, nextPt, context);
 }
 
 //---------------------------------------------------------------------------
 
 int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
-  vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2)
+  vtkPolyData* pd, vtkIdType cell, vtkIdType ptId1, vtkIdType ptId2, SplitContext* context)
 {
   // Calculate the actual orientation of this loop, by calculating the signed
   // area of the triangle made by the three points
@@ -1709,9 +1896,9 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
     vtkSmartPointer<vtkPoints> testPoints = vtkSmartPointer<vtkPoints>::New();
     vtkSmartPointer<vtkPolyData> testPD = vtkSmartPointer<vtkPolyData>::New();
     vtkSmartPointer<vtkCellArray> testCells = vtkSmartPointer<vtkCellArray>::New();
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId1));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId2));
-    testPoints->InsertNextPoint(this->SplittingPD->GetPoint(ptId3));
+    testPoints->InsertNextPoint(context->SplittingPD->GetPoint(ptId1));
+    testPoints->InsertNextPoint(context->SplittingPD->GetPoint(ptId2));
+    testPoints->InsertNextPoint(context->SplittingPD->GetPoint(ptId3));
     for (int i = 0; i < 3; i++)
     {
       testCells->InsertNextCell(2);
@@ -1724,13 +1911,13 @@ int vtkIntersectionPolyDataFilter::Impl::GetLoopOrientation(
 
     vtkSmartPointer<vtkTransform> newTransform = vtkSmartPointer<vtkTransform>::New();
     int sign = this->GetTransform(newTransform, testPoints);
-    if (sign != this->TransformSign)
+    if (sign != context->TransformSign)
     {
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId2));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(0, context->SplittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(1, context->SplittingPD->GetPoint(ptId1));
       this->GetTransform(newTransform, testPoints);
-      testPoints->SetPoint(0, this->SplittingPD->GetPoint(ptId1));
-      testPoints->SetPoint(1, this->SplittingPD->GetPoint(ptId2));
+      testPoints->SetPoint(0, context->SplittingPD->GetPoint(ptId1));
+      testPoints->SetPoint(1, context->SplittingPD->GetPoint(ptId2));
     }
 
     vtkSmartPointer<vtkTransformPolyDataFilter> newTransformer =
@@ -2365,7 +2552,8 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
 
   // This performs the triangle intersection search
   obbTree0->IntersectWithOBBTree(
-    obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+    obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindNodePairs, impl);
+  impl->FindTriangleIntersections();
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
@@ -58,6 +58,15 @@
  *
  * @warning This filter is not designed to perform 2D boolean operations,
  * and in fact relies on the inputs having no co-planar, overlapping cells.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The triangles of the
+ * overlapping leaves of the two OBB trees are intersected in parallel, and
+ * the cells crossed by the intersection lines are split in parallel. The
+ * results are merged in a fixed order, so the outputs do not depend on the
+ * number of threads. Using TBB or other non-sequential type (set in the CMake
+ * variable VTK_SMP_IMPLEMENTATION_TYPE) may improve performance
+ * significantly.
  */
 
 #ifndef vtkIntersectionPolyDataFilter_h
@@ -19,10 +19,14 @@
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -77,8 +81,6 @@ vtkOBBTree::vtkOBBTree()
   this->Automatic = 1;
   this->Tolerance = 0.01;
   this->Tree = nullptr;
-  this->PointsList = nullptr;
-  this->InsertedPoints = nullptr;
   this->OBBCount = this->Level = 0;
 }
 
@@ -227,231 +229,671 @@ void vtkOBBTree::ComputeOBB(
   }
 }
 
-// a method to compute the OBB of a dataset without having to go through the
-// Execute method; It does set
-void vtkOBBTree::ComputeOBB(
-  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+namespace
 {
-  vtkIdType numPts, numCells, i;
-  vtkIdList* cellList;
-  vtkDataSet* origDataSet;
+// Nodes with at least this many cells compute their moments, extents and
+// split with vtkSMPTools while the top of the tree is built serially.
+const vtkIdType vtkOBBTreeParallelThreshold = 10000;
 
-  vtkDebugMacro(<< "Computing OBB");
+// Subtrees with fewer cells are not worth building as a separate task.
+const vtkIdType vtkOBBTreeTaskThreshold = 1000;
 
-  if (input == nullptr || (numPts = input->GetNumberOfPoints()) < 1 ||
-    (input->GetNumberOfCells()) < 1)
+// Area-weighted first and second order moments of the triangles of a set of
+// cells. Only the upper triangle of the second order moments is accumulated.
+struct OBBMoments
+{
+  double Mass;
+  double Mean[3];
+  double A[3][3];
+
+  OBBMoments()
+    : Mass(0.0)
   {
-    vtkErrorMacro(<< "Can't compute OBB - no data available!");
-    return;
+    for (int i = 0; i < 3; i++)
+    {
+      this->Mean[i] = 0.0;
+      this->A[i][0] = this->A[i][1] = this->A[i][2] = 0.0;
+    }
   }
-  numCells = input->GetNumberOfCells();
 
-  // save previous value of DataSet and reset after calling ComputeOBB because
-  // computeOBB used this->DataSet internally
-  origDataSet = this->DataSet;
-  this->DataSet = input;
+  void Add(const OBBMoments& m)
+  {
+    this->Mass += m.Mass;
+    for (int i = 0; i < 3; i++)
+    {
+      this->Mean[i] += m.Mean[i];
+      for (int j = i; j < 3; j++)
+      {
+        this->A[i][j] += m.A[i][j];
+      }
+    }
+  }
+};
+
+// Extent of a set of points along three orthonormal axes through a center.
+struct OBBExtents
+{
+  double TMin[3];
+  double TMax[3];
 
-  // these are other member variables that ComputeOBB requires
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
+  OBBExtents()
   {
-    this->InsertedPoints[i] = 0;
+    this->TMin[0] = this->TMin[1] = this->TMin[2] = VTK_DOUBLE_MAX;
+    this->TMax[0] = this->TMax[1] = this->TMax[2] = -VTK_DOUBLE_MAX;
   }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
-  cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
-  for (i = 0; i < numCells; i++)
+  void Add(const double x[3], const double center[3], const double axes[3][3])
   {
-    cellList->InsertId(i, i);
+    const double d[3] = { x[0] - center[0], x[1] - center[1], x[2] - center[2] };
+    for (int i = 0; i < 3; i++)
+    {
+      const double t = vtkMath::Dot(d, axes[i]);
+      this->TMin[i] = (t < this->TMin[i] ? t : this->TMin[i]);
+      this->TMax[i] = (t > this->TMax[i] ? t : this->TMax[i]);
+    }
+  }
+
+  void Add(const OBBExtents& e)
+  {
+    for (int i = 0; i < 3; i++)
+    {
+      this->TMin[i] = (e.TMin[i] < this->TMin[i] ? e.TMin[i] : this->TMin[i]);
+      this->TMax[i] = (e.TMax[i] > this->TMax[i] ? e.TMax[i] : this->TMax[i]);
+    }
   }
+};
+
+// Accumulate the moments of the triangles of a cell. Only the thread safe
+// dataset API is used.
+void AddCellMoments(vtkDataSet* ds, vtkIdType cellId, vtkIdList* cellPts, OBBMoments& m)
+{
+  const int type = ds->GetCellType(cellId);
+  ds->GetCellPoints(cellId, cellPts);
+  const vtkIdType numPts = cellPts->GetNumberOfIds();
+  const vtkIdType* ptIds = cellPts->GetPointer(0);
+  vtkIdType pId, qId, rId;
+  double p[3], q[3], r[3], dp0[3], dp1[3], c[3], xp[3], tri_mass;
+
+  for (vtkIdType j = 0; j < numPts - 2; j++)
+  {
+    vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
+    if (pId < 0)
+    {
+      continue;
+    }
+    ds->GetPoint(pId, p);
+    ds->GetPoint(qId, q);
+    ds->GetPoint(rId, r);
+    // p, q, and r are the oriented triangle points.
+    // Compute the components of the moment of inertia tensor.
+    for (int k = 0; k < 3; k++)
+    {
+      // two edge vectors
+      dp0[k] = q[k] - p[k];
+      dp1[k] = r[k] - p[k];
+      // centroid
+      c[k] = (p[k] + q[k] + r[k]) / 3;
+    }
+    vtkMath::Cross(dp0, dp1, xp);
+    tri_mass = 0.5 * vtkMath::Norm(xp);
+    m.Mass += tri_mass;
+    for (int k = 0; k < 3; k++)
+    {
+      m.Mean[k] += tri_mass * c[k];
+    }
 
-  this->ComputeOBB(cellList, corner, max, mid, min, size);
+    // on-diagonal terms
+    m.A[0][0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
+    m.A[1][1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
+    m.A[2][2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
 
-  this->DataSet = origDataSet;
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-  cellList->Delete();
+    // off-diagonal terms
+    m.A[0][1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
+    m.A[0][2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
+    m.A[1][2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
+  }
 }
 
-// Compute an OBB from the list of cells given. Return the corner point
-// and the three axes defining the orientation of the OBB. Also return
-// a sorted list of relative "sizes" of axes for comparison purposes.
-void vtkOBBTree::ComputeOBB(
-  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+// Compute the mean and the principal axes (unit eigenvectors of the
+// covariance matrix, sorted by decreasing eigenvalue) from the moments.
+void ComputeAxes(const OBBMoments& m, double mean[3], double axes[3][3], double size[3])
 {
-  vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
-  int k, type;
-  vtkIdType numPts = 0;
-  const vtkIdType* ptIds = nullptr;
-  double p[3], q[3], r[3], mean[3], xp[3], *v[3], v0[3], v1[3], v2[3];
-  double *a[3], a0[3], a1[3], a2[3];
-  double tMin[3], tMax[3], closest[3], t;
-  double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
+  double *a[3], a0[3], a1[3], a2[3], *v[3], v0[3], v1[3], v2[3];
+  int i, j;
 
-  this->OBBCount++;
-  this->PointsList->Reset();
-  //
-  // Compute mean & moments
-  //
+  // normalize data
+  for (i = 0; i < 3; i++)
+  {
+    mean[i] = m.Mean[i] / m.Mass;
+  }
 
-  numCells = cells->GetNumberOfIds();
-  mean[0] = mean[1] = mean[2] = 0.0;
-  tot_mass = 0.0;
+  // matrix is symmetric
   a[0] = a0;
   a[1] = a1;
   a[2] = a2;
   for (i = 0; i < 3; i++)
   {
-    a0[i] = a1[i] = a2[i] = 0.0;
+    for (j = i; j < 3; j++)
+    {
+      a[i][j] = a[j][i] = m.A[i][j];
+    }
   }
 
-  for (i = 0; i < numCells; i++)
+  // get covariance from moments
+  for (i = 0; i < 3; i++)
   {
-    cellId = cells->GetId(i);
-    type = this->DataSet->GetCellType(cellId);
-    switch (this->DataSet->GetDataObjectType())
+    for (j = 0; j < 3; j++)
     {
-      case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
-        break;
-      default:
-        vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
-        break;
+      a[i][j] = a[i][j] / m.Mass - mean[i] * mean[j];
     }
-    for (j = 0; j < numPts - 2; j++)
+  }
+
+  //
+  // Extract axes (i.e., eigenvectors) from covariance matrix.
+  //
+  v[0] = v0;
+  v[1] = v1;
+  v[2] = v2;
+  vtkMath::Jacobi(a, size, v);
+  for (i = 0; i < 3; i++)
+  {
+    axes[0][i] = v[i][0];
+    axes[1][i] = v[i][1];
+    axes[2][i] = v[i][2];
+  }
+}
+
+// Turn axes and extents into the corner and edge vectors of the box.
+void SetOBB(const double mean[3], const double axes[3][3], const OBBExtents& e,
+  double corner[3], double max[3], double mid[3], double min[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    corner[i] = mean[i] + e.TMin[0] * axes[0][i] + e.TMin[1] * axes[1][i] + e.TMin[2] * axes[2][i];
+    max[i] = (e.TMax[0] - e.TMin[0]) * axes[0][i];
+    mid[i] = (e.TMax[1] - e.TMin[1]) * axes[1][i];
+    min[i] = (e.TMax[2] - e.TMin[2]) * axes[2][i];
+  }
+}
+
+// A subtree whose construction has been deferred so that the subtrees can
+// be built in parallel.
+struct OBBSubtree
+{
+  vtkIdList* Cells;
+  vtkOBBNode* Node;
+  int Level;
+  int Depth;
+};
+
+// Builds the tree. All the methods only read the builder and the dataset,
+// so separate subtrees can be built concurrently once the dataset has been
+// prepared for concurrent access.
+struct OBBBuilder
+{
+  vtkDataSet* DataSet;
+  int MaxLevel;
+  int NumberOfCellsPerNode;
+  bool RetainCellLists;
+  // Use vtkSMPTools within large nodes.
+  bool Parallel;
+  // Level from which subtrees are deferred, when subtrees are collected.
+  int SubtreeLevel;
+
+  bool UseSMP(vtkIdType numCells) const
+  {
+    return this->Parallel && numCells >= vtkOBBTreeParallelThreshold;
+  }
+
+  void ComputeMoments(vtkIdList* cells, OBBMoments& m) const
+  {
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    if (!this->UseSMP(numCells))
     {
-      vtkCELLTRIANGLES(ptIds, type, j, pId, qId, rId);
-      if (pId < 0)
+      vtkNew<vtkIdList> cellPts;
+      for (vtkIdType i = 0; i < numCells; i++)
       {
-        continue;
+        AddCellMoments(this->DataSet, cells->GetId(i), cellPts, m);
       }
-      this->DataSet->GetPoint(pId, p);
-      this->DataSet->GetPoint(qId, q);
-      this->DataSet->GetPoint(rId, r);
-      // p, q, and r are the oriented triangle points.
-      // Compute the components of the moment of inertia tensor.
-      for (k = 0; k < 3; k++)
+      return;
+    }
+
+    vtkSMPThreadLocal<OBBMoments> localMoments;
+    vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+    vtkDataSet* ds = this->DataSet;
+    auto accumulate = [&](vtkIdType begin, vtkIdType end) {
+      OBBMoments& lm = localMoments.Local();
+      vtkIdList* cellPts = localCellPts.Local();
+      for (vtkIdType i = begin; i < end; i++)
       {
-        // two edge vectors
-        dp0[k] = q[k] - p[k];
-        dp1[k] = r[k] - p[k];
-        // centroid
-        c[k] = (p[k] + q[k] + r[k]) / 3;
+        AddCellMoments(ds, cells->GetId(i), cellPts, lm);
       }
-      vtkMath::Cross(dp0, dp1, xp);
-      tri_mass = 0.5 * vtkMath::Norm(xp);
-      tot_mass += tri_mass;
-      for (k = 0; k < 3; k++)
+    };
+    vtkSMPTools::For(0, numCells, accumulate);
+    for (auto it = localMoments.begin(); it != localMoments.end(); ++it)
+    {
+      m.Add(*it);
+    }
+  }
+
+  // Project all the points of the cells onto the axes. A point shared by
+  // several cells is projected several times, which does not change the
+  // extents.
+  void ComputeExtents(
+    vtkIdList* cells, const double mean[3], const double axes[3][3], OBBExtents& e) const
+  {
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    vtkDataSet* ds = this->DataSet;
+    auto project = [&](vtkIdType begin, vtkIdType end, vtkIdList* cellPts, OBBExtents& le) {
+      double x[3];
+      for (vtkIdType i = begin; i < end; i++)
       {
-        mean[k] += tri_mass * c[k];
+        ds->GetCellPoints(cells->GetId(i), cellPts);
+        const vtkIdType numPts = cellPts->GetNumberOfIds();
+        for (vtkIdType j = 0; j < numPts; j++)
+        {
+          ds->GetPoint(cellPts->GetId(j), x);
+          le.Add(x, mean, axes);
+        }
       }
+    };
+    if (!this->UseSMP(numCells))
+    {
+      vtkNew<vtkIdList> cellPts;
+      project(0, numCells, cellPts, e);
+      return;
+    }
 
-      // on-diagonal terms
-      a0[0] += tri_mass * (9 * c[0] * c[0] + p[0] * p[0] + q[0] * q[0] + r[0] * r[0]) / 12;
-      a1[1] += tri_mass * (9 * c[1] * c[1] + p[1] * p[1] + q[1] * q[1] + r[1] * r[1]) / 12;
-      a2[2] += tri_mass * (9 * c[2] * c[2] + p[2] * p[2] + q[2] * q[2] + r[2] * r[2]) / 12;
+    vtkSMPThreadLocal<OBBExtents> localExtents;
+    vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+    auto projectRange = [&](vtkIdType begin, vtkIdType end) {
+      project(begin, end, localCellPts.Local(), localExtents.Local());
+    };
+    vtkSMPTools::For(0, numCells, projectRange);
+    for (auto it = localExtents.begin(); it != localExtents.end(); ++it)
+    {
+      e.Add(*it);
+    }
+  }
 
-      // off-diagonal terms
-      a0[1] += tri_mass * (9 * c[0] * c[1] + p[0] * p[1] + q[0] * q[1] + r[0] * r[1]) / 12;
-      a0[2] += tri_mass * (9 * c[0] * c[2] + p[0] * p[2] + q[0] * q[2] + r[0] * r[2]) / 12;
-      a1[2] += tri_mass * (9 * c[1] * c[2] + p[1] * p[2] + q[1] * q[2] + r[1] * r[2]) / 12;
-    } // end foreach triangle
+  void ComputeOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3],
+    double min[3], double size[3]) const
+  {
+    OBBMoments m;
+    double mean[3], axes[3][3];
+    OBBExtents e;
+    this->ComputeMoments(cells, m);
+    ComputeAxes(m, mean, axes, size);
+    this->ComputeExtents(cells, mean, axes, e);
+    SetOBB(mean, axes, e, corner, max, mid, min);
+  }
 
-    // While computing cell moments, gather all the cell's
-    // point coordinates into a single list.
-    //
-    for (j = 0; j < numPts; j++)
+  // Return 1 if the cell goes to the negative side of the plane (n,p),
+  // using the centroid to decide straddle cases.
+  int IsNegative(vtkIdType cellId, vtkIdList* cellPts, const double n[3], const double p[3]) const
+  {
+    double c[3], x[3], val;
+    int negative, positive;
+    this->DataSet->GetCellPoints(cellId, cellPts);
+    c[0] = c[1] = c[2] = 0.0;
+    const vtkIdType numPts = cellPts->GetNumberOfIds();
+    negative = positive = 0;
+    for (vtkIdType j = 0; j < numPts; j++)
     {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
+      this->DataSet->GetPoint(cellPts->GetId(j), x);
+      val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+      c[0] += x[0];
+      c[1] += x[1];
+      c[2] += x[2];
+      if (val < 0.0)
+      {
+        negative = 1;
+      }
+      else
       {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
+        positive = 1;
       }
-    } // for all points of this cell
-  }   // end foreach cell
+    }
 
-  // normalize data
-  for (i = 0; i < 3; i++)
+    if (negative && positive)
+    { // Use centroid to decide straddle cases
+      c[0] /= numPts;
+      c[1] /= numPts;
+      c[2] /= numPts;
+      return (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0);
+    }
+    return negative;
+  }
+
+  // Assign the cells to the two sides of the plane (n,p).
+  void Split(vtkIdList* cells, const double n[3], const double p[3], vtkIdList* LHlist,
+    vtkIdList* RHlist) const
   {
-    mean[i] = mean[i] / tot_mass;
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    if (!this->UseSMP(numCells))
+    {
+      vtkNew<vtkIdList> cellPts;
+      for (vtkIdType i = 0; i < numCells; i++)
+      {
+        const vtkIdType cellId = cells->GetId(i);
+        if (this->IsNegative(cellId, cellPts, n, p))
+        {
+          LHlist->InsertNextId(cellId);
+        }
+        else
+        {
+          RHlist->InsertNextId(cellId);
+        }
+      }
+      return;
+    }
+
+    // Classify in parallel, then fill the lists in order.
+    std::vector<unsigned char> negative(numCells);
+    vtkSMPThreadLocalObject<vtkIdList> localCellPts;
+    auto classify = [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* cellPts = localCellPts.Local();
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        negative[i] = static_cast<unsigned char>(this->IsNegative(cells->GetId(i), cellPts, n, p));
+      }
+    };
+    vtkSMPTools::For(0, numCells, classify);
+    for (vtkIdType i = 0; i < numCells; i++)
+    {
+      (negative[i] ? LHlist : RHlist)->InsertNextId(cells->GetId(i));
+    }
   }
 
-  // matrix is symmetric
-  a1[0] = a0[1];
-  a2[0] = a0[2];
-  a2[1] = a1[2];
+  // Build the subtree rooted at OBBptr and return its deepest level. When
+  // subtrees is not null, the subtrees starting at SubtreeLevel are not
+  // built but appended to it. Frees its first argument.
+  int Build(
+    vtkIdList* cells, vtkOBBNode* OBBptr, int level, std::vector<OBBSubtree>* subtrees) const
+  {
+    const vtkIdType numCells = cells->GetNumberOfIds();
+    if (subtrees && level >= this->SubtreeLevel && numCells >= vtkOBBTreeTaskThreshold)
+    {
+      OBBSubtree subtree = { cells, OBBptr, level, level };
+      subtrees->push_back(subtree);
+      return level;
+    }
 
-  // get covariance from moments
-  for (i = 0; i < 3; i++)
+    int depth = level;
+    double size[3];
+    this->ComputeOBB(
+      cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
+
+    //
+    // Check whether to continue recursing; if so, create two children and
+    // assign cells to appropriate child.
+    //
+    if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
+    {
+      vtkIdList* LHlist = vtkIdList::New();
+      LHlist->Allocate(numCells / 2);
+      vtkIdList* RHlist = vtkIdList::New();
+      RHlist->Allocate(numCells / 2);
+      double n[3], p[3], ratio, bestRatio;
+      int i, splitAcceptable, splitPlane;
+      int foundBestSplit, bestPlane = 0;
+      vtkIdType numInLHnode, numInRHnode;
+
+      // loop over three split planes to find acceptable one
+      for (i = 0; i < 3; i++) // compute split point
+      {
+        p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
+          OBBptr->Axes[2][i] / 2.0;
+      }
+
+      bestRatio = 1.0; // worst case ratio
+      foundBestSplit = 0;
+      for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
+      {
+        // compute split normal
+        for (i = 0; i < 3; i++)
+        {
+          n[i] = OBBptr->Axes[splitPlane][i];
+        }
+        vtkMath::Normalize(n);
+
+        // traverse cells, assigning to appropriate child list as necessary
+        this->Split(cells, n, p, LHlist, RHlist);
+
+        // evaluate this split
+        numInLHnode = LHlist->GetNumberOfIds();
+        numInRHnode = RHlist->GetNumberOfIds();
+        ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
+
+        // see whether we've found acceptable split plane
+        if (ratio < 0.6 || foundBestSplit) // accept right off the bat
+        {
+          splitAcceptable = 1;
+        }
+        else
+        { // not a great split try another
+          LHlist->Reset();
+          RHlist->Reset();
+          if (ratio < bestRatio)
+          {
+            bestRatio = ratio;
+            bestPlane = splitPlane;
+          }
+          if (++splitPlane == 3 && bestRatio < 0.95)
+          { // at closing time, even the ugly ones look good
+            splitPlane = bestPlane;
+            foundBestSplit = 1;
+          }
+        } // try another split
+
+      } // for each split
+
+      if (splitAcceptable) // otherwise recursion terminates
+      {
+        vtkOBBNode* LHnode = new vtkOBBNode;
+        vtkOBBNode* RHnode = new vtkOBBNode;
+        OBBptr->Kids = new vtkOBBNode*[2];
+        OBBptr->Kids[0] = LHnode;
+        OBBptr->Kids[1] = RHnode;
+        LHnode->Parent = OBBptr;
+        RHnode->Parent = OBBptr;
+
+        cells->Delete();
+        cells = nullptr; // don't need to keep anymore
+        const int LHdepth = this->Build(LHlist, LHnode, level + 1, subtrees);
+        const int RHdepth = this->Build(RHlist, RHnode, level + 1, subtrees);
+        depth = (LHdepth > RHdepth ? LHdepth : RHdepth);
+      }
+      else
+      {
+        // free up local objects
+        LHlist->Delete();
+        RHlist->Delete();
+      }
+    } // if should build tree
+
+    if (cells && this->RetainCellLists)
+    {
+      cells->Squeeze();
+      OBBptr->Cells = cells;
+    }
+    else if (cells)
+    {
+      cells->Delete();
+    }
+    return depth;
+  }
+
+  // Build the tree rooted at root from the cells, which are freed, building
+  // the subtrees of the upper levels in parallel. Returns the deepest level.
+  int BuildParallel(vtkIdList* cells, vtkOBBNode* root)
   {
-    for (j = 0; j < 3; j++)
+    // Defer enough subtrees to keep all the threads busy.
+    const int numThreads = vtkSMPTools::GetEstimatedNumberOfThreads();
+    if (numThreads < 2)
     {
-      a[i][j] = a[i][j] / tot_mass - mean[i] * mean[j];
+      this->Parallel = false;
+      return this->Build(cells, root, 0, nullptr);
     }
+    this->SubtreeLevel = 2;
+    while ((1 << this->SubtreeLevel) < 4 * numThreads && this->SubtreeLevel < 16)
+    {
+      this->SubtreeLevel++;
+    }
+
+    this->Parallel = true;
+    std::vector<OBBSubtree> subtrees;
+    int depth = this->Build(cells, root, 0, &subtrees);
+
+    // Each subtree is built serially, the parallelism is across subtrees.
+    this->Parallel = false;
+    const OBBBuilder& builder = *this;
+    auto buildSubtrees = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; i++)
+      {
+        OBBSubtree& subtree = subtrees[i];
+        subtree.Depth = builder.Build(subtree.Cells, subtree.Node, subtree.Level, nullptr);
+      }
+    };
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()), 1, buildSubtrees);
+    for (size_t i = 0; i < subtrees.size(); i++)
+    {
+      depth = (subtrees[i].Depth > depth ? subtrees[i].Depth : depth);
+    }
+    return depth;
   }
+};
 
-  //
-  // Extract axes (i.e., eigenvectors) from covariance matrix.
-  //
-  v[0] = v0;
-  v[1] = v1;
-  v[2] = v2;
-  vtkMath::Jacobi(a, size, v);
-  max[0] = v[0][0];
-  max[1] = v[1][0];
-  max[2] = v[2][0];
-  mid[0] = v[0][1];
-  mid[1] = v[1][1];
-  mid[2] = v[2][1];
-  min[0] = v[0][2];
-  min[1] = v[1][2];
-  min[2] = v[2][2];
+// Only vtkPolyData and vtkUnstructuredGrid expose the cell types needed to
+// triangulate the cells when computing the moments.
+bool IsSupported(vtkDataSet* ds)
+{
+  return ds->GetDataObjectType() == VTK_POLY_DATA ||
+    ds->GetDataObjectType() == VTK_UNSTRUCTURED_GRID;
+}
 
-  for (i = 0; i < 3; i++)
+// Initialize a builder from the locator settings.
+void InitializeBuilder(OBBBuilder& builder, vtkOBBTree* tree, vtkDataSet* ds)
+{
+  builder.DataSet = ds;
+  builder.MaxLevel = tree->GetMaxLevel();
+  builder.NumberOfCellsPerNode = tree->GetNumberOfCellsPerNode();
+  builder.RetainCellLists = (tree->GetRetainCellLists() != 0);
+  builder.Parallel = false;
+  builder.SubtreeLevel = 0;
+}
+
+// The first call to GetCellType() on a vtkPolyData builds its cell links.
+// Do it before the dataset is accessed from several threads.
+void PrepareDataSet(vtkDataSet* ds)
+{
+  if (ds->GetNumberOfCells() > 0)
   {
-    a[0][i] = mean[i] + max[i];
-    a[1][i] = mean[i] + mid[i];
-    a[2][i] = mean[i] + min[i];
+    ds->GetCellType(0);
   }
+}
 
-  //
-  // Create oriented bounding box by projecting points onto eigenvectors.
-  //
-  tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
-  tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
+void CollectLeaves(vtkOBBNode* node, std::vector<vtkOBBNode*>& leaves)
+{
+  if (node->Kids)
+  {
+    CollectLeaves(node->Kids[0], leaves);
+    CollectLeaves(node->Kids[1], leaves);
+  }
+  else
+  {
+    leaves.push_back(node);
+  }
+}
+
+int CountNodes(vtkOBBNode* node)
+{
+  return 1 + (node->Kids ? CountNodes(node->Kids[0]) + CountNodes(node->Kids[1]) : 0);
+}
 
-  numPts = this->PointsList->GetNumberOfPoints();
-  for (ptId = 0; ptId < numPts; ptId++)
+// Refit the interior nodes below node from the moments of the leaves, which
+// are visited in the order of CollectLeaves(). Returns the moments of node.
+OBBMoments RefitNode(vtkOBBNode* node, const std::vector<OBBMoments>& leafMoments, size_t& leaf)
+{
+  if (!node->Kids)
   {
-    this->PointsList->GetPoint(ptId, p);
-    for (i = 0; i < 3; i++)
+    return leafMoments[leaf++];
+  }
+  OBBMoments m = RefitNode(node->Kids[0], leafMoments, leaf);
+  m.Add(RefitNode(node->Kids[1], leafMoments, leaf));
+
+  // The new box contains the corners of the boxes of the children, hence
+  // all the cells below it.
+  double mean[3], axes[3][3], size[3], x[3];
+  ComputeAxes(m, mean, axes, size);
+  OBBExtents e;
+  for (int kid = 0; kid < 2; kid++)
+  {
+    const vtkOBBNode* k = node->Kids[kid];
+    for (int corner = 0; corner < 8; corner++)
     {
-      vtkLine::DistanceToLine(p, mean, a[i], t, closest);
-      if (t < tMin[i])
+      for (int i = 0; i < 3; i++)
       {
-        tMin[i] = t;
-      }
-      if (t > tMax[i])
-      {
-        tMax[i] = t;
+        x[i] = k->Corner[i] + ((corner & 1) ? k->Axes[0][i] : 0.0) +
+          ((corner & 2) ? k->Axes[1][i] : 0.0) + ((corner & 4) ? k->Axes[2][i] : 0.0);
       }
+      e.Add(x, mean, axes);
     }
-  } // for all points
+  }
+  SetOBB(mean, axes, e, node->Corner, node->Axes[0], node->Axes[1], node->Axes[2]);
+  return m;
+}
+}
 
-  for (i = 0; i < 3; i++)
+// a method to compute the OBB of a dataset without having to go through the
+// Execute method; It does set
+void vtkOBBTree::ComputeOBB(
+  vtkDataSet* input, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  vtkIdType numCells, i;
+
+  vtkDebugMacro(<< "Computing OBB");
+
+  if (input == nullptr || input->GetNumberOfPoints() < 1 || input->GetNumberOfCells() < 1)
   {
-    corner[i] = mean[i] + tMin[0] * max[i] + tMin[1] * mid[i] + tMin[2] * min[i];
+    vtkErrorMacro(<< "Can't compute OBB - no data available!");
+    return;
+  }
+  if (!IsSupported(input))
+  {
+    vtkErrorMacro(<< "DataSet " << input->GetClassName() << " not supported.");
+    return;
+  }
+  numCells = input->GetNumberOfCells();
 
-    max[i] = (tMax[0] - tMin[0]) * max[i];
-    mid[i] = (tMax[1] - tMin[1]) * mid[i];
-    min[i] = (tMax[2] - tMin[2]) * min[i];
+  vtkNew<vtkIdList> cellList;
+  cellList->SetNumberOfIds(numCells);
+  for (i = 0; i < numCells; i++)
+  {
+    cellList->SetId(i, i);
   }
+
+  PrepareDataSet(input);
+  OBBBuilder builder;
+  InitializeBuilder(builder, this, input);
+  builder.Parallel = true;
+  builder.ComputeOBB(cellList, corner, max, mid, min, size);
+}
+
+// Compute an OBB from the list of cells given. Return the corner point
+// and the three axes defining the orientation of the OBB. Also return
+// a sorted list of relative "sizes" of axes for comparison purposes.
+void vtkOBBTree::ComputeOBB(
+  vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  if (!IsSupported(this->DataSet))
+  {
+    vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
+    return;
+  }
+  OBBBuilder builder;
+  InitializeBuilder(builder, this, this->DataSet);
+  builder.ComputeOBB(cells, corner, max, mid, min, size);
 }
 
 // Efficient check for whether a line p1,p2 intersects with triangle
@@ -1047,7 +1489,6 @@ void vtkOBBNode::DebugPrintTree(int level, double* leaf_vol, int* minCells, int*
 void vtkOBBTree::BuildLocator()
 {
   vtkIdType numPts, numCells, i;
-  vtkIdList* cellList;
 
   vtkDebugMacro(<< "Building OBB tree");
   if ((this->Tree != nullptr) && (this->BuildTime > this->MTime) &&
@@ -1056,31 +1497,26 @@ void vtkOBBTree::BuildLocator()
     return;
   }
 
-  numPts = this->DataSet->GetNumberOfPoints();
-  numCells = this->DataSet->GetNumberOfCells();
-  if (this->DataSet == nullptr || numPts < 1 || numCells < 1)
+  if (this->DataSet == nullptr || (numPts = this->DataSet->GetNumberOfPoints()) < 1 ||
+    (numCells = this->DataSet->GetNumberOfCells()) < 1)
   {
     vtkErrorMacro(<< "Can't build OBB tree - no data available!");
     return;
   }
-
-  this->OBBCount = 0;
-  this->InsertedPoints = new int[numPts];
-  for (i = 0; i < numPts; i++)
+  if (!IsSupported(this->DataSet))
   {
-    this->InsertedPoints[i] = 0;
+    vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
+    return;
   }
-  this->PointsList = vtkPoints::New();
-  this->PointsList->Allocate(numPts);
 
   //
   // Begin recursively creating OBB's
   //
-  cellList = vtkIdList::New();
-  cellList->Allocate(numCells);
+  vtkIdList* cellList = vtkIdList::New();
+  cellList->SetNumberOfIds(numCells);
   for (i = 0; i < numCells; i++)
   {
-    cellList->InsertId(i, i);
+    cellList->SetId(i, i);
   }
 
   if (this->Tree)
@@ -1089,8 +1525,12 @@ void vtkOBBTree::BuildLocator()
     delete this->Tree;
   }
   this->Tree = new vtkOBBNode;
-  this->Level = 0;
-  this->BuildTree(cellList, this->Tree, 0);
+
+  PrepareDataSet(this->DataSet);
+  OBBBuilder builder;
+  InitializeBuilder(builder, this, this->DataSet);
+  this->Level = builder.BuildParallel(cellList, this->Tree);
+  this->OBBCount = CountNodes(this->Tree);
 
   vtkDebugMacro(<< "# Cells: " << numCells << ", Deepest tree level: " << this->Level
                 << ", Created: " << this->OBBCount << " OBB nodes");
@@ -1104,180 +1544,82 @@ void vtkOBBTree::BuildLocator()
     cout.flush();
   }
 
-  //
-  // Clean up
-  //
-  delete[] this->InsertedPoints;
-  this->PointsList->Delete();
-
   this->BuildTime.Modified();
 }
 
-// NOTE: for better memory usage this recursive method
-// frees its first argument
-void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
+//------------------------------------------------------------------------------
+void vtkOBBTree::Refit()
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
-  double size[3];
-
-  if (level > this->Level)
+  if ((this->Tree != nullptr) && (this->DataSet != nullptr) &&
+    (this->BuildTime > this->MTime) && (this->BuildTime > this->DataSet->GetMTime()))
   {
-    this->Level = level;
+    return;
   }
-  //
-  // Now compute the OBB
-  //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
 
-  //
-  // Check whether to continue recursing; if so, create two children and
-  // assign cells to appropriate child.
-  //
-  if (level < this->MaxLevel && numCells > this->NumberOfCellsPerNode)
+  // The leaves must hold their cells, and these must still be the cells of
+  // the dataset. Otherwise, build a new tree.
+  std::vector<vtkOBBNode*> leaves;
+  bool canRefit = (this->Tree != nullptr && this->DataSet != nullptr);
+  if (canRefit)
   {
-    vtkIdList* LHlist = vtkIdList::New();
-    LHlist->Allocate(cells->GetNumberOfIds() / 2);
-    vtkIdList* RHlist = vtkIdList::New();
-    RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
-    int numInLHnode, numInRHnode;
-
-    // loop over three split planes to find acceptable one
-    for (i = 0; i < 3; i++) // compute split point
+    vtkIdType numCells = 0;
+    CollectLeaves(this->Tree, leaves);
+    for (size_t i = 0; i < leaves.size() && canRefit; i++)
     {
-      p[i] = OBBptr->Corner[i] + OBBptr->Axes[0][i] / 2.0 + OBBptr->Axes[1][i] / 2.0 +
-        OBBptr->Axes[2][i] / 2.0;
+      canRefit = (leaves[i]->Cells != nullptr);
+      numCells += (canRefit ? leaves[i]->Cells->GetNumberOfIds() : 0);
     }
+    canRefit = canRefit && numCells == this->DataSet->GetNumberOfCells() &&
+      IsSupported(this->DataSet);
+  }
+  if (!canRefit)
+  {
+    vtkDebugMacro(<< "Cannot refit the OBB tree, building it");
+    this->FreeSearchStructure();
+    this->BuildLocator();
+    return;
+  }
 
-    bestRatio = 1.0; // worst case ratio
-    foundBestSplit = 0;
-    for (splitPlane = 0, splitAcceptable = 0; !splitAcceptable && splitPlane < 3;)
-    {
-      // compute split normal
-      for (i = 0; i < 3; i++)
-      {
-        n[i] = OBBptr->Axes[splitPlane][i];
-      }
-      vtkMath::Normalize(n);
-
-      // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
-      {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
-        {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
-          {
-            negative = 1;
-          }
-          else
-          {
-            positive = 1;
-          }
-        }
-
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-        else
-        {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
-        }
-      } // for all cells
-
-      // evaluate this split
-      numInLHnode = LHlist->GetNumberOfIds();
-      numInRHnode = RHlist->GetNumberOfIds();
-      ratio = fabs(((double)numInRHnode - numInLHnode) / numCells);
-
-      // see whether we've found acceptable split plane
-      if (ratio < 0.6 || foundBestSplit) // accept right off the bat
-      {
-        splitAcceptable = 1;
-      }
-      else
-      { // not a great split try another
-        LHlist->Reset();
-        RHlist->Reset();
-        if (ratio < bestRatio)
-        {
-          bestRatio = ratio;
-          bestPlane = splitPlane;
-        }
-        if (++splitPlane == 3 && bestRatio < 0.95)
-        { // at closing time, even the ugly ones look good
-          splitPlane = bestPlane;
-          foundBestSplit = 1;
-        }
-      } // try another split
-
-    } // for each split
-
-    if (splitAcceptable) // otherwise recursion terminates
-    {
-      vtkOBBNode* LHnode = new vtkOBBNode;
-      vtkOBBNode* RHnode = new vtkOBBNode;
-      OBBptr->Kids = new vtkOBBNode*[2];
-      OBBptr->Kids[0] = LHnode;
-      OBBptr->Kids[1] = RHnode;
-      LHnode->Parent = OBBptr;
-      RHnode->Parent = OBBptr;
+  vtkDebugMacro(<< "Refitting OBB tree");
+  PrepareDataSet(this->DataSet);
+  OBBBuilder builder;
+  InitializeBuilder(builder, this, this->DataSet);
 
-      cells->Delete();
-      cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
-    }
-    else
+  // Leaves are refitted from their cells, in parallel.
+  std::vector<OBBMoments> leafMoments(leaves.size());
+  auto refitLeaves = [&](vtkIdType begin, vtkIdType end) {
+    double mean[3], axes[3][3], size[3];
+    for (vtkIdType i = begin; i < end; i++)
     {
-      // free up local objects
-      LHlist->Delete();
-      RHlist->Delete();
+      vtkOBBNode* leaf = leaves[i];
+      OBBExtents e;
+      builder.ComputeMoments(leaf->Cells, leafMoments[i]);
+      ComputeAxes(leafMoments[i], mean, axes, size);
+      builder.ComputeExtents(leaf->Cells, mean, axes, e);
+      SetOBB(mean, axes, e, leaf->Corner, leaf->Axes[0], leaf->Axes[1], leaf->Axes[2]);
     }
-  } // if should build tree
+  };
+  vtkSMPTools::For(0, static_cast<vtkIdType>(leaves.size()), refitLeaves);
 
-  if (cells && this->RetainCellLists)
-  {
-    cells->Squeeze();
-    OBBptr->Cells = cells;
-  }
-  else if (cells)
+  // Interior nodes are refitted bottom-up from the moments of their leaves
+  // and the boxes of their children.
+  size_t leaf = 0;
+  RefitNode(this->Tree, leafMoments, leaf);
+
+  this->BuildTime.Modified();
+}
+
+// NOTE: for better memory usage this recursive method
+// frees its first argument
+void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
+{
+  OBBBuilder builder;
+  InitializeBuilder(builder, this, this->DataSet);
+  const int depth = builder.Build(cells, OBBptr, level, nullptr);
+  if (depth > this->Level)
   {
-    cells->Delete();
+    this->Level = depth;
   }
-  cellPts->Delete();
 }
 
 // Create polygonal representation for OBB tree at specified level. If
@@ -1896,22 +2238,5 @@ void vtkOBBTree::PrintSelf(ostream& os, vtkIndent indent)
   {
     os << indent << "Tree: (null)\n";
   }
-  if (this->PointsList)
-  {
-    os << indent << "PointsList " << this->PointsList << "\n";
-  }
-  else
-  {
-    os << indent << "PointsList: (null)\n";
-  }
-  if (this->InsertedPoints)
-  {
-    os << indent << "InsertedPoints " << this->InsertedPoints << "\n";
-  }
-  else
-  {
-    os << indent << "InsertedPoints: (null)\n";
-  }
-
   os << indent << "OBBCount " << this->OBBCount << "\n";
 }
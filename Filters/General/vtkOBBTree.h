@@ -30,6 +30,15 @@
  * then assigned to the children OBB's. This process then continues until
  * the MaxLevel ivar limits the recursion, or no split plane can be found.
  *
+ * The tree is built with vtkSMPTools: the moments, extents and splits of
+ * the large nodes near the root are computed in parallel, and the subtrees
+ * below them are then built concurrently. The result does not depend on the
+ * number of threads.
+ *
+ * When only the point coordinates of the dataset change (e.g., a deforming
+ * mesh), Refit() updates the boxes of an existing tree without changing its
+ * structure, which is much cheaper than building a new tree.
+ *
  * A good reference for OBB-trees is Gottschalk & Manocha in Proceedings of
  * Siggraph `96.
  *
@@ -177,6 +186,20 @@ public:
   void BuildLocator() override;
   //@}
 
+  /**
+   * Recompute the boxes of the tree from the current point coordinates of
+   * the dataset, keeping the tree structure and the assignment of cells to
+   * leaves. Leaf boxes are fitted to their cells in parallel, interior boxes
+   * are then fitted to the moments of their cells and the boxes of their
+   * children. This is meant for datasets whose points move while their
+   * cells stay the same; the boxes get looser as the cells move away from
+   * their initial arrangement. Refitting requires the cell lists of the
+   * leaves, so RetainCellLists must be on when the tree is built. If it is
+   * off, if there is no tree, or if the number of cells has changed, a new
+   * tree is built instead.
+   */
+  void Refit();
+
   /**
    * Create polygonal representation for OBB tree at specified level. If
    * level < 0, then the leaf OBB nodes will be gathered. The aspect ratio (ar)
@@ -200,8 +223,6 @@ protected:
 
   vtkOBBNode* Tree;
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
-  vtkPoints* PointsList;
-  int* InsertedPoints;
   int OBBCount;
 
   void DeleteTree(vtkOBBNode* OBBptr);
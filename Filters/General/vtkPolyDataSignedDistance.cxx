@@ -0,0 +1,413 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolyDataSignedDistance.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPolyDataSignedDistance.h"
+
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkStreamingDemandDrivenPipeline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+vtkStandardNewMacro(vtkPolyDataSignedDistance);
+
+namespace
+{
+// Value of the voxels whose distance is not known yet.
+const float FarValue = VTK_FLOAT_MAX;
+
+//----------------------------------------------------------------------------
+// Evaluate the signed distance at the voxels, by rows of the volume. With
+// a finite radius, the voxels farther than radius from the surface are set
+// to FarValue.
+struct EvaluateDistance
+{
+  vtkImplicitPolyDataDistance* Distance;
+  const int* Dims;
+  const double* Origin;
+  const double* Spacing;
+  double Radius;
+  float* Scalars;
+  vtkSMPThreadLocal<vtkIdType> NumberOfKnownVoxels;
+
+  void Initialize() { this->NumberOfKnownVoxels.Local() = 0; }
+
+  void operator()(vtkIdType row, vtkIdType endRow)
+  {
+    vtkIdType& numKnown = this->NumberOfKnownVoxels.Local();
+    const bool exact = !(this->Radius < vtkMath::Inf());
+    double x[3], value;
+    for (; row < endRow; ++row)
+    {
+      const int j = static_cast<int>(row % this->Dims[1]);
+      const int k = static_cast<int>(row / this->Dims[1]);
+      x[1] = this->Origin[1] + j * this->Spacing[1];
+      x[2] = this->Origin[2] + k * this->Spacing[2];
+      float* s = this->Scalars + row * this->Dims[0];
+      for (int i = 0; i < this->Dims[0]; ++i)
+      {
+        x[0] = this->Origin[0] + i * this->Spacing[0];
+        if (exact)
+        {
+          s[i] = static_cast<float>(this->Distance->EvaluateFunction(x));
+          ++numKnown;
+        }
+        else if (this->Distance->EvaluateFunctionWithinRadius(x, this->Radius, value))
+        {
+          s[i] = static_cast<float>(value);
+          ++numKnown;
+        }
+        else
+        {
+          s[i] = FarValue;
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  vtkIdType GetNumberOfKnownVoxels()
+  {
+    vtkIdType numKnown = 0;
+    for (auto it = this->NumberOfKnownVoxels.begin(); it != this->NumberOfKnownVoxels.end(); ++it)
+    {
+      numKnown += *it;
+    }
+    return numKnown;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Fast sweeping solver of the eikonal equation |grad d| = 1 (H. Zhao, "A
+// fast sweeping method for Eikonal equations", Math. Comp. 74, 2005). The
+// voxels of the narrow band are fixed. Each sweep visits the voxels by
+// increasing i+j+k along its direction, so that the voxels of a diagonal
+// plane only depend on the previous plane and are updated in parallel
+// (M. Detrixhe et al., "A parallel fast sweeping method for the Eikonal
+// equation", J. Comput. Phys. 237, 2013).
+struct FastSweeping
+{
+  float* D;
+  const unsigned char* Fixed;
+  int Dims[3];
+  double Spacing[3];
+
+  // Update voxel (i,j,k) from its neighbors.
+  void UpdateVoxel(int i, int j, int k)
+  {
+    const vtkIdType incs[3] = { 1, this->Dims[0],
+      static_cast<vtkIdType>(this->Dims[0]) * this->Dims[1] };
+    const int ijk[3] = { i, j, k };
+    const vtkIdType id = i + j * incs[1] + k * incs[2];
+    if (this->Fixed[id])
+    {
+      return;
+    }
+
+    // Smallest neighbor magnitude along each axis, and the sign of the
+    // smallest of all.
+    double a[3], h[3];
+    float sign = 1.0f;
+    double smallest = FarValue;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      a[axis] = FarValue;
+      h[axis] = this->Spacing[axis];
+      for (int side = -1; side <= 1; side += 2)
+      {
+        const int n = ijk[axis] + side;
+        if (n >= 0 && n < this->Dims[axis])
+        {
+          const float d = this->D[id + side * incs[axis]];
+          const double m = std::abs(d);
+          if (m < a[axis])
+          {
+            a[axis] = m;
+          }
+          if (m < smallest)
+          {
+            smallest = m;
+            sign = (d < 0.0f ? -1.0f : 1.0f);
+          }
+        }
+      }
+    }
+    if (!(smallest < FarValue))
+    {
+      return;
+    }
+
+    // Sort the axes by neighbor magnitude
+    for (int m = 1; m < 3; ++m)
+    {
+      for (int n = m; n > 0 && a[n] < a[n - 1]; --n)
+      {
+        std::swap(a[n], a[n - 1]);
+        std::swap(h[n], h[n - 1]);
+      }
+    }
+
+    // Solve sum(((u - a_n) / h_n)^2) = 1 over the smallest neighbors, adding
+    // an axis as long as the solution exceeds its neighbor.
+    double u = a[0] + h[0];
+    double sumW = 0.0, sumWA = 0.0, sumWA2 = 0.0;
+    for (int m = 0; m < 3 && a[m] < FarValue && (m == 0 || u > a[m]); ++m)
+    {
+      const double w = 1.0 / (h[m] * h[m]);
+      sumW += w;
+      sumWA += w * a[m];
+      sumWA2 += w * a[m] * a[m];
+      const double disc = sumWA * sumWA - sumW * (sumWA2 - 1.0);
+      u = (sumWA + std::sqrt(disc > 0.0 ? disc : 0.0)) / sumW;
+    }
+
+    if (u < std::abs(this->D[id]))
+    {
+      this->D[id] = sign * static_cast<float>(u);
+    }
+  }
+
+  void Sweep()
+  {
+    const int nx = this->Dims[0], ny = this->Dims[1], nz = this->Dims[2];
+    for (int dir = 0; dir < 8; ++dir)
+    {
+      const bool flip[3] = { (dir & 1) != 0, (dir & 2) != 0, (dir & 4) != 0 };
+      for (int level = 0; level <= nx + ny + nz - 3; ++level)
+      {
+        const int iMin = std::max(0, level - (ny - 1) - (nz - 1));
+        const int iMax = std::min(nx - 1, level);
+        vtkSMPTools::For(iMin, iMax + 1, [&](vtkIdType i, vtkIdType endI) {
+          for (; i < endI; ++i)
+          {
+            const int ii = static_cast<int>(i);
+            const int jMin = std::max(0, level - ii - (nz - 1));
+            const int jMax = std::min(ny - 1, level - ii);
+            for (int j = jMin; j <= jMax; ++j)
+            {
+              const int k = level - ii - j;
+              this->UpdateVoxel(flip[0] ? nx - 1 - ii : ii, flip[1] ? ny - 1 - j : j,
+                flip[2] ? nz - 1 - k : k);
+            }
+          }
+        });
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkPolyDataSignedDistance::vtkPolyDataSignedDistance()
+{
+  this->Dimensions[0] = 64;
+  this->Dimensions[1] = 64;
+  this->Dimensions[2] = 64;
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Bounds[i] = 0.0;
+  }
+  this->Padding = 0.1;
+  this->NarrowBand = 1;
+  this->NarrowBandWidth = 3.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyDataSignedDistance::ComputeVolumeBounds(vtkPolyData* input, double bounds[6])
+{
+  if (this->Bounds[0] < this->Bounds[1] && this->Bounds[2] < this->Bounds[3] &&
+    this->Bounds[4] < this->Bounds[5])
+  {
+    std::copy(this->Bounds, this->Bounds + 6, bounds);
+    return;
+  }
+
+  if (input)
+  {
+    input->GetBounds(bounds);
+  }
+  else
+  {
+    bounds[0] = bounds[2] = bounds[4] = -0.5;
+    bounds[1] = bounds[3] = bounds[5] = 0.5;
+  }
+  double maxLength = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    maxLength = std::max(maxLength, bounds[2 * i + 1] - bounds[2 * i]);
+  }
+  const double pad = this->Padding * maxLength;
+  for (int i = 0; i < 3; ++i)
+  {
+    bounds[2 * i] -= pad;
+    bounds[2 * i + 1] += pad;
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::RequestInformation(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+
+  double bounds[6], spacing[3], origin[3];
+  this->ComputeVolumeBounds(input, bounds);
+  for (int i = 0; i < 3; i++)
+  {
+    origin[i] = bounds[2 * i];
+    spacing[i] = (this->Dimensions[i] <= 1
+        ? 1.0
+        : (bounds[2 * i + 1] - bounds[2 * i]) / (this->Dimensions[i] - 1));
+  }
+
+  vtkDataObject::SetPointDataActiveScalarInfo(outInfo, VTK_FLOAT, 1);
+  outInfo->Set(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT(), 0, this->Dimensions[0] - 1, 0,
+    this->Dimensions[1] - 1, 0, this->Dimensions[2] - 1);
+  outInfo->Set(vtkDataObject::ORIGIN(), origin, 3);
+  outInfo->Set(vtkDataObject::SPACING(), spacing, 3);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkPolyDataSignedDistance::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0]);
+  vtkImageData* output = vtkImageData::GetData(outputVector);
+
+  vtkDebugMacro(<< "Computing signed distance volume");
+
+  if (!input || input->GetNumberOfPolys() + input->GetNumberOfStrips() < 1)
+  {
+    vtkErrorMacro(<< "No polygons to compute the distance to");
+    return 0;
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    if (this->Dimensions[i] < 1)
+    {
+      vtkErrorMacro(<< "Bad volume dimensions");
+      return 0;
+    }
+  }
+
+  // Define the volume
+  double bounds[6], spacing[3], origin[3];
+  this->ComputeVolumeBounds(input, bounds);
+  for (int i = 0; i < 3; i++)
+  {
+    origin[i] = bounds[2 * i];
+    spacing[i] = (this->Dimensions[i] <= 1
+        ? 1.0
+        : (bounds[2 * i + 1] - bounds[2 * i]) / (this->Dimensions[i] - 1));
+  }
+  output->SetExtent(
+    0, this->Dimensions[0] - 1, 0, this->Dimensions[1] - 1, 0, this->Dimensions[2] - 1);
+  output->SetOrigin(origin);
+  output->SetSpacing(spacing);
+
+  const vtkIdType numRows = static_cast<vtkIdType>(this->Dimensions[1]) * this->Dimensions[2];
+  const vtkIdType numVoxels = numRows * this->Dimensions[0];
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("SignedDistance");
+  scalars->SetNumberOfTuples(numVoxels);
+  float* s = scalars->GetPointer(0);
+  output->GetPointData()->SetScalars(scalars);
+
+  // The implicit function triangulates the input and builds a thread safe
+  // locator. Warm up the lazily built structures of the triangulated
+  // surface before evaluating in parallel.
+  vtkNew<vtkImplicitPolyDataDistance> distance;
+  distance->SetInput(input);
+  double x[3] = { origin[0], origin[1], origin[2] };
+  distance->EvaluateFunction(x);
+
+  // Exact distances, within the narrow band if requested
+  const double maxSpacing = std::max(spacing[0], std::max(spacing[1], spacing[2]));
+  EvaluateDistance evaluate;
+  evaluate.Distance = distance;
+  evaluate.Dims = this->Dimensions;
+  evaluate.Origin = origin;
+  evaluate.Spacing = spacing;
+  evaluate.Radius = (this->NarrowBand ? this->NarrowBandWidth * maxSpacing : vtkMath::Inf());
+  evaluate.Scalars = s;
+  vtkSMPTools::For(0, numRows, evaluate);
+  this->UpdateProgress(0.5);
+
+  // Without any voxel in the band, e.g. when the surface is far from the
+  // volume, fall back to the exact distances.
+  if (this->NarrowBand && evaluate.GetNumberOfKnownVoxels() == 0)
+  {
+    vtkDebugMacro(<< "No voxel within the narrow band, computing exact distances");
+    evaluate.Radius = vtkMath::Inf();
+    vtkSMPTools::For(0, numRows, evaluate);
+  }
+  else if (this->NarrowBand && evaluate.GetNumberOfKnownVoxels() < numVoxels)
+  {
+    std::vector<unsigned char> fixed(numVoxels);
+    vtkSMPTools::For(0, numVoxels, [&](vtkIdType id, vtkIdType endId) {
+      for (; id < endId; ++id)
+      {
+        fixed[id] = (s[id] != FarValue);
+      }
+    });
+
+    FastSweeping sweeping;
+    sweeping.D = s;
+    sweeping.Fixed = fixed.data();
+    std::copy(this->Dimensions, this->Dimensions + 3, sweeping.Dims);
+    std::copy(spacing, spacing + 3, sweeping.Spacing);
+    sweeping.Sweep();
+  }
+  this->UpdateProgress(1.0);
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkPolyDataSignedDistance::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", " << this->Dimensions[1] << ", "
+     << this->Dimensions[2] << ")\n";
+  os << indent << "Bounds: (" << this->Bounds[0] << ", " << this->Bounds[1] << ", "
+     << this->Bounds[2] << ", " << this->Bounds[3] << ", " << this->Bounds[4] << ", "
+     << this->Bounds[5] << ")\n";
+  os << indent << "Padding: " << this->Padding << "\n";
+  os << indent << "Narrow Band: " << (this->NarrowBand ? "On\n" : "Off\n");
+  os << indent << "Narrow Band Width: " << this->NarrowBandWidth << "\n";
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolyDataSignedDistance.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPolyDataSignedDistance
+ * @brief   sample the signed distance to a surface over a volume
+ *
+ * vtkPolyDataSignedDistance computes the signed distance to the polygons
+ * of its input vtkPolyData at the points of a vtkImageData. The distance is
+ * negative inside of the surface and positive outside; the sign is given by
+ * the angle-weighted pseudo-normal at the closest point of the surface, as
+ * computed by vtkImplicitPolyDataDistance. The input should therefore be a
+ * closed, consistently oriented surface.
+ *
+ * The volume is defined by its dimensions and bounds. When the bounds are
+ * not set, the bounds of the input are used, enlarged on each side by
+ * Padding times the largest side of the input bounds.
+ *
+ * By default the distance is computed exactly only within a narrow band
+ * around the surface, NarrowBandWidth voxels wide. The remaining voxels
+ * are filled by solving the eikonal equation |grad d| = 1 with the fast
+ * sweeping method, the band acting as the boundary condition and each voxel
+ * taking the sign of its upwind neighbor. Far from the surface, these
+ * values are a first order approximation of the distance that may slightly
+ * overestimate it. Turn NarrowBand off to compute the exact distance at
+ * every voxel, which is much slower on large volumes.
+ *
+ * The output scalars are a vtkFloatArray named "SignedDistance".
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools: the exact distances are
+ * evaluated in parallel with a vtkStaticCellLocator, and each sweep updates
+ * the voxels of a diagonal plane in parallel. Using TBB or other
+ * non-sequential type (set in the CMake variable
+ * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ *
+ * @sa
+ * vtkImplicitPolyDataDistance vtkDistancePolyDataFilter vtkImplicitModeller
+ * vtkSignedDistance
+ */
+
+#ifndef vtkPolyDataSignedDistance_h
+#define vtkPolyDataSignedDistance_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkImageAlgorithm.h"
+
+class vtkPolyData;
+
+class VTKFILTERSGENERAL_EXPORT vtkPolyDataSignedDistance : public vtkImageAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiating the class, providing type information,
+   * and printing.
+   */
+  static vtkPolyDataSignedDistance* New();
+  vtkTypeMacro(vtkPolyDataSignedDistance, vtkImageAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Set/Get the i-j-k dimensions of the volume. Defaults to 64x64x64.
+   */
+  vtkSetVector3Macro(Dimensions, int);
+  vtkGetVectorMacro(Dimensions, int, 3);
+  //@}
+
+  //@{
+  /**
+   * Set / get the region in space covered by the volume. If not
+   * specified, it is computed from the bounds of the input and the
+   * Padding.
+   */
+  vtkSetVector6Macro(Bounds, double);
+  vtkGetVectorMacro(Bounds, double, 6);
+  //@}
+
+  //@{
+  /**
+   * Set / get the fraction of the largest side of the input bounds added
+   * on each side of the input bounds when the Bounds are not specified.
+   * Defaults to 0.1.
+   */
+  vtkSetClampMacro(Padding, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Padding, double);
+  //@}
+
+  //@{
+  /**
+   * Indicate whether the exact distance is only computed within a narrow
+   * band around the surface, the rest of the volume being filled by fast
+   * sweeping. On by default.
+   */
+  vtkSetMacro(NarrowBand, vtkTypeBool);
+  vtkGetMacro(NarrowBand, vtkTypeBool);
+  vtkBooleanMacro(NarrowBand, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Set / get the half width of the narrow band, in units of the largest
+   * voxel spacing. Defaults to 3.
+   */
+  vtkSetClampMacro(NarrowBandWidth, double, 1.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(NarrowBandWidth, double);
+  //@}
+
+protected:
+  vtkPolyDataSignedDistance();
+  ~vtkPolyDataSignedDistance() override = default;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int FillInputPortInformation(int, vtkInformation*) override;
+
+  // Compute the bounds of the volume from the Bounds, or from the input.
+  void ComputeVolumeBounds(vtkPolyData* input, double bounds[6]);
+
+  int Dimensions[3];
+  double Bounds[6];
+  double Padding;
+  vtkTypeBool NarrowBand;
+  double NarrowBandWidth;
+
+private:
+  vtkPolyDataSignedDistance(const vtkPolyDataSignedDistance&) = delete;
+  void operator=(const vtkPolyDataSignedDistance&) = delete;
+};
+
+#endif
@@ -0,0 +1,489 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkSpaceFillingCurveReorder.h"
+
+#include "vtkArrayDispatch.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArrayRange.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtkSpaceFillingCurveKeys.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkSpaceFillingCurveReorder);
+
+namespace
+{
+using KeyType = vtkTypeUInt64;
+using KeyPair = std::pair<KeyType, vtkIdType>;
+
+//----------------------------------------------------------------------------
+// Maps positions to keys along the curve, over the bounds of the points.
+struct CurveGrid
+{
+  double Origin[3];
+  double Scale[3];
+  bool Hilbert;
+
+  CurveGrid(const double bounds[6], int curveType)
+    : Hilbert(curveType == vtkSpaceFillingCurveReorder::HILBERT)
+  {
+    const double maxCoord = static_cast<double>((1u << vtkSpaceFillingCurveKeys::Bits3D) - 1);
+    for (int i = 0; i < 3; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Origin[i] = bounds[2 * i];
+      this->Scale[i] = (length > 0.0 ? maxCoord / length : 0.0);
+    }
+  }
+
+  KeyType GetKey(const double x[3]) const
+  {
+    const unsigned int maxCoord = (1u << vtkSpaceFillingCurveKeys::Bits3D) - 1;
+    unsigned int c[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double v = (x[i] - this->Origin[i]) * this->Scale[i];
+      c[i] = (v <= 0.0 ? 0 : (v >= maxCoord ? maxCoord : static_cast<unsigned int>(v)));
+    }
+    return this->Hilbert ? vtkSpaceFillingCurveKeys::HilbertKey(c[0], c[1], c[2])
+                         : vtkSpaceFillingCurveKeys::MortonKey(c[0], c[1], c[2]);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Sort the keys in [begin,end) and return the old id of each new id. Ties
+// are broken by id so that the result does not depend on the sort.
+void SortKeys(std::vector<KeyPair>& keys, vtkIdType begin, vtkIdType end, vtkIdType* newToOld)
+{
+  vtkSMPTools::Sort(keys.begin() + begin, keys.begin() + end);
+  vtkSMPTools::For(begin, end, [&](vtkIdType id, vtkIdType endId) {
+    for (; id < endId; ++id)
+    {
+      newToOld[id] = keys[id].second;
+    }
+  });
+}
+
+//----------------------------------------------------------------------------
+// Compute the curve key of the average point of each cell of a cell array.
+struct ComputeCellKeys
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, vtkPoints* points, const CurveGrid& grid, KeyPair* keys,
+    vtkIdType idOffset)
+  {
+    vtkSMPTools::For(0, state.GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+      double x[3], center[3];
+      for (; cellId < endCellId; ++cellId)
+      {
+        center[0] = center[1] = center[2] = 0.0;
+        const auto cellPts = state.GetCellRange(cellId);
+        for (const vtkIdType ptId : cellPts)
+        {
+          points->GetPoint(ptId, x);
+          center[0] += x[0];
+          center[1] += x[1];
+          center[2] += x[2];
+        }
+        if (cellPts.size() > 0)
+        {
+          const double w = 1.0 / cellPts.size();
+          center[0] *= w;
+          center[1] *= w;
+          center[2] *= w;
+        }
+        else
+        {
+          center[0] = grid.Origin[0];
+          center[1] = grid.Origin[1];
+          center[2] = grid.Origin[2];
+        }
+        keys[cellId] = KeyPair(grid.GetKey(center), cellId + idOffset);
+      }
+    });
+  }
+};
+
+//----------------------------------------------------------------------------
+// Copy the cells of a cell array in a new order, renumbering their points.
+// newToOld holds the old id plus idOffset of each new cell, or is nullptr
+// to keep the cell order; ptMap holds the new id of each old point, or is
+// nullptr to keep the point ids.
+struct CopyCells
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, const vtkIdType* newToOld, vtkIdType idOffset,
+    const vtkIdType* ptMap, vtkIdTypeArray* offsets, vtkIdTypeArray* connectivity)
+  {
+    const vtkIdType numCells = state.GetNumberOfCells();
+    offsets->SetNumberOfValues(numCells + 1);
+    vtkIdType* offs = offsets->GetPointer(0);
+    offs[0] = 0;
+    for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+    {
+      const vtkIdType oldId = (newToOld ? newToOld[cellId] - idOffset : cellId);
+      offs[cellId + 1] = offs[cellId] + state.GetCellSize(oldId);
+    }
+    connectivity->SetNumberOfValues(offs[numCells]);
+    vtkIdType* conn = connectivity->GetPointer(0);
+
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const vtkIdType oldId = (newToOld ? newToOld[cellId] - idOffset : cellId);
+        vtkIdType* cellConn = conn + offs[cellId];
+        for (const vtkIdType ptId : state.GetCellRange(oldId))
+        {
+          *cellConn++ = (ptMap ? ptMap[ptId] : ptId);
+        }
+      }
+    });
+  }
+};
+
+vtkSmartPointer<vtkCellArray> ReorderCellArray(
+  vtkCellArray* cells, const vtkIdType* newToOld, vtkIdType idOffset, const vtkIdType* ptMap)
+{
+  if (!cells || cells->GetNumberOfCells() == 0 || (!newToOld && !ptMap))
+  {
+    return cells;
+  }
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdTypeArray> connectivity;
+  cells->Visit(CopyCells{}, newToOld, idOffset, ptMap, offsets.GetPointer(),
+    connectivity.GetPointer());
+  auto newCells = vtkSmartPointer<vtkCellArray>::New();
+  newCells->SetData(offsets, connectivity);
+  return newCells;
+}
+
+//----------------------------------------------------------------------------
+// Gather the tuples of an array in the new order.
+struct GatherTuples
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* input, vtkDataArray* outputArray, const vtkIdType* newToOld)
+  {
+    ArrayT* output = vtkArrayDownCast<ArrayT>(outputArray);
+    const auto inTuples = vtk::DataArrayTupleRange(input);
+    auto outTuples = vtk::DataArrayTupleRange(output);
+    vtkSMPTools::For(0, outTuples.size(), [&](vtkIdType id, vtkIdType endId) {
+      for (; id < endId; ++id)
+      {
+        outTuples[id] = inTuples[newToOld[id]];
+      }
+    });
+  }
+};
+
+vtkSmartPointer<vtkAbstractArray> ReorderArray(
+  vtkAbstractArray* input, const vtkIdType* newToOld, vtkIdType numTuples)
+{
+  auto output = vtkSmartPointer<vtkAbstractArray>::Take(input->NewInstance());
+  output->SetName(input->GetName());
+  output->SetNumberOfComponents(input->GetNumberOfComponents());
+  output->CopyComponentNames(input);
+  output->SetNumberOfTuples(numTuples);
+
+  vtkDataArray* inData = vtkDataArray::FastDownCast(input);
+  if (inData)
+  {
+    vtkDataArray* outData = vtkDataArray::FastDownCast(output);
+    GatherTuples worker;
+    if (!vtkArrayDispatch::Dispatch::Execute(inData, worker, outData, newToOld))
+    {
+      worker(inData, outData, newToOld);
+    }
+  }
+  else
+  {
+    // String and variant arrays
+    for (vtkIdType id = 0; id < numTuples; ++id)
+    {
+      output->SetTuple(id, newToOld[id], input);
+    }
+  }
+  return output;
+}
+
+//----------------------------------------------------------------------------
+// Permute all the arrays of point or cell data, keeping the active
+// attributes, and optionally add the original ids.
+void ReorderAttributes(vtkDataSetAttributes* input, vtkDataSetAttributes* output,
+  const vtkIdType* newToOld, vtkIdType numTuples, const char* originalIdsName)
+{
+  if (newToOld)
+  {
+    int attributeIndices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    input->GetAttributeIndices(attributeIndices);
+    for (int i = 0; i < input->GetNumberOfArrays(); ++i)
+    {
+      output->AddArray(ReorderArray(input->GetAbstractArray(i), newToOld, numTuples));
+    }
+    for (int i = 0; i < vtkDataSetAttributes::NUM_ATTRIBUTES; ++i)
+    {
+      if (attributeIndices[i] >= 0)
+      {
+        output->SetActiveAttribute(attributeIndices[i], i);
+      }
+    }
+  }
+  else
+  {
+    output->PassData(input);
+  }
+
+  if (originalIdsName)
+  {
+    vtkNew<vtkIdTypeArray> originalIds;
+    originalIds->SetName(originalIdsName);
+    originalIds->SetNumberOfValues(numTuples);
+    vtkIdType* ids = originalIds->GetPointer(0);
+    vtkSMPTools::For(0, numTuples, [&](vtkIdType id, vtkIdType endId) {
+      for (; id < endId; ++id)
+      {
+        ids[id] = (newToOld ? newToOld[id] : id);
+      }
+    });
+    output->AddArray(originalIds);
+  }
+}
+
+} // anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkSpaceFillingCurveReorder::vtkSpaceFillingCurveReorder()
+{
+  this->CurveType = HILBERT;
+  this->ReorderPoints = 1;
+  this->ReorderCells = 1;
+  this->GenerateOriginalIds = 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Remove(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE());
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  info->Append(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkUnstructuredGrid");
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkSpaceFillingCurveReorder::RequestData(vtkInformation* vtkNotUsed(request),
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPointSet* input = vtkPointSet::GetData(inputVector[0]);
+  vtkPointSet* output = vtkPointSet::GetData(outputVector);
+  vtkPolyData* inPolyData = vtkPolyData::SafeDownCast(input);
+  vtkUnstructuredGrid* inGrid = vtkUnstructuredGrid::SafeDownCast(input);
+  if (!inPolyData && !inGrid)
+  {
+    vtkErrorMacro("Input must be a vtkPolyData or a vtkUnstructuredGrid");
+    return 0;
+  }
+
+  vtkPoints* inPts = input->GetPoints();
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  const vtkIdType numCells = input->GetNumberOfCells();
+  if (numPts < 1)
+  {
+    vtkDebugMacro("No points to reorder");
+    output->ShallowCopy(input);
+    return 1;
+  }
+
+  double bounds[6];
+  inPts->GetBounds(bounds);
+  const CurveGrid grid(bounds, this->CurveType);
+
+  // Sort the points along the curve
+  std::vector<vtkIdType> ptNewToOld;
+  std::vector<vtkIdType> ptOldToNew;
+  if (this->ReorderPoints)
+  {
+    std::vector<KeyPair> keys(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      double x[3];
+      for (; ptId < endPtId; ++ptId)
+      {
+        inPts->GetPoint(ptId, x);
+        keys[ptId] = KeyPair(grid.GetKey(x), ptId);
+      }
+    });
+    ptNewToOld.resize(numPts);
+    SortKeys(keys, 0, numPts, ptNewToOld.data());
+
+    ptOldToNew.resize(numPts);
+    vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        ptOldToNew[ptNewToOld[ptId]] = ptId;
+      }
+    });
+  }
+  const vtkIdType* ptNewToOldPtr = (ptNewToOld.empty() ? nullptr : ptNewToOld.data());
+  const vtkIdType* ptMap = (ptOldToNew.empty() ? nullptr : ptOldToNew.data());
+  this->UpdateProgress(0.3);
+
+  // The cell arrays of the input. The cells of a vtkPolyData are sorted
+  // within each of its four cell arrays.
+  std::vector<vtkCellArray*> cellArrays;
+  if (inPolyData)
+  {
+    cellArrays = { inPolyData->GetVerts(), inPolyData->GetLines(), inPolyData->GetPolys(),
+      inPolyData->GetStrips() };
+  }
+  else
+  {
+    cellArrays = { inGrid->GetCells() };
+  }
+
+  // Sort the cells along the curve
+  std::vector<vtkIdType> cellNewToOld;
+  if (this->ReorderCells && numCells > 0)
+  {
+    std::vector<KeyPair> keys(numCells);
+    cellNewToOld.resize(numCells);
+    vtkIdType idOffset = 0;
+    for (vtkCellArray* cells : cellArrays)
+    {
+      if (cells && cells->GetNumberOfCells() > 0)
+      {
+        const vtkIdType numArrayCells = cells->GetNumberOfCells();
+        cells->Visit(ComputeCellKeys{}, inPts, grid, keys.data() + idOffset, idOffset);
+        SortKeys(keys, idOffset, idOffset + numArrayCells, cellNewToOld.data());
+        idOffset += numArrayCells;
+      }
+    }
+  }
+  const vtkIdType* cellNewToOldPtr = (cellNewToOld.empty() ? nullptr : cellNewToOld.data());
+  this->UpdateProgress(0.6);
+
+  // Copy the points
+  if (ptNewToOldPtr)
+  {
+    vtkNew<vtkPoints> newPts;
+    newPts->SetData(
+      vtkDataArray::SafeDownCast(ReorderArray(inPts->GetData(), ptNewToOldPtr, numPts)));
+    output->SetPoints(newPts);
+  }
+  else
+  {
+    output->SetPoints(inPts);
+  }
+
+  // Copy the cells
+  std::vector<vtkSmartPointer<vtkCellArray>> newCellArrays;
+  vtkIdType idOffset = 0;
+  for (vtkCellArray* cells : cellArrays)
+  {
+    const vtkIdType numArrayCells = (cells ? cells->GetNumberOfCells() : 0);
+    newCellArrays.push_back(ReorderCellArray(
+      cells, cellNewToOldPtr ? cellNewToOldPtr + idOffset : nullptr, idOffset, ptMap));
+    idOffset += numArrayCells;
+  }
+
+  if (inPolyData)
+  {
+    vtkPolyData* outPolyData = vtkPolyData::SafeDownCast(output);
+    outPolyData->SetVerts(newCellArrays[0]);
+    outPolyData->SetLines(newCellArrays[1]);
+    outPolyData->SetPolys(newCellArrays[2]);
+    outPolyData->SetStrips(newCellArrays[3]);
+  }
+  else if (numCells > 0)
+  {
+    vtkUnstructuredGrid* outGrid = vtkUnstructuredGrid::SafeDownCast(output);
+    vtkUnsignedCharArray* types = inGrid->GetCellTypesArray();
+    vtkSmartPointer<vtkUnsignedCharArray> newTypes = types;
+    if (cellNewToOldPtr)
+    {
+      newTypes = vtkUnsignedCharArray::SafeDownCast(ReorderArray(types, cellNewToOldPtr, numCells));
+    }
+
+    // Face streams of polyhedra: number of faces, then the number of
+    // points and point ids of each face.
+    vtkIdTypeArray* faces = inGrid->GetFaces();
+    vtkIdTypeArray* faceLocations = inGrid->GetFaceLocations();
+    vtkSmartPointer<vtkIdTypeArray> newFaces = faces;
+    vtkSmartPointer<vtkIdTypeArray> newFaceLocations = faceLocations;
+    if (faces && faceLocations && (cellNewToOldPtr || ptMap))
+    {
+      newFaces = vtkSmartPointer<vtkIdTypeArray>::New();
+      newFaces->Allocate(faces->GetNumberOfValues());
+      newFaceLocations = vtkSmartPointer<vtkIdTypeArray>::New();
+      newFaceLocations->SetNumberOfValues(numCells);
+      for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+      {
+        const vtkIdType oldId = (cellNewToOldPtr ? cellNewToOldPtr[cellId] : cellId);
+        vtkIdType loc = faceLocations->GetValue(oldId);
+        if (loc < 0)
+        {
+          newFaceLocations->SetValue(cellId, -1);
+          continue;
+        }
+        newFaceLocations->SetValue(cellId, newFaces->GetNumberOfValues());
+        const vtkIdType numFaces = faces->GetValue(loc++);
+        newFaces->InsertNextValue(numFaces);
+        for (vtkIdType i = 0; i < numFaces; ++i)
+        {
+          const vtkIdType numFacePts = faces->GetValue(loc++);
+          newFaces->InsertNextValue(numFacePts);
+          for (vtkIdType j = 0; j < numFacePts; ++j)
+          {
+            const vtkIdType ptId = faces->GetValue(loc++);
+            newFaces->InsertNextValue(ptMap ? ptMap[ptId] : ptId);
+          }
+        }
+      }
+    }
+    outGrid->SetCells(newTypes, newCellArrays[0], newFaceLocations, newFaces);
+  }
+  this->UpdateProgress(0.8);
+
+  // Copy the attributes
+  ReorderAttributes(input->GetPointData(), output->GetPointData(), ptNewToOldPtr, numPts,
+    this->GenerateOriginalIds ? "vtkOriginalPointIds" : nullptr);
+  ReorderAttributes(input->GetCellData(), output->GetCellData(), cellNewToOldPtr, numCells,
+    this->GenerateOriginalIds ? "vtkOriginalCellIds" : nullptr);
+  output->GetFieldData()->PassData(input->GetFieldData());
+
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkSpaceFillingCurveReorder::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Curve Type: " << (this->CurveType == MORTON ? "Morton" : "Hilbert") << "\n";
+  os << indent << "Reorder Points: " << (this->ReorderPoints ? "On\n" : "Off\n");
+  os << indent << "Reorder Cells: " << (this->ReorderCells ? "On\n" : "Off\n");
+  os << indent << "Generate Original Ids: " << (this->GenerateOriginalIds ? "On\n" : "Off\n");
+}
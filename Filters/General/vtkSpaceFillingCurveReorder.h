@@ -0,0 +1,127 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkSpaceFillingCurveReorder.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkSpaceFillingCurveReorder
+ * @brief   reorder points and cells along a space-filling curve
+ *
+ * vtkSpaceFillingCurveReorder renumbers the points and the cells of a
+ * vtkPolyData or a vtkUnstructuredGrid so that entities close in space are
+ * close in memory. Points are sorted by the position of their coordinates
+ * along a Morton (Z-order) or Hilbert curve, and cells by the position of
+ * the average of their points. The curve is defined over the bounds of the
+ * input points, quantized to 21 bits per axis. The geometry and topology
+ * are unchanged: connectivity is rewritten in terms of the new point ids,
+ * and the point data and cell data are permuted accordingly.
+ *
+ * Reordering improves the cache behavior of the algorithms that traverse
+ * the dataset afterwards, such as locators, probing or contouring. The
+ * Hilbert curve has better locality than the Morton curve, whose keys are
+ * cheaper to compute.
+ *
+ * Since vtkPolyData stores its vertices, lines, polygons and triangle
+ * strips in this order, the cells of a vtkPolyData are reordered within
+ * each of these four groups. The face streams of polyhedral cells are
+ * remapped as well.
+ *
+ * When GenerateOriginalIds is on, the input id of each output point and
+ * cell is stored in the vtkIdTypeArrays named vtkOriginalPointIds and
+ * vtkOriginalCellIds. The keys, the sorts and the copies are performed in
+ * parallel with vtkSMPTools.
+ *
+ * @sa
+ * vtkStaticPointLocator vtkStaticCleanPolyData
+ */
+
+#ifndef vtkSpaceFillingCurveReorder_h
+#define vtkSpaceFillingCurveReorder_h
+
+#include "vtkFiltersGeneralModule.h" // For export macro
+#include "vtkPointSetAlgorithm.h"
+
+class VTKFILTERSGENERAL_EXPORT vtkSpaceFillingCurveReorder : public vtkPointSetAlgorithm
+{
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkSpaceFillingCurveReorder* New();
+  vtkTypeMacro(vtkSpaceFillingCurveReorder, vtkPointSetAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  enum CurveTypes
+  {
+    MORTON = 0,
+    HILBERT = 1
+  };
+
+  //@{
+  /**
+   * Specify the curve along which the points and cells are sorted. By
+   * default the Hilbert curve is used.
+   */
+  vtkSetClampMacro(CurveType, int, MORTON, HILBERT);
+  vtkGetMacro(CurveType, int);
+  void SetCurveTypeToMorton() { this->SetCurveType(MORTON); }
+  void SetCurveTypeToHilbert() { this->SetCurveType(HILBERT); }
+  //@}
+
+  //@{
+  /**
+   * Indicate whether the points are reordered. On by default.
+   */
+  vtkSetMacro(ReorderPoints, vtkTypeBool);
+  vtkGetMacro(ReorderPoints, vtkTypeBool);
+  vtkBooleanMacro(ReorderPoints, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Indicate whether the cells are reordered. On by default.
+   */
+  vtkSetMacro(ReorderCells, vtkTypeBool);
+  vtkGetMacro(ReorderCells, vtkTypeBool);
+  vtkBooleanMacro(ReorderCells, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Indicate whether the vtkOriginalPointIds and vtkOriginalCellIds arrays
+   * are added to the output. On by default.
+   */
+  vtkSetMacro(GenerateOriginalIds, vtkTypeBool);
+  vtkGetMacro(GenerateOriginalIds, vtkTypeBool);
+  vtkBooleanMacro(GenerateOriginalIds, vtkTypeBool);
+  //@}
+
+protected:
+  vtkSpaceFillingCurveReorder();
+  ~vtkSpaceFillingCurveReorder() override = default;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  int CurveType;
+  vtkTypeBool ReorderPoints;
+  vtkTypeBool ReorderCells;
+  vtkTypeBool GenerateOriginalIds;
+
+private:
+  vtkSpaceFillingCurveReorder(const vtkSpaceFillingCurveReorder&) = delete;
+  void operator=(const vtkSpaceFillingCurveReorder&) = delete;
+};
+
+#endif
@@ -0,0 +1,122 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestRibbonFilterLines.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Ribbon many polylines, which are ribboned in parallel, with sliding normals
+// and with a default normal. Check that the pair of points of each polyline
+// point is placed after the ones of the previous points, centered on the
+// point, and normal to the default normal when it is used. Some polylines
+// share a point with the previous one, and one of them has coincident points
+// and is skipped.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkRibbonFilter.h"
+#include "vtkTestErrorObserver.h"
+
+#include <cmath>
+
+int TestRibbonFilterLines(int, char*[])
+{
+  const int numLines = 20;
+  const int badLine = 7;
+  const double width = 0.1;
+
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> lines;
+  vtkNew<vtkIdList> ids;
+  for (int lineId = 0; lineId < numLines; ++lineId)
+  {
+    ids->Reset();
+    if (lineId % 4 == 1)
+    {
+      ids->InsertNextId(points->GetNumberOfPoints() - 1);
+    }
+    for (int i = 0; i < 2 + lineId % 5; ++i)
+    {
+      ids->InsertNextId(points->InsertNextPoint(i, std::cos(i + lineId), lineId));
+    }
+    if (lineId == badLine)
+    {
+      ids->InsertNextId(ids->GetId(ids->GetNumberOfIds() - 1));
+    }
+    lines->InsertNextCell(ids);
+  }
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+  input->SetLines(lines);
+
+  for (int useDefaultNormal = 0; useDefaultNormal < 2; ++useDefaultNormal)
+  {
+    vtkNew<vtkTest::ErrorObserver> observer;
+    vtkNew<vtkRibbonFilter> ribbon;
+    ribbon->SetInputData(input);
+    ribbon->SetWidth(width);
+    ribbon->SetUseDefaultNormal(useDefaultNormal);
+    ribbon->AddObserver(vtkCommand::WarningEvent, observer);
+    ribbon->Update();
+    vtkPolyData* output = ribbon->GetOutput();
+    if (observer->CheckWarningMessage("Could not generate points!"))
+    {
+      return EXIT_FAILURE;
+    }
+
+    vtkIdType ptId = 0;
+    vtkIdType stripId = 0;
+    vtkNew<vtkIdList> stripPts;
+    for (int lineId = 0; lineId < numLines; ++lineId)
+    {
+      if (lineId == badLine)
+      {
+        continue;
+      }
+      input->GetLines()->GetCellAtId(lineId, ids);
+      const vtkIdType firstPtId = ptId;
+      for (vtkIdType i = 0; i < ids->GetNumberOfIds(); ++i, ptId += 2)
+      {
+        double x[3], minus[3], plus[3];
+        input->GetPoint(ids->GetId(i), x);
+        output->GetPoint(ptId, minus);
+        output->GetPoint(ptId + 1, plus);
+        bool valid =
+          std::abs(std::sqrt(vtkMath::Distance2BetweenPoints(minus, plus)) - 2.0 * width) < 1.0e-5;
+        for (int j = 0; j < 3; ++j)
+        {
+          valid &= std::abs(0.5 * (minus[j] + plus[j]) - x[j]) < 1.0e-5;
+        }
+        // The ribbon is normal to the default normal, the z axis
+        if (!valid || (useDefaultNormal && std::abs(plus[2] - x[2]) > 1.0e-5))
+        {
+          cerr << "Wrong ribbon points " << ptId << " for line " << lineId << endl;
+          return EXIT_FAILURE;
+        }
+      }
+      output->GetCellPoints(stripId++, stripPts);
+      if (stripPts->GetNumberOfIds() != ptId - firstPtId || stripPts->GetId(0) != firstPtId)
+      {
+        cerr << "Wrong strip for line " << lineId << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    if (ptId != output->GetNumberOfPoints() || stripId != output->GetNumberOfCells())
+    {
+      cerr << "The ribbons have extra points or strips" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -89,6 +89,7 @@ vtkCollisionDetectionFilter::vtkCollisionDetectionFilter()
   this->BoxTolerance = 0.0;
   this->CellTolerance = 0.0;
   this->NumberOfCellsPerNode = 2;
+  this->RefitTrees = 0;
   this->Tree0 = vtkOBBTree::New();
   this->Tree1 = vtkOBBTree::New();
   this->GenerateScalars = 0;
@@ -494,16 +495,30 @@ int vtkCollisionDetectionFilter::RequestData(vtkInformation* vtkNotUsed(request)
   }
   this->InvokeEvent(vtkCommand::StartEvent, nullptr);
 
-  // rebuild the obb trees... they do their own mtime checking with input data
+  // rebuild (or refit) the obb trees... they do their own mtime checking with input data
   Tree0->SetDataSet(input[0]);
   Tree0->AutomaticOn();
   Tree0->SetNumberOfCellsPerNode(this->NumberOfCellsPerNode);
-  Tree0->BuildLocator();
+  if (this->RefitTrees)
+  {
+    Tree0->Refit();
+  }
+  else
+  {
+    Tree0->BuildLocator();
+  }
 
   Tree1->SetDataSet(input[1]);
   Tree1->AutomaticOn();
   Tree1->SetNumberOfCellsPerNode(this->NumberOfCellsPerNode);
-  Tree1->BuildLocator();
+  if (this->RefitTrees)
+  {
+    Tree1->Refit();
+  }
+  else
+  {
+    Tree1->BuildLocator();
+  }
 
   // Set the Box Tolerance
   Tree0->SetTolerance(this->BoxTolerance);
@@ -762,6 +777,7 @@ void vtkCollisionDetectionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Box Tolerance: " << this->GetBoxTolerance() << "\n";
   os << indent << "Cell Tolerance: " << this->GetCellTolerance() << "\n";
   os << indent << "Number of cells per Node: " << this->GetNumberOfCellsPerNode() << "\n";
+  os << indent << "RefitTrees: " << (this->GetRefitTrees() ? "On" : "Off") << "\n";
   os << indent << "GenerateScalars: " << (this->GetGenerateScalars() ? "On" : "Off") << "\n";
   os << indent << "Collision Mode: " << this->GetCollisionModeAsString() << "\n";
   os << indent << "Opacity: " << this->GetOpacity() << "\n";
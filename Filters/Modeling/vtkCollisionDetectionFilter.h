@@ -252,6 +252,20 @@ public:
   vtkGetMacro(NumberOfCellsPerNode, int);
   //@}
 
+  //@{
+  /*
+   * Set and Get the flag to refit the OBB trees instead of building new ones
+   * when an input changes. Refitting keeps the structure of the trees and
+   * only updates their boxes, which is much faster for deforming inputs whose
+   * cells do not change. The boxes get looser as the cells move away from
+   * the arrangement the trees were built for; turn the flag off for one
+   * update to build new trees. Default is off.
+   */
+  vtkSetMacro(RefitTrees, vtkTypeBool);
+  vtkGetMacro(RefitTrees, vtkTypeBool);
+  vtkBooleanMacro(RefitTrees, vtkTypeBool);
+  //@}
+
   //@{
   /*
    * Set and Get the opacity of the polydata output when a collision takes place.
@@ -284,6 +298,8 @@ protected:
 
   int NumberOfCellsPerNode;
 
+  vtkTypeBool RefitTrees;
+
   int GenerateScalars;
 
   float BoxTolerance;
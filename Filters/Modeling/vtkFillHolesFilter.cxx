@@ -25,6 +25,7 @@
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
 #include "vtkSphere.h"
+#include "vtkStaticHalfEdgeMeshTemplate.h"
 #include "vtkTriangleStrip.h"
 
 vtkStandardNewMacro(vtkFillHolesFilter);
@@ -67,8 +68,6 @@ int vtkFillHolesFilter::RequestData(vtkInformation* vtkNotUsed(request),
     return 1;
   }
 
-  vtkPolyData* Mesh = vtkPolyData::New();
-  Mesh->SetPoints(inPts);
   vtkCellArray *newPolys, *inPolys = input->GetPolys();
   if (numStrips > 0)
   {
@@ -86,15 +85,16 @@ int vtkFillHolesFilter::RequestData(vtkInformation* vtkNotUsed(request),
     {
       vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
     }
-    Mesh->SetPolys(newPolys);
-    newPolys->Delete();
   }
   else
   {
     newPolys = inPolys;
-    Mesh->SetPolys(newPolys);
+    newPolys->Register(this);
   }
-  Mesh->BuildLinks();
+
+  // Build the half-edges to find the free edges
+  vtkStaticHalfEdgeMeshTemplate<vtkIdType> halfEdges;
+  halfEdges.BuildHalfEdges(numPts, newPolys);
 
   // Allocate storage for lines/points (arbitrary allocation sizes)
   //
@@ -106,7 +106,7 @@ int vtkFillHolesFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
   // grab all free edges and place them into a temporary polydata
   int abort = 0;
-  vtkIdType cellId, p1, p2, numNei, i, numCells = newPolys->GetNumberOfCells();
+  vtkIdType cellId, p1, p2, i, numCells = newPolys->GetNumberOfCells();
   vtkIdType progressInterval = numCells / 20 + 1;
   vtkIdList* neighbors = vtkIdList::New();
   neighbors->Allocate(VTK_CELL_SIZE);
@@ -123,10 +123,7 @@ int vtkFillHolesFilter::RequestData(vtkInformation* vtkNotUsed(request),
       p1 = pts[i];
       p2 = pts[(i + 1) % npts];
 
-      Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
-
-      if (numNei < 1)
+      if (halfEdges.GetNumberOfEdgeNeighbors(halfEdges.GetCellHalfEdge(cellId) + i) < 1)
       {
         newLines->InsertNextCell(2);
         newLines->InsertCellPoint(p1);
@@ -250,7 +247,7 @@ int vtkFillHolesFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
   output->SetStrips(input->GetStrips());
 
-  Mesh->Delete();
+  newPolys->Delete();
   newLines->Delete();
   return 1;
 }
@@ -15,16 +15,26 @@
 #include "vtkRibbonFilter.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellArrayIterator.h"
 #include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkLineNormalsInternal.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
-#include "vtkPolyLine.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
 
 vtkStandardNewMacro(vtkRibbonFilter);
 
@@ -78,19 +88,13 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* inPts;
   vtkIdType numPts;
   vtkIdType numLines;
-  vtkIdType numNewPts, numNewCells;
   vtkPoints* newPts;
   int deleteNormals = 0;
   vtkFloatArray* newNormals;
   vtkIdType i;
   double range[2];
   vtkCellArray* newStrips;
-  vtkIdType npts = 0;
-  const vtkIdType* pts = nullptr;
-  vtkIdType offset = 0;
   vtkFloatArray* newTCoords = nullptr;
-  int abort = 0;
-  vtkIdType inCellId;
 
   // Check input and initialize
   //
@@ -103,15 +107,10 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Create the geometry and topology
-  numNewPts = 2 * numPts;
   newPts = vtkPoints::New();
-  newPts->Allocate(numNewPts);
   newNormals = vtkFloatArray::New();
   newNormals->SetNumberOfComponents(3);
-  newNormals->Allocate(3 * numNewPts);
   newStrips = vtkCellArray::New();
-  newStrips->AllocateEstimate(1, numNewPts);
-  vtkCellArray* singlePolyline = vtkCellArray::New();
 
   // Point data: copy scalars, vectors, tcoords. Normals may be computed here.
   outPD->CopyNormalsOff();
@@ -121,10 +120,8 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     newTCoords = vtkFloatArray::New();
     newTCoords->SetNumberOfComponents(2);
-    newTCoords->Allocate(numNewPts);
     outPD->CopyTCoordsOff();
   }
-  outPD->CopyAllocate(pd, numNewPts);
 
   int generateNormals = 0;
   inNormals = this->GetInputArrayToProcess(1, inputVector);
@@ -163,69 +160,151 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  // Copy selected parts of cell data; certainly don't want normals
+  // Count the points of each polyline. The output of each polyline is then
+  // placed, with an exclusive scan of its size, and generated in parallel.
   //
-  numNewCells = inLines->GetNumberOfCells();
-  outCD->CopyNormalsOff();
-  outCD->CopyAllocate(cd, numNewCells);
-
-  //  Create points along each polyline that are connected into NumberOfSides
-  //  triangle strips. Texture coordinates are optionally generated.
+  std::vector<vtkIdType> lineNumPts(numLines);
+  std::vector<std::vector<std::string> > lineWarnings(numLines);
+  vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+    for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+    {
+      lineNumPts[lineId] = inLines->GetCellSize(lineId);
+      if (lineNumPts[lineId] < 2)
+      {
+        lineWarnings[lineId].emplace_back("Less than two points in line!");
+        lineNumPts[lineId] = 0;
+      }
+    }
+  });
+  this->UpdateProgress(0.25);
+
+  std::vector<vtkIdType> ptOffsets(numLines + 1);
+  std::vector<vtkIdType> stripIds(numLines + 1);
+  vtkNew<vtkIdList> srcPtIds;
+  vtkNew<vtkIdTypeArray> newOffsets;
+  vtkNew<vtkIdTypeArray> newConnectivity;
+  vtkNew<vtkIdList> srcCellIds;
+
+  //  Create points along each polyline that are connected into a triangle
+  //  strip. Texture coordinates are optionally generated. A polyline that
+  //  cannot be ribboned is removed from the layout, and the output is
+  //  generated again.
   //
   this->Theta = vtkMath::RadiansFromDegrees(this->Angle);
-  vtkPolyLine* lineNormalGenerator = vtkPolyLine::New();
-  for (inCellId = 0, inLines->InitTraversal(); inLines->GetNextCell(npts, pts) && !abort;
-       inCellId++)
+  for (bool firstPass = true;; firstPass = false)
   {
-    this->UpdateProgress((double)inCellId / numLines);
-    abort = this->GetAbortExecute();
-
-    if (npts < 2)
+    ptOffsets[0] = stripIds[0] = 0;
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
     {
-      vtkWarningMacro(<< "Less than two points in line!");
-      continue; // skip tubing this polyline
+      const vtkIdType npts = lineNumPts[lineId];
+      ptOffsets[lineId + 1] = this->ComputeOffset(ptOffsets[lineId], npts);
+      stripIds[lineId + 1] = stripIds[lineId] + (npts ? 1 : 0);
     }
-
-    // If necessary calculate normals, each polyline calculates its
-    // normals independently, avoiding conflicts at shared vertices.
-    if (generateNormals)
+    const vtkIdType numNewPts = ptOffsets[numLines];
+    const vtkIdType numNewStrips = stripIds[numLines];
+    newPts->SetNumberOfPoints(numNewPts);
+    newNormals->SetNumberOfTuples(numNewPts);
+    if (newTCoords)
     {
-      singlePolyline->Reset(); // avoid instantiation
-      singlePolyline->InsertNextCell(npts, pts);
-      if (!lineNormalGenerator->GenerateSlidingNormals(inPts, singlePolyline, inNormals))
-      {
-        vtkWarningMacro(<< "No normals for line!");
-        continue; // skip tubing this polyline
-      }
+      newTCoords->SetNumberOfTuples(numNewPts);
     }
-
-    // Generate the points around the polyline. The strip is not created
-    // if the polyline is bad.
-    //
-    if (!this->GeneratePoints(
-          offset, npts, pts, inPts, newPts, pd, outPD, newNormals, inScalars, range, inNormals))
+    srcPtIds->SetNumberOfIds(numNewPts);
+    // each strip uses each of its points once
+    newOffsets->SetNumberOfValues(numNewStrips + 1);
+    newOffsets->SetValue(numNewStrips, numNewPts);
+    newConnectivity->SetNumberOfValues(numNewPts);
+    srcCellIds->SetNumberOfIds(numNewStrips);
+
+    vtkSMPTools::For(0, numLines, [&](vtkIdType beginLine, vtkIdType endLine) {
+      auto lineIter = vtk::TakeSmartPointer(inLines->NewIterator());
+      vtkLineNormals lineNormals;
+      for (vtkIdType lineId = beginLine; lineId < endLine; ++lineId)
+      {
+        if (!lineNumPts[lineId])
+        {
+          continue; // skip tubing this polyline
+        }
+        vtkIdType npts;
+        const vtkIdType* pts;
+        lineIter->GetCellAtId(lineId, npts, pts);
+
+        // If necessary calculate normals, each polyline calculates its
+        // normals independently, avoiding conflicts at shared vertices.
+        vtkDataArray* normals = inNormals;
+        const vtkIdType* normalIds = pts;
+        if (generateNormals)
+        {
+          normals = lineNormals.Normals;
+          if (!lineNormals.Generate(inPts, npts, pts))
+          {
+            lineWarnings[lineId].emplace_back("No normals for line!");
+            lineNumPts[lineId] = 0;
+            continue; // skip tubing this polyline
+          }
+          normalIds = lineNormals.GetNormalIds();
+        }
+
+        // Generate the points around the polyline. The strip is not created
+        // if the polyline is bad.
+        //
+        if (!this->GeneratePoints(ptOffsets[lineId], npts, pts, inPts, newPts, srcPtIds,
+              newNormals, inScalars, range, normals, normalIds, lineWarnings[lineId]))
+        {
+          lineWarnings[lineId].emplace_back("Could not generate points!");
+          lineNumPts[lineId] = 0;
+          continue; // skip ribboning this polyline
+        }
+
+        // Generate the strip for this polyline
+        //
+        this->GenerateStrip(ptOffsets[lineId], npts, lineId, stripIds[lineId], ptOffsets[lineId],
+          newOffsets->GetPointer(0), newConnectivity->GetPointer(0), srcCellIds);
+
+        // Generate the texture coordinates for this polyline
+        //
+        if (newTCoords)
+        {
+          this->GenerateTextureCoords(ptOffsets[lineId], npts, pts, inPts, inScalars, newTCoords);
+        }
+      } // for all polylines
+    });
+
+    // Report the problems in the order of the polylines
+    bool failed = false;
+    for (vtkIdType lineId = 0; lineId < numLines; ++lineId)
     {
-      vtkWarningMacro(<< "Could not generate points!");
-      continue; // skip ribboning this polyline
+      if (firstPass)
+      {
+        for (const std::string& warning : lineWarnings[lineId])
+        {
+          vtkWarningMacro(<< warning);
+        }
+      }
+      lineWarnings[lineId].clear();
+      failed |= (!lineNumPts[lineId] && ptOffsets[lineId + 1] != ptOffsets[lineId]);
     }
-
-    // Generate the strip for this polyline
-    //
-    this->GenerateStrip(offset, npts, pts, inCellId, cd, outCD, newStrips);
-
-    // Generate the texture coordinates for this polyline
-    //
-    if (newTCoords)
+    if (!failed)
     {
-      this->GenerateTextureCoords(offset, npts, pts, inPts, inScalars, newTCoords);
+      break;
     }
+  }
+  this->UpdateProgress(0.75);
 
-    // Compute the new offset for the next polyline
-    offset = this->ComputeOffset(offset, npts);
-
-  } // for all polylines
-
-  singlePolyline->Delete();
+  // Copy the point data, and selected parts of the cell data; certainly
+  // don't want normals
+  //
+  vtkNew<vtkIdList> dstPtIds;
+  dstPtIds->SetNumberOfIds(srcPtIds->GetNumberOfIds());
+  std::iota(dstPtIds->GetPointer(0), dstPtIds->GetPointer(0) + dstPtIds->GetNumberOfIds(), 0);
+  outPD->CopyAllocate(pd, dstPtIds->GetNumberOfIds());
+  outPD->CopyData(pd, srcPtIds, dstPtIds);
+  vtkNew<vtkIdList> dstCellIds;
+  dstCellIds->SetNumberOfIds(srcCellIds->GetNumberOfIds());
+  std::iota(
+    dstCellIds->GetPointer(0), dstCellIds->GetPointer(0) + dstCellIds->GetNumberOfIds(), 0);
+  outCD->CopyNormalsOff();
+  outCD->CopyAllocate(cd, dstCellIds->GetNumberOfIds());
+  outCD->CopyData(cd, srcCellIds, dstCellIds);
 
   // Update ourselves
   //
@@ -243,12 +322,12 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
   output->SetPoints(newPts);
   newPts->Delete();
 
+  newStrips->SetData(newOffsets, newConnectivity);
   output->SetStrips(newStrips);
   newStrips->Delete();
 
   outPD->SetNormals(newNormals);
   newNormals->Delete();
-  lineNormalGenerator->Delete();
 
   output->Squeeze();
 
@@ -256,8 +335,9 @@ int vtkRibbonFilter::RequestData(vtkInformation* vtkNotUsed(request),
 }
 
 int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkIdType* pts,
-  vtkPoints* inPts, vtkPoints* newPts, vtkPointData* pd, vtkPointData* outPD,
-  vtkFloatArray* newNormals, vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals)
+  vtkPoints* inPts, vtkPoints* newPts, vtkIdList* srcIds, vtkFloatArray* newNormals,
+  vtkDataArray* inScalars, double range[2], vtkDataArray* inNormals, const vtkIdType* normalIds,
+  std::vector<std::string>& warnings)
 {
   vtkIdType j;
   int i;
@@ -310,11 +390,11 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
       }
     }
 
-    inNormals->GetTuple(pts[j], n);
+    inNormals->GetTuple(normalIds[j], n);
 
     if (vtkMath::Normalize(sNext) == 0.0)
     {
-      vtkWarningMacro(<< "Coincident points!");
+      warnings.emplace_back("Coincident points!");
       return 0;
     }
 
@@ -325,11 +405,11 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
     // if s is zero then just use sPrev cross n
     if (vtkMath::Normalize(s) == 0.0)
     {
-      vtkWarningMacro(<< "Using alternate bevel vector");
+      warnings.emplace_back("Using alternate bevel vector");
       vtkMath::Cross(sPrev, n, s);
       if (vtkMath::Normalize(s) == 0.0)
       {
-        vtkWarningMacro(<< "Using alternate bevel vector");
+        warnings.emplace_back("Using alternate bevel vector");
       }
     }
     /*
@@ -352,8 +432,10 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
     vtkMath::Cross(s, n, w);
     if (vtkMath::Normalize(w) == 0.0)
     {
-      vtkWarningMacro(<< "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0]
-                      << " " << n[1] << " " << n[2]);
+      std::ostringstream warning;
+      warning << "Bad normal s = " << s[0] << " " << s[1] << " " << s[2] << " n = " << n[0] << " "
+              << n[1] << " " << n[2];
+      warnings.push_back(warning.str());
       return 0;
     }
 
@@ -374,32 +456,32 @@ int vtkRibbonFilter::GeneratePoints(vtkIdType offset, vtkIdType npts, const vtkI
       sp[i] = p[i] + this->Width * sFactor * v[i];
       sm[i] = p[i] - this->Width * sFactor * v[i];
     }
-    newPts->InsertPoint(ptId, sm);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
+    newPts->SetPoint(ptId, sm);
+    newNormals->SetTuple(ptId, nP);
+    srcIds->SetId(ptId, pts[j]);
     ptId++;
-    newPts->InsertPoint(ptId, sp);
-    newNormals->InsertTuple(ptId, nP);
-    outPD->CopyData(pd, pts[j], ptId);
+    newPts->SetPoint(ptId, sp);
+    newNormals->SetTuple(ptId, nP);
+    srcIds->SetId(ptId, pts[j]);
     ptId++;
   } // for all points in polyline
 
   return 1;
 }
 
-void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts,
-  const vtkIdType* vtkNotUsed(pts), vtkIdType inCellId, vtkCellData* cd, vtkCellData* outCD,
-  vtkCellArray* newStrips)
+void vtkRibbonFilter::GenerateStrip(vtkIdType offset, vtkIdType npts, vtkIdType inCellId,
+  vtkIdType outCellId, vtkIdType connId, vtkIdType* stripOffsets, vtkIdType* connectivity,
+  vtkIdList* srcIds)
 {
-  vtkIdType i, idx, outCellId;
+  vtkIdType i, idx;
 
-  outCellId = newStrips->InsertNextCell(npts * 2);
-  outCD->CopyData(cd, inCellId, outCellId);
+  stripOffsets[outCellId] = connId;
+  srcIds->SetId(outCellId, inCellId);
   for (i = 0; i < npts; i++)
   {
     idx = 2 * i;
-    newStrips->InsertCellPoint(offset + idx);
-    newStrips->InsertCellPoint(offset + idx + 1);
+    connectivity[connId++] = offset + idx;
+    connectivity[connId++] = offset + idx + 1;
   }
 }
 
@@ -414,18 +496,18 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
   // The first texture coordinate is always 0.
   for (k = 0; k < 2; k++)
   {
-    newTCoords->InsertTuple2(offset + k, 0.0, 0.0);
+    newTCoords->SetTuple2(offset + k, 0.0, 0.0);
   }
   if (this->GenerateTCoords == VTK_TCOORDS_FROM_SCALARS && inScalars)
   {
-    s0 = inScalars->GetTuple1(pts[0]);
+    s0 = inScalars->GetComponent(pts[0], 0);
     for (i = 1; i < npts; i++)
     {
-      s = inScalars->GetTuple1(pts[i]);
+      s = inScalars->GetComponent(pts[i], 0);
       tc = (s - s0) / this->TextureLength;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
     }
   }
@@ -440,7 +522,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
       tc = len / this->TextureLength;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -468,7 +550,7 @@ void vtkRibbonFilter::GenerateTextureCoords(vtkIdType offset, vtkIdType npts, co
       tc = len / length;
       for (k = 0; k < 2; k++)
       {
-        newTCoords->InsertTuple2(offset + i * 2 + k, tc, 0.0);
+        newTCoords->SetTuple2(offset + i * 2 + k, tc, 0.0);
       }
       xPrev[0] = x[0];
       xPrev[1] = x[1];
@@ -17,6 +17,7 @@
 #include "vtkCellData.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
+#include "vtkFastWindingNumber.h"
 #include "vtkFeatureEdges.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
@@ -35,6 +36,8 @@
 #include "vtkStaticCellLocator.h"
 #include "vtkUnsignedCharArray.h"
 
+#include <cmath>
+
 vtkStandardNewMacro(vtkSelectEnclosedPoints);
 
 //----------------------------------------------------------------------------
@@ -136,6 +139,36 @@ struct SelectInOutCheck
   }
 }; // SelectInOutCheck
 
+//----------------------------------------------------------------------------
+// Classify the points from the winding number of the surface. The hierarchy
+// of the winding number must have been built.
+struct SelectWindingNumberCheck
+{
+  vtkDataSet* DataSet;
+  vtkSelectEnclosedPoints* Selector;
+  unsigned char* Hits;
+  vtkTypeBool InsideOut;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    unsigned char* hits = this->Hits + ptId;
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->DataSet->GetPoint(ptId, x);
+      const bool inside = this->Selector->IsInsideSurface(x) != 0;
+      *hits++ = (inside != static_cast<bool>(this->InsideOut) ? 1 : 0);
+    }
+  }
+
+  static void Execute(
+    vtkIdType numPts, vtkDataSet* ds, unsigned char* hits, vtkSelectEnclosedPoints* sel)
+  {
+    SelectWindingNumberCheck inOut{ ds, sel, hits, sel->GetInsideOut() };
+    vtkSMPTools::For(0, numPts, inOut);
+  }
+}; // SelectWindingNumberCheck
+
 } // anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -147,6 +180,7 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CheckSurface = false;
   this->InsideOut = 0;
   this->Tolerance = 0.0001;
+  this->Method = RAY_CASTING;
 
   this->InsideOutsideArray = nullptr;
 
@@ -154,6 +188,7 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CellLocator = vtkStaticCellLocator::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
+  this->WindingNumber = vtkFastWindingNumber::New();
 }
 
 //----------------------------------------------------------------------------
@@ -173,6 +208,13 @@ vtkSelectEnclosedPoints::~vtkSelectEnclosedPoints()
 
   this->CellIds->Delete();
   this->Cell->Delete();
+
+  if (this->WindingNumber)
+  {
+    vtkFastWindingNumber* windingNumber = this->WindingNumber;
+    this->WindingNumber = nullptr;
+    windingNumber->Delete();
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -214,8 +256,15 @@ int vtkSelectEnclosedPoints::RequestData(vtkInformation* vtkNotUsed(request),
   unsigned char* hitsPtr = static_cast<unsigned char*>(hits->GetVoidPointer(0));
 
   // Process the points in parallel
-  SelectInOutCheck::Execute(
-    numPts, input, surface, this->Bounds, this->Tolerance, this->CellLocator, hitsPtr, this);
+  if (this->Method == WINDING_NUMBER)
+  {
+    SelectWindingNumberCheck::Execute(numPts, input, hitsPtr, this);
+  }
+  else
+  {
+    SelectInOutCheck::Execute(
+      numPts, input, surface, this->Bounds, this->Tolerance, this->CellLocator, hitsPtr, this);
+  }
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
@@ -272,6 +321,15 @@ void vtkSelectEnclosedPoints::Initialize(vtkPolyData* surface)
   surface->GetBounds(this->Bounds);
   this->Length = surface->GetLength();
 
+  // The hierarchy of the winding number is only rebuilt if the surface
+  // has changed since the previous execution.
+  if (this->Method == WINDING_NUMBER)
+  {
+    this->WindingNumber->SetSurface(surface);
+    this->WindingNumber->BuildTree();
+    return;
+  }
+
   // Set up structures for acceleration ray casting
   this->CellLocator->SetDataSet(surface);
   this->CellLocator->BuildLocator();
@@ -302,9 +360,21 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x, double y, double z)
 
 //----------------------------------------------------------------------------
 // This is done to preserve backward compatibility. However it is not thread
-// safe due to the use of the data member CellIds and Cell.
+// safe due to the use of the data member CellIds and Cell, unless the
+// winding number is used.
 int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
 {
+  if (this->Method == WINDING_NUMBER)
+  {
+    const double* bds = this->Bounds;
+    if (x[0] < bds[0] || x[0] > bds[1] || x[1] < bds[2] || x[1] > bds[3] || x[2] < bds[4] ||
+      x[2] > bds[5])
+    {
+      return 0;
+    }
+    return std::abs(this->WindingNumber->EvaluateWindingNumber(x)) >= 0.5 ? 1 : 0;
+  }
+
   vtkIntersectionCounter counter(this->Tolerance, this->Length);
 
   return this->IsInsideSurface(x, this->Surface, this->Bounds, this->Length, this->Tolerance,
@@ -494,6 +564,7 @@ void vtkSelectEnclosedPoints::ReportReferences(vtkGarbageCollector* collector)
   // These filters share our input and are therefore involved in a
   // reference loop.
   vtkGarbageCollectorReport(collector, this->CellLocator, "CellLocator");
+  vtkGarbageCollectorReport(collector, this->WindingNumber, "WindingNumber");
 }
 
 //----------------------------------------------------------------------------
@@ -506,4 +577,8 @@ void vtkSelectEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Inside Out: " << (this->InsideOut ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Method: "
+     << (this->Method == WINDING_NUMBER ? "Winding Number\n" : "Ray Casting\n");
+  os << indent << "Winding Number: " << this->WindingNumber << "\n";
 }
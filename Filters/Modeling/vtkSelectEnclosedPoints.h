@@ -25,11 +25,21 @@
  * After running the filter, it is possible to query it as to whether a point
  * is inside/outside by invoking the IsInside(ptId) method.
  *
+ * Two methods are available to classify the points. By default, random
+ * rays are cast from each point through the surface and the intersections
+ * are counted, several rays voting on the result. Alternatively, the
+ * generalized winding number of the surface can be evaluated at each point
+ * with vtkFastWindingNumber, the point being inside when its magnitude is at
+ * least 0.5. The winding number is deterministic, robust to small holes and
+ * gaps in the surface, and its hierarchy is kept between executions, so that
+ * classifying many points against the same surface is much faster.
+ *
  * @warning
  * The filter assumes that the surface is closed and manifold. A boolean flag
  * can be set to force the filter to first check whether this is true. If false,
  * all points will be marked outside. Note that if this check is not performed
- * and the surface is not closed, the results are undefined.
+ * and the surface is not closed, the results are undefined (with the ray
+ * casting method; the winding number method degrades gracefully).
  *
  * @warning
  * This filter produces and output data array, but does not modify the input
@@ -43,7 +53,7 @@
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
  *
  * @sa
- * vtkMaskPoints vtkExtractEnclosedPoints
+ * vtkMaskPoints vtkExtractEnclosedPoints vtkFastWindingNumber
  */
 
 #ifndef vtkSelectEnclosedPoints_h
@@ -55,6 +65,7 @@
 
 class vtkUnsignedCharArray;
 class vtkAbstractCellLocator;
+class vtkFastWindingNumber;
 class vtkStaticCellLocator;
 class vtkIdList;
 class vtkGenericCell;
@@ -115,6 +126,33 @@ public:
   vtkGetMacro(CheckSurface, vtkTypeBool);
   //@}
 
+  /**
+   * The methods used to classify the points.
+   */
+  enum Methods
+  {
+    RAY_CASTING = 0,
+    WINDING_NUMBER = 1
+  };
+
+  //@{
+  /**
+   * Specify how the points are classified: by casting rays through the
+   * surface (the default), or by evaluating its generalized winding number.
+   */
+  vtkSetClampMacro(Method, int, RAY_CASTING, WINDING_NUMBER);
+  vtkGetMacro(Method, int);
+  void SetMethodToRayCasting() { this->SetMethod(RAY_CASTING); }
+  void SetMethodToWindingNumber() { this->SetMethod(WINDING_NUMBER); }
+  //@}
+
+  /**
+   * Return the object evaluating the winding number, for instance to
+   * adjust its accuracy. Its hierarchy is built on the first execution with
+   * the winding number method, and rebuilt only when the surface changes.
+   */
+  vtkGetObjectMacro(WindingNumber, vtkFastWindingNumber);
+
   /**
    * Query an input point id as to whether it is inside or outside. Note that
    * the result requires that the filter execute first.
@@ -125,6 +163,7 @@ public:
   /**
    * Specify the tolerance on the intersection. The tolerance is expressed as
    * a fraction of the diagonal of the bounding box of the enclosing surface.
+   * It is not used by the winding number method.
    */
   vtkSetClampMacro(Tolerance, double, 0.0, VTK_FLOAT_MAX);
   vtkGetMacro(Tolerance, double);
@@ -135,7 +174,8 @@ public:
    * This is a backdoor that can be used to test many points for containment.
    * First initialize the instance, then repeated calls to IsInsideSurface()
    * can be used without rebuilding the search structures. The Complete()
-   * method releases memory.
+   * method releases memory. The Method is honored; with the winding number
+   * method, IsInsideSurface() is thread safe.
    */
   void Initialize(vtkPolyData* surface);
   int IsInsideSurface(double x[3]);
@@ -170,6 +210,7 @@ protected:
   vtkTypeBool CheckSurface;
   vtkTypeBool InsideOut;
   double Tolerance;
+  int Method;
 
   vtkUnsignedCharArray* InsideOutsideArray;
 
@@ -177,6 +218,7 @@ protected:
   vtkStaticCellLocator* CellLocator;
   vtkIdList* CellIds;
   vtkGenericCell* Cell;
+  vtkFastWindingNumber* WindingNumber;
   vtkPolyData* Surface;
   double Bounds[6];
   double Length;
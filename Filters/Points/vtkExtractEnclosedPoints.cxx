@@ -19,6 +19,7 @@
 #include "vtkDataArrayRange.h"
 #include "vtkDataSet.h"
 #include "vtkExecutive.h"
+#include "vtkFastWindingNumber.h"
 #include "vtkFeatureEdges.h"
 #include "vtkGarbageCollector.h"
 #include "vtkGenericCell.h"
@@ -40,6 +41,7 @@
 #include "vtkUnsignedCharArray.h"
 
 #include <algorithm>
+#include <cmath>
 
 vtkStandardNewMacro(vtkExtractEnclosedPoints);
 
@@ -142,6 +144,51 @@ struct ExtractLauncher
   }
 };
 
+//----------------------------------------------------------------------------
+// Classify the points from the winding number of the surface, whose
+// hierarchy must have been built.
+template <typename ArrayT>
+struct ExtractWindingNumberCheck
+{
+  ArrayT* Points;
+  vtkFastWindingNumber* WindingNumber;
+  const double* Bounds;
+  vtkIdType* PointMap;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    const auto points = vtk::DataArrayTupleRange(this->Points);
+    const double* bds = this->Bounds;
+    vtkIdType* map = this->PointMap + ptId;
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      const auto pt = points[ptId];
+
+      x[0] = static_cast<double>(pt[0]);
+      x[1] = static_cast<double>(pt[1]);
+      x[2] = static_cast<double>(pt[2]);
+
+      const bool hit = x[0] >= bds[0] && x[0] <= bds[1] && x[1] >= bds[2] && x[1] <= bds[3] &&
+        x[2] >= bds[4] && x[2] <= bds[5] &&
+        std::abs(this->WindingNumber->EvaluateWindingNumber(x)) >= 0.5;
+      *map++ = (hit ? 1 : -1);
+    }
+  }
+}; // ExtractWindingNumberCheck
+
+struct WindingNumberLauncher
+{
+  template <typename ArrayT>
+  void operator()(
+    ArrayT* pts, vtkFastWindingNumber* windingNumber, const double* bds, vtkIdType* hits)
+  {
+    ExtractWindingNumberCheck<ArrayT> inOut{ pts, windingNumber, bds, hits };
+    vtkSMPTools::For(0, pts->GetNumberOfTuples(), inOut);
+  }
+};
+
 } // anonymous namespace
 
 //----------------------------------------------------------------------------
@@ -152,10 +199,16 @@ vtkExtractEnclosedPoints::vtkExtractEnclosedPoints()
 
   this->CheckSurface = false;
   this->Tolerance = 0.001;
+  this->Method = RAY_CASTING;
+  this->Surface = nullptr;
+  this->WindingNumber = vtkFastWindingNumber::New();
 }
 
 //----------------------------------------------------------------------------
-vtkExtractEnclosedPoints::~vtkExtractEnclosedPoints() = default;
+vtkExtractEnclosedPoints::~vtkExtractEnclosedPoints()
+{
+  this->WindingNumber->Delete();
+}
 
 //----------------------------------------------------------------------------
 // Partial implementation invokes vtkPointCloudFilter::RequestData(). This is
@@ -192,23 +245,38 @@ int vtkExtractEnclosedPoints::RequestData(
 // the enclosing surface.
 int vtkExtractEnclosedPoints::FilterPoints(vtkPointSet* input)
 {
-  // Initiailize search structures
-  vtkStaticCellLocator* locator = vtkStaticCellLocator::New();
-
   vtkPolyData* surface = this->Surface;
   double bds[6];
   surface->GetBounds(bds);
 
+  using vtkArrayDispatch::Reals;
+  using Dispatcher = vtkArrayDispatch::DispatchByValueType<Reals>;
+  vtkDataArray* ptArray = input->GetPoints()->GetData();
+
+  // The hierarchy of the winding number is only rebuilt if the surface has
+  // changed since the previous execution.
+  if (this->Method == WINDING_NUMBER)
+  {
+    this->WindingNumber->SetSurface(surface);
+    this->WindingNumber->BuildTree();
+    WindingNumberLauncher worker;
+    if (!Dispatcher::Execute(ptArray, worker, this->WindingNumber, bds, this->PointMap))
+    { // fallback for other arrays:
+      worker(ptArray, this->WindingNumber, bds, this->PointMap);
+    }
+    return 1;
+  }
+
+  // Initiailize search structures
+  vtkStaticCellLocator* locator = vtkStaticCellLocator::New();
+
   // Set up structures for acceleration ray casting
   locator->SetDataSet(surface);
   locator->BuildLocator();
 
   // Loop over all input points determining inside/outside
   // Use fast path for float/double points:
-  using vtkArrayDispatch::Reals;
-  using Dispatcher = vtkArrayDispatch::DispatchByValueType<Reals>;
   ExtractLauncher worker;
-  vtkDataArray* ptArray = input->GetPoints()->GetData();
   if (!Dispatcher::Execute(ptArray, worker, surface, bds, this->Tolerance, locator, this->PointMap))
   { // fallback for other arrays:
     worker(ptArray, surface, bds, this->Tolerance, locator, this->PointMap);
@@ -276,4 +344,8 @@ void vtkExtractEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Check Surface: " << (this->CheckSurface ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Method: "
+     << (this->Method == WINDING_NUMBER ? "Winding Number\n" : "Ray Casting\n");
+  os << indent << "Winding Number: " << this->WindingNumber << "\n";
 }
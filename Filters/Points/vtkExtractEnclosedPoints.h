@@ -25,11 +25,17 @@
  * available for generating an in/out mask, and also extracting points
  * outside of the enclosing surface.
  *
+ * As with vtkSelectEnclosedPoints, the points are classified either by ray
+ * casting (the default) or from the generalized winding number of the
+ * surface (see vtkFastWindingNumber). The winding number is robust to small
+ * gaps in the surface, and its hierarchy is kept between executions.
+ *
  * @warning
  * The filter assumes that the surface is closed and manifold. A boolean flag
  * can be set to force the filter to first check whether this is true. If false,
  * all points will be marked outside. Note that if this check is not performed
- * and the surface is not closed, the results are undefined.
+ * and the surface is not closed, the results are undefined (with the ray
+ * casting method; the winding number method degrades gracefully).
  *
  * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
@@ -47,7 +53,7 @@
  * its methods to vtkSelectEnclosedPoints.
  *
  * @sa
- * vtkSelectEnclosedPoints vtkExtractPoints
+ * vtkSelectEnclosedPoints vtkExtractPoints vtkFastWindingNumber
  */
 
 #ifndef vtkExtractEnclosedPoints_h
@@ -56,6 +62,8 @@
 #include "vtkFiltersPointsModule.h" // For export macro
 #include "vtkPointCloudFilter.h"
 
+class vtkFastWindingNumber;
+
 class VTKFILTERSPOINTS_EXPORT vtkExtractEnclosedPoints : public vtkPointCloudFilter
 {
 public:
@@ -100,20 +108,50 @@ public:
   /**
    * Specify the tolerance on the intersection. The tolerance is expressed as
    * a fraction of the diagonal of the bounding box of the enclosing surface.
+   * It is not used by the winding number method.
    */
   vtkSetClampMacro(Tolerance, double, 0.0, VTK_FLOAT_MAX);
   vtkGetMacro(Tolerance, double);
   //@}
 
+  /**
+   * The methods used to classify the points.
+   */
+  enum Methods
+  {
+    RAY_CASTING = 0,
+    WINDING_NUMBER = 1
+  };
+
+  //@{
+  /**
+   * Specify how the points are classified: by casting rays through the
+   * surface (the default), or by evaluating its generalized winding number.
+   */
+  vtkSetClampMacro(Method, int, RAY_CASTING, WINDING_NUMBER);
+  vtkGetMacro(Method, int);
+  void SetMethodToRayCasting() { this->SetMethod(RAY_CASTING); }
+  void SetMethodToWindingNumber() { this->SetMethod(WINDING_NUMBER); }
+  //@}
+
+  /**
+   * Return the object evaluating the winding number, for instance to
+   * adjust its accuracy. Its hierarchy is built on the first execution with
+   * the winding number method, and rebuilt only when the surface changes.
+   */
+  vtkGetObjectMacro(WindingNumber, vtkFastWindingNumber);
+
 protected:
   vtkExtractEnclosedPoints();
   ~vtkExtractEnclosedPoints() override;
 
   vtkTypeBool CheckSurface;
   double Tolerance;
+  int Method;
 
   // Internal structures for managing the intersection testing
   vtkPolyData* Surface;
+  vtkFastWindingNumber* WindingNumber;
 
   // Satisfy vtkPointCloudFilter superclass API
   int FilterPoints(vtkPointSet* input) override;
@@ -0,0 +1,280 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    MeshQualityCells.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Check that the cell quality computed by vtkMeshQuality on a large mixed
+// mesh matches the quality functions applied to each cell, that the mesh
+// statistics summarize the cell quality, and that the tetrahedron volumes
+// are saved for every cell.
+
+#include "vtkMeshQuality.h"
+
+#include "vtkCell.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const int Size = 12;
+
+vtkIdType PointId(int i, int j, int k)
+{
+  return i + (Size + 1) * (j + (Size + 1) * k);
+}
+
+// A perturbed grid whose cells are split into hexahedra, tetrahedra, wedges,
+// and quadrilaterals and triangles on their bottom and top faces.
+void MakeMesh(vtkUnstructuredGrid* mesh)
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2);
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k <= Size; ++k)
+  {
+    for (int j = 0; j <= Size; ++j)
+    {
+      for (int i = 0; i <= Size; ++i)
+      {
+        double x[3] = { static_cast<double>(i), static_cast<double>(j),
+          static_cast<double>(k) };
+        for (int c = 0; c < 3; ++c)
+        {
+          random->Next();
+          x[c] += random->GetRangeValue(-0.2, 0.2);
+        }
+        points->InsertNextPoint(x);
+      }
+    }
+  }
+  mesh->SetPoints(points);
+
+  mesh->AllocateEstimate(2 * Size * Size * Size, 8);
+  for (int k = 0; k < Size; ++k)
+  {
+    for (int j = 0; j < Size; ++j)
+    {
+      for (int i = 0; i < Size; ++i)
+      {
+        const vtkIdType h[8] = { PointId(i, j, k), PointId(i + 1, j, k),
+          PointId(i + 1, j + 1, k), PointId(i, j + 1, k), PointId(i, j, k + 1),
+          PointId(i + 1, j, k + 1), PointId(i + 1, j + 1, k + 1), PointId(i, j + 1, k + 1) };
+        switch ((i + 2 * j + 3 * k) % 4)
+        {
+          case 0:
+            mesh->InsertNextCell(VTK_HEXAHEDRON, 8, h);
+            break;
+          case 1:
+          {
+            const vtkIdType tet0[4] = { h[0], h[1], h[3], h[4] };
+            const vtkIdType tet1[4] = { h[1], h[2], h[3], h[6] };
+            mesh->InsertNextCell(VTK_TETRA, 4, tet0);
+            mesh->InsertNextCell(VTK_TETRA, 4, tet1);
+            break;
+          }
+          case 2:
+          {
+            const vtkIdType wedge[6] = { h[0], h[1], h[3], h[4], h[5], h[7] };
+            mesh->InsertNextCell(VTK_WEDGE, 6, wedge);
+            break;
+          }
+          default:
+          {
+            const vtkIdType quad[4] = { h[0], h[1], h[2], h[3] };
+            const vtkIdType tri[3] = { h[4], h[5], h[6] };
+            mesh->InsertNextCell(VTK_QUAD, 4, quad);
+            mesh->InsertNextCell(VTK_TRIANGLE, 3, tri);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+bool Close(double a, double b)
+{
+  return std::fabs(a - b) <= 1.0e-9 * (1.0 + std::fabs(a) + std::fabs(b));
+}
+
+// Compare the statistics of one type of cell with the cell quality
+int CheckStatistics(vtkMeshQuality* filter, int cellType, const char* arrayName)
+{
+  vtkDataSet* output = filter->GetOutput();
+  vtkDataArray* quality = output->GetCellData()->GetArray("Quality");
+  double min = VTK_DOUBLE_MAX;
+  double max = VTK_DOUBLE_MIN;
+  double sum = 0.0;
+  double sum2 = 0.0;
+  vtkIdType count = 0;
+  for (vtkIdType cellId = 0; cellId < output->GetNumberOfCells(); ++cellId)
+  {
+    if (output->GetCellType(cellId) == cellType)
+    {
+      const double q = quality->GetComponent(cellId, 0);
+      min = std::min(min, q);
+      max = std::max(max, q);
+      sum += q;
+      sum2 += q * q;
+      ++count;
+    }
+  }
+  const double mean = sum / count;
+  const double variance = (sum2 - count * mean * mean) / (count - 1);
+
+  double stats[5];
+  output->GetFieldData()->GetArray(arrayName)->GetTuple(0, stats);
+  if (stats[0] != min || stats[2] != max || !Close(stats[1], mean) ||
+    !Close(stats[3], variance) || stats[4] != count)
+  {
+    cerr << arrayName << ": wrong statistics" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+typedef double (*QualityFunction)(vtkCell*);
+
+// Compare the quality of each cell with the quality function of its type
+int CheckQuality(vtkUnstructuredGrid* mesh, int measure, QualityFunction triangle,
+  QualityFunction quad, QualityFunction tet, QualityFunction hex)
+{
+  vtkNew<vtkMeshQuality> filter;
+  filter->SetInputData(mesh);
+  filter->SetTriangleQualityMeasure(measure);
+  filter->SetQuadQualityMeasure(measure);
+  filter->SetTetQualityMeasure(measure);
+  filter->SetHexQualityMeasure(measure);
+  filter->Update();
+
+  vtkDataArray* quality = filter->GetOutput()->GetCellData()->GetArray("Quality");
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    vtkCell* cell = mesh->GetCell(cellId);
+    double expected = 0.0;
+    switch (cell->GetCellType())
+    {
+      case VTK_TRIANGLE:
+        expected = triangle(cell);
+        break;
+      case VTK_QUAD:
+        expected = quad(cell);
+        break;
+      case VTK_TETRA:
+        expected = tet(cell);
+        break;
+      case VTK_HEXAHEDRON:
+        expected = hex(cell);
+        break;
+    }
+    if (quality->GetComponent(cellId, 0) != expected)
+    {
+      cerr << "Measure " << measure << ": wrong quality for cell " << cellId << endl;
+      return 1;
+    }
+  }
+
+  return CheckStatistics(filter, VTK_TRIANGLE, "Mesh Triangle Quality") ||
+    CheckStatistics(filter, VTK_QUAD, "Mesh Quadrilateral Quality") ||
+    CheckStatistics(filter, VTK_TETRA, "Mesh Tetrahedron Quality") ||
+    CheckStatistics(filter, VTK_HEXAHEDRON, "Mesh Hexahedron Quality");
+}
+
+int CheckVolume(vtkUnstructuredGrid* mesh)
+{
+  // In compatibility mode, the volume and the quality share one array
+  vtkNew<vtkMeshQuality> filter;
+  filter->SetInputData(mesh);
+  filter->VolumeOn();
+  filter->Update();
+  vtkDataArray* quality = filter->GetOutput()->GetCellData()->GetArray("Quality");
+  if (quality->GetNumberOfComponents() != 2)
+  {
+    cerr << "No volume in compatibility mode" << endl;
+    return 1;
+  }
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    vtkCell* cell = mesh->GetCell(cellId);
+    const bool tet = (cell->GetCellType() == VTK_TETRA);
+    if (quality->GetComponent(cellId, 0) != (tet ? vtkMeshQuality::TetVolume(cell) : 0.0) ||
+      (tet && quality->GetComponent(cellId, 1) != vtkMeshQuality::TetRadiusRatio(cell)))
+    {
+      cerr << "Wrong volume or quality for cell " << cellId << " in compatibility mode" << endl;
+      return 1;
+    }
+  }
+
+  // Otherwise the volume has its own array
+  filter->CompatibilityModeOff();
+  filter->Update();
+  vtkDataArray* volume = filter->GetOutput()->GetCellData()->GetArray("Volume");
+  if (!volume || volume->GetNumberOfTuples() != mesh->GetNumberOfCells())
+  {
+    cerr << "No volume array" << endl;
+    return 1;
+  }
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    vtkCell* cell = mesh->GetCell(cellId);
+    const double expected =
+      (cell->GetCellType() == VTK_TETRA ? vtkMeshQuality::TetVolume(cell) : 0.0);
+    if (volume->GetComponent(cellId, 0) != expected)
+    {
+      cerr << "Wrong volume for cell " << cellId << endl;
+      return 1;
+    }
+  }
+
+  // Without the cell quality, only the statistics are computed
+  filter->SaveCellQualityOff();
+  filter->Update();
+  if (filter->GetOutput()->GetCellData()->GetArray("Volume") ||
+    !filter->GetOutput()->GetFieldData()->GetArray("Mesh Tetrahedron Quality"))
+  {
+    cerr << "Wrong output without the cell quality" << endl;
+    return 1;
+  }
+  return 0;
+}
+}
+
+int MeshQualityCells(int, char*[])
+{
+  vtkNew<vtkUnstructuredGrid> mesh;
+  MakeMesh(mesh);
+
+  if (CheckQuality(mesh, VTK_QUALITY_SCALED_JACOBIAN, vtkMeshQuality::TriangleScaledJacobian,
+        vtkMeshQuality::QuadScaledJacobian, vtkMeshQuality::TetScaledJacobian,
+        vtkMeshQuality::HexScaledJacobian) ||
+    CheckQuality(mesh, VTK_QUALITY_SHAPE, vtkMeshQuality::TriangleShape,
+      vtkMeshQuality::QuadShape, vtkMeshQuality::TetShape, vtkMeshQuality::HexShape) ||
+    CheckQuality(mesh, VTK_QUALITY_RELATIVE_SIZE_SQUARED,
+      vtkMeshQuality::TriangleRelativeSizeSquared, vtkMeshQuality::QuadRelativeSizeSquared,
+      vtkMeshQuality::TetRelativeSizeSquared, vtkMeshQuality::HexRelativeSizeSquared) ||
+    CheckQuality(mesh, VTK_QUALITY_DISTORTION, vtkMeshQuality::TriangleDistortion,
+      vtkMeshQuality::QuadDistortion, vtkMeshQuality::TetDistortion,
+      vtkMeshQuality::HexDistortion) ||
+    CheckVolume(mesh))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
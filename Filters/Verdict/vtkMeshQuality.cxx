@@ -28,22 +28,43 @@
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkIdList.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTetra.h"
 #include "vtkTriangle.h"
 
 #include "vtk_verdict.h"
 
+#include <algorithm>
+#include <vector>
+
 vtkStandardNewMacro(vtkMeshQuality);
 
-typedef double (*CellQualityType)(vtkCell*);
+typedef double (*CellQualityType)(int, double[][3]);
 
 double TetVolume(vtkCell* cell);
 
+namespace
+{
+// Gather the coordinates of the points of a cell. A hexahedron is the largest
+// cell evaluated by the quality functions, so extra points are ignored.
+void GetCellCoordinates(vtkDataSet* ds, vtkIdType cellId, vtkIdList* ptIds, double pc[8][3])
+{
+  ds->GetCellPoints(cellId, ptIds);
+  const vtkIdType npts = std::min(ptIds->GetNumberOfIds(), static_cast<vtkIdType>(8));
+  for (vtkIdType i = 0; i < npts; ++i)
+  {
+    ds->GetPoint(ptIds->GetId(i), pc[i]);
+  }
+}
+}
+
 static const char* QualityMeasureNames[] = { "EdgeRatio", "AspectRatio", "RadiusRatio",
   "AspectFrobenius", "MedAspectFrobenius", "MaxAspectFrobenius", "MinAngle", "CollapseRatio",
   "MaxAngle", "Condition", "ScaledJacobian", "Shear", "RelativeSizeSquared", "Shape",
@@ -104,13 +125,11 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
   double qquam, qquaM, Eqqua, Eqqua2;
   double qtetm, qtetM, Eqtet, Eqtet2;
   double qhexm, qhexM, Eqhex, Eqhex2;
-  double q;
-  double V = 0.;
   vtkIdType ntri = 0;
   vtkIdType nqua = 0;
   vtkIdType ntet = 0;
   vtkIdType nhex = 0;
-  vtkCell* cell;
+  vtkSMPThreadLocalObject<vtkIdList> tlPtIds;
   int progressNumer = 0;
   double progressDenom = 20.;
 
@@ -130,258 +149,264 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
   switch (this->GetTriangleQualityMeasure())
   {
     case VTK_QUALITY_AREA:
-      TriangleQuality = TriangleArea;
+      TriangleQuality = v_tri_area;
       break;
     case VTK_QUALITY_EDGE_RATIO:
-      TriangleQuality = TriangleEdgeRatio;
+      TriangleQuality = v_tri_edge_ratio;
       break;
     case VTK_QUALITY_ASPECT_RATIO:
-      TriangleQuality = TriangleAspectRatio;
+      TriangleQuality = v_tri_aspect_ratio;
       break;
     case VTK_QUALITY_RADIUS_RATIO:
-      TriangleQuality = TriangleRadiusRatio;
+      TriangleQuality = v_tri_radius_ratio;
       break;
     case VTK_QUALITY_ASPECT_FROBENIUS:
-      TriangleQuality = TriangleAspectFrobenius;
+      TriangleQuality = v_tri_aspect_frobenius;
       break;
     case VTK_QUALITY_MIN_ANGLE:
-      TriangleQuality = TriangleMinAngle;
+      TriangleQuality = v_tri_minimum_angle;
       break;
     case VTK_QUALITY_MAX_ANGLE:
-      TriangleQuality = TriangleMaxAngle;
+      TriangleQuality = v_tri_maximum_angle;
       break;
     case VTK_QUALITY_CONDITION:
-      TriangleQuality = TriangleCondition;
+      TriangleQuality = v_tri_condition;
       break;
     case VTK_QUALITY_SCALED_JACOBIAN:
-      TriangleQuality = TriangleScaledJacobian;
+      TriangleQuality = v_tri_scaled_jacobian;
       break;
     case VTK_QUALITY_RELATIVE_SIZE_SQUARED:
-      TriangleQuality = TriangleRelativeSizeSquared;
+      TriangleQuality = v_tri_relative_size_squared;
       break;
     case VTK_QUALITY_SHAPE:
-      TriangleQuality = TriangleShape;
+      TriangleQuality = v_tri_shape;
       break;
     case VTK_QUALITY_SHAPE_AND_SIZE:
-      TriangleQuality = TriangleShapeAndSize;
+      TriangleQuality = v_tri_shape_and_size;
       break;
     case VTK_QUALITY_DISTORTION:
-      TriangleQuality = TriangleDistortion;
+      TriangleQuality = v_tri_distortion;
       break;
     default:
       vtkWarningMacro("Bad TriangleQualityMeasure (" << this->GetTriangleQualityMeasure()
                                                      << "), using RadiusRatio instead");
-      TriangleQuality = TriangleRadiusRatio;
+      TriangleQuality = v_tri_radius_ratio;
       break;
   }
 
   switch (this->GetQuadQualityMeasure())
   {
     case VTK_QUALITY_EDGE_RATIO:
-      QuadQuality = QuadEdgeRatio;
+      QuadQuality = v_quad_edge_ratio;
       break;
     case VTK_QUALITY_ASPECT_RATIO:
-      QuadQuality = QuadAspectRatio;
+      QuadQuality = v_quad_aspect_ratio;
       break;
     case VTK_QUALITY_RADIUS_RATIO:
-      QuadQuality = QuadRadiusRatio;
+      QuadQuality = v_quad_radius_ratio;
       break;
     case VTK_QUALITY_MED_ASPECT_FROBENIUS:
-      QuadQuality = QuadMedAspectFrobenius;
+      QuadQuality = v_quad_med_aspect_frobenius;
       break;
     case VTK_QUALITY_MAX_ASPECT_FROBENIUS:
-      QuadQuality = QuadMaxAspectFrobenius;
+      QuadQuality = v_quad_max_aspect_frobenius;
       break;
     case VTK_QUALITY_MIN_ANGLE:
-      QuadQuality = QuadMinAngle;
+      QuadQuality = v_quad_minimum_angle;
       break;
     case VTK_QUALITY_MAX_EDGE_RATIO:
-      QuadQuality = QuadMaxEdgeRatios;
+      QuadQuality = v_quad_max_edge_ratio;
       break;
     case VTK_QUALITY_SKEW:
-      QuadQuality = QuadSkew;
+      QuadQuality = v_quad_skew;
       break;
     case VTK_QUALITY_TAPER:
-      QuadQuality = QuadTaper;
+      QuadQuality = v_quad_taper;
       break;
     case VTK_QUALITY_WARPAGE:
-      QuadQuality = QuadWarpage;
+      QuadQuality = v_quad_warpage;
       break;
     case VTK_QUALITY_AREA:
-      QuadQuality = QuadArea;
+      QuadQuality = v_quad_area;
       break;
     case VTK_QUALITY_STRETCH:
-      QuadQuality = QuadStretch;
+      QuadQuality = v_quad_stretch;
       break;
     // case VTK_QUALITY_MIN_ANGLE:
     case VTK_QUALITY_MAX_ANGLE:
-      QuadQuality = QuadMaxAngle;
+      QuadQuality = v_quad_maximum_angle;
       break;
     case VTK_QUALITY_ODDY:
-      QuadQuality = QuadOddy;
+      QuadQuality = v_quad_oddy;
       break;
     case VTK_QUALITY_CONDITION:
-      QuadQuality = QuadCondition;
+      QuadQuality = v_quad_condition;
       break;
     case VTK_QUALITY_JACOBIAN:
-      QuadQuality = QuadJacobian;
+      QuadQuality = v_quad_jacobian;
       break;
     case VTK_QUALITY_SCALED_JACOBIAN:
-      QuadQuality = QuadScaledJacobian;
+      QuadQuality = v_quad_scaled_jacobian;
       break;
     case VTK_QUALITY_SHEAR:
-      QuadQuality = QuadShear;
+      QuadQuality = v_quad_shear;
       break;
     case VTK_QUALITY_SHAPE:
-      QuadQuality = QuadShape;
+      QuadQuality = v_quad_shape;
       break;
     case VTK_QUALITY_RELATIVE_SIZE_SQUARED:
-      QuadQuality = QuadRelativeSizeSquared;
+      QuadQuality = v_quad_relative_size_squared;
       break;
     case VTK_QUALITY_SHAPE_AND_SIZE:
-      QuadQuality = QuadShapeAndSize;
+      QuadQuality = v_quad_shape_and_size;
       break;
     case VTK_QUALITY_SHEAR_AND_SIZE:
-      QuadQuality = QuadShearAndSize;
+      QuadQuality = v_quad_shear_and_size;
       break;
     case VTK_QUALITY_DISTORTION:
-      QuadQuality = QuadDistortion;
+      QuadQuality = v_quad_distortion;
       break;
     default:
       vtkWarningMacro("Bad QuadQualityMeasure (" << this->GetQuadQualityMeasure()
                                                  << "), using EdgeRatio instead");
-      QuadQuality = QuadEdgeRatio;
+      QuadQuality = v_quad_edge_ratio;
       break;
   }
 
   switch (this->GetTetQualityMeasure())
   {
     case VTK_QUALITY_EDGE_RATIO:
-      TetQuality = TetEdgeRatio;
+      TetQuality = v_tet_edge_ratio;
       break;
     case VTK_QUALITY_ASPECT_RATIO:
-      TetQuality = TetAspectRatio;
+      TetQuality = v_tet_aspect_ratio;
       break;
     case VTK_QUALITY_RADIUS_RATIO:
-      TetQuality = TetRadiusRatio;
+      TetQuality = v_tet_radius_ratio;
       break;
     case VTK_QUALITY_ASPECT_FROBENIUS:
-      TetQuality = TetAspectFrobenius;
+      TetQuality = v_tet_aspect_frobenius;
       break;
     case VTK_QUALITY_MIN_ANGLE:
-      TetQuality = TetMinAngle;
+      TetQuality = v_tet_minimum_angle;
       break;
     case VTK_QUALITY_COLLAPSE_RATIO:
-      TetQuality = TetCollapseRatio;
+      TetQuality = v_tet_collapse_ratio;
       break;
     case VTK_QUALITY_ASPECT_BETA:
-      TetQuality = TetAspectBeta;
+      TetQuality = v_tet_aspect_beta;
       break;
     case VTK_QUALITY_ASPECT_GAMMA:
-      TetQuality = TetAspectGamma;
+      TetQuality = v_tet_aspect_gamma;
       break;
     case VTK_QUALITY_VOLUME:
-      TetQuality = TetVolume;
+      TetQuality = v_tet_volume;
       break;
     case VTK_QUALITY_CONDITION:
-      TetQuality = TetCondition;
+      TetQuality = v_tet_condition;
       break;
     case VTK_QUALITY_JACOBIAN:
-      TetQuality = TetJacobian;
+      TetQuality = v_tet_jacobian;
       break;
     case VTK_QUALITY_SCALED_JACOBIAN:
-      TetQuality = TetScaledJacobian;
+      TetQuality = v_tet_scaled_jacobian;
       break;
     case VTK_QUALITY_SHAPE:
-      TetQuality = TetShape;
+      TetQuality = v_tet_shape;
       break;
     case VTK_QUALITY_RELATIVE_SIZE_SQUARED:
-      TetQuality = TetRelativeSizeSquared;
+      TetQuality = v_tet_relative_size_squared;
       break;
     case VTK_QUALITY_SHAPE_AND_SIZE:
-      TetQuality = TetShapeandSize;
+      TetQuality = v_tet_shape_and_size;
       break;
     case VTK_QUALITY_DISTORTION:
-      TetQuality = TetDistortion;
+      TetQuality = v_tet_distortion;
       break;
     default:
       vtkWarningMacro("Bad TetQualityMeasure (" << this->GetTetQualityMeasure()
                                                 << "), using RadiusRatio instead");
-      TetQuality = TetRadiusRatio;
+      TetQuality = v_tet_radius_ratio;
       break;
   }
 
   switch (this->GetHexQualityMeasure())
   {
     case VTK_QUALITY_EDGE_RATIO:
-      HexQuality = HexEdgeRatio;
+      HexQuality = v_hex_edge_ratio;
       break;
     case VTK_QUALITY_MED_ASPECT_FROBENIUS:
-      HexQuality = HexMedAspectFrobenius;
+      HexQuality = v_hex_med_aspect_frobenius;
       break;
     case VTK_QUALITY_MAX_ASPECT_FROBENIUS:
-      HexQuality = HexMaxAspectFrobenius;
+      HexQuality = v_hex_max_aspect_frobenius;
       break;
     case VTK_QUALITY_MAX_EDGE_RATIO:
-      HexQuality = HexMaxEdgeRatio;
+      HexQuality = v_hex_max_edge_ratio;
       break;
     case VTK_QUALITY_SKEW:
-      HexQuality = HexSkew;
+      HexQuality = v_hex_skew;
       break;
     case VTK_QUALITY_TAPER:
-      HexQuality = HexTaper;
+      HexQuality = v_hex_taper;
       break;
     case VTK_QUALITY_VOLUME:
-      HexQuality = HexVolume;
+      HexQuality = v_hex_volume;
       break;
     case VTK_QUALITY_STRETCH:
-      HexQuality = HexStretch;
+      HexQuality = v_hex_stretch;
       break;
     case VTK_QUALITY_DIAGONAL:
-      HexQuality = HexDiagonal;
+      HexQuality = v_hex_diagonal;
       break;
     case VTK_QUALITY_DIMENSION:
-      HexQuality = HexDimension;
+      HexQuality = v_hex_dimension;
       break;
     case VTK_QUALITY_ODDY:
-      HexQuality = HexOddy;
+      HexQuality = v_hex_oddy;
       break;
     case VTK_QUALITY_CONDITION:
-      HexQuality = HexCondition;
+      HexQuality = v_hex_condition;
       break;
     case VTK_QUALITY_JACOBIAN:
-      HexQuality = HexJacobian;
+      HexQuality = v_hex_jacobian;
       break;
     case VTK_QUALITY_SCALED_JACOBIAN:
-      HexQuality = HexScaledJacobian;
+      HexQuality = v_hex_scaled_jacobian;
       break;
     case VTK_QUALITY_SHEAR:
-      HexQuality = HexShear;
+      HexQuality = v_hex_shear;
       break;
     case VTK_QUALITY_SHAPE:
-      HexQuality = HexShape;
+      HexQuality = v_hex_shape;
       break;
     case VTK_QUALITY_RELATIVE_SIZE_SQUARED:
-      HexQuality = HexRelativeSizeSquared;
+      HexQuality = v_hex_relative_size_squared;
       break;
     case VTK_QUALITY_SHAPE_AND_SIZE:
-      HexQuality = HexShapeAndSize;
+      HexQuality = v_hex_shape_and_size;
       break;
     case VTK_QUALITY_SHEAR_AND_SIZE:
-      HexQuality = HexShearAndSize;
+      HexQuality = v_hex_shear_and_size;
       break;
     case VTK_QUALITY_DISTORTION:
-      HexQuality = HexDistortion;
+      HexQuality = v_hex_distortion;
       break;
     default:
       vtkWarningMacro("Bad HexQualityMeasure (" << this->GetTetQualityMeasure()
                                                 << "), using MaxAspectFrobenius instead");
-      HexQuality = HexMaxAspectFrobenius;
+      HexQuality = v_hex_max_aspect_frobenius;
       break;
   }
 
   out->ShallowCopy(in);
 
+  // Dummy call required before multithreaded calls
+  if (N > 0)
+  {
+    static_cast<void>(out->GetCellType(0));
+  }
+
   if (this->SaveCellQuality)
   {
     quality = vtkDoubleArray::New();
@@ -468,14 +493,43 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
         tetVolTuple[i] = 0;
         hexVolTuple[i] = 0;
       }
+      // Compute the sizes in parallel, then accumulate them in cell order so
+      // that the statistics do not depend on the number of threads.
+      std::vector<double> sizes(N);
+      vtkSMPTools::For(0, N, [&](vtkIdType begin, vtkIdType end) {
+        vtkIdList* ptIds = tlPtIds.Local();
+        double pc[8][3];
+        for (vtkIdType c = begin; c < end; ++c)
+        {
+          switch (out->GetCellType(c))
+          {
+            case VTK_TRIANGLE:
+              GetCellCoordinates(out, c, ptIds, pc);
+              sizes[c] = v_tri_area(3, pc);
+              break;
+            case VTK_QUAD:
+              GetCellCoordinates(out, c, ptIds, pc);
+              sizes[c] = v_quad_area(4, pc);
+              break;
+            case VTK_TETRA:
+              GetCellCoordinates(out, c, ptIds, pc);
+              sizes[c] = v_tet_volume(4, pc);
+              break;
+            case VTK_HEXAHEDRON:
+              GetCellCoordinates(out, c, ptIds, pc);
+              sizes[c] = v_hex_volume(8, pc);
+              break;
+          }
+        }
+      });
+
       for (vtkIdType c = 0; c < N; ++c)
       {
         double a, v; // area and volume
-        cell = out->GetCell(c);
-        switch (cell->GetCellType())
+        switch (out->GetCellType(c))
         {
           case VTK_TRIANGLE:
-            a = TriangleArea(cell);
+            a = sizes[c];
             if (a > triAreaTuple[2])
             {
               if (triAreaTuple[0] == triAreaTuple[2])
@@ -493,7 +547,7 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
             ntri++;
             break;
           case VTK_QUAD:
-            a = QuadArea(cell);
+            a = sizes[c];
             if (a > quadAreaTuple[2])
             {
               if (quadAreaTuple[0] == quadAreaTuple[2])
@@ -511,7 +565,7 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
             nqua++;
             break;
           case VTK_TETRA:
-            v = TetVolume(cell);
+            v = sizes[c];
             if (v > tetVolTuple[2])
             {
               if (tetVolTuple[0] == tetVolTuple[2])
@@ -529,7 +583,7 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
             ntet++;
             break;
           case VTK_HEXAHEDRON:
-            v = HexVolume(cell);
+            v = sizes[c];
             if (v > hexVolTuple[2])
             {
               if (hexVolTuple[0] == hexVolTuple[2])
@@ -594,119 +648,153 @@ int vtkMeshQuality::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
-  int p;
-  vtkIdType c = 0;
-  vtkIdType sz = N / 20 + 1;
-  vtkIdType inner;
-  this->UpdateProgress(progressNumer / progressDenom + 0.01);
-  for (p = 0; p < 20; ++p)
-  {
-    for (inner = 0; (inner < sz && c < N); ++c, ++inner)
+  // Evaluate the quality of the cells in parallel, then accumulate the
+  // statistics in cell order so that they do not depend on the number of
+  // threads. The triangle normals and the Gauss integration of the distortion
+  // go through global state in verdict, so these cases run on one thread.
+  std::vector<double> qualities(N);
+  std::vector<double> volumes(this->Volume ? N : 0);
+  auto evaluate = [&](vtkIdType begin, vtkIdType end) {
+    vtkIdList* ptIds = tlPtIds.Local();
+    double pc[8][3];
+    for (vtkIdType c = begin; c < end; ++c)
     {
-      cell = out->GetCell(c);
-      V = 0.;
-      switch (cell->GetCellType())
+      double q = 0.;
+      switch (out->GetCellType(c))
       {
         case VTK_TRIANGLE:
+          GetCellCoordinates(out, c, ptIds, pc);
           if (this->CellNormals)
             this->CellNormals->GetTuple(c, vtkMeshQuality::CurrentTriNormal);
-          q = TriangleQuality(cell);
-          if (q > qtriM)
-          {
-            if (qtrim > qtriM)
-            {
-              qtrim = q;
-            }
-            qtriM = q;
-          }
-          else if (q < qtrim)
-          {
-            qtrim = q;
-          }
-          Eqtri += q;
-          Eqtri2 += q * q;
-          ++ntri;
+          q = TriangleQuality(3, pc);
           break;
         case VTK_QUAD:
-          q = QuadQuality(cell);
-          if (q > qquaM)
-          {
-            if (qquam > qquaM)
-            {
-              qquam = q;
-            }
-            qquaM = q;
-          }
-          else if (q < qquam)
-          {
-            qquam = q;
-          }
-          Eqqua += q;
-          Eqqua2 += q * q;
-          ++nqua;
+          GetCellCoordinates(out, c, ptIds, pc);
+          q = QuadQuality(4, pc);
           break;
         case VTK_TETRA:
-          q = TetQuality(cell);
-          if (q > qtetM)
+          GetCellCoordinates(out, c, ptIds, pc);
+          q = TetQuality(4, pc);
+          if (this->Volume)
           {
-            if (qtetm > qtetM)
-            {
-              qtetm = q;
-            }
-            qtetM = q;
+            volumes[c] = v_tet_volume(4, pc);
           }
-          else if (q < qtetm)
+          break;
+        case VTK_HEXAHEDRON:
+          GetCellCoordinates(out, c, ptIds, pc);
+          q = HexQuality(8, pc);
+          break;
+      }
+      qualities[c] = q;
+    }
+  };
+
+  this->UpdateProgress(progressNumer / progressDenom + 0.01);
+  if (this->CellNormals || TriangleQuality == v_tri_distortion ||
+    QuadQuality == v_quad_distortion || TetQuality == v_tet_distortion ||
+    HexQuality == v_hex_distortion)
+  {
+    evaluate(0, N);
+  }
+  else
+  {
+    vtkSMPTools::For(0, N, evaluate);
+  }
+  this->UpdateProgress((progressNumer + 19) / progressDenom);
+
+  for (vtkIdType c = 0; c < N; ++c)
+  {
+    const double q = qualities[c];
+    const double V = (this->Volume ? volumes[c] : 0.);
+    switch (out->GetCellType(c))
+    {
+      case VTK_TRIANGLE:
+        if (q > qtriM)
+        {
+          if (qtrim > qtriM)
           {
-            qtetm = q;
+            qtrim = q;
           }
-          Eqtet += q;
-          Eqtet2 += q * q;
-          ++ntet;
-          if (this->Volume)
+          qtriM = q;
+        }
+        else if (q < qtrim)
+        {
+          qtrim = q;
+        }
+        Eqtri += q;
+        Eqtri2 += q * q;
+        ++ntri;
+        break;
+      case VTK_QUAD:
+        if (q > qquaM)
+        {
+          if (qquam > qquaM)
           {
-            V = TetVolume(cell);
-            if (!this->CompatibilityMode)
-            {
-              volume->SetTuple1(0, V);
-            }
+            qquam = q;
           }
-          break;
-        case VTK_HEXAHEDRON:
-          q = HexQuality(cell);
-          if (q > qhexM)
+          qquaM = q;
+        }
+        else if (q < qquam)
+        {
+          qquam = q;
+        }
+        Eqqua += q;
+        Eqqua2 += q * q;
+        ++nqua;
+        break;
+      case VTK_TETRA:
+        if (q > qtetM)
+        {
+          if (qtetm > qtetM)
           {
-            if (qhexm > qhexM)
-            {
-              qhexm = q;
-            }
-            qhexM = q;
+            qtetm = q;
           }
-          else if (q < qhexm)
+          qtetM = q;
+        }
+        else if (q < qtetm)
+        {
+          qtetm = q;
+        }
+        Eqtet += q;
+        Eqtet2 += q * q;
+        ++ntet;
+        break;
+      case VTK_HEXAHEDRON:
+        if (q > qhexM)
+        {
+          if (qhexm > qhexM)
           {
             qhexm = q;
           }
-          Eqhex += q;
-          Eqhex2 += q * q;
-          ++nhex;
-          break;
-        default:
-          q = 0.;
-      }
-
-      if (this->SaveCellQuality)
-      {
-        if (this->CompatibilityMode && this->Volume)
-        {
-          quality->SetTuple2(c, V, q);
+          qhexM = q;
         }
-        else
+        else if (q < qhexm)
         {
-          quality->SetTuple1(c, q);
+          qhexm = q;
         }
+        Eqhex += q;
+        Eqhex2 += q * q;
+        ++nhex;
+        break;
+    }
+
+    if (this->SaveCellQuality)
+    {
+      if (this->CompatibilityMode && this->Volume)
+      {
+        quality->SetTuple2(c, V, q);
       }
+      else
+      {
+        quality->SetTuple1(c, q);
+      }
+    }
+    if (volume)
+    {
+      volume->SetTuple1(c, V);
     }
-    this->UpdateProgress(double(p + 1 + progressNumer) / progressDenom);
   }
+  this->UpdateProgress((progressNumer + 20) / progressDenom);
 
   if (ntri)
   {
@@ -57,6 +57,15 @@
  * only.
  * The minimal angle is not, strictly speaking, a quality function, but it is
  * provided because of its usage by many authors.
+ *
+ * @warning
+ * This class has been threaded with vtkSMPTools. The cell quality is
+ * evaluated in parallel and the statistics are then accumulated in cell
+ * order, so they do not depend on the number of threads. The distortion
+ * measures and the triangle measures using cell normals rely on global
+ * state in verdict and are evaluated on a single thread. Using TBB or other
+ * non-sequential type (set in the CMake variable VTK_SMP_IMPLEMENTATION_TYPE)
+ * may improve performance significantly.
  */
 
 #ifndef vtkMeshQuality_h